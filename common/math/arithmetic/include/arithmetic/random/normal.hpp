@@ -0,0 +1,52 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ARITHMETIC__RANDOM__NORMAL_HPP_
+#define ARITHMETIC__RANDOM__NORMAL_HPP_
+
+#include <arithmetic/random/philox.hpp>
+#include <cmath>
+#include <cstddef>
+
+namespace math
+{
+namespace arithmetic
+{
+/**
+ * @brief Fill the range with normal random numbers of the given mean and standard deviation.
+ * @note Box-Muller transform of the uniform numbers of the generator, two normal numbers per two
+ * uniform numbers. Unlike std::normal_distribution there is no rejection loop nor cached value, so
+ * the numbers of a range only depend on the state of the generator.
+ */
+template <typename Iterator>
+auto fillNormal(
+  Philox4x32 & engine, Iterator first, const Iterator last, const double mean,
+  const double standard_deviation) -> void
+{
+  /// @note Uniform number in (0, 1), so that its logarithm is finite.
+  const auto uniform = [&]() { return (engine() + 0.5) * 0x1.0p-32; };
+  constexpr auto two_pi = 6.283185307179586;
+  while (first != last) {
+    const auto radius = standard_deviation * std::sqrt(-2.0 * std::log(uniform()));
+    const auto angle = two_pi * uniform();
+    *first++ = mean + radius * std::cos(angle);
+    if (first != last) {
+      *first++ = mean + radius * std::sin(angle);
+    }
+  }
+}
+}  // namespace arithmetic
+}  // namespace math
+
+#endif  // ARITHMETIC__RANDOM__NORMAL_HPP_
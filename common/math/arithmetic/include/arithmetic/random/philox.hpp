@@ -0,0 +1,124 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ARITHMETIC__RANDOM__PHILOX_HPP_
+#define ARITHMETIC__RANDOM__PHILOX_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+namespace math
+{
+namespace arithmetic
+{
+/**
+ * @brief Philox4x32-10 counter-based random number generator, see "Parallel Random Numbers: As
+ * Easy as 1, 2, 3" by John K. Salmon et al. (SC11).
+ * @note The output is a bijection of a counter keyed by the seed, so each (seed, stream) pair is an
+ * independent sequence and owners holding their own stream draw the same numbers whatever order or
+ * thread they are updated in. Satisfies UniformRandomBitGenerator, so it works with the
+ * distributions of <random>.
+ */
+class Philox4x32
+{
+public:
+  using result_type = std::uint32_t;
+
+  using Block = std::array<std::uint32_t, 4>;
+
+  static constexpr auto min() -> result_type { return std::numeric_limits<result_type>::min(); }
+
+  static constexpr auto max() -> result_type { return std::numeric_limits<result_type>::max(); }
+
+  explicit constexpr Philox4x32(
+    const std::uint64_t seed = 0, const std::uint64_t stream = 0, const std::uint64_t position = 0)
+  : key_{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)},
+    stream_(stream),
+    position_(position)
+  {
+  }
+
+  auto operator()() -> result_type
+  {
+    if (index_ == block_.size()) {
+      block_ = generate(
+        {static_cast<std::uint32_t>(position_), static_cast<std::uint32_t>(position_ >> 32),
+         static_cast<std::uint32_t>(stream_), static_cast<std::uint32_t>(stream_ >> 32)},
+        key_);
+      ++position_;
+      index_ = 0;
+    }
+    return block_[index_++];
+  }
+
+  auto discard(unsigned long long count) -> void
+  {
+    for (; 0 < count and index_ != block_.size(); --count) {
+      ++index_;
+    }
+    position_ += count / block_.size();
+    for (count %= block_.size(); 0 < count; --count) {
+      operator()();
+    }
+  }
+
+  static constexpr auto generate(Block counter, std::array<std::uint32_t, 2> key) -> Block
+  {
+    constexpr std::uint64_t multipliers[] = {0xD2511F53, 0xCD9E8D57};
+    constexpr std::uint32_t weyl[] = {0x9E3779B9, 0xBB67AE85};
+    for (auto round = 0; round < 10; ++round) {
+      const auto product0 = multipliers[0] * counter[0];
+      const auto product1 = multipliers[1] * counter[2];
+      counter = {
+        static_cast<std::uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+        static_cast<std::uint32_t>(product1),
+        static_cast<std::uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+        static_cast<std::uint32_t>(product0)};
+      key = {key[0] + weyl[0], key[1] + weyl[1]};
+    }
+    return counter;
+  }
+
+private:
+  std::array<std::uint32_t, 2> key_;
+
+  std::uint64_t stream_;
+
+  /// @note Index of the next block of the stream.
+  std::uint64_t position_;
+
+  Block block_ = {};
+
+  std::size_t index_ = block_.size();
+};
+
+/**
+ * @brief Stream number for a named owner of random numbers (an entity, a sensor, ...).
+ * @note FNV-1a, so that the number is the same on every platform and every run unlike std::hash.
+ */
+constexpr auto makeStreamId(const std::string_view name) -> std::uint64_t
+{
+  std::uint64_t hash = 14695981039346656037ULL;
+  for (const auto c : name) {
+    hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+  }
+  return hash;
+}
+}  // namespace arithmetic
+}  // namespace math
+
+#endif  // ARITHMETIC__RANDOM__PHILOX_HPP_
@@ -22,6 +22,7 @@
 #include <boost/geometry/geometries/linestring.hpp>
 #include <boost/geometry/geometries/point_xy.hpp>
 #include <boost/numeric/conversion/bounds.hpp>
+#include <geometry/oriented_bounding_box.hpp>
 #include <geometry/transform.hpp>
 #include <geometry_msgs/msg/pose.hpp>
 #include <optional>
@@ -49,6 +50,10 @@ struct DistancesFromCenterToEdge
 std::optional<double> getPolygonDistance(
   const geometry_msgs::msg::Pose & pose0, const traffic_simulator_msgs::msg::BoundingBox & bbox0,
   const geometry_msgs::msg::Pose & pose1, const traffic_simulator_msgs::msg::BoundingBox & bbox1);
+/// @note One-to-many getPolygonDistance, e.g. from the ego to every other entity.
+auto getPolygonDistances(
+  const OrientedBoundingBox & box, const std::vector<OrientedBoundingBox> & other_boxes)
+  -> std::vector<std::optional<double>>;
 std::optional<std::pair<geometry_msgs::msg::Pose, geometry_msgs::msg::Pose>> getClosestPoses(
   const geometry_msgs::msg::Pose & pose0, const traffic_simulator_msgs::msg::BoundingBox & bbox0,
   const geometry_msgs::msg::Pose & pose1, const traffic_simulator_msgs::msg::BoundingBox & bbox1);
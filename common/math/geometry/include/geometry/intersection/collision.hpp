@@ -15,10 +15,13 @@
 #ifndef GEOMETRY__INTERSECTION__COLLISION_HPP_
 #define GEOMETRY__INTERSECTION__COLLISION_HPP_
 
+#include <cstddef>
 #include <geometry/bounding_box.hpp>
+#include <geometry/oriented_bounding_box.hpp>
 #include <geometry/polygon/polygon.hpp>
 #include <geometry_msgs/msg/pose.hpp>
 #include <traffic_simulator_msgs/msg/bounding_box.hpp>
+#include <utility>
 #include <vector>
 
 namespace math
@@ -28,6 +31,20 @@ namespace geometry
 bool checkCollision2D(
   geometry_msgs::msg::Pose pose0, traffic_simulator_msgs::msg::BoundingBox bbox0,
   geometry_msgs::msg::Pose pose1, traffic_simulator_msgs::msg::BoundingBox bbox1);
+/// @note Separating axis test on the corners, touching boxes collide like in boost::geometry.
+bool checkCollision2D(const OrientedBoundingBox & box0, const OrientedBoundingBox & box1);
+/**
+ * @brief Check every box of boxes0 against every box of boxes1.
+ * @note Candidate pairs are found with a uniform grid over boxes1, so the cost grows with the
+ * number of nearby pairs instead of the number of all pairs.
+ * @return Pairs of indices (i, j) such that boxes0[i] and boxes1[j] collide, in ascending order.
+ */
+auto checkCollisions2D(
+  const std::vector<OrientedBoundingBox> & boxes0, const std::vector<OrientedBoundingBox> & boxes1)
+  -> std::vector<std::pair<std::size_t, std::size_t>>;
+/// @return Pairs of indices (i, j), i < j, such that boxes[i] and boxes[j] collide, sorted.
+auto checkCollisions2D(const std::vector<OrientedBoundingBox> & boxes)
+  -> std::vector<std::pair<std::size_t, std::size_t>>;
 bool contains(
   const std::vector<geometry_msgs::msg::Point> & polygon, const geometry_msgs::msg::Point & point);
 }  // namespace geometry
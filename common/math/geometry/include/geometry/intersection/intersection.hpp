@@ -15,6 +15,7 @@
 #ifndef GEOMETRY__INTERSECTION__INTERSECTION_HPP_
 #define GEOMETRY__INTERSECTION__INTERSECTION_HPP_
 
+#include <cstddef>
 #include <geometry/polygon/line_segment.hpp>
 #include <geometry_msgs/msg/point.hpp>
 #include <optional>
@@ -29,6 +30,24 @@ bool isIntersect2D(const std::vector<LineSegment> & lines);
 std::optional<geometry_msgs::msg::Point> getIntersection2D(
   const LineSegment & line0, const LineSegment & line1);
 std::vector<geometry_msgs::msg::Point> getIntersection2D(const std::vector<LineSegment> & lines);
+
+struct FirstIntersection2D
+{
+  /// @note Index of the intersected segment.
+  std::size_t index;
+
+  /// @note Normalized s value of the intersection along the query segment.
+  double s;
+};
+
+/**
+ * @brief Find the intersection nearest to the start of each query segment, in 2D.
+ * @note Segments are tested like in isIntersect2D, ties keep the lowest index, and overlapping
+ * collinear segments intersect at the start of the overlap.
+ * @return For each query segment, its first intersection or std::nullopt if there is none.
+ */
+auto getFirstIntersections2D(const LineSegmentArray & queries, const LineSegmentArray & segments)
+  -> std::vector<std::optional<FirstIntersection2D>>;
 }  // namespace geometry
 }  // namespace math
 
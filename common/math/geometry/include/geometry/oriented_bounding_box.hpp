@@ -0,0 +1,67 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GEOMETRY__ORIENTED_BOUNDING_BOX_HPP_
+#define GEOMETRY__ORIENTED_BOUNDING_BOX_HPP_
+
+#include <array>
+#include <geometry_msgs/msg/pose.hpp>
+#include <optional>
+#include <traffic_simulator_msgs/msg/bounding_box.hpp>
+
+namespace math
+{
+namespace geometry
+{
+/**
+ * @brief Bounding box placed in the map frame, with its 2D corners computed once.
+ * @note The corners are the ones of toPolygon2D(pose, bounding_box), so a box can be tested
+ * against many others without building boost polygons for every pair.
+ */
+struct OrientedBoundingBox
+{
+  OrientedBoundingBox(
+    const geometry_msgs::msg::Pose & pose,
+    const traffic_simulator_msgs::msg::BoundingBox & bounding_box);
+
+  /// @note Separating axis test in 2D, touching boxes intersect like in boost::geometry.
+  auto intersects(const OrientedBoundingBox & other) const -> bool;
+
+  /**
+   * @brief Distance between the boxes in 2D.
+   * @note Closed form for disjoint parallelograms: the nearest points are a corner of one box and
+   * a point on an edge of the other.
+   * @retval std::nullopt boxes intersect
+   * @retval 0 <= distance between two boxes
+   */
+  auto getDistance(const OrientedBoundingBox & other) const -> std::optional<double>;
+
+  /// @note Corners in the order front left, rear left, rear right, front right.
+  std::array<double, 4> x;
+  std::array<double, 4> y;
+
+  /// @note Height of the center and size along the z axis, compared without the orientation.
+  double z;
+  double height;
+
+  /// @note Axis aligned envelope of the corners.
+  double min_x;
+  double min_y;
+  double max_x;
+  double max_y;
+};
+}  // namespace geometry
+}  // namespace math
+
+#endif  // GEOMETRY__ORIENTED_BOUNDING_BOX_HPP_
@@ -20,7 +20,9 @@
 #include <geometry_msgs/msg/pose.hpp>
 #include <geometry_msgs/msg/quaternion.hpp>
 #include <geometry_msgs/msg/vector3.hpp>
+#include <cstddef>
 #include <optional>
+#include <vector>
 
 namespace math
 {
@@ -76,6 +78,27 @@ private:
   auto denormalize(const double s) const -> double;
 };
 
+/**
+ * @brief 2D line segments in struct-of-arrays layout, for the batched intersection tests.
+ * @note The end points are stored rather than the vectors, so that the vectors are computed exactly
+ * as in LineSegment and the batched tests agree with the ones on LineSegment.
+ */
+struct LineSegmentArray
+{
+  LineSegmentArray() = default;
+
+  explicit LineSegmentArray(const std::vector<LineSegment> & lines);
+
+  auto push_back(const LineSegment & line) -> void;
+
+  auto size() const -> std::size_t { return start_x.size(); }
+
+  std::vector<double> start_x;
+  std::vector<double> start_y;
+  std::vector<double> end_x;
+  std::vector<double> end_y;
+};
+
 auto getLineSegments(
   const std::vector<geometry_msgs::msg::Point> & points, const bool close_start_end = false)
   -> std::vector<LineSegment>;
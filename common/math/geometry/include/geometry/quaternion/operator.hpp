@@ -26,7 +26,7 @@ template <
   typename T, typename U,
   std::enable_if_t<std::conjunction_v<IsLikeQuaternion<T>, IsLikeQuaternion<U>>, std::nullptr_t> =
     nullptr>
-auto operator+(const T & a, const U & b)
+constexpr auto operator+(const T & a, const U & b)
 {
   auto v = T();
   v.x = a.x + b.x;
@@ -40,7 +40,7 @@ template <
   typename T, typename U,
   std::enable_if_t<std::conjunction_v<IsLikeQuaternion<T>, IsLikeQuaternion<U>>, std::nullptr_t> =
     nullptr>
-auto operator-(const T & a, const U & b)
+constexpr auto operator-(const T & a, const U & b)
 {
   auto v = T();
   v.x = a.x - b.x;
@@ -54,7 +54,7 @@ template <
   typename T, typename U,
   std::enable_if_t<std::conjunction_v<IsLikeQuaternion<T>, IsLikeQuaternion<U>>, std::nullptr_t> =
     nullptr>
-auto operator*(const T & a, const U & b)
+constexpr auto operator*(const T & a, const U & b)
 {
   auto v = T();
   v.x = a.w * b.x - a.z * b.y + a.y * b.z + a.x * b.w;
@@ -68,7 +68,7 @@ template <
   typename T, typename U,
   std::enable_if_t<std::conjunction_v<IsLikeQuaternion<T>, IsLikeQuaternion<U>>, std::nullptr_t> =
     nullptr>
-auto operator+=(T & a, const U & b) -> decltype(auto)
+constexpr auto operator+=(T & a, const U & b) -> decltype(auto)
 {
   a.x += b.x;
   a.y += b.y;
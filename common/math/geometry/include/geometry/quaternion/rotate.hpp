@@ -0,0 +1,86 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GEOMETRY__QUATERNION__ROTATE_HPP_
+#define GEOMETRY__QUATERNION__ROTATE_HPP_
+
+#include <array>
+#include <geometry/quaternion/is_like_quaternion.hpp>
+#include <geometry/vector3/is_like_vector3.hpp>
+
+namespace math
+{
+namespace geometry
+{
+/**
+ * @brief Row-major elements of the rotation matrix of the quaternion.
+ * @note Same matrix as getRotationMatrix, without building an Eigen::Matrix3d.
+ */
+template <
+  typename T, std::enable_if_t<std::conjunction_v<IsLikeQuaternion<T>>, std::nullptr_t> = nullptr>
+constexpr auto getRotationMatrixElements(const T & quat) -> std::array<double, 9>
+{
+  const double x = quat.x;
+  const double y = quat.y;
+  const double z = quat.z;
+  const double w = quat.w;
+  return {
+    x * x - y * y - z * z + w * w, 2 * (x * y - z * w), 2 * (z * x + w * y),
+    2 * (x * y + z * w), -x * x + y * y - z * z + w * w, 2 * (y * z - x * w),
+    2 * (z * x - w * y), 2 * (y * z + w * x), -x * x - y * y + z * z + w * w};
+}
+
+/**
+ * @brief Rotate the vector by the rotation matrix elements, keeping the type of the vector.
+ * @note Works on plain structs as well as on messages, and is constexpr for literal types.
+ */
+template <typename T, std::enable_if_t<IsLikeVector3<T>::value, std::nullptr_t> = nullptr>
+constexpr auto rotate(const std::array<double, 9> & matrix, const T & v) -> T
+{
+  auto rotated = v;
+  rotated.x = matrix[0] * v.x + matrix[1] * v.y + matrix[2] * v.z;
+  rotated.y = matrix[3] * v.x + matrix[4] * v.y + matrix[5] * v.z;
+  rotated.z = matrix[6] * v.x + matrix[7] * v.y + matrix[8] * v.z;
+  return rotated;
+}
+
+template <
+  typename T, typename U,
+  std::enable_if_t<std::conjunction_v<IsLikeQuaternion<T>, IsLikeVector3<U>>, std::nullptr_t> =
+    nullptr>
+constexpr auto rotate(const T & quat, const U & v) -> U
+{
+  return rotate(getRotationMatrixElements(quat), v);
+}
+
+/**
+ * @brief Rotate every vector in [first, last) by the quaternion, writing them to output.
+ * @note The rotation matrix is computed once for all vectors.
+ */
+template <
+  typename T, typename InputIterator, typename OutputIterator,
+  std::enable_if_t<std::conjunction_v<IsLikeQuaternion<T>>, std::nullptr_t> = nullptr>
+auto rotate(const T & quat, InputIterator first, InputIterator last, OutputIterator output)
+  -> OutputIterator
+{
+  const auto matrix = getRotationMatrixElements(quat);
+  for (; first != last; ++first, ++output) {
+    *output = rotate(matrix, *first);
+  }
+  return output;
+}
+}  // namespace geometry
+}  // namespace math
+
+#endif  // GEOMETRY__QUATERNION__ROTATE_HPP_
@@ -15,7 +15,9 @@
 #ifndef GEOMETRY__SOLVER__POLYNOMIAL_SOLVER_HPP_
 #define GEOMETRY__SOLVER__POLYNOMIAL_SOLVER_HPP_
 
-#include <complex>
+#include <array>
+#include <cmath>
+#include <cstddef>
 #include <vector>
 
 namespace math
@@ -25,6 +27,29 @@ namespace geometry
 class PolynomialSolver
 {
 public:
+  /// @brief Coefficients of the cubic function a*t^3 + b*t^2 + c*t + d
+  struct CubicCoefficients
+  {
+    double a;
+    double b;
+    double c;
+    double d;
+  };
+  /**
+   * @brief Real solutions of an equation of up to third degree, stored in place so that solving
+   * does not allocate.
+   * @note indeterminate is true if any x is a solution, in which case there are no values.
+   */
+  struct Solutions
+  {
+    std::array<double, 3> values = {};
+    std::size_t size = 0;
+    bool indeterminate = false;
+    auto begin() const { return values.begin(); }
+    auto end() const { return values.begin() + size; }
+    auto empty() const -> bool { return size == 0; }
+    auto push_back(const double value) -> void { values[size++] = value; }
+  };
   /**
    * @brief solve linear equation a*x + b = 0
    *
@@ -57,6 +82,31 @@ public:
   auto solveCubicEquation(
     const double a, const double b, const double c, const double d, const double min_value = 0,
     const double max_value = 1) const -> std::vector<double>;
+  /**
+   * @brief solve cubic function a*t^3 + b*t^2 + c*t + d = 0 without heap allocation
+   * @note Unlike the overload above, this one does not throw when any t is a solution, it sets
+   * Solutions::indeterminate instead.
+   * @return Solutions real solution of the cubic functions (from min_value to max_value)
+   */
+  auto solveCubicEquation(
+    const CubicCoefficients & coefficients, const double min_value = 0,
+    const double max_value = 1) const -> Solutions;
+  /**
+   * @brief solve the cubic functions in [first, last) and write their solutions to output
+   * @note output must have room for std::distance(first, last) elements, so that callers can pass
+   * fixed size buffers and solve a whole batch without heap allocation.
+   * @return OutputIterator past the last written solutions
+   */
+  template <typename InputIterator, typename OutputIterator>
+  auto solveCubicEquations(
+    InputIterator first, const InputIterator last, OutputIterator output,
+    const double min_value = 0, const double max_value = 1) const -> OutputIterator
+  {
+    for (; first != last; ++first, ++output) {
+      *output = solveCubicEquation(*first, min_value, max_value);
+    }
+    return output;
+  }
   /**
    * @brief calculate result of linear function a*t + b
    *
@@ -102,22 +152,36 @@ public:
   constexpr static double tolerance = 1e-7;
 
 private:
+  /// @note Solutions of a*x + b = 0 without range limits.
+  auto solveLinearEquationWithoutLimit(const double a, const double b) const -> Solutions;
+  /// @note Solutions of a*x^2 + b*x + c = 0 without range limits.
+  auto solveQuadraticEquationWithoutLimit(const double a, const double b, const double c) const
+    -> Solutions;
+  /// @note Solutions of a*x^3 + b*x^2 + c*x + d = 0 without range limits.
+  auto solveCubicEquationWithoutLimit(
+    const double a, const double b, const double c, const double d) const -> Solutions;
   /**
    * @brief solve cubic equation x^3 + a*x^2 + b*x + c = 0
-   * @param a 
-   * @param b 
-   * @param c 
-   * @return std::vector<std::complex<double>> Up to 3 complex solutions
+   * @param a
+   * @param b
+   * @param c
+   * @return Solutions Up to 3 real solutions, complex ones are dropped
    */
-  auto solveMonicCubicEquationWithComplex(const double a, const double b, const double c) const
-    -> std::vector<std::complex<double>>;
+  auto solveMonicCubicEquation(const double a, const double b, const double c) const -> Solutions;
   /**
    * @brief filter values by range.
    * @param values the values you want to check.
-   * @return std::vector<double> filtered values.
+   * @return Solutions filtered values.
+   */
+  auto filterByRange(const Solutions & values, const double min_value, const double max_value) const
+    -> Solutions;
+  /**
+   * @brief convert solutions to std::vector for the public API.
+   * @param a coefficient of x of the linear equation the solutions can be indeterminate for.
+   * @param b constant term of the linear equation the solutions can be indeterminate for.
+   * @throw common::SimulationError if any x is a solution.
    */
-  auto filterByRange(
-    const std::vector<double> & values, const double min_value, const double max_value) const
+  auto toVector(const Solutions & solutions, const double a, const double b) const
     -> std::vector<double>;
   /**
    * @brief check the value0 and value1 is equal or not with considering tolerance.
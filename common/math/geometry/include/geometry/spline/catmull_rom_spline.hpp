@@ -14,11 +14,14 @@
 #ifndef GEOMETRY__SPLINE__CATMULL_ROM_SPLINE_HPP_
 #define GEOMETRY__SPLINE__CATMULL_ROM_SPLINE_HPP_
 
+#include <array>
 #include <exception>
 #include <geometry/polygon/line_segment.hpp>
 #include <geometry/spline/catmull_rom_spline_interface.hpp>
+#include <geometry/spline/curve_bounding_hierarchy.hpp>
 #include <geometry/spline/hermite_curve.hpp>
 #include <geometry_msgs/msg/point.hpp>
+#include <memory>
 #include <optional>
 #include <string>
 #include <utility>
@@ -43,6 +46,10 @@ public:
   auto getTrajectory(
     const double start_s, const double end_s, const double resolution,
     const double offset = 0.0) const -> std::vector<geometry_msgs::msg::Point>;
+  /// @note Same as above but overwrites trajectory, so a caller reusing it does not allocate.
+  auto getTrajectory(
+    const double start_s, const double end_s, const double resolution, const double offset,
+    std::vector<geometry_msgs::msg::Point> & trajectory) const -> void;
   auto getSValue(const geometry_msgs::msg::Pose & pose, double threshold_distance = 3.0) const
     -> std::optional<double>;
   auto getSquaredDistanceIn2D(const geometry_msgs::msg::Point & point, const double s) const
@@ -69,14 +76,61 @@ private:
     const -> std::vector<geometry_msgs::msg::Point>;
   auto getSInSplineCurve(const size_t curve_index, const double s) const -> double;
   auto getCurveIndexAndS(const double s) const -> std::pair<size_t, double>;
+  /// @note curve_index is the curve of the previous query, it is updated to the curve of s.
+  auto getCurveIndexAndS(const double s, size_t & curve_index) const -> std::pair<size_t, double>;
+  auto getPoint(const std::pair<size_t, double> & index_and_s) const -> geometry_msgs::msg::Point;
+  auto getCurveBoundingHierarchy() const -> const CurveBoundingHierarchy &;
   auto checkConnection() const -> bool;
   auto equals(const geometry_msgs::msg::Point & p0, const geometry_msgs::msg::Point & p1) const
     -> bool;
   std::vector<LineSegment> line_segments_;
   std::vector<HermiteCurve> curves_;
+  /**
+   * @brief Coefficients of curves_ in struct-of-arrays layout, axes[0] is x, axes[1] is y and
+   * axes[2] is z, so that sampling many points reads a few contiguous arrays.
+   * @note The polynomial of axis k of curves_[i] is
+   * axes[k].a[i] * s^3 + axes[k].b[i] * s^2 + axes[k].c[i] * s + axes[k].d[i].
+   */
+  struct CurveCoefficients
+  {
+    struct Axis
+    {
+      std::vector<double> a, b, c, d;
+    };
+
+    std::array<Axis, 3> axes;
+
+    auto reserve(const size_t size) -> void
+    {
+      for (auto & axis : axes) {
+        axis.a.reserve(size);
+        axis.b.reserve(size);
+        axis.c.reserve(size);
+        axis.d.reserve(size);
+      }
+    }
+
+    auto append(
+      double ax, double bx, double cx, double dx, double ay, double by, double cy, double dy,
+      double az, double bz, double cz, double dz) -> void
+    {
+      const std::array<std::array<double, 4>, 3> values = {
+        {{ax, bx, cx, dx}, {ay, by, cy, dy}, {az, bz, cz, dz}}};
+      for (size_t k = 0; k < axes.size(); ++k) {
+        axes[k].a.push_back(values[k][0]);
+        axes[k].b.push_back(values[k][1]);
+        axes[k].c.push_back(values[k][2]);
+        axes[k].d.push_back(values[k][3]);
+      }
+    }
+  } coefficients_;
   std::vector<double> length_list_;
+  /// @note accumulated_lengths_[i] is the s value at the start of curves_[i], last is the total.
+  std::vector<double> accumulated_lengths_;
   std::vector<double> maximum_2d_curvatures_;
   double total_length_;
+  /// @note Built on the first collision query, splines that are never searched do not pay for it.
+  mutable std::shared_ptr<const CurveBoundingHierarchy> curve_bounding_hierarchy_;
 };
 }  // namespace geometry
 }  // namespace math
@@ -0,0 +1,96 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GEOMETRY__SPLINE__CURVE_BOUNDING_HIERARCHY_HPP_
+#define GEOMETRY__SPLINE__CURVE_BOUNDING_HIERARCHY_HPP_
+
+#include <cstddef>
+#include <geometry/spline/hermite_curve.hpp>
+#include <geometry_msgs/msg/point.hpp>
+#include <vector>
+
+namespace math
+{
+namespace geometry
+{
+/**
+ * @brief Hierarchy of 2D axis aligned bounding boxes over consecutive curves of a spline.
+ * @note Consecutive curves of a spline are also spatially close, so the tree pairs neighbouring
+ * curves level by level instead of sorting them.
+ */
+class CurveBoundingHierarchy
+{
+public:
+  struct Box
+  {
+    double min_x;
+    double min_y;
+    double max_x;
+    double max_y;
+
+    auto intersects(const Box & other) const -> bool
+    {
+      return min_x <= other.max_x and other.min_x <= max_x and min_y <= other.max_y and
+             other.min_y <= max_y;
+    }
+  };
+
+  /// @note The box contains every point of the curve, it is not always the tightest one.
+  static auto getBox(const HermiteCurve & curve) -> Box;
+
+  static auto getBox(const std::vector<geometry_msgs::msg::Point> & points) -> Box;
+
+  static auto getBox(
+    const geometry_msgs::msg::Point & point0, const geometry_msgs::msg::Point & point1) -> Box;
+
+  explicit CurveBoundingHierarchy(const std::vector<HermiteCurve> & curves);
+
+  /// @return Indices of the curves whose boxes intersect the given one, in ascending order.
+  auto query(const Box & box) const -> std::vector<std::size_t>;
+
+  /**
+   * @brief Call function with the index of each curve whose box intersects the given one, in
+   * ascending order, or in descending order if backward, until function returns true.
+   * @note Unlike query(), this does not allocate.
+   * @return true if function returned true for some curve.
+   */
+  template <typename Function>
+  auto find(const Box & box, const bool backward, Function && function) const -> bool
+  {
+    return not levels_.empty() and find(box, backward, levels_.size() - 1, 0, function);
+  }
+
+private:
+  template <typename Function>
+  auto find(
+    const Box & box, const bool backward, const std::size_t level, const std::size_t index,
+    Function & function) const -> bool
+  {
+    if (index >= levels_[level].size() or not levels_[level][index].intersects(box)) {
+      return false;
+    }
+    if (level == 0) {
+      return function(index);
+    }
+    return find(box, backward, level - 1, index * 2 + (backward ? 1 : 0), function) or
+           find(box, backward, level - 1, index * 2 + (backward ? 0 : 1), function);
+  }
+
+  /// @note levels_[0][i] is the box of curves[i], levels_[k + 1][i] covers levels_[k][2i, 2i + 1].
+  std::vector<std::vector<Box>> levels_;
+};
+}  // namespace geometry
+}  // namespace math
+
+#endif  // GEOMETRY__SPLINE__CURVE_BOUNDING_HIERARCHY_HPP_
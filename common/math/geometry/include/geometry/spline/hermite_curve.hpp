@@ -17,6 +17,7 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
 #include <geometry/solver/polynomial_solver.hpp>
 #include <geometry_msgs/msg/point.hpp>
 #include <geometry_msgs/msg/pose.hpp>
@@ -47,6 +48,10 @@ public:
   std::vector<geometry_msgs::msg::Point> getTrajectory(size_t num_points = 30) const;
   const std::vector<geometry_msgs::msg::Point> getTrajectory(
     double start_s, double end_s, double resolution, bool denormalize_s = false) const;
+  /// @note Same as above but overwrites trajectory, so a caller reusing it does not allocate.
+  void getTrajectory(
+    double start_s, double end_s, double resolution, bool denormalize_s,
+    std::vector<geometry_msgs::msg::Point> & trajectory) const;
   const geometry_msgs::msg::Pose getPose(
     double s, bool denormalize_s = false, bool fill_pitch = true) const;
   const geometry_msgs::msg::Point getPoint(double s, bool denormalize_s = false) const;
@@ -69,6 +74,15 @@ public:
   std::optional<double> getCollisionPointIn2D(
     const geometry_msgs::msg::Point & point0, const geometry_msgs::msg::Point & point1,
     bool search_backward = false, bool denormalize_s = false) const;
+  /**
+   * @note Same as the std::set overload above but writes the collision points to s_values in
+   * ascending order without heap allocation, a cubic curve crosses a line segment at most 3 times.
+   * @return size_t number of the collision points written to s_values.
+   */
+  size_t getCollisionPointsIn2D(
+    const geometry_msgs::msg::Point & point0, const geometry_msgs::msg::Point & point1,
+    std::array<double, 3> & s_values, bool search_backward = false,
+    bool denormalize_s = false) const;
   std::set<double> getCollisionPointsIn2D(
     const std::vector<geometry_msgs::msg::Point> & polygon, bool search_backward = false,
     bool close_start_end = true, bool denormalize_s = false) const;
@@ -78,6 +92,18 @@ public:
 
 private:
   std::pair<double, double> get2DMinMaxCurvatureValue() const;
+  /// @note Coefficients of the cubic equation of s whose solutions are on the line through points.
+  PolynomialSolver::CubicCoefficients getCollisionCoefficients(
+    const geometry_msgs::msg::Point & point0, const geometry_msgs::msg::Point & point1) const;
+  /// @note Solutions of the collision coefficients which are on the line segment, as s values.
+  PolynomialSolver::Solutions filterCollisionPointsIn2D(
+    const geometry_msgs::msg::Point & point0, const geometry_msgs::msg::Point & point1,
+    const PolynomialSolver::Solutions & solutions, bool search_backward, bool denormalize_s) const;
+  /// @note Call function with each collision point of the edges of polygon.
+  template <typename Function>
+  void forEachCollisionPointIn2D(
+    const std::vector<geometry_msgs::msg::Point> & polygon, bool search_backward,
+    bool close_start_end, bool denormalize_s, Function && function) const;
   double length_;
 };
 }  // namespace geometry
@@ -25,7 +25,7 @@ template <
   typename T, typename U,
   std::enable_if_t<std::conjunction_v<IsLikeVector3<T>, IsLikeVector3<U>>, std::nullptr_t> =
     nullptr>
-auto innerProduct(const T & v0, const U & v1)
+constexpr auto innerProduct(const T & v0, const U & v1)
 {
   return v0.x * v1.x + v0.y * v1.y + v0.z * v1.z;
 }
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <geometry/bounding_box.hpp>
+#include <geometry/oriented_bounding_box.hpp>
 #include <geometry/polygon/polygon.hpp>
 
 // headers in Eigen
@@ -39,18 +40,19 @@ std::optional<double> getPolygonDistance(
   const geometry_msgs::msg::Pose & pose0, const traffic_simulator_msgs::msg::BoundingBox & bbox0,
   const geometry_msgs::msg::Pose & pose1, const traffic_simulator_msgs::msg::BoundingBox & bbox1)
 {
-  const auto poly0 = toPolygon2D(pose0, bbox0);
-  const auto poly1 = toPolygon2D(pose1, bbox1);
-  if (boost::geometry::intersects(poly0, poly1)) {
-    return std::nullopt;
-  }
-  if (boost::geometry::intersects(poly1, poly0)) {
-    return std::nullopt;
-  }
-  if (boost::geometry::disjoint(poly0, poly1)) {
-    return boost::geometry::distance(poly0, poly1);
+  return OrientedBoundingBox(pose0, bbox0).getDistance(OrientedBoundingBox(pose1, bbox1));
+}
+
+auto getPolygonDistances(
+  const OrientedBoundingBox & box, const std::vector<OrientedBoundingBox> & other_boxes)
+  -> std::vector<std::optional<double>>
+{
+  std::vector<std::optional<double>> distances;
+  distances.reserve(other_boxes.size());
+  for (const auto & other_box : other_boxes) {
+    distances.push_back(box.getDistance(other_box));
   }
-  return std::nullopt;
+  return distances;
 }
 
 // inspiration taken from
@@ -12,14 +12,19 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <boost/assert.hpp>
 #include <boost/assign/list_of.hpp>
 #include <boost/geometry.hpp>
 #include <boost/geometry/algorithms/disjoint.hpp>
 #include <boost/geometry/geometries/linestring.hpp>
 #include <boost/geometry/geometries/point_xy.hpp>
+#include <cmath>
+#include <cstdint>
 #include <geometry/bounding_box.hpp>
 #include <geometry/intersection/collision.hpp>
+#include <limits>
+#include <tuple>
 #include <vector>
 
 namespace math
@@ -29,24 +34,157 @@ namespace geometry
 using boost_point = boost::geometry::model::d2::point_xy<double>;
 using boost_polygon = boost::geometry::model::polygon<boost_point>;
 
+namespace
+{
+auto overlapsIn2D(const OrientedBoundingBox & box0, const OrientedBoundingBox & box1) -> bool
+{
+  return box0.min_x <= box1.max_x and box1.min_x <= box0.max_x and box0.min_y <= box1.max_y and
+         box1.min_y <= box0.max_y;
+}
+
+/**
+ * @brief Uniform grid over the envelopes of boxes.
+ * @note The cells are at least as large as any box, so each box is registered in at most 2x2 cells.
+ */
+class UniformGrid
+{
+public:
+  explicit UniformGrid(const std::vector<OrientedBoundingBox> & boxes) : boxes_(boxes)
+  {
+    for (const auto & box : boxes_) {
+      cell_size_ = std::max({cell_size_, box.max_x - box.min_x, box.max_y - box.min_y});
+    }
+    if (cell_size_ <= 0.0) {
+      /// @note Hard coded parameter, any size works if all boxes are points.
+      cell_size_ = 1.0;
+    }
+    for (std::size_t index = 0; index < boxes_.size(); ++index) {
+      const auto & box = boxes_[index];
+      for (auto cell_x = getCell(box.min_x); cell_x <= getCell(box.max_x); ++cell_x) {
+        for (auto cell_y = getCell(box.min_y); cell_y <= getCell(box.max_y); ++cell_y) {
+          entries_.push_back({cell_x, cell_y, index});
+        }
+      }
+    }
+    std::sort(entries_.begin(), entries_.end());
+    for (const auto & entry : entries_) {
+      min_cell_y_ = std::min(min_cell_y_, entry.cell_y);
+      max_cell_y_ = std::max(max_cell_y_, entry.cell_y);
+    }
+  }
+
+  /**
+   * @brief Call function once with the index of each box whose envelope overlaps the given one.
+   * @note A pair is reported only from the cell holding the lower corner of the overlap of the two
+   * envelopes, which is a cell of both boxes, so no set of visited boxes is needed.
+   */
+  template <typename Function>
+  auto find(const OrientedBoundingBox & box, Function && function) const -> void
+  {
+    if (entries_.empty()) {
+      return;
+    }
+    const auto first_cell_x = std::max(getCell(box.min_x), entries_.front().cell_x);
+    const auto last_cell_x = std::min(getCell(box.max_x), entries_.back().cell_x);
+    const auto first_cell_y = std::max(getCell(box.min_y), min_cell_y_);
+    const auto last_cell_y = std::min(getCell(box.max_y), max_cell_y_);
+    for (auto cell_x = first_cell_x; cell_x <= last_cell_x; ++cell_x) {
+      for (auto cell_y = first_cell_y; cell_y <= last_cell_y; ++cell_y) {
+        const auto [begin, end] = std::equal_range(
+          entries_.begin(), entries_.end(), Entry{cell_x, cell_y, 0}, Entry::compareCell);
+        for (auto entry = begin; entry != end; ++entry) {
+          const auto & other = boxes_[entry->index];
+          if (
+            overlapsIn2D(box, other) and getCell(std::max(box.min_x, other.min_x)) == cell_x and
+            getCell(std::max(box.min_y, other.min_y)) == cell_y) {
+            function(entry->index);
+          }
+        }
+      }
+    }
+  }
+
+private:
+  struct Entry
+  {
+    std::int64_t cell_x;
+    std::int64_t cell_y;
+    std::size_t index;
+
+    auto operator<(const Entry & other) const -> bool
+    {
+      return std::tie(cell_x, cell_y, index) < std::tie(other.cell_x, other.cell_y, other.index);
+    }
+
+    static auto compareCell(const Entry & lhs, const Entry & rhs) -> bool
+    {
+      return std::tie(lhs.cell_x, lhs.cell_y) < std::tie(rhs.cell_x, rhs.cell_y);
+    }
+  };
+
+  auto getCell(const double value) const -> std::int64_t
+  {
+    return static_cast<std::int64_t>(std::floor(value / cell_size_));
+  }
+
+  const std::vector<OrientedBoundingBox> & boxes_;
+
+  double cell_size_ = 0.0;
+
+  std::int64_t min_cell_y_ = std::numeric_limits<std::int64_t>::max();
+
+  std::int64_t max_cell_y_ = std::numeric_limits<std::int64_t>::lowest();
+
+  std::vector<Entry> entries_;
+};
+}  // namespace
+
 bool checkCollision2D(
   geometry_msgs::msg::Pose pose0, traffic_simulator_msgs::msg::BoundingBox bbox0,
   geometry_msgs::msg::Pose pose1, traffic_simulator_msgs::msg::BoundingBox bbox1)
 {
-  if (
-    std::abs((pose0.position.z + bbox0.center.z) - (pose1.position.z + bbox1.center.z)) >
-    (std::abs(bbox0.dimensions.z + bbox1.dimensions.z) * 0.5)) {
+  return checkCollision2D(OrientedBoundingBox(pose0, bbox0), OrientedBoundingBox(pose1, bbox1));
+}
+
+bool checkCollision2D(const OrientedBoundingBox & box0, const OrientedBoundingBox & box1)
+{
+  if (std::abs(box0.z - box1.z) > (std::abs(box0.height + box1.height) * 0.5)) {
     return false;
   }
-  const boost_polygon poly0 = math::geometry::toPolygon2D(pose0, bbox0);
-  const boost_polygon poly1 = math::geometry::toPolygon2D(pose1, bbox1);
-  if (boost::geometry::intersects(poly0, poly1)) {
-    return true;
+  return box0.intersects(box1);
+}
+
+auto checkCollisions2D(
+  const std::vector<OrientedBoundingBox> & boxes0, const std::vector<OrientedBoundingBox> & boxes1)
+  -> std::vector<std::pair<std::size_t, std::size_t>>
+{
+  std::vector<std::pair<std::size_t, std::size_t>> collisions;
+  const UniformGrid grid(boxes1);
+  for (std::size_t i = 0; i < boxes0.size(); ++i) {
+    grid.find(boxes0[i], [&](const std::size_t j) {
+      if (checkCollision2D(boxes0[i], boxes1[j])) {
+        collisions.emplace_back(i, j);
+      }
+    });
   }
-  if (boost::geometry::disjoint(poly0, poly1)) {
-    return false;
+  std::sort(collisions.begin(), collisions.end());
+  return collisions;
+}
+
+auto checkCollisions2D(const std::vector<OrientedBoundingBox> & boxes)
+  -> std::vector<std::pair<std::size_t, std::size_t>>
+{
+  std::vector<std::pair<std::size_t, std::size_t>> collisions;
+  const UniformGrid grid(boxes);
+  for (std::size_t i = 0; i < boxes.size(); ++i) {
+    grid.find(boxes[i], [&](const std::size_t j) {
+      if (i < j and checkCollision2D(boxes[i], boxes[j])) {
+        collisions.emplace_back(i, j);
+      }
+    });
   }
-  return true;
+  std::sort(collisions.begin(), collisions.end());
+  return collisions;
 }
 
 bool contains(
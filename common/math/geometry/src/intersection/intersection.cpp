@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <cmath>
 #include <geometry/intersection/intersection.hpp>
 #include <limits>
 #include <optional>
@@ -103,5 +105,82 @@ std::vector<geometry_msgs::msg::Point> getIntersection2D(const std::vector<LineS
   }
   return ret;
 }
+
+auto getFirstIntersections2D(const LineSegmentArray & queries, const LineSegmentArray & segments)
+  -> std::vector<std::optional<FirstIntersection2D>>
+{
+  constexpr double tolerance = std::numeric_limits<double>::epsilon();
+  /// @note Same as LineSegment::relativePointPosition2D.
+  const auto sign = [](const double determinant) {
+    return (determinant > tolerance ? 1.0 : 0.0) - (determinant < -tolerance ? 1.0 : 0.0);
+  };
+  /// @note Same as LineSegment::isInBounds2D.
+  const auto is_in_bounds = [](
+                              const double x, const double y, const double start_x,
+                              const double start_y, const double end_x, const double end_y) {
+    return std::min(start_x, end_x) <= x and x <= std::max(start_x, end_x) and
+           std::min(start_y, end_y) <= y and y <= std::max(start_y, end_y);
+  };
+  constexpr double crossing = 1.0;
+  constexpr double collinear = 2.0;
+
+  std::vector<std::optional<FirstIntersection2D>> intersections(queries.size());
+  std::vector<double> hits(segments.size());
+  const auto segment_count = segments.size();
+  const auto * const p1x = segments.start_x.data();
+  const auto * const p1y = segments.start_y.data();
+  const auto * const q1x = segments.end_x.data();
+  const auto * const q1y = segments.end_y.data();
+  for (std::size_t query = 0; query < queries.size(); ++query) {
+    const auto p0x = queries.start_x[query], p0y = queries.start_y[query];
+    const auto q0x = queries.end_x[query], q0y = queries.end_y[query];
+    const auto v0x = q0x - p0x, v0y = q0y - p0y;
+    /**
+     * @note isIntersect2D written with arithmetic on 0.0 and 1.0 instead of bool and int, so
+     * that the loop has no control flow and the compiler can vectorize it. Collinear segments are
+     * rare, so their bounds are checked afterwards.
+     */
+    for (std::size_t i = 0; i < segment_count; ++i) {
+      const auto v1x = q1x[i] - p1x[i], v1y = q1y[i] - p1y[i];
+      const auto position_p0 = sign(v1y * (p0x - q1x[i]) - v1x * (p0y - q1y[i]));
+      const auto position_q0 = sign(v1y * (q0x - q1x[i]) - v1x * (q0y - q1y[i]));
+      const auto position_p1 = sign(v0y * (p1x[i] - q0x) - v0x * (p1y[i] - q0y));
+      const auto position_q1 = sign(v0y * (q1x[i] - q0x) - v0x * (q1y[i] - q0y));
+      const auto positions = position_p0 * position_p0 + position_q0 * position_q0 +
+                             position_p1 * position_p1 + position_q1 * position_q1;
+      hits[i] = (position_p1 != position_q1 ? crossing : 0.0) *
+                  (position_p0 != position_q0 ? 1.0 : 0.0) +
+                (positions == 0.0 ? collinear : 0.0);
+    }
+
+    auto & intersection = intersections[query];
+    for (std::size_t i = 0; i < segment_count; ++i) {
+      if (
+        hits[i] == 0.0 or (hits[i] == collinear and
+                           not is_in_bounds(p1x[i], p1y[i], p0x, p0y, q0x, q0y) and
+                           not is_in_bounds(q1x[i], q1y[i], p0x, p0y, q0x, q0y) and
+                           not is_in_bounds(p0x, p0y, p1x[i], p1y[i], q1x[i], q1y[i]) and
+                           not is_in_bounds(q0x, q0y, p1x[i], p1y[i], q1x[i], q1y[i]))) {
+        continue;
+      }
+      const auto v1x = q1x[i] - p1x[i], v1y = q1y[i] - p1y[i];
+      const auto determinant = v0x * v1y - v0y * v1x;
+      double s = 0.0;
+      if (std::abs(determinant) > tolerance) {
+        s = ((p1x[i] - p0x) * v1y - (p1y[i] - p0y) * v1x) / determinant;
+      } else if (const auto squared_length = v0x * v0x + v0y * v0y; squared_length > 0.0) {
+        s = std::min(
+              (p1x[i] - p0x) * v0x + (p1y[i] - p0y) * v0y,
+              (q1x[i] - p0x) * v0x + (q1y[i] - p0y) * v0y) /
+            squared_length;
+      }
+      s = std::clamp(s, 0.0, 1.0);
+      if (not intersection or s < intersection->s) {
+        intersection = FirstIntersection2D{i, s};
+      }
+    }
+  }
+  return intersections;
+}
 }  // namespace geometry
 }  // namespace math
@@ -0,0 +1,122 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <geometry/bounding_box.hpp>
+#include <geometry/oriented_bounding_box.hpp>
+#include <geometry/quaternion/get_rotation_matrix.hpp>
+#include <limits>
+
+namespace math
+{
+namespace geometry
+{
+namespace
+{
+/// @note The corners of a box are a parallelogram, so its first two edges give all of its axes.
+auto isSeparatedByEdgesOf(const OrientedBoundingBox & box0, const OrientedBoundingBox & box1)
+  -> bool
+{
+  for (std::size_t edge = 0; edge < 2; ++edge) {
+    const auto axis_x = box0.y[edge] - box0.y[edge + 1];
+    const auto axis_y = box0.x[edge + 1] - box0.x[edge];
+    const auto project = [&](const OrientedBoundingBox & box, const std::size_t i) {
+      return axis_x * box.x[i] + axis_y * box.y[i];
+    };
+    auto min0 = project(box0, 0), max0 = min0;
+    auto min1 = project(box1, 0), max1 = min1;
+    for (std::size_t i = 1; i < 4; ++i) {
+      min0 = std::min(min0, project(box0, i));
+      max0 = std::max(max0, project(box0, i));
+      min1 = std::min(min1, project(box1, i));
+      max1 = std::max(max1, project(box1, i));
+    }
+    if (max0 < min1 or max1 < min0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/// @return Squared distance from the corners of box0 to the edges of box1.
+auto getSquaredDistanceFromCornersToEdges(
+  const OrientedBoundingBox & box0, const OrientedBoundingBox & box1) -> double
+{
+  auto squared_distance = std::numeric_limits<double>::infinity();
+  for (std::size_t edge = 0; edge < 4; ++edge) {
+    const auto next = (edge + 1) % 4;
+    const auto edge_x = box1.x[next] - box1.x[edge];
+    const auto edge_y = box1.y[next] - box1.y[edge];
+    const auto squared_length = edge_x * edge_x + edge_y * edge_y;
+    for (std::size_t corner = 0; corner < 4; ++corner) {
+      const auto x = box0.x[corner] - box1.x[edge];
+      const auto y = box0.y[corner] - box1.y[edge];
+      const auto t = squared_length > 0.0
+                       ? std::clamp((x * edge_x + y * edge_y) / squared_length, 0.0, 1.0)
+                       : 0.0;
+      const auto dx = x - t * edge_x;
+      const auto dy = y - t * edge_y;
+      squared_distance = std::min(squared_distance, dx * dx + dy * dy);
+    }
+  }
+  return squared_distance;
+}
+}  // namespace
+
+OrientedBoundingBox::OrientedBoundingBox(
+  const geometry_msgs::msg::Pose & pose,
+  const traffic_simulator_msgs::msg::BoundingBox & bounding_box)
+: z(pose.position.z + bounding_box.center.z), height(bounding_box.dimensions.z)
+{
+  const auto distances = getDistancesFromCenterToEdge(bounding_box);
+  const std::array<double, 4> local_x = {
+    distances.front, distances.rear, distances.rear, distances.front};
+  const std::array<double, 4> local_y = {
+    distances.left, distances.left, distances.right, distances.right};
+  const auto rotation = getRotationMatrix(pose.orientation);
+  for (std::size_t i = 0; i < 4; ++i) {
+    x[i] = rotation(0, 0) * local_x[i] + rotation(0, 1) * local_y[i] +
+           rotation(0, 2) * distances.up + pose.position.x;
+    y[i] = rotation(1, 0) * local_x[i] + rotation(1, 1) * local_y[i] +
+           rotation(1, 2) * distances.up + pose.position.y;
+  }
+  const auto [min_x_iter, max_x_iter] = std::minmax_element(x.begin(), x.end());
+  const auto [min_y_iter, max_y_iter] = std::minmax_element(y.begin(), y.end());
+  min_x = *min_x_iter;
+  max_x = *max_x_iter;
+  min_y = *min_y_iter;
+  max_y = *max_y_iter;
+}
+
+auto OrientedBoundingBox::intersects(const OrientedBoundingBox & other) const -> bool
+{
+  /// @note The envelopes are the separating axes x and y, and reject most pairs cheaply.
+  return min_x <= other.max_x and other.min_x <= max_x and min_y <= other.max_y and
+         other.min_y <= max_y and not isSeparatedByEdgesOf(*this, other) and
+         not isSeparatedByEdgesOf(other, *this);
+}
+
+auto OrientedBoundingBox::getDistance(const OrientedBoundingBox & other) const
+  -> std::optional<double>
+{
+  if (intersects(other)) {
+    return std::nullopt;
+  }
+  return std::sqrt(std::min(
+    getSquaredDistanceFromCornersToEdges(*this, other),
+    getSquaredDistanceFromCornersToEdges(other, *this)));
+}
+}  // namespace geometry
+}  // namespace math
@@ -324,6 +324,25 @@ auto getLineSegments(
   }
 }
 
+LineSegmentArray::LineSegmentArray(const std::vector<LineSegment> & lines)
+{
+  start_x.reserve(lines.size());
+  start_y.reserve(lines.size());
+  end_x.reserve(lines.size());
+  end_y.reserve(lines.size());
+  for (const auto & line : lines) {
+    push_back(line);
+  }
+}
+
+auto LineSegmentArray::push_back(const LineSegment & line) -> void
+{
+  start_x.push_back(line.start_point.x);
+  start_y.push_back(line.start_point.y);
+  end_x.push_back(line.end_point.x);
+  end_y.push_back(line.end_point.y);
+}
+
 /**
  * @brief Checks if the given point lies within the bounding box of the line segment.
  * @param point Points you want to test.
@@ -48,92 +48,78 @@ auto PolynomialSolver::solveLinearEquation(
   const double a, const double b, const double min_value, const double max_value) const
   -> std::vector<double>
 {
-  const auto solve_without_limit = [this](const double a, const double b) -> std::vector<double> {
-    /// @note In this case, ax*b = 0 (a=0) can cause division by zero. So give special treatment to this case.
-    if (isApproximatelyEqualTo(a, 0)) {
-      if (isApproximatelyEqualTo(b, 0)) {
-        THROW_SIMULATION_ERROR(
-          "Not computable x because of the linear equation ", a, " x + ", b, "=0, and a = ", a,
-          ", b = ", b, " is very close to zero ,so any value of x will be the solution.",
-          "There are no expected cases where this exception is thrown.",
-          "Please contact the scenario_simulator_v2 developers, ",
-          "especially Masaya Kataoka (@hakuturu583).");
-      }
-      /// @note In this case, ax*b = 0 (a=0,b!=0) so any x cannot satisfy this equation.
-      return {};
-    }
-    /// @note In this case, ax*b = 0 (a!=0, b!=0) so x = -b/a is a only solution.
-    return {-b / a};
-  };
-
   /// @note No fallback because of the order cannot be lowered any further.
-  return filterByRange(solve_without_limit(a, b), min_value, max_value);
+  return toVector(filterByRange(solveLinearEquationWithoutLimit(a, b), min_value, max_value), a, b);
 }
 
 auto PolynomialSolver::solveQuadraticEquation(
   const double a, const double b, const double c, const double min_value,
   const double max_value) const -> std::vector<double>
 {
-  const auto solve_without_limit =
-    [this](const double a, const double b, const double c) -> std::vector<double> {
-    if (const double discriminant = b * b - 4 * a * c; isApproximatelyEqualTo(discriminant, 0)) {
-      return {-b / (2 * a)};
-    } else if (discriminant < 0) {
-      return {};
-    } else {
-      return {(-b - std::sqrt(discriminant)) / (2 * a), (-b + std::sqrt(discriminant)) / (2 * a)};
-    }
-  };
-
-  /// @note Fallback to linear equation solver if a = 0
-  return isApproximatelyEqualTo(a, 0)
-           ? solveLinearEquation(b, c, min_value, max_value)
-           : filterByRange(solve_without_limit(a, b, c), min_value, max_value);
+  return toVector(
+    filterByRange(solveQuadraticEquationWithoutLimit(a, b, c), min_value, max_value), b, c);
 }
 
 auto PolynomialSolver::solveCubicEquation(
   const double a, const double b, const double c, const double d, const double min_value,
   const double max_value) const -> std::vector<double>
 {
-  const auto solve_without_limit =
-    [this](const double a, const double b, const double c, const double d) {
-      /// @note Function that takes a std::vector of complex numbers and selects only real numbers from it and returns them
-      const auto get_real_values =
-        [](const std::vector<std::complex<double>> & complex_values) -> std::vector<double> {
-        /**
-         * @note Function that takes a complex number as input and returns the real part if it is a real number (imaginary part is 0) 
-         * or std::nullopt if it is an imaginary or complex number.
-         */
-        const auto is_real_value = [](const std::complex<double> & complex_value) {
-          constexpr double epsilon = std::numeric_limits<double>::epsilon();
-          return (std::abs(complex_value.imag()) <= epsilon)
-                   ? std::optional<double>(complex_value.real())
-                   : std::nullopt;
-        };
-        /// @note Iterate all complex values and check the value is real value or not.
-        std::vector<double> real_values = {};
-        std::for_each(
-          complex_values.begin(), complex_values.end(),
-          [&real_values, is_real_value](const auto & complex_value) mutable {
-            if (const auto real_value = is_real_value(complex_value)) {
-              real_values.push_back(real_value.value());
-            }
-          });
-        return real_values;
-      };
-      /// @note Finds the complex solution of the monic cubic equation and returns only those that are real numbers.
-      return get_real_values(solveMonicCubicEquationWithComplex(b / a, c / a, d / a));
-    };
+  return toVector(solveCubicEquation({a, b, c, d}, min_value, max_value), c, d);
+}
 
+auto PolynomialSolver::solveCubicEquation(
+  const CubicCoefficients & coefficients, const double min_value, const double max_value) const
+  -> Solutions
+{
+  const auto & [a, b, c, d] = coefficients;
+  return filterByRange(solveCubicEquationWithoutLimit(a, b, c, d), min_value, max_value);
+}
+
+auto PolynomialSolver::solveLinearEquationWithoutLimit(const double a, const double b) const
+  -> Solutions
+{
+  Solutions solutions;
+  /// @note In this case, ax*b = 0 (a=0) can cause division by zero. So give special treatment to this case.
+  if (isApproximatelyEqualTo(a, 0)) {
+    /**
+     * @note In this case, ax*b = 0 (a=0,b=0) so any x value will be the solution,
+     * or ax*b = 0 (a=0,b!=0) so any x cannot satisfy this equation.
+     */
+    solutions.indeterminate = isApproximatelyEqualTo(b, 0);
+    return solutions;
+  }
+  /// @note In this case, ax*b = 0 (a!=0, b!=0) so x = -b/a is a only solution.
+  solutions.push_back(-b / a);
+  return solutions;
+}
+
+auto PolynomialSolver::solveQuadraticEquationWithoutLimit(
+  const double a, const double b, const double c) const -> Solutions
+{
+  /// @note Fallback to linear equation solver if a = 0
+  if (isApproximatelyEqualTo(a, 0)) {
+    return solveLinearEquationWithoutLimit(b, c);
+  }
+  Solutions solutions;
+  if (const double discriminant = b * b - 4 * a * c; isApproximatelyEqualTo(discriminant, 0)) {
+    solutions.push_back(-b / (2 * a));
+  } else if (discriminant > 0) {
+    solutions.push_back((-b - std::sqrt(discriminant)) / (2 * a));
+    solutions.push_back((-b + std::sqrt(discriminant)) / (2 * a));
+  }
+  return solutions;
+}
+
+auto PolynomialSolver::solveCubicEquationWithoutLimit(
+  const double a, const double b, const double c, const double d) const -> Solutions
+{
   /// @note Fallback to quadratic equation solver if a = 0
-  return isApproximatelyEqualTo(a, 0)
-           ? solveQuadraticEquation(b, c, d, min_value, max_value)
-           : filterByRange(solve_without_limit(a, b, c, d), min_value, max_value);
+  return isApproximatelyEqualTo(a, 0) ? solveQuadraticEquationWithoutLimit(b, c, d)
+                                      : solveMonicCubicEquation(b / a, c / a, d / a);
 }
 
 auto PolynomialSolver::filterByRange(
-  const std::vector<double> & values, const double min_value, const double max_value) const
-  -> std::vector<double>
+  const Solutions & values, const double min_value, const double max_value) const -> Solutions
 {
   /**
    * @note Function to check if value exists between [min_value,max_value] considering the tolerance,
@@ -150,79 +136,75 @@ auto PolynomialSolver::filterByRange(
     return std::optional<double>();
   };
   /// @note Iterate values and check the value is in range or not.
-  std::vector<double> filtered_values = {};
-  std::for_each(
-    values.begin(), values.end(),
-    [&filtered_values, is_in_range, min_value, max_value](const double value) mutable {
-      if (const auto filtered_value = is_in_range(value, min_value, max_value)) {
-        filtered_values.push_back(filtered_value.value());
-      }
-    });
+  Solutions filtered_values;
+  filtered_values.indeterminate = values.indeterminate;
+  for (const double value : values) {
+    if (const auto filtered_value = is_in_range(value, min_value, max_value)) {
+      filtered_values.push_back(filtered_value.value());
+    }
+  }
   return filtered_values;
 }
 
+auto PolynomialSolver::toVector(const Solutions & solutions, const double a, const double b) const
+  -> std::vector<double>
+{
+  if (solutions.indeterminate) {
+    THROW_SIMULATION_ERROR(
+      "Not computable x because of the linear equation ", a, " x + ", b, "=0, and a = ", a,
+      ", b = ", b, " is very close to zero ,so any value of x will be the solution.",
+      "There are no expected cases where this exception is thrown.",
+      "Please contact the scenario_simulator_v2 developers, ",
+      "especially Masaya Kataoka (@hakuturu583).");
+  }
+  return std::vector<double>(solutions.begin(), solutions.end());
+}
+
 /// @note this code is public domain (http://math.ivanovo.ac.ru/dalgebra/Khashin/poly/index.html)
-auto PolynomialSolver::solveMonicCubicEquationWithComplex(
-  const double a, const double b, const double c) const -> std::vector<std::complex<double>>
+auto PolynomialSolver::solveMonicCubicEquation(const double a, const double b, const double c) const
+  -> Solutions
 {
   /**
    * @note Tschirnhaus transformation, transform into x^3 + 3q*x + 2r = 0
    * @sa https://oshima-gakushujuku.com/blog/math/formula-qubic-equation/
    */
-  const auto tschirnhaus_transformation = [](const auto a, const auto b, const auto c) {
-    /// @note The first element of the return value is q, the second element is r
-    return std::tuple<double, double>((a * a - 3 * b) / 9, (a * (2 * a * a - 9 * b) + 27 * c) / 54);
-  };
+  const double q = (a * a - 3 * b) / 9;
+  const double r = (a * (2 * a * a - 9 * b) + 27 * c) / 54;
 
-  const auto solve_without_limit =
+  Solutions solutions;
+  if (const double q3 = q * q * q; r * r <= (q3 + tolerance)) {
+    /**
+     * @note If 3 real solutions are found.
+     * The URL specified in @sa is a reference material for developers who wish to follow the formulas,
+     * and the code that exists in the material is not included in this library.
+     * @sa https://onihusube.hatenablog.com/entry/2018/10/08/140426
+     */
+    const double t = std::acos(std::clamp(r / std::sqrt(q3), -1.0, 1.0));
     // clang-format off
-    [this, a](const auto q, const auto r) -> std::vector<std::complex<double>> {
+    solutions.push_back(-2 * std::sqrt(q) * std::cos( t                                             / 3) - a / 3);
+    solutions.push_back(-2 * std::sqrt(q) * std::cos((t + boost::math::constants::two_pi<double>()) / 3) - a / 3);
+    solutions.push_back(-2 * std::sqrt(q) * std::cos((t - boost::math::constants::two_pi<double>()) / 3) - a / 3);
     // clang-format on
-    if (const double q3 = q * q * q; r * r <= (q3 + tolerance)) {
-      /**
-       * @note If 3 real solutions are found.
-       * The URL specified in @sa is a reference material for developers who wish to follow the formulas,
-       * and the code that exists in the material is not included in this library.
-       * @sa https://onihusube.hatenablog.com/entry/2018/10/08/140426
-       */
-      const double t = std::acos(std::clamp(r / std::sqrt(q3), -1.0, 1.0));
-      return {
-        // clang-format off
-        std::complex<double>(-2 * std::sqrt(q) * std::cos( t                                             / 3) - a / 3, 0),
-        std::complex<double>(-2 * std::sqrt(q) * std::cos((t + boost::math::constants::two_pi<double>()) / 3) - a / 3, 0),
-        std::complex<double>(-2 * std::sqrt(q) * std::cos((t - boost::math::constants::two_pi<double>()) / 3) - a / 3, 0)
-        // clang-format on
+  } else {
+    /// @note If imaginary solutions exist.
+    const double A = [r, q3]() {
+      const auto calculate_real_solution = [r, q3]() {
+        return -std::cbrt(std::abs(r) + std::sqrt(r * r - q3));
       };
-    } else {
-      /// @note If imaginary solutions exist.
-      const double A = [r, q3]() {
-        const auto calculate_real_solution = [r, q3]() {
-          return -std::cbrt(std::abs(r) + std::sqrt(r * r - q3));
-        };
-        return r < 0 ? -1 * calculate_real_solution() : calculate_real_solution();
-      }();
-      const double B = isApproximatelyEqualTo(A, 0) ? 0 : q / A;
-      /// @note If the imaginary part of the complex almost zero, this equation has a multiple solution.
-      const double imaginary_part = 0.5 * std::sqrt(3.0) * (A - B);
-      return isApproximatelyEqualTo(imaginary_part, 0)
-               ? std::vector<std::complex<double>>({
-                   // clang-format off
-                    std::complex<double>(       (A + B) - a / 3, 0),
-                    std::complex<double>(-0.5 * (A + B) - a / 3, 0)
-                   // clang-format on
-                 })
-               : std::vector<std::complex<double>>({
-                   // clang-format off
-                    std::complex<double>(       (A + B) - a / 3,               0),
-                    std::complex<double>(-0.5 * (A + B) - a / 3, -imaginary_part),
-                    std::complex<double>(-0.5 * (A + B) - a / 3,  imaginary_part)
-                   // clang-format on
-                 });
+      return r < 0 ? -1 * calculate_real_solution() : calculate_real_solution();
+    }();
+    const double B = isApproximatelyEqualTo(A, 0) ? 0 : q / A;
+    solutions.push_back((A + B) - a / 3);
+    /**
+     * @note If the imaginary part of the complex almost zero, this equation has a multiple
+     * solution. Otherwise the other two solutions are complex and dropped.
+     */
+    if (const double imaginary_part = 0.5 * std::sqrt(3.0) * (A - B);
+        isApproximatelyEqualTo(imaginary_part, 0)) {
+      solutions.push_back(-0.5 * (A + B) - a / 3);
     }
-    /// @note No solutions are found.
-    return {};
-  };
-  return std::apply(solve_without_limit, tschirnhaus_transformation(a, b, c));
+  }
+  return solutions;
 }
 
 auto PolynomialSolver::isApproximatelyEqualTo(const double value0, const double value1) const
@@ -12,7 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <geometry/spline/catmull_rom_spline.hpp>
+#include <geometry/transform.hpp>
 #include <iostream>
 #include <limits>
 #include <optional>
@@ -103,24 +105,54 @@ auto CatmullRomSpline::getTrajectory(
   const double start_s, const double end_s, const double resolution, const double offset) const
   -> std::vector<geometry_msgs::msg::Point>
 {
+  std::vector<geometry_msgs::msg::Point> ret;
+  getTrajectory(start_s, end_s, resolution, offset, ret);
+  return ret;
+}
+
+auto CatmullRomSpline::getTrajectory(
+  const double start_s, const double end_s, const double resolution, const double offset,
+  std::vector<geometry_msgs::msg::Point> & trajectory) const -> void
+{
+  trajectory.clear();
+  /**
+   * @note Without offset, points are evaluated directly from the coefficients of the curves,
+   * starting the search of the curve containing s from the one of the previous point.
+   */
+  if (offset == 0.0 and control_points.size() >= 3) {
+    size_t curve_index = 0;
+    const auto get_point = [this, &curve_index](const double s) {
+      return getPoint(getCurveIndexAndS(s, curve_index));
+    };
+    double s = start_s;
+    if (start_s > end_s) {
+      while (s > end_s) {
+        trajectory.emplace_back(get_point(s));
+        s = s - std::fabs(resolution);
+      }
+    } else {
+      while (s < end_s) {
+        trajectory.emplace_back(get_point(s));
+        s = s + std::fabs(resolution);
+      }
+    }
+    trajectory.emplace_back(get_point(end_s));
+    return;
+  }
   if (start_s > end_s) {
-    std::vector<geometry_msgs::msg::Point> ret;
     double s = start_s;
     while (s > end_s) {
-      ret.emplace_back(getPoint(s, offset));
+      trajectory.emplace_back(getPoint(s, offset));
       s = s - std::fabs(resolution);
     }
-    ret.emplace_back(getPoint(end_s, offset));
-    return ret;
+    trajectory.emplace_back(getPoint(end_s, offset));
   } else {
-    std::vector<geometry_msgs::msg::Point> ret;
     double s = start_s;
     while (s < end_s) {
-      ret.emplace_back(getPoint(s, offset));
+      trajectory.emplace_back(getPoint(s, offset));
       s = s + std::fabs(resolution);
     }
-    ret.emplace_back(getPoint(end_s, offset));
-    return ret;
+    trajectory.emplace_back(getPoint(end_s, offset));
   }
 }
 
@@ -144,7 +176,15 @@ CatmullRomSpline::CatmullRomSpline(const std::vector<geometry_msgs::msg::Point>
     /// @note In this case, spline is interpreted as curve.
     default:
       [this](const auto & control_points) -> void {
+        const auto append_curve = [this](
+                                    double ax, double bx, double cx, double dx, double ay,
+                                    double by, double cy, double dy, double az, double bz,
+                                    double cz, double dz) {
+          curves_.emplace_back(ax, bx, cx, dx, ay, by, cy, dy, az, bz, cz, dz);
+          coefficients_.append(ax, bx, cx, dx, ay, by, cy, dy, az, bz, cz, dz);
+        };
         size_t n = control_points.size() - 1;
+        coefficients_.reserve(n);
         for (size_t i = 0; i < n; i++) {
           if (i == 0) {
             double ax = 0;
@@ -171,7 +211,7 @@ CatmullRomSpline::CatmullRomSpline(const std::vector<geometry_msgs::msg::Point>
             bz = bz * 0.5;
             cz = cz * 0.5;
             dz = dz * 0.5;
-            curves_.emplace_back(ax, bx, cx, dx, ay, by, cy, dy, az, bz, cz, dz);
+            append_curve(ax, bx, cx, dx, ay, by, cy, dy, az, bz, cz, dz);
           } else if (i == (n - 1)) {
             double ax = 0;
             double bx = control_points[i - 1].x - 2 * control_points[i].x + control_points[i + 1].x;
@@ -197,7 +237,7 @@ CatmullRomSpline::CatmullRomSpline(const std::vector<geometry_msgs::msg::Point>
             bz = bz * 0.5;
             cz = cz * 0.5;
             dz = dz * 0.5;
-            curves_.emplace_back(ax, bx, cx, dx, ay, by, cy, dy, az, bz, cz, dz);
+            append_curve(ax, bx, cx, dx, ay, by, cy, dy, az, bz, cz, dz);
           } else {
             double ax = -1 * control_points[i - 1].x + 3 * control_points[i].x -
                         3 * control_points[i + 1].x + control_points[i + 2].x;
@@ -229,17 +269,16 @@ CatmullRomSpline::CatmullRomSpline(const std::vector<geometry_msgs::msg::Point>
             bz = bz * 0.5;
             cz = cz * 0.5;
             dz = dz * 0.5;
-            curves_.emplace_back(ax, bx, cx, dx, ay, by, cy, dy, az, bz, cz, dz);
+            append_curve(ax, bx, cx, dx, ay, by, cy, dy, az, bz, cz, dz);
           }
         }
+        accumulated_lengths_.emplace_back(0);
         for (const auto & curve : curves_) {
           length_list_.emplace_back(curve.getLength());
           maximum_2d_curvatures_.emplace_back(curve.getMaximum2DCurvature());
+          accumulated_lengths_.emplace_back(accumulated_lengths_.back() + curve.getLength());
         }
-        total_length_ = 0;
-        for (const auto & length : length_list_) {
-          total_length_ = total_length_ + length;
-        }
+        total_length_ = accumulated_lengths_.back();
         checkConnection();
       }(control_points);
       break;
@@ -255,27 +294,52 @@ auto CatmullRomSpline::getCurveIndexAndS(const double s) const -> std::pair<size
     return std::make_pair(
       curves_.size() - 1, s - (total_length_ - curves_[curves_.size() - 1].getLength()));
   }
-  double current_s = 0;
-  for (size_t i = 0; i < curves_.size(); i++) {
-    double prev_s = current_s;
-    current_s = current_s + length_list_[i];
-    if (prev_s <= s && s < current_s) {
-      return std::make_pair(i, s - prev_s);
-    }
+  /// @note The curve containing s is the last one starting at or before s.
+  if (const auto iter =
+        std::upper_bound(accumulated_lengths_.begin(), accumulated_lengths_.end(), s);
+      iter != accumulated_lengths_.begin() and iter != accumulated_lengths_.end()) {
+    const auto index = static_cast<size_t>(std::distance(accumulated_lengths_.begin(), iter)) - 1;
+    return std::make_pair(index, s - accumulated_lengths_[index]);
   }
   THROW_SIMULATION_ERROR("failed to calculate curve index");  // LCOV_EXCL_LINE
 }
 
+auto CatmullRomSpline::getCurveIndexAndS(const double s, size_t & curve_index) const
+  -> std::pair<size_t, double>
+{
+  if (s < 0 or s >= total_length_) {
+    return getCurveIndexAndS(s);
+  }
+  /// @note Same curve as getCurveIndexAndS(s) finds, the last one starting at or before s.
+  curve_index = std::min(curve_index, curves_.size() - 1);
+  while (accumulated_lengths_[curve_index + 1] <= s) {
+    ++curve_index;
+  }
+  while (accumulated_lengths_[curve_index] > s) {
+    --curve_index;
+  }
+  return std::make_pair(curve_index, s - accumulated_lengths_[curve_index]);
+}
+
+auto CatmullRomSpline::getPoint(const std::pair<size_t, double> & index_and_s) const
+  -> geometry_msgs::msg::Point
+{
+  /// @note Same as HermiteCurve::getPoint with denormalize_s = true.
+  const auto & [i, s_in_curve] = index_and_s;
+  const auto s = s_in_curve / length_list_[i];
+  const auto s2 = s * s;
+  const auto s3 = s2 * s;
+  const auto & [x, y, z] = coefficients_.axes;
+  return geometry_msgs::build<geometry_msgs::msg::Point>()
+    .x(x.a[i] * s3 + x.b[i] * s2 + x.c[i] * s + x.d[i])
+    .y(y.a[i] * s3 + y.b[i] * s2 + y.c[i] * s + y.d[i])
+    .z(z.a[i] * s3 + z.b[i] * s2 + z.c[i] * s + z.d[i]);
+}
+
 auto CatmullRomSpline::getSInSplineCurve(const size_t curve_index, const double s) const -> double
 {
-  size_t n = curves_.size();
-  double ret = 0;
-  for (size_t i = 0; i < n; i++) {
-    if (i == curve_index) {
-      return ret + s;
-    } else {
-      ret = ret + curves_[i].getLength();
-    }
+  if (curve_index < curves_.size()) {
+    return accumulated_lengths_[curve_index] + s;
   }
   THROW_SEMANTIC_ERROR("curve index does not match");  // LCOV_EXCL_LINE
 }
@@ -295,7 +359,8 @@ auto CatmullRomSpline::getCollisionPointsIn2D(
   const auto get_collision_point_2d_with_curve =
     [this](const auto & polygon, const auto search_backward) -> std::set<double> {
     std::set<double> s_value_candidates;
-    for (size_t i = 0; i < curves_.size(); ++i) {
+    for (const auto i :
+         getCurveBoundingHierarchy().query(CurveBoundingHierarchy::getBox(polygon))) {
       /// @note The polygon is assumed to be closed
       const auto s = curves_[i].getCollisionPointsIn2D(polygon, search_backward, true, true);
       std::for_each(s.begin(), s.end(), [&s_value_candidates, i, this](const auto & s) {
@@ -362,6 +427,22 @@ auto CatmullRomSpline::getCollisionPointIn2D(
   const std::vector<geometry_msgs::msg::Point> & polygon, const bool search_backward) const
   -> std::optional<double>
 {
+  /**
+   * @note The s values of a curve are not less than the ones of the curves before it, so the first
+   * curve colliding in the search direction has the answer, and no set of candidates is needed.
+   */
+  if (control_points.size() >= 3 and polygon.size() >= 2) {
+    std::optional<double> s_value;
+    getCurveBoundingHierarchy().find(
+      CurveBoundingHierarchy::getBox(polygon), search_backward, [&](const auto i) {
+        /// @note The polygon is assumed to be closed
+        if (const auto s = curves_[i].getCollisionPointIn2D(polygon, search_backward, true, true)) {
+          s_value = getSInSplineCurve(i, s.value());
+        }
+        return s_value.has_value();
+      });
+    return s_value;
+  }
   std::set<double> s_value_candidates = getCollisionPointsIn2D(polygon, search_backward);
   if (s_value_candidates.empty()) {
     return std::nullopt;
@@ -376,25 +457,15 @@ auto CatmullRomSpline::getCollisionPointIn2D(
   const geometry_msgs::msg::Point & point0, const geometry_msgs::msg::Point & point1,
   const bool search_backward) const -> std::optional<double>
 {
-  size_t n = curves_.size();
-  if (search_backward) {
-    for (size_t i = 0; i < n; i++) {
-      auto s = curves_[n - 1 - i].getCollisionPointIn2D(point0, point1, search_backward, true);
-      if (s) {
-        return getSInSplineCurve(n - 1 - i, s.value());
-      }
-    }
-    return std::nullopt;
-  } else {
-    for (size_t i = 0; i < n; i++) {
-      auto s = curves_[i].getCollisionPointIn2D(point0, point1, search_backward, true);
-      if (s) {
-        return getSInSplineCurve(i, s.value());
+  std::optional<double> s_value;
+  getCurveBoundingHierarchy().find(
+    CurveBoundingHierarchy::getBox(point0, point1), search_backward, [&](const auto i) {
+      if (const auto s = curves_[i].getCollisionPointIn2D(point0, point1, search_backward, true)) {
+        s_value = getSInSplineCurve(i, s.value());
       }
-    }
-    return std::nullopt;
-  }
-  return std::nullopt;
+      return s_value.has_value();
+    });
+  return s_value;
 }
 
 auto CatmullRomSpline::getSValue(
@@ -426,17 +497,21 @@ auto CatmullRomSpline::getSValue(
           "contact the developer of traffic_simulator.");
       }
       return line_segments_[0].getSValue(pose, threshold_distance, true);
-    default:
-      double s = 0;
-      for (size_t i = 0; i < curves_.size(); i++) {
-        auto s_value = curves_[i].getSValue(pose, threshold_distance, true);
-        if (s_value) {
-          s = s + s_value.value();
-          return s;
-        }
-        s = s + curves_[i].getLength();
-      }
-      return std::nullopt;
+    default: {
+      /// @note Same line segment as the one HermiteCurve::getSValue intersects with the curve.
+      const auto line = transformPoints(
+        pose, {geometry_msgs::build<geometry_msgs::msg::Point>().x(0).y(threshold_distance).z(0),
+               geometry_msgs::build<geometry_msgs::msg::Point>().x(0).y(-threshold_distance).z(0)});
+      std::optional<double> s;
+      getCurveBoundingHierarchy().find(
+        CurveBoundingHierarchy::getBox(line[0], line[1]), false, [&](const auto i) {
+          if (const auto s_value = curves_[i].getSValue(pose, threshold_distance, true)) {
+            s = getSInSplineCurve(i, s_value.value());
+          }
+          return s.has_value();
+        });
+      return s;
+    }
   }
 }
 
@@ -543,8 +618,7 @@ auto CatmullRomSpline::getPoint(const double s) const -> geometry_msgs::msg::Poi
       }
       return line_segments_[0].getPoint(s, true);
     default:
-      const auto index_and_s = getCurveIndexAndS(s);
-      return curves_[index_and_s.first].getPoint(index_and_s.second, true);
+      return getPoint(getCurveIndexAndS(s));
   }
 }
 
@@ -671,6 +745,19 @@ auto CatmullRomSpline::getPose(const double s, const bool fill_pitch) const
   }
 }
 
+auto CatmullRomSpline::getCurveBoundingHierarchy() const -> const CurveBoundingHierarchy &
+{
+  auto hierarchy = std::atomic_load(&curve_bounding_hierarchy_);
+  if (not hierarchy) {
+    /// @note Concurrent queries may both build it, but only the first one is stored and kept.
+    auto built = std::make_shared<const CurveBoundingHierarchy>(curves_);
+    if (std::atomic_compare_exchange_strong(&curve_bounding_hierarchy_, &hierarchy, built)) {
+      hierarchy = built;
+    }
+  }
+  return *hierarchy;
+}
+
 auto CatmullRomSpline::checkConnection() const -> bool
 {
   if (control_points.size() != (curves_.size() + 1)) {
@@ -0,0 +1,114 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <geometry/spline/curve_bounding_hierarchy.hpp>
+#include <limits>
+
+namespace math
+{
+namespace geometry
+{
+namespace
+{
+auto merge(const CurveBoundingHierarchy::Box & lhs, const CurveBoundingHierarchy::Box & rhs)
+  -> CurveBoundingHierarchy::Box
+{
+  return {
+    std::min(lhs.min_x, rhs.min_x), std::min(lhs.min_y, rhs.min_y), std::max(lhs.max_x, rhs.max_x),
+    std::max(lhs.max_y, rhs.max_y)};
+}
+}  // namespace
+
+auto CurveBoundingHierarchy::getBox(const HermiteCurve & curve) -> Box
+{
+  /**
+   * @note A cubic curve lies inside the convex hull of its Bezier control points, which are the end
+   * points and the end points moved by a third of the tangent vectors.
+   */
+  const auto start = curve.getPoint(0.0, false);
+  const auto goal = curve.getPoint(1.0, false);
+  const auto start_tangent = curve.getTangentVector(0.0, false);
+  const auto goal_tangent = curve.getTangentVector(1.0, false);
+  auto box = getBox(
+    {start, goal,
+     geometry_msgs::build<geometry_msgs::msg::Point>()
+       .x(start.x + start_tangent.x / 3.0)
+       .y(start.y + start_tangent.y / 3.0)
+       .z(0.0),
+     geometry_msgs::build<geometry_msgs::msg::Point>()
+       .x(goal.x - goal_tangent.x / 3.0)
+       .y(goal.y - goal_tangent.y / 3.0)
+       .z(0.0)});
+  /**
+   * @note Margin for the rounding errors of the collision check, which accepts points on the
+   * boundary. Hard coded parameter.
+   */
+  constexpr double margin = 1e-3;
+  box.min_x -= margin;
+  box.min_y -= margin;
+  box.max_x += margin;
+  box.max_y += margin;
+  return box;
+}
+
+auto CurveBoundingHierarchy::getBox(const std::vector<geometry_msgs::msg::Point> & points) -> Box
+{
+  Box box = {
+    std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(),
+    -std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()};
+  for (const auto & point : points) {
+    box = merge(box, {point.x, point.y, point.x, point.y});
+  }
+  return box;
+}
+
+auto CurveBoundingHierarchy::getBox(
+  const geometry_msgs::msg::Point & point0, const geometry_msgs::msg::Point & point1) -> Box
+{
+  return merge({point0.x, point0.y, point0.x, point0.y}, {point1.x, point1.y, point1.x, point1.y});
+}
+
+CurveBoundingHierarchy::CurveBoundingHierarchy(const std::vector<HermiteCurve> & curves)
+{
+  if (curves.empty()) {
+    return;
+  }
+  auto & leaves = levels_.emplace_back();
+  leaves.reserve(curves.size());
+  for (const auto & curve : curves) {
+    leaves.push_back(getBox(curve));
+  }
+  while (levels_.back().size() > 1) {
+    const auto & lower = levels_.back();
+    std::vector<Box> upper;
+    upper.reserve((lower.size() + 1) / 2);
+    for (std::size_t i = 0; i < lower.size(); i += 2) {
+      upper.push_back(i + 1 < lower.size() ? merge(lower[i], lower[i + 1]) : lower[i]);
+    }
+    levels_.push_back(std::move(upper));
+  }
+}
+
+auto CurveBoundingHierarchy::query(const Box & box) const -> std::vector<std::size_t>
+{
+  std::vector<std::size_t> curve_indices;
+  find(box, false, [&curve_indices](const auto curve_index) {
+    curve_indices.push_back(curve_index);
+    return false;
+  });
+  return curve_indices;
+}
+}  // namespace geometry
+}  // namespace math
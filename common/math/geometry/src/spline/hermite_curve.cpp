@@ -84,25 +84,48 @@ geometry_msgs::msg::Vector3 HermiteCurve::getSquaredDistanceVector(
   return ret;
 }
 
-std::set<double> HermiteCurve::getCollisionPointsIn2D(
+template <typename Function>
+void HermiteCurve::forEachCollisionPointIn2D(
   const std::vector<geometry_msgs::msg::Point> & polygon, bool search_backward,
-  bool close_start_end, bool denormalize_s) const
+  bool close_start_end, bool denormalize_s, Function && function) const
 {
   size_t n = polygon.size();
   if (n <= 1) {
-    return {};
+    return;
   }
-  std::set<double> s_values;
-  for (size_t i = 0; i < (n - 1); i++) {
-    const auto p0 = polygon[i];
-    const auto p1 = polygon[i + 1];
-    s_values.merge(getCollisionPointsIn2D(p0, p1, search_backward, denormalize_s));
-  }
-  if (close_start_end) {
-    const auto p0 = polygon[n - 1];
-    const auto p1 = polygon[0];
-    s_values.merge(getCollisionPointsIn2D(p0, p1, search_backward, denormalize_s));
+  /**
+   * @note The edge i is from polygon[i] to polygon[(i + 1) % n]. Edges are solved in batches of
+   * fixed size, so that no buffer is allocated for them.
+   */
+  constexpr size_t batch_size = 8;
+  const size_t edge_count = close_start_end ? n : n - 1;
+  std::array<PolynomialSolver::CubicCoefficients, batch_size> coefficients;
+  std::array<PolynomialSolver::Solutions, batch_size> solutions;
+  for (size_t first = 0; first < edge_count; first += batch_size) {
+    const size_t size = std::min(batch_size, edge_count - first);
+    for (size_t i = 0; i < size; i++) {
+      coefficients[i] = getCollisionCoefficients(polygon[first + i], polygon[(first + i + 1) % n]);
+    }
+    solver_.solveCubicEquations(
+      coefficients.begin(), coefficients.begin() + size, solutions.begin(), 0, 1);
+    for (size_t i = 0; i < size; i++) {
+      for (const auto s : filterCollisionPointsIn2D(
+             polygon[first + i], polygon[(first + i + 1) % n], solutions[i], search_backward,
+             denormalize_s)) {
+        function(s);
+      }
+    }
   }
+}
+
+std::set<double> HermiteCurve::getCollisionPointsIn2D(
+  const std::vector<geometry_msgs::msg::Point> & polygon, bool search_backward,
+  bool close_start_end, bool denormalize_s) const
+{
+  std::set<double> s_values;
+  forEachCollisionPointIn2D(
+    polygon, search_backward, close_start_end, denormalize_s,
+    [&s_values](const double s) { s_values.insert(s); });
   return s_values;
 }
 
@@ -110,21 +133,58 @@ std::optional<double> HermiteCurve::getCollisionPointIn2D(
   const std::vector<geometry_msgs::msg::Point> & polygon, bool search_backward,
   bool close_start_end, bool denormalize_s) const
 {
-  auto s_values = getCollisionPointsIn2D(polygon, search_backward, close_start_end, denormalize_s);
-  if (s_values.empty()) {
+  std::optional<double> s_value;
+  forEachCollisionPointIn2D(
+    polygon, search_backward, close_start_end, denormalize_s,
+    [&s_value, search_backward](const double s) {
+      if (!s_value || (search_backward ? s > s_value.value() : s < s_value.value())) {
+        s_value = s;
+      }
+    });
+  return s_value;
+}
+
+std::set<double> HermiteCurve::getCollisionPointsIn2D(
+  const geometry_msgs::msg::Point & point0, const geometry_msgs::msg::Point & point1,
+  bool search_backward, bool denormalize_s) const
+{
+  std::array<double, 3> s_values;
+  const auto size =
+    getCollisionPointsIn2D(point0, point1, s_values, search_backward, denormalize_s);
+  return std::set<double>(s_values.begin(), s_values.begin() + size);
+}
+
+size_t HermiteCurve::getCollisionPointsIn2D(
+  const geometry_msgs::msg::Point & point0, const geometry_msgs::msg::Point & point1,
+  std::array<double, 3> & s_values, bool search_backward, bool denormalize_s) const
+{
+  const auto solutions = filterCollisionPointsIn2D(
+    point0, point1, solver_.solveCubicEquation(getCollisionCoefficients(point0, point1), 0, 1),
+    search_backward, denormalize_s);
+  std::copy(solutions.begin(), solutions.end(), s_values.begin());
+  std::sort(s_values.begin(), s_values.begin() + solutions.size);
+  return std::unique(s_values.begin(), s_values.begin() + solutions.size) - s_values.begin();
+}
+
+std::optional<double> HermiteCurve::getCollisionPointIn2D(
+  const geometry_msgs::msg::Point & point0, const geometry_msgs::msg::Point & point1,
+  bool search_backward, bool denormalize_s) const
+{
+  std::array<double, 3> s_values;
+  const auto size =
+    getCollisionPointsIn2D(point0, point1, s_values, search_backward, denormalize_s);
+  if (size == 0) {
     return std::nullopt;
   }
   if (search_backward) {
-    return *s_values.rbegin();
+    return s_values[size - 1];
   }
-  return *s_values.begin();
+  return s_values[0];
 }
 
-std::set<double> HermiteCurve::getCollisionPointsIn2D(
-  const geometry_msgs::msg::Point & point0, const geometry_msgs::msg::Point & point1,
-  bool search_backward, bool denormalize_s) const
+PolynomialSolver::CubicCoefficients HermiteCurve::getCollisionCoefficients(
+  const geometry_msgs::msg::Point & point0, const geometry_msgs::msg::Point & point1) const
 {
-  std::set<double> s_values;
   double fx = point0.x;
   double ex = (point1.x - point0.x);
   double fy = point0.y;
@@ -133,24 +193,24 @@ std::set<double> HermiteCurve::getCollisionPointsIn2D(
   double b = by_ * ex - bx_ * ey;
   double c = cy_ * ex - cx_ * ey;
   double d = dy_ * ex - dx_ * ey - ex * fy + ey * fx;
+  return {a, b, c, d};
+}
 
-  const auto get_solutions = [search_backward, a, b, c, d, this]() -> std::vector<double> {
-    try {
-      /**
-       * @note Obtain a solution to the cubic equation ax^3 + bx^2 + cx + d = 0 that falls within the range [0, 1].
-       */
-      return solver_.solveCubicEquation(a, b, c, d, 0, 1);
-    }
-    /**
-     * @note PolynomialSolver::solveCubicEquation throws common::SimulationError when any x value can satisfy the equation, 
-     * so the beginning and end point of this curve can collide with the line segment.
-     * If search_backward = true, the line segment collisions at the end of the curve. So return 1.
-     * If search_backward = false, the line segment collisions at the start of the curve. So return 0.
-     */
-    catch (const common::SimulationError &) {
-      return {search_backward ? 1.0 : 0.0};
-    }
-  };
+PolynomialSolver::Solutions HermiteCurve::filterCollisionPointsIn2D(
+  const geometry_msgs::msg::Point & point0, const geometry_msgs::msg::Point & point1,
+  const PolynomialSolver::Solutions & solutions, bool search_backward, bool denormalize_s) const
+{
+  /**
+   * @note The solutions are indeterminate when any x value can satisfy the equation,
+   * so the beginning and end point of this curve can collide with the line segment.
+   * If search_backward = true, the line segment collisions at the end of the curve. So return 1.
+   * If search_backward = false, the line segment collisions at the start of the curve. So return 0.
+   */
+  PolynomialSolver::Solutions candidates = solutions;
+  if (solutions.indeterminate) {
+    candidates = {};
+    candidates.push_back(search_backward ? 1.0 : 0.0);
+  }
 
   /**
    * @note Denormalize given S value as necessary
@@ -162,7 +222,8 @@ std::set<double> HermiteCurve::getCollisionPointsIn2D(
     return s;
   };
 
-  for (const auto solution : get_solutions()) {
+  PolynomialSolver::Solutions s_values;
+  for (const auto solution : candidates) {
     constexpr double epsilon = std::numeric_limits<double>::epsilon();
     double x = solver_.cubic(ax_, bx_, cx_, dx_, solution);
     double tx = (x - point0.x) / (point1.x - point0.x);
@@ -174,31 +235,17 @@ std::set<double> HermiteCurve::getCollisionPointsIn2D(
        * tx, ty, will be in the range [0, 1] while the other will be out of that range because of division by zero.
        */
       if ((0 <= tx && tx <= 1) || (0 <= ty && ty <= 1)) {
-        s_values.insert(denormalize(solution));
+        s_values.push_back(denormalize(solution));
       }
     } else {
       if ((0 <= tx && tx <= 1) && (0 <= ty && ty <= 1)) {
-        s_values.insert(denormalize(solution));
+        s_values.push_back(denormalize(solution));
       }
     }
   }
   return s_values;
 }
 
-std::optional<double> HermiteCurve::getCollisionPointIn2D(
-  const geometry_msgs::msg::Point & point0, const geometry_msgs::msg::Point & point1,
-  bool search_backward, bool denormalize_s) const
-{
-  auto s_values = getCollisionPointsIn2D(point0, point1, search_backward, denormalize_s);
-  if (s_values.empty()) {
-    return std::nullopt;
-  }
-  if (search_backward) {
-    return *s_values.rbegin();
-  }
-  return *s_values.begin();
-}
-
 std::optional<double> HermiteCurve::getSValue(
   const geometry_msgs::msg::Pose & pose, double threshold_distance, bool denormalize_s) const
 {
@@ -219,23 +266,29 @@ std::optional<double> HermiteCurve::getSValue(
 const std::vector<geometry_msgs::msg::Point> HermiteCurve::getTrajectory(
   double start_s, double end_s, double resolution, bool denormalize_s) const
 {
+  std::vector<geometry_msgs::msg::Point> ret;
+  getTrajectory(start_s, end_s, resolution, denormalize_s, ret);
+  return ret;
+}
+
+void HermiteCurve::getTrajectory(
+  double start_s, double end_s, double resolution, bool denormalize_s,
+  std::vector<geometry_msgs::msg::Point> & trajectory) const
+{
+  trajectory.clear();
   resolution = std::fabs(resolution);
   if (start_s <= end_s) {
-    std::vector<geometry_msgs::msg::Point> ret;
     double s = start_s;
     while (s <= end_s) {
       s = s + resolution;
-      ret.emplace_back(getPoint(s, denormalize_s));
+      trajectory.emplace_back(getPoint(s, denormalize_s));
     }
-    return ret;
   } else {
-    std::vector<geometry_msgs::msg::Point> ret;
     double s = start_s;
     while (s >= end_s) {
       s = s - resolution;
-      ret.emplace_back(getPoint(s, denormalize_s));
+      trajectory.emplace_back(getPoint(s, denormalize_s));
     }
-    return ret;
   }
 }
 
@@ -14,15 +14,33 @@
 
 #include <tf2/LinearMath/Quaternion.h>
 
+#include <algorithm>
+#include <array>
 #include <geometry/quaternion/get_rotation.hpp>
-#include <geometry/quaternion/get_rotation_matrix.hpp>
+#include <geometry/quaternion/rotate.hpp>
 #include <geometry/transform.hpp>
+#include <geometry/vector3/operator.hpp>
+#include <iterator>
 #include <tf2_geometry_msgs/tf2_geometry_msgs.hpp>
 
 namespace math
 {
 namespace geometry
 {
+namespace
+{
+auto transformPoint(
+  const std::array<double, 9> & matrix, const geometry_msgs::msg::Point & translation,
+  const geometry_msgs::msg::Point & point) -> geometry_msgs::msg::Point
+{
+  auto transformed = rotate(matrix, point);
+  transformed.x += translation.x;
+  transformed.y += translation.y;
+  transformed.z += translation.z;
+  return transformed;
+}
+}  // namespace
+
 const geometry_msgs::msg::Pose getRelativePose(
   const geometry_msgs::msg::Pose & from, const geometry_msgs::msg::Pose & to)
 {
@@ -65,50 +83,29 @@ const geometry_msgs::msg::Pose getRelativePose(
 const geometry_msgs::msg::Point transformPoint(
   const geometry_msgs::msg::Pose & pose, const geometry_msgs::msg::Point & point)
 {
-  auto mat = math::geometry::getRotationMatrix(pose.orientation);
-  Eigen::VectorXd v(3);
-  v(0) = point.x;
-  v(1) = point.y;
-  v(2) = point.z;
-  v = mat * v;
-  v(0) = v(0) + pose.position.x;
-  v(1) = v(1) + pose.position.y;
-  v(2) = v(2) + pose.position.z;
-  geometry_msgs::msg::Point transformed;
-  transformed.x = v(0);
-  transformed.y = v(1);
-  transformed.z = v(2);
-  return transformed;
+  return transformPoint(getRotationMatrixElements(pose.orientation), pose.position, point);
 }
 
 const geometry_msgs::msg::Point transformPoint(
   const geometry_msgs::msg::Pose & pose, const geometry_msgs::msg::Pose & sensor_pose,
   const geometry_msgs::msg::Point & point)
 {
-  auto mat = math::geometry::getRotationMatrix(
-    math::geometry::getRotation(sensor_pose.orientation, pose.orientation));
-  Eigen::VectorXd v(3);
-  v(0) = point.x;
-  v(1) = point.y;
-  v(2) = point.z;
-  v = mat * v;
-  v(0) = v(0) + pose.position.x - sensor_pose.position.x;
-  v(1) = v(1) + pose.position.y - sensor_pose.position.y;
-  v(2) = v(2) + pose.position.z - sensor_pose.position.z;
-  geometry_msgs::msg::Point ret;
-  ret.x = v(0);
-  ret.y = v(1);
-  ret.z = v(2);
-  return ret;
+  return transformPoint(
+    getRotationMatrixElements(getRotation(sensor_pose.orientation, pose.orientation)),
+    pose.position - sensor_pose.position, point);
 }
 
 std::vector<geometry_msgs::msg::Point> transformPoints(
   const geometry_msgs::msg::Pose & pose, const std::vector<geometry_msgs::msg::Point> & points)
 {
+  const auto matrix = getRotationMatrixElements(pose.orientation);
   std::vector<geometry_msgs::msg::Point> ret;
+  ret.reserve(points.size());
   std::transform(
     points.begin(), points.end(), std::back_inserter(ret),
-    [pose](const geometry_msgs::msg::Point & point) { return transformPoint(pose, point); });
+    [&](const geometry_msgs::msg::Point & point) {
+      return transformPoint(matrix, pose.position, point);
+    });
   return ret;
 }
 
@@ -116,11 +113,15 @@ std::vector<geometry_msgs::msg::Point> transformPoints(
   const geometry_msgs::msg::Pose & pose, const geometry_msgs::msg::Pose & sensor_pose,
   const std::vector<geometry_msgs::msg::Point> & points)
 {
+  const auto matrix =
+    getRotationMatrixElements(getRotation(sensor_pose.orientation, pose.orientation));
+  const auto translation = pose.position - sensor_pose.position;
   std::vector<geometry_msgs::msg::Point> ret;
+  ret.reserve(points.size());
   std::transform(
     points.begin(), points.end(), std::back_inserter(ret),
-    [pose, sensor_pose](const geometry_msgs::msg::Point & point) {
-      return transformPoint(pose, sensor_pose, point);
+    [&](const geometry_msgs::msg::Point & point) {
+      return transformPoint(matrix, translation, point);
     });
   return ret;
 }
@@ -0,0 +1,93 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <geometry/bounding_box.hpp>
+#include <geometry/intersection/collision.hpp>
+#include <geometry/oriented_bounding_box.hpp>
+#include <geometry/quaternion/euler_to_quaternion.hpp>
+#include <vector>
+
+#include "benchmark_utils.hpp"
+
+/// @note Cars on a 10 x 10 m grid with varying yaw, like a crowded intersection.
+static auto makeCarPoses(const std::size_t size) -> std::vector<geometry_msgs::msg::Pose>
+{
+  const auto columns = static_cast<std::size_t>(std::ceil(std::sqrt(size)));
+  std::vector<geometry_msgs::msg::Pose> poses;
+  for (std::size_t i = 0; i < size; ++i) {
+    poses.push_back(makePose(
+      (i % columns) * 10.0, (i / columns) * 10.0, 0.0,
+      math::geometry::convertEulerAngleToQuaternion(makeVector(0.0, 0.0, i * 0.3))));
+  }
+  return poses;
+}
+
+static auto makeCarBoxes(const std::size_t size)
+  -> std::vector<math::geometry::OrientedBoundingBox>
+{
+  std::vector<math::geometry::OrientedBoundingBox> boxes;
+  for (const auto & pose : makeCarPoses(size)) {
+    boxes.emplace_back(pose, makeCarBoundingBox());
+  }
+  return boxes;
+}
+
+static void CheckCollision2D(benchmark::State & state)
+{
+  const auto bounding_box = makeCarBoundingBox();
+  const auto pose0 = makePose(0.0, 0.0);
+  const auto pose1 = makePose(
+    3.0, 1.0, 0.0, math::geometry::convertEulerAngleToQuaternion(makeVector(0.0, 0.0, 0.5)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+      math::geometry::checkCollision2D(pose0, bounding_box, pose1, bounding_box));
+  }
+}
+BENCHMARK(CheckCollision2D);
+
+static void CheckCollisions2D(benchmark::State & state)
+{
+  const auto boxes = makeCarBoxes(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(math::geometry::checkCollisions2D(boxes));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(CheckCollisions2D)->Arg(16)->Arg(256);
+
+static void GetPolygonDistance(benchmark::State & state)
+{
+  const auto bounding_box = makeCarBoundingBox();
+  const auto pose0 = makePose(0.0, 0.0);
+  const auto pose1 = makePose(
+    8.0, 3.0, 0.0, math::geometry::convertEulerAngleToQuaternion(makeVector(0.0, 0.0, 0.5)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+      math::geometry::getPolygonDistance(pose0, bounding_box, pose1, bounding_box));
+  }
+}
+BENCHMARK(GetPolygonDistance);
+
+static void GetPolygonDistances(benchmark::State & state)
+{
+  const auto boxes = makeCarBoxes(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(math::geometry::getPolygonDistances(boxes.front(), boxes));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(GetPolygonDistances)->Arg(256);
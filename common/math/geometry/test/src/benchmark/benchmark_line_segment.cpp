@@ -0,0 +1,97 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <geometry/intersection/intersection.hpp>
+#include <geometry/polygon/line_segment.hpp>
+#include <limits>
+#include <vector>
+
+#include "benchmark_utils.hpp"
+
+/// @note Segments like stop lines crossing the centerline, one every 2.5 m.
+static auto makeCrossingLineSegments(const std::size_t size)
+  -> std::vector<math::geometry::LineSegment>
+{
+  std::vector<math::geometry::LineSegment> line_segments;
+  for (std::size_t i = 0; i < size; ++i) {
+    line_segments.emplace_back(makePoint(i * 2.5 + 0.1, -20.0), makePoint(i * 2.5 + 0.1, 20.0));
+  }
+  return line_segments;
+}
+
+static auto makeCenterLineSegments(const std::size_t size)
+  -> std::vector<math::geometry::LineSegment>
+{
+  std::vector<geometry_msgs::msg::Point> points;
+  for (std::size_t i = 0; i <= size; ++i) {
+    points.push_back(makePoint(i * 0.5, 10.0 * std::sin(i * 0.01)));
+  }
+  return math::geometry::getLineSegments(points);
+}
+
+static void LineSegmentIsIntersect2D(benchmark::State & state)
+{
+  const math::geometry::LineSegment line0(makePoint(0.0, 0.0), makePoint(10.0, 10.0));
+  const math::geometry::LineSegment line1(makePoint(0.0, 10.0), makePoint(10.0, 0.0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(math::geometry::isIntersect2D(line0, line1));
+  }
+}
+BENCHMARK(LineSegmentIsIntersect2D);
+
+static void LineSegmentGetIntersection2D(benchmark::State & state)
+{
+  const math::geometry::LineSegment line0(makePoint(0.0, 0.0), makePoint(10.0, 10.0));
+  const math::geometry::LineSegment line1(makePoint(0.0, 10.0), makePoint(10.0, 0.0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(math::geometry::getIntersection2D(line0, line1));
+  }
+}
+BENCHMARK(LineSegmentGetIntersection2D);
+
+/// @note Baseline of getFirstIntersections2D, the nearest intersection of every pair is kept.
+static void LineSegmentGetIntersection2DAllPairs(benchmark::State & state)
+{
+  const auto queries = makeCrossingLineSegments(state.range(0));
+  const auto segments = makeCenterLineSegments(state.range(1));
+  for (auto _ : state) {
+    for (const auto & query : queries) {
+      auto min_distance = std::numeric_limits<double>::infinity();
+      for (const auto & segment : segments) {
+        if (const auto point = math::geometry::getIntersection2D(query, segment)) {
+          min_distance = std::min(
+            min_distance,
+            std::hypot(point->x - query.start_point.x, point->y - query.start_point.y));
+        }
+      }
+      benchmark::DoNotOptimize(min_distance);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(1));
+}
+BENCHMARK(LineSegmentGetIntersection2DAllPairs)->Args({200, 1000});
+
+static void LineSegmentGetFirstIntersections2D(benchmark::State & state)
+{
+  const math::geometry::LineSegmentArray queries(makeCrossingLineSegments(state.range(0)));
+  const math::geometry::LineSegmentArray segments(makeCenterLineSegments(state.range(1)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(math::geometry::getFirstIntersections2D(queries, segments));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(1));
+}
+BENCHMARK(LineSegmentGetFirstIntersections2D)->Args({200, 1000});
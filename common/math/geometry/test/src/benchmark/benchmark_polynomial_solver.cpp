@@ -0,0 +1,56 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <geometry/solver/polynomial_solver.hpp>
+#include <vector>
+
+/// @note Coefficients like the ones of a cubic curve crossing a line segment, most have solutions.
+static auto makeCubicCoefficients(const std::size_t size)
+  -> std::vector<math::geometry::PolynomialSolver::CubicCoefficients>
+{
+  std::vector<math::geometry::PolynomialSolver::CubicCoefficients> coefficients;
+  for (std::size_t i = 0; i < size; ++i) {
+    const auto t = static_cast<double>(i) / static_cast<double>(size);
+    coefficients.push_back({1.0 + t, -1.5, 0.5 - t, 0.1 * t - 0.05});
+  }
+  return coefficients;
+}
+
+static void PolynomialSolverSolveCubicEquation(benchmark::State & state)
+{
+  const math::geometry::PolynomialSolver solver;
+  const auto coefficients = makeCubicCoefficients(state.range(0));
+  for (auto _ : state) {
+    for (const auto & [a, b, c, d] : coefficients) {
+      benchmark::DoNotOptimize(solver.solveCubicEquation(a, b, c, d));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(PolynomialSolverSolveCubicEquation)->Arg(64);
+
+static void PolynomialSolverSolveCubicEquations(benchmark::State & state)
+{
+  const math::geometry::PolynomialSolver solver;
+  const auto coefficients = makeCubicCoefficients(state.range(0));
+  std::vector<math::geometry::PolynomialSolver::Solutions> solutions(coefficients.size());
+  for (auto _ : state) {
+    solver.solveCubicEquations(coefficients.begin(), coefficients.end(), solutions.begin());
+    benchmark::DoNotOptimize(solutions.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(PolynomialSolverSolveCubicEquations)->Arg(64);
@@ -0,0 +1,112 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <geometry/spline/catmull_rom_spline.hpp>
+#include <geometry/spline/hermite_curve.hpp>
+
+#include "benchmark_utils.hpp"
+
+static void HermiteCurveGetPoint(benchmark::State & state)
+{
+  const math::geometry::HermiteCurve curve(
+    makePose(0.0, 0.0), makePose(10.0, 2.0), makeVector(10.0, 0.0), makeVector(10.0, 4.0));
+  double s = 0.0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(curve.getPoint(s));
+    s = s < 1.0 ? s + 0.01 : 0.0;
+  }
+}
+BENCHMARK(HermiteCurveGetPoint);
+
+static void HermiteCurveGetCollisionPointIn2D(benchmark::State & state)
+{
+  const math::geometry::HermiteCurve curve(
+    makePose(0.0, 0.0), makePose(10.0, 2.0), makeVector(10.0, 0.0), makeVector(10.0, 4.0));
+  const auto point0 = makePoint(5.0, -5.0);
+  const auto point1 = makePoint(5.0, 5.0);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(curve.getCollisionPointIn2D(point0, point1));
+  }
+}
+BENCHMARK(HermiteCurveGetCollisionPointIn2D);
+
+static void HermiteCurveGetSValue(benchmark::State & state)
+{
+  const math::geometry::HermiteCurve curve(
+    makePose(0.0, 0.0), makePose(10.0, 2.0), makeVector(10.0, 0.0), makeVector(10.0, 4.0));
+  const auto pose = makePose(5.0, 0.5);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(curve.getSValue(pose));
+  }
+}
+BENCHMARK(HermiteCurveGetSValue);
+
+/// @note The argument is the number of control points, from a short lanelet to a long route.
+static void CatmullRomSplineConstruct(benchmark::State & state)
+{
+  const auto points = makeCenterPoints(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(math::geometry::CatmullRomSpline(points));
+  }
+}
+BENCHMARK(CatmullRomSplineConstruct)->Arg(30)->Arg(300);
+
+static void CatmullRomSplineGetPoint(benchmark::State & state)
+{
+  const math::geometry::CatmullRomSpline spline(makeCenterPoints(state.range(0)));
+  double s = 0.0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(spline.getPoint(s));
+    s = s + 0.5 < spline.getLength() ? s + 0.5 : 0.0;
+  }
+}
+BENCHMARK(CatmullRomSplineGetPoint)->Arg(30)->Arg(300);
+
+static void CatmullRomSplineGetTrajectory(benchmark::State & state)
+{
+  const math::geometry::CatmullRomSpline spline(makeCenterPoints(state.range(0)));
+  std::vector<geometry_msgs::msg::Point> trajectory;
+  for (auto _ : state) {
+    spline.getTrajectory(0.0, spline.getLength(), 1.0, 0.0, trajectory);
+    benchmark::DoNotOptimize(trajectory.data());
+  }
+}
+BENCHMARK(CatmullRomSplineGetTrajectory)->Arg(30)->Arg(300);
+
+static void CatmullRomSplineGetSValue(benchmark::State & state)
+{
+  const auto points = makeCenterPoints(state.range(0));
+  const math::geometry::CatmullRomSpline spline(points);
+  const auto pose = makePose(points[points.size() / 2].x, points[points.size() / 2].y + 0.5);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(spline.getSValue(pose));
+  }
+}
+BENCHMARK(CatmullRomSplineGetSValue)->Arg(30)->Arg(300);
+
+static void CatmullRomSplineGetCollisionPointIn2D(benchmark::State & state)
+{
+  const auto points = makeCenterPoints(state.range(0));
+  const math::geometry::CatmullRomSpline spline(points);
+  const auto & center = points[points.size() / 2];
+  const std::vector<geometry_msgs::msg::Point> polygon{
+    makePoint(center.x - 2.0, center.y - 2.0), makePoint(center.x + 2.0, center.y - 2.0),
+    makePoint(center.x + 2.0, center.y + 2.0), makePoint(center.x - 2.0, center.y + 2.0)};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(spline.getCollisionPointIn2D(polygon));
+  }
+}
+BENCHMARK(CatmullRomSplineGetCollisionPointIn2D)->Arg(30)->Arg(300);
@@ -0,0 +1,45 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GEOMETRY__TEST__BENCHMARK_UTILS_HPP_
+#define GEOMETRY__TEST__BENCHMARK_UTILS_HPP_
+
+#include <cmath>
+#include <geometry_msgs/msg/point.hpp>
+#include <vector>
+
+#include "../test_utils.hpp"
+
+/**
+ * @brief Center points of a lanelet sized curve, one point per meter on an arc.
+ * @note Hard coded parameter, with a radius of 100 m even 300 points stay on a half circle.
+ */
+inline auto makeCenterPoints(const std::size_t number_of_points, const double radius = 100.0)
+  -> std::vector<geometry_msgs::msg::Point>
+{
+  std::vector<geometry_msgs::msg::Point> points;
+  for (std::size_t i = 0; i < number_of_points; ++i) {
+    const auto theta = static_cast<double>(i) / radius;
+    points.push_back(makePoint(radius * std::sin(theta), radius * (1.0 - std::cos(theta))));
+  }
+  return points;
+}
+
+/// @brief Bounding box of a passenger car, 4.5 m x 1.8 m.
+inline auto makeCarBoundingBox() -> traffic_simulator_msgs::msg::BoundingBox
+{
+  return makeBbox(4.5, 1.8, 1.5, 1.0, 0.0, 0.75);
+}
+
+#endif  // GEOMETRY__TEST__BENCHMARK_UTILS_HPP_
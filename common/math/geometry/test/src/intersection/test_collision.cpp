@@ -14,7 +14,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
 #include <geometry/intersection/collision.hpp>
+#include <geometry/quaternion/euler_to_quaternion.hpp>
 #include <scenario_simulator_exception/exception.hpp>
 
 #include "../test_utils.hpp"
@@ -51,6 +53,66 @@ TEST(Collision, Touching)
   EXPECT_TRUE(math::geometry::checkCollision2D(pose0, box, pose1, box));
 }
 
+TEST(Collision, RotatedNoCollision)
+{
+  geometry_msgs::msg::Pose pose0 = makePose(
+    0.0, 0.0, 0.0, math::geometry::convertEulerAngleToQuaternion(makeVector(0.0, 0.0, M_PI_4)));
+  geometry_msgs::msg::Pose pose1 = makePose(0.9, 0.9);
+  traffic_simulator_msgs::msg::BoundingBox box = makeBbox(1.0, 1.0, 1.0);
+  EXPECT_FALSE(math::geometry::checkCollision2D(pose0, box, pose1, box));
+  EXPECT_FALSE(boost::geometry::intersects(
+    math::geometry::toPolygon2D(pose0, box), math::geometry::toPolygon2D(pose1, box)));
+}
+
+TEST(Collision, RotatedCollision)
+{
+  geometry_msgs::msg::Pose pose0 = makePose(
+    0.0, 0.0, 0.0, math::geometry::convertEulerAngleToQuaternion(makeVector(0.0, 0.0, M_PI_4)));
+  geometry_msgs::msg::Pose pose1 = makePose(0.8, 0.8);
+  traffic_simulator_msgs::msg::BoundingBox box = makeBbox(1.0, 1.0, 1.0);
+  EXPECT_TRUE(math::geometry::checkCollision2D(pose0, box, pose1, box));
+}
+
+TEST(Collision, ManyBoxes)
+{
+  std::vector<geometry_msgs::msg::Pose> poses;
+  std::vector<traffic_simulator_msgs::msg::BoundingBox> bboxes;
+  std::vector<math::geometry::OrientedBoundingBox> boxes;
+  for (int i = 0; i < 60; ++i) {
+    poses.push_back(makePose(
+      std::fmod(i * 3.7, 20.0), std::fmod(i * 2.3, 15.0), (i % 3) * 0.5,
+      math::geometry::convertEulerAngleToQuaternion(makeVector(0.0, 0.0, i * 0.4))));
+    bboxes.push_back(makeBbox(1.0 + (i % 4), 1.0 + (i % 2), 1.0, 0.5 * (i % 3)));
+    boxes.emplace_back(poses.back(), bboxes.back());
+  }
+
+  std::vector<std::pair<std::size_t, std::size_t>> expected;
+  for (std::size_t i = 0; i < boxes.size(); ++i) {
+    for (std::size_t j = i + 1; j < boxes.size(); ++j) {
+      /// @note Same check as before the separating axis test, with boost::geometry polygons.
+      if (
+        std::abs(boxes[i].z - boxes[j].z) <= 1.0 and
+        boost::geometry::intersects(
+          math::geometry::toPolygon2D(poses[i], bboxes[i]),
+          math::geometry::toPolygon2D(poses[j], bboxes[j]))) {
+        expected.emplace_back(i, j);
+      }
+    }
+  }
+  EXPECT_FALSE(expected.empty());
+  EXPECT_EQ(math::geometry::checkCollisions2D(boxes), expected);
+
+  const std::vector<math::geometry::OrientedBoundingBox> boxes0(boxes.begin(), boxes.begin() + 20);
+  const std::vector<math::geometry::OrientedBoundingBox> boxes1(boxes.begin() + 20, boxes.end());
+  std::vector<std::pair<std::size_t, std::size_t>> expected_between;
+  for (const auto & [i, j] : expected) {
+    if (i < 20 and j >= 20) {
+      expected_between.emplace_back(i, j - 20);
+    }
+  }
+  EXPECT_EQ(math::geometry::checkCollisions2D(boxes0, boxes1), expected_between);
+}
+
 TEST(Collision, PointInside)
 {
   std::vector<geometry_msgs::msg::Point> polygon(4);
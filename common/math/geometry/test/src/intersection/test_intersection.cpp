@@ -131,6 +131,62 @@ TEST(Intersection, getIntersection2DEmptyVector)
   EXPECT_EQ(ans.size(), size_t(0));
 }
 
+TEST(Intersection, getFirstIntersections2D)
+{
+  const math::geometry::LineSegmentArray queries(
+    {{makePoint(0.0, 0.0), makePoint(4.0, 0.0)},
+     {makePoint(0.0, 1.0), makePoint(4.0, 1.0)},
+     {makePoint(0.0, 5.0), makePoint(4.0, 5.0)},
+     {makePoint(-1.0, 0.0), makePoint(1.0, 0.0)}});
+  const math::geometry::LineSegmentArray segments(
+    {{makePoint(3.0, -1.0), makePoint(3.0, 2.0)},
+     {makePoint(1.0, -1.0), makePoint(1.0, 2.0)},
+     {makePoint(0.5, 0.0), makePoint(2.0, 0.0)}});
+  const auto ans = math::geometry::getFirstIntersections2D(queries, segments);
+  ASSERT_EQ(ans.size(), size_t(4));
+  ASSERT_TRUE(ans[0]);
+  EXPECT_EQ(ans[0]->index, size_t(2));
+  EXPECT_DOUBLE_EQ(ans[0]->s, 0.125);
+  ASSERT_TRUE(ans[1]);
+  EXPECT_EQ(ans[1]->index, size_t(1));
+  EXPECT_DOUBLE_EQ(ans[1]->s, 0.25);
+  EXPECT_FALSE(ans[2]);
+  ASSERT_TRUE(ans[3]);
+  EXPECT_EQ(ans[3]->index, size_t(2));
+  EXPECT_DOUBLE_EQ(ans[3]->s, 0.75);
+}
+
+TEST(Intersection, getFirstIntersections2DSameAsIsIntersect2D)
+{
+  std::vector<math::geometry::LineSegment> lines;
+  for (int i = 0; i < 100; ++i) {
+    lines.emplace_back(
+      makePoint(std::fmod(i * 1.3, 7.0), std::fmod(i * 2.9, 5.0)),
+      makePoint(std::fmod(i * 3.1, 11.0), std::fmod(i * 0.7, 6.0)));
+  }
+  const std::vector<math::geometry::LineSegment> queries(lines.begin(), lines.begin() + 30);
+  const std::vector<math::geometry::LineSegment> segments(lines.begin() + 30, lines.end());
+  const auto ans = math::geometry::getFirstIntersections2D(
+    math::geometry::LineSegmentArray(queries), math::geometry::LineSegmentArray(segments));
+  ASSERT_EQ(ans.size(), queries.size());
+  for (std::size_t i = 0; i < queries.size(); ++i) {
+    std::optional<double> expected_s;
+    for (const auto & segment : segments) {
+      if (const auto point = math::geometry::getIntersection2D(queries[i], segment)) {
+        const auto s = std::hypot(
+                         point->x - queries[i].start_point.x, point->y - queries[i].start_point.y) /
+                       queries[i].length_2d;
+        expected_s = std::min(expected_s.value_or(s), s);
+      }
+    }
+    ASSERT_EQ(ans[i].has_value(), expected_s.has_value());
+    if (ans[i]) {
+      EXPECT_TRUE(math::geometry::isIntersect2D(queries[i], segments[ans[i]->index]));
+      EXPECT_NEAR(ans[i]->s, expected_s.value(), 1e-9);
+    }
+  }
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -16,7 +16,11 @@
 
 #include <geometry/quaternion/is_like_quaternion.hpp>
 #include <geometry/quaternion/make_quaternion.hpp>
+#include <geometry/quaternion/euler_to_quaternion.hpp>
+#include <geometry/quaternion/get_rotation_matrix.hpp>
 #include <geometry/quaternion/operator.hpp>
+#include <geometry/quaternion/rotate.hpp>
+#include <vector>
 
 #include "../expect_eq_macros.hpp"
 #include "../test_utils.hpp"
@@ -75,6 +79,58 @@ TEST(Quaternion, operator_additionAssignment)
   EXPECT_QUATERNION_EQ(q1, math::geometry::makeQuaternion(0, 2, 0, 2))
 }
 
+/**
+ * @note Test result equality with getRotationMatrix.
+ */
+TEST(Quaternion, rotate)
+{
+  const auto q = math::geometry::convertEulerAngleToQuaternion(makeVector(0.1, -0.4, 2.3));
+  const auto v = makeVector(1.0, -2.0, 3.0);
+  const Eigen::Vector3d expected = math::geometry::getRotationMatrix(q) * Eigen::Vector3d(1, -2, 3);
+  const auto ans = math::geometry::rotate(q, v);
+  EXPECT_VECTOR3_NEAR(ans, makeVector(expected.x(), expected.y(), expected.z()), EPS);
+}
+
+/**
+ * @note Test that rotating many vectors at once gives the same results as one by one.
+ */
+TEST(Quaternion, rotateMany)
+{
+  const auto q = math::geometry::convertEulerAngleToQuaternion(makeVector(0.0, 0.3, -1.2));
+  std::vector<geometry_msgs::msg::Point> points;
+  for (int i = 0; i < 10; ++i) {
+    points.push_back(makePoint(i, i * i, -i));
+  }
+  std::vector<geometry_msgs::msg::Point> ans(points.size());
+  EXPECT_EQ(math::geometry::rotate(q, points.begin(), points.end(), ans.begin()), ans.end());
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    EXPECT_POINT_EQ(ans[i], math::geometry::rotate(q, points[i]));
+  }
+}
+
+/**
+ * @note Test that quaternion operations and rotations on plain structs are usable at compile time.
+ */
+TEST(Quaternion, rotateConstexpr)
+{
+  struct Quaternion
+  {
+    double x, y, z, w;
+  };
+  struct Vector3
+  {
+    double x, y, z;
+  };
+  constexpr Quaternion yaw_90{0.0, 0.0, M_SQRT1_2, M_SQRT1_2};
+  constexpr auto identity = math::geometry::operator*(yaw_90, Quaternion{0.0, 0.0, 0.0, 1.0});
+  static_assert(identity.z == yaw_90.z and identity.w == yaw_90.w);
+  constexpr auto ans =
+    math::geometry::rotate(Quaternion{0.0, 0.0, 0.0, 1.0}, Vector3{1.0, 2.0, 3.0});
+  static_assert(ans.x == 1.0 and ans.y == 2.0 and ans.z == 3.0);
+  EXPECT_VECTOR3_NEAR(
+    math::geometry::rotate(yaw_90, Vector3{1.0, 0.0, 0.0}), makeVector(0.0, 1.0, 0.0), EPS);
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
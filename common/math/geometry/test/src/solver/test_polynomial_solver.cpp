@@ -201,6 +201,35 @@ TEST(PolynomialSolverTest, SolveCubicEquation)
   }
 }
 
+/// @note Testcase for solving a batch of ax^3+bx^2+cx+d = 0 into a fixed size buffer
+TEST(PolynomialSolverTest, SolveCubicEquations)
+{
+  constexpr double infinity = std::numeric_limits<double>::infinity();
+  math::geometry::PolynomialSolver solver;
+  const std::array<math::geometry::PolynomialSolver::CubicCoefficients, 4> coefficients = {{
+    {1, -2, -11, 12},  // x^3 - 2x^2 - 11x + 12 = 0 (solutions should be -3, 1, 4)
+    {0, 1, 0, -4},     // x^2 - 4 = 0 (solutions should be -2, 2)
+    {0, 0, 2, -1},     // 2x - 1 = 0 (solution should be 0.5)
+    {0, 0, 0, 0},      // 0 = 0 (any x value is a solution)
+  }};
+  std::array<math::geometry::PolynomialSolver::Solutions, 4> solutions;
+  const auto last = solver.solveCubicEquations(
+    coefficients.begin(), coefficients.end(), solutions.begin(), -infinity, infinity);
+  EXPECT_EQ(last, solutions.end());
+  for (size_t i = 0; i < 3; ++i) {
+    const auto & [a, b, c, d] = coefficients[i];
+    EXPECT_FALSE(solutions[i].indeterminate);
+    EXPECT_EQ(
+      std::vector<double>(solutions[i].begin(), solutions[i].end()),
+      solver.solveCubicEquation(a, b, c, d, -infinity, infinity));
+  }
+  EXPECT_EQ(solutions[0].size, static_cast<size_t>(3));
+  EXPECT_EQ(solutions[1].size, static_cast<size_t>(2));
+  EXPECT_EQ(solutions[2].size, static_cast<size_t>(1));
+  EXPECT_TRUE(solutions[3].indeterminate);
+  EXPECT_TRUE(solutions[3].empty());
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
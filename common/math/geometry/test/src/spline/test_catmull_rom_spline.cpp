@@ -416,6 +416,78 @@ TEST(CatmullRomSpline, getPointCurve)
   EXPECT_POINT_NEAR(point, makePoint(1.0, 1.0), eps);
 }
 
+TEST(CatmullRomSpline, getPointManyControlPoints)
+{
+  std::vector<geometry_msgs::msg::Point> control_points;
+  for (int i = 0; i <= 100; ++i) {
+    control_points.push_back(makePoint(i, 0.0));
+  }
+  const math::geometry::CatmullRomSpline spline(control_points);
+  constexpr double eps = 0.1;
+  EXPECT_NEAR(spline.getLength(), 100.0, eps);
+  for (const double s : {0.0, 0.5, 1.0, 49.9, 50.0, 99.5, 100.0}) {
+    EXPECT_POINT_NEAR(spline.getPoint(s), makePoint(s, 0.0), eps);
+  }
+}
+
+TEST(CatmullRomSpline, getSValueManyControlPoints)
+{
+  std::vector<geometry_msgs::msg::Point> control_points;
+  for (int i = 0; i <= 100; ++i) {
+    control_points.push_back(makePoint(i, 0.0));
+  }
+  const math::geometry::CatmullRomSpline spline(control_points);
+  constexpr double eps = 0.1;
+  const auto s = spline.getSValue(makePose(37.5, 1.0));
+  EXPECT_TRUE(s);
+  EXPECT_NEAR(s.value(), 37.5, eps);
+  EXPECT_FALSE(spline.getSValue(makePose(37.5, 5.0)));
+  EXPECT_FALSE(spline.getSValue(makePose(120.0, 0.0)));
+}
+
+TEST(CatmullRomSpline, getCollisionPointIn2DManyControlPoints)
+{
+  std::vector<geometry_msgs::msg::Point> control_points;
+  for (int i = 0; i <= 100; ++i) {
+    control_points.push_back(makePoint(i, 0.0));
+  }
+  const math::geometry::CatmullRomSpline spline(control_points);
+  constexpr double eps = 0.1;
+  const auto collision_s =
+    spline.getCollisionPointIn2D(makePoint(20.5, -1.0), makePoint(20.5, 1.0));
+  EXPECT_TRUE(collision_s);
+  EXPECT_NEAR(collision_s.value(), 20.5, eps);
+  const std::vector<geometry_msgs::msg::Point> polygon{
+    makePoint(10.0, -1.0), makePoint(20.0, -1.0), makePoint(20.0, 1.0), makePoint(10.0, 1.0)};
+  const auto forward_s = spline.getCollisionPointIn2D(polygon, false);
+  EXPECT_TRUE(forward_s);
+  EXPECT_NEAR(forward_s.value(), 10.0, eps);
+  const auto backward_s = spline.getCollisionPointIn2D(polygon, true);
+  EXPECT_TRUE(backward_s);
+  EXPECT_NEAR(backward_s.value(), 20.0, eps);
+  EXPECT_FALSE(spline.getCollisionPointIn2D(makePoint(20.5, 1.0), makePoint(20.5, 2.0)));
+}
+
+TEST(CatmullRomSpline, getTrajectoryManyControlPoints)
+{
+  std::vector<geometry_msgs::msg::Point> control_points;
+  for (int i = 0; i <= 50; ++i) {
+    control_points.push_back(makePoint(i, std::sin(i * 0.3)));
+  }
+  const math::geometry::CatmullRomSpline spline(control_points);
+  for (const auto & [start_s, end_s] :
+       std::vector<std::pair<double, double>>{{0.0, spline.getLength()}, {40.0, 3.0}}) {
+    const auto trajectory = spline.getTrajectory(start_s, end_s, 0.7);
+    ASSERT_FALSE(trajectory.empty());
+    double s = start_s;
+    for (size_t i = 0; i + 1 < trajectory.size(); ++i) {
+      EXPECT_POINT_EQ(trajectory[i], spline.getPoint(s));
+      s = start_s < end_s ? s + 0.7 : s - 0.7;
+    }
+    EXPECT_POINT_EQ(trajectory.back(), spline.getPoint(end_s));
+  }
+}
+
 TEST(CatmullRomSpline, getTangentVectorLine)
 {
   const math::geometry::CatmullRomSpline spline = makeLine();
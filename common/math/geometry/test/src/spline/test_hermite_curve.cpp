@@ -210,6 +210,18 @@ TEST(HermiteCurveTest, getTrajectoryPast2)
   EXPECT_POINT_NEAR(trajectory[10], ans[10], eps);
 }
 
+TEST(HermiteCurveTest, getTrajectoryIntoBuffer)
+{
+  const auto curve = makeLine2();
+  std::vector<geometry_msgs::msg::Point> trajectory(20, makePoint(-1.0, -1.0));
+  curve.getTrajectory(0.0, 1.0, 0.1, false, trajectory);
+  const auto ans = curve.getTrajectory(0.0, 1.0, 0.1, false);
+  EXPECT_EQ(trajectory.size(), ans.size());
+  for (size_t i = 0; i < ans.size(); ++i) {
+    EXPECT_POINT_EQ(trajectory[i], ans[i]);
+  }
+}
+
 TEST(HermiteCurveTest, getPointLine)
 {
   const auto curve = makeLine2();
@@ -417,6 +429,23 @@ TEST(HermiteCurveTest, getCollisionPointIn2DCurve)
   EXPECT_NEAR(s2.value(), 0.8, eps);
 }
 
+TEST(HermiteCurveTest, getCollisionPointsIn2DCurveIntoBuffer)
+{
+  const auto curve = makeCurve1();
+
+  constexpr double eps = 0.1;
+  std::array<double, 3> s_values;
+  EXPECT_EQ(
+    curve.getCollisionPointsIn2D(makePoint(0.1, 0.0), makePoint(1.0, 0.9), s_values),
+    static_cast<size_t>(2));
+  EXPECT_NEAR(s_values[0], 0.2, eps);
+  EXPECT_NEAR(s_values[1], 0.8, eps);
+  EXPECT_LT(s_values[0], s_values[1]);
+  EXPECT_EQ(
+    curve.getCollisionPointsIn2D(makePoint(2.0, 0.0), makePoint(3.0, 0.0), s_values),
+    static_cast<size_t>(0));
+}
+
 TEST(HermiteCurveTest, getCollisionPointIn2DCurveEdge)
 {
   const auto curve = makeCurve1();
@@ -135,6 +135,44 @@ TEST(BoundingBox, getPolygonDistanceWithoutCollision)
   EXPECT_DOUBLE_EQ(ans.value(), 3.0);
 }
 
+TEST(BoundingBox, getPolygonDistanceRotated)
+{
+  traffic_simulator_msgs::msg::BoundingBox bbox0 = makeBbox(4.0, 2.0, 1.0, 0.5);
+  traffic_simulator_msgs::msg::BoundingBox bbox1 = makeBbox(1.0, 3.0, 1.0);
+  for (int i = 0; i < 50; ++i) {
+    const auto pose0 = makePose(
+      0.0, 0.0, 0.0, math::geometry::convertEulerAngleToQuaternion(makeVector(0.0, 0.0, i * 0.3)));
+    const auto pose1 = makePose(
+      std::cos(i * 0.7) * (2.0 + i * 0.1), std::sin(i * 0.7) * (2.0 + i * 0.1), 0.0,
+      math::geometry::convertEulerAngleToQuaternion(makeVector(0.0, 0.0, i * -0.5)));
+    const auto poly0 = math::geometry::toPolygon2D(pose0, bbox0);
+    const auto poly1 = math::geometry::toPolygon2D(pose1, bbox1);
+    const auto ans = math::geometry::getPolygonDistance(pose0, bbox0, pose1, bbox1);
+    if (boost::geometry::intersects(poly0, poly1)) {
+      EXPECT_FALSE(ans);
+    } else {
+      ASSERT_TRUE(ans);
+      EXPECT_NEAR(ans.value(), boost::geometry::distance(poly0, poly1), 1e-9);
+    }
+  }
+}
+
+TEST(BoundingBox, getPolygonDistances)
+{
+  const math::geometry::OrientedBoundingBox box(makePose(0.0, 0.0), makeBbox(3.0, 3.0, 3.0));
+  const std::vector<math::geometry::OrientedBoundingBox> other_boxes = {
+    math::geometry::OrientedBoundingBox(makePose(0.0, 5.0), makeBbox(1.0, 1.0, 1.0)),
+    math::geometry::OrientedBoundingBox(makePose(0.0, 0.0), makeBbox(1.0, 1.0, 1.0)),
+    math::geometry::OrientedBoundingBox(makePose(-7.0, 0.0), makeBbox(1.0, 1.0, 1.0))};
+  const auto distances = math::geometry::getPolygonDistances(box, other_boxes);
+  ASSERT_EQ(distances.size(), 3u);
+  ASSERT_TRUE(distances[0]);
+  EXPECT_DOUBLE_EQ(distances[0].value(), 3.0);
+  EXPECT_FALSE(distances[1]);
+  ASSERT_TRUE(distances[2]);
+  EXPECT_DOUBLE_EQ(distances[2].value(), 5.0);
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -15,11 +15,16 @@
 #ifndef SIMPLE_JUNIT__JUNIT5_HPP_
 #define SIMPLE_JUNIT__JUNIT5_HPP_
 
+#include <cstdio>
+#include <fstream>
+#include <map>
 #include <optional>
 #include <pugixml.hpp>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
+#include <utility>
 
 namespace xs
 {
@@ -389,6 +394,140 @@ struct SimpleTestSuites : private std::unordered_map<std::string, SimpleTestSuit
 };
 
 using JUnit5 = SimpleTestSuites;
+
+/*
+   Append-only writer of the same document as SimpleTestSuites, for runs with
+   too many testcases to be kept in memory until the end.
+
+   Each completed testcase is appended to "<path>.part" on its own line,
+   wrapped in the testsuite it belongs to, and flushed. Only the counts of
+   the testsuites are kept. A crash therefore loses at most the testcase
+   being run, and the part file can still be read line by line.
+
+   finalize() writes the valid document to the path in one pass over the part
+   file per testsuite, then removes the part file.
+*/
+class StreamingTestSuites
+{
+  struct Counts
+  {
+    std::size_t pass = 0, failures = 0, errors = 0;
+
+    auto tests() const { return pass + failures + errors; }
+  };
+
+  const std::string path;
+
+  const xs::string name;
+
+  std::ofstream part;
+
+  std::map<xs::string, Counts> counts;
+
+  static auto escape(const xs::string & value) -> std::string
+  {
+    std::string escaped;
+    for (const auto c : value) {
+      switch (c) {
+        case '&':
+          escaped += "&amp;";
+          break;
+        case '<':
+          escaped += "&lt;";
+          break;
+        case '>':
+          escaped += "&gt;";
+          break;
+        case '"':
+          escaped += "&quot;";
+          break;
+        default:
+          if (0 <= c and c < 32) {
+            escaped += "&#" + std::to_string(static_cast<int>(c)) + ";";
+          } else {
+            escaped += c;
+          }
+      }
+    }
+    return escaped;
+  }
+
+  static auto attributes(const Counts & counts) -> std::string
+  {
+    return " failures=\"" + std::to_string(counts.failures) + "\" errors=\"" +
+           std::to_string(counts.errors) + "\" tests=\"" + std::to_string(counts.tests()) + "\"";
+  }
+
+public:
+  explicit StreamingTestSuites(const std::string & path, const xs::string & name = "")
+  : path(path), name(name), part(path + ".part", std::ios::trunc)
+  {
+    if (not part) {
+      throw std::runtime_error("failed to open " + path + ".part");
+    }
+  }
+
+  auto testsuite(const xs::string & testsuite_name) -> void { counts[testsuite_name]; }
+
+  auto write(const xs::string & testsuite_name, const SimpleTestCase & testcase) -> void
+  {
+    auto & testsuite_counts = counts[testsuite_name];
+    testsuite_counts.pass += testcase.pass.size();
+    testsuite_counts.failures += testcase.failure.size();
+    testsuite_counts.errors += testcase.error.size();
+
+    pugi::xml_document document;
+    auto node = document.append_child("testsuite");
+    node.append_attribute("name") = testsuite_name.c_str();
+    node << testcase;
+    document.save(part, "", pugi::format_raw | pugi::format_no_declaration);
+    part << std::endl;
+  }
+
+  auto finalize() -> void
+  {
+    part.close();
+
+    std::ofstream output(path, std::ios::trunc);
+
+    Counts total;
+    for (const auto & each : counts) {
+      total.pass += each.second.pass;
+      total.failures += each.second.failures;
+      total.errors += each.second.errors;
+    }
+
+    output << "<?xml version=\"1.0\"?>\n<testsuites";
+    if (not name.empty()) {
+      output << " name=\"" << escape(name) << "\"";
+    }
+    output << attributes(total) << (counts.empty() ? " />\n" : ">\n");
+
+    for (const auto & each : counts) {
+      output << "  <testsuite name=\"" << escape(each.first) << "\"" << attributes(each.second);
+      std::ifstream input(path + ".part");
+      bool empty = true;
+      for (std::string line; std::getline(input, line);) {
+        pugi::xml_document document;
+        const auto node = document.load_string(line.c_str()) ? document.child("testsuite")
+                                                             : pugi::xml_node();
+        if (node and each.first == node.attribute("name").value()) {
+          if (std::exchange(empty, false)) {
+            output << ">\n";
+          }
+          node.child("testcase").print(output, "  ", pugi::format_default, pugi::encoding_auto, 2);
+        }
+      }
+      output << (empty ? " />\n" : "  </testsuite>\n");
+    }
+
+    if (not counts.empty()) {
+      output << "</testsuites>\n";
+    }
+
+    std::remove((path + ".part").c_str());
+  }
+};
 }  // namespace junit
 }  // namespace common
 
@@ -150,6 +150,23 @@ TEST(SIMPLE_JUNIT, TESTSUITES_NAME)
   cleanup("result_testsuites_name.junit.xml");
 }
 
+TEST(SIMPLE_JUNIT, STREAMING)
+{
+  common::junit::StreamingTestSuites junit("result_streaming.junit.xml");
+  junit.testsuite("example_suites");
+  common::junit::SimpleTestCase testcase("example_case");
+  testcase.error.push_back(common::junit::Error("example_error", "error_test_case"));
+  testcase.failure.push_back(common::junit::Failure("example_failure", "failure_test_case"));
+  junit.write("example_suite", testcase);
+  EXPECT_TRUE(boost::filesystem::exists("result_streaming.junit.xml.part"));
+  junit.finalize();
+  EXPECT_FALSE(boost::filesystem::exists("result_streaming.junit.xml.part"));
+  EXPECT_TEXT_FILE_EQ(
+    "result_streaming.junit.xml",
+    ament_index_cpp::get_package_share_directory("simple_junit") + "/expected/complex.junit.xml");
+  cleanup("result_streaming.junit.xml");
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
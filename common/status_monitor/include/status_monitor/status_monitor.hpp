@@ -15,56 +15,88 @@
 #ifndef STATUS_MONITOR__STATUS_MONITOR_HPP_
 #define STATUS_MONITOR__STATUS_MONITOR_HPP_
 
+#include <atomic>
 #include <cerrno>
 #include <chrono>
 #include <filesystem>
 #include <fstream>
+#include <list>
 #include <mutex>
+#include <string>
 #include <thread>
-#include <unordered_map>
+#include <tuple>
 #include <utility>
 
 namespace common
 {
 class StatusMonitor
 {
+  /*
+     The status of a thread is only written by the thread itself, which holds
+     a pointer to it, and only read by the watchdog. So touch takes no lock,
+     its atomics only need to be relaxed.
+  */
   struct Status
   {
-    const std::string name;
+    using clock = std::chrono::steady_clock;
+
+    using duration = clock::duration;
 
-    std::chrono::high_resolution_clock::time_point last_access;
+    const std::string name;
 
-    using duration =
-      decltype(std::chrono::high_resolution_clock::now() - std::chrono::high_resolution_clock::now());
+    std::atomic<duration::rep> last_access;
 
-    duration minimum_access_interval;
+    std::atomic<duration::rep> minimum_access_interval;
 
-    duration maximum_access_interval;
+    std::atomic<duration::rep> maximum_access_interval;
 
-    bool exited = false;
+    std::atomic_bool exited{false};
 
     template <typename Name>
     explicit Status(Name && name)
     : name(std::forward<decltype(name)>(name)),
-      last_access(std::chrono::high_resolution_clock::now()),
-      minimum_access_interval(duration::max()),
-      maximum_access_interval(duration::min())
+      last_access(now()),
+      minimum_access_interval(duration::max().count()),
+      maximum_access_interval(duration::min().count())
     {
     }
 
+    static auto now() -> duration::rep { return clock::now().time_since_epoch().count(); }
+
+    auto touch() -> void
+    {
+      const auto this_access = now();
+
+      const auto this_access_interval =
+        this_access - last_access.load(std::memory_order_relaxed);
+
+      if (this_access_interval < minimum_access_interval.load(std::memory_order_relaxed)) {
+        minimum_access_interval.store(this_access_interval, std::memory_order_relaxed);
+      }
+
+      if (maximum_access_interval.load(std::memory_order_relaxed) < this_access_interval) {
+        maximum_access_interval.store(this_access_interval, std::memory_order_relaxed);
+      }
+
+      last_access.store(this_access, std::memory_order_relaxed);
+    }
+
     auto since_last_access() const
     {
-      return std::chrono::high_resolution_clock::now() - last_access;
+      return duration(now() - last_access.load(std::memory_order_relaxed));
     }
 
-    auto good() const { return exited or since_last_access() < threshold; }
+    auto good() const { return exited.load() or since_last_access() < threshold; }
 
     explicit operator bool() const { return good(); }
   };
 
   static inline std::ofstream file;
 
-  static inline std::unordered_map<std::thread::id, Status> statuses;
+  /// @note A list, so the statuses do not move while the threads touch them.
+  static inline std::list<std::pair<std::thread::id, Status>> statuses;
+
+  static inline thread_local Status * this_thread_status = nullptr;
 
   static inline std::thread watchdog;
 
@@ -82,26 +114,16 @@ public:
   template <typename Name>
   auto touch(Name && name)
   {
-    auto lock = std::scoped_lock<std::mutex>(mutex);
-
-    if (auto iter = statuses.find(std::this_thread::get_id()); iter != std::end(statuses)) {
-      [[maybe_unused]] auto && [id, status] = *iter;
-
-      const auto now = std::chrono::high_resolution_clock::now();
-
-      const auto this_access_interval = now - status.last_access;
-
-      status.minimum_access_interval =
-        std::min<std::decay_t<decltype(status.minimum_access_interval)>>(
-          status.minimum_access_interval, this_access_interval);
-
-      status.maximum_access_interval =
-        std::max<std::decay_t<decltype(status.maximum_access_interval)>>(
-          status.maximum_access_interval, this_access_interval);
-
-      status.last_access = now;
+    if (this_thread_status) {
+      this_thread_status->touch();
     } else {
-      statuses.emplace(std::this_thread::get_id(), std::forward<decltype(name)>(name));
+      auto lock = std::scoped_lock<std::mutex>(mutex);
+      this_thread_status = &statuses
+                              .emplace_back(
+                                std::piecewise_construct,
+                                std::forward_as_tuple(std::this_thread::get_id()),
+                                std::forward_as_tuple(std::forward<decltype(name)>(name)))
+                              .second;
     }
   }
 
@@ -0,0 +1,72 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef STATUS_MONITOR__TRACE_HPP_
+#define STATUS_MONITOR__TRACE_HPP_
+
+#include <chrono>
+#include <string>
+
+namespace common
+{
+/*
+   Opt-in trace of the execution of the simulator, written in the JSON array
+   format of the Chrome trace events that Perfetto and chrome://tracing open.
+   It is enabled by naming the file in the environment variable
+   SCENARIO_SIMULATOR_TRACE_FILE. Every process given the variable appends
+   its events to that file, timestamped by std::chrono::steady_clock, which is
+   the CLOCK_MONOTONIC shared by all the processes of the machine. So the
+   interpreter and the simulators are laid out on one timeline.
+*/
+class Trace
+{
+public:
+  using clock = std::chrono::steady_clock;
+
+  static auto enabled() -> bool;
+
+  /// @note The event is written by a single append, so the processes do not interleave events.
+  static auto complete(
+    const char * category, const std::string & name, const clock::time_point & begin,
+    const clock::time_point & end) -> void;
+};
+
+/// @brief Trace the scope as a complete event, if the trace is enabled.
+class ScopedTraceEvent
+{
+  const char * const category;
+
+  /// @note A string literal, or nullptr when the name is held in dynamic_name.
+  const char * const name;
+
+  const std::string dynamic_name;
+
+  const bool enabled;
+
+  const Trace::clock::time_point begin;
+
+public:
+  explicit ScopedTraceEvent(const char * category, const char * name);
+
+  /// @note The name is only copied when the trace is enabled.
+  explicit ScopedTraceEvent(const char * category, const std::string & name);
+
+  ~ScopedTraceEvent();
+
+  ScopedTraceEvent(const ScopedTraceEvent &) = delete;
+
+  auto operator=(const ScopedTraceEvent &) -> ScopedTraceEvent & = delete;
+};
+}  // namespace common
+
+#endif  // STATUS_MONITOR__TRACE_HPP_
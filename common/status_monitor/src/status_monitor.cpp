@@ -38,8 +38,6 @@ static std::size_t count = 0;
 StatusMonitor::StatusMonitor()
 {
   if (not count++) {
-    statuses = {};
-
     watchdog = std::thread([this]() {
       /*
          When a file open fails, the system expects the upper-level system to
@@ -60,9 +58,9 @@ StatusMonitor::~StatusMonitor()
 {
   auto lock = std::scoped_lock<std::mutex>(mutex);
 
-  auto mark_as_exited = [this]() {
-    if (auto iter = statuses.find(std::this_thread::get_id()); iter != std::end(statuses)) {
-      std::get<1>(*iter).exited = true;
+  auto mark_as_exited = []() {
+    if (this_thread_status) {
+      this_thread_status->exited = true;
     }
   };
 
@@ -97,13 +95,15 @@ auto StatusMonitor::write() const -> void
 
       thread["good"] = status.good();
 
-      thread["maximum_access_interval_ms"] =
-        std::chrono::duration_cast<std::chrono::milliseconds>(status.maximum_access_interval)
+      auto milliseconds = [](auto && interval) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+                 Status::duration(interval.load(std::memory_order_relaxed)))
           .count();
+      };
 
-      thread["minimum_access_interval_ms"] =
-        std::chrono::duration_cast<std::chrono::milliseconds>(status.minimum_access_interval)
-          .count();
+      thread["maximum_access_interval_ms"] = milliseconds(status.maximum_access_interval);
+
+      thread["minimum_access_interval_ms"] = milliseconds(status.minimum_access_interval);
 
       thread["thread_id"] = boost::lexical_cast<std::string>(id);
 
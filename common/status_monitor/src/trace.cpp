@@ -0,0 +1,127 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <filesystem>
+#include <nlohmann/json.hpp>
+#include <sstream>
+#include <status_monitor/trace.hpp>
+
+namespace common
+{
+namespace
+{
+struct TraceFile
+{
+  int descriptor = -1;
+
+  TraceFile()
+  {
+    if (const auto path = std::getenv("SCENARIO_SIMULATOR_TRACE_FILE"); path and *path) {
+      /// @note Only the process creating the file opens the array of the events.
+      if (descriptor = ::open(path, O_WRONLY | O_APPEND | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+          0 <= descriptor) {
+        append("[\n");
+      } else if (errno == EEXIST) {
+        descriptor = ::open(path, O_WRONLY | O_APPEND | O_CLOEXEC);
+      }
+      if (0 <= descriptor) {
+        std::stringstream metadata;
+        metadata << R"({"name":"process_name","ph":"M","pid":)" << ::getpid()
+                 << R"(,"args":{"name":)" << nlohmann::json(processName()).dump() << "}},\n";
+        append(metadata.str());
+      }
+    }
+  }
+
+  ~TraceFile()
+  {
+    if (0 <= descriptor) {
+      ::close(descriptor);
+    }
+  }
+
+  static auto processName() -> std::string
+  {
+#if _GNU_SOURCE
+    return std::filesystem::path(program_invocation_name).filename().string();
+#else
+    return std::to_string(::getpid());
+#endif
+  }
+
+  /*
+     The trailing comma and the missing closing bracket of the array are
+     allowed by the format, so the file stays readable even if a process is
+     killed.
+  */
+  auto append(const std::string & event) const -> void
+  {
+    [[maybe_unused]] const auto written = ::write(descriptor, event.data(), event.size());
+  }
+};
+
+auto traceFile() -> const TraceFile &
+{
+  static const TraceFile file;
+  return file;
+}
+
+auto microseconds(const Trace::clock::duration & duration)
+{
+  return std::chrono::duration<double, std::micro>(duration).count();
+}
+}  // namespace
+
+auto Trace::enabled() -> bool { return 0 <= traceFile().descriptor; }
+
+auto Trace::complete(
+  const char * category, const std::string & name, const clock::time_point & begin,
+  const clock::time_point & end) -> void
+{
+  if (enabled()) {
+    static thread_local const auto thread_id = ::gettid();
+    std::stringstream event;
+    event << std::fixed << R"({"name":)" << nlohmann::json(name).dump() << R"(,"cat":")"
+          << category << R"(","ph":"X","ts":)" << microseconds(begin.time_since_epoch())
+          << R"(,"dur":)" << microseconds(end - begin) << R"(,"pid":)" << ::getpid()
+          << R"(,"tid":)" << thread_id << "},\n";
+    traceFile().append(event.str());
+  }
+}
+
+ScopedTraceEvent::ScopedTraceEvent(const char * category, const char * name)
+: category(category), name(name), enabled(Trace::enabled()), begin(Trace::clock::now())
+{
+}
+
+ScopedTraceEvent::ScopedTraceEvent(const char * category, const std::string & name)
+: category(category),
+  name(nullptr),
+  dynamic_name(Trace::enabled() ? name : std::string()),
+  enabled(Trace::enabled()),
+  begin(Trace::clock::now())
+{
+}
+
+ScopedTraceEvent::~ScopedTraceEvent()
+{
+  if (enabled) {
+    Trace::complete(category, name ? name : dynamic_name, begin, Trace::clock::now());
+  }
+}
+}  // namespace common
@@ -34,16 +34,36 @@ class ContinuousTransformBroadcaster
 
   geometry_msgs::msg::TransformStamped current_transform;
 
+  geometry_msgs::msg::TransformStamped sent_transform;
+
   const rclcpp::TimerBase::SharedPtr timer;
 
+  /*
+     The transform is broadcast as soon as it changes. An unchanged transform is broadcast again
+     only once it gets old, as often as the localization of Autoware is updated, so a still ego
+     does not load TF at the rate of the timer.
+  */
   void updateTransform()
   {
+    /// @note Hard coded parameter, the period of the localization topics of Autoware.
+    constexpr auto max_staleness = std::chrono::milliseconds(20);
+
     if (
       not current_transform.header.frame_id.empty() and
       not current_transform.child_frame_id.empty())  //
     {
-      current_transform.header.stamp = static_cast<Node &>(*this).get_clock()->now();
-      return transform_broadcaster.sendTransform(current_transform);
+      const auto now = static_cast<Node &>(*this).get_clock()->now();
+      const auto elapsed = now - rclcpp::Time(sent_transform.header.stamp, now.get_clock_type());
+      /// @note The elapsed time is negative when the clock is reset, as between scenarios.
+      if (
+        current_transform.transform != sent_transform.transform or
+        current_transform.header.frame_id != sent_transform.header.frame_id or
+        current_transform.child_frame_id != sent_transform.child_frame_id or
+        elapsed.nanoseconds() < 0 or elapsed >= rclcpp::Duration(max_staleness)) {
+        current_transform.header.stamp = now;
+        transform_broadcaster.sendTransform(current_transform);
+        sent_transform = current_transform;
+      }
     }
   }
 
@@ -35,6 +35,8 @@
 #include <autoware_auto_perception_msgs/msg/traffic_signal_array.hpp>
 #include <autoware_auto_planning_msgs/msg/path_with_lane_id.hpp>
 #include <autoware_auto_system_msgs/msg/emergency_state.hpp>
+#include <array>
+#include <atomic>
 #include <autoware_auto_vehicle_msgs/msg/gear_command.hpp>
 #include <concealer/autoware_universe.hpp>
 #include <concealer/field_operator_application.hpp>
@@ -42,6 +44,8 @@
 #include <concealer/service_with_validation.hpp>
 #include <concealer/subscriber_wrapper.hpp>
 #include <concealer/task_queue.hpp>
+#include <condition_variable>
+#include <cstring>
 #include <geometry_msgs/msg/pose_with_covariance_stamped.hpp>
 #include <tier4_external_api_msgs/msg/emergency.hpp>
 #include <tier4_external_api_msgs/srv/engage.hpp>
@@ -49,7 +53,9 @@
 #include <tier4_planning_msgs/msg/trajectory.hpp>
 #include <tier4_rtc_msgs/msg/cooperate_status_array.hpp>
 #include <tier4_rtc_msgs/srv/auto_mode_with_module.hpp>
+#include <mutex>
 #include <tier4_rtc_msgs/srv/cooperate_commands.hpp>
+#include <unordered_set>
 
 namespace concealer
 {
@@ -88,7 +94,58 @@ class FieldOperatorApplicationFor<AutowareUniverse>
 
   tier4_rtc_msgs::msg::CooperateStatusArray latest_cooperate_status_array;
 
-  std::string autoware_state;
+  struct CooperateStatusKey
+  {
+    std::uint8_t module_type;
+
+    std::array<std::uint8_t, 16> uuid;
+
+    std::uint8_t command_type;
+
+    explicit CooperateStatusKey(const tier4_rtc_msgs::msg::CooperateStatus &);
+
+    auto operator==(const CooperateStatusKey &) const noexcept -> bool;
+
+    struct Hash
+    {
+      auto operator()(const CooperateStatusKey &) const noexcept -> std::size_t;
+    };
+  };
+
+  /*
+     NOTE: Cooperate statuses already answered by sendCooperateCommand. Only
+     the ones still published are kept on each update of the statuses, so
+     this does not grow over a long session.
+  */
+  std::unordered_set<CooperateStatusKey, CooperateStatusKey::Hash> used_cooperate_statuses;
+
+  auto receiveCooperateStatusArray(const tier4_rtc_msgs::msg::CooperateStatusArray &) -> void;
+
+  /*
+     NOTE: The state is one of the string literals returned by
+     getAutowareStateString, so that it can be read from the thread of the
+     task queue without a lock. The mutex only orders the store against the
+     waits for a transition, so that no notification is lost.
+  */
+  std::atomic<char const *> autoware_state{""};
+
+  mutable std::mutex autoware_state_mutex;
+
+  mutable std::condition_variable autoware_state_changed;
+
+  auto setAutowareState(char const * state) -> void;
+
+  /*
+     Wait until the predicate is satisfied, a stop is requested or the
+     interval elapses, whichever comes first. Returns false on the timeout.
+  */
+  template <typename Predicate, typename Interval>
+  auto waitForAutowareState(Predicate && satisfied, const Interval & interval) const -> bool
+  {
+    auto lock = std::unique_lock<std::mutex>(autoware_state_mutex);
+    return autoware_state_changed.wait_for(
+      lock, interval, [&]() { return isStopRequested() or satisfied(); });
+  }
 
   std::string minimum_risk_maneuver_state;
 
@@ -103,8 +160,8 @@ class FieldOperatorApplicationFor<AutowareUniverse>
      argument or template parameter. Otherwise, code using this class would
      need to have knowledge of the Autoware state type.
   */
-#define DEFINE_STATE_PREDICATE(NAME, VALUE)                           \
-  auto is##NAME() const noexcept { return autoware_state == #VALUE; } \
+#define DEFINE_STATE_PREDICATE(NAME, VALUE)                                            \
+  auto is##NAME() const noexcept { return std::strcmp(autoware_state, #VALUE) == 0; } \
   static_assert(true, "")
 
   DEFINE_STATE_PREDICATE(Initializing, INITIALIZING_VEHICLE);
@@ -159,7 +216,7 @@ public:
        Even if the topic comes in multiple types, as long as the content is the same,
        there is basically no problem, but there is a possibility that potential problems may occur.
       */
-       autoware_state = getAutowareStateString<autoware_system_msgs::msg::AutowareState>(v.state); }),
+       setAutowareState(getAutowareStateString<autoware_system_msgs::msg::AutowareState>(v.state)); }),
 #endif
 #if __has_include(<autoware_auto_system_msgs/msg/autoware_state.hpp>)
     getAutowareAutoState("/autoware/state", rclcpp::QoS(1), *this, [this](const auto & v) {
@@ -169,10 +226,10 @@ public:
        Even if the topic comes in multiple types, as long as the content is the same,
        there is basically no problem, but there is a possibility that potential problems may occur.
       */
-      autoware_state = getAutowareStateString<autoware_auto_system_msgs::msg::AutowareState>(v.state);
+      setAutowareState(getAutowareStateString<autoware_auto_system_msgs::msg::AutowareState>(v.state));
     }),
 #endif
-    getCooperateStatusArray("/api/external/get/rtc_status", rclcpp::QoS(1), *this, [this](const auto & v) { latest_cooperate_status_array = v; }),
+    getCooperateStatusArray("/api/external/get/rtc_status", rclcpp::QoS(1), *this, [this](const auto & v) { receiveCooperateStatusArray(v); }),
     getEmergencyState("/api/external/get/emergency", rclcpp::QoS(1), *this, [this](const auto & v) { receiveEmergencyState(v); }),
 #if __has_include(<autoware_adapi_v1_msgs/msg/localization_initialization_state.hpp>)
     getLocalizationState("/api/localization/initialization_state", rclcpp::QoS(1).transient_local(), *this),
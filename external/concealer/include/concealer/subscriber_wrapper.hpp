@@ -15,6 +15,9 @@
 #ifndef CONCEALER__SUBSCRIBER_WRAPPER_HPP_
 #define CONCEALER__SUBSCRIBER_WRAPPER_HPP_
 
+#include <array>
+#include <atomic>
+#include <cstddef>
 #include <memory>
 #include <rclcpp/rclcpp.hpp>
 
@@ -22,21 +25,30 @@ namespace concealer
 {
 enum class ThreadSafety : bool { unsafe, safe };
 
+/*
+   The messages are kept in a ring, and the latest one is published to the readers through an atomic
+   pointer. Readers never wait for the executor thread delivering the messages, and the reference a
+   reader got stays valid until the ring wraps, which takes as many new messages as its size. Only
+   the executor thread writes into the ring, so without thread safety one message is enough.
+*/
 template <typename MessageType, ThreadSafety thread_safety = ThreadSafety::unsafe>
 class SubscriberWrapper
 {
-  typename MessageType::ConstSharedPtr current_value = std::make_shared<const MessageType>();
+  static constexpr std::size_t buffer_size = thread_safety == ThreadSafety::safe ? 4 : 1;
+
+  std::array<typename MessageType::ConstSharedPtr, buffer_size> buffer{
+    {std::make_shared<const MessageType>()}};
+
+  std::size_t latest_index = 0;
+
+  std::atomic<const MessageType *> current_value{buffer.front().get()};
 
   typename rclcpp::Subscription<MessageType>::SharedPtr subscription;
 
 public:
-  auto operator()() const -> decltype(auto)
+  auto operator()() const -> const MessageType &
   {
-    if constexpr (thread_safety == ThreadSafety::unsafe) {
-      return *current_value;
-    } else {
-      return *std::atomic_load(&current_value);
-    }
+    return *current_value.load(std::memory_order_acquire);
   }
 
   template <typename NodeInterface>
@@ -47,14 +59,12 @@ public:
   : subscription(autoware_interface.template create_subscription<MessageType>(
       topic, quality_of_service,
       [this, callback](const typename MessageType::ConstSharedPtr message) {
-        if constexpr (thread_safety == ThreadSafety::safe) {
-          std::atomic_store(&current_value, message);
-          if (current_value and callback) {
-            callback(*std::atomic_load(&current_value));
-          }
-        } else {
-          if (current_value = message; current_value and callback) {
-            callback(*current_value);
+        if (message) {
+          latest_index = (latest_index + 1) % buffer_size;
+          buffer[latest_index] = message;
+          current_value.store(message.get(), std::memory_order_release);
+          if (callback) {
+            callback(*message);
           }
         }
       }))
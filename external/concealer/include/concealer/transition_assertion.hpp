@@ -17,7 +17,6 @@
 
 #include <chrono>
 #include <rclcpp/node.hpp>
-#include <rclcpp/rate.hpp>
 #include <scenario_simulator_exception/exception.hpp>
 
 namespace concealer
@@ -45,13 +44,14 @@ struct TransitionAssertion
   auto waitForAutowareStateToBe##STATE(                                                 \
     Thunk && thunk = [] {}, Interval interval = std::chrono::seconds(1))                \
   {                                                                                     \
-    for (thunk(); not static_cast<const Autoware &>(*this).isStopRequested() and        \
-                  not static_cast<const Autoware &>(*this).is##STATE();                 \
-         rclcpp::GenericRate<std::chrono::steady_clock>(interval).sleep()) {            \
+    const auto & autoware = static_cast<const Autoware &>(*this);                       \
+    for (thunk(); not autoware.isStopRequested() and                                    \
+                  not autoware.waitForAutowareState(                                    \
+                    [&]() { return autoware.is##STATE(); }, interval);) {               \
       if (                                                                              \
         have_never_been_engaged and                                                     \
         start + initialize_duration <= std::chrono::steady_clock::now()) {              \
-        const auto state = static_cast<const Autoware &>(*this).getAutowareStateName(); \
+        const auto state = autoware.getAutowareStateName();                             \
         throw common::AutowareError(                                                    \
           "Simulator waited for the Autoware state to transition to " #STATE            \
           ", but time is up. The current Autoware state is ",                           \
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <concealer/autoware_universe.hpp>
+#include <status_monitor/trace.hpp>
 
 namespace concealer
 {
@@ -81,6 +82,8 @@ auto AutowareUniverse::getSteeringAngle() const -> double
 
 auto AutowareUniverse::updateLocalization() -> void
 {
+  common::ScopedTraceEvent event("concealer", "AutowareUniverse::updateLocalization");
+
   setAcceleration([this]() {
     geometry_msgs::msg::AccelWithCovarianceStamped message;
     message.header.stamp = get_clock()->now();
@@ -110,6 +113,8 @@ auto AutowareUniverse::updateLocalization() -> void
 
 auto AutowareUniverse::updateVehicleState() -> void
 {
+  common::ScopedTraceEvent event("concealer", "AutowareUniverse::updateVehicleState");
+
   setControlModeReport([this]() {
     autoware_auto_vehicle_msgs::msg::ControlModeReport message;
     message.mode = autoware_auto_vehicle_msgs::msg::ControlModeReport::AUTONOMOUS;
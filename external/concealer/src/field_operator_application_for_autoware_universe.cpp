@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <boost/functional/hash.hpp>
 #include <boost/range/adaptor/sliced.hpp>
 #include <concealer/field_operator_application_for_autoware_universe.hpp>
 #include <concealer/has_data_member_allow_goal_modification.hpp>
@@ -225,16 +226,8 @@ auto FieldOperatorApplicationFor<AutowareUniverse>::sendCooperateCommand(
    *       So, we need to check cooperate statuses if they are used or not in scenario_simulator_v2 side
    *       to avoid sending the same cooperate command when sending multiple commands between updates of cooperate statuses.
    */
-  static std::vector<tier4_rtc_msgs::msg::CooperateStatus> used_cooperate_statuses;
   auto is_used_cooperate_status = [this](const auto & cooperate_status) {
-    return std::find_if(
-             used_cooperate_statuses.begin(), used_cooperate_statuses.end(),
-             [&cooperate_status](const auto & used_cooperate_status) {
-               return used_cooperate_status.module == cooperate_status.module &&
-                      used_cooperate_status.uuid == cooperate_status.uuid &&
-                      used_cooperate_status.command_status.type ==
-                        cooperate_status.command_status.type;
-             }) != used_cooperate_statuses.end();
+    return used_cooperate_statuses.count(CooperateStatusKey(cooperate_status)) != 0;
   };
 
   if (const auto cooperate_status = std::find_if(
@@ -266,24 +259,91 @@ auto FieldOperatorApplicationFor<AutowareUniverse>::sendCooperateCommand(
 
     task_queue.delay([this, request]() { requestCooperateCommands(request); });
 
-    used_cooperate_statuses.push_back(*cooperate_status);
+    used_cooperate_statuses.emplace(*cooperate_status);
   }
 }
 
+FieldOperatorApplicationFor<AutowareUniverse>::CooperateStatusKey::CooperateStatusKey(
+  const tier4_rtc_msgs::msg::CooperateStatus & cooperate_status)
+: module_type(cooperate_status.module.type),
+  uuid(cooperate_status.uuid.uuid),
+  command_type(cooperate_status.command_status.type)
+{
+}
+
+auto FieldOperatorApplicationFor<AutowareUniverse>::CooperateStatusKey::operator==(
+  const CooperateStatusKey & other) const noexcept -> bool
+{
+  return module_type == other.module_type and uuid == other.uuid and
+         command_type == other.command_type;
+}
+
+auto FieldOperatorApplicationFor<AutowareUniverse>::CooperateStatusKey::Hash::operator()(
+  const CooperateStatusKey & key) const noexcept -> std::size_t
+{
+  std::size_t seed = 0;
+  boost::hash_combine(seed, key.module_type);
+  boost::hash_range(seed, key.uuid.begin(), key.uuid.end());
+  boost::hash_combine(seed, key.command_type);
+  return seed;
+}
+
+auto FieldOperatorApplicationFor<AutowareUniverse>::receiveCooperateStatusArray(
+  const tier4_rtc_msgs::msg::CooperateStatusArray & message) -> void
+{
+  /*
+     Autoware deletes the used cooperate statuses from the array, so a used
+     status that is no longer published will never be matched again.
+  */
+  if (not used_cooperate_statuses.empty()) {
+    decltype(used_cooperate_statuses) still_used_cooperate_statuses;
+    for (const auto & cooperate_status : message.statuses) {
+      if (auto key = CooperateStatusKey(cooperate_status); used_cooperate_statuses.count(key)) {
+        still_used_cooperate_statuses.insert(std::move(key));
+      }
+    }
+    used_cooperate_statuses = std::move(still_used_cooperate_statuses);
+  }
+
+  latest_cooperate_status_array = message;
+}
+
 auto FieldOperatorApplicationFor<AutowareUniverse>::initialize(
   const geometry_msgs::msg::Pose & initial_pose) -> void
 {
   if (not std::exchange(initialize_was_called, true)) {
     task_queue.delay([this, initial_pose]() {
+      auto relocalization_was_requested = false;
       waitForAutowareStateToBeWaitingForRoute([&]() {
+        /*
+           An Autoware not launched by concealer may be kept running between scenarios to save its
+           launch. It is then reset from the state the previous scenario left it in: disengaged,
+           its route cleared, and localized again at the initial pose of this scenario.
+        */
+        if (process_id == 0 and (isPlanning() or isWaitingForEngage() or isDriving() or
+                                 isArrivedGoal())) {
+          if (isDriving()) {
+            auto request = std::make_shared<tier4_external_api_msgs::srv::Engage::Request>();
+            request->engage = false;
+            try {
+              requestEngage(request);
+            } catch (const decltype(requestEngage)::TimeoutError &) {
+              // ignore timeout error because the Autoware state transition validates this service.
+            }
+          }
+          requestClearRoute(std::make_shared<autoware_adapi_v1_msgs::srv::ClearRoute::Request>());
+        }
 
 #if __has_include(<autoware_adapi_v1_msgs/msg/localization_initialization_state.hpp>)
         if (
           getLocalizationState().state !=
-          autoware_adapi_v1_msgs::msg::LocalizationInitializationState::UNINITIALIZED) {
+            autoware_adapi_v1_msgs::msg::LocalizationInitializationState::UNINITIALIZED and
+          (process_id != 0 or relocalization_was_requested)) {
           return;
         }
 #endif
+        relocalization_was_requested = true;
+
         geometry_msgs::msg::PoseWithCovarianceStamped initial_pose_msg;
         initial_pose_msg.header.stamp = get_clock()->now();
         initial_pose_msg.header.frame_id = "map";
@@ -414,7 +474,18 @@ auto FieldOperatorApplicationFor<AutowareUniverse>::restrictTargetSpeed(double v
 
 auto FieldOperatorApplicationFor<AutowareUniverse>::getAutowareStateName() const -> std::string
 {
-  return autoware_state;
+  return autoware_state.load();
+}
+
+auto FieldOperatorApplicationFor<AutowareUniverse>::setAutowareState(char const * state) -> void
+{
+  if (std::strcmp(autoware_state, state) != 0) {
+    {
+      std::lock_guard<std::mutex> lock(autoware_state_mutex);
+      autoware_state = state;
+    }
+    autoware_state_changed.notify_all();
+  }
 }
 
 auto FieldOperatorApplicationFor<AutowareUniverse>::getEmergencyStateName() const -> std::string
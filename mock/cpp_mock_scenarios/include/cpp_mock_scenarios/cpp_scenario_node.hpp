@@ -15,6 +15,7 @@
 #ifndef CPP_MOCK_SCENARIOS__CPP_SCENARIO_NODE_HPP_
 #define CPP_MOCK_SCENARIOS__CPP_SCENARIO_NODE_HPP_
 
+#include <chrono>
 #include <limits>
 #include <memory>
 #include <rclcpp/rclcpp.hpp>
@@ -69,6 +70,20 @@ private:
   virtual void onInitialize() = 0;
   rclcpp::TimerBase::SharedPtr update_timer_;
   int timeout_;
+  /**
+   * @note In batch mode the frames are stepped back to back from start() without the executor nor
+   * the timer, as fast as the simulator allows, and the time spent per phase is reported on stop.
+   * Scenarios waiting for messages, such as the engagement of Autoware, cannot run in batch mode.
+   */
+  bool batch_ = false;
+  std::size_t frame_count_ = 0;
+  std::chrono::steady_clock::time_point batch_start_time_;
+  std::chrono::steady_clock::duration on_update_duration_{};
+  std::chrono::steady_clock::duration update_frame_duration_{};
+  std::vector<double> frame_durations_;
+  /// @note Path of the JSON file the measurements of a batch run are written to, if not empty.
+  std::string benchmark_path_;
+  void writeBenchmark(const double elapsed_time) const;
   auto configure(
     const std::string & map_path, const std::string & lanelet2_map_file,
     const std::string & scenario_filename, const bool verbose) -> traffic_simulator::Configuration
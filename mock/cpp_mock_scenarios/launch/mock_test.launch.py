@@ -123,6 +123,9 @@ def launch_setup(context, *args, **kwargs):
     vehicle_model                       = LaunchConfiguration("vehicle_model",                          default="")
     scenario_package                    = LaunchConfiguration("package",                                default="cpp_mock_scenarios")
     junit_path                          = LaunchConfiguration("junit_path",                             default="/tmp/output.xunit.xml")
+    batch                               = LaunchConfiguration("batch",                                  default=False)
+    benchmark_path                      = LaunchConfiguration("benchmark_path",                         default="")
+    scenario_parameters                 = LaunchConfiguration("scenario_parameters",                    default="")
     # fmt: on
 
     print(f"architecture_type                   := {architecture_type.perform(context)}")
@@ -148,6 +151,9 @@ def launch_setup(context, *args, **kwargs):
     print(f"vehicle_model                       := {vehicle_model.perform(context)}")
     print(f"scenario_package                    := {scenario_package.perform(context)}")
     print(f"junit_path                          := {junit_path.perform(context)}")
+    print(f"batch                               := {batch.perform(context)}")
+    print(f"benchmark_path                      := {benchmark_path.perform(context)}")
+    print(f"scenario_parameters                 := {scenario_parameters.perform(context)}")
 
     def make_parameters():
         parameters = [
@@ -186,13 +192,23 @@ def launch_setup(context, *args, **kwargs):
             parameters.append(description() + "/config/simulator_model.param.yaml")
         return parameters
 
+    def make_scenario_parameters():
+        parameters = [
+            {"batch": batch},
+            {"benchmark_path": benchmark_path},
+        ]
+        # Parameters specific to a scenario, such as the entity counts of the stress scenario.
+        if scenario_parameters.perform(context):
+            parameters.append(scenario_parameters.perform(context))
+        return parameters
+
     cpp_scenario_node = Node(
             package=scenario_package,
             executable=scenario,
             name="scenario_node",
             output="screen",
             arguments=[("__log_level:=info")],
-            parameters=make_parameters() + [{"use_sim_time": use_sim_time}],
+            parameters=make_parameters() + make_scenario_parameters() + [{"use_sim_time": use_sim_time}],
             )
     io_handler = OnProcessIO(
         target_action=cpp_scenario_node,
@@ -225,6 +241,9 @@ def launch_setup(context, *args, **kwargs):
         DeclareLaunchArgument("vehicle_model",                       default_value=vehicle_model                      ),
         DeclareLaunchArgument("scenario_package",                    default_value=scenario_package                   ),
         DeclareLaunchArgument("junit_path",                          default_value=junit_path                         ),
+        DeclareLaunchArgument("batch",                               default_value=batch                              ),
+        DeclareLaunchArgument("benchmark_path",                      default_value=benchmark_path                     ),
+        DeclareLaunchArgument("scenario_parameters",                 default_value=scenario_parameters                ),
         # fmt: on
         cpp_scenario_node,
         Node(
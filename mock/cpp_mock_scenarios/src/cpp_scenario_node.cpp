@@ -12,7 +12,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <sys/resource.h>
+
+#include <algorithm>
 #include <cpp_mock_scenarios/cpp_scenario_node.hpp>
+#include <fstream>
 #include <iostream>
 
 namespace cpp_mock_scenarios
@@ -33,6 +37,10 @@ CppScenarioNode::CppScenarioNode(
   get_parameter<std::string>("junit_path", junit_path_);
   declare_parameter<int>("global_timeout", 10.0);
   get_parameter<int>("global_timeout", timeout_);
+  declare_parameter<bool>("batch", false);
+  get_parameter<bool>("batch", batch_);
+  declare_parameter<std::string>("benchmark_path", "");
+  get_parameter<std::string>("benchmark_path", benchmark_path_);
 
   traffic_simulator::lanelet_pose::CanonicalizedLaneletPose::setConsiderPoseByRoadSlope([&]() {
     if (not has_parameter("consider_pose_by_road_slope")) {
@@ -40,13 +48,29 @@ CppScenarioNode::CppScenarioNode(
     }
     return get_parameter("consider_pose_by_road_slope").as_bool();
   }());
+  traffic_simulator::lanelet_pose::CanonicalizedLaneletPose::setUseElevationProfile([&]() {
+    if (not has_parameter("use_elevation_profile")) {
+      declare_parameter("use_elevation_profile", false);
+    }
+    return get_parameter("use_elevation_profile").as_bool();
+  }());
 }
 
 void CppScenarioNode::update()
 {
+  const auto on_update_start_time = std::chrono::steady_clock::now();
   onUpdate();
+  const auto update_frame_start_time = std::chrono::steady_clock::now();
+  on_update_duration_ += update_frame_start_time - on_update_start_time;
+  ++frame_count_;
   try {
     api_.updateFrame();
+    const auto update_frame_end_time = std::chrono::steady_clock::now();
+    update_frame_duration_ += update_frame_end_time - update_frame_start_time;
+    if (batch_) {
+      frame_durations_.push_back(
+        std::chrono::duration<double>(update_frame_end_time - on_update_start_time).count());
+    }
     if (api_.getCurrentTime() >= timeout_) {
       stop(Result::FAILURE);
     }
@@ -64,9 +88,16 @@ void CppScenarioNode::start()
 {
   onInitialize();
   api_.startNpcLogic();
-  const auto rate =
-    std::chrono::duration<double>(1.0 / get_parameter("global_frame_rate").as_double());
-  update_timer_ = this->create_wall_timer(rate, std::bind(&CppScenarioNode::update, this));
+  if (batch_) {
+    batch_start_time_ = std::chrono::steady_clock::now();
+    while (rclcpp::ok()) {
+      update();
+    }
+  } else {
+    const auto rate =
+      std::chrono::duration<double>(1.0 / get_parameter("global_frame_rate").as_double());
+    update_timer_ = this->create_wall_timer(rate, std::bind(&CppScenarioNode::update, this));
+  }
 }
 
 void CppScenarioNode::stop(Result result, const std::string & description)
@@ -90,12 +121,65 @@ void CppScenarioNode::stop(Result result, const std::string & description)
     }
   }
   // junit_.testsuite("cpp_mock_scenario").testcase(scenario_filename_).time = api_.getCurrentTime();
+  if (batch_) {
+    const auto seconds = [](const auto & duration) {
+      return std::chrono::duration<double>(duration).count();
+    };
+    const auto elapsed_time = seconds(std::chrono::steady_clock::now() - batch_start_time_);
+    junit_.testsuite("cpp_mock_scenario").testcase(scenario_filename_).time =
+      std::to_string(elapsed_time);
+    std::cout << "cpp_scenario:batch frames: " << frame_count_
+              << " frames_per_second: " << frame_count_ / elapsed_time
+              << " on_update: " << seconds(on_update_duration_) << "s"
+              << " update_frame: " << seconds(update_frame_duration_) << "s" << std::endl;
+    if (not benchmark_path_.empty()) {
+      writeBenchmark(elapsed_time);
+    }
+  }
   junit_.write_to(junit_path_.c_str(), "  ");
-  update_timer_->cancel();
+  if (update_timer_) {
+    update_timer_->cancel();
+  }
   rclcpp::shutdown();
   std::exit(0);
 }
 
+void CppScenarioNode::writeBenchmark(const double elapsed_time) const
+{
+  auto frame_durations = frame_durations_;
+  double frame_p99 = 0.0;
+  if (not frame_durations.empty()) {
+    const auto p99 = std::next(
+      frame_durations.begin(), static_cast<std::ptrdiff_t>(0.99 * (frame_durations.size() - 1)));
+    std::nth_element(frame_durations.begin(), p99, frame_durations.end());
+    frame_p99 = *p99;
+  }
+
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+
+  const auto simulated_time = api_.getCurrentTime();
+
+  std::ofstream file(benchmark_path_);
+  file << "{\n"
+       << "  \"scenario\": \"" << scenario_filename_ << "\",\n"
+       << "  \"frames\": " << frame_count_ << ",\n"
+       << "  \"simulated_time\": " << simulated_time << ",\n"
+       << "  \"wall_time\": " << elapsed_time << ",\n"
+       << "  \"wall_time_per_simulated_second\": "
+       << (simulated_time > 0.0 ? elapsed_time / simulated_time : 0.0) << ",\n"
+       << "  \"frame_time_p99\": " << frame_p99 << ",\n"
+       << "  \"on_update_time\": " << std::chrono::duration<double>(on_update_duration_).count()
+       << ",\n"
+       << "  \"update_frame_time\": "
+       << std::chrono::duration<double>(update_frame_duration_).count() << ",\n"
+       << "  \"rpc_time\": " << std::chrono::duration<double>(api_.getZMQCallDuration()).count()
+       << ",\n"
+       << "  \"peak_rss_kb\": " << usage.ru_maxrss << ",\n"
+       << "  \"rpc_calls\": " << api_.getZMQCallCount() << "\n"
+       << "}\n";
+}
+
 void CppScenarioNode::spawnEgoEntity(
   const traffic_simulator::CanonicalizedLaneletPose & spawn_lanelet_pose,
   const std::vector<traffic_simulator::CanonicalizedLaneletPose> & goal_lanelet_poses,
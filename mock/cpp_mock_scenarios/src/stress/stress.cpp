@@ -0,0 +1,144 @@
+// Copyright 2024 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ament_index_cpp/get_package_share_directory.hpp>
+#include <cpp_mock_scenarios/catalogs.hpp>
+#include <cpp_mock_scenarios/cpp_scenario_node.hpp>
+#include <geometry/quaternion/euler_to_quaternion.hpp>
+#include <memory>
+#include <rclcpp/rclcpp.hpp>
+#include <string>
+#include <traffic_simulator/api/api.hpp>
+#include <vector>
+
+namespace cpp_mock_scenarios
+{
+/**
+ * @brief Spawn vehicle_count vehicles and pedestrian_count pedestrians on the roads of the map and
+ * run them for duration seconds, to measure how the cost of a frame grows with the entities.
+ * @note The entities are spawned every spacing meters along the road lanelets, vehicles first.
+ */
+class Stress : public cpp_mock_scenarios::CppScenarioNode
+{
+public:
+  explicit Stress(const rclcpp::NodeOptions & option)
+  : cpp_mock_scenarios::CppScenarioNode(
+      "stress", ament_index_cpp::get_package_share_directory("kashiwanoha_map") + "/map",
+      "lanelet2_map.osm", __FILE__, false, option)
+  {
+    declare_parameter<int>("vehicle_count", 10);
+    declare_parameter<int>("pedestrian_count", 0);
+    declare_parameter<bool>("use_default_behavior", true);
+    declare_parameter<bool>("attach_detection_sensor", false);
+    declare_parameter<double>("traffic_source_rate", 0.0);
+    declare_parameter<double>("spacing", 10.0);
+    declare_parameter<double>("duration", 10.0);
+    start();
+  }
+
+private:
+  using VehicleBehavior = traffic_simulator::entity::VehicleEntity::BuiltinBehavior;
+  using PedestrianBehavior = traffic_simulator::entity::PedestrianEntity::BuiltinBehavior;
+
+  void onUpdate() override
+  {
+    if (api_.getCurrentTime() >= get_parameter("duration").as_double()) {
+      stop(cpp_mock_scenarios::Result::SUCCESS);
+    }
+  }
+
+  auto getSpawnPoses(const std::size_t count)
+    -> std::vector<traffic_simulator::CanonicalizedLaneletPose>
+  {
+    const auto & hdmap_utils = api_.getHdmapUtils();
+    const auto spacing = get_parameter("spacing").as_double();
+    std::vector<traffic_simulator::CanonicalizedLaneletPose> poses;
+    for (const auto id : hdmap_utils->filterLaneletIds(
+           hdmap_utils->getLaneletIds(), lanelet::AttributeValueString::Road)) {
+      for (double s = 0.5 * spacing; s < hdmap_utils->getLaneletLength(id); s += spacing) {
+        if (poses.size() == count) {
+          return poses;
+        }
+        poses.push_back(
+          traffic_simulator::helper::constructCanonicalizedLaneletPose(id, s, 0.0, hdmap_utils));
+      }
+    }
+    return poses;
+  }
+
+  void onInitialize() override
+  {
+    const auto vehicle_count = static_cast<std::size_t>(get_parameter("vehicle_count").as_int());
+    const auto pedestrian_count =
+      static_cast<std::size_t>(get_parameter("pedestrian_count").as_int());
+    const auto use_default_behavior = get_parameter("use_default_behavior").as_bool();
+
+    /// @note The ego takes the first pose, so the other entities do not overlap it.
+    const auto poses = getSpawnPoses(1 + vehicle_count + pedestrian_count);
+    if (poses.size() < 1 + vehicle_count + pedestrian_count) {
+      stop(cpp_mock_scenarios::Result::FAILURE);  // LCOV_EXCL_LINE
+      return;                                      // LCOV_EXCL_LINE
+    }
+
+    api_.spawn("ego", poses[0], getVehicleParameters());
+    api_.setLinearVelocity("ego", 0.0);
+    api_.requestSpeedChange("ego", 0.0, true);
+    if (get_parameter("attach_detection_sensor").as_bool()) {
+      api_.attachDetectionSensor("ego", 200.0, true, 0.0, 0, 0.0, 0.0);
+    }
+
+    for (std::size_t i = 0; i < vehicle_count; ++i) {
+      const auto name = "vehicle_" + std::to_string(i);
+      api_.spawn(
+        name, poses[1 + i], getVehicleParameters(),
+        use_default_behavior ? VehicleBehavior::defaultBehavior() : VehicleBehavior::doNothing());
+      api_.requestSpeedChange(name, 10.0, true);
+    }
+
+    for (std::size_t i = 0; i < pedestrian_count; ++i) {
+      const auto name = "pedestrian_" + std::to_string(i);
+      api_.spawn(
+        name, poses[1 + vehicle_count + i], getPedestrianParameters(),
+        use_default_behavior ? PedestrianBehavior::defaultBehavior()
+                             : PedestrianBehavior::doNothing());
+      api_.requestSpeedChange(name, 1.0, true);
+    }
+
+    if (const auto rate = get_parameter("traffic_source_rate").as_double(); rate > 0.0) {
+      api_.addTrafficSource(
+        200.0, rate, 10.0,
+        geometry_msgs::build<geometry_msgs::msg::Pose>()
+          .position(geometry_msgs::build<geometry_msgs::msg::Point>().x(3764.18).y(73745.45).z(0.0))
+          .orientation(math::geometry::convertEulerAngleToQuaternion(
+            geometry_msgs::build<geometry_msgs::msg::Vector3>().x(0.0).y(0.0).z(0.321802))),
+        // clang-format off
+        {
+          {getVehicleParameters(), VehicleBehavior::defaultBehavior(), "", 0.0},
+        }  // clang-format on
+        ,
+        false, true, true, 0);
+    }
+  }
+};
+}  // namespace cpp_mock_scenarios
+
+int main(int argc, char * argv[])
+{
+  rclcpp::init(argc, argv);
+  rclcpp::NodeOptions options;
+  auto component = std::make_shared<cpp_mock_scenarios::Stress>(options);
+  rclcpp::spin(component);
+  rclcpp::shutdown();
+  return 0;
+}
@@ -52,6 +52,26 @@ class Interpreter : public rclcpp_lifecycle::LifecycleNode,
 
   const rclcpp_lifecycle::LifecyclePublisher<Context>::SharedPtr publisher_of_context;
 
+  /*
+     If true, the next frame starts as soon as the previous one is completed,
+     instead of waiting for the period of local_frame_rate. The simulation time
+     still advances by local_real_time_factor / local_frame_rate per frame, so
+     the results do not change, only the wall-clock time they take. This is
+     intended for use with use_sim_time on machines running scenarios in batch.
+  */
+  bool as_fast_as_possible;
+
+  /*
+     The context is published at most at this rate (Hz) of wall-clock time,
+     and at once when a storyboard element changes its state. If zero, the
+     context is published on every frame.
+  */
+  double context_publish_rate;
+
+  std::chrono::steady_clock::time_point context_published_time;
+
+  std::size_t context_published_transition_count = 0;
+
   double local_frame_rate;
 
   double local_real_time_factor;
@@ -64,6 +84,13 @@ class Interpreter : public rclcpp_lifecycle::LifecycleNode,
 
   bool record;
 
+  /*
+     Whitespace separated topics to be recorded, or every topic if empty. For
+     example, "/simulation/context /simulation/entity/status" records a
+     compact trace of the scenario without the sensor data.
+  */
+  String record_topics;
+
   std::shared_ptr<OpenScenario> script;
 
   std::list<std::shared_ptr<ScenarioDefinition>> scenarios;
@@ -110,7 +137,8 @@ public:
 
   auto on_shutdown(const rclcpp_lifecycle::State &) -> Result override;
 
-  auto publishCurrentContext() const -> void;
+  /// @note Skipped with no subscriber, unless forced, and rate limited as context_publish_rate.
+  auto publishCurrentContext(const bool forced = false) -> void;
 
   auto reset() -> void;
 
@@ -197,8 +225,9 @@ public:
   template <typename TimeoutHandler, typename Thunk>
   auto withTimeoutHandler(TimeoutHandler && handle, Thunk && thunk) -> decltype(auto)
   {
-    if (const auto time = execution_timer.invoke("", thunk); currentLocalFrameRate() < time) {
-      handle(execution_timer.getStatistics(""));
+    if (const auto time = execution_timer.invoke("frame", thunk);
+        not as_fast_as_possible and currentLocalFrameRate() < time) {
+      handle(execution_timer.getStatistics("frame"));
     }
   }
 
@@ -99,16 +99,22 @@ public:
     return type() == typeid(U);
   }
 
+  /*
+     is_also and as cast the raw pointer rather than std::dynamic_pointer_cast
+     it, because they are called for every condition and action on every frame
+     and the copy of the shared_ptr costs two atomic operations. The result
+     lives as long as this pointer as before.
+  */
   template <typename U>
   auto is_also() const
   {
-    return static_cast<bool>(std::dynamic_pointer_cast<U>(*this));
+    return dynamic_cast<U *>(this->get()) != nullptr;
   }
 
   template <typename U>
   auto as() const -> U &
   {
-    if (const auto bound = std::dynamic_pointer_cast<U>(*this)) {
+    if (const auto bound = dynamic_cast<U *>(this->get())) {
       return *bound;
     } else {
       throw SemanticError(
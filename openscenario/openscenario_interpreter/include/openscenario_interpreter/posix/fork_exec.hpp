@@ -31,6 +31,16 @@ pid_t fork_exec(const std::vector<std::string> &);
 pid_t fork_exec(const std::string &);
 
 pid_t fork_exec(const std::string &, const std::string &);
+
+/*
+   Same as fork_exec, but returns as soon as the child is forked. The child is
+   reaped by `exited`.
+*/
+pid_t fork_exec_nowait(const std::vector<std::string> &);
+
+pid_t fork_exec_nowait(const std::string &, const std::string &);
+
+bool exited(pid_t);
 }  // namespace posix
 }  // namespace openscenario_interpreter
 
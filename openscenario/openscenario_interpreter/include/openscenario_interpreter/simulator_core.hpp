@@ -16,15 +16,19 @@
 #define OPENSCENARIO_INTERPRETER__SIMULATOR_CORE_HPP_
 
 #include <geometry/quaternion/quaternion_to_euler.hpp>
+#include <map>
 #include <openscenario_interpreter/error.hpp>
 #include <openscenario_interpreter/syntax/boolean.hpp>
 #include <openscenario_interpreter/syntax/double.hpp>
 #include <openscenario_interpreter/syntax/routing_algorithm.hpp>
 #include <openscenario_interpreter/syntax/string.hpp>
 #include <openscenario_interpreter/syntax/unsigned_integer.hpp>
+#include <optional>
 #include <traffic_simulator/api/api.hpp>
 #include <traffic_simulator/utils/distance.hpp>
 #include <traffic_simulator/utils/pose.hpp>
+#include <tuple>
+#include <vector>
 
 namespace openscenario_interpreter
 {
@@ -38,7 +42,87 @@ using NativeRelativeLanePosition = traffic_simulator::LaneletPose;
 
 class SimulatorCore
 {
-  static inline std::unique_ptr<traffic_simulator::API> core = nullptr;
+  /*
+     The state of the simulator is per thread, so that several interpreters
+     each driving its own scenario on its own thread (and executor) in one
+     process do not share it. The maps and the catalogs are read-only and are
+     shared by all of them through their registries.
+  */
+  static inline thread_local std::unique_ptr<traffic_simulator::API> core = nullptr;
+
+  enum class Query { relative_lane_position, bounding_box_relative_lane_position };
+
+  /*
+     The conditions of a frame often query the same pair of entities, and some
+     of these queries route through the lanelet map. Their results only depend
+     on the poses of the entities, so they are kept until the frame is updated
+     or an action moves, adds or deletes an entity.
+  */
+  static inline thread_local std::map<
+    std::tuple<Query, std::string, std::string, RoutingAlgorithm::value_type>,
+    traffic_simulator::LaneletPose>
+    queries;
+
+  template <typename Function>
+  static auto memoize(
+    const Query query, const std::string & from_entity_name, const std::string & to_entity_name,
+    const RoutingAlgorithm::value_type routing_algorithm, Function && function)
+    -> traffic_simulator::LaneletPose
+  {
+    auto key = std::make_tuple(query, from_entity_name, to_entity_name, routing_algorithm);
+    if (const auto iter = queries.find(key); iter != queries.end()) {
+      return iter->second;
+    } else {
+      return queries.emplace(std::move(key), function()).first->second;
+    }
+  }
+
+  /*
+     The kinematic state of every entity is taken once per frame into a flat
+     array indexed by the handles of the entities, so that the conditions of
+     the frame read it without looking the entities up by name. An action that
+     changes the state of an entity clears the array until the next frame, and
+     the entities are then queried directly.
+  */
+  struct EntityState
+  {
+    traffic_simulator::entity::EntityHandle handle;
+
+    double speed;
+
+    double acceleration;
+
+    double stand_still_duration;
+  };
+
+  static inline thread_local std::vector<std::optional<EntityState>> states;
+
+  static auto snapshot() -> void
+  {
+    states.clear();
+    for (const auto & name : core->getEntityNames()) {
+      if (const auto handle = core->getEntityHandle(name)) {
+        if (const auto entity = core->getEntity(handle.value())) {
+          if (states.size() <= handle->index) {
+            states.resize(handle->index + 1);
+          }
+          states[handle->index] = EntityState{
+            handle.value(), entity->getCurrentTwist().linear.x, entity->getCurrentAccel().linear.x,
+            entity->getStandStillDuration()};
+        }
+      }
+    }
+  }
+
+  static auto state(const traffic_simulator::entity::EntityHandle & handle) -> const EntityState *
+  {
+    if (handle.index < states.size() and states[handle.index] and
+        states[handle.index]->handle == handle) {
+      return &states[handle.index].value();
+    } else {
+      return nullptr;
+    }
+  }
 
 public:
   template <typename Node, typename... Ts>
@@ -61,10 +145,17 @@ public:
       core->despawnEntities();
       core->closeZMQConnection();
       core.reset();
+      queries.clear();
+      states.clear();
     }
   }
 
-  static auto update() -> void { core->updateFrame(); }
+  static auto update() -> void
+  {
+    core->updateFrame();
+    queries.clear();
+    snapshot();
+  }
 
   class CoordinateSystemConversion
   {
@@ -148,13 +239,16 @@ public:
       const RoutingAlgorithm::value_type routing_algorithm = RoutingAlgorithm::undefined)
       -> traffic_simulator::LaneletPose
     {
-      if (const auto to_entity = core->getEntity(to_entity_name)) {
-        if (const auto to_lanelet_pose = to_entity->getCanonicalizedLaneletPose()) {
-          return makeNativeRelativeLanePosition(
-            from_entity_name, to_lanelet_pose.value(), routing_algorithm);
-        }
-      }
-      return traffic_simulator::pose::quietNaNLaneletPose();
+      return memoize(
+        Query::relative_lane_position, from_entity_name, to_entity_name, routing_algorithm, [&]() {
+          if (const auto to_entity = core->getEntity(to_entity_name)) {
+            if (const auto to_lanelet_pose = to_entity->getCanonicalizedLaneletPose()) {
+              return makeNativeRelativeLanePosition(
+                from_entity_name, to_lanelet_pose.value(), routing_algorithm);
+            }
+          }
+          return traffic_simulator::pose::quietNaNLaneletPose();
+        });
     }
 
     static auto makeNativeRelativeLanePosition(
@@ -185,18 +279,22 @@ public:
       const std::string & from_entity_name, const std::string & to_entity_name,
       const RoutingAlgorithm::value_type routing_algorithm = RoutingAlgorithm::undefined)
     {
-      if (const auto from_entity = core->getEntity(from_entity_name)) {
-        if (const auto to_entity = core->getEntity(to_entity_name)) {
-          if (const auto from_lanelet_pose = from_entity->getCanonicalizedLaneletPose()) {
-            if (const auto to_lanelet_pose = to_entity->getCanonicalizedLaneletPose()) {
-              return makeNativeBoundingBoxRelativeLanePosition(
-                from_lanelet_pose.value(), from_entity->getBoundingBox(), to_lanelet_pose.value(),
-                to_entity->getBoundingBox(), routing_algorithm);
+      return memoize(
+        Query::bounding_box_relative_lane_position, from_entity_name, to_entity_name,
+        routing_algorithm, [&]() {
+          if (const auto from_entity = core->getEntity(from_entity_name)) {
+            if (const auto to_entity = core->getEntity(to_entity_name)) {
+              if (const auto from_lanelet_pose = from_entity->getCanonicalizedLaneletPose()) {
+                if (const auto to_lanelet_pose = to_entity->getCanonicalizedLaneletPose()) {
+                  return makeNativeBoundingBoxRelativeLanePosition(
+                    from_lanelet_pose.value(), from_entity->getBoundingBox(),
+                    to_lanelet_pose.value(), to_entity->getBoundingBox(), routing_algorithm);
+                }
+              }
             }
           }
-        }
-      }
-      return traffic_simulator::pose::quietNaNLaneletPose();
+          return traffic_simulator::pose::quietNaNLaneletPose();
+        });
     }
 
     static auto makeNativeBoundingBoxRelativeLanePosition(
@@ -293,6 +391,8 @@ public:
     template <typename... Ts>
     static auto applyAddEntityAction(Ts &&... xs)
     {
+      queries.clear();
+      states.clear();
       return core->spawn(std::forward<decltype(xs)>(xs)...);
     }
 
@@ -342,6 +442,10 @@ public:
       core->setBehaviorParameter(entity_ref, [&]() {
         auto message = core->getBehaviorParameter(entity_ref);
         message.see_around = not controller.properties.template get<Boolean>("isBlind");
+        message.use_bisection_for_follow_waypoint =
+          controller.properties.template get<Boolean>("useBisectionForFollowWaypoint");
+        message.skip_ticks_while_waiting =
+          controller.properties.template get<Boolean>("skipTicksWhileWaiting");
         /// The default values written in https://github.com/tier4/scenario_simulator_v2/blob/master/simulation/traffic_simulator_msgs/msg/DynamicConstraints.msg
         message.dynamic_constraints.max_acceleration =
           controller.properties.template get<Double>("maxAcceleration", 10.0);
@@ -370,6 +474,16 @@ public:
           return configuration;
         }());
 
+        const auto publisher_configuration = [&]() {
+          simulation_api_schema::PublisherConfiguration configuration;
+          // clang-format off
+          configuration.set_best_effort(controller.properties.template get<Boolean>("sensorPublisherBestEffort"));
+          configuration.set_history_depth(controller.properties.template get<UnsignedInteger>("sensorPublisherHistoryDepth", 1));
+          configuration.set_intra_process(controller.properties.template get<Boolean>("sensorPublisherIntraProcess"));
+          // clang-format on
+          return configuration;
+        }();
+
         core->attachLidarSensor([&]() {
           simulation_api_schema::LidarConfiguration configuration;
 
@@ -379,9 +493,13 @@ public:
 
           // clang-format off
           configuration.set_architecture_type(core->getROS2Parameter<std::string>("architecture_type", "awf/universe"));
+          configuration.set_azimuth_sliced(controller.properties.template get<Boolean>("pointcloudAzimuthSliced"));
           configuration.set_entity(entity_ref);
           configuration.set_horizontal_resolution(degree_to_radian(controller.properties.template get<Double>("pointcloudHorizontalResolution", 1.0)));
           configuration.set_lidar_sensor_delay(controller.properties.template get<Double>("pointcloudPublishingDelay"));
+          configuration.set_raycast_lanelet_map(controller.properties.template get<Boolean>("pointcloudRaycastLaneletMap"));
+          configuration.set_raycaster_backend(controller.properties.template get<String>("pointcloudRaycasterBackend", "embree"));
+          *configuration.mutable_publisher() = publisher_configuration;
           configuration.set_scan_duration(0.1);
           // clang-format on
 
@@ -410,7 +528,9 @@ public:
           configuration.set_probability_of_lost(controller.properties.template get<Double>("detectedObjectMissingProbability"));
           configuration.set_random_seed(controller.properties.template get<UnsignedInteger>("randomSeed"));
           configuration.set_range(controller.properties.template get<Double>("detectionSensorRange",300.0));
+          configuration.set_visibility_test(controller.properties.template get<Boolean>("detectionSensorVisibilityTest"));
           configuration.set_object_recognition_ground_truth_delay(controller.properties.template get<Double>("detectedObjectGroundTruthPublishingDelay"));
+          *configuration.mutable_publisher() = publisher_configuration;
           configuration.set_update_duration(0.1);
           // clang-format on
           return configuration;
@@ -423,6 +543,7 @@ public:
           configuration.set_entity(entity_ref);
           configuration.set_filter_by_range(controller.properties.template get<Boolean>("isClairvoyant"));
           configuration.set_height(200);
+          *configuration.mutable_publisher() = publisher_configuration;
           configuration.set_range(300);
           configuration.set_resolution(0.5);
           configuration.set_update_duration(0.1);
@@ -435,6 +556,8 @@ public:
           simulation_api_schema::PseudoTrafficLightDetectorConfiguration configuration;
           configuration.set_architecture_type(
             core->getROS2Parameter<std::string>("architecture_type", "awf/universe"));
+          configuration.set_keepalive_period(
+            controller.properties.template get<Double>("trafficLightKeepalivePeriod"));
           return configuration;
         }());
 
@@ -482,6 +605,8 @@ public:
     template <typename... Ts>
     static auto applyDeleteEntityAction(Ts &&... xs)
     {
+      queries.clear();
+      states.clear();
       return core->despawn(std::forward<decltype(xs)>(xs)...);
     }
 
@@ -500,12 +625,15 @@ public:
     template <typename... Ts>
     static auto applySpeedAction(Ts &&... xs)
     {
+      states.clear();
       return core->requestSpeedChange(std::forward<decltype(xs)>(xs)...);
     }
 
     template <typename... Ts>
     static auto applyTeleportAction(Ts &&... xs)
     {
+      queries.clear();
+      states.clear();
       return core->setEntityStatus(std::forward<decltype(xs)>(xs)...);
     }
 
@@ -514,6 +642,11 @@ public:
     {
       return core->requestWalkStraight(std::forward<decltype(xs)>(xs)...);
     }
+
+    static auto getEntityHandle(const std::string & entity_ref)
+    {
+      return core->getEntityHandle(entity_ref).value_or(traffic_simulator::entity::EntityHandle());
+    }
   };
 
   // OpenSCENARIO 1.1.1 Section 3.1.5
@@ -526,6 +659,16 @@ public:
       return core->getCurrentAccel(std::forward<decltype(xs)>(xs)...).linear.x;
     }
 
+    template <typename Entity>
+    static auto evaluateAcceleration(const Entity & entity) -> decltype(entity.handle(), double())
+    {
+      if (const auto entity_state = state(entity.handle())) {
+        return entity_state->acceleration;
+      } else {
+        return core->getCurrentAccel(entity).linear.x;
+      }
+    }
+
     template <typename... Ts>
     static auto evaluateCollisionCondition(Ts &&... xs) -> bool
     {
@@ -566,12 +709,32 @@ public:
       return core->getCurrentTwist(std::forward<decltype(xs)>(xs)...).linear.x;
     }
 
+    template <typename Entity>
+    static auto evaluateSpeed(const Entity & entity) -> decltype(entity.handle(), double())
+    {
+      if (const auto entity_state = state(entity.handle())) {
+        return entity_state->speed;
+      } else {
+        return core->getCurrentTwist(entity).linear.x;
+      }
+    }
+
     template <typename... Ts>
     static auto evaluateStandStill(Ts &&... xs)
     {
       return core->getStandStillDuration(std::forward<decltype(xs)>(xs)...);
     }
 
+    template <typename Entity>
+    static auto evaluateStandStill(const Entity & entity) -> decltype(entity.handle(), double())
+    {
+      if (const auto entity_state = state(entity.handle())) {
+        return entity_state->stand_still_duration;
+      } else {
+        return core->getStandStillDuration(entity);
+      }
+    }
+
     template <typename... Ts>
     static auto evaluateTimeHeadway(Ts &&... xs)
     {
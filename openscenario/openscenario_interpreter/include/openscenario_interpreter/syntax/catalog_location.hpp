@@ -15,9 +15,11 @@
 #ifndef OPENSCENARIO_INTERPRETER__SYNTAX__CATALOG_LOCATION_HPP_
 #define OPENSCENARIO_INTERPRETER__SYNTAX__CATALOG_LOCATION_HPP_
 
+#include <boost/filesystem.hpp>
 #include <memory>
 #include <openscenario_interpreter/syntax/directory.hpp>
 #include <pugixml.hpp>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -25,14 +27,29 @@ namespace openscenario_interpreter
 {
 inline namespace syntax
 {
+/*
+   A catalog file with the entries of its catalog indexed by name, so that a
+   CatalogReference does not walk the whole catalog. Only the entry it
+   resolves is read into a syntax element.
+*/
+struct CatalogFile
+{
+  pugi::xml_document document;
+
+  pugi::xml_node catalog;
+
+  std::unordered_map<std::string, std::vector<pugi::xml_node>> entries;
+
+  explicit CatalogFile(const boost::filesystem::path &);
+};
+
 /* ---- CatalogLocation --------------------------------------------------------
  *
  *
  * -------------------------------------------------------------------------- */
-class CatalogLocation : public std::unordered_map<std::string, pugi::xml_node>
+class CatalogLocation
+: public std::unordered_map<std::string, std::shared_ptr<const CatalogFile>>
 {
-  std::vector<std::shared_ptr<pugi::xml_document>> catalog_files;
-
 public:
   const Directory directory;
 
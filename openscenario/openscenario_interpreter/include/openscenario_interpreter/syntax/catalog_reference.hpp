@@ -21,6 +21,7 @@
 #include <openscenario_interpreter/reader/attribute.hpp>
 #include <openscenario_interpreter/scope.hpp>
 #include <openscenario_interpreter/syntax/catalog.hpp>
+#include <openscenario_interpreter/syntax/catalog_location.hpp>
 #include <openscenario_interpreter/syntax/directory.hpp>
 #include <openscenario_interpreter/syntax/parameter_assignments.hpp>
 #include <openscenario_interpreter/utility/print.hpp>
@@ -55,7 +56,7 @@ struct CatalogReference
 
   ParameterAssignments parameter_assignments;
 
-  pugi::xml_node catalog_node;
+  std::shared_ptr<const CatalogFile> catalog_file;
 };
 
 }  // namespace syntax
@@ -18,8 +18,8 @@
 #include <algorithm>
 #include <boost/json.hpp>
 #include <cstddef>
+#include <deque>
 #include <functional>
-#include <list>
 #include <openscenario_interpreter/object.hpp>
 #include <openscenario_interpreter/scope.hpp>
 #include <openscenario_interpreter/simulator_core.hpp>
@@ -64,7 +64,8 @@ private:
     bool result;
   };
 
-  std::list<History> histories;
+  /* A deque, so that the history of each frame is not a node allocation. */
+  std::deque<History> histories;
 
 public:
   explicit Condition(const pugi::xml_node & node, Scope & scope);
@@ -16,6 +16,7 @@
 #define OPENSCENARIO_INTERPRETER__SYNTAX__DISTRIBUTION_RANGE_HPP_
 
 #include <openscenario_interpreter/scope.hpp>
+#include <openscenario_interpreter/syntax/double.hpp>
 #include <openscenario_interpreter/syntax/range.hpp>
 #include <pugixml.hpp>
 
@@ -29,11 +30,14 @@ inline namespace syntax
  *    <xsd:all>
  *      <xsd:element name="Range" type="Range"/>
  *    </xsd:all>
+ *    <xsd:attribute name="stepWidth" type="Double" use="required"/>
  *  </xsd:complexType>
  *
  * -------------------------------------------------------------------------- */
 struct DistributionRange : private Scope, public ComplexType
 {
+  const Double step_width;
+
   const Range range;
 
   explicit DistributionRange(const pugi::xml_node &, Scope &);
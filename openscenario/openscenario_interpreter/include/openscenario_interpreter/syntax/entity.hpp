@@ -30,6 +30,11 @@
 #include <valarray>
 #include <vector>
 
+namespace traffic_simulator::entity
+{
+struct EntityHandle;
+}  // namespace traffic_simulator::entity
+
 namespace openscenario_interpreter
 {
 struct Scope;
@@ -56,6 +61,12 @@ struct Entity : public Object
 
   auto name() const -> String;
 
+  /**
+   * This function is for ScenarioObject only.
+   * @return Handle of the entity in the simulator, resolved when the entity was added.
+   */
+  auto handle() const -> const traffic_simulator::entity::EntityHandle &;
+
   auto objects() const -> std::set<Entity>;
 
   auto objectTypes() const -> std::set<ObjectType::value_type>;
@@ -15,6 +15,7 @@
 #ifndef OPENSCENARIO_INTERPRETER__SYNTAX__PARAMETER_CONDITION_HPP_
 #define OPENSCENARIO_INTERPRETER__SYNTAX__PARAMETER_CONDITION_HPP_
 
+#include <functional>
 #include <openscenario_interpreter/scope.hpp>
 #include <openscenario_interpreter/syntax/rule.hpp>
 #include <openscenario_interpreter/syntax/string.hpp>
@@ -41,15 +42,22 @@ struct ParameterCondition : private Scope
 
   const Rule rule;
 
+  /* The parameter is resolved on the first evaluation and the comparison is
+     compiled for its type, with the value converted once. It is kept, since a
+     ParameterSetAction or ParameterModifyAction only assigns to its value. */
+  std::function<bool()> comparison;
+
   explicit ParameterCondition(Scope &);
 
   explicit ParameterCondition(const pugi::xml_node &, Scope &);
 
   static auto compare(const Object &, const Rule &, const String &) -> bool;
 
+  static auto compile(const Object &, const Rule &, const String &) -> std::function<bool()>;
+
   /*  */ auto description() const -> String;
 
-  /*  */ auto evaluate() const -> Object;
+  /*  */ auto evaluate() -> Object;
 };
 }  // namespace syntax
 }  // namespace openscenario_interpreter
@@ -15,6 +15,7 @@
 #ifndef OPENSCENARIO_INTERPRETER__SYNTAX__PARAMETER_MODIFY_ACTION_HPP_
 #define OPENSCENARIO_INTERPRETER__SYNTAX__PARAMETER_MODIFY_ACTION_HPP_
 
+#include <functional>
 #include <openscenario_interpreter/scope.hpp>
 #include <openscenario_interpreter/syntax/modify_rule.hpp>
 #include <pugixml.hpp>
@@ -38,13 +39,17 @@ struct ParameterModifyAction : Scope
 
   const ModifyRule rule;
 
+  /* The rule is compiled for the referenced parameter on the first start and
+     reused, so a repeated event does not look up the parameter again. */
+  std::function<void()> modification;
+
   explicit ParameterModifyAction(const pugi::xml_node &, Scope &, const String &);
 
   static auto accomplished() noexcept -> bool;
 
   static auto run() noexcept -> void;
 
-  /*  */ auto start() const -> void;
+  /*  */ auto start() -> void;
 };
 }  // namespace syntax
 }  // namespace openscenario_interpreter
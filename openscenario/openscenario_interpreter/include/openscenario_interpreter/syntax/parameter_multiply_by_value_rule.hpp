@@ -15,6 +15,7 @@
 #ifndef OPENSCENARIO_INTERPRETER__SYNTAX__PARAMETER_MULTIPLY_BY_VALUE_RULE_HPP_
 #define OPENSCENARIO_INTERPRETER__SYNTAX__PARAMETER_MULTIPLY_BY_VALUE_RULE_HPP_
 
+#include <functional>
 #include <openscenario_interpreter/scope.hpp>
 #include <openscenario_interpreter/syntax/double.hpp>
 #include <pugixml.hpp>
@@ -36,6 +37,9 @@ struct ParameterMultiplyByValueRule
 
   explicit ParameterMultiplyByValueRule(const pugi::xml_node &, Scope &);
 
+  /// @return Modification of the target, for the type of the target resolved once.
+  auto compile(const Object & target) const -> std::function<void()>;
+
   auto operator()(const Object &) const -> Object;
 };
 }  // namespace syntax
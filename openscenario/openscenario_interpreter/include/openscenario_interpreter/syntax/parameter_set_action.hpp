@@ -15,6 +15,7 @@
 #ifndef OPENSCENARIO_INTERPRETER__SYNTAX__PARAMETER_SET_ACTION_HPP_
 #define OPENSCENARIO_INTERPRETER__SYNTAX__PARAMETER_SET_ACTION_HPP_
 
+#include <functional>
 #include <openscenario_interpreter/scope.hpp>
 #include <openscenario_interpreter/syntax/string.hpp>
 #include <pugixml.hpp>
@@ -36,15 +37,21 @@ struct ParameterSetAction : private Scope
 
   const String value;
 
+  /* The value is converted to the type of the referenced parameter on the
+     first start and reused, so a repeated event only assigns it. */
+  std::function<void()> assignment;
+
   explicit ParameterSetAction(const pugi::xml_node &, Scope &, const String &);
 
   static auto accomplished() noexcept -> bool;
 
   static auto run() noexcept -> void;
 
+  static auto compile(const Object &, const String &) -> std::function<void()>;
+
   static auto set(const Scope & scope, const String &, const String &) -> void;
 
-  /*  */ auto start() const -> void;
+  /*  */ auto start() -> void;
 };
 }  // namespace syntax
 }  // namespace openscenario_interpreter
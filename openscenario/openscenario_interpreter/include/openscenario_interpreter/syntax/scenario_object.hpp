@@ -43,6 +43,8 @@ struct ScenarioObject : public Scope, public EntityObject
 
   bool is_added = false;  // NOTE: Is applied AddEntityAction?
 
+  traffic_simulator::entity::EntityHandle handle;  // NOTE: Resolved by AddEntityAction.
+
   explicit ScenarioObject(const pugi::xml_node &, Scope &);
 };
 }  // namespace syntax
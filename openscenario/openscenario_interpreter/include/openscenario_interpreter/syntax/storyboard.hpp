@@ -46,7 +46,7 @@ struct Storyboard : public Scope,
 
   using Thunk = std::function<void()>;
 
-  static inline std::queue<Thunk> thunks{};
+  static inline thread_local std::queue<Thunk> thunks{};
 
   explicit Storyboard(const pugi::xml_node &, Scope &);
 
@@ -128,7 +128,7 @@ private:
 protected:
   auto rename(const std::string & name) const
   {
-    static std::size_t id = 0;
+    static thread_local std::size_t id = 0;
     return name.empty() ? std::string("anonymous-") + std::to_string(++id) : name;
   }
 
@@ -176,8 +176,12 @@ public:
     callbacks[transition].push_back(callback);
   }
 
+  /// @note Number of transitions of all the storyboard elements, to notice any change of state.
+  static inline thread_local std::size_t transition_count = 0;
+
   auto transitionTo(const Object & state) -> bool
   {
+    ++transition_count;
     current_state = state;
     for (auto && callback : callbacks[current_state.as<StoryboardElementState>()]) {
       callback(std::as_const(*this));
@@ -187,7 +191,15 @@ public:
 
   virtual auto evaluate() -> Object
   {
-    if (stop_trigger.evaluate().as<Boolean>()) {
+    /*
+       No transition leaves the completeState by a trigger, so the stop
+       trigger of a complete element is not evaluated. Otherwise a satisfied
+       stop trigger would cycle the element through the stopTransition every
+       frame.
+    */
+    if (is<StoryboardElementState::completeState>()) {
+      return current_state;
+    } else if (stop_trigger.evaluate().as<Boolean>()) {
       override();
     }
 
@@ -24,6 +24,8 @@ namespace openscenario_interpreter
 {
 inline namespace syntax
 {
+class StoryboardElement;
+
 /* ---- StoryboardElementStateCondition ----------------------------------------
  *
  *  <xsd:complexType name="StoryboardElementStateCondition">
@@ -43,6 +45,11 @@ struct StoryboardElementStateCondition : private Scope
 
   StoryboardElementState current_state;
 
+  /* Resolved once the storyboard is built, instead of looking it up by name
+     on every evaluation. Not an Object, because the element may own this
+     condition. */
+  const StoryboardElement * referenced_storyboard_element = nullptr;
+
   explicit StoryboardElementStateCondition(const pugi::xml_node &, const Scope &);
 
   auto description() const -> String;
@@ -49,6 +49,9 @@ struct TrafficSignalControllerCondition
 
   Scope scope;
 
+  /* Resolved on the first evaluation, the controllers are not redefined. */
+  Object traffic_signal_controller;
+
   explicit TrafficSignalControllerCondition(const pugi::xml_node &, const Scope &);
 
   auto description() const -> String;
@@ -44,6 +44,13 @@ struct TriggeringEntities
 
   explicit TriggeringEntities(const pugi::xml_node &, Scope &);
 
+  /*
+     The predicate is evaluated in the order of the entity references, and
+     the evaluation stops as soon as the rule is decided (std::any_of and
+     std::all_of), so only the evaluated entities have a result in the
+     context. The predicates are not evaluated in parallel because they call
+     the simulator core, which is not thread safe.
+  */
   template <typename Predicate>
   auto apply(Predicate && predicate) const -> decltype(auto)
   {
@@ -15,9 +15,14 @@
 #ifndef OPENSCENARIO_INTERPRETER__UTILITY__EXECUTION_TIMER_HPP_
 #define OPENSCENARIO_INTERPRETER__UTILITY__EXECUTION_TIMER_HPP_
 
+#include <array>
 #include <chrono>
 #include <cmath>
+#include <cstdint>
 #include <functional>
+#include <limits>
+#include <ostream>
+#include <string>
 #include <unordered_map>
 
 namespace openscenario_interpreter
@@ -39,6 +44,41 @@ class ExecutionTimer
 
     int count = 0;
 
+    /*
+       Log-linear histogram of the durations: each power of two of
+       nanoseconds is split into 2^sub_bucket_bits buckets, so a percentile is
+       known within 1 / 2^sub_bucket_bits of its value without keeping the
+       samples.
+    */
+    static constexpr int sub_bucket_bits = 3;
+
+    std::array<int, 64 << sub_bucket_bits> histogram{};
+
+    static auto bucketOf(std::uint64_t ns) -> std::size_t
+    {
+      if (ns < (1u << sub_bucket_bits)) {
+        return ns;
+      } else {
+        int exponent = 0;
+        while ((ns >> exponent) >= (2u << sub_bucket_bits)) {
+          ++exponent;
+        }
+        return ((exponent + 1) << sub_bucket_bits) + (ns >> exponent) - (1u << sub_bucket_bits);
+      }
+    }
+
+    /// @return The largest duration of the bucket.
+    static auto upperBoundOf(std::size_t bucket) -> std::int64_t
+    {
+      if (bucket < (1u << sub_bucket_bits)) {
+        return bucket;
+      } else {
+        const auto exponent = (bucket >> sub_bucket_bits) - 1;
+        const auto mantissa = (bucket & ((1u << sub_bucket_bits) - 1)) + (1u << sub_bucket_bits);
+        return ((mantissa + 1) << exponent) - 1;
+      }
+    }
+
   public:
     template <typename Duration>
     auto add(Duration diff) -> void
@@ -46,9 +86,24 @@ class ExecutionTimer
       std::int64_t diff_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(diff).count();
       count++;
       ns_max = std::max(ns_max, diff_ns);
-      ns_min = std::min(ns_max, diff_ns);
+      ns_min = std::min(ns_min, diff_ns);
       ns_sum += diff_ns;
       ns_square_sum += std::pow(diff_ns, 2);
+      histogram[bucketOf(std::max<std::int64_t>(diff_ns, 0))]++;
+    }
+
+    /// @param ratio Ratio of the durations not longer than the result, such as 0.99.
+    template <typename T>
+    auto percentile(const double ratio) const
+    {
+      const auto rank = static_cast<std::size_t>(std::ceil(ratio * count));
+      for (std::size_t bucket = 0, accumulated = 0; bucket < histogram.size(); ++bucket) {
+        if (rank <= (accumulated += histogram[bucket]) and 0 < accumulated) {
+          return std::chrono::duration_cast<T>(
+            std::chrono::nanoseconds(std::min(upperBoundOf(bucket), ns_max)));
+        }
+      }
+      return max<T>();
     }
 
     template <typename T>
@@ -84,10 +139,18 @@ class ExecutionTimer
     {
       using namespace std::chrono;
 
-      return os << "mean = " << statistics.template mean<milliseconds>().count() << " ms, "
-                << "max = " << statistics.template max<milliseconds>().count() << " ms, "
+      const auto ms = [](auto && duration) {
+        return duration_cast<microseconds>(duration).count() / 1000.0;
+      };
+
+      return os << "mean = " << ms(statistics.template mean<nanoseconds>()) << " ms, "
+                << "min = " << ms(statistics.template min<nanoseconds>()) << " ms, "
+                << "max = " << ms(statistics.template max<nanoseconds>()) << " ms, "
+                << "p50 = " << ms(statistics.template percentile<nanoseconds>(0.5)) << " ms, "
+                << "p99 = " << ms(statistics.template percentile<nanoseconds>(0.99)) << " ms, "
+                << "p999 = " << ms(statistics.template percentile<nanoseconds>(0.999)) << " ms, "
                 << "standard deviation = "
-                << statistics.template standardDeviation<milliseconds>().count() / 1000.0 << " ms";
+                << ms(statistics.template standardDeviation<nanoseconds>()) << " ms";
     }
   };
 
@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <boost/json.hpp>
+#include <iterator>
 #include <openscenario_interpreter/openscenario_interpreter.hpp>
 #include <openscenario_interpreter/record.hpp>
 #include <openscenario_interpreter/syntax/object_controller.hpp>
@@ -23,8 +24,10 @@
 #include <openscenario_interpreter/syntax/scenario_definition.hpp>
 #include <openscenario_interpreter/syntax/scenario_object.hpp>
 #include <openscenario_interpreter/utility/overload.hpp>
+#include <sstream>
 #include <status_monitor/status_monitor.hpp>
 #include <traffic_simulator/data_type/lanelet_pose.hpp>
+#include <traffic_simulator/helper/phase_timer.hpp>
 
 #define DECLARE_PARAMETER(IDENTIFIER) \
   declare_parameter<decltype(IDENTIFIER)>(#IDENTIFIER, IDENTIFIER)
@@ -36,19 +39,25 @@ namespace openscenario_interpreter
 Interpreter::Interpreter(const rclcpp::NodeOptions & options)
 : rclcpp_lifecycle::LifecycleNode("openscenario_interpreter", options),
   publisher_of_context(create_publisher<Context>("context", rclcpp::QoS(1).transient_local())),
+  as_fast_as_possible(false),
+  context_publish_rate(10),
   local_frame_rate(30),
   local_real_time_factor(1.0),
   osc_path(""),
   output_directory("/tmp"),
   publish_empty_context(false),
-  record(false)
+  record(false),
+  record_topics("")
 {
+  DECLARE_PARAMETER(as_fast_as_possible);
+  DECLARE_PARAMETER(context_publish_rate);
   DECLARE_PARAMETER(local_frame_rate);
   DECLARE_PARAMETER(local_real_time_factor);
   DECLARE_PARAMETER(osc_path);
   DECLARE_PARAMETER(output_directory);
   DECLARE_PARAMETER(publish_empty_context);
   DECLARE_PARAMETER(record);
+  DECLARE_PARAMETER(record_topics);
 }
 
 Interpreter::~Interpreter() {}
@@ -102,12 +111,15 @@ auto Interpreter::on_configure(const rclcpp_lifecycle::State &) -> Result
 
       std::this_thread::sleep_for(std::chrono::seconds(1));  // NOTE: Wait for parameters to be set.
 
+      GET_PARAMETER(as_fast_as_possible);
+      GET_PARAMETER(context_publish_rate);
       GET_PARAMETER(local_frame_rate);
       GET_PARAMETER(local_real_time_factor);
       GET_PARAMETER(osc_path);
       GET_PARAMETER(output_directory);
       GET_PARAMETER(publish_empty_context);
       GET_PARAMETER(record);
+      GET_PARAMETER(record_topics);
 
       script = std::make_shared<OpenScenario>(osc_path);
 
@@ -119,6 +131,12 @@ auto Interpreter::on_configure(const rclcpp_lifecycle::State &) -> Result
         }
         return get_parameter("consider_pose_by_road_slope").as_bool();
       }());
+      traffic_simulator::lanelet_pose::CanonicalizedLaneletPose::setUseElevationProfile([&]() {
+        if (not has_parameter("use_elevation_profile")) {
+          declare_parameter("use_elevation_profile", false);
+        }
+        return get_parameter("use_elevation_profile").as_bool();
+      }());
 
       if (script->category.is<ScenarioDefinition>()) {
         scenarios = {std::dynamic_pointer_cast<ScenarioDefinition>(script->category)};
@@ -178,7 +196,7 @@ auto Interpreter::on_activate(const rclcpp_lifecycle::State &) -> Result
   auto evaluate_storyboard = [this]() {
     withExceptionHandler(
       [this](auto &&...) {
-        publishCurrentContext();
+        publishCurrentContext(true);
         deactivate();
       },
       [this]() {
@@ -192,14 +210,17 @@ auto Interpreter::on_activate(const rclcpp_lifecycle::State &) -> Result
               waiting_for_engagement_to_be_completed = false;  // NOTE: DIRTY HACK!!!
             }
           } else if (currentScenarioDefinition()) {
-            currentScenarioDefinition()->evaluate();
+            execution_timer.invoke("evaluate", [this]() {
+              traffic_simulator::helper::ScopedPhaseTimer timer("Storyboard::evaluate");
+              currentScenarioDefinition()->evaluate();
+            });
           } else {
             throw Error("No script evaluable.");
           }
 
-          SimulatorCore::update();
+          execution_timer.invoke("update", []() { SimulatorCore::update(); });
 
-          publishCurrentContext();
+          execution_timer.invoke("publishCurrentContext", [this]() { publishCurrentContext(); });
         });
       });
   };
@@ -209,14 +230,23 @@ auto Interpreter::on_activate(const rclcpp_lifecycle::State &) -> Result
   } else {
     return withExceptionHandler(
       [this](auto &&...) {
-        publishCurrentContext();
+        publishCurrentContext(true);
         reset();
         return Interpreter::Result::FAILURE;  // => Inactive
       },
       [&]() {
         if (record) {
-          record::start(
-            "-a", "-o", boost::filesystem::path(osc_path).replace_extension("").string());
+          std::vector<std::string> options{
+            "-o", boost::filesystem::path(osc_path).replace_extension("").string()};
+          if (record_topics.empty()) {
+            options.emplace_back("-a");
+          } else {
+            std::istringstream topics(record_topics);
+            options.insert(
+              options.end(), std::istream_iterator<std::string>(topics),
+              std::istream_iterator<std::string>());
+          }
+          record::start(options);
         }
 
         SimulatorCore::activate(
@@ -246,7 +276,13 @@ auto Interpreter::on_activate(const rclcpp_lifecycle::State &) -> Result
           throw Error("No script evaluable.");
         }
 
-        timer = create_wall_timer(currentLocalFrameRate(), evaluate_storyboard);
+        /*
+           A timer with a period of zero is always ready, so the executor
+           calls it again as soon as it has processed the other callbacks.
+        */
+        timer = create_wall_timer(
+          as_fast_as_possible ? std::chrono::milliseconds(0) : currentLocalFrameRate(),
+          evaluate_storyboard);
 
         return Interpreter::Result::SUCCESS;  // => Active
       });
@@ -283,8 +319,22 @@ auto Interpreter::on_shutdown(const rclcpp_lifecycle::State &) -> Result
   return Interpreter::Result::SUCCESS;  // => Finalized
 }
 
-auto Interpreter::publishCurrentContext() const -> void
+auto Interpreter::publishCurrentContext(const bool forced) -> void
 {
+  const auto time = std::chrono::steady_clock::now();
+  if (not forced) {
+    if (publisher_of_context->get_subscription_count() == 0) {
+      return;
+    } else if (
+      context_published_transition_count == StoryboardElement::transition_count and
+      context_publish_rate > 0 and
+      time - context_published_time < std::chrono::duration<double>(1 / context_publish_rate)) {
+      return;
+    }
+  }
+  context_published_time = time;
+  context_published_transition_count = StoryboardElement::transition_count;
+
   Context context;
   {
     boost::json::monotonic_resource mr;
@@ -330,6 +380,10 @@ auto Interpreter::reset() -> void
   common::status_monitor.overrideThreshold(
     std::chrono::seconds(get_parameter("initialize_duration").as_int()), SimulatorCore::deactivate);
 
+  for (const auto & [tag, statistics] : execution_timer) {
+    RCLCPP_INFO_STREAM(get_logger(), "Execution time of " << tag << ": " << statistics);
+  }
+
   scenarios.pop_front();
 
   // NOTE: Error on simulation is not error of the interpreter; so we print error messages into
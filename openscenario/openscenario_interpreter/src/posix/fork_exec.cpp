@@ -46,38 +46,58 @@ int execvp(const std::vector<std::string> & f_xs)
   return ::execvp(argv[0], argv.data());
 }
 
-pid_t fork_exec(const std::vector<std::string> & f_xs)
+pid_t fork_exec_nowait(const std::vector<std::string> & f_xs)
 {
   const auto pid = fork();
 
   if (pid < 0) {
     throw std::system_error(errno, std::system_category());
   } else {
-    int status = 0;
-
-    switch (pid) {
-      case 0:
-        if (execvp(f_xs) < 0) {
-          std::cerr << std::system_error(errno, std::system_category()).what() << std::endl;
-          std::exit(EXIT_FAILURE);
-        }
-        break;
-
-      default:
-        do {
-          ::waitpid(pid, &status, WUNTRACED);
-        } while (!WIFEXITED(status) && !WIFSIGNALED(status));
+    if (pid == 0 and execvp(f_xs) < 0) {
+      std::cerr << std::system_error(errno, std::system_category()).what() << std::endl;
+      std::exit(EXIT_FAILURE);
     }
 
     return pid;
   }
 }
 
+pid_t fork_exec(const std::vector<std::string> & f_xs)
+{
+  const auto pid = fork_exec_nowait(f_xs);
+
+  int status = 0;
+
+  do {
+    ::waitpid(pid, &status, WUNTRACED);
+  } while (!WIFEXITED(status) && !WIFSIGNALED(status));
+
+  return pid;
+}
+
+bool exited(pid_t pid)
+{
+  int status = 0;
+
+  switch (const auto result = ::waitpid(pid, &status, WNOHANG); result) {
+    case 0:
+      return false;
+
+    default:
+      return result < 0 or WIFEXITED(status) or WIFSIGNALED(status);
+  }
+}
+
 pid_t fork_exec(const std::string & f_xs) { return fork_exec(split(f_xs)); }
 
 pid_t fork_exec(const std::string & f, const std::string & xs)
 {
   return fork_exec(xs.empty() ? f : f + " " + xs);
 }
+
+pid_t fork_exec_nowait(const std::string & f, const std::string & xs)
+{
+  return fork_exec_nowait(split(xs.empty() ? f : f + " " + xs));
+}
 }  // namespace posix
 }  // namespace openscenario_interpreter
@@ -13,11 +13,14 @@
 // limitations under the License.
 
 #include <boost/filesystem.hpp>
+#include <ctime>
+#include <mutex>
 #include <openscenario_interpreter/reader/element.hpp>
 #include <openscenario_interpreter/syntax/catalog.hpp>
 #include <openscenario_interpreter/syntax/catalog_location.hpp>
 #include <openscenario_interpreter/syntax/directory.hpp>
 #include <openscenario_interpreter/syntax/open_scenario.hpp>
+#include <utility>
 
 namespace openscenario_interpreter
 {
@@ -39,6 +42,52 @@ auto convertScenario(
   }
 }
 
+CatalogFile::CatalogFile(const boost::filesystem::path & path)
+{
+  document.load_file(path.string().c_str());
+
+  if (catalog = document.child("OpenSCENARIO").child("Catalog"); catalog) {
+    for (auto && entry : catalog.children()) {
+      if (auto name = entry.attribute("name"); name) {
+        entries[name.as_string()].push_back(entry);
+      }
+    }
+  }
+}
+
+/*
+   The documents of the catalog files are shared by every run of the process
+   while the files are not modified, so that sweeps over one scenario do not
+   parse (nor convert from YAML) the same catalogs on every configuration.
+   The documents are only read once loaded.
+*/
+auto loadCatalogFile(const boost::filesystem::path & path) -> std::shared_ptr<const CatalogFile>
+{
+  static std::mutex mutex;
+
+  using LastWriteTime = std::time_t;
+
+  static std::unordered_map<
+    std::string, std::pair<LastWriteTime, std::shared_ptr<const CatalogFile>>>
+    documents;
+
+  std::lock_guard<std::mutex> lock(mutex);
+
+  const auto last_write_time = boost::filesystem::last_write_time(path);
+
+  if (auto iter = documents.find(path.string());
+      iter != std::end(documents) and iter->second.first == last_write_time) {
+    return iter->second.second;
+  } else {
+    const auto output_dir =
+      boost::filesystem::path("/tmp/converted_scenario") / path.parent_path().filename();
+    auto document = std::make_shared<const CatalogFile>(
+      path.extension() == ".yaml" ? convertScenario(path, output_dir) : path);
+    return documents.insert_or_assign(path.string(), std::make_pair(last_write_time, document))
+      .first->second.second;
+  }
+}
+
 CatalogLocation::CatalogLocation(const pugi::xml_node & node, Scope & scope)
 : directory(readElement<Directory>("Directory", node, scope))
 {
@@ -49,26 +98,11 @@ CatalogLocation::CatalogLocation(const pugi::xml_node & node, Scope & scope)
     THROW_SYNTAX_ERROR(directory.path.string() + " is not directory");
   }
 
-  for (auto path : Directory::ls(directory)) {
-    if (path.extension() == ".yaml") {
-      path = convertScenario(
-        path, boost::filesystem::path("/tmp/converted_scenario") / directory.path.filename());
-    } else if (path.extension() != ".xosc") {
-      continue;
-    }
-    auto new_document = std::make_shared<pugi::xml_document>();
-    new_document->load_file(path.string().c_str());
-    catalog_files.emplace_back(std::move(new_document));
-  }
-
-  for (auto && xml : catalog_files) {
-    auto open_scenario = xml->child("OpenSCENARIO");
-    if (open_scenario) {
-      auto catalog = open_scenario.child("Catalog");
-      if (catalog) {
-        auto name = catalog.attribute("name");
-        if (name) {
-          emplace(name.as_string(), catalog);
+  for (const auto & path : Directory::ls(directory)) {
+    if (path.extension() == ".yaml" or path.extension() == ".xosc") {
+      if (auto catalog_file = loadCatalogFile(path); catalog_file->catalog) {
+        if (auto name = catalog_file->catalog.attribute("name"); name) {
+          emplace(name.as_string(), catalog_file);
         }
       }
     }
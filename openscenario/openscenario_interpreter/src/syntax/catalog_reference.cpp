@@ -21,7 +21,6 @@
 #include <openscenario_interpreter/syntax/pedestrian.hpp>
 #include <openscenario_interpreter/syntax/string.hpp>
 #include <openscenario_interpreter/syntax/vehicle.hpp>
-#include <openscenario_interpreter/utility/print.hpp>
 
 namespace openscenario_interpreter
 {
@@ -33,45 +32,6 @@ inline namespace syntax
     " is valid OpenSCENARIO element of class CatalogReference" \
     ", but is not supported yet")
 
-template <typename... Ts>
-auto choice_by_attribute(const pugi::xml_node & node, const std::string & attribute, Ts &&... xs)
-{
-  using CalleeT = std::function<Object(const pugi::xml_node &)>;
-
-  const std::unordered_map<std::string, CalleeT> callees{
-    {std::forward<decltype(xs)>(xs)...}, sizeof...(Ts)};
-
-  std::vector<std::pair<pugi::xml_node, CalleeT>> specs;
-
-  for (auto && child : node.children()) {
-    auto iter = callees.find(child.attribute(attribute.c_str()).as_string());
-    if (iter != std::end(callees)) {
-      specs.emplace_back(child, iter->second);
-    }
-  }
-
-  if (specs.empty()) {
-    std::stringstream what;
-    what << node.name() << " requires one of following " << std::quoted(attribute) << ": ";
-    print_keys_to(what, callees);
-    what << ". But no element specified";
-    throw SyntaxError(what.str());
-  }
-
-  if (1 < specs.size()) {
-    std::stringstream what;
-    what << node.name() << " requires just one of following " << std::quoted(attribute) << ": ";
-    print_keys_to(what, callees);
-    what << ". But " << specs.size() << " element" << (1 < specs.size() ? "s" : "") << " (";
-    print_keys_to(what, specs);
-    what << ") specified";
-    throw SyntaxError(what.str());
-  }
-
-  const auto iter = std::cbegin(specs);
-  return iter->second(iter->first);
-}
-
 CatalogReference::CatalogReference(const pugi::xml_node & node, Scope & scope)
 : scope(scope),
   catalog_name(readAttribute<std::string>("catalogName", node, scope)),
@@ -86,7 +46,7 @@ CatalogReference::CatalogReference(const pugi::xml_node & node, Scope & scope)
         auto & catalog_location = p.second;
         auto found_catalog = catalog_location.find(catalog_name);
         if (found_catalog != std::end(catalog_location)) {
-          catalog_node = found_catalog->second;
+          catalog_file = found_catalog->second;
           return true;
         } else {
           return false;
@@ -118,22 +78,29 @@ auto CatalogReference::make() -> const Object
     // clang-format on
   };
 
-  return choice_by_attribute(
-    catalog_node, "name", std::make_pair(entry_name, [&](const pugi::xml_node & node) {
-      if (auto iter = dispatcher.find(node.name()); iter != std::end(dispatcher)) {
-        return iter->second(node);
-      } else {
-        std::stringstream what;
-        what << "Catalog element must be one of following elements: ";
-        const auto * separator = "[";
-        for (auto & each : dispatcher) {
-          what << separator << each.first;
-          separator = ", ";
-        }
-        what << "]. But no element specified.";
-        throw SyntaxError(what.str());
-      }
-    }));
+  if (auto entries = catalog_file->entries.find(entry_name);
+      entries == std::end(catalog_file->entries)) {
+    throw SyntaxError(
+      "Required entry ", std::quoted(entry_name), " not found in catalog ",
+      std::quoted(catalog_name));
+  } else if (1 < entries->second.size()) {
+    throw SyntaxError(
+      "Catalog ", std::quoted(catalog_name), " has ", entries->second.size(), " entries named ",
+      std::quoted(entry_name));
+  } else if (const auto & node = entries->second.front();
+             dispatcher.find(node.name()) != std::end(dispatcher)) {
+    return dispatcher.at(node.name())(node);
+  } else {
+    std::stringstream what;
+    what << "Catalog element must be one of following elements: ";
+    const auto * separator = "[";
+    for (auto & each : dispatcher) {
+      what << separator << each.first;
+      separator = ", ";
+    }
+    what << "]. But no element specified.";
+    throw SyntaxError(what.str());
+  }
 }
 }  // namespace syntax
 }  // namespace openscenario_interpreter
@@ -288,16 +288,38 @@ struct TestCommand : public CustomCommand
 
 struct ForkExecCommand : public CustomCommand
 {
+  /*
+     A type ending with an ampersand runs the command in the background, as a
+     shell does. The process is then only forked on start and the action keeps
+     running, without blocking the frame, until the process exits.
+  */
+  const bool background;
+
   const std::string type;
 
   const std::string content;
 
+  pid_t pid = 0;
+
   explicit ForkExecCommand(const std::string & type, const std::string & content)
-  : type(type), content(content)
+  : background(not type.empty() and type.back() == '&'),
+    type(background ? type.substr(0, type.size() - 1) : type),
+    content(content)
   {
   }
 
-  auto start(const Scope &) -> void override { fork_exec(type, content); }
+  auto accomplished() noexcept -> bool override { return not background or exited(pid); }
+
+  auto endsImmediately() const -> bool override { return not background; }
+
+  auto start(const Scope &) -> void override
+  {
+    if (background) {
+      pid = fork_exec_nowait(type, content);
+    } else {
+      fork_exec(type, content);
+    }
+  }
 };
 
 auto makeCustomCommand(const std::string & type, const std::string & content)
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <openscenario_interpreter/reader/attribute.hpp>
 #include <openscenario_interpreter/reader/element.hpp>
 #include <openscenario_interpreter/syntax/distribution_range.hpp>
 
@@ -20,7 +21,9 @@ namespace openscenario_interpreter
 inline namespace syntax
 {
 DistributionRange::DistributionRange(const pugi::xml_node & node, Scope & scope)
-: Scope(scope), range(readElement<Range>("Range", node, local()))
+: Scope(scope),
+  step_width(readAttribute<Double>("stepWidth", node, local())),
+  range(readElement<Range>("Range", node, local()))
 {
 }
 
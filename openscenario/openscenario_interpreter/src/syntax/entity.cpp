@@ -58,10 +58,15 @@ auto operator<<(std::ostream & os, const Entity & entity) -> std::ostream &
 
 auto Entity::name() const -> String { return this->as<Scope>().name; }
 
+auto Entity::handle() const -> const traffic_simulator::entity::EntityHandle &
+{
+  return as<ScenarioObject>().handle;
+}
+
 auto Entity::objects() const -> std::set<Entity>
 {
   if (is<ScenarioObject>()) {
-    return {as<ScenarioObject>()};
+    return {*this};
   } else if (is<EntitySelection>()) {
     return as<EntitySelection>().objects();
   } else {
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <functional>
 #include <openscenario_interpreter/reader/attribute.hpp>
 #include <openscenario_interpreter/syntax/parameter_add_value_rule.hpp>
 #include <typeindex>
@@ -22,39 +23,33 @@ namespace openscenario_interpreter
 {
 inline namespace syntax
 {
+namespace
+{
+/* The value is bound to the target by reference, so that the modification
+   does not look up the type of the target again. */
+template <typename T>
+auto add(const Object & target, const Double & value) -> std::function<void()>
+{
+  return [target, &lhs = target.template as<T>(), value]() { lhs += value; };
+}
+}  // namespace
+
 ParameterAddValueRule::ParameterAddValueRule(const pugi::xml_node & node, Scope & scope)
 : value(readAttribute<Double>("value", node, scope))
 {
 }
 
-auto ParameterAddValueRule::operator()(const Object & target) const -> Object
+auto ParameterAddValueRule::compile(const Object & target) const -> std::function<void()>
 {
   static const std::unordered_map<
-    std::type_index, std::function<Object(const Object &, const Double &)> >
+    std::type_index, std::function<std::function<void()>(const Object &, const Double &)> >
     overloads{
-      {typeid(Integer),
-       [](auto && target, auto && value) {
-         target.template as<Integer>() += value;
-         return target;
-       }},
-
-      {typeid(Double),
-       [](auto && target, auto && value) {
-         target.template as<Double>() += value;
-         return target;
-       }},
-
+      {typeid(Integer), [](auto && target, auto && value) { return add<Integer>(target, value); }},
+      {typeid(Double), [](auto && target, auto && value) { return add<Double>(target, value); }},
       {typeid(UnsignedInteger),
-       [](auto && target, auto && value) {
-         target.template as<UnsignedInteger>() += value;
-         return target;
-       }},
-
+       [](auto && target, auto && value) { return add<UnsignedInteger>(target, value); }},
       {typeid(UnsignedShort),
-       [](auto && target, auto && value) {
-         target.template as<UnsignedShort>() += value;
-         return target;
-       }},
+       [](auto && target, auto && value) { return add<UnsignedShort>(target, value); }},
     };
 
   const auto iter = overloads.find(target.type());
@@ -68,5 +63,11 @@ auto ParameterAddValueRule::operator()(const Object & target) const -> Object
       target, " (type ", makeTypename(target.type()), ") specified");
   }
 }
+
+auto ParameterAddValueRule::operator()(const Object & target) const -> Object
+{
+  compile(target)();
+  return target;
+}
 }  // namespace syntax
 }  // namespace openscenario_interpreter
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <functional>
 #include <iomanip>
 #include <openscenario_interpreter/reader/attribute.hpp>
 #include <openscenario_interpreter/syntax/parameter_condition.hpp>
@@ -24,6 +25,18 @@ namespace openscenario_interpreter
 {
 inline namespace syntax
 {
+namespace
+{
+/* The converted value is bound to the parameter by reference, so that the
+   comparison does not parse the value nor look up the type again. */
+template <typename T>
+auto comparisonOf(const Object & parameter, const Rule rule, const T & value)
+  -> std::function<bool()>
+{
+  return [parameter, &lhs = parameter.as<T>(), rule, value]() { return rule(lhs, value); };
+}
+}  // namespace
+
 ParameterCondition::ParameterCondition(const pugi::xml_node & node, Scope & scope)
 : Scope(scope),
   parameter_ref(readAttribute<String>("parameterRef", node, local())),
@@ -34,18 +47,24 @@ ParameterCondition::ParameterCondition(const pugi::xml_node & node, Scope & scop
 
 auto ParameterCondition::compare(const Object & parameter, const Rule & rule, const String & value)
   -> bool
+{
+  return compile(parameter, rule, value)();
+}
+
+auto ParameterCondition::compile(const Object & parameter, const Rule & rule, const String & value)
+  -> std::function<bool()>
 {
   static const std::unordered_map<
     std::type_index,  //
-    std::function<bool(const Object &, const Rule, const String &)>>
+    std::function<std::function<bool()>(const Object &, const Rule, const String &)>>
     overloads{
       // clang-format off
-      { typeid(Boolean        ), [](auto && lhs, auto && compare, auto && rhs) { return compare(lhs.template as<Boolean        >(), Boolean        (rhs)); } },
-      { typeid(Double         ), [](auto && lhs, auto && compare, auto && rhs) { return compare(lhs.template as<Double         >(), Double         (rhs)); } },
-      { typeid(Integer        ), [](auto && lhs, auto && compare, auto && rhs) { return compare(lhs.template as<Integer        >(), Integer        (rhs)); } },
-      { typeid(String         ), [](auto && lhs, auto && compare, auto && rhs) { return compare(lhs.template as<String         >(),                 rhs ); } },
-      { typeid(UnsignedInteger), [](auto && lhs, auto && compare, auto && rhs) { return compare(lhs.template as<UnsignedInteger>(), UnsignedInteger(rhs)); } },
-      { typeid(UnsignedShort  ), [](auto && lhs, auto && compare, auto && rhs) { return compare(lhs.template as<UnsignedShort  >(), UnsignedShort  (rhs)); } },
+      { typeid(Boolean        ), [](auto && lhs, auto && compare, auto && rhs) { return comparisonOf<Boolean        >(lhs, compare, Boolean        (rhs)); } },
+      { typeid(Double         ), [](auto && lhs, auto && compare, auto && rhs) { return comparisonOf<Double         >(lhs, compare, Double         (rhs)); } },
+      { typeid(Integer        ), [](auto && lhs, auto && compare, auto && rhs) { return comparisonOf<Integer        >(lhs, compare, Integer        (rhs)); } },
+      { typeid(String         ), [](auto && lhs, auto && compare, auto && rhs) { return comparisonOf<String         >(lhs, compare,                 rhs ); } },
+      { typeid(UnsignedInteger), [](auto && lhs, auto && compare, auto && rhs) { return comparisonOf<UnsignedInteger>(lhs, compare, UnsignedInteger(rhs)); } },
+      { typeid(UnsignedShort  ), [](auto && lhs, auto && compare, auto && rhs) { return comparisonOf<UnsignedShort  >(lhs, compare, UnsignedShort  (rhs)); } },
       // clang-format on
     };
 
@@ -68,14 +87,16 @@ auto ParameterCondition::description() const -> String
   return description.str();
 }
 
-auto ParameterCondition::evaluate() const -> Object
+auto ParameterCondition::evaluate() -> Object
 {
   try {
-    const auto parameter = local().ref(parameter_ref);
-    if (not parameter) {
+    if (comparison) {
+      return asBoolean(comparison());
+    } else if (const auto parameter = local().ref(parameter_ref); not parameter) {
       THROW_SYNTAX_ERROR(parameter_ref, " cannot be found from this scope");
     } else {
-      return asBoolean(compare(parameter, rule, value));
+      comparison = compile(parameter, rule, value);
+      return asBoolean(comparison());
     }
   } catch (const std::out_of_range &) {
     throw SemanticError("No such parameter ", std::quoted(parameter_ref));
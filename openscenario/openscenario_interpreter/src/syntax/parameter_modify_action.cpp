@@ -31,15 +31,18 @@ auto ParameterModifyAction::accomplished() noexcept -> bool { return true; }
 
 auto ParameterModifyAction::run() noexcept -> void {}
 
-auto ParameterModifyAction::start() const -> void
+auto ParameterModifyAction::start() -> void
 {
   try {
-    const auto target = local().ref(parameter_ref);
-    if (rule.is<ParameterAddValueRule>()) {
-      rule.as<ParameterAddValueRule>()(target);
-    } else {
-      rule.as<ParameterMultiplyByValueRule>()(target);
+    if (not modification) {
+      const auto target = local().ref(parameter_ref);
+      if (rule.is<ParameterAddValueRule>()) {
+        modification = rule.as<ParameterAddValueRule>().compile(target);
+      } else {
+        modification = rule.as<ParameterMultiplyByValueRule>().compile(target);
+      }
     }
+    modification();
   } catch (const std::out_of_range &) {
     throw SemanticError("No such parameter ", std::quoted(parameter_ref));
   }
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <functional>
 #include <openscenario_interpreter/reader/attribute.hpp>
 #include <openscenario_interpreter/syntax/parameter_multiply_by_value_rule.hpp>
 #include <typeindex>
@@ -22,40 +23,34 @@ namespace openscenario_interpreter
 {
 inline namespace syntax
 {
+namespace
+{
+/* The value is bound to the target by reference, so that the modification
+   does not look up the type of the target again. */
+template <typename T>
+auto multiply(const Object & target, const Double & value) -> std::function<void()>
+{
+  return [target, &lhs = target.template as<T>(), value]() { lhs *= value; };
+}
+}  // namespace
+
 ParameterMultiplyByValueRule::ParameterMultiplyByValueRule(
   const pugi::xml_node & node, Scope & scope)
 : value(readAttribute<Double>("value", node, scope))
 {
 }
 
-auto ParameterMultiplyByValueRule::operator()(const Object & target) const -> Object
+auto ParameterMultiplyByValueRule::compile(const Object & target) const -> std::function<void()>
 {
   static const std::unordered_map<
-    std::type_index, std::function<Object(const Object &, const Double &)> >
+    std::type_index, std::function<std::function<void()>(const Object &, const Double &)> >
     overloads{
-      {typeid(Integer),
-       [](auto && target, auto && value) {
-         target.template as<Integer>() *= value;
-         return target;
-       }},
-
-      {typeid(Double),
-       [](auto && target, auto && value) {
-         target.template as<Double>() *= value;
-         return target;
-       }},
-
+      {typeid(Integer), [](auto && target, auto && value) { return multiply<Integer>(target, value); }},
+      {typeid(Double), [](auto && target, auto && value) { return multiply<Double>(target, value); }},
       {typeid(UnsignedInteger),
-       [](auto && target, auto && value) {
-         target.template as<UnsignedInteger>() *= value;
-         return target;
-       }},
-
+       [](auto && target, auto && value) { return multiply<UnsignedInteger>(target, value); }},
       {typeid(UnsignedShort),
-       [](auto && target, auto && value) {
-         target.template as<UnsignedShort>() *= value;
-         return target;
-       }},
+       [](auto && target, auto && value) { return multiply<UnsignedShort>(target, value); }},
     };
 
   const auto iter = overloads.find(target.type());
@@ -69,5 +64,11 @@ auto ParameterMultiplyByValueRule::operator()(const Object & target) const -> Ob
       target, " (type ", makeTypename(target.type()), ") specified");
   }
 }
+
+auto ParameterMultiplyByValueRule::operator()(const Object & target) const -> Object
+{
+  compile(target)();
+  return target;
+}
 }  // namespace syntax
 }  // namespace openscenario_interpreter
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <functional>
 #include <openscenario_interpreter/reader/attribute.hpp>
 #include <openscenario_interpreter/syntax/parameter_set_action.hpp>
 #include <typeindex>
@@ -21,6 +22,17 @@ namespace openscenario_interpreter
 {
 inline namespace syntax
 {
+namespace
+{
+/* The converted value is bound to the parameter by reference, so that the
+   assignment does not parse the value nor look up the type again. */
+template <typename T>
+auto assign(const Object & parameter, const T & value) -> std::function<void()>
+{
+  return [parameter, &target = parameter.as<T>(), value]() { target = value; };
+}
+}  // namespace
+
 ParameterSetAction::ParameterSetAction(
   const pugi::xml_node & node, Scope & scope, const String & parameter_ref)
 : Scope(scope), parameter_ref(parameter_ref), value(readAttribute<String>("value", node, local()))
@@ -34,30 +46,37 @@ auto ParameterSetAction::accomplished() noexcept -> bool  //
 
 auto ParameterSetAction::run() noexcept -> void {}
 
-auto ParameterSetAction::set(
-  const Scope & scope, const String & parameter_ref, const String & value) -> void
+auto ParameterSetAction::compile(const Object & parameter, const String & value)
+  -> std::function<void()>
 {
   static const std::unordered_map<
-    std::type_index, std::function<void(const Object &, const String &)>>
+    std::type_index, std::function<std::function<void()>(const Object &, const String &)>>
     overloads{
       // clang-format off
-      { typeid(Boolean),         [](const Object & parameter, const auto & value) { parameter.as<Boolean        >() = boost::lexical_cast<Boolean        >(value); } },
-      { typeid(Double),          [](const Object & parameter, const auto & value) { parameter.as<Double         >() = boost::lexical_cast<Double         >(value); } },
-      { typeid(Integer),         [](const Object & parameter, const auto & value) { parameter.as<Integer        >() = boost::lexical_cast<Integer        >(value); } },
-      { typeid(String),          [](const Object & parameter, const auto & value) { parameter.as<String         >() =                                      value ; } },
-      { typeid(UnsignedInteger), [](const Object & parameter, const auto & value) { parameter.as<UnsignedInteger>() = boost::lexical_cast<UnsignedInteger>(value); } },
-      { typeid(UnsignedShort),   [](const Object & parameter, const auto & value) { parameter.as<UnsignedShort  >() = boost::lexical_cast<UnsignedShort  >(value); } },
+      { typeid(Boolean),         [](const Object & parameter, const auto & value) { return assign(parameter, boost::lexical_cast<Boolean        >(value)); } },
+      { typeid(Double),          [](const Object & parameter, const auto & value) { return assign(parameter, boost::lexical_cast<Double         >(value)); } },
+      { typeid(Integer),         [](const Object & parameter, const auto & value) { return assign(parameter, boost::lexical_cast<Integer        >(value)); } },
+      { typeid(String),          [](const Object & parameter, const auto & value) { return assign(parameter,                                      value ); } },
+      { typeid(UnsignedInteger), [](const Object & parameter, const auto & value) { return assign(parameter, boost::lexical_cast<UnsignedInteger>(value)); } },
+      { typeid(UnsignedShort),   [](const Object & parameter, const auto & value) { return assign(parameter, boost::lexical_cast<UnsignedShort  >(value)); } },
       // clang-format on
     };
 
-  const auto parameter = scope.ref(parameter_ref);
+  return overloads.at(parameter.type())(parameter, value);
+}
 
-  overloads.at(parameter.type())(parameter, value);
+auto ParameterSetAction::set(
+  const Scope & scope, const String & parameter_ref, const String & value) -> void
+{
+  compile(scope.ref(parameter_ref), value)();
 }
 
-auto ParameterSetAction::start() const -> void  //
+auto ParameterSetAction::start() -> void  //
 {
-  set(local(), parameter_ref, value);
+  if (not assignment) {
+    assignment = compile(local().ref(parameter_ref), value);
+  }
+  assignment();
 }
 }  // namespace syntax
 }  // namespace openscenario_interpreter
@@ -43,11 +43,11 @@ StoryboardElementStateCondition::StoryboardElementStateCondition(
   */
 
   auto register_callback = [this]() {
-    local()
-      .ref<StoryboardElement>(storyboard_element_ref)
-      .addTransitionCallback(state, [this](auto && storyboard_element) {
-        current_state = storyboard_element.state().template as<StoryboardElementState>();
-      });
+    auto & element = local().ref<StoryboardElement>(storyboard_element_ref);
+    element.addTransitionCallback(state, [this](auto && storyboard_element) {
+      current_state = storyboard_element.state().template as<StoryboardElementState>();
+    });
+    referenced_storyboard_element = &element;
   };
 
   Storyboard::thunks.push(register_callback);
@@ -66,10 +66,11 @@ auto StoryboardElementStateCondition::description() const -> String
 auto StoryboardElementStateCondition::evaluate() -> Object
 {
   auto update = [this]() {
-    auto storyboard_element = [this]() {
-      return local().ref<StoryboardElement>(storyboard_element_ref);
-    };
-    return current_state = storyboard_element().state().template as<StoryboardElementState>();
+    if (not referenced_storyboard_element) {
+      referenced_storyboard_element = &local().ref<StoryboardElement>(storyboard_element_ref);
+    }
+    return current_state =
+             referenced_storyboard_element->state().template as<StoryboardElementState>();
   };
 
   /*
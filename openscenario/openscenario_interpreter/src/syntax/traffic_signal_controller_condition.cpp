@@ -42,7 +42,10 @@ auto TrafficSignalControllerCondition::description() const -> String
 
 auto TrafficSignalControllerCondition::evaluate() -> Object
 {
-  const auto & controller = scope.ref<TrafficSignalController>(traffic_signal_controller_ref);
+  if (not traffic_signal_controller) {
+    traffic_signal_controller = scope.ref(traffic_signal_controller_ref);
+  }
+  const auto & controller = traffic_signal_controller.as<TrafficSignalController>();
   current_phase_name = controller.currentPhaseName();
   current_phase_since = controller.currentPhaseSince();
   return asBoolean(current_phase_name == phase);
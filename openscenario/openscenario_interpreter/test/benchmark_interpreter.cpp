@@ -0,0 +1,122 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <sys/resource.h>
+
+#include <atomic>
+#include <boost/filesystem.hpp>
+#include <cstdlib>
+#include <new>
+#include <openscenario_interpreter/syntax/open_scenario.hpp>
+#include <openscenario_interpreter/syntax/parameter_condition.hpp>
+#include <openscenario_interpreter/syntax/parameter_set_action.hpp>
+#include <pugixml.hpp>
+#include <string>
+#include <vector>
+
+namespace
+{
+std::atomic<std::size_t> allocation_count{0};
+
+/// @note Scenarios that only need the interpreter to be read, the simulator core is not activated.
+const std::vector<boost::filesystem::path> scenarios{
+  boost::filesystem::path(OPENSCENARIO_INTERPRETER_SOURCE_DIRECTORY) / "test" / "success.xosc",
+  boost::filesystem::path(OPENSCENARIO_INTERPRETER_SOURCE_DIRECTORY) / "example" /
+    "lane_change.xosc",
+};
+
+/// @brief Report the allocations per iteration and the peak resident set size of the process.
+auto setCounters(benchmark::State & state, const std::size_t initial_allocation_count) -> void
+{
+  state.counters["allocations"] = benchmark::Counter(
+    static_cast<double>(allocation_count.load() - initial_allocation_count),
+    benchmark::Counter::kAvgIterations);
+
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  state.counters["peak_rss_kb"] = static_cast<double>(usage.ru_maxrss);
+}
+}  // namespace
+
+/// @note Count the allocations of the whole process, the interpreter allocates through these.
+void * operator new(std::size_t size)
+{
+  ++allocation_count;
+  if (void * pointer = std::malloc(size == 0 ? 1 : size)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void * pointer) noexcept { std::free(pointer); }
+
+void operator delete(void * pointer, std::size_t) noexcept { std::free(pointer); }
+
+using namespace openscenario_interpreter;
+
+/// @note The argument is the index of the scenario in the list above.
+static void OpenScenarioLoad(benchmark::State & state)
+{
+  const auto & path = scenarios[state.range(0)];
+  state.SetLabel(path.filename().string());
+
+  const auto initial_allocation_count = allocation_count.load();
+  for (auto _ : state) {
+    auto script = OpenScenario(path);
+    benchmark::DoNotOptimize(script);
+  }
+  setCounters(state, initial_allocation_count);
+}
+BENCHMARK(OpenScenarioLoad)->DenseRange(0, 1)->Unit(benchmark::kMillisecond);
+
+/// @note Evaluation of a condition of the storyboard on every frame.
+static void ParameterConditionEvaluate(benchmark::State & state)
+{
+  auto script = OpenScenario(scenarios.front());
+  auto scope = Scope("benchmark", script);
+  scope.insert("speed", make<Double>(10.0));
+
+  pugi::xml_document document;
+  document.load_string(R"(<ParameterCondition parameterRef="speed" rule="lessThan" value="20"/>)");
+  auto condition = ParameterCondition(document.child("ParameterCondition"), scope);
+
+  const auto initial_allocation_count = allocation_count.load();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(condition.evaluate());
+  }
+  setCounters(state, initial_allocation_count);
+}
+BENCHMARK(ParameterConditionEvaluate);
+
+/// @note Start of an action of the storyboard, as for an event repeated on every frame.
+static void ParameterSetActionStart(benchmark::State & state)
+{
+  auto script = OpenScenario(scenarios.front());
+  auto scope = Scope("benchmark", script);
+  scope.insert("speed", make<Double>(10.0));
+
+  pugi::xml_document document;
+  document.load_string(R"(<SetAction value="20"/>)");
+  auto action = ParameterSetAction(document.child("SetAction"), scope, "speed");
+
+  const auto initial_allocation_count = allocation_count.load();
+  for (auto _ : state) {
+    action.start();
+  }
+  setCounters(state, initial_allocation_count);
+}
+BENCHMARK(ParameterSetActionStart);
+
+BENCHMARK_MAIN();
@@ -15,14 +15,19 @@
 #ifndef OPENSCENARIO_PREPROCESSOR__OPENSCENARIO_PREPROCESSOR_HPP_
 #define OPENSCENARIO_PREPROCESSOR__OPENSCENARIO_PREPROCESSOR_HPP_
 
-#include <concealer/execute.hpp>
+#include <cstdint>
 #include <deque>
 #include <memory>
+#include <mutex>
 #include <openscenario_interpreter/syntax/open_scenario.hpp>
 #include <openscenario_preprocessor_msgs/srv/check_derivative_remained.hpp>
 #include <openscenario_preprocessor_msgs/srv/derive.hpp>
 #include <openscenario_preprocessor_msgs/srv/load.hpp>
+#include <openscenario_validator/validator.hpp>
 #include <rclcpp/rclcpp.hpp>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace openscenario_preprocessor
 {
@@ -49,6 +54,36 @@ struct ScenarioSet
   float frame_rate;
 };
 
+/*
+   The scenarios derived from a ParameterValueDistribution, served one by one.
+   A derived scenario is only written when it is requested, from its index in
+   the Cartesian product of the parameter distributions, so the product is
+   never materialized. A scenario without distribution is the product of no
+   axis, which has one element.
+*/
+struct Derivation
+{
+  using ParameterAssignments = std::vector<std::pair<std::string, std::string>>;
+
+  ScenarioSet base_scenario;
+
+  // Each axis holds the alternative assignments of one parameter distribution.
+  std::vector<std::vector<ParameterAssignments>> axes;
+
+  // Shard k of n derives the indices k, k + n, k + 2n and so on.
+  std::size_t index = 0;
+
+  std::size_t stride = 1;
+
+  std::shared_ptr<pugi::xml_document> document;
+
+  auto empty() const -> bool { return size() <= index; }
+
+  auto next() -> ScenarioSet;
+
+  auto size() const -> std::size_t;
+};
+
 class Preprocessor : public rclcpp::Node
 {
 public:
@@ -57,8 +92,33 @@ public:
 private:
   void preprocessScenario(ScenarioSet &);
 
+  auto push(
+    const ScenarioSet &, const std::vector<std::vector<Derivation::ParameterAssignments>> &)
+    -> void;
+
+  // This preprocessor serves the shard shard_index of shard_count of every derivation.
+  const std::size_t shard_index;
+
+  const std::size_t shard_count;
+
   [[nodiscard]] bool validateXOSC(const boost::filesystem::path &, bool);
 
+  /*
+     The schema is loaded once by the constructor, instead of starting a
+     Python process to load it for every file.
+  */
+  openscenario_validator::OpenSCENARIOValidator validate;
+
+  /*
+     A file is validated once per content and schema. The files found valid
+     are recorded in the cache directory by the hash of their content and of
+     the schema, so editing either of them validates the file again, while
+     the same scenario given again, even by another process, is not.
+  */
+  const std::uint64_t schema_hash;
+
+  const boost::filesystem::path validation_cache_directory;
+
   rclcpp::Service<openscenario_preprocessor_msgs::srv::Load>::SharedPtr load_server;
 
   rclcpp::Service<openscenario_preprocessor_msgs::srv::Derive>::SharedPtr derive_server;
@@ -66,7 +126,7 @@ private:
   rclcpp::Service<openscenario_preprocessor_msgs::srv::CheckDerivativeRemained>::SharedPtr
     check_server;
 
-  std::deque<ScenarioSet> preprocessed_scenarios;
+  std::deque<Derivation> preprocessed_scenarios;
 
   std::mutex preprocessed_scenarios_mutex;
 };
@@ -13,15 +13,150 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <boost/lexical_cast.hpp>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <numeric>
+#include <openscenario_interpreter/syntax/deterministic_multi_parameter_distribution.hpp>
+#include <openscenario_interpreter/syntax/deterministic_single_parameter_distribution.hpp>
+#include <openscenario_interpreter/syntax/distribution_range.hpp>
+#include <openscenario_interpreter/syntax/distribution_set.hpp>
 #include <openscenario_interpreter/syntax/open_scenario.hpp>
 #include <openscenario_interpreter/syntax/parameter_value_distribution.hpp>
 #include <openscenario_preprocessor/openscenario_preprocessor.hpp>
 #include <rclcpp_components/register_node_macro.hpp>
+#include <sstream>
+#include <string>
 
 namespace openscenario_preprocessor
 {
+auto Derivation::next() -> ScenarioSet
+{
+  if (axes.empty()) {
+    index += stride;
+    return base_scenario;
+  }
+
+  if (not document) {
+    document = std::make_shared<pugi::xml_document>();
+    if (not document->load_file(base_scenario.path.c_str())) {
+      throw common::Error("failed to load base scenario : " + base_scenario.path);
+    }
+  }
+
+  /*
+     Every derived scenario assigns one alternative of each axis, so the
+     parameters of the previous derived scenario are all overwritten.
+  */
+  auto i = index;
+  for (auto axis = axes.rbegin(); axis != axes.rend(); ++axis) {
+    for (const auto & [name, value] : (*axis)[i % axis->size()]) {
+      if (
+        auto parameter_declaration = document->select_node(
+          ("/OpenSCENARIO/ParameterDeclarations/ParameterDeclaration[@name='" + name + "']")
+            .c_str())) {
+        parameter_declaration.node().attribute("value").set_value(value.c_str());
+      } else {
+        throw common::Error("parameter " + name + " is not declared in " + base_scenario.path);
+      }
+    }
+    i /= axis->size();
+  }
+
+  const auto directory = boost::filesystem::path("/tmp/openscenario_preprocessor");
+  boost::filesystem::create_directories(directory);
+
+  const auto stem = boost::filesystem::path(base_scenario.path).stem().string();
+
+  auto derived_scenario = base_scenario;
+  derived_scenario.path = (directory / (stem + "." + std::to_string(index) + ".xosc")).string();
+  if (not document->save_file(derived_scenario.path.c_str())) {
+    throw common::Error("failed to write derived scenario : " + derived_scenario.path);
+  }
+
+  index += stride;
+  return derived_scenario;
+}
+
+auto Derivation::size() const -> std::size_t
+{
+  return std::accumulate(
+    std::begin(axes), std::end(axes), std::size_t(1),
+    [](auto && size, auto && axis) { return size * axis.size(); });
+}
+
+auto derive(const openscenario_interpreter::Deterministic & deterministic)
+{
+  using namespace openscenario_interpreter;
+
+  std::vector<std::vector<Derivation::ParameterAssignments>> axes;
+
+  for (const auto & distribution : deterministic.deterministic_parameter_distributions) {
+    auto & axis = axes.emplace_back();
+    if (distribution.is<DeterministicMultiParameterDistribution>()) {
+      for (const auto & parameter_value_set :
+           distribution.as<DeterministicMultiParameterDistribution>().parameter_value_sets) {
+        auto & assignments = axis.emplace_back();
+        for (const auto & assignment : parameter_value_set.parameter_assignments) {
+          assignments.emplace_back(assignment.parameterRef, assignment.value);
+        }
+      }
+    } else if (const auto & single = distribution.as<DeterministicSingleParameterDistribution>();
+               single.is<DistributionSet>()) {
+      for (const auto & element : single.as<DistributionSet>().elements) {
+        axis.push_back({{single.parameter_name, element.value}});
+      }
+    } else if (single.is<DistributionRange>()) {
+      const auto & distribution_range = single.as<DistributionRange>();
+      const double lower_limit = distribution_range.range.lower_limit;
+      const double upper_limit = distribution_range.range.upper_limit;
+      const double step_width = distribution_range.step_width;
+      if (step_width <= 0) {
+        throw common::Error("stepWidth of DistributionRange must be positive");
+      }
+      /// @note Hard coded parameter, tolerance for the upper limit to be reached by the steps.
+      constexpr double epsilon = 1e-9;
+      const auto count =
+        static_cast<std::size_t>(std::floor((upper_limit - lower_limit) / step_width + epsilon));
+      for (std::size_t i = 0; i <= count and lower_limit <= upper_limit; ++i) {
+        const auto value = boost::lexical_cast<std::string>(lower_limit + i * step_width);
+        axis.push_back({{single.parameter_name, value}});
+      }
+    } else {
+      throw common::Error("UserDefinedDistribution is not supported yet");
+    }
+  }
+
+  return axes;
+}
+
+/// @note FNV-1a, which does not change between processes unlike std::hash.
+auto hash(const std::string & content, std::uint64_t value = 14695981039346656037ull)
+  -> std::uint64_t
+{
+  for (const auto c : content) {
+    value = (value ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+  }
+  return value;
+}
+
+auto read(const boost::filesystem::path & path) -> std::string
+{
+  if (std::ifstream file(path.string(), std::ios::binary); file) {
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  } else {
+    throw common::Error("failed to read file : " + path.string());
+  }
+}
+
 Preprocessor::Preprocessor(const rclcpp::NodeOptions & options)
 : rclcpp::Node("openscenario_preprocessor", options),
+  shard_index(declare_parameter<int>("shard_index", 0)),
+  shard_count(declare_parameter<int>("shard_count", 1)),
+  schema_hash(hash(read(validate.schema()))),
+  validation_cache_directory("/tmp/openscenario_preprocessor/validated"),
   load_server(create_service<openscenario_preprocessor_msgs::srv::Load>(
     "~/load",
     [this](
@@ -48,8 +183,15 @@ Preprocessor::Preprocessor(const rclcpp::NodeOptions & options)
       if (preprocessed_scenarios.empty()) {
         response->path = "no output";
       } else {
-        *response = preprocessed_scenarios.front().getDeriveResponse();
-        preprocessed_scenarios.pop_front();
+        try {
+          *response = preprocessed_scenarios.front().next().getDeriveResponse();
+        } catch (const std::exception & e) {
+          RCLCPP_ERROR_STREAM(get_logger(), e.what());
+          response->path = "no output";
+        }
+        if (preprocessed_scenarios.front().empty()) {
+          preprocessed_scenarios.pop_front();
+        }
       }
     })),
   check_server(create_service<openscenario_preprocessor_msgs::srv::CheckDerivativeRemained>(
@@ -62,16 +204,51 @@ Preprocessor::Preprocessor(const rclcpp::NodeOptions & options)
       response->derivative_remained = not preprocessed_scenarios.empty();
     }))
 {
+  if (shard_count == 0 or shard_count <= shard_index) {
+    throw common::Error(
+      "shard_index (", shard_index, ") must be less than shard_count (", shard_count, ")");
+  }
 }
 
 bool Preprocessor::validateXOSC(const boost::filesystem::path & file_name, bool verbose = false)
 {
-  auto result =
-    concealer::dollar("ros2 run openscenario_utility validation.py " + file_name.string());
-  if (verbose) {
-    std::cout << "validate : " << result << std::endl;
+  try {
+    std::stringstream key;
+    key << std::hex << std::setw(16) << std::setfill('0') << hash(read(file_name), schema_hash);
+    const auto cache = validation_cache_directory / key.str();
+    if (boost::filesystem::exists(cache)) {
+      if (verbose) {
+        std::cout << "validate : " << file_name << " is standard compliant (cached)." << std::endl;
+      }
+      return true;
+    }
+    validate(file_name);
+    boost::filesystem::create_directories(validation_cache_directory);
+    std::ofstream(cache.string());
+    if (verbose) {
+      std::cout << "validate : " << file_name << " is standard compliant." << std::endl;
+    }
+    return true;
+  } catch (const std::exception & e) {
+    if (verbose) {
+      std::cout << "validate : " << e.what() << std::endl;
+    }
+    return false;
+  }
+}
+
+auto Preprocessor::push(
+  const ScenarioSet & scenario,
+  const std::vector<std::vector<Derivation::ParameterAssignments>> & axes) -> void
+{
+  Derivation derivation;
+  derivation.base_scenario = scenario;
+  derivation.axes = axes;
+  derivation.index = shard_index;
+  derivation.stride = shard_count;
+  if (not derivation.empty()) {
+    preprocessed_scenarios.push_back(std::move(derivation));
   }
-  return result.find("All xosc files given are standard compliant.") != std::string::npos;
 }
 
 void Preprocessor::preprocessScenario(ScenarioSet & scenario)
@@ -88,11 +265,14 @@ void Preprocessor::preprocessScenario(ScenarioSet & scenario)
       std::cout << "base_scenario_path : " << base_scenario_path << std::endl;
       if (boost::filesystem::exists(base_scenario_path)) {
         if (validateXOSC(base_scenario_path, true)) {
-          // TODO : implement in feature/parameter_value_distribution branch
-          //
-          //  parameters = evaluate( parameter_value_distribution( given scenario ) )
-          //  for( auto derived_scenario : embedParameter( linked scenario, parameters)
-          //    preprocessed_scenarios.emplace_back({derived_scenario, derive_server});
+          if (const auto & distribution = script->category.as<ParameterValueDistribution>();
+              distribution.is<Deterministic>()) {
+            auto base_scenario = scenario;
+            base_scenario.path = base_scenario_path.string();
+            push(base_scenario, derive(distribution.as<Deterministic>()));
+          } else {
+            throw common::Error("Stochastic distribution is not supported yet");
+          }
         } else {
           throw common::Error("base scenario is not valid : " + base_scenario_path.string());
         }
@@ -103,7 +283,7 @@ void Preprocessor::preprocessScenario(ScenarioSet & scenario)
 
     } else {
       // normal scenario
-      preprocessed_scenarios.emplace_back(scenario);
+      push(scenario, {});
     }
   } else {
     throw common::Error("the scenario file is not valid. Please check your scenario");
@@ -60,6 +60,8 @@ class OpenSCENARIOValidator
     }
   };
 
+  const boost::filesystem::path schema_path;
+
   std::unique_ptr<xercesc::XercesDOMParser> parser;
 
   ErrorHandler error_handler;
@@ -74,7 +76,11 @@ class OpenSCENARIOValidator
   static inline XMLPlatformLifecycleHandler xml_platform_lifecycle_handler;
 
 public:
-  OpenSCENARIOValidator() : parser(std::make_unique<xercesc::XercesDOMParser>())
+  OpenSCENARIOValidator()
+  : schema_path(
+      ament_index_cpp::get_package_share_directory("openscenario_validator") +
+      "/schema/OpenSCENARIO-1.3.xsd"),
+    parser(std::make_unique<xercesc::XercesDOMParser>())
   {
     parser->setDoNamespaces(true);
     parser->setDoSchema(true);
@@ -82,12 +88,11 @@ public:
     parser->setValidationSchemaFullChecking(true);
     parser->setValidationScheme(xercesc::XercesDOMParser::Val_Always);
 
-    parser->setExternalNoNamespaceSchemaLocation(
-      (ament_index_cpp::get_package_share_directory("openscenario_validator") +
-       "/schema/OpenSCENARIO-1.3.xsd")
-        .c_str());
+    parser->setExternalNoNamespaceSchemaLocation(schema_path.string().c_str());
   }
 
+  auto schema() const -> const boost::filesystem::path & { return schema_path; }
+
   auto validate(const boost::filesystem::path & xml_file) -> void
   {
     parser->parse(xml_file.string().c_str());
@@ -15,8 +15,6 @@
 #ifndef OPENSCENARIO_VISUALIZATION_CONDITION_GROUPS_HPP_
 #define OPENSCENARIO_VISUALIZATION_CONDITION_GROUPS_HPP_
 
-#include <yaml-cpp/yaml.h>
-
 #include <memory>
 #include <nlohmann/json.hpp>
 
@@ -50,17 +48,33 @@ struct Condition
   std::string current_evaluation;
   std::string current_value;
   std::string type;
+
+  auto operator==(const Condition & other) const -> bool
+  {
+    return current_evaluation == other.current_evaluation &&
+           current_value == other.current_value && type == other.type;
+  }
 };
 
 struct ConditionGroup
 {
   std::vector<Condition> conditions;
+
+  auto operator==(const ConditionGroup & other) const -> bool
+  {
+    return conditions == other.conditions;
+  }
 };
 
 struct ConditionGroups
 {
   std::string groups_name;
   std::vector<ConditionGroup> condition_groups;
+
+  auto operator==(const ConditionGroups & other) const -> bool
+  {
+    return groups_name == other.groups_name && condition_groups == other.condition_groups;
+  }
 };
 
 using nlohmann::json;
@@ -78,6 +92,7 @@ public:
   void onInitialize() override;
   void onDisable() override;
   void onEnable() override;
+  void update(float wall_dt, float ros_dt) override;
   void subscribe();
   void unsubscribe();
 
@@ -97,11 +112,14 @@ protected:
   rviz_common::properties::FloatProperty * property_value_scale_;
 
 private:
+  void draw();
   void loadConditionGroups(const Context::ConstSharedPtr msg_ptr);
-  void processStory(const YAML::Node & story);
-  void processManeuver(const YAML::Node & maneuver);
-  void processEvent(const YAML::Node & event);
+  void processStory(const json & story);
+  void processManeuver(const json & maneuver);
+  void processEvent(const json & event);
   rclcpp::Subscription<Context>::SharedPtr simulation_context_sub_;
+  /// @note The latest message received, parsed at most once per frame of the display.
+  Context::ConstSharedPtr pending_msg_ptr_;
   Context::ConstSharedPtr last_msg_ptr_;
   std::shared_ptr<ConditionGroupsCollection> condition_groups_collection_ptr_;
 };
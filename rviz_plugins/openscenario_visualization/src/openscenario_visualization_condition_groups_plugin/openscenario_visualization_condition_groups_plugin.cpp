@@ -23,10 +23,25 @@
 #include <rviz_common/display_context.hpp>
 #include <rviz_common/uniform_string_stream.hpp>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace openscenario_visualization
 {
+namespace
+{
+/// @note Elements of the array of the key, without copying them, or none if the key is missing.
+auto children(const json & node, const char * key) -> const json &
+{
+  static const json none = json::array();
+  if (const auto iter = node.find(key); iter != node.end()) {
+    return *iter;
+  } else {
+    return none;
+  }
+}
+}  // namespace
+
 VisualizationConditionGroupsDisplay::VisualizationConditionGroupsDisplay()
 : condition_groups_collection_ptr_(std::make_shared<std::vector<ConditionGroups>>())
 {
@@ -158,6 +173,31 @@ void VisualizationConditionGroupsDisplay::subscribe()
 void VisualizationConditionGroupsDisplay::unsubscribe() { simulation_context_sub_.reset(); }
 
 void VisualizationConditionGroupsDisplay::processMessage(const Context::ConstSharedPtr msg_ptr)
+{
+  /// @note Only keep the message, so that the messages received within a frame are parsed once.
+  pending_msg_ptr_ = msg_ptr;
+}
+
+void VisualizationConditionGroupsDisplay::update(float, float)
+{
+  if (!pending_msg_ptr_ || !overlay_->isVisible()) return;
+
+  const auto msg_ptr = std::exchange(pending_msg_ptr_, nullptr);
+
+  /// @note The context is repeated while no storyboard element changes its state.
+  if (last_msg_ptr_ && last_msg_ptr_->data == msg_ptr->data) return;
+
+  auto previous_collection = std::move(*condition_groups_collection_ptr_);
+  loadConditionGroups(msg_ptr);
+  last_msg_ptr_ = msg_ptr;
+
+  /// @note The texture is only redrawn if a row of the table has changed.
+  if (previous_collection != *condition_groups_collection_ptr_) {
+    draw();
+  }
+}
+
+void VisualizationConditionGroupsDisplay::draw()
 {
   if (!overlay_->isVisible()) return;
 
@@ -179,8 +219,6 @@ void VisualizationConditionGroupsDisplay::processMessage(const Context::ConstSha
   font.setBold(true);
   painter.setFont(font);
 
-  loadConditionGroups(msg_ptr);
-
   std::ostringstream context_ss;
   for (const auto & condition_groups : *condition_groups_collection_ptr_) {
     context_ss << std::fixed << std::setprecision(0)
@@ -200,7 +238,6 @@ void VisualizationConditionGroupsDisplay::processMessage(const Context::ConstSha
     overlay_->getTextureHeight(), Qt::AlignLeft | Qt::AlignTop, context_ss.str().c_str());
 
   painter.end();
-  last_msg_ptr_ = msg_ptr;
 }
 
 void VisualizationConditionGroupsDisplay::updateVisualization()
@@ -212,57 +249,55 @@ void VisualizationConditionGroupsDisplay::updateVisualization()
   overlay_->setPosition(property_left_->getInt(), property_top_->getInt());
   overlay_->setDimensions(width, height);
 
-  if (last_msg_ptr_) {
-    processMessage(last_msg_ptr_);
-  }
+  draw();
 }
 
 void VisualizationConditionGroupsDisplay::loadConditionGroups(const Context::ConstSharedPtr msg_ptr)
 {
   if (!msg_ptr) return;
 
-  YAML::Node data;
+  json data;
   try {
-    data = YAML::Load(msg_ptr->data);
+    data = json::parse(msg_ptr->data);
   } catch (const std::exception & e) {
-    throw std::runtime_error(std::string("Failed to load YAML: ") + e.what());
+    throw std::runtime_error(std::string("Failed to load JSON: ") + e.what());
   }
 
   condition_groups_collection_ptr_->clear();
 
-  auto stories = data["OpenSCENARIO"]["Storyboard"]["Story"];
-  for (const auto & story : stories) {
-    processStory(story);
+  if (const auto stories = json::json_pointer("/OpenSCENARIO/Storyboard/Story");
+      data.contains(stories)) {
+    for (const auto & story : data[stories]) {
+      processStory(story);
+    }
   }
 }
 
-void VisualizationConditionGroupsDisplay::processStory(const YAML::Node & story_node)
+void VisualizationConditionGroupsDisplay::processStory(const json & story_node)
 {
-  for (const auto & act : story_node["Act"]) {
-    for (const auto & maneuver_group : act["ManeuverGroup"]) {
-      for (const auto & maneuver : maneuver_group["Maneuver"]) {
+  for (const auto & act : children(story_node, "Act")) {
+    for (const auto & maneuver_group : children(act, "ManeuverGroup")) {
+      for (const auto & maneuver : children(maneuver_group, "Maneuver")) {
         processManeuver(maneuver);
       }
     }
   }
 }
 
-void VisualizationConditionGroupsDisplay::processManeuver(const YAML::Node & maneuver_node)
+void VisualizationConditionGroupsDisplay::processManeuver(const json & maneuver_node)
 {
-  for (const auto & event : maneuver_node["Event"]) {
-    if (event["StartTrigger"] && event["StartTrigger"]["ConditionGroup"]) {
+  for (const auto & event : children(maneuver_node, "Event")) {
+    if (event.contains("StartTrigger") && event["StartTrigger"].contains("ConditionGroup")) {
       processEvent(event);
     }
   }
 }
 
-void VisualizationConditionGroupsDisplay::processEvent(const YAML::Node & event_node)
+void VisualizationConditionGroupsDisplay::processEvent(const json & event_node)
 {
   std::string event_name;
-  try {
-    event_name = event_node["name"].as<std::string>();
-  } catch (const YAML::BadConversion & e) {
-    event_name = "";
+  if (event_node.contains("name") && event_node["name"].is_string()) {
+    event_name = event_node["name"].get<std::string>();
   }
   if (event_name.empty()) {
     event_name = "name is not defined";
@@ -274,11 +309,11 @@ void VisualizationConditionGroupsDisplay::processEvent(const YAML::Node & event_
   for (const auto & condition_group_node : event_node["StartTrigger"]["ConditionGroup"]) {
     ConditionGroup condition_group;
 
-    for (const auto & condition_node : condition_group_node["Condition"]) {
+    for (const auto & condition_node : children(condition_group_node, "Condition")) {
       Condition condition_msg;
-      condition_msg.current_evaluation = condition_node["currentEvaluation"].as<std::string>();
-      condition_msg.current_value = condition_node["currentValue"].as<std::string>();
-      condition_msg.type = condition_node["type"].as<std::string>();
+      condition_msg.current_evaluation = condition_node.at("currentEvaluation").get<std::string>();
+      condition_msg.current_value = condition_node.at("currentValue").get<std::string>();
+      condition_msg.type = condition_node.at("type").get<std::string>();
 
       condition_group.conditions.push_back(condition_msg);
     }
@@ -18,6 +18,7 @@
 #include <behaviortree_cpp_v3/action_node.h>
 
 #include <algorithm>
+#include <behavior_tree_plugin/action_node_context.hpp>
 #include <geometry/spline/catmull_rom_spline.hpp>
 #include <memory>
 #include <optional>
@@ -55,6 +56,9 @@ public:
   auto getDistanceToStopLine(
     const lanelet::Ids & route_lanelets,
     const std::vector<geometry_msgs::msg::Point> & waypoints) const -> std::optional<double>;
+  auto getDistanceToStopLine(
+    const lanelet::Ids & route_lanelets,
+    const math::geometry::CatmullRomSplineInterface & spline) const -> std::optional<double>;
   auto getDistanceToTrafficLightStopLine(
     const lanelet::Ids & route_lanelets,
     const math::geometry::CatmullRomSplineInterface & spline) const -> std::optional<double>;
@@ -64,6 +68,8 @@ public:
   auto getYieldStopDistance(const lanelet::Ids & following_lanelets) const -> std::optional<double>;
   auto getOtherEntityStatus(lanelet::Id lanelet_id) const
     -> std::vector<traffic_simulator::CanonicalizedEntityStatus>;
+  auto getOtherEntityStatus(lanelet::Ids lanelet_ids) const
+    -> std::vector<traffic_simulator::CanonicalizedEntityStatus>;
   auto stopEntity() const -> void;
   auto getHorizon() const -> double;
 
@@ -76,19 +82,9 @@ public:
   {
     return {
       // clang-format off
-      BT::InputPort<double>("current_time"),
-      BT::InputPort<double>("matching_distance_for_lanelet_pose_calculation"),
-      BT::InputPort<double>("step_time"),
-      BT::InputPort<EntityStatusDict>("other_entity_status"),
-      BT::InputPort<lanelet::Ids>("route_lanelets"),
-      BT::InputPort<std::optional<double>>("target_speed"),
-      BT::InputPort<std::shared_ptr<hdmap_utils::HdMapUtils>>("hdmap_utils"),
-      BT::InputPort<std::shared_ptr<traffic_simulator::CanonicalizedEntityStatus>>("canonicalized_entity_status"),
-      BT::InputPort<std::shared_ptr<traffic_simulator::TrafficLightManager>>("traffic_light_manager"),
-      BT::InputPort<traffic_simulator::behavior::Request>("request"),
+      BT::InputPort<std::shared_ptr<ActionNodeContext>>(ActionNodeContext::key()),
       BT::OutputPort<std::optional<traffic_simulator_msgs::msg::Obstacle>>("obstacle"),
       BT::OutputPort<traffic_simulator_msgs::msg::WaypointsArray>("waypoints"),
-      BT::OutputPort<traffic_simulator::behavior::Request>("request"),
       // clang-format on
     };
   }
@@ -102,14 +98,17 @@ public:
     -> std::optional<double>;
 
   auto setCanonicalizedEntityStatus(const traffic_simulator::EntityStatus & entity_status) -> void;
+  auto setCanonicalizedEntityStatus(
+    const traffic_simulator::CanonicalizedEntityStatus & canonicalized_entity_status) -> void;
   auto calculateUpdatedEntityStatus(
     double target_speed, const traffic_simulator_msgs::msg::DynamicConstraints &) const
-    -> traffic_simulator::EntityStatus;
+    -> traffic_simulator::CanonicalizedEntityStatus;
   auto calculateUpdatedEntityStatusInWorldFrame(
     double target_speed, const traffic_simulator_msgs::msg::DynamicConstraints &) const
     -> traffic_simulator::EntityStatus;
 
 protected:
+  std::shared_ptr<const ActionNodeContext> context;
   traffic_simulator::behavior::Request request;
   std::shared_ptr<hdmap_utils::HdMapUtils> hdmap_utils;
   std::shared_ptr<traffic_simulator::TrafficLightManager> traffic_light_manager;
@@ -118,10 +117,18 @@ protected:
   double step_time;
   double default_matching_distance_for_lanelet_pose_calculation;
   std::optional<double> target_speed;
-  EntityStatusDict other_entity_status;
-  lanelet::Ids route_lanelets;
 
 private:
+  auto calculateDistanceToConflictingEntity(
+    const lanelet::Ids & route_lanelets,
+    const math::geometry::CatmullRomSplineInterface & spline) const -> std::optional<double>;
+  auto calculateFrontEntityName(const math::geometry::CatmullRomSplineInterface & spline) const
+    -> std::optional<std::string>;
+  auto calculateDistanceToTrafficLightStopLine(
+    const lanelet::Ids & route_lanelets,
+    const math::geometry::CatmullRomSplineInterface & spline) const -> std::optional<double>;
+  auto calculateRightOfWayEntities(const lanelet::Ids & following_lanelets) const
+    -> std::vector<traffic_simulator::CanonicalizedEntityStatus>;
   auto getDistanceToTargetEntityOnCrosswalk(
     const math::geometry::CatmullRomSplineInterface & spline,
     const traffic_simulator::CanonicalizedEntityStatus & status) const -> std::optional<double>;
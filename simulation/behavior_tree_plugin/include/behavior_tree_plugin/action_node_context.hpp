@@ -0,0 +1,97 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef BEHAVIOR_TREE_PLUGIN__ACTION_NODE_CONTEXT_HPP_
+#define BEHAVIOR_TREE_PLUGIN__ACTION_NODE_CONTEXT_HPP_
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <traffic_simulator/behavior/behavior_plugin_base.hpp>
+#include <traffic_simulator/data_type/behavior.hpp>
+#include <traffic_simulator/data_type/entity_status.hpp>
+#include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
+#include <traffic_simulator/traffic_lights/traffic_light_manager.hpp>
+#include <utility>
+#include <vector>
+
+namespace entity_behavior
+{
+/**
+ * @brief Perception results that several action nodes ask for during one tick of an entity.
+ * @note Each one is calculated by the first node asking for it and reused by the following ones.
+ * The behavior tree clears them before every tick, and ActionNode::setCanonicalizedEntityStatus
+ * clears them when a node moves the entity. Each entry also remembers the arguments it was
+ * calculated for, and a call with other arguments recalculates it. The horizon trajectories of
+ * the nodes are told apart by their length, since they all start at the entity.
+ */
+struct PerceptionCache
+{
+  template <typename Key, typename Value>
+  class Entry
+  {
+  public:
+    template <typename Calculate>
+    auto get(const Key & key, Calculate && calculate) -> const Value &
+    {
+      if (not memo_ or memo_->first != key) {
+        memo_.emplace(key, calculate());
+      }
+      return memo_->second;
+    }
+
+  private:
+    std::optional<std::pair<Key, Value>> memo_;
+  };
+
+  using RouteAndLength = std::pair<lanelet::Ids, double>;
+
+  Entry<lanelet::Ids, std::vector<traffic_simulator::CanonicalizedEntityStatus>>
+    right_of_way_entities;
+  Entry<double, std::optional<std::string>> front_entity_name;
+  Entry<double, std::optional<double>> distance_to_front_entity;
+  Entry<RouteAndLength, std::optional<double>> distance_to_conflicting_entity;
+  Entry<RouteAndLength, std::optional<double>> distance_to_stop_line;
+  Entry<RouteAndLength, std::optional<double>> distance_to_traffic_light_stop_line;
+};
+
+/**
+ * @brief Values shared by every ActionNode of a behavior tree.
+ * @note The behavior tree owns a single instance and publishes it on the blackboard under key(),
+ * so each node gets all of them with one lookup and reads them by reference instead of copying
+ * them out of the blackboard one port at a time.
+ */
+struct ActionNodeContext
+{
+  static auto key() -> const std::string &
+  {
+    static const std::string key = "action_node_context";
+    return key;
+  }
+
+  traffic_simulator::behavior::Request request = traffic_simulator::behavior::Request::NONE;
+  std::shared_ptr<hdmap_utils::HdMapUtils> hdmap_utils;
+  std::shared_ptr<traffic_simulator::TrafficLightManager> traffic_light_manager;
+  std::shared_ptr<traffic_simulator::CanonicalizedEntityStatus> canonicalized_entity_status;
+  double current_time = 0.0;
+  double step_time = 0.0;
+  double default_matching_distance_for_lanelet_pose_calculation = 0.0;
+  std::optional<double> target_speed;
+  EntityStatusDict other_entity_status;
+  lanelet::Ids route_lanelets;
+  mutable PerceptionCache perception_cache;
+};
+}  // namespace entity_behavior
+
+#endif  // BEHAVIOR_TREE_PLUGIN__ACTION_NODE_CONTEXT_HPP_
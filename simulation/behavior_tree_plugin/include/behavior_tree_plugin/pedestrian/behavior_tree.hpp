@@ -20,6 +20,7 @@
 
 #include <behavior_tree_plugin/pedestrian/follow_lane_action.hpp>
 #include <behavior_tree_plugin/pedestrian/walk_straight_action.hpp>
+#include <behavior_tree_plugin/action_node_context.hpp>
 #include <behavior_tree_plugin/transition_events/transition_events.hpp>
 #include <functional>
 #include <geometry_msgs/msg/point.hpp>
@@ -39,7 +40,15 @@ class PedestrianBehaviorTree : public BehaviorPluginBase
 {
 public:
   void configure(const rclcpp::Logger & logger) override;
+  auto recycle() -> bool override;
   auto update(const double current_time, const double step_time) -> void override;
+  /**
+   * @brief Tick the trees of all pedestrians in one loop without virtual dispatch.
+   * @param plugins plugins of the entities, all of them are PedestrianBehaviorTree.
+   */
+  auto updateAll(
+    const std::vector<BehaviorPluginBase *> & plugins, const double current_time,
+    const double step_time) -> void override;
   const std::string & getCurrentAction() const override;
 
 #define DEFINE_GETTER_SETTER(NAME, TYPE)                                                    \
@@ -51,34 +60,43 @@ public:
 
   // clang-format off
   DEFINE_GETTER_SETTER(BehaviorParameter,                                traffic_simulator_msgs::msg::BehaviorParameter)
-  DEFINE_GETTER_SETTER(CanonicalizedEntityStatus,                        std::shared_ptr<traffic_simulator::CanonicalizedEntityStatus>)
-  DEFINE_GETTER_SETTER(CurrentTime,                                      double)
   DEFINE_GETTER_SETTER(DebugMarker,                                      std::vector<visualization_msgs::msg::Marker>)
-  DEFINE_GETTER_SETTER(DefaultMatchingDistanceForLaneletPoseCalculation, double)
   DEFINE_GETTER_SETTER(GoalPoses,                                        std::vector<geometry_msgs::msg::Pose>)
-  DEFINE_GETTER_SETTER(HdMapUtils,                                       std::shared_ptr<hdmap_utils::HdMapUtils>)
   DEFINE_GETTER_SETTER(LaneChangeParameters,                             traffic_simulator::lane_change::Parameter)
   DEFINE_GETTER_SETTER(Obstacle,                                         std::optional<traffic_simulator_msgs::msg::Obstacle>)
-  DEFINE_GETTER_SETTER(OtherEntityStatus,                                EntityStatusDict)
   DEFINE_GETTER_SETTER(PedestrianParameters,                             traffic_simulator_msgs::msg::PedestrianParameters)
   DEFINE_GETTER_SETTER(PolylineTrajectory,                               std::shared_ptr<traffic_simulator_msgs::msg::PolylineTrajectory>)
   DEFINE_GETTER_SETTER(ReferenceTrajectory,                              std::shared_ptr<math::geometry::CatmullRomSpline>)
-  DEFINE_GETTER_SETTER(Request,                                          traffic_simulator::behavior::Request)
-  DEFINE_GETTER_SETTER(RouteLanelets,                                    lanelet::Ids)
-  DEFINE_GETTER_SETTER(StepTime,                                         double)
-  DEFINE_GETTER_SETTER(TargetSpeed,                                      std::optional<double>)
-  DEFINE_GETTER_SETTER(TrafficLightManager,                              std::shared_ptr<traffic_simulator::TrafficLightManager>)
   DEFINE_GETTER_SETTER(VehicleParameters,                                traffic_simulator_msgs::msg::VehicleParameters)
   DEFINE_GETTER_SETTER(Waypoints,                                        traffic_simulator_msgs::msg::WaypointsArray)
   // clang-format on
 
 #undef DEFINE_GETTER_SETTER
 
+#define DEFINE_CONTEXT_GETTER_SETTER(NAME, TYPE, MEMBER)                    \
+  TYPE get##NAME() override { return context_->MEMBER; }                    \
+  void set##NAME(const TYPE & value) override { context_->MEMBER = value; }
+
+  // clang-format off
+  DEFINE_CONTEXT_GETTER_SETTER(CanonicalizedEntityStatus,                        std::shared_ptr<traffic_simulator::CanonicalizedEntityStatus>, canonicalized_entity_status)
+  DEFINE_CONTEXT_GETTER_SETTER(CurrentTime,                                      double, current_time)
+  DEFINE_CONTEXT_GETTER_SETTER(DefaultMatchingDistanceForLaneletPoseCalculation, double, default_matching_distance_for_lanelet_pose_calculation)
+  DEFINE_CONTEXT_GETTER_SETTER(HdMapUtils,                                       std::shared_ptr<hdmap_utils::HdMapUtils>, hdmap_utils)
+  DEFINE_CONTEXT_GETTER_SETTER(OtherEntityStatus,                                EntityStatusDict, other_entity_status)
+  DEFINE_CONTEXT_GETTER_SETTER(Request,                                          traffic_simulator::behavior::Request, request)
+  DEFINE_CONTEXT_GETTER_SETTER(RouteLanelets,                                    lanelet::Ids, route_lanelets)
+  DEFINE_CONTEXT_GETTER_SETTER(StepTime,                                         double, step_time)
+  DEFINE_CONTEXT_GETTER_SETTER(TargetSpeed,                                      std::optional<double>, target_speed)
+  DEFINE_CONTEXT_GETTER_SETTER(TrafficLightManager,                              std::shared_ptr<traffic_simulator::TrafficLightManager>, traffic_light_manager)
+  // clang-format on
+#undef DEFINE_CONTEXT_GETTER_SETTER
+
 private:
   auto tickOnce(const double current_time, const double step_time) -> BT::NodeStatus;
   auto createBehaviorTree(const std::string & format_path) -> BT::Tree;
   BT::BehaviorTreeFactory factory_;
   BT::Tree tree_;
+  const std::shared_ptr<ActionNodeContext> context_ = std::make_shared<ActionNodeContext>();
   std::unique_ptr<behavior_tree_plugin::LoggingEvent> logging_event_ptr_;
   std::unique_ptr<behavior_tree_plugin::ResetRequestEvent> reset_request_event_ptr_;
 };
@@ -20,9 +20,11 @@
 
 #include <behavior_tree_plugin/pedestrian/pedestrian_action_node.hpp>
 #include <memory>
+#include <optional>
 #include <string>
 #include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
 #include <traffic_simulator_msgs/msg/entity_status.hpp>
+#include <utility>
 #include <vector>
 
 namespace entity_behavior
@@ -44,6 +46,10 @@ public:
     }
     return ports;
   }
+
+private:
+  /// @note Speed limit of the lanelets following the lanelet the entity was on at the last tick.
+  std::optional<std::pair<lanelet::Id, double>> speed_limit_;
 };
 }  // namespace pedestrian
 }  // namespace entity_behavior
@@ -16,6 +16,8 @@
 #define BEHAVIOR_TREE_PLUGIN__PEDESTRIAN__FOLLOW_POLYLINE_TRAJECTORY_ACTION_HPP_
 
 #include <behavior_tree_plugin/pedestrian/pedestrian_action_node.hpp>
+#include <optional>
+#include <traffic_simulator/behavior/follow_trajectory.hpp>
 
 namespace entity_behavior
 {
@@ -25,6 +27,15 @@ struct FollowPolylineTrajectoryAction : public PedestrianActionNode
 {
   std::shared_ptr<traffic_simulator_msgs::msg::PolylineTrajectory> polyline_trajectory;
 
+  /*
+     The samples are made on the first tick of every newly requested trajectory, which is kept
+     alive here so that a new request can never be mistaken for the sampled one.
+  */
+  std::shared_ptr<traffic_simulator_msgs::msg::PolylineTrajectory> sampled_polyline_trajectory;
+
+  std::optional<traffic_simulator::follow_trajectory::PolylineTrajectorySamples>
+    polyline_trajectory_samples;
+
   using PedestrianActionNode::PedestrianActionNode;
 
   auto calculateWaypoints() -> const traffic_simulator_msgs::msg::WaypointsArray;
@@ -32,6 +43,9 @@ struct FollowPolylineTrajectoryAction : public PedestrianActionNode
   auto calculateObstacle(const traffic_simulator_msgs::msg::WaypointsArray &)
     -> const std::optional<traffic_simulator_msgs::msg::Obstacle>;
 
+  auto getPolylineTrajectorySamples()
+    -> traffic_simulator::follow_trajectory::PolylineTrajectorySamples &;
+
   static auto providedPorts() -> BT::PortsList;
 
   auto tick() -> BT::NodeStatus override;
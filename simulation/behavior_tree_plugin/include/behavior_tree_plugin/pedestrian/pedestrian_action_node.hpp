@@ -46,7 +46,8 @@ public:
   traffic_simulator_msgs::msg::PedestrianParameters pedestrian_parameters;
   auto calculateUpdatedEntityStatusInWorldFrame(double target_speed) const
     -> traffic_simulator::EntityStatus;
-  auto calculateUpdatedEntityStatus(double target_speed) const -> traffic_simulator::EntityStatus;
+  auto calculateUpdatedEntityStatus(double target_speed) const
+    -> traffic_simulator::CanonicalizedEntityStatus;
 
 protected:
   traffic_simulator_msgs::msg::BehaviorParameter behavior_parameter;
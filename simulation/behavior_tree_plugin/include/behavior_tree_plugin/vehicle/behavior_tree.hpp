@@ -18,7 +18,9 @@
 #include <behaviortree_cpp_v3/bt_factory.h>
 #include <behaviortree_cpp_v3/loggers/bt_cout_logger.h>
 
+#include <behavior_tree_plugin/action_node_context.hpp>
 #include <behavior_tree_plugin/transition_events/transition_events.hpp>
+#include <behavior_tree_plugin/wake_up_condition.hpp>
 #include <functional>
 #include <geometry_msgs/msg/point.hpp>
 #include <map>
@@ -40,6 +42,7 @@ class VehicleBehaviorTree : public BehaviorPluginBase
 public:
   auto update(const double current_time, const double step_time) -> void override;
   void configure(const rclcpp::Logger & logger) override;
+  auto recycle() -> bool override;
   const std::string & getCurrentAction() const override;
 
   auto getBehaviorParameter() -> traffic_simulator_msgs::msg::BehaviorParameter override;
@@ -55,33 +58,43 @@ public:
   }
 
   // clang-format off
-  DEFINE_GETTER_SETTER(CanonicalizedEntityStatus,                        std::shared_ptr<traffic_simulator::CanonicalizedEntityStatus>)
-  DEFINE_GETTER_SETTER(CurrentTime,                                      double)
   DEFINE_GETTER_SETTER(DebugMarker,                                      std::vector<visualization_msgs::msg::Marker>)
-  DEFINE_GETTER_SETTER(DefaultMatchingDistanceForLaneletPoseCalculation, double)
   DEFINE_GETTER_SETTER(GoalPoses,                                        std::vector<geometry_msgs::msg::Pose>)
-  DEFINE_GETTER_SETTER(HdMapUtils,                                       std::shared_ptr<hdmap_utils::HdMapUtils>)
   DEFINE_GETTER_SETTER(LaneChangeParameters,                             traffic_simulator::lane_change::Parameter)
   DEFINE_GETTER_SETTER(Obstacle,                                         std::optional<traffic_simulator_msgs::msg::Obstacle>)
-  DEFINE_GETTER_SETTER(OtherEntityStatus,                                EntityStatusDict)
   DEFINE_GETTER_SETTER(PedestrianParameters,                             traffic_simulator_msgs::msg::PedestrianParameters)
   DEFINE_GETTER_SETTER(PolylineTrajectory,                               std::shared_ptr<traffic_simulator_msgs::msg::PolylineTrajectory>)
   DEFINE_GETTER_SETTER(ReferenceTrajectory,                              std::shared_ptr<math::geometry::CatmullRomSpline>)
-  DEFINE_GETTER_SETTER(Request,                                          traffic_simulator::behavior::Request)
-  DEFINE_GETTER_SETTER(RouteLanelets,                                    lanelet::Ids)
-  DEFINE_GETTER_SETTER(StepTime,                                         double)
-  DEFINE_GETTER_SETTER(TargetSpeed,                                      std::optional<double>)
-  DEFINE_GETTER_SETTER(TrafficLightManager,                              std::shared_ptr<traffic_simulator::TrafficLightManager>)
   DEFINE_GETTER_SETTER(VehicleParameters,                                traffic_simulator_msgs::msg::VehicleParameters)
   DEFINE_GETTER_SETTER(Waypoints,                                        traffic_simulator_msgs::msg::WaypointsArray)
   // clang-format on
 #undef DEFINE_GETTER_SETTER
 
+#define DEFINE_CONTEXT_GETTER_SETTER(NAME, TYPE, MEMBER)                    \
+  TYPE get##NAME() override { return context_->MEMBER; }                    \
+  void set##NAME(const TYPE & value) override { context_->MEMBER = value; }
+
+  // clang-format off
+  DEFINE_CONTEXT_GETTER_SETTER(CanonicalizedEntityStatus,                        std::shared_ptr<traffic_simulator::CanonicalizedEntityStatus>, canonicalized_entity_status)
+  DEFINE_CONTEXT_GETTER_SETTER(CurrentTime,                                      double, current_time)
+  DEFINE_CONTEXT_GETTER_SETTER(DefaultMatchingDistanceForLaneletPoseCalculation, double, default_matching_distance_for_lanelet_pose_calculation)
+  DEFINE_CONTEXT_GETTER_SETTER(HdMapUtils,                                       std::shared_ptr<hdmap_utils::HdMapUtils>, hdmap_utils)
+  DEFINE_CONTEXT_GETTER_SETTER(OtherEntityStatus,                                EntityStatusDict, other_entity_status)
+  DEFINE_CONTEXT_GETTER_SETTER(Request,                                          traffic_simulator::behavior::Request, request)
+  DEFINE_CONTEXT_GETTER_SETTER(RouteLanelets,                                    lanelet::Ids, route_lanelets)
+  DEFINE_CONTEXT_GETTER_SETTER(StepTime,                                         double, step_time)
+  DEFINE_CONTEXT_GETTER_SETTER(TargetSpeed,                                      std::optional<double>, target_speed)
+  DEFINE_CONTEXT_GETTER_SETTER(TrafficLightManager,                              std::shared_ptr<traffic_simulator::TrafficLightManager>, traffic_light_manager)
+  // clang-format on
+#undef DEFINE_CONTEXT_GETTER_SETTER
+
 private:
   auto tickOnce(const double current_time, const double step_time) -> BT::NodeStatus;
   auto createBehaviorTree(const std::string & format_path) -> BT::Tree;
   BT::BehaviorTreeFactory factory_;
   BT::Tree tree_;
+  const std::shared_ptr<ActionNodeContext> context_ = std::make_shared<ActionNodeContext>();
+  behavior_tree_plugin::WakeUpCondition wake_up_condition_;
   std::unique_ptr<behavior_tree_plugin::LoggingEvent> logging_event_ptr_;
   std::unique_ptr<behavior_tree_plugin::ResetRequestEvent> reset_request_event_ptr_;
 };
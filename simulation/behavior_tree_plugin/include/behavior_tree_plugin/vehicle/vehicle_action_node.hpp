@@ -53,7 +53,8 @@ public:
     }
     return ports;
   }
-  auto calculateUpdatedEntityStatus(double target_speed) const -> traffic_simulator::EntityStatus;
+  auto calculateUpdatedEntityStatus(double target_speed) const
+    -> traffic_simulator::CanonicalizedEntityStatus;
   auto calculateUpdatedEntityStatusInWorldFrame(double target_speed) const
     -> traffic_simulator::EntityStatus;
   virtual const traffic_simulator_msgs::msg::WaypointsArray calculateWaypoints() = 0;
@@ -0,0 +1,84 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef BEHAVIOR_TREE_PLUGIN__WAKE_UP_CONDITION_HPP_
+#define BEHAVIOR_TREE_PLUGIN__WAKE_UP_CONDITION_HPP_
+
+#include <behavior_tree_plugin/action_node_context.hpp>
+#include <geometry_msgs/msg/point.hpp>
+#include <optional>
+#include <string>
+#include <traffic_simulator/traffic_lights/traffic_light.hpp>
+#include <traffic_simulator_msgs/msg/behavior_parameter.hpp>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace behavior_tree_plugin
+{
+/**
+ * @brief Conditions under which a waiting entity has to tick its behavior tree again.
+ * @note It is armed after a tick which left the entity standing still in an action that only
+ * waits for its surroundings. Until it fires, a tick would take the same decision again, so the
+ * behavior tree only advances the time of the entity. It fires when the request, the target
+ * speed, the route or the behavior parameter change, when a traffic light on the route changes,
+ * when an entity near the entity or on a lanelet the route depends on appears, disappears or
+ * moves, and when the timer expires.
+ */
+class WakeUpCondition
+{
+public:
+  auto arm(
+    const entity_behavior::ActionNodeContext & context,
+    const traffic_simulator_msgs::msg::BehaviorParameter & behavior_parameter) -> void;
+
+  auto disarm() -> void { armed_.reset(); }
+
+  auto isArmed() const -> bool { return armed_.has_value(); }
+
+  auto fired(
+    const entity_behavior::ActionNodeContext & context,
+    const traffic_simulator_msgs::msg::BehaviorParameter & behavior_parameter) const -> bool;
+
+  /// @return true if the action keeps the entity in place only until its surroundings change.
+  static auto isWaitingAction(const std::string & action) -> bool;
+
+private:
+  struct Snapshot
+  {
+    traffic_simulator::behavior::Request request;
+    std::optional<double> target_speed;
+    lanelet::Ids route_lanelets;
+    traffic_simulator_msgs::msg::BehaviorParameter behavior_parameter;
+    geometry_msgs::msg::Point position;
+    std::vector<traffic_simulator::TrafficLight::Bulb::Hash> traffic_lights;
+    /// @note Sorted by name.
+    std::vector<std::pair<std::string, geometry_msgs::msg::Point>> entities;
+  };
+
+  auto takeSnapshot(
+    const entity_behavior::ActionNodeContext & context,
+    const traffic_simulator_msgs::msg::BehaviorParameter & behavior_parameter) const -> Snapshot;
+
+  std::optional<Snapshot> armed_;
+
+  double wake_up_time_ = 0.0;
+
+  lanelet::Ids traffic_light_ids_;
+
+  std::unordered_set<lanelet::Id> watched_lanelet_ids_;
+};
+}  // namespace behavior_tree_plugin
+
+#endif  // BEHAVIOR_TREE_PLUGIN__WAKE_UP_CONDITION_HPP_
@@ -14,11 +14,13 @@
 
 #include <algorithm>
 #include <behavior_tree_plugin/action_node.hpp>
+#include <cmath>
 #include <geometry/bounding_box.hpp>
 #include <geometry/quaternion/euler_to_quaternion.hpp>
 #include <geometry/quaternion/get_rotation.hpp>
 #include <geometry/quaternion/get_rotation_matrix.hpp>
 #include <geometry/quaternion/quaternion_to_euler.hpp>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <rclcpp/rclcpp.hpp>
@@ -42,44 +44,22 @@ auto ActionNode::executeTick() -> BT::NodeStatus { return BT::ActionNodeBase::ex
 
 auto ActionNode::getBlackBoardValues() -> void
 {
-  if (!getInput<traffic_simulator::behavior::Request>("request", request)) {
-    THROW_SIMULATION_ERROR("failed to get input request in ActionNode");
-  }
-  if (!getInput<double>("step_time", step_time)) {
-    THROW_SIMULATION_ERROR("failed to get input step_time in ActionNode");
-  }
-  if (!getInput<double>("current_time", current_time)) {
-    THROW_SIMULATION_ERROR("failed to get input current_time in ActionNode");
-  }
-  if (!getInput<std::shared_ptr<hdmap_utils::HdMapUtils>>("hdmap_utils", hdmap_utils)) {
-    THROW_SIMULATION_ERROR("failed to get input hdmap_utils in ActionNode");
-  }
-  if (!getInput<std::shared_ptr<traffic_simulator::TrafficLightManager>>(
-        "traffic_light_manager", traffic_light_manager)) {
-    THROW_SIMULATION_ERROR("failed to get input traffic_light_manager in ActionNode");
-  }
-  if (!getInput<std::shared_ptr<traffic_simulator::CanonicalizedEntityStatus>>(
-        "canonicalized_entity_status", canonicalized_entity_status)) {
-    THROW_SIMULATION_ERROR("failed to get input canonicalized_entity_status in ActionNode");
-  }
-
-  if (!getInput<std::optional<double>>("target_speed", target_speed)) {
-    target_speed = std::nullopt;
-  }
-
-  if (!getInput<double>(
-        "matching_distance_for_lanelet_pose_calculation",
-        default_matching_distance_for_lanelet_pose_calculation)) {
-    THROW_SIMULATION_ERROR(
-      "failed to get input matching_distance_for_lanelet_pose_calculation in ActionNode");
-  }
-
-  if (!getInput<EntityStatusDict>("other_entity_status", other_entity_status)) {
-    THROW_SIMULATION_ERROR("failed to get input other_entity_status in ActionNode");
-  }
-  if (!getInput<lanelet::Ids>("route_lanelets", route_lanelets)) {
-    THROW_SIMULATION_ERROR("failed to get input route_lanelets in ActionNode");
-  }
+  std::shared_ptr<ActionNodeContext> action_node_context;
+  if (
+    !getInput<std::shared_ptr<ActionNodeContext>>(ActionNodeContext::key(), action_node_context) or
+    !action_node_context) {
+    THROW_SIMULATION_ERROR("failed to get input ", ActionNodeContext::key(), " in ActionNode");
+  }
+  context = action_node_context;
+  request = context->request;
+  step_time = context->step_time;
+  current_time = context->current_time;
+  hdmap_utils = context->hdmap_utils;
+  traffic_light_manager = context->traffic_light_manager;
+  canonicalized_entity_status = context->canonicalized_entity_status;
+  target_speed = context->target_speed;
+  default_matching_distance_for_lanelet_pose_calculation =
+    context->default_matching_distance_for_lanelet_pose_calculation;
 }
 
 auto ActionNode::getHorizon() const -> double
@@ -99,18 +79,35 @@ auto ActionNode::setCanonicalizedEntityStatus(const traffic_simulator::EntitySta
 {
   canonicalized_entity_status->set(
     entity_status, default_matching_distance_for_lanelet_pose_calculation, hdmap_utils);
+  context->perception_cache = PerceptionCache();
+}
+
+auto ActionNode::setCanonicalizedEntityStatus(
+  const traffic_simulator::CanonicalizedEntityStatus & canonicalized_entity_status) -> void
+{
+  this->canonicalized_entity_status->set(canonicalized_entity_status);
+  context->perception_cache = PerceptionCache();
 }
 
 auto ActionNode::getOtherEntityStatus(lanelet::Id lanelet_id) const
   -> std::vector<traffic_simulator::CanonicalizedEntityStatus>
 {
   std::vector<traffic_simulator::CanonicalizedEntityStatus> ret;
-  for (const auto & status : other_entity_status) {
-    if (
-      status.second.laneMatchingSucceed() &&
-      traffic_simulator::isSameLaneletId(status.second, lanelet_id)) {
-      ret.emplace_back(status.second);
-    }
+  context->other_entity_status.forEachOnLanelet(
+    lanelet_id, [&](const auto & status) { ret.emplace_back(status.second); });
+  return ret;
+}
+
+auto ActionNode::getOtherEntityStatus(lanelet::Ids lanelet_ids) const
+  -> std::vector<traffic_simulator::CanonicalizedEntityStatus>
+{
+  /// @note Each entity is on a single lanelet, so it is listed once if the ids are unique.
+  std::sort(lanelet_ids.begin(), lanelet_ids.end());
+  lanelet_ids.erase(std::unique(lanelet_ids.begin(), lanelet_ids.end()), lanelet_ids.end());
+  std::vector<traffic_simulator::CanonicalizedEntityStatus> ret;
+  for (const auto lanelet_id : lanelet_ids) {
+    context->other_entity_status.forEachOnLanelet(
+      lanelet_id, [&](const auto & status) { ret.emplace_back(status.second); });
   }
   return ret;
 }
@@ -145,6 +142,13 @@ auto ActionNode::getYieldStopDistance(const lanelet::Ids & following_lanelets) c
 
 auto ActionNode::getRightOfWayEntities(const lanelet::Ids & following_lanelets) const
   -> std::vector<traffic_simulator::CanonicalizedEntityStatus>
+{
+  return context->perception_cache.right_of_way_entities.get(
+    following_lanelets, [&]() { return calculateRightOfWayEntities(following_lanelets); });
+}
+
+auto ActionNode::calculateRightOfWayEntities(const lanelet::Ids & following_lanelets) const
+  -> std::vector<traffic_simulator::CanonicalizedEntityStatus>
 {
   auto is_the_same_right_of_way =
     [&](const std::int64_t & lanelet_id, const std::int64_t & following_lanelet) {
@@ -156,7 +160,7 @@ auto ActionNode::getRightOfWayEntities(const lanelet::Ids & following_lanelets)
 
   std::vector<traffic_simulator::CanonicalizedEntityStatus> ret;
   const auto lanelet_ids_list = hdmap_utils->getRightOfWayLaneletIds(following_lanelets);
-  for (const auto & status : other_entity_status) {
+  for (const auto & status : context->other_entity_status) {
     for (const auto & following_lanelet : following_lanelets) {
       for (const lanelet::Id & lanelet_id : lanelet_ids_list.at(following_lanelet)) {
         if (
@@ -183,7 +187,7 @@ auto ActionNode::getRightOfWayEntities() const
   if (lanelet_ids.empty()) {
     return ret;
   }
-  for (const auto & status : other_entity_status) {
+  for (const auto & status : context->other_entity_status) {
     for (const lanelet::Id & lanelet_id : lanelet_ids) {
       if (
         status.second.laneMatchingSucceed() &&
@@ -198,6 +202,15 @@ auto ActionNode::getRightOfWayEntities() const
 auto ActionNode::getDistanceToTrafficLightStopLine(
   const lanelet::Ids & route_lanelets,
   const math::geometry::CatmullRomSplineInterface & spline) const -> std::optional<double>
+{
+  return context->perception_cache.distance_to_traffic_light_stop_line.get(
+    {route_lanelets, spline.getLength()},
+    [&]() { return calculateDistanceToTrafficLightStopLine(route_lanelets, spline); });
+}
+
+auto ActionNode::calculateDistanceToTrafficLightStopLine(
+  const lanelet::Ids & route_lanelets,
+  const math::geometry::CatmullRomSplineInterface & spline) const -> std::optional<double>
 {
   const auto traffic_light_ids = hdmap_utils->getTrafficLightIdsOnPath(route_lanelets);
   if (traffic_light_ids.empty()) {
@@ -230,34 +243,78 @@ auto ActionNode::getDistanceToStopLine(
   return hdmap_utils->getDistanceToStopLine(route_lanelets, waypoints);
 }
 
+auto ActionNode::getDistanceToStopLine(
+  const lanelet::Ids & route_lanelets,
+  const math::geometry::CatmullRomSplineInterface & spline) const -> std::optional<double>
+{
+  return context->perception_cache.distance_to_stop_line.get(
+    {route_lanelets, spline.getLength()},
+    [&]() { return hdmap_utils->getDistanceToStopLine(route_lanelets, spline); });
+}
+
 auto ActionNode::getDistanceToFrontEntity(
   const math::geometry::CatmullRomSplineInterface & spline) const -> std::optional<double>
 {
-  auto name = getFrontEntityName(spline);
-  if (!name) {
-    return std::nullopt;
-  }
-  return getDistanceToTargetEntityPolygon(spline, name.value());
+  return context->perception_cache.distance_to_front_entity.get(
+    spline.getLength(), [&]() -> std::optional<double> {
+      if (const auto name = getFrontEntityName(spline)) {
+        return getDistanceToTargetEntityPolygon(spline, name.value());
+      } else {
+        return std::nullopt;
+      }
+    });
 }
 
 auto ActionNode::getFrontEntityName(const math::geometry::CatmullRomSplineInterface & spline) const
   -> std::optional<std::string>
 {
+  return context->perception_cache.front_entity_name.get(
+    spline.getLength(), [&]() { return calculateFrontEntityName(spline); });
+}
+
+auto ActionNode::calculateFrontEntityName(
+  const math::geometry::CatmullRomSplineInterface & spline) const -> std::optional<std::string>
+{
+  /// @note Hard coded parameter, entities touching the spline farther than this are ignored.
+  constexpr double front_entity_distance_threshold = 40.0;
+  /*
+     The spline starts at the lanelet pose of the entity, so a point of the spline within the
+     threshold is within threshold + |offset| of the entity. It is used as a bounding circle test
+     so that the spline collision only runs on the entities which can touch that part of it.
+  */
+  const auto & map_position = canonicalized_entity_status->getMapPose().position;
+  const auto search_radius =
+    std::min(front_entity_distance_threshold, spline.getLength()) +
+    (canonicalized_entity_status->laneMatchingSucceed()
+       ? std::abs(canonicalized_entity_status->getLaneletPose().offset)
+       : std::numeric_limits<double>::infinity());
+  auto is_in_search_radius = [&](const traffic_simulator::CanonicalizedEntityStatus & status) {
+    const auto & bounding_box = status.getBoundingBox();
+    const auto & position = status.getMapPose().position;
+    const auto circumradius = std::hypot(
+      bounding_box.dimensions.x * 0.5 + std::abs(bounding_box.center.x),
+      bounding_box.dimensions.y * 0.5 + std::abs(bounding_box.center.y));
+    return std::hypot(position.x - map_position.x, position.y - map_position.y) <=
+           search_radius + circumradius;
+  };
+
   std::vector<double> distances;
   std::vector<std::string> entities;
-  for (const auto & each : other_entity_status) {
-    const auto distance = getDistanceToTargetEntityPolygon(spline, each.first);
+  for (const auto & [name, status] : context->other_entity_status) {
+    if (not status.laneMatchingSucceed() or not is_in_search_radius(status)) {
+      continue;
+    }
     const auto quat = math::geometry::getRotation(
-      canonicalized_entity_status->getMapPose().orientation,
-      other_entity_status.at(each.first).getMapPose().orientation);
+      canonicalized_entity_status->getMapPose().orientation, status.getMapPose().orientation);
     /**
      * @note hard-coded parameter, if the Yaw value of RPY is in ~1.5708 -> 1.5708, entity is a candidate of front entity.
      */
     if (
       std::fabs(math::geometry::convertQuaternionToEulerAngle(quat).z) <=
       boost::math::constants::half_pi<double>()) {
-      if (distance && distance.value() < 40) {
-        entities.emplace_back(each.first);
+      const auto distance = getDistanceToTargetEntityPolygon(spline, status);
+      if (distance && distance.value() < front_entity_distance_threshold) {
+        entities.emplace_back(name);
         distances.emplace_back(distance.value());
       }
     }
@@ -287,7 +344,8 @@ auto ActionNode::getDistanceToTargetEntityOnCrosswalk(
 auto ActionNode::getEntityStatus(const std::string & target_name) const
   -> const traffic_simulator::CanonicalizedEntityStatus &
 {
-  if (auto it = other_entity_status.find(target_name); it != other_entity_status.end()) {
+  if (auto it = context->other_entity_status.find(target_name);
+      it != context->other_entity_status.end()) {
     return it->second;
   } else {
     THROW_SEMANTIC_ERROR("other entity : ", target_name, " does not exist.");
@@ -327,6 +385,15 @@ auto ActionNode::getDistanceToTargetEntityPolygon(
 auto ActionNode::getDistanceToConflictingEntity(
   const lanelet::Ids & route_lanelets,
   const math::geometry::CatmullRomSplineInterface & spline) const -> std::optional<double>
+{
+  return context->perception_cache.distance_to_conflicting_entity.get(
+    {route_lanelets, spline.getLength()},
+    [&]() { return calculateDistanceToConflictingEntity(route_lanelets, spline); });
+}
+
+auto ActionNode::calculateDistanceToConflictingEntity(
+  const lanelet::Ids & route_lanelets,
+  const math::geometry::CatmullRomSplineInterface & spline) const -> std::optional<double>
 {
   auto crosswalk_entity_status = getConflictingEntityStatusOnCrossWalk(route_lanelets);
   auto lane_entity_status = getConflictingEntityStatusOnLane(route_lanelets);
@@ -352,41 +419,20 @@ auto ActionNode::getDistanceToConflictingEntity(
 auto ActionNode::getConflictingEntityStatusOnCrossWalk(const lanelet::Ids & route_lanelets) const
   -> std::vector<traffic_simulator::CanonicalizedEntityStatus>
 {
-  std::vector<traffic_simulator::CanonicalizedEntityStatus> conflicting_entity_status;
-  auto conflicting_crosswalks = hdmap_utils->getConflictingCrosswalkIds(route_lanelets);
-  for (const auto & status : other_entity_status) {
-    if (
-      status.second.laneMatchingSucceed() &&
-      std::count(
-        conflicting_crosswalks.begin(), conflicting_crosswalks.end(),
-        status.second.getLaneletId()) >= 1) {
-      conflicting_entity_status.emplace_back(status.second);
-    }
-  }
-  return conflicting_entity_status;
+  return getOtherEntityStatus(hdmap_utils->getConflictingCrosswalkIds(route_lanelets));
 }
 
 auto ActionNode::getConflictingEntityStatusOnLane(const lanelet::Ids & route_lanelets) const
   -> std::vector<traffic_simulator::CanonicalizedEntityStatus>
 {
-  std::vector<traffic_simulator::CanonicalizedEntityStatus> conflicting_entity_status;
-  auto conflicting_lanes = hdmap_utils->getConflictingLaneIds(route_lanelets);
-  for (const auto & status : other_entity_status) {
-    if (
-      status.second.laneMatchingSucceed() &&
-      std::count(
-        conflicting_lanes.begin(), conflicting_lanes.end(), status.second.getLaneletId()) >= 1) {
-      conflicting_entity_status.emplace_back(status.second);
-    }
-  }
-  return conflicting_entity_status;
+  return getOtherEntityStatus(hdmap_utils->getConflictingLaneIds(route_lanelets));
 }
 
 auto ActionNode::foundConflictingEntity(const lanelet::Ids & following_lanelets) const -> bool
 {
   auto conflicting_crosswalks = hdmap_utils->getConflictingCrosswalkIds(following_lanelets);
   auto conflicting_lanes = hdmap_utils->getConflictingLaneIds(following_lanelets);
-  for (const auto & status : other_entity_status) {
+  for (const auto & status : context->other_entity_status) {
     if (
       status.second.laneMatchingSucceed() &&
       std::count(
@@ -422,12 +468,36 @@ auto ActionNode::calculateUpdatedEntityStatus(
   if (!canonicalized_entity_status->laneMatchingSucceed()) {
     THROW_SIMULATION_ERROR(
       "Entity ", canonicalized_entity_status->getName(), " is not matched to the lanelet.");
+  } else if (
+    const auto moved_lanelet_pose =
+      canonicalized_entity_status->getCanonicalizedLaneletPose()->moveAlongLanelet(
+        (twist_new.linear.x + canonicalized_entity_status->getTwist().linear.x) / 2.0 * step_time,
+        hdmap_utils)) {
+    /*
+       Most of the steps end on the lanelet they started from. The moved pose is canonical already,
+       so neither the route is searched nor the status is matched to the lanelets again.
+    */
+    auto entity_status_updated =
+      static_cast<traffic_simulator::EntityStatus>(*canonicalized_entity_status);
+    {
+      entity_status_updated.time = current_time + step_time;
+      entity_status_updated.lanelet_pose =
+        static_cast<traffic_simulator::LaneletPose>(moved_lanelet_pose.value());
+      entity_status_updated.lanelet_pose_valid = true;
+      entity_status_updated.action_status.twist = twist_new;
+      entity_status_updated.action_status.accel = accel_new;
+      entity_status_updated.action_status.linear_jerk = linear_jerk_new;
+      entity_status_updated.pose =
+        static_cast<geometry_msgs::msg::Pose>(moved_lanelet_pose.value());
+    }
+    return traffic_simulator::CanonicalizedEntityStatus(entity_status_updated, moved_lanelet_pose);
   } else {
     auto lanelet_pose = canonicalized_entity_status->getLaneletPose();
     lanelet_pose.s =
       lanelet_pose.s +
       (twist_new.linear.x + canonicalized_entity_status->getTwist().linear.x) / 2.0 * step_time;
-    const auto canonicalized = hdmap_utils->canonicalizeLaneletPose(lanelet_pose, route_lanelets);
+    const auto canonicalized =
+      hdmap_utils->canonicalizeLaneletPose(lanelet_pose, context->route_lanelets);
     if (
       const auto canonicalized_lanelet_pose =
         std::get<std::optional<traffic_simulator::LaneletPose>>(canonicalized)) {
@@ -444,7 +514,9 @@ auto ActionNode::calculateUpdatedEntityStatus(
         entity_status_updated.pose =
           hdmap_utils->toMapPose(canonicalized_lanelet_pose.value()).pose;
       }
-      return entity_status_updated;
+      return traffic_simulator::CanonicalizedEntityStatus(
+        entity_status_updated,
+        traffic_simulator::pose::canonicalize(canonicalized_lanelet_pose.value(), hdmap_utils));
     } else {
       // If canonicalize failed, set end of road lanelet pose.
       if (const auto end_of_road_lanelet_id = std::get<std::optional<lanelet::Id>>(canonicalized)) {
@@ -467,7 +539,9 @@ auto ActionNode::calculateUpdatedEntityStatus(
             entity_status_updated.action_status.linear_jerk = linear_jerk_new;
             entity_status_updated.pose = hdmap_utils->toMapPose(end_of_road_lanelet_pose).pose;
           }
-          return entity_status_updated;
+          return traffic_simulator::CanonicalizedEntityStatus(
+            entity_status_updated,
+            traffic_simulator::pose::canonicalize(end_of_road_lanelet_pose, hdmap_utils));
         } else {
           traffic_simulator::LaneletPose end_of_road_lanelet_pose;
           {
@@ -488,7 +562,9 @@ auto ActionNode::calculateUpdatedEntityStatus(
             entity_status_updated.action_status.linear_jerk = linear_jerk_new;
             entity_status_updated.pose = hdmap_utils->toMapPose(end_of_road_lanelet_pose).pose;
           }
-          return entity_status_updated;
+          return traffic_simulator::CanonicalizedEntityStatus(
+            entity_status_updated,
+            traffic_simulator::pose::canonicalize(end_of_road_lanelet_pose, hdmap_utils));
         }
       } else {
         THROW_SIMULATION_ERROR("Failed to find trailing lanelet_id.");
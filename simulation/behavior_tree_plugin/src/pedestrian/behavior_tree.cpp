@@ -18,22 +18,31 @@
 #include <behavior_tree_plugin/pedestrian/follow_trajectory_sequence/follow_polyline_trajectory_action.hpp>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <pugixml.hpp>
 #include <string>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace entity_behavior
 {
 void PedestrianBehaviorTree::configure(const rclcpp::Logger & logger)
 {
-  namespace pedestrian = entity_behavior::pedestrian;
-  factory_.registerNodeType<pedestrian::FollowLaneAction>("FollowLane");
-  factory_.registerNodeType<pedestrian::WalkStraightAction>("WalkStraightAction");
-  factory_.registerNodeType<pedestrian::FollowPolylineTrajectoryAction>("FollowPolylineTrajectory");
-
-  auto base_path = ament_index_cpp::get_package_share_directory("behavior_tree_plugin");
-  auto format_path = base_path + "/config/pedestrian_entity_behavior.xml";
-  tree_ = createBehaviorTree(format_path);
+  /// @note A recycled plugin keeps its tree, only the events are bound to the new logger.
+  if (not tree_.rootNode()) {
+    namespace pedestrian = entity_behavior::pedestrian;
+    factory_.registerNodeType<pedestrian::FollowLaneAction>("FollowLane");
+    factory_.registerNodeType<pedestrian::WalkStraightAction>("WalkStraightAction");
+    factory_.registerNodeType<pedestrian::FollowPolylineTrajectoryAction>(
+      "FollowPolylineTrajectory");
+
+    auto base_path = ament_index_cpp::get_package_share_directory("behavior_tree_plugin");
+    auto format_path = base_path + "/config/pedestrian_entity_behavior.xml";
+    tree_ = createBehaviorTree(format_path);
+  }
+  tree_.rootBlackboard()->set<std::shared_ptr<ActionNodeContext>>(
+    ActionNodeContext::key(), context_);
   logging_event_ptr_ =
     std::make_unique<behavior_tree_plugin::LoggingEvent>(tree_.rootNode(), logger);
   reset_request_event_ptr_ = std::make_unique<behavior_tree_plugin::ResetRequestEvent>(
@@ -42,40 +51,61 @@ void PedestrianBehaviorTree::configure(const rclcpp::Logger & logger)
   setRequest(traffic_simulator::behavior::Request::NONE);
 }
 
+auto PedestrianBehaviorTree::recycle() -> bool
+{
+  tree_.haltTree();
+  tree_.rootBlackboard()->clear();
+  *context_ = ActionNodeContext();
+  return true;
+}
+
 auto PedestrianBehaviorTree::createBehaviorTree(const std::string & format_path) -> BT::Tree
 {
-  auto xml_doc = pugi::xml_document();
-  xml_doc.load_file(format_path.c_str());
+  /*
+     The expanded tree only depends on the file and on the node types, which every instance
+     registers identically, so it is built once per process and every entity spawned afterwards
+     only instantiates its nodes from it.
+  */
+  static std::mutex mutex;
+  static std::unordered_map<std::string, std::string> xml_texts;
 
-  class XMLTreeWalker : public pugi::xml_tree_walker
-  {
-  public:
-    explicit XMLTreeWalker(const BT::TreeNodeManifest & manifest) : manifest_(manifest) {}
+  std::lock_guard<std::mutex> lock(mutex);
+  auto iter = xml_texts.find(format_path);
+  if (iter == xml_texts.end()) {
+    auto xml_doc = pugi::xml_document();
+    xml_doc.load_file(format_path.c_str());
 
-  private:
-    bool for_each(pugi::xml_node & node) final
+    class XMLTreeWalker : public pugi::xml_tree_walker
     {
-      if (node.name() == manifest_.registration_ID) {
-        for (const auto & [port, info] : manifest_.ports) {
-          node.append_attribute(port.c_str()) = std::string("{" + port + "}").c_str();
+    public:
+      explicit XMLTreeWalker(const BT::TreeNodeManifest & manifest) : manifest_(manifest) {}
+
+    private:
+      bool for_each(pugi::xml_node & node) final
+      {
+        if (node.name() == manifest_.registration_ID) {
+          for (const auto & [port, info] : manifest_.ports) {
+            node.append_attribute(port.c_str()) = std::string("{" + port + "}").c_str();
+          }
         }
+        return true;
       }
-      return true;
-    }
 
-    const BT::TreeNodeManifest & manifest_;
-  };
+      const BT::TreeNodeManifest & manifest_;
+    };
 
-  for (const auto & [id, manifest] : factory_.manifests()) {
-    if (factory_.builtinNodes().count(id) == 0) {
-      auto walker = XMLTreeWalker(manifest);
-      xml_doc.traverse(walker);
+    for (const auto & [id, manifest] : factory_.manifests()) {
+      if (factory_.builtinNodes().count(id) == 0) {
+        auto walker = XMLTreeWalker(manifest);
+        xml_doc.traverse(walker);
+      }
     }
-  }
 
-  auto xml_str = std::stringstream();
-  xml_doc.save(xml_str);
-  return factory_.createTreeFromText(xml_str.str());
+    auto xml_str = std::stringstream();
+    xml_doc.save(xml_str);
+    iter = xml_texts.emplace(format_path, xml_str.str()).first;
+  }
+  return factory_.createTreeFromText(iter->second);
 }
 
 const std::string & PedestrianBehaviorTree::getCurrentAction() const
@@ -91,11 +121,22 @@ auto PedestrianBehaviorTree::update(const double current_time, const double step
   }
 }
 
+auto PedestrianBehaviorTree::updateAll(
+  const std::vector<BehaviorPluginBase *> & plugins, const double current_time,
+  const double step_time) -> void
+{
+  for (const auto plugin : plugins) {
+    static_cast<PedestrianBehaviorTree *>(plugin)->PedestrianBehaviorTree::update(
+      current_time, step_time);
+  }
+}
+
 auto PedestrianBehaviorTree::tickOnce(const double current_time, const double step_time)
   -> BT::NodeStatus
 {
   setCurrentTime(current_time);
   setStepTime(step_time);
+  context_->perception_cache = PerceptionCache();
   return tree_.rootNode()->executeTick();
 }
 }  // namespace entity_behavior
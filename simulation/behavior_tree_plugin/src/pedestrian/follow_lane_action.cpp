@@ -17,6 +17,7 @@
 #include <iostream>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace entity_behavior
@@ -42,10 +43,14 @@ BT::NodeStatus FollowLaneAction::tick()
     stopEntity();
     return BT::NodeStatus::RUNNING;
   }
-  auto following_lanelets =
-    hdmap_utils->getFollowingLanelets(canonicalized_entity_status->getLaneletId());
   if (!target_speed) {
-    target_speed = hdmap_utils->getSpeedLimit(following_lanelets);
+    /// @note The following lanelets only change with the lanelet, so the speed limit is reused.
+    if (const auto lanelet_id = canonicalized_entity_status->getLaneletId();
+        not speed_limit_ or speed_limit_->first != lanelet_id) {
+      speed_limit_ = std::make_pair(
+        lanelet_id, hdmap_utils->getSpeedLimit(hdmap_utils->getFollowingLanelets(lanelet_id)));
+    }
+    target_speed = speed_limit_->second;
   }
   setCanonicalizedEntityStatus(calculateUpdatedEntityStatus(target_speed.value()));
   return BT::NodeStatus::RUNNING;
@@ -25,32 +25,41 @@
 #include <behavior_tree_plugin/vehicle/follow_trajectory_sequence/follow_polyline_trajectory_action.hpp>
 #include <behavior_tree_plugin/vehicle/lane_change_action.hpp>
 #include <iostream>
+#include <mutex>
 #include <pugixml.hpp>
 #include <sstream>
 #include <string>
 #include <traffic_simulator_msgs/msg/behavior_parameter.hpp>
+#include <unordered_map>
 #include <utility>
 
 namespace entity_behavior
 {
 void VehicleBehaviorTree::configure(const rclcpp::Logger & logger)
 {
-  factory_.registerNodeType<vehicle::follow_lane_sequence::FollowLaneAction>("FollowLane");
-  factory_.registerNodeType<vehicle::follow_lane_sequence::FollowFrontEntityAction>(
-    "FollowFrontEntity");
-  factory_.registerNodeType<vehicle::follow_lane_sequence::StopAtCrossingEntityAction>(
-    "StopAtCrossingEntity");
-  factory_.registerNodeType<vehicle::follow_lane_sequence::StopAtStopLineAction>("StopAtStopLine");
-  factory_.registerNodeType<vehicle::follow_lane_sequence::StopAtTrafficLightAction>(
-    "StopAtTrafficLight");
-  factory_.registerNodeType<vehicle::follow_lane_sequence::YieldAction>("Yield");
-  factory_.registerNodeType<vehicle::follow_lane_sequence::MoveBackwardAction>("MoveBackward");
-  factory_.registerNodeType<vehicle::FollowPolylineTrajectoryAction>("FollowPolylineTrajectory");
-  factory_.registerNodeType<vehicle::LaneChangeAction>("LaneChange");
-
-  tree_ = createBehaviorTree(
-    ament_index_cpp::get_package_share_directory("behavior_tree_plugin") +
-    "/config/vehicle_entity_behavior.xml");
+  /// @note A recycled plugin keeps its tree, only the events are bound to the new logger.
+  if (not tree_.rootNode()) {
+    factory_.registerNodeType<vehicle::follow_lane_sequence::FollowLaneAction>("FollowLane");
+    factory_.registerNodeType<vehicle::follow_lane_sequence::FollowFrontEntityAction>(
+      "FollowFrontEntity");
+    factory_.registerNodeType<vehicle::follow_lane_sequence::StopAtCrossingEntityAction>(
+      "StopAtCrossingEntity");
+    factory_.registerNodeType<vehicle::follow_lane_sequence::StopAtStopLineAction>(
+      "StopAtStopLine");
+    factory_.registerNodeType<vehicle::follow_lane_sequence::StopAtTrafficLightAction>(
+      "StopAtTrafficLight");
+    factory_.registerNodeType<vehicle::follow_lane_sequence::YieldAction>("Yield");
+    factory_.registerNodeType<vehicle::follow_lane_sequence::MoveBackwardAction>("MoveBackward");
+    factory_.registerNodeType<vehicle::FollowPolylineTrajectoryAction>("FollowPolylineTrajectory");
+    factory_.registerNodeType<vehicle::LaneChangeAction>("LaneChange");
+
+    tree_ = createBehaviorTree(
+      ament_index_cpp::get_package_share_directory("behavior_tree_plugin") +
+      "/config/vehicle_entity_behavior.xml");
+  }
+
+  tree_.rootBlackboard()->set<std::shared_ptr<ActionNodeContext>>(
+    ActionNodeContext::key(), context_);
 
   logging_event_ptr_ =
     std::make_unique<behavior_tree_plugin::LoggingEvent>(tree_.rootNode(), logger);
@@ -62,40 +71,62 @@ void VehicleBehaviorTree::configure(const rclcpp::Logger & logger)
   setRequest(traffic_simulator::behavior::Request::NONE);
 }
 
-auto VehicleBehaviorTree::createBehaviorTree(const std::string & format_path) -> BT::Tree
+auto VehicleBehaviorTree::recycle() -> bool
 {
-  auto xml_doc = pugi::xml_document();
-  xml_doc.load_file(format_path.c_str());
-
-  class XMLTreeWalker : public pugi::xml_tree_walker
-  {
-  public:
-    explicit XMLTreeWalker(const BT::TreeNodeManifest & manifest) : manifest_(manifest) {}
+  tree_.haltTree();
+  tree_.rootBlackboard()->clear();
+  *context_ = ActionNodeContext();
+  wake_up_condition_.disarm();
+  return true;
+}
 
-  private:
-    bool for_each(pugi::xml_node & node) final
+auto VehicleBehaviorTree::createBehaviorTree(const std::string & format_path) -> BT::Tree
+{
+  /*
+     The expanded tree only depends on the file and on the node types, which every instance
+     registers identically, so it is built once per process and every entity spawned afterwards
+     only instantiates its nodes from it.
+  */
+  static std::mutex mutex;
+  static std::unordered_map<std::string, std::string> xml_texts;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto iter = xml_texts.find(format_path);
+  if (iter == xml_texts.end()) {
+    auto xml_doc = pugi::xml_document();
+    xml_doc.load_file(format_path.c_str());
+
+    class XMLTreeWalker : public pugi::xml_tree_walker
     {
-      if (node.name() == manifest_.registration_ID) {
-        for (const auto & [port, info] : manifest_.ports) {
-          node.append_attribute(port.c_str()) = std::string("{" + port + "}").c_str();
+    public:
+      explicit XMLTreeWalker(const BT::TreeNodeManifest & manifest) : manifest_(manifest) {}
+
+    private:
+      bool for_each(pugi::xml_node & node) final
+      {
+        if (node.name() == manifest_.registration_ID) {
+          for (const auto & [port, info] : manifest_.ports) {
+            node.append_attribute(port.c_str()) = std::string("{" + port + "}").c_str();
+          }
         }
+        return true;
       }
-      return true;
-    }
 
-    const BT::TreeNodeManifest & manifest_;
-  };
+      const BT::TreeNodeManifest & manifest_;
+    };
 
-  for (const auto & [id, manifest] : factory_.manifests()) {
-    if (factory_.builtinNodes().count(id) == 0) {
-      auto walker = XMLTreeWalker(manifest);
-      xml_doc.traverse(walker);
+    for (const auto & [id, manifest] : factory_.manifests()) {
+      if (factory_.builtinNodes().count(id) == 0) {
+        auto walker = XMLTreeWalker(manifest);
+        xml_doc.traverse(walker);
+      }
     }
-  }
 
-  auto xml_str = std::stringstream();
-  xml_doc.save(xml_str);
-  return factory_.createTreeFromText(xml_str.str());
+    auto xml_str = std::stringstream();
+    xml_doc.save(xml_str);
+    iter = xml_texts.emplace(format_path, xml_str.str()).first;
+  }
+  return factory_.createTreeFromText(iter->second);
 }
 
 auto VehicleBehaviorTree::getBehaviorParameter() -> traffic_simulator_msgs::msg::BehaviorParameter
@@ -144,10 +175,28 @@ const std::string & VehicleBehaviorTree::getCurrentAction() const
 
 auto VehicleBehaviorTree::update(const double current_time, const double step_time) -> void
 {
+  setCurrentTime(current_time);
+  setStepTime(step_time);
+  if (
+    wake_up_condition_.isArmed() and
+    not wake_up_condition_.fired(*context_, getBehaviorParameter())) {
+    /// @note The entity stands still, so the tick would only have advanced its time.
+    context_->canonicalized_entity_status->setTime(current_time + step_time);
+    return;
+  }
+  wake_up_condition_.disarm();
+
   tickOnce(current_time, step_time);
   while (getCurrentAction() == "root") {
     tickOnce(current_time, step_time);
   }
+
+  if (const auto & status = *context_->canonicalized_entity_status;
+      getBehaviorParameter().skip_ticks_while_waiting and
+      behavior_tree_plugin::WakeUpCondition::isWaitingAction(getCurrentAction()) and
+      status.getTwist().linear.x == 0.0 and status.getAccel().linear.x == 0.0) {
+    wake_up_condition_.arm(*context_, getBehaviorParameter());
+  }
 }
 
 auto VehicleBehaviorTree::tickOnce(const double current_time, const double step_time)
@@ -155,6 +204,7 @@ auto VehicleBehaviorTree::tickOnce(const double current_time, const double step_
 {
   setCurrentTime(current_time);
   setStepTime(step_time);
+  context_->perception_cache = PerceptionCache();
   return tree_.rootNode()->executeTick();
 }
 }  // namespace entity_behavior
@@ -77,7 +77,7 @@ BT::NodeStatus FollowFrontEntityAction::tick()
     request != traffic_simulator::behavior::Request::FOLLOW_LANE) {
     return BT::NodeStatus::FAILURE;
   }
-  if (getRightOfWayEntities(route_lanelets).size() != 0) {
+  if (getRightOfWayEntities(context->route_lanelets).size() != 0) {
     return BT::NodeStatus::FAILURE;
   }
   if (!behavior_parameter.see_around) {
@@ -90,8 +90,9 @@ BT::NodeStatus FollowFrontEntityAction::tick()
   if (trajectory == nullptr) {
     return BT::NodeStatus::FAILURE;
   }
-  auto distance_to_stopline = hdmap_utils->getDistanceToStopLine(route_lanelets, *trajectory);
-  auto distance_to_conflicting_entity = getDistanceToConflictingEntity(route_lanelets, *trajectory);
+  auto distance_to_stopline = getDistanceToStopLine(context->route_lanelets, *trajectory);
+  auto distance_to_conflicting_entity =
+    getDistanceToConflictingEntity(context->route_lanelets, *trajectory);
   const auto front_entity_name = getFrontEntityName(*trajectory);
   if (!front_entity_name) {
     return BT::NodeStatus::FAILURE;
@@ -113,7 +114,7 @@ BT::NodeStatus FollowFrontEntityAction::tick()
   }
   const auto & front_entity_status = getEntityStatus(front_entity_name.value());
   if (!target_speed) {
-    target_speed = hdmap_utils->getSpeedLimit(route_lanelets);
+    target_speed = hdmap_utils->getSpeedLimit(context->route_lanelets);
   }
   const double front_entity_linear_velocity = front_entity_status.getTwist().linear.x;
   if (target_speed.value() <= front_entity_linear_velocity) {
@@ -83,7 +83,7 @@ BT::NodeStatus FollowLaneAction::tick()
     return BT::NodeStatus::FAILURE;
   }
   if (behavior_parameter.see_around) {
-    if (getRightOfWayEntities(route_lanelets).size() != 0) {
+    if (getRightOfWayEntities(context->route_lanelets).size() != 0) {
       return BT::NodeStatus::FAILURE;
     }
     if (trajectory == nullptr) {
@@ -99,15 +99,15 @@ BT::NodeStatus FollowLaneAction::tick()
       }
     }
     const auto distance_to_traffic_stop_line =
-      getDistanceToTrafficLightStopLine(route_lanelets, *trajectory);
+      getDistanceToTrafficLightStopLine(context->route_lanelets, *trajectory);
     if (distance_to_traffic_stop_line) {
       if (distance_to_traffic_stop_line.value() <= getHorizon()) {
         return BT::NodeStatus::FAILURE;
       }
     }
-    auto distance_to_stopline = hdmap_utils->getDistanceToStopLine(route_lanelets, *trajectory);
+    auto distance_to_stopline = getDistanceToStopLine(context->route_lanelets, *trajectory);
     auto distance_to_conflicting_entity =
-      getDistanceToConflictingEntity(route_lanelets, *trajectory);
+      getDistanceToConflictingEntity(context->route_lanelets, *trajectory);
     if (distance_to_stopline) {
       if (
         distance_to_stopline.value() <=
@@ -126,7 +126,7 @@ BT::NodeStatus FollowLaneAction::tick()
     }
   }
   if (!target_speed) {
-    target_speed = hdmap_utils->getSpeedLimit(route_lanelets);
+    target_speed = hdmap_utils->getSpeedLimit(context->route_lanelets);
   }
   setCanonicalizedEntityStatus(calculateUpdatedEntityStatus(target_speed.value()));
   setOutput("waypoints", waypoints);
@@ -98,7 +98,7 @@ BT::NodeStatus StopAtStopLineAction::tick()
   if (!behavior_parameter.see_around) {
     return BT::NodeStatus::FAILURE;
   }
-  if (getRightOfWayEntities(route_lanelets).size() != 0) {
+  if (getRightOfWayEntities(context->route_lanelets).size() != 0) {
     return BT::NodeStatus::FAILURE;
   }
   const auto waypoints = calculateWaypoints();
@@ -108,8 +108,9 @@ BT::NodeStatus StopAtStopLineAction::tick()
   if (trajectory == nullptr) {
     return BT::NodeStatus::FAILURE;
   }
-  distance_to_stopline_ = hdmap_utils->getDistanceToStopLine(route_lanelets, *trajectory);
-  const auto distance_to_stop_target = getDistanceToConflictingEntity(route_lanelets, *trajectory);
+  distance_to_stopline_ = getDistanceToStopLine(context->route_lanelets, *trajectory);
+  const auto distance_to_stop_target =
+    getDistanceToConflictingEntity(context->route_lanelets, *trajectory);
   const auto distance_to_front_entity = getDistanceToFrontEntity(*trajectory);
   if (!distance_to_stopline_) {
     stopped_ = false;
@@ -137,7 +138,7 @@ BT::NodeStatus StopAtStopLineAction::tick()
   }
   if (stopped_) {
     if (!target_speed) {
-      target_speed = hdmap_utils->getSpeedLimit(route_lanelets);
+      target_speed = hdmap_utils->getSpeedLimit(context->route_lanelets);
     }
     if (!distance_to_stopline_) {
       stopped_ = false;
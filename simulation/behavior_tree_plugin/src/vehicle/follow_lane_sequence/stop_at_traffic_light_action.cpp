@@ -98,7 +98,7 @@ BT::NodeStatus StopAtTrafficLightAction::tick()
   if (!behavior_parameter.see_around) {
     return BT::NodeStatus::FAILURE;
   }
-  if (getRightOfWayEntities(route_lanelets).size() != 0) {
+  if (getRightOfWayEntities(context->route_lanelets).size() != 0) {
     return BT::NodeStatus::FAILURE;
   }
   const auto waypoints = calculateWaypoints();
@@ -108,7 +108,8 @@ BT::NodeStatus StopAtTrafficLightAction::tick()
   if (trajectory == nullptr) {
     return BT::NodeStatus::FAILURE;
   }
-  distance_to_stop_target_ = getDistanceToTrafficLightStopLine(route_lanelets, *trajectory);
+  distance_to_stop_target_ =
+    getDistanceToTrafficLightStopLine(context->route_lanelets, *trajectory);
   std::optional<double> target_linear_speed;
   if (distance_to_stop_target_) {
     if (distance_to_stop_target_.value() > getHorizon()) {
@@ -99,10 +99,10 @@ BT::NodeStatus YieldAction::tick()
   if (!canonicalized_entity_status->laneMatchingSucceed()) {
     return BT::NodeStatus::FAILURE;
   }
-  const auto right_of_way_entities = getRightOfWayEntities(route_lanelets);
+  const auto right_of_way_entities = getRightOfWayEntities(context->route_lanelets);
   if (right_of_way_entities.empty()) {
     if (!target_speed) {
-      target_speed = hdmap_utils->getSpeedLimit(route_lanelets);
+      target_speed = hdmap_utils->getSpeedLimit(context->route_lanelets);
     }
     setCanonicalizedEntityStatus(calculateUpdatedEntityStatus(target_speed.value()));
     const auto waypoints = calculateWaypoints();
@@ -114,10 +114,10 @@ BT::NodeStatus YieldAction::tick()
     setOutput("obstacle", obstacle);
     return BT::NodeStatus::SUCCESS;
   }
-  distance_to_stop_target_ = getYieldStopDistance(route_lanelets);
+  distance_to_stop_target_ = getYieldStopDistance(context->route_lanelets);
   target_speed = calculateTargetSpeed();
   if (!target_speed) {
-    target_speed = hdmap_utils->getSpeedLimit(route_lanelets);
+    target_speed = hdmap_utils->getSpeedLimit(context->route_lanelets);
   }
   setCanonicalizedEntityStatus(calculateUpdatedEntityStatus(target_speed.value()));
   const auto waypoints = calculateWaypoints();
@@ -54,6 +54,18 @@ auto FollowPolylineTrajectoryAction::providedPorts() -> BT::PortsList
   return ports;
 }
 
+auto FollowPolylineTrajectoryAction::getPolylineTrajectorySamples()
+  -> traffic_simulator::follow_trajectory::PolylineTrajectorySamples &
+{
+  if (sampled_polyline_trajectory != polyline_trajectory or not polyline_trajectory_samples) {
+    sampled_polyline_trajectory = polyline_trajectory;
+    polyline_trajectory_samples.emplace(
+      *polyline_trajectory, canonicalized_entity_status->getBoundingBox(), hdmap_utils,
+      default_matching_distance_for_lanelet_pose_calculation);
+  }
+  return polyline_trajectory_samples.value();
+}
+
 auto FollowPolylineTrajectoryAction::tick() -> BT::NodeStatus
 {
   auto getTargetSpeed = [&]() -> double {
@@ -67,7 +79,6 @@ auto FollowPolylineTrajectoryAction::tick() -> BT::NodeStatus
   if (getBlackBoardValues();
       request != traffic_simulator::behavior::Request::FOLLOW_POLYLINE_TRAJECTORY or
       not getInput<decltype(polyline_trajectory)>("polyline_trajectory", polyline_trajectory) or
-      not getInput<decltype(target_speed)>("target_speed", target_speed) or
       not polyline_trajectory) {
     return BT::NodeStatus::FAILURE;
   } else if (std::isnan(canonicalized_entity_status->getTime())) {
@@ -78,7 +89,8 @@ auto FollowPolylineTrajectoryAction::tick() -> BT::NodeStatus
     const auto entity_status_updated = traffic_simulator::follow_trajectory::makeUpdatedStatus(
       static_cast<traffic_simulator::EntityStatus>(*canonicalized_entity_status),
       *polyline_trajectory, behavior_parameter, hdmap_utils, step_time,
-      default_matching_distance_for_lanelet_pose_calculation, getTargetSpeed())) {
+      default_matching_distance_for_lanelet_pose_calculation, getTargetSpeed(),
+      &getPolylineTrajectorySamples())) {
     setCanonicalizedEntityStatus(entity_status_updated.value());
     setOutput("waypoints", calculateWaypoints());
     setOutput("obstacle", calculateObstacle(calculateWaypoints()));
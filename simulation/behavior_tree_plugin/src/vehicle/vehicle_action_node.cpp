@@ -44,7 +44,7 @@ void VehicleActionNode::getBlackBoardValues()
 }
 
 auto VehicleActionNode::calculateUpdatedEntityStatus(double target_speed) const
-  -> traffic_simulator::EntityStatus
+  -> traffic_simulator::CanonicalizedEntityStatus
 {
   return ActionNode::calculateUpdatedEntityStatus(
     target_speed, behavior_parameter.dynamic_constraints);
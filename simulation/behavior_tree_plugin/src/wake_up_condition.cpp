@@ -0,0 +1,128 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <behavior_tree_plugin/wake_up_condition.hpp>
+#include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace behavior_tree_plugin
+{
+/// @note Hard coded parameter, longer than the horizon of the follow lane actions plus a vehicle.
+constexpr double watched_radius = 60.0;
+
+/// @note Hard coded parameter, an armed condition fires at least this often.
+constexpr double maximum_sleep_duration = 1.0;
+
+/// @note Hard coded parameter, an entity moving less than this is considered as not moving.
+constexpr double position_tolerance = 1e-3;
+
+namespace
+{
+auto isSamePosition(const geometry_msgs::msg::Point & a, const geometry_msgs::msg::Point & b)
+{
+  return std::hypot(a.x - b.x, a.y - b.y, a.z - b.z) <= position_tolerance;
+}
+}  // namespace
+
+auto WakeUpCondition::isWaitingAction(const std::string & action) -> bool
+{
+  /*
+     These actions decide from the surroundings of the entity only. StopAtStopLine waits for a
+     duration and the other ones move the entity or follow a trajectory, so they are not listed.
+  */
+  return action == "follow_lane" or action == "follow_front_entity" or
+         action == "stop_at_traffic_light" or action == "stop_at_crossing_entity" or
+         action == "yield";
+}
+
+auto WakeUpCondition::arm(
+  const entity_behavior::ActionNodeContext & context,
+  const traffic_simulator_msgs::msg::BehaviorParameter & behavior_parameter) -> void
+{
+  const auto & route_lanelets = context.route_lanelets;
+  traffic_light_ids_ = context.hdmap_utils->getTrafficLightIdsOnPath(route_lanelets);
+  watched_lanelet_ids_ = std::unordered_set<lanelet::Id>(
+    std::begin(route_lanelets), std::end(route_lanelets));
+  for (const auto & [lanelet_id, right_of_way_ids] :
+       context.hdmap_utils->getRightOfWayLaneletIds(route_lanelets)) {
+    watched_lanelet_ids_.insert(std::begin(right_of_way_ids), std::end(right_of_way_ids));
+  }
+  for (const auto & lanelet_id : context.hdmap_utils->getConflictingLaneIds(route_lanelets)) {
+    watched_lanelet_ids_.insert(lanelet_id);
+  }
+  for (const auto & lanelet_id : context.hdmap_utils->getConflictingCrosswalkIds(route_lanelets)) {
+    watched_lanelet_ids_.insert(lanelet_id);
+  }
+  wake_up_time_ = context.current_time + maximum_sleep_duration;
+  armed_ = takeSnapshot(context, behavior_parameter);
+}
+
+auto WakeUpCondition::fired(
+  const entity_behavior::ActionNodeContext & context,
+  const traffic_simulator_msgs::msg::BehaviorParameter & behavior_parameter) const -> bool
+{
+  if (not armed_ or context.current_time >= wake_up_time_) {
+    return true;
+  } else {
+    const auto snapshot = takeSnapshot(context, behavior_parameter);
+    return snapshot.request != armed_->request or snapshot.target_speed != armed_->target_speed or
+           snapshot.route_lanelets != armed_->route_lanelets or
+           snapshot.behavior_parameter != armed_->behavior_parameter or
+           not isSamePosition(snapshot.position, armed_->position) or
+           snapshot.traffic_lights != armed_->traffic_lights or
+           not std::equal(
+             std::begin(snapshot.entities), std::end(snapshot.entities),
+             std::begin(armed_->entities), std::end(armed_->entities),
+             [](const auto & a, const auto & b) {
+               return a.first == b.first and isSamePosition(a.second, b.second);
+             });
+  }
+}
+
+auto WakeUpCondition::takeSnapshot(
+  const entity_behavior::ActionNodeContext & context,
+  const traffic_simulator_msgs::msg::BehaviorParameter & behavior_parameter) const -> Snapshot
+{
+  Snapshot snapshot;
+  snapshot.request = context.request;
+  snapshot.target_speed = context.target_speed;
+  snapshot.route_lanelets = context.route_lanelets;
+  snapshot.behavior_parameter = behavior_parameter;
+  snapshot.position = context.canonicalized_entity_status->getMapPose().position;
+  for (const auto & traffic_light_id : traffic_light_ids_) {
+    for (const auto & bulb :
+         context.traffic_light_manager->getTrafficLight(traffic_light_id).bulbs) {
+      snapshot.traffic_lights.push_back(bulb.hash());
+    }
+    /// @note Separates the bulbs of consecutive traffic lights.
+    snapshot.traffic_lights.push_back(0);
+  }
+  for (const auto & [name, status] : context.other_entity_status) {
+    const auto & position = status.getMapPose().position;
+    if (
+      std::hypot(position.x - snapshot.position.x, position.y - snapshot.position.y) <=
+        watched_radius or
+      (status.laneMatchingSucceed() and watched_lanelet_ids_.count(status.getLaneletId()))) {
+      snapshot.entities.emplace_back(name, position);
+    }
+  }
+  std::sort(
+    std::begin(snapshot.entities), std::end(snapshot.entities),
+    [](const auto & a, const auto & b) { return a.first < b.first; });
+  return snapshot;
+}
+}  // namespace behavior_tree_plugin
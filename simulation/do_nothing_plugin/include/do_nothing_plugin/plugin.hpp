@@ -28,6 +28,13 @@ public:
    * @param step_time step time of the simulation, this argument exists for other BehaviorPlugin classes but are not used by this plugin.
    */
   void update(double current_time, double step_time) override;
+  /**
+   * @brief Update all entities driven by this plugin type in one loop without virtual dispatch.
+   * @param plugins plugins of the entities, all of them are DoNothingBehavior.
+   */
+  auto updateAll(
+    const std::vector<BehaviorPluginBase *> & plugins, const double current_time,
+    const double step_time) -> void override;
   /**
    * @brief setup rclcpp::logger for debug output, but there is no debug output in this plugin.
    * @param logger logger for debug output, this argument exists for other BehaviorPlugin classes but are not used by this plugin.
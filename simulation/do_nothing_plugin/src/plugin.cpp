@@ -189,6 +189,15 @@ void DoNothingBehavior::update(double current_time, double step_time)
   }
 }
 
+auto DoNothingBehavior::updateAll(
+  const std::vector<BehaviorPluginBase *> & plugins, const double current_time,
+  const double step_time) -> void
+{
+  for (const auto plugin : plugins) {
+    static_cast<DoNothingBehavior *>(plugin)->DoNothingBehavior::update(current_time, step_time);
+  }
+}
+
 const std::string & DoNothingBehavior::getCurrentAction() const
 {
   static const std::string behavior = "do_nothing";
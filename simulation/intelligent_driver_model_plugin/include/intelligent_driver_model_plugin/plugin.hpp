@@ -0,0 +1,172 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INTELLIGENT_DRIVER_MODEL_PLUGIN__PLUGIN_HPP_
+#define INTELLIGENT_DRIVER_MODEL_PLUGIN__PLUGIN_HPP_
+
+#include <limits>
+#include <optional>
+#include <string>
+#include <traffic_simulator/behavior/behavior_plugin_base.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace entity_behavior
+{
+/**
+ * @brief Lightweight behavior for background traffic. The entity follows its route lanelets, keeps
+ * its distance to the entity in front with the intelligent driver model (IDM), changes lanes when
+ * MOBIL finds it beneficial and safe, and stops in front of red and yellow traffic lights.
+ * @note The entity moves in lane coordinates. Only the map tables of HdMapUtils are read and the
+ * other entities are found through the lanelet occupancy of OtherEntityStatus, so no spline is
+ * built or collided on each step, which keeps thousands of entities in real time.
+ */
+class IntelligentDriverModelBehavior : public BehaviorPluginBase
+{
+public:
+  /**
+   * @brief Advance the entity along its lanes by one step.
+   * @param current_time current time in scenario time
+   * @param step_time step time of the simulation
+   */
+  void update(double current_time, double step_time) override;
+  /**
+   * @brief Update all entities driven by this plugin type in one loop without virtual dispatch.
+   * @param plugins plugins of the entities, all of them are IntelligentDriverModelBehavior.
+   */
+  auto updateAll(
+    const std::vector<BehaviorPluginBase *> & plugins, const double current_time,
+    const double step_time) -> void override;
+  /**
+   * @brief setup rclcpp::logger for debug output, but there is no debug output in this plugin.
+   * @param logger logger for debug output, this argument exists for other BehaviorPlugin classes but are not used by this plugin.
+   */
+  void configure(const rclcpp::Logger & logger) override;
+  /**
+   * @brief Get the Current Action object
+   * @return const std::string& "follow_lane", "lane_change" or "stop_at_traffic_light"
+   */
+  const std::string & getCurrentAction() const override;
+
+  auto recycle() -> bool override;
+
+/// @note Getters defined by this macro return default values and setters are behaved as no-operation functions.
+#define DEFINE_GETTER_SETTER(NAME, TYPE)        \
+public:                                         \
+  TYPE get##NAME() override { return TYPE(); }; \
+  void set##NAME(const TYPE &) override{};
+  // clang-format off
+  DEFINE_GETTER_SETTER(DebugMarker,                                      std::vector<visualization_msgs::msg::Marker>)
+  DEFINE_GETTER_SETTER(GoalPoses,                                        std::vector<geometry_msgs::msg::Pose>)
+  DEFINE_GETTER_SETTER(LaneChangeParameters,                             traffic_simulator::lane_change::Parameter)
+  DEFINE_GETTER_SETTER(Obstacle,                                         std::optional<traffic_simulator_msgs::msg::Obstacle>)
+  DEFINE_GETTER_SETTER(PedestrianParameters,                             traffic_simulator_msgs::msg::PedestrianParameters)
+  DEFINE_GETTER_SETTER(PolylineTrajectory,                               std::shared_ptr<traffic_simulator_msgs::msg::PolylineTrajectory>)
+  DEFINE_GETTER_SETTER(ReferenceTrajectory,                              std::shared_ptr<math::geometry::CatmullRomSpline>)
+  DEFINE_GETTER_SETTER(VehicleParameters,                                traffic_simulator_msgs::msg::VehicleParameters)
+  DEFINE_GETTER_SETTER(Waypoints,                                        traffic_simulator_msgs::msg::WaypointsArray)
+  // clang-format on
+#undef DEFINE_GETTER_SETTER
+
+/// @note Getters defined by this macro return stored values and setters store values.
+#define DEFINE_GETTER_SETTER(NAME, TYPE, FIELD_NAME)                   \
+public:                                                                \
+  TYPE get##NAME() override { return FIELD_NAME; };                    \
+  void set##NAME(const TYPE & value) override { FIELD_NAME = value; }; \
+                                                                       \
+private:                                                               \
+  TYPE FIELD_NAME;
+  // clang-format off
+  DEFINE_GETTER_SETTER(BehaviorParameter,                                traffic_simulator_msgs::msg::BehaviorParameter,                   behavior_parameter_)
+  DEFINE_GETTER_SETTER(CanonicalizedEntityStatus,                        std::shared_ptr<traffic_simulator::CanonicalizedEntityStatus>,    canonicalized_entity_status_)
+  DEFINE_GETTER_SETTER(CurrentTime,                                      double,                                                           current_time_)
+  DEFINE_GETTER_SETTER(DefaultMatchingDistanceForLaneletPoseCalculation, double,                                                           default_matching_distance_for_lanelet_pose_calculation_)
+  DEFINE_GETTER_SETTER(HdMapUtils,                                       std::shared_ptr<hdmap_utils::HdMapUtils>,                         hdmap_utils_)
+  DEFINE_GETTER_SETTER(OtherEntityStatus,                                EntityStatusDict,                                                 other_entity_status_)
+  DEFINE_GETTER_SETTER(Request,                                          traffic_simulator::behavior::Request,                             request_)
+  DEFINE_GETTER_SETTER(RouteLanelets,                                    lanelet::Ids,                                                     route_lanelets_)
+  DEFINE_GETTER_SETTER(StepTime,                                         double,                                                           step_time_)
+  DEFINE_GETTER_SETTER(TargetSpeed,                                      std::optional<double>,                                            target_speed_)
+  DEFINE_GETTER_SETTER(TrafficLightManager,                              std::shared_ptr<traffic_simulator::TrafficLightManager>,          traffic_light_manager_)
+  // clang-format on
+#undef DEFINE_GETTER_SETTER
+
+private:
+  /// @brief Something the entity has to keep its distance to, measured bumper to bumper.
+  struct Obstruction
+  {
+    double gap;
+
+    double speed;
+  };
+
+  struct StopLine
+  {
+    lanelet::Id traffic_light_id;
+
+    /// @note Longitudinal position of the stop line on the lanelet.
+    double s;
+  };
+
+  /// @brief Acceleration the entity chooses on a lane, and the lanelets it drives through.
+  struct Plan
+  {
+    lanelet::Ids path;
+
+    double acceleration;
+
+    bool stops_at_traffic_light;
+  };
+
+  auto makePlan(
+    const traffic_simulator::LaneletPose &, const double speed, const double desired_speed)
+    -> Plan;
+
+  /// @return Lanelets the entity drives through from lanelet_id, to the end of the lookahead.
+  auto getPath(const lanelet::Id lanelet_id) const -> lanelet::Ids;
+
+  /// @return Closest entity ahead of s on the path, whose first lanelet contains s.
+  auto findLeader(const lanelet::Ids & path, const double s) const -> std::optional<Obstruction>;
+
+  /// @return Closest entity behind s on lanelet_id or on its previous lanelets.
+  auto findFollower(const lanelet::Id lanelet_id, const double s) const
+    -> std::optional<Obstruction>;
+
+  /// @return Closest stop line ahead of s on the path whose traffic light tells to stop.
+  auto findStopLine(const lanelet::Ids & path, const double s, const double speed)
+    -> std::optional<Obstruction>;
+
+  auto getStopLines(const lanelet::Id lanelet_id) -> const std::vector<StopLine> &;
+
+  auto getAcceleration(
+    const double speed, const double desired_speed, const std::optional<Obstruction> &) const
+    -> double;
+
+  /// @return Lanelet pose on the adjacent lane to change to, if MOBIL accepts the lane change.
+  auto findLaneChange(
+    const traffic_simulator::LaneletPose &, const double speed, const double desired_speed,
+    const double acceleration) -> std::optional<traffic_simulator::LaneletPose>;
+
+  auto followLane() -> traffic_simulator::CanonicalizedEntityStatus;
+
+  std::string current_action_;
+
+  double lane_change_checked_time_ = -std::numeric_limits<double>::infinity();
+
+  /// @note Traffic light stop lines of the lanelets this entity drove through, see getStopLines.
+  std::unordered_map<lanelet::Id, std::vector<StopLine>> stop_lines_;
+};
+}  // namespace entity_behavior
+
+#endif  // INTELLIGENT_DRIVER_MODEL_PLUGIN__PLUGIN_HPP_
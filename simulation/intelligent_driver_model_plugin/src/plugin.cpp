@@ -0,0 +1,468 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <geometry/quaternion/quaternion_to_euler.hpp>
+#include <intelligent_driver_model_plugin/plugin.hpp>
+#include <scenario_simulator_exception/exception.hpp>
+
+namespace entity_behavior
+{
+namespace
+{
+/// @note Hard coded parameters of the intelligent driver model.
+constexpr double time_headway = 1.5;
+constexpr double minimum_gap = 2.0;
+constexpr double acceleration_exponent = 4.0;
+constexpr double comfortable_acceleration = 1.5;
+constexpr double comfortable_deceleration = 2.0;
+constexpr double lookahead_distance = 100.0;
+
+/// @note Hard coded parameters of MOBIL and of the lateral motion while changing lanes.
+constexpr double politeness = 0.2;
+constexpr double lane_change_threshold = 0.2;
+constexpr double safe_deceleration = 4.0;
+constexpr double lane_change_interval = 1.0;
+constexpr double lane_change_matching_distance = 5.0;
+constexpr double lane_keeping_offset = 0.1;
+constexpr double lateral_speed_ratio = 0.1;
+constexpr double maximum_lateral_speed = 1.0;
+
+auto getFrontLength(const traffic_simulator_msgs::msg::BoundingBox & bounding_box) -> double
+{
+  return bounding_box.center.x + bounding_box.dimensions.x * 0.5;
+}
+
+auto getRearLength(const traffic_simulator_msgs::msg::BoundingBox & bounding_box) -> double
+{
+  return bounding_box.dimensions.x * 0.5 - bounding_box.center.x;
+}
+}  // namespace
+
+void IntelligentDriverModelBehavior::configure(const rclcpp::Logger &)
+{
+  request_ = traffic_simulator::behavior::Request::NONE;
+  current_action_ = "follow_lane";
+}
+
+void IntelligentDriverModelBehavior::update(double current_time, double step_time)
+{
+  setCurrentTime(current_time);
+  setStepTime(step_time);
+
+  if (
+    request_ != traffic_simulator::behavior::Request::NONE and
+    request_ != traffic_simulator::behavior::Request::FOLLOW_LANE) {
+    THROW_SIMULATION_ERROR(
+      "Request ", request_, " is not supported by IntelligentDriverModelBehavior.",
+      "It only follows lanes, please use behavior_tree_plugin for this entity.");
+  }
+
+  canonicalized_entity_status_->setTime(current_time);
+  if (canonicalized_entity_status_->laneMatchingSucceed()) {
+    canonicalized_entity_status_->set(followLane());
+  } else {
+    /// @note Without a lanelet pose there is no lane to follow, so the entity stops where it is.
+    canonicalized_entity_status_->setTwist(geometry_msgs::msg::Twist());
+    canonicalized_entity_status_->setAccel(geometry_msgs::msg::Accel());
+    canonicalized_entity_status_->setLinearJerk(0.0);
+    current_action_ = "follow_lane";
+  }
+}
+
+auto IntelligentDriverModelBehavior::updateAll(
+  const std::vector<BehaviorPluginBase *> & plugins, const double current_time,
+  const double step_time) -> void
+{
+  for (const auto plugin : plugins) {
+    static_cast<IntelligentDriverModelBehavior *>(plugin)->IntelligentDriverModelBehavior::update(
+      current_time, step_time);
+  }
+}
+
+auto IntelligentDriverModelBehavior::followLane() -> traffic_simulator::CanonicalizedEntityStatus
+{
+  const auto & status = *canonicalized_entity_status_;
+  const auto & constraints = behavior_parameter_.dynamic_constraints;
+
+  auto lanelet_pose = status.getLaneletPose();
+  const auto speed = std::max(status.getTwist().linear.x, 0.0);
+  const auto desired_speed = std::min(
+    target_speed_ ? target_speed_.value() : hdmap_utils_->getSpeedLimit({lanelet_pose.lanelet_id}),
+    constraints.max_speed);
+
+  auto plan = makePlan(lanelet_pose, speed, desired_speed);
+  if (
+    std::abs(lanelet_pose.offset) < lane_keeping_offset and
+    lane_change_checked_time_ + lane_change_interval <= current_time_) {
+    lane_change_checked_time_ = current_time_;
+    if (const auto target = findLaneChange(lanelet_pose, speed, desired_speed, plan.acceleration)) {
+      lanelet_pose = target.value();
+      plan = makePlan(lanelet_pose, speed, desired_speed);
+    }
+  }
+
+  const auto acceleration =
+    std::clamp(plan.acceleration, -constraints.max_deceleration, constraints.max_acceleration);
+  const auto next_speed = std::max(speed + acceleration * step_time_, 0.0);
+  /// @note If the entity stops within this step, it moves only its braking distance.
+  const auto distance = speed + acceleration * step_time_ < 0.0
+                          ? speed * speed / (-2.0 * acceleration)
+                          : (speed + next_speed) * 0.5 * step_time_;
+
+  /**
+   * @note After a lane change the entity is on the target lanelet with an offset, the offset is
+   * reduced at a lateral speed proportional to the speed, and the entity heads towards the
+   * centerline at the corresponding angle.
+   */
+  const auto lateral_direction = lanelet_pose.offset > 0.0 ? -1.0 : 1.0;
+  const auto lateral_distance = std::min(
+    std::abs(lanelet_pose.offset),
+    std::min(maximum_lateral_speed, lateral_speed_ratio * next_speed) * step_time_);
+  lanelet_pose.offset += lateral_direction * lateral_distance;
+  lanelet_pose.rpy = geometry_msgs::msg::Vector3();
+  lanelet_pose.rpy.z =
+    distance > 0.0 ? lateral_direction * std::atan2(lateral_distance, distance) : 0.0;
+
+  lanelet_pose.s += distance;
+  for (std::size_t i = 1;
+       i < plan.path.size() and lanelet_pose.s > hdmap_utils_->getLaneletLength(plan.path[i - 1]);
+       ++i) {
+    lanelet_pose.s -= hdmap_utils_->getLaneletLength(plan.path[i - 1]);
+    lanelet_pose.lanelet_id = plan.path[i];
+  }
+  lanelet_pose.s =
+    std::min(lanelet_pose.s, hdmap_utils_->getLaneletLength(lanelet_pose.lanelet_id));
+
+  const traffic_simulator::CanonicalizedLaneletPose canonicalized_lanelet_pose(
+    lanelet_pose, plan.path, hdmap_utils_);
+  auto entity_status = static_cast<traffic_simulator::EntityStatus>(status);
+  entity_status.pose = static_cast<geometry_msgs::msg::Pose>(canonicalized_lanelet_pose);
+  const auto angular_velocity =
+    std::remainder(
+      math::geometry::convertQuaternionToEulerAngle(entity_status.pose.orientation).z -
+        math::geometry::convertQuaternionToEulerAngle(status.getMapPose().orientation).z,
+      2.0 * M_PI) /
+    step_time_;
+  entity_status.action_status.twist = geometry_msgs::msg::Twist();
+  entity_status.action_status.twist.linear.x = next_speed;
+  entity_status.action_status.twist.angular.z = angular_velocity;
+  entity_status.action_status.accel = geometry_msgs::msg::Accel();
+  entity_status.action_status.accel.linear.x = acceleration;
+  entity_status.action_status.accel.angular.z =
+    (angular_velocity - status.getTwist().angular.z) / step_time_;
+  entity_status.action_status.linear_jerk =
+    (acceleration - status.getAccel().linear.x) / step_time_;
+  entity_status.lanelet_pose_valid = true;
+
+  if (std::abs(lanelet_pose.offset) >= lane_keeping_offset) {
+    current_action_ = "lane_change";
+  } else if (plan.stops_at_traffic_light) {
+    current_action_ = "stop_at_traffic_light";
+  } else {
+    current_action_ = "follow_lane";
+  }
+  return traffic_simulator::CanonicalizedEntityStatus(entity_status, canonicalized_lanelet_pose);
+}
+
+auto IntelligentDriverModelBehavior::makePlan(
+  const traffic_simulator::LaneletPose & lanelet_pose, const double speed,
+  const double desired_speed) -> Plan
+{
+  Plan plan{getPath(lanelet_pose.lanelet_id), 0.0, false};
+
+  std::optional<Obstruction> obstruction;
+  const auto keep_closest = [&](const std::optional<Obstruction> & candidate) {
+    if (candidate and (not obstruction or candidate->gap < obstruction->gap)) {
+      obstruction = candidate;
+      return true;
+    } else {
+      return false;
+    }
+  };
+
+  if (behavior_parameter_.see_around) {
+    keep_closest(findLeader(plan.path, lanelet_pose.s));
+  }
+  /// @note At a dead end the entity stops at the end of the last lanelet.
+  if (hdmap_utils_->getNextLaneletIds(plan.path.back()).empty()) {
+    auto remaining_distance = -lanelet_pose.s;
+    for (const auto lanelet_id : plan.path) {
+      remaining_distance += hdmap_utils_->getLaneletLength(lanelet_id);
+    }
+    if (remaining_distance < lookahead_distance) {
+      keep_closest(Obstruction{
+        remaining_distance - getFrontLength(canonicalized_entity_status_->getBoundingBox()), 0.0});
+    }
+  }
+  plan.stops_at_traffic_light = keep_closest(findStopLine(plan.path, lanelet_pose.s, speed));
+
+  plan.acceleration = getAcceleration(speed, desired_speed, obstruction);
+  return plan;
+}
+
+auto IntelligentDriverModelBehavior::getPath(const lanelet::Id lanelet_id) const -> lanelet::Ids
+{
+  lanelet::Ids path;
+  auto length = 0.0;
+  /// @note The path follows the route only through successors, lane changes are made separately.
+  if (const auto route_iter = std::find(route_lanelets_.begin(), route_lanelets_.end(), lanelet_id);
+      route_iter != route_lanelets_.end()) {
+    for (auto iter = route_iter; iter != route_lanelets_.end() and length < lookahead_distance;
+         ++iter) {
+      if (not path.empty()) {
+        if (const auto next_ids = hdmap_utils_->getNextLaneletIds(path.back());
+            std::find(next_ids.begin(), next_ids.end(), *iter) == next_ids.end()) {
+          break;
+        }
+      }
+      path.push_back(*iter);
+      length += hdmap_utils_->getLaneletLength(*iter);
+    }
+  } else {
+    path.push_back(lanelet_id);
+    length += hdmap_utils_->getLaneletLength(lanelet_id);
+  }
+  if (length < lookahead_distance) {
+    const auto following_ids =
+      hdmap_utils_->getFollowingLanelets(path.back(), lookahead_distance - length, false);
+    path.insert(path.end(), following_ids.begin(), following_ids.end());
+  }
+  return path;
+}
+
+auto IntelligentDriverModelBehavior::findLeader(const lanelet::Ids & path, const double s) const
+  -> std::optional<Obstruction>
+{
+  const auto front_length = getFrontLength(canonicalized_entity_status_->getBoundingBox());
+  std::optional<Obstruction> leader;
+  /// @note Lanelets are visited in driving order, the first with an entity ahead has the leader.
+  auto distance_to_lanelet = -s;
+  for (const auto lanelet_id : path) {
+    if (leader or lookahead_distance < distance_to_lanelet) {
+      break;
+    }
+    other_entity_status_.forEachOnLanelet(lanelet_id, [&](const auto & entry) {
+      const auto & other_status = entry.second;
+      if (const auto distance = distance_to_lanelet + other_status.getLaneletPose().s;
+          0.0 < distance) {
+        const auto gap = distance - front_length - getRearLength(other_status.getBoundingBox());
+        if (not leader or gap < leader->gap) {
+          leader = Obstruction{gap, other_status.getTwist().linear.x};
+        }
+      }
+    });
+    distance_to_lanelet += hdmap_utils_->getLaneletLength(lanelet_id);
+  }
+  return leader;
+}
+
+auto IntelligentDriverModelBehavior::findFollower(
+  const lanelet::Id lanelet_id, const double s) const -> std::optional<Obstruction>
+{
+  const auto rear_length = getRearLength(canonicalized_entity_status_->getBoundingBox());
+  std::optional<Obstruction> follower;
+  const auto keep_closest = [&](const auto & entry, const double distance) {
+    const auto & other_status = entry.second;
+    if (const auto gap = distance - rear_length - getFrontLength(other_status.getBoundingBox());
+        0.0 < distance and (not follower or gap < follower->gap)) {
+      follower = Obstruction{gap, other_status.getTwist().linear.x};
+    }
+  };
+  other_entity_status_.forEachOnLanelet(lanelet_id, [&](const auto & entry) {
+    keep_closest(entry, s - entry.second.getLaneletPose().s);
+  });
+  if (not follower) {
+    for (const auto previous_id : hdmap_utils_->getPreviousLaneletIds(lanelet_id)) {
+      const auto previous_length = hdmap_utils_->getLaneletLength(previous_id);
+      other_entity_status_.forEachOnLanelet(previous_id, [&](const auto & entry) {
+        keep_closest(entry, s + previous_length - entry.second.getLaneletPose().s);
+      });
+    }
+  }
+  return follower;
+}
+
+auto IntelligentDriverModelBehavior::findStopLine(
+  const lanelet::Ids & path, const double s, const double speed) -> std::optional<Obstruction>
+{
+  if (not traffic_light_manager_) {
+    return std::nullopt;
+  }
+  using Color = traffic_simulator::TrafficLight::Color;
+  using Status = traffic_simulator::TrafficLight::Status;
+  using Shape = traffic_simulator::TrafficLight::Shape;
+  const auto front_length = getFrontLength(canonicalized_entity_status_->getBoundingBox());
+  /// @note An entity which can no longer stop in front of the stop line goes through.
+  const auto braking_distance =
+    speed * speed / (2.0 * behavior_parameter_.dynamic_constraints.max_deceleration);
+  auto distance_to_lanelet = -s;
+  for (const auto lanelet_id : path) {
+    if (lookahead_distance < distance_to_lanelet) {
+      break;
+    }
+    for (const auto & stop_line : getStopLines(lanelet_id)) {
+      if (const auto gap = distance_to_lanelet + stop_line.s - front_length;
+          braking_distance <= gap) {
+        if (const auto & traffic_light =
+              traffic_light_manager_->getTrafficLight(stop_line.traffic_light_id);
+            traffic_light.contains(Color::red, Status::solid_on, Shape::circle) or
+            traffic_light.contains(Color::yellow, Status::solid_on, Shape::circle)) {
+          return Obstruction{gap, 0.0};
+        }
+      }
+    }
+    distance_to_lanelet += hdmap_utils_->getLaneletLength(lanelet_id);
+  }
+  return std::nullopt;
+}
+
+auto IntelligentDriverModelBehavior::getStopLines(const lanelet::Id lanelet_id)
+  -> const std::vector<StopLine> &
+{
+  if (const auto iter = stop_lines_.find(lanelet_id); iter != stop_lines_.end()) {
+    return iter->second;
+  } else {
+    std::vector<StopLine> stop_lines;
+    if (const auto traffic_light_ids = hdmap_utils_->getTrafficLightIdsOnPath({lanelet_id});
+        not traffic_light_ids.empty()) {
+      const auto centerline = hdmap_utils_->getCenterPointsSpline(lanelet_id);
+      for (const auto traffic_light_id : traffic_light_ids) {
+        if (const auto s =
+              hdmap_utils_->getDistanceToTrafficLightStopLine(*centerline, traffic_light_id)) {
+          stop_lines.push_back(StopLine{traffic_light_id, s.value()});
+        }
+      }
+      std::sort(stop_lines.begin(), stop_lines.end(), [](const auto & a, const auto & b) {
+        return a.s < b.s;
+      });
+    }
+    return stop_lines_.emplace(lanelet_id, std::move(stop_lines)).first->second;
+  }
+}
+
+auto IntelligentDriverModelBehavior::getAcceleration(
+  const double speed, const double desired_speed,
+  const std::optional<Obstruction> & obstruction) const -> double
+{
+  const auto & constraints = behavior_parameter_.dynamic_constraints;
+  const auto maximum_acceleration =
+    std::min(constraints.max_acceleration, comfortable_acceleration);
+  const auto deceleration = std::min(constraints.max_deceleration, comfortable_deceleration);
+
+  const auto free_road_term =
+    0.0 < desired_speed ? std::pow(speed / desired_speed, acceleration_exponent)
+                        : (0.0 < speed ? std::numeric_limits<double>::infinity() : 1.0);
+  const auto interaction_term = [&]() {
+    if (obstruction) {
+      const auto dynamic_gap =
+        speed * time_headway + speed * (speed - obstruction->speed) /
+                                 (2.0 * std::sqrt(maximum_acceleration * deceleration));
+      const auto desired_gap = minimum_gap + std::max(dynamic_gap, 0.0);
+      return std::pow(
+        desired_gap / std::max(obstruction->gap, std::numeric_limits<double>::epsilon()), 2);
+    } else {
+      return 0.0;
+    }
+  }();
+  return maximum_acceleration * (1.0 - free_road_term - interaction_term);
+}
+
+auto IntelligentDriverModelBehavior::findLaneChange(
+  const traffic_simulator::LaneletPose & lanelet_pose, const double speed,
+  const double desired_speed, const double acceleration)
+  -> std::optional<traffic_simulator::LaneletPose>
+{
+  using Direction = traffic_simulator::lane_change::Direction;
+  const auto entity_length = canonicalized_entity_status_->getBoundingBox().dimensions.x;
+  std::optional<traffic_simulator::LaneletPose> lane_change;
+  auto best_incentive = lane_change_threshold;
+  for (const auto direction : {Direction::LEFT, Direction::RIGHT}) {
+    const auto target_id =
+      hdmap_utils_->getLaneChangeableLaneletId(lanelet_pose.lanelet_id, direction);
+    if (not target_id or target_id.value() == lanelet_pose.lanelet_id) {
+      continue;
+    }
+    const auto target_pose = hdmap_utils_->toLaneletPose(
+      canonicalized_entity_status_->getMapPose(), target_id.value(), lane_change_matching_distance);
+    if (not target_pose) {
+      continue;
+    }
+    const auto target_plan = makePlan(target_pose.value(), speed, desired_speed);
+    if (target_plan.acceleration < -safe_deceleration) {
+      continue;
+    }
+    /**
+     * @note MOBIL: the lane change must not make the new follower brake harder than
+     * safe_deceleration, and it is made if the acceleration the entity gains exceeds the
+     * threshold, after subtracting the acceleration the new follower loses weighted by politeness.
+     */
+    auto follower_acceleration_loss = 0.0;
+    if (const auto follower = behavior_parameter_.see_around
+                                ? findFollower(target_id.value(), target_pose->s)
+                                : std::nullopt) {
+      const auto follower_acceleration =
+        getAcceleration(follower->speed, desired_speed, Obstruction{follower->gap, speed});
+      if (follower_acceleration < -safe_deceleration) {
+        continue;
+      }
+      const auto leader = findLeader(target_plan.path, target_pose->s);
+      const auto previous_follower_acceleration = getAcceleration(
+        follower->speed, desired_speed,
+        leader ? std::make_optional(
+                   Obstruction{follower->gap + entity_length + leader->gap, leader->speed})
+               : std::nullopt);
+      follower_acceleration_loss = previous_follower_acceleration - follower_acceleration;
+    }
+    /// @note A lane change on the route is made whenever it is safe.
+    if (
+      route_lanelets_.size() > 1 and route_lanelets_[0] == lanelet_pose.lanelet_id and
+      route_lanelets_[1] == target_id.value()) {
+      return target_pose;
+    } else if (const auto incentive =
+                 target_plan.acceleration - acceleration - politeness * follower_acceleration_loss;
+               best_incentive < incentive) {
+      best_incentive = incentive;
+      lane_change = target_pose;
+    }
+  }
+  return lane_change;
+}
+
+const std::string & IntelligentDriverModelBehavior::getCurrentAction() const
+{
+  return current_action_;
+}
+
+auto IntelligentDriverModelBehavior::recycle() -> bool
+{
+  behavior_parameter_ = traffic_simulator_msgs::msg::BehaviorParameter();
+  canonicalized_entity_status_ = nullptr;
+  other_entity_status_ = EntityStatusDict();
+  request_ = traffic_simulator::behavior::Request::NONE;
+  route_lanelets_.clear();
+  target_speed_ = std::nullopt;
+  traffic_light_manager_ = nullptr;
+  current_action_ = "follow_lane";
+  lane_change_checked_time_ = -std::numeric_limits<double>::infinity();
+  stop_lines_.clear();
+  return true;
+}
+}  // namespace entity_behavior
+
+#include "pluginlib/class_list_macros.hpp"
+
+PLUGINLIB_EXPORT_CLASS(
+  entity_behavior::IntelligentDriverModelBehavior, entity_behavior::BehaviorPluginBase)
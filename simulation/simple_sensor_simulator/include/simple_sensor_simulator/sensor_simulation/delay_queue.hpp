@@ -0,0 +1,89 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__DELAY_QUEUE_HPP_
+#define SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__DELAY_QUEUE_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace simple_sensor_simulator
+{
+/**
+ * @brief Ring buffer of the messages of a sensor waiting for their publishing delay to elapse.
+ * @note The messages are moved in and out of the slots, so they are never copied. The capacity
+ * follows from the delay and the update period of the sensor, and only grows if the simulation
+ * steps do not match the period.
+ */
+template <typename T>
+class DelayQueue
+{
+public:
+  explicit DelayQueue(const double delay, const double period)
+  : slots_(period > 0 ? static_cast<std::size_t>(std::ceil(std::max(0.0, delay) / period)) + 2 : 2)
+  {
+  }
+
+  auto empty() const -> bool { return size_ == 0; }
+
+  auto size() const -> std::size_t { return size_; }
+
+  auto push(T && message, const double time) -> void
+  {
+    if (size_ == slots_.size()) {
+      grow();
+    }
+    auto & slot = slots_[(head_ + size_) % slots_.size()];
+    slot.first = std::move(message);
+    slot.second = time;
+    ++size_;
+  }
+
+  auto front() -> T & { return slots_[head_].first; }
+
+  /// @return Time when the oldest message was pushed.
+  auto frontTime() const -> double { return slots_[head_].second; }
+
+  /// @note Move the oldest message out of the queue.
+  auto pop() -> T
+  {
+    auto message = std::move(slots_[head_].first);
+    head_ = (head_ + 1) % slots_.size();
+    --size_;
+    return message;
+  }
+
+private:
+  auto grow() -> void
+  {
+    std::vector<std::pair<T, double>> slots(slots_.size() * 2);
+    for (std::size_t i = 0; i < size_; ++i) {
+      slots[i] = std::move(slots_[(head_ + i) % slots_.size()]);
+    }
+    slots_.swap(slots);
+    head_ = 0;
+  }
+
+  std::vector<std::pair<T, double>> slots_;
+
+  std::size_t head_ = 0;
+
+  std::size_t size_ = 0;
+};
+}  // namespace simple_sensor_simulator
+
+#endif  // SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__DELAY_QUEUE_HPP_
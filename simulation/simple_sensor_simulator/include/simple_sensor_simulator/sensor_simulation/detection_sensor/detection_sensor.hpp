@@ -17,16 +17,21 @@
 
 #include <simulation_api_schema.pb.h>
 
+#include <arithmetic/random/philox.hpp>
+#include <autoware_auto_perception_msgs/msg/tracked_objects.hpp>
 #include <memory>
-#include <queue>
 #include <random>
 #include <rclcpp/rclcpp.hpp>
+#include <simple_sensor_simulator/sensor_simulation/delay_queue.hpp>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 namespace simple_sensor_simulator
 {
+class Raycaster;
+
 class DetectionSensorBase
 {
 protected:
@@ -53,8 +58,7 @@ public:
 
   virtual void update(
     const double current_simulation_time, const std::vector<traffic_simulator_msgs::EntityStatus> &,
-    const rclcpp::Time & current_ros_time,
-    const std::vector<std::string> & lidar_detected_entities) = 0;
+    const rclcpp::Time & current_ros_time, const std::vector<bool> & lidar_detected_entities) = 0;
 };
 
 template <typename T, typename U = autoware_auto_perception_msgs::msg::TrackedObjects>
@@ -64,24 +68,42 @@ class DetectionSensor : public DetectionSensorBase
 
   const typename rclcpp::Publisher<U>::SharedPtr ground_truth_objects_publisher;
 
-  std::default_random_engine random_engine_;
+  math::arithmetic::Philox4x32 random_engine_;
+
+  DelayQueue<autoware_auto_perception_msgs::msg::DetectedObjects> detected_objects_queue;
+
+  DelayQueue<autoware_auto_perception_msgs::msg::TrackedObjects> ground_truth_objects_queue;
+
+  /// @note Name based UUIDs of the entities, generated once per entity.
+  std::unordered_map<std::string, unique_identifier_msgs::msg::UUID> uuids_;
+
+  /// @note Positions of the entities of the frame, x, y and z of each entity in turn.
+  std::vector<double> positions_;
 
-  std::queue<std::pair<autoware_auto_perception_msgs::msg::DetectedObjects, double>>
-    detected_objects_queue;
+  /// @note Scene shared with the LiDARs, traced for the visibility test if it is enabled.
+  const std::shared_ptr<Raycaster> raycaster_ptr_;
 
-  std::queue<std::pair<autoware_auto_perception_msgs::msg::TrackedObjects, double>>
-    ground_truth_objects_queue;
+  auto getUUID(const traffic_simulator_msgs::EntityStatus &)
+    -> const unique_identifier_msgs::msg::UUID &;
 
 public:
   explicit DetectionSensor(
     const double current_simulation_time,
     const simulation_api_schema::DetectionSensorConfiguration & configuration,
     const typename rclcpp::Publisher<T>::SharedPtr & publisher,
-    const typename rclcpp::Publisher<U>::SharedPtr & ground_truth_publisher = nullptr)
+    const typename rclcpp::Publisher<U>::SharedPtr & ground_truth_publisher = nullptr,
+    const std::shared_ptr<Raycaster> & raycaster_ptr = nullptr)
   : DetectionSensorBase(current_simulation_time, configuration),
     detected_objects_publisher(publisher),
     ground_truth_objects_publisher(ground_truth_publisher),
-    random_engine_(configuration.random_seed())
+    random_engine_(
+      configuration.random_seed(),
+      math::arithmetic::makeStreamId("detection_sensor/" + configuration.entity())),
+    detected_objects_queue(
+      configuration.object_recognition_delay(), configuration.update_duration()),
+    ground_truth_objects_queue(
+      configuration.object_recognition_ground_truth_delay(), configuration.update_duration()),
+    raycaster_ptr_(raycaster_ptr)
   {
   }
 
@@ -89,7 +111,7 @@ public:
 
   auto update(
     const double, const std::vector<traffic_simulator_msgs::EntityStatus> &, const rclcpp::Time &,
-    const std::vector<std::string> & lidar_detected_entities) -> void override;
+    const std::vector<bool> & lidar_detected_entities) -> void override;
 };
 }  // namespace simple_sensor_simulator
 
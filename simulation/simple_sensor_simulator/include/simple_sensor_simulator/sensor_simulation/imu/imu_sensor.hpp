@@ -17,6 +17,7 @@
 
 #include <simulation_api_schema.pb.h>
 
+#include <arithmetic/random/philox.hpp>
 #include <array>
 #include <geometry_msgs/msg/accel.hpp>
 #include <geometry_msgs/msg/twist.hpp>
@@ -36,10 +37,9 @@ public:
     noise_standard_deviation_orientation_(configuration.noise_standard_deviation_orientation()),
     noise_standard_deviation_twist_(configuration.noise_standard_deviation_twist()),
     noise_standard_deviation_acceleration_(configuration.noise_standard_deviation_acceleration()),
-    random_generator_(configuration.use_seed() ? configuration.seed() : std::random_device{}()),
-    noise_distribution_orientation_(0.0, noise_standard_deviation_orientation_),
-    noise_distribution_twist_(0.0, noise_standard_deviation_twist_),
-    noise_distribution_acceleration_(0.0, noise_standard_deviation_acceleration_),
+    random_generator_(
+      configuration.use_seed() ? configuration.seed() : std::random_device{}(),
+      math::arithmetic::makeStreamId("imu_sensor/" + configuration.entity())),
     orientation_covariance_(calculateCovariance(noise_standard_deviation_orientation_)),
     angular_velocity_covariance_(calculateCovariance(noise_standard_deviation_twist_)),
     linear_acceleration_covariance_(calculateCovariance(noise_standard_deviation_acceleration_))
@@ -57,10 +57,7 @@ protected:
   const double noise_standard_deviation_orientation_;
   const double noise_standard_deviation_twist_;
   const double noise_standard_deviation_acceleration_;
-  mutable std::mt19937 random_generator_;
-  mutable std::normal_distribution<> noise_distribution_orientation_;
-  mutable std::normal_distribution<> noise_distribution_twist_;
-  mutable std::normal_distribution<> noise_distribution_acceleration_;
+  mutable math::arithmetic::Philox4x32 random_generator_;
   const std::array<double, 9> orientation_covariance_;
   const std::array<double, 9> angular_velocity_covariance_;
   const std::array<double, 9> linear_acceleration_covariance_;
@@ -17,11 +17,12 @@
 
 #include <simulation_api_schema.pb.h>
 
+#include <algorithm>
 #include <geometry/quaternion/get_rotation_matrix.hpp>
 #include <memory>
-#include <queue>
 #include <rclcpp/rclcpp.hpp>
 #include <sensor_msgs/msg/point_cloud2.hpp>
+#include <simple_sensor_simulator/sensor_simulation/delay_queue.hpp>
 #include <simple_sensor_simulator/sensor_simulation/lidar/raycaster.hpp>
 #include <string>
 #include <vector>
@@ -35,13 +36,22 @@ protected:
 
   simulation_api_schema::LidarConfiguration configuration_;
 
-  Raycaster raycaster_;
+  /// @note Shared by the LiDARs of the same entity, which all trace the same scene per frame.
+  const std::shared_ptr<Raycaster> raycaster_ptr_;
+  const Raycaster::RayDirections ray_directions_;
+  /// @note The rays skip the entity carrying the LiDAR, which is in the scene for the others.
+  const unsigned int ray_mask_;
   std::vector<std::string> detected_objects_;
 
   explicit LidarSensorBase(
     const double current_simulation_time,
-    const simulation_api_schema::LidarConfiguration & configuration)
-  : previous_simulation_time_(current_simulation_time), configuration_(configuration)
+    const simulation_api_schema::LidarConfiguration & configuration,
+    const std::shared_ptr<Raycaster> & raycaster_ptr)
+  : previous_simulation_time_(current_simulation_time),
+    configuration_(configuration),
+    raycaster_ptr_(raycaster_ptr),
+    ray_directions_(raycaster_ptr_->makeDirections(configuration)),
+    ray_mask_(raycaster_ptr_->getRayMask(configuration.entity()))
   {
   }
 
@@ -60,19 +70,59 @@ class LidarSensor : public LidarSensorBase
 {
   const typename rclcpp::Publisher<T>::SharedPtr publisher_ptr_;
 
-  std::queue<std::pair<sensor_msgs::msg::PointCloud2, double>> queue_pointcloud_;
+  DelayQueue<sensor_msgs::msg::PointCloud2> queue_pointcloud_;
+
+  /// @note Index of the first ray of the scan which has not been traced yet, in azimuth slices.
+  std::size_t next_ray_ = 0;
 
-  auto raycast(const std::vector<traffic_simulator_msgs::EntityStatus> &, const rclcpp::Time &)
-    -> T;
+  auto raycast(
+    const std::vector<traffic_simulator_msgs::EntityStatus> &, const rclcpp::Time &,
+    const std::size_t first_ray, const std::size_t last_ray) -> T;
+
+  /**
+   * @brief Trace the rays of the azimuth swept since the previous frame.
+   * @note The cost of a scan is spread over its frames, and each slice is traced from the pose of
+   * the ego at its frame, like a rotating LiDAR moving during the scan.
+   */
+  auto updateAzimuthSlice(
+    const double current_simulation_time,
+    const std::vector<traffic_simulator_msgs::EntityStatus> & status,
+    const rclcpp::Time & current_ros_time) -> void
+  {
+    const auto ray_count = ray_directions_.x.size();
+    const auto column_size = std::max<std::size_t>(1, configuration_.vertical_angles_size());
+    const auto column_count = ray_count / column_size;
+    const auto elapsed_time = current_simulation_time - previous_simulation_time_;
+    const auto end_of_scan = elapsed_time - configuration_.scan_duration() >= -0.002;
+    const auto last_ray =
+      end_of_scan ? ray_count
+                  : std::min(
+                      ray_count, static_cast<std::size_t>(
+                                   elapsed_time / configuration_.scan_duration() * column_count) *
+                                   column_size);
+    if (next_ray_ < last_ray) {
+      queue_pointcloud_.push(
+        raycast(status, current_ros_time, next_ray_, last_ray), current_simulation_time);
+      next_ray_ = last_ray;
+    } else {
+      detected_objects_.clear();
+    }
+    if (end_of_scan) {
+      previous_simulation_time_ = current_simulation_time;
+      next_ray_ = 0;
+    }
+  }
 
 public:
   explicit LidarSensor(
     const double current_simulation_time,
     const simulation_api_schema::LidarConfiguration & configuration,
-    const typename rclcpp::Publisher<T>::SharedPtr & publisher_ptr)
-  : LidarSensorBase(current_simulation_time, configuration), publisher_ptr_(publisher_ptr)
+    const typename rclcpp::Publisher<T>::SharedPtr & publisher_ptr,
+    const std::shared_ptr<Raycaster> & raycaster_ptr = std::make_shared<Raycaster>())
+  : LidarSensorBase(current_simulation_time, configuration, raycaster_ptr),
+    publisher_ptr_(publisher_ptr),
+    queue_pointcloud_(configuration.lidar_sensor_delay(), configuration.scan_duration())
   {
-    raycaster_.setDirection(configuration);
   }
 
   auto update(
@@ -80,35 +130,32 @@ public:
     const std::vector<traffic_simulator_msgs::EntityStatus> & status,
     const rclcpp::Time & current_ros_time) -> void override
   {
-    if (
+    if (configuration_.azimuth_sliced()) {
+      updateAzimuthSlice(current_simulation_time, status, current_ros_time);
+    } else if (
       current_simulation_time - previous_simulation_time_ - configuration_.scan_duration() >=
       -0.002) {
       previous_simulation_time_ = current_simulation_time;
       queue_pointcloud_.push(
-        std::make_pair(raycast(status, current_ros_time), current_simulation_time));
+        raycast(status, current_ros_time, 0, ray_directions_.x.size()), current_simulation_time);
     } else {
       detected_objects_.clear();
     }
 
     if (
       not queue_pointcloud_.empty() and
-      current_simulation_time - queue_pointcloud_.front().second >=
+      current_simulation_time - queue_pointcloud_.frontTime() >=
         configuration_.lidar_sensor_delay()) {
-      const auto pointcloud = queue_pointcloud_.front().first;
-      queue_pointcloud_.pop();
-      publisher_ptr_->publish(pointcloud);
+      /// @note Moved into a unique pointer, so intra process subscribers take it without copy.
+      publisher_ptr_->publish(std::make_unique<T>(queue_pointcloud_.pop()));
     }
   }
-
-private:
-  // Override
-  Raycaster raycaster_;
 };
 
 template <>
 auto LidarSensor<sensor_msgs::msg::PointCloud2>::raycast(
-  const std::vector<traffic_simulator_msgs::EntityStatus> &, const rclcpp::Time &)
-  -> sensor_msgs::msg::PointCloud2;
+  const std::vector<traffic_simulator_msgs::EntityStatus> &, const rclcpp::Time &,
+  const std::size_t, const std::size_t) -> sensor_msgs::msg::PointCloud2;
 }  // namespace simple_sensor_simulator
 
 #endif  // SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__LIDAR__LIDAR_SENSOR_HPP_
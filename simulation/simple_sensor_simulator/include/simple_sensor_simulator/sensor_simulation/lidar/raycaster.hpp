@@ -18,14 +18,16 @@
 #include <embree4/rtcore.h>
 #include <pcl_conversions/pcl_conversions.h>
 
-#include <geometry/quaternion/euler_to_quaternion.hpp>
 #include <geometry/quaternion/get_rotation_matrix.hpp>
 #include <geometry_msgs/msg/pose.hpp>
 #include <geometry_msgs/msg/vector3.hpp>
 #include <memory>
+#include <optional>
 #include <random>
+#include <set>
 #include <sensor_msgs/msg/point_cloud2.hpp>
 #include <simple_sensor_simulator/sensor_simulation/primitives/box.hpp>
+#include <simple_sensor_simulator/sensor_simulation/primitives/mesh.hpp>
 #include <simple_sensor_simulator/sensor_simulation/primitives/primitive.hpp>
 #include <string>
 #include <unordered_map>
@@ -37,6 +39,17 @@ namespace simple_sensor_simulator
 class Raycaster
 {
 public:
+  /**
+   * @brief Directions of the rays in the sensor frame, as separate float arrays for ray packets.
+   * @note The rays are ordered by azimuth column first, so consecutive rays share their column.
+   */
+  struct RayDirections
+  {
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+  };
+
   Raycaster();
   explicit Raycaster(std::string embree_config);
   ~Raycaster();
@@ -49,74 +62,125 @@ public:
     auto primitive_ptr = std::make_unique<T>(std::forward<Ts>(xs)...);
     primitive_ptrs_.emplace(name, std::move(primitive_ptr));
   }
-  const sensor_msgs::msg::PointCloud2 raycast(
+  /**
+   * @brief Update the scene with the primitives added since the last commit, then clear them.
+   * @note The LiDARs sharing a raycaster commit the scene once per frame and all trace it.
+   */
+  void commit(const rclcpp::Time & stamp);
+  /**
+   * @brief Add the entities as their models or bounding boxes and commit the scene, unless it is
+   * already committed for the stamp.
+   * @note The levels of detail of the models follow the distance from lod_origin, or are the
+   * finest without it.
+   */
+  void commit(
+    const rclcpp::Time & stamp, const std::vector<traffic_simulator_msgs::EntityStatus> & entities,
+    const std::optional<geometry_msgs::msg::Point> & lod_origin = std::nullopt);
+  /**
+   * @brief Add a mesh in map coordinates which stays in the scene, such as the road surface.
+   * @note The BVH of the mesh is built once, and the mesh is not reported as a detected object.
+   */
+  void addStaticMesh(const std::vector<Vertex> & vertices, const std::vector<Triangle> & triangles);
+  bool isCommitted(const rclcpp::Time & stamp) const;
+  /// @note Set the 3D model of the entity, or nullptr to trace its bounding box.
+  void setModel(
+    const std::string & name, const std::shared_ptr<const primitives::MeshModel> & model);
+  std::shared_ptr<const primitives::MeshModel> getModel(const std::string & name) const;
+  /**
+   * @brief Ray mask of the LiDARs of the entity, so that their rays do not hit the entity itself.
+   * @note Each entity carrying LiDARs takes one bit of the mask, which its own instance does not
+   * have, so the LiDARs of up to 32 entities trace one scene holding all the entities.
+   */
+  unsigned int getRayMask(const std::string & entity);
+  sensor_msgs::msg::PointCloud2 raycast(
     const std::string & frame_id, const rclcpp::Time & stamp,
     const geometry_msgs::msg::Pose & origin, double max_distance = 300, double min_distance = 0);
+  /// @note Trace the scene as committed, for the rays of one of the LiDARs sharing the raycaster.
+  sensor_msgs::msg::PointCloud2 raycast(
+    const RayDirections & directions, const std::string & frame_id, const rclcpp::Time & stamp,
+    const geometry_msgs::msg::Pose & origin, double max_distance = 300, double min_distance = 0,
+    unsigned int ray_mask = 0b11111111'11111111'11111111'11111111);
+  /// @note Trace only the rays in [first_ray, last_ray), such as those of one azimuth slice.
+  sensor_msgs::msg::PointCloud2 raycast(
+    const RayDirections & directions, std::size_t first_ray, std::size_t last_ray,
+    const std::string & frame_id, const rclcpp::Time & stamp,
+    const geometry_msgs::msg::Pose & origin, double max_distance = 300, double min_distance = 0,
+    unsigned int ray_mask = 0b11111111'11111111'11111111'11111111);
   const std::vector<std::string> & getDetectedObject() const;
+  /**
+   * @brief Whether a ray from the origin to any of the targets reaches the entity, or the target,
+   * before hitting anything else in the scene as committed.
+   * @note Traces one ray per target, instead of a scan of the whole field of view.
+   */
+  bool isVisible(
+    const geometry_msgs::msg::Point & origin, const std::string & entity,
+    const std::vector<geometry_msgs::msg::Point> & targets,
+    unsigned int ray_mask = 0b11111111'11111111'11111111'11111111) const;
   void setDirection(
     const simulation_api_schema::LidarConfiguration & configuration,
     double horizontal_angle_start = 0, double horizontal_angle_end = 2 * M_PI);
+  RayDirections makeDirections(
+    const simulation_api_schema::LidarConfiguration & configuration,
+    double horizontal_angle_start = 0, double horizontal_angle_end = 2 * M_PI) const;
 
 private:
-  std::vector<geometry_msgs::msg::Quaternion> getDirections(
-    const std::vector<double> & vertical_angles, double horizontal_angle_start,
-    double horizontal_angle_end, double horizontal_resolution);
-  std::vector<geometry_msgs::msg::Quaternion> directions_;
-  double previous_horizontal_angle_start_;
-  double previous_horizontal_angle_end_;
-  double previous_horizontal_resolution_;
-  std::vector<double> previous_vertical_angles_;
   std::unordered_map<std::string, std::unique_ptr<primitives::Primitive>> primitive_ptrs_;
   RTCDevice device_;
   RTCScene scene_;
-  std::random_device seed_gen_;
-  std::default_random_engine engine_;
   std::vector<std::string> detected_objects_;
   std::unordered_map<unsigned int, std::string> geometry_ids_;
-  std::vector<Eigen::Matrix3d> rotation_matrices_;
 
-  static void intersect(
-    int thread_id, int thread_count, RTCScene scene,
-    pcl::PointCloud<pcl::PointXYZI>::Ptr thread_cloud, geometry_msgs::msg::Pose origin,
-    std::reference_wrapper<std::set<unsigned int>> ref_thread_detected_ids, double max_distance,
-    double min_distance,
-    std::reference_wrapper<const std::vector<Eigen::Matrix3d>> ref_rotation_matrices)
+  /**
+   * @brief Primitive kept in the scene across scans, as an instance of a prototype scene holding
+   * it in its own coordinates.
+   * @note Only the transform of the instance is updated per scan, so the BVH of the prototype is
+   * built once and the scene only rebuilds its BVH over the instances.
+   */
+  struct Instance
   {
-    auto & rotation_matrices = ref_rotation_matrices.get();
-    auto & thread_detected_ids = ref_thread_detected_ids.get();
-    const auto orientation_matrix = math::geometry::getRotationMatrix(origin.orientation);
-    for (unsigned int i = thread_id; i < rotation_matrices.size(); i += thread_count) {
-      RTCRayHit rayhit = {};
-      rayhit.ray.org_x = origin.position.x;
-      rayhit.ray.org_y = origin.position.y;
-      rayhit.ray.org_z = origin.position.z;
-      // make raycast interact with all objects
-      rayhit.ray.mask = 0b11111111'11111111'11111111'11111111;
-      rayhit.ray.tfar = max_distance;
-      rayhit.ray.tnear = min_distance;
-      rayhit.ray.flags = false;
+    std::vector<Vertex> vertices;
+    std::string prototype_key;
+    RTCScene prototype;
+    RTCGeometry geometry;
+    unsigned int geometry_id;
+  };
+  std::unordered_map<std::string, Instance> instances_;
+  /// @note Prototypes shared by the instances of the same key, such as the entities of a model.
+  std::unordered_map<std::string, RTCScene> shared_prototypes_;
+  std::unordered_map<std::string, std::shared_ptr<const primitives::MeshModel>> models_;
+  std::unordered_map<std::string, unsigned int> ray_masks_;
+  std::vector<Instance> static_instances_;
+  void updateInstances();
+  void release(const Instance & instance);
+  RayDirections ray_directions_;
+  std::optional<rclcpp::Time> committed_stamp_;
+  /// @note Number of rays traced together, 16 or 8 when the device supports the packet natively.
+  std::size_t packet_size_;
 
-      const auto rotation_mat = orientation_matrix * rotation_matrices.at(i);
-      rayhit.ray.dir_x = rotation_mat(0);
-      rayhit.ray.dir_y = rotation_mat(1);
-      rayhit.ray.dir_z = rotation_mat(2);
-      rayhit.hit.geomID = RTC_INVALID_GEOMETRY_ID;
-      rtcIntersect1(scene, &rayhit);
+  /// @note Output buffers of the chunks of rays, kept across scans so they are only cleared.
+  std::vector<pcl::PointCloud<pcl::PointXYZI>> chunk_clouds_;
+  std::vector<std::set<unsigned int>> chunk_detected_ids_;
 
-      if (rayhit.hit.geomID != RTC_INVALID_GEOMETRY_ID) {
-        double distance = rayhit.ray.tfar;
-        pcl::PointXYZI p;
-        {
-          p.x = rotation_matrices.at(i)(0) * distance;
-          p.y = rotation_matrices.at(i)(1) * distance;
-          p.z = rotation_matrices.at(i)(2) * distance;
-        }
-        thread_cloud->emplace_back(p);
-        thread_detected_ids.insert(rayhit.hit.geomID);
-      }
-    }
-  }
+  void intersect(
+    const RayDirections & directions, std::size_t begin, std::size_t end,
+    const geometry_msgs::msg::Pose & origin, double max_distance, double min_distance,
+    unsigned int ray_mask, pcl::PointCloud<pcl::PointXYZI> & cloud,
+    std::set<unsigned int> & detected_ids) const;
+
+  template <std::size_t PacketSize>
+  void intersectPackets(
+    const RayDirections & directions, std::size_t begin, std::size_t end,
+    const geometry_msgs::msg::Pose & origin, double max_distance, double min_distance,
+    unsigned int ray_mask, pcl::PointCloud<pcl::PointXYZI> & cloud,
+    std::set<unsigned int> & detected_ids) const;
 };
+
+/**
+ * @brief Create the raycaster of the ray tracing backend, selected by LidarConfiguration.
+ * @note Only "embree", the Embree CPU path, is available in this build. An empty name selects it.
+ * Another backend implements the same raycast contract as a Raycaster and is added here.
+ */
+auto makeRaycaster(const std::string & backend) -> std::shared_ptr<Raycaster>;
 }  // namespace simple_sensor_simulator
 
 #endif  // SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__LIDAR__RAYCASTER_HPP_
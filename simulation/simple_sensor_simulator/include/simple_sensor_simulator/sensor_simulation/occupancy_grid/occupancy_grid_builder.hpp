@@ -104,6 +104,22 @@ private:
    */
   std::vector<int32_t> min_cols_, max_cols_;
 
+  /**
+   * @brief Vector to hold a polygon in pixel coordinate
+   * @note This vector is declared as a member to reuse allocated memory
+   */
+  PolygonType pixels_;
+
+  /**
+   * @brief Range of rows of marker grids holding marks since the last build
+   */
+  int32_t dirty_row_begin_, dirty_row_end_ = 0;
+
+  /**
+   * @brief Range of rows of grid values which may be not zero
+   */
+  int32_t value_row_begin_, value_row_end_ = 0;
+
   /**
    * @brief Mark grid area of convex hull
    * @param grid Grid to be marked
@@ -50,20 +50,20 @@ public:
 
   /**
    * @brief Update sensor status
+   * @param lidar_detected_entities flags of the entities detected by lidar, indexed like entities
    */
   virtual void update(
     const double current_simulation_time, const std::vector<traffic_simulator_msgs::EntityStatus> &,
-    const rclcpp::Time & current_ros_time,
-    const std::vector<std::string> & lidar_detected_entities) = 0;
+    const rclcpp::Time & current_ros_time, const std::vector<bool> & lidar_detected_entities) = 0;
 
   /**
    * @brief List all objects in range of sensor sight
    * @warning `status` must contain EGO object
-   * @return names of objects in range of sensor sight
+   * @return flags of objects in range of sensor sight, indexed like `status`
    */
-  const std::vector<std::string> getDetectedObjects(
+  const std::vector<bool> getDetectedObjects(
     const std::vector<traffic_simulator_msgs::EntityStatus> & status,
-    const std::vector<std::string> & lidar_detected_entities) const;
+    const std::vector<bool> & lidar_detected_entities) const;
 
   /**
    * @brief Extract sensor pose from entity statuses
@@ -89,7 +89,7 @@ class OccupancyGridSensor : public OccupancyGridSensorBase
    */
   auto getOccupancyGrid(
     const std::vector<traffic_simulator_msgs::EntityStatus> &, const rclcpp::Time &,
-    const std::vector<std::string> &) -> T;
+    const std::vector<bool> &) -> T;
 
 public:
   explicit OccupancyGridSensor(
@@ -105,15 +105,16 @@ public:
   auto update(
     const double current_simulation_time,
     const std::vector<traffic_simulator_msgs::EntityStatus> & entities,
-    const rclcpp::Time & current_ros_time, const std::vector<std::string> & lidar_detected_entities)
+    const rclcpp::Time & current_ros_time, const std::vector<bool> & lidar_detected_entities)
     -> void override
   {
     if (
       current_simulation_time - previous_simulation_time_ - configuration_.update_duration() >=
       -0.002) {
       previous_simulation_time_ = current_simulation_time;
+      /// @note Intra process subscribers take the grid without copy from the unique pointer.
       publisher_ptr_->publish(
-        getOccupancyGrid(entities, current_ros_time, lidar_detected_entities));
+        std::make_unique<T>(getOccupancyGrid(entities, current_ros_time, lidar_detected_entities)));
     } else {
       detected_objects_ = {};
     }
@@ -121,12 +122,19 @@ public:
 
 private:
   mutable OccupancyGridBuilder builder_;
+
+  /**
+   * @brief Origin of the grid followed by the dimensions and pose of every box added to the grid
+   * @note The grid is built again only when these differ from the ones of the last build, so the
+   * frames where neither the ego nor the detected entities moved reuse the grid as it is.
+   */
+  std::vector<double> inputs_, previous_inputs_;
 };
 
 template <>
 auto OccupancyGridSensor<nav_msgs::msg::OccupancyGrid>::getOccupancyGrid(
   const std::vector<traffic_simulator_msgs::EntityStatus> & status, const rclcpp::Time & stamp,
-  const std::vector<std::string> & lidar_detected_entities) -> nav_msgs::msg::OccupancyGrid;
+  const std::vector<bool> & lidar_detected_entities) -> nav_msgs::msg::OccupancyGrid;
 }  // namespace simple_sensor_simulator
 
 #endif  // SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__OCCUPANCY_GRID__OCCUPANCY_GRID_SENSOR_HPP_
@@ -0,0 +1,77 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__PRIMITIVES__MESH_HPP_
+#define SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__PRIMITIVES__MESH_HPP_
+
+#include <istream>
+#include <memory>
+#include <simple_sensor_simulator/sensor_simulation/primitives/primitive.hpp>
+#include <string>
+#include <vector>
+
+namespace simple_sensor_simulator
+{
+namespace primitives
+{
+/**
+ * @brief Triangles of the 3D model of an entity, loaded from a Wavefront OBJ file.
+ * @note The vertices are fitted into the unit cube centered on the origin, so the model is
+ * stretched to the bounding box of each entity using it.
+ */
+struct MeshModel
+{
+  struct Level
+  {
+    std::vector<Vertex> vertices;
+    std::vector<Triangle> triangles;
+  };
+
+  std::string path;
+
+  /// @note Levels of detail from the finest, read from "<name>.obj", "<name>.lod1.obj" and so on.
+  std::vector<Level> levels;
+
+  /// @return Level of detail for an entity at the given distance from the sensor.
+  auto getLevel(double distance) const -> std::size_t;
+
+  /**
+   * @brief Load the model of the path, once per process.
+   * @return nullptr if the path is not an OBJ file or holds no triangle, such as a model type name.
+   */
+  static auto load(const std::string & path) -> std::shared_ptr<const MeshModel>;
+
+  /// @note Faces with more than three vertices are split into triangle fans.
+  static auto read(std::istream & is) -> Level;
+};
+
+class Mesh : public Primitive
+{
+public:
+  explicit Mesh(
+    const std::shared_ptr<const MeshModel> & model, std::size_t level, float depth, float width,
+    float height, const geometry_msgs::msg::Pose & pose);
+  ~Mesh() = default;
+  const std::shared_ptr<const MeshModel> model;
+  const std::size_t level;
+  const float depth;
+  const float width;
+  const float height;
+  RTCScene createPrototype(RTCDevice device) const override;
+  std::string getPrototypeKey() const override;
+};
+}  // namespace primitives
+}  // namespace simple_sensor_simulator
+
+#endif  // SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__PRIMITIVES__MESH_HPP_
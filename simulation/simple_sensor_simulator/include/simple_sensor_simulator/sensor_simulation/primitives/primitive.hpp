@@ -55,7 +55,19 @@ public:
   const std::string type;
   const geometry_msgs::msg::Pose pose;
   unsigned int addToScene(RTCDevice device, RTCScene scene);
+  /**
+   * @brief Create a committed scene holding the primitive in its own coordinates.
+   * @note The scene does not depend on the pose, so it is instanced and only the transform of the
+   * instance follows the pose.
+   */
+  virtual RTCScene createPrototype(RTCDevice device) const;
+  /**
+   * @return Key of the prototype, shared by all the primitives with the same key, or an empty
+   * string if the prototype belongs to this primitive alone.
+   */
+  virtual std::string getPrototypeKey() const { return ""; }
   std::vector<Vertex> getVertex() const;
+  const std::vector<Vertex> & getLocalVertex() const { return vertices_; }
   std::vector<Triangle> getTriangles() const;
   std::vector<geometry_msgs::msg::Point> get2DConvexHull() const;
   std::vector<geometry_msgs::msg::Point> get2DConvexHull(
@@ -74,6 +86,7 @@ protected:
   std::vector<Triangle> triangles_;
 
 private:
+  RTCGeometry createGeometry(RTCDevice device, const std::vector<Vertex> & vertices) const;
   Vertex transform(const Vertex & v) const;
   Vertex transform(const Vertex & v, const geometry_msgs::msg::Pose & sensor_pose) const;
 };
@@ -17,6 +17,7 @@
 
 #include <simulation_api_schema.pb.h>
 
+#include <algorithm>
 #include <autoware_auto_perception_msgs/msg/detected_objects.hpp>
 #include <autoware_auto_perception_msgs/msg/tracked_objects.hpp>
 #include <autoware_auto_perception_msgs/msg/traffic_signal_array.hpp>
@@ -29,6 +30,9 @@
 #include <simple_sensor_simulator/sensor_simulation/lidar/lidar_sensor.hpp>
 #include <simple_sensor_simulator/sensor_simulation/occupancy_grid/occupancy_grid_sensor.hpp>
 #include <simple_sensor_simulator/sensor_simulation/traffic_lights/traffic_lights_detector.hpp>
+#include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace simple_sensor_simulator
@@ -38,13 +42,22 @@ class SensorSimulation
 public:
   auto attachLidarSensor(
     const double current_simulation_time,
-    const simulation_api_schema::LidarConfiguration & configuration, rclcpp::Node & node) -> void
+    const simulation_api_schema::LidarConfiguration & configuration, rclcpp::Node & node,
+    std::shared_ptr<hdmap_utils::HdMapUtils> hdmap_utils) -> void
   {
     if (configuration.architecture_type().find("awf/universe") != std::string::npos) {
+      /// @note The first LiDAR attached selects the backend of the scene shared by all of them.
+      makeRaycasterIfNotExists(configuration.raycaster_backend());
+      if (configuration.raycast_lanelet_map() and not raycast_lanelet_map_) {
+        const auto [vertices, triangles] = triangulateLaneletMap(*hdmap_utils);
+        raycaster_ptr_->addStaticMesh(vertices, triangles);
+        raycast_lanelet_map_ = true;
+      }
       lidar_sensors_.push_back(std::make_unique<LidarSensor<sensor_msgs::msg::PointCloud2>>(
         current_simulation_time, configuration,
-        node.create_publisher<sensor_msgs::msg::PointCloud2>(
-          "/perception/obstacle_segmentation/pointcloud", 1)));
+        createPublisher<sensor_msgs::msg::PointCloud2>(
+          node, "/perception/obstacle_segmentation/pointcloud", configuration.publisher()),
+        raycaster_ptr_));
     } else {
       std::stringstream ss;
       ss << "Unexpected architecture_type " << std::quoted(configuration.architecture_type())
@@ -61,11 +74,17 @@ public:
     if (configuration.architecture_type().find("awf/universe") != std::string::npos) {
       using Message = autoware_auto_perception_msgs::msg::DetectedObjects;
       using GroundTruthMessage = autoware_auto_perception_msgs::msg::TrackedObjects;
+      /// @note The visibility test traces the scene of the LiDARs, made here if there is no LiDAR.
+      if (configuration.visibility_test() and not configuration.detect_all_objects_in_range()) {
+        makeRaycasterIfNotExists("");
+      }
       detection_sensors_.push_back(std::make_unique<DetectionSensor<Message>>(
         current_simulation_time, configuration,
-        node.create_publisher<Message>("/perception/object_recognition/detection/objects", 1),
-        node.create_publisher<GroundTruthMessage>(
-          "/perception/object_recognition/ground_truth/objects", 1)));
+        createPublisher<Message>(
+          node, "/perception/object_recognition/detection/objects", configuration.publisher()),
+        createPublisher<GroundTruthMessage>(
+          node, "/perception/object_recognition/ground_truth/objects", configuration.publisher()),
+        raycaster_ptr_));
     } else {
       std::stringstream ss;
       ss << "Unexpected architecture_type " << std::quoted(configuration.architecture_type())
@@ -83,7 +102,8 @@ public:
       using Message = nav_msgs::msg::OccupancyGrid;
       occupancy_grid_sensors_.push_back(std::make_unique<OccupancyGridSensor<Message>>(
         current_simulation_time, configuration,
-        node.create_publisher<Message>("/perception/occupancy_grid_map/map", 1)));
+        createPublisher<Message>(
+          node, "/perception/occupancy_grid_map/map", configuration.publisher())));
     } else {
       std::stringstream ss;
       ss << "Unexpected architecture_type " << std::quoted(configuration.architecture_type())
@@ -101,12 +121,14 @@ public:
       using Message = autoware_auto_perception_msgs::msg::TrafficSignalArray;
       traffic_lights_detectors_.push_back(std::make_unique<traffic_lights::TrafficLightsDetector>(
         std::make_shared<traffic_simulator::TrafficLightPublisher<Message>>(
-          "/perception/traffic_light_recognition/traffic_signals", &node, hdmap_utils)));
+          "/perception/traffic_light_recognition/traffic_signals", &node, hdmap_utils),
+        configuration.keepalive_period()));
     } else if (configuration.architecture_type() >= "awf/universe/20230906") {
       using Message = autoware_perception_msgs::msg::TrafficSignalArray;
       traffic_lights_detectors_.push_back(std::make_unique<traffic_lights::TrafficLightsDetector>(
         std::make_shared<traffic_simulator::TrafficLightPublisher<Message>>(
-          "/perception/traffic_light_recognition/internal/traffic_signals", &node, hdmap_utils)));
+          "/perception/traffic_light_recognition/internal/traffic_signals", &node, hdmap_utils),
+        configuration.keepalive_period()));
     } else {
       std::stringstream ss;
       ss << "Unexpected architecture_type " << std::quoted(configuration.architecture_type())
@@ -124,6 +146,24 @@ public:
       configuration, node.create_publisher<sensor_msgs::msg::Imu>("/sensing/imu/imu_data", 1)));
   }
 
+  /**
+   * @brief Set the 3D model traced by the LiDARs for the entity, from its asset key.
+   * @note The entity is traced as its bounding box if the asset key is not an OBJ file, such as a
+   * model type name, or is empty as on despawn.
+   */
+  auto setEntityModel(const std::string & name, const std::string & asset_key) -> void
+  {
+    const auto model = primitives::MeshModel::load(asset_key);
+    if (model) {
+      entity_models_[name] = model;
+    } else {
+      entity_models_.erase(name);
+    }
+    if (raycaster_ptr_) {
+      raycaster_ptr_->setModel(name, model);
+    }
+  }
+
   auto updateSensorFrame(
     double current_simulation_time, const rclcpp::Time & current_ros_time,
     const std::vector<traffic_simulator_msgs::EntityStatus> &,
@@ -132,9 +172,43 @@ public:
 private:
   std::vector<std::unique_ptr<ImuSensorBase>> imu_sensors_;
   std::vector<std::unique_ptr<LidarSensorBase>> lidar_sensors_;
+  /// @note One scene built once per frame and traced by the LiDARs of all the entities.
+  std::shared_ptr<Raycaster> raycaster_ptr_;
+  auto makeRaycasterIfNotExists(const std::string & backend) -> void
+  {
+    if (not raycaster_ptr_) {
+      raycaster_ptr_ = makeRaycaster(backend);
+      for (const auto & [name, model] : entity_models_) {
+        raycaster_ptr_->setModel(name, model);
+      }
+    }
+  }
+  std::unordered_map<std::string, std::shared_ptr<const primitives::MeshModel>> entity_models_;
+  /// @note Whether the raycaster holds the road surface of the lanelet map.
+  bool raycast_lanelet_map_ = false;
+  /// @return Road surface of the lanelets, as triangle strips between their left and right bounds.
+  static auto triangulateLaneletMap(const hdmap_utils::HdMapUtils & hdmap_utils)
+    -> std::pair<std::vector<Vertex>, std::vector<Triangle>>;
   std::vector<std::unique_ptr<DetectionSensorBase>> detection_sensors_;
   std::vector<std::unique_ptr<OccupancyGridSensorBase>> occupancy_grid_sensors_;
   std::vector<std::unique_ptr<traffic_lights::TrafficLightsDetector>> traffic_lights_detectors_;
+
+  /// @note The default configuration is the reliable topic of depth 1 published through DDS.
+  template <typename Message>
+  static auto createPublisher(
+    rclcpp::Node & node, const std::string & topic,
+    const simulation_api_schema::PublisherConfiguration & configuration)
+  {
+    auto qos = rclcpp::QoS(std::max<std::size_t>(1, configuration.history_depth()));
+    if (configuration.best_effort()) {
+      qos.best_effort();
+    }
+    auto options = rclcpp::PublisherOptions();
+    if (configuration.intra_process()) {
+      options.use_intra_process_comm = rclcpp::IntraProcessSetting::Enable;
+    }
+    return node.create_publisher<Message>(topic, qos, options);
+  }
 };
 }  // namespace simple_sensor_simulator
 
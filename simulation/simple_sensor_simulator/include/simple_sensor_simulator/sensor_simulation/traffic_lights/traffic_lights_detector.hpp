@@ -15,11 +15,13 @@
 #ifndef SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__TRAFFIC_LIGHTS__TRAFFIC_LIGHTS_DETECTOR_HPP_
 #define SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__TRAFFIC_LIGHTS__TRAFFIC_LIGHTS_DETECTOR_HPP_
 
+#include <optional>
 #include <rclcpp/rclcpp.hpp>
 #include <simulation_interface/conversions.hpp>
 #include <string>
 #include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
 #include <traffic_simulator/traffic_lights/traffic_light_publisher.hpp>
+#include <utility>
 
 namespace simple_sensor_simulator
 {
@@ -34,18 +36,39 @@ class TrafficLightsDetector
 {
   const std::shared_ptr<traffic_simulator::TrafficLightPublisherBase> publisher_;
 
+  const double keepalive_period_;
+
+  /// @note Serialized states of the last published request, to tell whether a bulb changed.
+  std::optional<std::string> published_states_;
+
+  rclcpp::Time published_time_;
+
 public:
   explicit TrafficLightsDetector(
-    const std::shared_ptr<traffic_simulator::TrafficLightPublisherBase> & publisher)
-  : publisher_(publisher)
+    const std::shared_ptr<traffic_simulator::TrafficLightPublisherBase> & publisher,
+    const double keepalive_period = 0.0)
+  : publisher_(publisher), keepalive_period_(keepalive_period)
   {
   }
 
+  /**
+   * @note With a positive keepalive period the message is only built again when the states
+   * change, and otherwise the last message is published again once per keepalive period.
+   */
   auto updateFrame(
     const rclcpp::Time & current_ros_time,
     const simulation_api_schema::UpdateTrafficLightsRequest & request) -> void
   {
-    publisher_->publish(current_ros_time, request);
+    if (keepalive_period_ <= 0.0) {
+      publisher_->publish(current_ros_time, request);
+    } else if (auto states = request.SerializeAsString(); states != published_states_) {
+      publisher_->publish(current_ros_time, request);
+      published_states_ = std::move(states);
+      published_time_ = current_ros_time;
+    } else if ((current_ros_time - published_time_).seconds() >= keepalive_period_) {
+      publisher_->republish(current_ros_time);
+      published_time_ = current_ros_time;
+    }
   }
 };
 }  // namespace traffic_lights
@@ -20,6 +20,10 @@
 
 #include <geographic_msgs/msg/geo_point.hpp>
 #include <geometry_msgs/msg/pose_stamped.hpp>
+#include <chrono>
+#include <cstdint>
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
+#include <future>
 #include <geometry_msgs/msg/transform_stamped.hpp>
 #include <map>
 #include <memory>
@@ -32,6 +36,7 @@
 #include <string>
 #include <thread>
 #include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
+#include <unordered_map>
 #include <vector>
 #include <visualization_msgs/msg/marker_array.hpp>
 
@@ -90,6 +95,13 @@ public:
 private:
   SensorSimulation sensor_sim_;
 
+  /// @note Wall-clock time of the phases of the frames, published once per second.
+  const rclcpp::Publisher<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr diagnostics_pub_;
+
+  std::chrono::steady_clock::time_point diagnostics_published_time_;
+
+  auto publishDiagnostics() -> void;
+
   auto initialize(const simulation_api_schema::InitializeRequest &)
     -> simulation_api_schema::InitializeResponse;
 
@@ -99,8 +111,10 @@ private:
   auto updateStepTime(const simulation_api_schema::UpdateStepTimeRequest &)
     -> simulation_api_schema::UpdateStepTimeResponse;
 
-  auto updateEntityStatus(const simulation_api_schema::UpdateEntityStatusRequest &)
-    -> simulation_api_schema::UpdateEntityStatusResponse;
+  /// @note Writes the response in place, since it has the status of every entity.
+  auto updateEntityStatus(
+    const simulation_api_schema::UpdateEntityStatusRequest &,
+    simulation_api_schema::UpdateEntityStatusResponse &) -> void;
 
   auto spawnVehicleEntity(const simulation_api_schema::SpawnVehicleEntityRequest &)
     -> simulation_api_schema::SpawnVehicleEntityResponse;
@@ -119,6 +133,13 @@ private:
   auto despawnEntity(const simulation_api_schema::DespawnEntityRequest &)
     -> simulation_api_schema::DespawnEntityResponse;
 
+  auto spawnEntities(const simulation_api_schema::SpawnEntitiesRequest &)
+    -> simulation_api_schema::SpawnEntitiesResponse;
+
+  /// @note The entities are removed in one pass over the entities of each type.
+  auto despawnEntities(const simulation_api_schema::DespawnEntitiesRequest &)
+    -> simulation_api_schema::DespawnEntitiesResponse;
+
   auto attachImuSensor(const simulation_api_schema::AttachImuSensorRequest &)
     -> simulation_api_schema::AttachImuSensorResponse;
 
@@ -139,6 +160,7 @@ private:
     -> simulation_api_schema::AttachPseudoTrafficLightDetectorResponse;
 
   int getSocketPort();
+  simulation_interface::TransportProtocol getTransportProtocol();
 
   std::vector<traffic_simulator_msgs::VehicleParameters> ego_vehicles_;
   std::vector<traffic_simulator_msgs::VehicleParameters> vehicles_;
@@ -151,6 +173,8 @@ private:
   rclcpp::Time current_ros_time_;
   bool initialized_;
   std::map<std::string, simulation_api_schema::EntityStatus> entity_status_;
+  /// @note Names of the entities by the handles given by the traffic simulator for the session.
+  std::unordered_map<std::uint32_t, std::string> entity_names_;
   simulation_api_schema::UpdateTrafficLightsRequest traffic_signals_states_;
   traffic_simulator_msgs::BoundingBox getBoundingBox(const std::string & name);
   zeromq::MultiServer server_;
@@ -158,6 +182,16 @@ private:
   std::shared_ptr<hdmap_utils::HdMapUtils> hdmap_utils_;
   std::shared_ptr<vehicle_simulation::EgoEntitySimulation> ego_entity_simulation_;
 
+  /**
+   * @brief If true, sensors render a frame while the traffic simulator computes the next one.
+   * @note The sensor delays are counted in simulation time of the rendered frame, so they do not
+   * depend on when the rendering ends.
+   */
+  bool pipeline_sensor_frames_ = false;
+  std::future<void> sensor_frame_;
+  /// @note Barrier before the next frame is rendered or the sensors are changed.
+  auto waitForSensorFrame() -> void;
+
   bool isEgo(const std::string & name);
   bool isEntityExists(const std::string & name);
 };
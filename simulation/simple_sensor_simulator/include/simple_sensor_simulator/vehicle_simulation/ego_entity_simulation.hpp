@@ -45,6 +45,9 @@ public:
 private:
   const VehicleModelType vehicle_model_type_;
 
+  /// @note The vehicle model is integrated this many times per frame, with the same input.
+  const std::size_t vehicle_model_sub_step_count_;
+
   const std::shared_ptr<SimModelInterface> vehicle_model_ptr_;
 
   std::optional<double> previous_linear_velocity_, previous_angular_velocity_;
@@ -57,6 +60,8 @@ private:
 
   static auto getVehicleModelType() -> VehicleModelType;
 
+  static auto getVehicleModelSubStepCount(const double step_time) -> std::size_t;
+
   static auto makeSimulationModel(
     const VehicleModelType, const double step_time,
     const traffic_simulator_msgs::msg::VehicleParameters &)
@@ -66,6 +71,30 @@ private:
 
   Eigen::Vector3d world_relative_position_;
 
+  /// @note Segment of the centerline the ego was on in the previous frame, see calculateEgoPitch.
+  struct CenterlineCursor
+  {
+    std::shared_ptr<const std::vector<geometry_msgs::msg::Point>> points;
+
+    lanelet::Id lanelet_id = 0;
+
+    std::size_t segment_index = 0;
+
+    double segment_start_s = 0.0;
+  };
+
+  mutable CenterlineCursor centerline_cursor_;
+
+  /// @note The route of Autoware as of the last lane matching, and its unique lanelets.
+  lanelet::Ids route_lanelets_;
+
+  lanelet::Ids unique_route_lanelets_;
+
+  /// @note The last pose matched to the lanelets, so a pose that did not move is not matched again.
+  std::optional<geometry_msgs::msg::Pose> matched_pose_;
+
+  std::optional<traffic_simulator::CanonicalizedLaneletPose> matched_lanelet_pose_;
+
 public:
   const std::shared_ptr<hdmap_utils::HdMapUtils> hdmap_utils_ptr_;
 
@@ -0,0 +1,59 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SIMPLE_PLANNING_SIMULATOR__VEHICLE_MODEL__DELAY_LINE_HPP_
+#define SIMPLE_PLANNING_SIMULATOR__VEHICLE_MODEL__DELAY_LINE_HPP_
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class DelayLine
+ * @brief fixed-capacity ring buffer delaying a command by a constant time
+ * @note The delay is rounded to a whole count of nominal steps. At the nominal step time, the
+ * output is the input of that count of steps before, as a queue of the same length would give.
+ * Other step times read the delayed input by linear interpolation between the samples around it.
+ */
+class DelayLine
+{
+public:
+  /**
+   * @brief allocate the buffer and fill it with zeros, as if they were input before the first step
+   * @param [in] delay time delay of the command [s]
+   * @param [in] dt nominal delta time [s]
+   * @note The capacity covers the delay with steps down to half the nominal one, shorter steps
+   * shorten the delay to the age of the oldest sample.
+   */
+  void initialize(const double delay, const double dt);
+
+  /**
+   * @brief step the delay line
+   * @param [in] input command of this step
+   * @param [in] dt delta time since the previous step [s]
+   * @return command delayed by the delay
+   */
+  double update(const double input, const double dt);
+
+private:
+  double delay_ = 0.0;  //!< @brief delay rounded to a whole count of nominal steps [s]
+  double time_ = 0.0;   //!< @brief time of the newest sample [s]
+
+  std::vector<double> values_;  //!< @brief inputs, in a ring
+  std::vector<double> times_;   //!< @brief times the inputs were given at [s]
+  std::size_t newest_ = 0;      //!< @brief index of the newest sample in the ring
+
+  double tolerance_ = 0.0;  //!< @brief difference of times considered as the same time [s]
+};
+
+#endif  // SIMPLE_PLANNING_SIMULATOR__VEHICLE_MODEL__DELAY_LINE_HPP_
@@ -15,14 +15,14 @@
 #ifndef SIMPLE_PLANNING_SIMULATOR__VEHICLE_MODEL__SIM_MODEL_DELAY_STEER_ACC_GEARED_HPP_
 #define SIMPLE_PLANNING_SIMULATOR__VEHICLE_MODEL__SIM_MODEL_DELAY_STEER_ACC_GEARED_HPP_
 
-#include <deque>
 #include <eigen3/Eigen/Core>
 #include <eigen3/Eigen/LU>
 #include <iostream>
 #include <queue>
+#include <simple_sensor_simulator/vehicle_simulation/vehicle_model/delay_line.hpp>
 #include <simple_sensor_simulator/vehicle_simulation/vehicle_model/sim_model_interface.hpp>
 
-class SimModelDelaySteerAccGeared : public SimModelInterface
+class SimModelDelaySteerAccGeared : public SimModelBase<6, 2>
 {
 public:
   /**
@@ -75,8 +75,8 @@ private:
   const double steer_rate_lim_;  //!< @brief steering angular velocity limit [rad/s]
   const double wheelbase_;       //!< @brief vehicle wheelbase length [m]
 
-  std::deque<double> acc_input_queue_;       //!< @brief buffer for accel command
-  std::deque<double> steer_input_queue_;     //!< @brief buffer for steering command
+  DelayLine acc_input_delay_line_;           //!< @brief buffer for accel command
+  DelayLine steer_input_delay_line_;         //!< @brief buffer for steering command
   const double acc_delay_;                   //!< @brief time delay for accel command [s]
   const double acc_time_constant_;           //!< @brief time constant for accel dynamics
   const double steer_delay_;                 //!< @brief time delay for steering command [s]
@@ -142,7 +142,7 @@ private:
    * @param [in] state current model state
    * @param [in] input input vector to model
    */
-  Eigen::VectorXd calcModel(const Eigen::VectorXd & state, const Eigen::VectorXd & input) override;
+  State calcModel(const State & state, const Input & input) override;
 
   /**
    * @brief update state considering current gear
@@ -152,7 +152,7 @@ private:
    * @param [in] dt delta time to update state
    */
   void updateStateWithGear(
-    Eigen::VectorXd & state, const Eigen::VectorXd & prev_state, const uint8_t gear,
+    State & state, const State & prev_state, const uint8_t gear,
     const double dt);
 };
 
@@ -15,13 +15,15 @@
 #ifndef SIMPLE_PLANNING_SIMULATOR__VEHICLE_MODEL__SIM_MODEL_DELAY_STEER_MAP_ACC_GEARED_HPP_
 #define SIMPLE_PLANNING_SIMULATOR__VEHICLE_MODEL__SIM_MODEL_DELAY_STEER_MAP_ACC_GEARED_HPP_
 
-#include <deque>
+#include <array>
 #include <fstream>
 #include <iostream>
 #include <queue>
+#include <simple_sensor_simulator/vehicle_simulation/vehicle_model/delay_line.hpp>
 #include <simple_sensor_simulator/vehicle_simulation/vehicle_model/sim_model_interface.hpp>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "eigen3/Eigen/Core"
@@ -173,38 +175,71 @@ public:
     vel_index_ = CSVLoader::getRowIndex(table);
     acc_index_ = CSVLoader::getColumnIndex(table);
     acceleration_map_ = CSVLoader::getMap(table);
+    resample();
 
     std::cout << "[SimModelDelaySteerMapAccGeared]: success to read acceleration map from "
               << csv_path << std::endl;
     return true;
   }
 
+  /**
+   * @brief bilinear interpolation in the cell of the resampled map holding the query
+   * @note When the desired acceleration or the velocity is out of the map, the closest value is
+   * used, so the acceleration is saturated to the edge of the throttle area.
+   */
   double getAcceleration(const double acc_des, const double vel) const
   {
-    std::vector<double> interpolated_acc_vec;
-    const double clamped_vel = CSVLoader::clampValue(vel, vel_index_, "acc: vel");
-
-    // (throttle, vel, acc) map => (throttle, acc) map by fixing vel
-    for (const auto & acc_vec : acceleration_map_) {
-      interpolated_acc_vec.push_back(interpolation::lerp(vel_index_, acc_vec, clamped_vel));
-    }
-    // calculate throttle
-    // When the desired acceleration is smaller than the throttle area, return min acc
-    // When the desired acceleration is greater than the throttle area, return max acc
-    const double clamped_acc = CSVLoader::clampValue(acc_des, acc_index_, "acceleration: acc");
-    const double acc = interpolation::lerp(acc_index_, interpolated_acc_vec, clamped_acc);
-
-    return acc;
+    const auto [i, t] = acc_axis_.locate(acc_des, "acceleration: acc");
+    const auto [j, s] = vel_axis_.locate(vel, "acc: vel");
+    const auto & [a, b, c, d] = cell_coefficients_[i * (vel_axis_.size - 1) + j];
+    return a + b * s + (c + d * s) * t;
   }
   std::vector<std::vector<double>> acceleration_map_;
 
 private:
+  /**
+   * @brief evenly spaced axis of the resampled map
+   * @note The spacing is the smallest one of the CSV index, so a uniform index is kept as is.
+   */
+  struct UniformAxis
+  {
+    static constexpr std::size_t max_size = 256;  //!< @brief bound of the grid points per axis
+
+    double min = 0.0;
+    double max = 0.0;
+    double step = 1.0;
+    std::size_t size = 0;
+
+    UniformAxis() = default;
+
+    explicit UniformAxis(const std::vector<double> & index);
+
+    double at(const std::size_t i) const { return i + 1 < size ? min + step * i : max; }
+
+    /**
+     * @brief find the cell of the axis holding the value
+     * @return index of the lower grid point and the ratio of the value in the cell
+     */
+    std::pair<std::size_t, double> locate(const double value, const char * name) const;
+  };
+
+  /**
+   * @brief sample the CSV map on the uniform grid and precompute the coefficients of each cell
+   */
+  void resample();
+
   std::string vehicle_name_;
   std::vector<double> vel_index_;
   std::vector<double> acc_index_;
+
+  UniformAxis vel_axis_;
+  UniformAxis acc_axis_;
+
+  /// @note acceleration = a + b * s + c * t + d * s * t, s and t are the ratios in the cell.
+  std::vector<std::array<double, 4>> cell_coefficients_;
 };
 
-class SimModelDelaySteerMapAccGeared : public SimModelInterface
+class SimModelDelaySteerMapAccGeared : public SimModelBase<6, 2>
 {
 public:
   /**
@@ -256,8 +291,8 @@ private:
   const double steer_rate_lim_;  //!< @brief steering angular velocity limit [rad/s]
   const double wheelbase_;       //!< @brief vehicle wheelbase length [m]
 
-  std::deque<double> acc_input_queue_;    //!< @brief buffer for accel command
-  std::deque<double> steer_input_queue_;  //!< @brief buffer for steering command
+  DelayLine acc_input_delay_line_;        //!< @brief buffer for accel command
+  DelayLine steer_input_delay_line_;      //!< @brief buffer for steering command
   const double acc_delay_;                //!< @brief time delay for accel command [s]
   const double acc_time_constant_;        //!< @brief time constant for accel dynamics
   const double steer_delay_;              //!< @brief time delay for steering command [s]
@@ -321,7 +356,7 @@ private:
    * @param [in] state current model state
    * @param [in] input input vector to model
    */
-  Eigen::VectorXd calcModel(const Eigen::VectorXd & state, const Eigen::VectorXd & input) override;
+  State calcModel(const State & state, const Input & input) override;
 
   /**
    * @brief update state considering current gear
@@ -331,7 +366,7 @@ private:
    * @param [in] dt delta time to update state
    */
   void updateStateWithGear(
-    Eigen::VectorXd & state, const Eigen::VectorXd & prev_state, const uint8_t gear,
+    State & state, const State & prev_state, const uint8_t gear,
     const double dt);
 };
 
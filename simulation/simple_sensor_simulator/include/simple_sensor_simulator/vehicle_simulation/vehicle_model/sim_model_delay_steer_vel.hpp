@@ -15,17 +15,17 @@
 #ifndef SIMPLE_PLANNING_SIMULATOR__VEHICLE_MODEL__SIM_MODEL_DELAY_STEER_VEL_HPP_
 #define SIMPLE_PLANNING_SIMULATOR__VEHICLE_MODEL__SIM_MODEL_DELAY_STEER_VEL_HPP_
 
-#include <deque>
 #include <eigen3/Eigen/Core>
 #include <eigen3/Eigen/LU>
 #include <iostream>
 #include <queue>
+#include <simple_sensor_simulator/vehicle_simulation/vehicle_model/delay_line.hpp>
 #include <simple_sensor_simulator/vehicle_simulation/vehicle_model/sim_model_interface.hpp>
 /**
  * @class SimModelDelaySteerVel
  * @brief calculate delay steering dynamics
  */
-class SimModelDelaySteerVel : public SimModelInterface
+class SimModelDelaySteerVel : public SimModelBase<5, 2>
 {
 public:
   /**
@@ -75,8 +75,8 @@ private:
   double prev_vx_ = 0.0;
   double current_ax_ = 0.0;
 
-  std::deque<double> vx_input_queue_;     //!< @brief buffer for velocity command
-  std::deque<double> steer_input_queue_;  //!< @brief buffer for angular velocity command
+  DelayLine vx_input_delay_line_;         //!< @brief buffer for velocity command
+  DelayLine steer_input_delay_line_;      //!< @brief buffer for angular velocity command
   const double vx_delay_;                 //!< @brief time delay for velocity command [s]
   const double vx_time_constant_;
   //!< @brief time constant for 1D model of velocity dynamics
@@ -142,7 +142,7 @@ private:
    * @param [in] state current model state
    * @param [in] input input vector to model
    */
-  Eigen::VectorXd calcModel(const Eigen::VectorXd & state, const Eigen::VectorXd & input) override;
+  State calcModel(const State & state, const Input & input) override;
 };
 
 #endif  // SIMPLE_PLANNING_SIMULATOR__VEHICLE_MODEL__SIM_MODEL_DELAY_STEER_VEL_HPP_
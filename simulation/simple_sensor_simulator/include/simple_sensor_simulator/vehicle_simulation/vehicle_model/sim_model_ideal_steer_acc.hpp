@@ -24,7 +24,7 @@
  * @class SimModelIdealSteerAcc
  * @brief calculate ideal steering dynamics
  */
-class SimModelIdealSteerAcc : public SimModelInterface
+class SimModelIdealSteerAcc : public SimModelBase<4, 2>
 {
 public:
   /**
@@ -98,7 +98,7 @@ private:
    * @param [in] state current model state
    * @param [in] input input vector to model
    */
-  Eigen::VectorXd calcModel(const Eigen::VectorXd & state, const Eigen::VectorXd & input) override;
+  State calcModel(const State & state, const Input & input) override;
 };
 
 #endif  // SIMPLE_PLANNING_SIMULATOR__VEHICLE_MODEL__SIM_MODEL_IDEAL_STEER_ACC_HPP_
@@ -24,7 +24,7 @@
  * @class SimModelIdealSteerAccGeared
  * @brief calculate ideal steering dynamics
  */
-class SimModelIdealSteerAccGeared : public SimModelInterface
+class SimModelIdealSteerAccGeared : public SimModelBase<4, 2>
 {
 public:
   /**
@@ -99,7 +99,7 @@ private:
    * @param [in] state current model state
    * @param [in] input input vector to model
    */
-  Eigen::VectorXd calcModel(const Eigen::VectorXd & state, const Eigen::VectorXd & input) override;
+  State calcModel(const State & state, const Input & input) override;
 
   /**
    * @brief update state considering current gear
@@ -109,7 +109,7 @@ private:
    * @param [in] dt delta time to update state
    */
   void updateStateWithGear(
-    Eigen::VectorXd & state, const Eigen::VectorXd & prev_state, const uint8_t gear,
+    State & state, const State & prev_state, const uint8_t gear,
     const double dt);
 };
 
@@ -25,15 +25,19 @@
 class SimModelInterface
 {
 protected:
-  const int dim_x_;        //!< @brief dimension of state x
-  const int dim_u_;        //!< @brief dimension of input u
-  Eigen::VectorXd state_;  //!< @brief vehicle state vector
-  Eigen::VectorXd input_;  //!< @brief vehicle input vector
+  const int dim_x_;  //!< @brief dimension of state x
+  const int dim_u_;  //!< @brief dimension of input u
 
   //!< @brief gear command defined in autoware_auto_msgs/GearCommand
   uint8_t gear_ = autoware_auto_vehicle_msgs::msg::GearCommand::DRIVE;
 
 public:
+  /**
+   * @brief vector of a state or an input of any model, without heap allocation
+   * @note 6 is the largest dimension of the models
+   */
+  using Vector = Eigen::Matrix<double, Eigen::Dynamic, 1, Eigen::ColMajor, 6, 1>;
+
   /**
    * @brief constructor
    * @param [in] dim_x dimension of state x
@@ -44,31 +48,31 @@ public:
   /**
    * @brief destructor
    */
-  ~SimModelInterface() = default;
+  virtual ~SimModelInterface() = default;
 
   /**
    * @brief get state vector of model
    * @param [out] state state vector
    */
-  void getState(Eigen::VectorXd & state);
+  virtual void getState(Vector & state) = 0;
 
   /**
    * @brief get input vector of model
    * @param [out] input input vector
    */
-  void getInput(Eigen::VectorXd & input);
+  virtual void getInput(Vector & input) = 0;
 
   /**
    * @brief set state vector of model
    * @param [in] state state vector
    */
-  void setState(const Eigen::VectorXd & state);
+  virtual void setState(const Vector & state) = 0;
 
   /**
    * @brief set input vector of model
    * @param [in] input input vector
    */
-  void setInput(const Eigen::VectorXd & input);
+  virtual void setInput(const Vector & input) = 0;
 
   /**
    * @brief set gear
@@ -76,20 +80,6 @@ public:
    */
   void setGear(const uint8_t gear);
 
-  /**
-   * @brief update vehicle states with Runge-Kutta methods
-   * @param [in] dt delta time [s]
-   * @param [in] input vehicle input
-   */
-  void updateRungeKutta(const double & dt, const Eigen::VectorXd & input);
-
-  /**
-   * @brief update vehicle states with Euler methods
-   * @param [in] dt delta time [s]
-   * @param [in] input vehicle input
-   */
-  void updateEuler(const double & dt, const Eigen::VectorXd & input);
-
   /**
    * @brief update vehicle states
    * @param [in] dt delta time [s]
@@ -150,14 +140,68 @@ public:
    * @brief get input vector dimension
    */
   inline int getDimU() { return dim_u_; }
+};
+
+/**
+ * @class SimModelBase
+ * @brief vehicle model class with its state and input vectors of fixed size
+ * @note The integration of the states does not allocate, including the temporaries of Runge-Kutta.
+ */
+template <int DimX, int DimU>
+class SimModelBase : public SimModelInterface
+{
+public:
+  using State = Eigen::Matrix<double, DimX, 1>;
+  using Input = Eigen::Matrix<double, DimU, 1>;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+protected:
+  State state_ = State::Zero();  //!< @brief vehicle state vector
+  Input input_ = Input::Zero();  //!< @brief vehicle input vector
+
+  SimModelBase() : SimModelInterface(DimX, DimU) {}
+
+  /**
+   * @brief update vehicle states with Runge-Kutta methods
+   * @param [in] dt delta time [s]
+   * @param [in] input vehicle input
+   */
+  void updateRungeKutta(const double & dt, const Input & input)
+  {
+    const State k1 = calcModel(state_, input);
+    const State k2 = calcModel(state_ + k1 * 0.5 * dt, input);
+    const State k3 = calcModel(state_ + k2 * 0.5 * dt, input);
+    const State k4 = calcModel(state_ + k3 * dt, input);
+
+    state_ += 1.0 / 6.0 * (k1 + 2.0 * k2 + 2.0 * k3 + k4) * dt;
+  }
+
+  /**
+   * @brief update vehicle states with Euler methods
+   * @param [in] dt delta time [s]
+   * @param [in] input vehicle input
+   */
+  void updateEuler(const double & dt, const Input & input)
+  {
+    state_ += calcModel(state_, input) * dt;
+  }
 
   /**
    * @brief calculate derivative of states with vehicle model
    * @param [in] state current model state
    * @param [in] input input vector to model
    */
-  virtual Eigen::VectorXd calcModel(
-    const Eigen::VectorXd & state, const Eigen::VectorXd & input) = 0;
+  virtual State calcModel(const State & state, const Input & input) = 0;
+
+public:
+  void getState(Vector & state) override { state = state_; }
+
+  void getInput(Vector & input) override { input = input_; }
+
+  void setState(const Vector & state) override { state_ = state; }
+
+  void setInput(const Vector & input) override { input_ = input; }
 };
 
 #endif  // SIMPLE_PLANNING_SIMULATOR__VEHICLE_MODEL__SIM_MODEL_INTERFACE_HPP_
@@ -13,32 +13,27 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <array>
 #include <autoware_auto_perception_msgs/msg/detected_objects.hpp>
 #include <autoware_auto_perception_msgs/msg/tracked_objects.hpp>
 #include <boost/uuid/string_generator.hpp>
 #include <boost/uuid/uuid.hpp>
+#include <arithmetic/random/normal.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
 #include <geometry/quaternion/get_rotation_matrix.hpp>
-#include <geometry/vector3/hypot.hpp>
 #include <memory>
 #include <random>
 #include <simple_sensor_simulator/exception.hpp>
 #include <simple_sensor_simulator/sensor_simulation/detection_sensor/detection_sensor.hpp>
+#include <simple_sensor_simulator/sensor_simulation/lidar/raycaster.hpp>
 #include <simulation_interface/conversions.hpp>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace simple_sensor_simulator
 {
-auto distance(const geometry_msgs::Pose & pose1, const geometry_msgs::Pose & pose2)
-{
-  return std::hypot(
-    pose1.position().x() - pose2.position().x(),  //
-    pose1.position().y() - pose2.position().y(),  //
-    pose1.position().z() - pose2.position().z());
-}
-
 auto DetectionSensorBase::isEgoEntityStatusToWhichThisSensorIsAttached(
   const traffic_simulator_msgs::EntityStatus & status) const -> bool
 {
@@ -65,6 +60,39 @@ auto DetectionSensorBase::findEgoEntityStatusToWhichThisSensorIsAttached(
 template <typename To, typename... From>
 auto make(From &&...) -> To;
 
+/**
+ * @brief Targets of the rays of the visibility test, the center and the corners of the bounding
+ * box of the entity in the map coordinate.
+ * @note The corners are pulled towards the center, so the rays hit the box instead of grazing it.
+ */
+auto getVisibilityTargets(const traffic_simulator_msgs::EntityStatus & status)
+  -> std::vector<geometry_msgs::msg::Point>
+{
+  /// @note Hard coded parameter, ratio of the distance from the center to the corners.
+  constexpr double corner_ratio = 0.8;
+  geometry_msgs::msg::Pose pose;
+  simulation_interface::toMsg(status.pose(), pose);
+  const auto rotation = math::geometry::getRotationMatrix(pose.orientation);
+  const auto & center = status.bounding_box().center();
+  const auto & dimensions = status.bounding_box().dimensions();
+  std::vector<geometry_msgs::msg::Point> targets;
+  targets.reserve(9);
+  for (const auto [x, y, z] : std::vector<std::array<double, 3>>{
+         {0, 0, 0}, {1, 1, 1}, {1, 1, -1}, {1, -1, 1}, {1, -1, -1}, {-1, 1, 1}, {-1, 1, -1},
+         {-1, -1, 1}, {-1, -1, -1}}) {
+    const Eigen::Vector3d local(
+      center.x() + x * corner_ratio * dimensions.x() * 0.5,
+      center.y() + y * corner_ratio * dimensions.y() * 0.5,
+      center.z() + z * corner_ratio * dimensions.z() * 0.5);
+    const Eigen::Vector3d global = rotation * local;
+    targets.push_back(geometry_msgs::build<geometry_msgs::msg::Point>()
+                        .x(pose.position.x + global.x())
+                        .y(pose.position.y + global.y())
+                        .z(pose.position.z + global.z()));
+  }
+  return targets;
+}
+
 template <>
 auto make(const traffic_simulator_msgs::EntityStatus & status) -> unique_identifier_msgs::msg::UUID
 {
@@ -199,14 +227,14 @@ auto make(const traffic_simulator_msgs::EntityStatus & status)
 
 template <>
 auto make(
-  const traffic_simulator_msgs::EntityStatus & status,
+  const unique_identifier_msgs::msg::UUID & uuid,
   const autoware_auto_perception_msgs::msg::DetectedObject & detected_object)
   -> autoware_auto_perception_msgs::msg::TrackedObject
 {
   // ref: https://github.com/autowarefoundation/autoware.universe/blob/main/common/perception_utils/src/conversion.cpp
   auto tracked_object = autoware_auto_perception_msgs::msg::TrackedObject();
   // clang-format off
-  tracked_object.object_id                           = make<unique_identifier_msgs::msg::UUID>(status);
+  tracked_object.object_id                           = uuid;
   tracked_object.existence_probability               = detected_object.existence_probability;
   tracked_object.classification                      = detected_object.classification;
   tracked_object.kinematics.orientation_availability = detected_object.kinematics.orientation_availability;
@@ -225,14 +253,14 @@ struct DefaultNoiseApplicator
 
   const traffic_simulator_msgs::EntityStatus & ego_entity_status;
 
-  std::default_random_engine & random_engine;
+  math::arithmetic::Philox4x32 & random_engine;
 
   const simulation_api_schema::DetectionSensorConfiguration & detection_sensor_configuration;
 
   explicit DefaultNoiseApplicator(
     double current_simulation_time, const rclcpp::Time & current_ros_time,
     const traffic_simulator_msgs::EntityStatus & ego_entity_status,
-    std::default_random_engine & random_engine,
+    math::arithmetic::Philox4x32 & random_engine,
     const simulation_api_schema::DetectionSensorConfiguration & detection_sensor_configuration)
   : current_simulation_time(current_simulation_time),
     current_ros_time(current_ros_time),
@@ -253,14 +281,16 @@ struct DefaultNoiseApplicator
   auto operator()(autoware_auto_perception_msgs::msg::DetectedObjects detected_objects)
     -> decltype(auto)
   {
-    auto position_noise_distribution =
-      std::normal_distribution<>(0.0, detection_sensor_configuration.pos_noise_stddev());
-
-    for (auto && detected_object : detected_objects.objects) {
-      detected_object.kinematics.pose_with_covariance.pose.position.x +=
-        position_noise_distribution(random_engine);
-      detected_object.kinematics.pose_with_covariance.pose.position.y +=
-        position_noise_distribution(random_engine);
+    // The noises of all the objects are drawn at once, x and y of each object in turn
+    auto position_noises = std::vector<double>(detected_objects.objects.size() * 2);
+    math::arithmetic::fillNormal(
+      random_engine, position_noises.begin(), position_noises.end(), 0.0,
+      detection_sensor_configuration.pos_noise_stddev());
+
+    for (std::size_t i = 0; i < detected_objects.objects.size(); ++i) {
+      auto & position = detected_objects.objects[i].kinematics.pose_with_covariance.pose.position;
+      position.x += position_noises[i * 2];
+      position.y += position_noises[i * 2 + 1];
     }
 
     detected_objects.objects.erase(
@@ -298,11 +328,23 @@ struct CustomNoiseApplicator : public DefaultNoiseApplicator
   // }
 };
 
+template <>
+auto DetectionSensor<autoware_auto_perception_msgs::msg::DetectedObjects>::getUUID(
+  const traffic_simulator_msgs::EntityStatus & status) -> const unique_identifier_msgs::msg::UUID &
+{
+  if (auto iter = uuids_.find(status.name()); iter != uuids_.end()) {
+    return iter->second;
+  } else {
+    return uuids_.emplace(status.name(), make<unique_identifier_msgs::msg::UUID>(status))
+      .first->second;
+  }
+}
+
 template <>
 auto DetectionSensor<autoware_auto_perception_msgs::msg::DetectedObjects>::update(
   const double current_simulation_time,
   const std::vector<traffic_simulator_msgs::EntityStatus> & statuses,
-  const rclcpp::Time & current_ros_time, const std::vector<std::string> & lidar_detected_entities)
+  const rclcpp::Time & current_ros_time, const std::vector<bool> & lidar_detected_entities)
   -> void
 {
   if (
@@ -319,40 +361,94 @@ auto DetectionSensor<autoware_auto_perception_msgs::msg::DetectedObjects>::updat
 
     const auto ego_entity_status = findEgoEntityStatusToWhichThisSensorIsAttached(statuses);
 
-    auto is_in_range = [&](const auto & status) {
-      return not isEgoEntityStatusToWhichThisSensorIsAttached(status) and
-             distance(status.pose(), ego_entity_status->pose()) <= configuration_.range() and
-             (configuration_.detect_all_objects_in_range() or
-              std::find(
-                lidar_detected_entities.begin(), lidar_detected_entities.end(), status.name()) !=
-                lidar_detected_entities.end());
+    /*
+       The ground truth is only built when somebody listens to it, so that
+       the simulator does not pay for the tracked objects otherwise.
+    */
+    const auto publishes_ground_truth =
+      ground_truth_objects_publisher and
+      ground_truth_objects_publisher->get_subscription_count() > 0;
+
+    positions_.resize(statuses.size() * 3);
+    for (std::size_t index = 0; index < statuses.size(); ++index) {
+      const auto & position = statuses[index].pose().position();
+      positions_[index * 3] = position.x();
+      positions_[index * 3 + 1] = position.y();
+      positions_[index * 3 + 2] = position.z();
+    }
+
+    const auto & ego_position = ego_entity_status->pose().position();
+    const auto squared_range = configuration_.range() * configuration_.range();
+
+    /*
+       The visibility test traces a few rays to each entity in range, instead of depending on a
+       LiDAR scan of the whole field of view. The scene is committed here if no LiDAR has done it
+       in this frame.
+    */
+    const auto tests_visibility = raycaster_ptr_ and configuration_.visibility_test() and
+                                  not configuration_.detect_all_objects_in_range();
+    /// @note The ray mask is taken before the commit, so the scene keeps the rays off the ego.
+    const auto ray_mask = tests_visibility ? raycaster_ptr_->getRayMask(configuration_.entity())
+                                           : 0b11111111'11111111'11111111'11111111;
+    if (tests_visibility) {
+      raycaster_ptr_->commit(current_ros_time, statuses);
+    }
+    const auto sensor_position = geometry_msgs::build<geometry_msgs::msg::Point>()
+                                   .x(ego_position.x())
+                                   .y(ego_position.y())
+                                   .z(ego_position.z());
+
+    auto is_detected = [&](const auto index) {
+      if (configuration_.detect_all_objects_in_range()) {
+        return true;
+      } else if (tests_visibility) {
+        return raycaster_ptr_->isVisible(
+          sensor_position, statuses[index].name(), getVisibilityTargets(statuses[index]), ray_mask);
+      } else {
+        return static_cast<bool>(lidar_detected_entities[index]);
+      }
+    };
+
+    auto is_in_range = [&](const auto index) {
+      const auto x = positions_[index * 3] - ego_position.x();
+      const auto y = positions_[index * 3 + 1] - ego_position.y();
+      const auto z = positions_[index * 3 + 2] - ego_position.z();
+      return x * x + y * y + z * z <= squared_range and
+             not isEgoEntityStatusToWhichThisSensorIsAttached(statuses[index]) and
+             is_detected(index);
     };
 
-    for (const auto & status : statuses) {
-      if (is_in_range(status)) {
-        const auto detected_object =
-          make<autoware_auto_perception_msgs::msg::DetectedObject>(status);
-        detected_objects.objects.push_back(detected_object);
-        ground_truth_objects.objects.push_back(
-          make<autoware_auto_perception_msgs::msg::TrackedObject>(status, detected_object));
+    for (std::size_t index = 0; index < statuses.size(); ++index) {
+      if (is_in_range(index)) {
+        const auto & status = statuses[index];
+        detected_objects.objects.push_back(
+          make<autoware_auto_perception_msgs::msg::DetectedObject>(status));
+        if (publishes_ground_truth) {
+          ground_truth_objects.objects.push_back(
+            make<autoware_auto_perception_msgs::msg::TrackedObject>(
+              getUUID(status), detected_objects.objects.back()));
+        }
       }
     }
 
-    if (detected_objects_queue.emplace(detected_objects, current_simulation_time);
-        current_simulation_time - detected_objects_queue.front().second >=
+    if (detected_objects_queue.push(std::move(detected_objects), current_simulation_time);
+        current_simulation_time - detected_objects_queue.frontTime() >=
         configuration_.object_recognition_delay()) {
       auto apply_noise = CustomNoiseApplicator(
         current_simulation_time, current_ros_time, *ego_entity_status, random_engine_,
         configuration_);
-      detected_objects_publisher->publish(apply_noise(detected_objects_queue.front().first));
-      detected_objects_queue.pop();
+      detected_objects_publisher->publish(apply_noise(detected_objects_queue.pop()));
+    }
+
+    if (publishes_ground_truth) {
+      ground_truth_objects_queue.push(std::move(ground_truth_objects), current_simulation_time);
     }
 
-    if (ground_truth_objects_queue.emplace(ground_truth_objects, current_simulation_time);
-        current_simulation_time - ground_truth_objects_queue.front().second >=
+    if (
+      not ground_truth_objects_queue.empty() and
+      current_simulation_time - ground_truth_objects_queue.frontTime() >=
         configuration_.object_recognition_ground_truth_delay()) {
-      ground_truth_objects_publisher->publish(ground_truth_objects_queue.front().first);
-      ground_truth_objects_queue.pop();
+      ground_truth_objects_publisher->publish(ground_truth_objects_queue.pop());
     }
   }
 }
@@ -17,6 +17,8 @@
 #include <tf2/LinearMath/Transform.h>
 
 #include <algorithm>
+#include <arithmetic/random/normal.hpp>
+#include <array>
 #include <geometry/quaternion/euler_to_quaternion.hpp>
 #include <geometry/quaternion/quaternion_to_euler.hpp>
 #include <simple_sensor_simulator/sensor_simulation/imu/imu_sensor.hpp>
@@ -28,12 +30,14 @@ auto ImuSensor<sensor_msgs::msg::Imu>::generateMessage(
   const rclcpp::Time & current_ros_time,
   const traffic_simulator_msgs::msg::EntityStatus & status) const -> const sensor_msgs::msg::Imu
 {
-  const auto applyNoise =
-    [&](geometry_msgs::msg::Vector3 & v, std::normal_distribution<> & distribution) {
-      v.x += distribution(random_generator_);
-      v.y += distribution(random_generator_);
-      v.z += distribution(random_generator_);
-    };
+  const auto applyNoise = [&](geometry_msgs::msg::Vector3 & v, const double standard_deviation) {
+    std::array<double, 3> noise;
+    math::arithmetic::fillNormal(
+      random_generator_, noise.begin(), noise.end(), 0.0, standard_deviation);
+    v.x += noise[0];
+    v.y += noise[1];
+    v.z += noise[2];
+  };
 
   auto imu_msg = sensor_msgs::msg::Imu();
   imu_msg.header.stamp = current_ros_time;
@@ -45,13 +49,13 @@ auto ImuSensor<sensor_msgs::msg::Imu>::generateMessage(
 
   // Apply noise
   if (noise_standard_deviation_orientation_ > 0.0) {
-    applyNoise(orientation_rpy, noise_distribution_orientation_);
+    applyNoise(orientation_rpy, noise_standard_deviation_orientation_);
   }
   if (noise_standard_deviation_twist_ > 0.0) {
-    applyNoise(twist.angular, noise_distribution_twist_);
+    applyNoise(twist.angular, noise_standard_deviation_twist_);
   }
   if (noise_standard_deviation_acceleration_ > 0.0) {
-    applyNoise(accel.linear, noise_distribution_acceleration_);
+    applyNoise(accel.linear, noise_standard_deviation_acceleration_);
   }
 
   // Apply gravity
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cmath>
 #include <memory>
 #include <optional>
 #include <simple_sensor_simulator/exception.hpp>
@@ -25,42 +26,32 @@ namespace simple_sensor_simulator
 template <>
 auto LidarSensor<sensor_msgs::msg::PointCloud2>::raycast(
   const std::vector<traffic_simulator_msgs::EntityStatus> & entities,
-  const rclcpp::Time & current_ros_time) -> sensor_msgs::msg::PointCloud2
+  const rclcpp::Time & current_ros_time, const std::size_t first_ray, const std::size_t last_ray)
+  -> sensor_msgs::msg::PointCloud2
 {
   std::optional<geometry_msgs::msg::Pose> ego_pose;
-
   for (const auto & entity : entities) {
     if (configuration_.entity() == entity.name()) {
       geometry_msgs::msg::Pose pose;
       simulation_interface::toMsg(entity.pose(), pose);
       ego_pose = pose;
-    } else {
-      geometry_msgs::msg::Pose pose;
-      simulation_interface::toMsg(entity.pose(), pose);
-      auto rotation = math::geometry::getRotationMatrix(pose.orientation);
-      geometry_msgs::msg::Point center_point;
-      simulation_interface::toMsg(entity.bounding_box().center(), center_point);
-      Eigen::Vector3d center(center_point.x, center_point.y, center_point.z);
-      center = rotation * center;
-      pose.position.x = pose.position.x + center.x();
-      pose.position.y = pose.position.y + center.y();
-      pose.position.z = pose.position.z + center.z();
-      raycaster_.addPrimitive<simple_sensor_simulator::primitives::Box>(
-        entity.name(),                           //
-        entity.bounding_box().dimensions().x(),  //
-        entity.bounding_box().dimensions().y(),  //
-        entity.bounding_box().dimensions().z(),  //
-        pose);
     }
   }
 
+  /*
+     The first LiDAR raycasting in this frame updates the scene shared by the LiDARs of all the
+     entities, so it holds every entity, and the ray mask keeps each LiDAR off its own entity. The
+     levels of detail of the models follow the distance to the entity of this LiDAR.
+  */
+  raycaster_ptr_->commit(
+    current_ros_time, entities,
+    ego_pose ? std::make_optional(ego_pose->position) : std::nullopt);
+
   if (ego_pose) {
-    std::vector<double> vertical_angles;
-    for (const auto vertical_angle : configuration_.vertical_angles()) {
-      vertical_angles.push_back(vertical_angle);
-    }
-    const auto pointcloud = raycaster_.raycast("base_link", current_ros_time, ego_pose.value());
-    detected_objects_ = raycaster_.getDetectedObject();
+    auto pointcloud = raycaster_ptr_->raycast(
+      ray_directions_, first_ray, last_ray, "base_link", current_ros_time, ego_pose.value(), 300, 0,
+      ray_mask_);
+    detected_objects_ = raycaster_ptr_->getDetectedObject();
     return pointcloud;
   } else {
     throw simple_sensor_simulator::SimulationRuntimeError("failed to find ego vehicle");
@@ -13,34 +13,130 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <cmath>
+#include <iomanip>
 #include <iostream>
+#include <mutex>
+#include <sensor_msgs/point_cloud2_iterator.hpp>
+#include <set>
+#include <simple_sensor_simulator/exception.hpp>
 #include <simple_sensor_simulator/sensor_simulation/lidar/lidar_sensor.hpp>
 #include <simple_sensor_simulator/sensor_simulation/lidar/raycaster.hpp>
+#include <simulation_interface/conversions.hpp>
+#include <sstream>
+#include <status_monitor/trace.hpp>
 #include <string>
+#include <thread>
+#include <traffic_simulator/utils/thread_pool.hpp>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 namespace simple_sensor_simulator
 {
+namespace
+{
+/// @note Shared by all the raycasters, so the threads are created once per process.
+auto getThreadPool() -> traffic_simulator::ThreadPool &
+{
+  // Run as many threads as physical cores (which is usually /2 virtual threads)
+  // In heavy loads virtual threads (hyper-threading) add little to the overall performance
+  static traffic_simulator::ThreadPool thread_pool(
+    std::max(1u, std::thread::hardware_concurrency() / 2));
+  return thread_pool;
+}
+
+auto getPacketSize(RTCDevice device) -> std::size_t
+{
+  if (rtcGetDeviceProperty(device, RTC_DEVICE_PROPERTY_NATIVE_RAY16_SUPPORTED)) {
+    return 16;
+  } else if (rtcGetDeviceProperty(device, RTC_DEVICE_PROPERTY_NATIVE_RAY8_SUPPORTED)) {
+    return 8;
+  } else {
+    return 1;
+  }
+}
+
+/// @note Affine transform of the pose, in the column major 3x4 layout read by Embree.
+auto toTransform(const geometry_msgs::msg::Pose & pose) -> Eigen::Matrix<float, 3, 4>
+{
+  Eigen::Matrix<float, 3, 4> transform;
+  transform.leftCols<3>() = math::geometry::getRotationMatrix(pose.orientation).cast<float>();
+  transform.col(3) = Eigen::Vector3f(pose.position.x, pose.position.y, pose.position.z);
+  return transform;
+}
+
+auto isSameShape(const std::vector<Vertex> & lhs, const std::vector<Vertex> & rhs) -> bool
+{
+  return std::equal(
+    lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), [](const auto & v0, const auto & v1) {
+      return v0.x == v1.x and v0.y == v1.y and v0.z == v1.z;
+    });
+}
+
+/// @note Id of the instance if the ray hit one, since every primitive is instanced.
+auto getHitIdentifier(unsigned int geometry_id, unsigned int instance_id) -> unsigned int
+{
+  return instance_id != RTC_INVALID_GEOMETRY_ID ? instance_id : geometry_id;
+}
+
+template <std::size_t PacketSize>
+struct RayHitPacket;
+
+template <>
+struct RayHitPacket<8>
+{
+  using type = RTCRayHit8;
+
+  static void intersect(const int * valid, RTCScene scene, RTCRayHit8 & rayhit)
+  {
+    rtcIntersect8(valid, scene, &rayhit);
+  }
+};
+
+template <>
+struct RayHitPacket<16>
+{
+  using type = RTCRayHit16;
+
+  static void intersect(const int * valid, RTCScene scene, RTCRayHit16 & rayhit)
+  {
+    rtcIntersect16(valid, scene, &rayhit);
+  }
+};
+}  // namespace
+
 Raycaster::Raycaster()
 : primitive_ptrs_(0),
   device_(rtcNewDevice(nullptr)),
   scene_(rtcNewScene(device_)),
-  engine_(seed_gen_())
+  packet_size_(getPacketSize(device_))
 {
+  rtcSetSceneFlags(scene_, RTC_SCENE_FLAG_DYNAMIC);
+  rtcSetSceneBuildQuality(scene_, RTC_BUILD_QUALITY_LOW);
 }
 
 Raycaster::Raycaster(std::string embree_config)
 : primitive_ptrs_(0),
   device_(rtcNewDevice(embree_config.c_str())),
   scene_(rtcNewScene(device_)),
-  engine_(seed_gen_())
+  packet_size_(getPacketSize(device_))
 {
+  rtcSetSceneFlags(scene_, RTC_SCENE_FLAG_DYNAMIC);
+  rtcSetSceneBuildQuality(scene_, RTC_BUILD_QUALITY_LOW);
 }
 
 Raycaster::~Raycaster()
 {
+  for (const auto & [name, instance] : instances_) {
+    release(instance);
+  }
+  for (const auto & instance : static_instances_) {
+    release(instance);
+  }
+  for (const auto & [key, prototype] : shared_prototypes_) {
+    rtcReleaseScene(prototype);
+  }
   rtcReleaseScene(scene_);
   rtcReleaseDevice(device_);
 }
@@ -49,101 +145,467 @@ void Raycaster::setDirection(
   const simulation_api_schema::LidarConfiguration & configuration, double horizontal_angle_start,
   double horizontal_angle_end)
 {
-  std::vector<double> vertical_angles;
-  for (const auto v : configuration.vertical_angles()) {
-    vertical_angles.emplace_back(v);
-  }
-
-  auto quat_directions = getDirections(
-    vertical_angles, horizontal_angle_start, horizontal_angle_end,
-    configuration.horizontal_resolution());
-  rotation_matrices_.clear();
-  for (const auto & q : quat_directions) {
-    rotation_matrices_.push_back(math::geometry::getRotationMatrix(q));
-  }
-}
-
-std::vector<geometry_msgs::msg::Quaternion> Raycaster::getDirections(
-  const std::vector<double> & vertical_angles, double horizontal_angle_start,
-  double horizontal_angle_end, double horizontal_resolution)
-{
-  if (
-    directions_.empty() || previous_horizontal_angle_start_ != horizontal_angle_start ||
-    previous_horizontal_angle_end_ != horizontal_angle_end ||
-    previous_horizontal_resolution_ != horizontal_resolution ||
-    previous_vertical_angles_ != vertical_angles) {
-    std::vector<geometry_msgs::msg::Quaternion> directions;
-    double horizontal_angle = horizontal_angle_start;
-    while (horizontal_angle <= horizontal_angle_end) {
-      horizontal_angle = horizontal_angle + horizontal_resolution;
-      for (const auto vertical_angle : vertical_angles) {
-        geometry_msgs::msg::Vector3 rpy;
-        rpy.x = 0;
-        rpy.y = vertical_angle;
-        rpy.z = horizontal_angle;
-        auto quat = math::geometry::convertEulerAngleToQuaternion(rpy);
-        directions.emplace_back(quat);
+  ray_directions_ = makeDirections(configuration, horizontal_angle_start, horizontal_angle_end);
+}
+
+Raycaster::RayDirections Raycaster::makeDirections(
+  const simulation_api_schema::LidarConfiguration & configuration, double horizontal_angle_start,
+  double horizontal_angle_end) const
+{
+  /*
+     The direction of a ray is the first column of the rotation of roll 0, pitch the vertical
+     angle and yaw the horizontal angle, computed here once per LiDAR so tracing a ray only rotates
+     it to the pose of the sensor.
+  */
+  RayDirections directions;
+  double horizontal_angle = horizontal_angle_start;
+  while (horizontal_angle <= horizontal_angle_end) {
+    horizontal_angle = horizontal_angle + configuration.horizontal_resolution();
+    const auto cos_horizontal = std::cos(horizontal_angle);
+    const auto sin_horizontal = std::sin(horizontal_angle);
+    for (const double vertical_angle : configuration.vertical_angles()) {
+      directions.x.push_back(cos_horizontal * std::cos(vertical_angle));
+      directions.y.push_back(sin_horizontal * std::cos(vertical_angle));
+      directions.z.push_back(-std::sin(vertical_angle));
+    }
+  }
+  return directions;
+}
+
+void Raycaster::intersect(
+  const RayDirections & directions, std::size_t begin, std::size_t end,
+  const geometry_msgs::msg::Pose & origin, double max_distance, double min_distance,
+  unsigned int ray_mask, pcl::PointCloud<pcl::PointXYZI> & cloud,
+  std::set<unsigned int> & detected_ids) const
+{
+  const Eigen::Matrix3f orientation_matrix =
+    math::geometry::getRotationMatrix(origin.orientation).cast<float>();
+  for (std::size_t i = begin; i < end; ++i) {
+    RTCRayHit rayhit = {};
+    rayhit.ray.org_x = origin.position.x;
+    rayhit.ray.org_y = origin.position.y;
+    rayhit.ray.org_z = origin.position.z;
+    rayhit.ray.mask = ray_mask;
+    rayhit.ray.tfar = max_distance;
+    rayhit.ray.tnear = min_distance;
+    rayhit.ray.flags = false;
+
+    const Eigen::Vector3f direction =
+      orientation_matrix * Eigen::Vector3f(directions.x[i], directions.y[i], directions.z[i]);
+    rayhit.ray.dir_x = direction.x();
+    rayhit.ray.dir_y = direction.y();
+    rayhit.ray.dir_z = direction.z();
+    rayhit.hit.geomID = RTC_INVALID_GEOMETRY_ID;
+    rayhit.hit.instID[0] = RTC_INVALID_GEOMETRY_ID;
+    rtcIntersect1(scene_, &rayhit);
+
+    if (rayhit.hit.geomID != RTC_INVALID_GEOMETRY_ID) {
+      pcl::PointXYZI p;
+      {
+        p.x = directions.x[i] * rayhit.ray.tfar;
+        p.y = directions.y[i] * rayhit.ray.tfar;
+        p.z = directions.z[i] * rayhit.ray.tfar;
+      }
+      cloud.emplace_back(p);
+      detected_ids.insert(getHitIdentifier(rayhit.hit.geomID, rayhit.hit.instID[0]));
+    }
+  }
+}
+
+template <std::size_t PacketSize>
+void Raycaster::intersectPackets(
+  const RayDirections & directions, std::size_t begin, std::size_t end,
+  const geometry_msgs::msg::Pose & origin, double max_distance, double min_distance,
+  unsigned int ray_mask, pcl::PointCloud<pcl::PointXYZI> & cloud,
+  std::set<unsigned int> & detected_ids) const
+{
+  const Eigen::Matrix3f orientation_matrix =
+    math::geometry::getRotationMatrix(origin.orientation).cast<float>();
+  for (std::size_t first = begin; first < end; first += PacketSize) {
+    const auto size = std::min(PacketSize, end - first);
+    alignas(64) int valid[PacketSize];
+    alignas(64) typename RayHitPacket<PacketSize>::type rayhit = {};
+    for (std::size_t lane = 0; lane < PacketSize; ++lane) {
+      rayhit.hit.geomID[lane] = RTC_INVALID_GEOMETRY_ID;
+      rayhit.hit.instID[0][lane] = RTC_INVALID_GEOMETRY_ID;
+      if (lane < size) {
+        const auto i = first + lane;
+        valid[lane] = -1;
+        rayhit.ray.org_x[lane] = origin.position.x;
+        rayhit.ray.org_y[lane] = origin.position.y;
+        rayhit.ray.org_z[lane] = origin.position.z;
+        rayhit.ray.mask[lane] = ray_mask;
+        rayhit.ray.tfar[lane] = max_distance;
+        rayhit.ray.tnear[lane] = min_distance;
+        rayhit.ray.dir_x[lane] = orientation_matrix(0, 0) * directions.x[i] +
+                                 orientation_matrix(0, 1) * directions.y[i] +
+                                 orientation_matrix(0, 2) * directions.z[i];
+        rayhit.ray.dir_y[lane] = orientation_matrix(1, 0) * directions.x[i] +
+                                 orientation_matrix(1, 1) * directions.y[i] +
+                                 orientation_matrix(1, 2) * directions.z[i];
+        rayhit.ray.dir_z[lane] = orientation_matrix(2, 0) * directions.x[i] +
+                                 orientation_matrix(2, 1) * directions.y[i] +
+                                 orientation_matrix(2, 2) * directions.z[i];
+      } else {
+        valid[lane] = 0;
+      }
+    }
+    RayHitPacket<PacketSize>::intersect(valid, scene_, rayhit);
+
+    for (std::size_t lane = 0; lane < size; ++lane) {
+      if (rayhit.hit.geomID[lane] != RTC_INVALID_GEOMETRY_ID) {
+        const auto i = first + lane;
+        pcl::PointXYZI p;
+        {
+          p.x = directions.x[i] * rayhit.ray.tfar[lane];
+          p.y = directions.y[i] * rayhit.ray.tfar[lane];
+          p.z = directions.z[i] * rayhit.ray.tfar[lane];
+        }
+        cloud.emplace_back(p);
+        detected_ids.insert(getHitIdentifier(rayhit.hit.geomID[lane], rayhit.hit.instID[0][lane]));
       }
     }
-    directions_ = directions;
-    previous_horizontal_angle_end_ = horizontal_angle_end;
-    previous_horizontal_angle_start_ = horizontal_angle_start;
-    previous_horizontal_resolution_ = horizontal_resolution;
-    previous_vertical_angles_ = vertical_angles;
   }
-  return directions_;
 }
 
 const std::vector<std::string> & Raycaster::getDetectedObject() const { return detected_objects_; }
 
-const sensor_msgs::msg::PointCloud2 Raycaster::raycast(
-  const std::string & frame_id, const rclcpp::Time & stamp, const geometry_msgs::msg::Pose & origin,
-  double max_distance, double min_distance)
+bool Raycaster::isVisible(
+  const geometry_msgs::msg::Point & origin, const std::string & entity,
+  const std::vector<geometry_msgs::msg::Point> & targets, unsigned int ray_mask) const
 {
-  detected_objects_ = {};
-  pcl::PointCloud<pcl::PointXYZI>::Ptr cloud(new pcl::PointCloud<pcl::PointXYZI>());
-  for (auto & pair : primitive_ptrs_) {
-    auto id = pair.second->addToScene(device_, scene_);
-    geometry_ids_.insert({id, pair.first});
+  for (const auto & target : targets) {
+    const Eigen::Vector3f direction(
+      target.x - origin.x, target.y - origin.y, target.z - origin.z);
+    if (const auto distance = direction.norm(); distance == 0.0f) {
+      return true;
+    } else {
+      RTCRayHit rayhit = {};
+      rayhit.ray.org_x = origin.x;
+      rayhit.ray.org_y = origin.y;
+      rayhit.ray.org_z = origin.z;
+      rayhit.ray.dir_x = direction.x() / distance;
+      rayhit.ray.dir_y = direction.y() / distance;
+      rayhit.ray.dir_z = direction.z() / distance;
+      rayhit.ray.mask = ray_mask;
+      rayhit.ray.tnear = 0;
+      rayhit.ray.tfar = distance;
+      rayhit.hit.geomID = RTC_INVALID_GEOMETRY_ID;
+      rayhit.hit.instID[0] = RTC_INVALID_GEOMETRY_ID;
+      rtcIntersect1(scene_, &rayhit);
+      if (rayhit.hit.geomID == RTC_INVALID_GEOMETRY_ID) {
+        return true;
+      } else if (const auto iter =
+                   geometry_ids_.find(getHitIdentifier(rayhit.hit.geomID, rayhit.hit.instID[0]));
+                 iter != geometry_ids_.end() and iter->second == entity) {
+        return true;
+      }
+    }
   }
+  return false;
+}
 
-  // Run as many threads as physical cores (which is usually /2 virtual threads)
-  // In heavy loads virtual threads (hyper-threading) add little to the overall performance
-  // This also minimizes cost of creating a thread (roughly 10us on Intel/Linux)
-  int thread_count = std::thread::hardware_concurrency() / 2;
-  // Per thread data structures:
-  std::vector<std::thread> threads(thread_count);
-  std::vector<std::set<unsigned int>> thread_detected_ids(thread_count);
-  std::vector<pcl::PointCloud<pcl::PointXYZI>::Ptr> thread_cloud(thread_count);
+void Raycaster::updateInstances()
+{
+  /// @note The primitives are added for every scan, so those missing now have been despawned.
+  for (auto iter = instances_.begin(); iter != instances_.end();) {
+    if (primitive_ptrs_.count(iter->first) == 0) {
+      release(iter->second);
+      iter = instances_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+  for (const auto & [name, primitive_ptr] : primitive_ptrs_) {
+    auto iter = instances_.find(name);
+    if (
+      iter != instances_.end() and
+      (iter->second.prototype_key != primitive_ptr->getPrototypeKey() or
+       not isSameShape(iter->second.vertices, primitive_ptr->getLocalVertex()))) {
+      release(iter->second);
+      instances_.erase(iter);
+      iter = instances_.end();
+    }
+    if (iter == instances_.end()) {
+      Instance instance;
+      instance.vertices = primitive_ptr->getLocalVertex();
+      instance.prototype_key = primitive_ptr->getPrototypeKey();
+      if (instance.prototype_key.empty()) {
+        instance.prototype = primitive_ptr->createPrototype(device_);
+      } else {
+        auto & prototype = shared_prototypes_[instance.prototype_key];
+        if (not prototype) {
+          prototype = primitive_ptr->createPrototype(device_);
+        }
+        /// @note Each instance holds a reference, which release gives back.
+        rtcRetainScene(prototype);
+        instance.prototype = prototype;
+      }
+      instance.geometry = rtcNewGeometry(device_, RTC_GEOMETRY_TYPE_INSTANCE);
+      rtcSetGeometryInstancedScene(instance.geometry, instance.prototype);
+      instance.geometry_id = rtcAttachGeometry(scene_, instance.geometry);
+      geometry_ids_[instance.geometry_id] = name;
+      iter = instances_.emplace(name, instance).first;
+    }
+    const auto transform = toTransform(primitive_ptr->pose);
+    rtcSetGeometryTransform(
+      iter->second.geometry, 0, RTC_FORMAT_FLOAT3X4_COLUMN_MAJOR, transform.data());
+    /// @note Set on every commit, since the entity may start carrying LiDARs after its spawn.
+    const auto ray_mask = ray_masks_.find(name);
+    rtcSetGeometryMask(
+      iter->second.geometry, ray_mask != ray_masks_.end()
+                               ? ~ray_mask->second
+                               : 0b11111111'11111111'11111111'11111111);
+    rtcCommitGeometry(iter->second.geometry);
+  }
+  primitive_ptrs_.clear();
+}
+
+void Raycaster::release(const Instance & instance)
+{
+  rtcDetachGeometry(scene_, instance.geometry_id);
+  rtcReleaseGeometry(instance.geometry);
+  rtcReleaseScene(instance.prototype);
+  geometry_ids_.erase(instance.geometry_id);
+}
 
+void Raycaster::addStaticMesh(
+  const std::vector<Vertex> & vertices, const std::vector<Triangle> & triangles)
+{
+  Instance instance;
+  instance.prototype = rtcNewScene(device_);
+  /// @note The mesh never changes, so its BVH is worth building with the best quality.
+  rtcSetSceneBuildQuality(instance.prototype, RTC_BUILD_QUALITY_HIGH);
+  RTCGeometry mesh = rtcNewGeometry(device_, RTC_GEOMETRY_TYPE_TRIANGLE);
+  Vertex * vertex_buffer = static_cast<Vertex *>(rtcSetNewGeometryBuffer(
+    mesh, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, sizeof(Vertex), vertices.size()));
+  std::copy(vertices.begin(), vertices.end(), vertex_buffer);
+  Triangle * triangle_buffer = static_cast<Triangle *>(rtcSetNewGeometryBuffer(
+    mesh, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT3, sizeof(Triangle), triangles.size()));
+  std::copy(triangles.begin(), triangles.end(), triangle_buffer);
+  // enable raycasting
+  rtcSetGeometryMask(mesh, 0b11111111'11111111'11111111'11111111);
+  rtcCommitGeometry(mesh);
+  rtcAttachGeometry(instance.prototype, mesh);
+  rtcReleaseGeometry(mesh);
+  rtcCommitScene(instance.prototype);
+
+  instance.geometry = rtcNewGeometry(device_, RTC_GEOMETRY_TYPE_INSTANCE);
+  rtcSetGeometryInstancedScene(instance.geometry, instance.prototype);
+  // enable raycasting
+  rtcSetGeometryMask(instance.geometry, 0b11111111'11111111'11111111'11111111);
+  const auto transform = toTransform(geometry_msgs::msg::Pose());
+  rtcSetGeometryTransform(instance.geometry, 0, RTC_FORMAT_FLOAT3X4_COLUMN_MAJOR, transform.data());
+  rtcCommitGeometry(instance.geometry);
+  instance.geometry_id = rtcAttachGeometry(scene_, instance.geometry);
+  static_instances_.push_back(instance);
+}
+
+void Raycaster::commit(const rclcpp::Time & stamp)
+{
+  updateInstances();
   rtcCommitScene(scene_);
-  for (unsigned int i = 0; i < threads.size(); ++i) {
-    thread_cloud[i] = pcl::PointCloud<pcl::PointXYZI>::Ptr(new pcl::PointCloud<pcl::PointXYZI>());
-    threads[i] = std::thread(
-      intersect, i, thread_count, scene_, thread_cloud[i], origin, std::ref(thread_detected_ids[i]),
-      max_distance, min_distance, std::ref(rotation_matrices_));
-  }
-  for (unsigned int i = 0; i < threads.size(); ++i) {
-    threads[i].join();
-    (*cloud) += *(thread_cloud[i]);
-  }
-  for (auto && detected_ids_in_thread : thread_detected_ids) {
-    for (const auto & id : detected_ids_in_thread) {
-      detected_objects_.emplace_back(geometry_ids_[id]);
+  committed_stamp_ = stamp;
+}
+
+void Raycaster::commit(
+  const rclcpp::Time & stamp, const std::vector<traffic_simulator_msgs::EntityStatus> & entities,
+  const std::optional<geometry_msgs::msg::Point> & lod_origin)
+{
+  if (isCommitted(stamp)) {
+    return;
+  }
+  for (const auto & entity : entities) {
+    geometry_msgs::msg::Pose pose;
+    simulation_interface::toMsg(entity.pose(), pose);
+    auto rotation = math::geometry::getRotationMatrix(pose.orientation);
+    geometry_msgs::msg::Point center_point;
+    simulation_interface::toMsg(entity.bounding_box().center(), center_point);
+    Eigen::Vector3d center(center_point.x, center_point.y, center_point.z);
+    center = rotation * center;
+    pose.position.x = pose.position.x + center.x();
+    pose.position.y = pose.position.y + center.y();
+    pose.position.z = pose.position.z + center.z();
+    if (const auto model = getModel(entity.name())) {
+      const auto distance = lod_origin ? std::hypot(
+                                           pose.position.x - lod_origin->x,
+                                           pose.position.y - lod_origin->y,
+                                           pose.position.z - lod_origin->z)
+                                       : 0.0;
+      addPrimitive<simple_sensor_simulator::primitives::Mesh>(
+        entity.name(),                           //
+        model,                                   //
+        model->getLevel(distance),               //
+        entity.bounding_box().dimensions().x(),  //
+        entity.bounding_box().dimensions().y(),  //
+        entity.bounding_box().dimensions().z(),  //
+        pose);
+    } else {
+      addPrimitive<simple_sensor_simulator::primitives::Box>(
+        entity.name(),                           //
+        entity.bounding_box().dimensions().x(),  //
+        entity.bounding_box().dimensions().y(),  //
+        entity.bounding_box().dimensions().z(),  //
+        pose);
     }
   }
+  commit(stamp);
+}
+
+void Raycaster::setModel(
+  const std::string & name, const std::shared_ptr<const primitives::MeshModel> & model)
+{
+  if (model) {
+    models_[name] = model;
+  } else {
+    models_.erase(name);
+  }
+}
 
-  for (const auto & id : geometry_ids_) {
-    rtcDetachGeometry(scene_, id.first);
+std::shared_ptr<const primitives::MeshModel> Raycaster::getModel(const std::string & name) const
+{
+  if (auto iter = models_.find(name); iter != models_.end()) {
+    return iter->second;
+  } else {
+    return nullptr;
   }
+}
 
-  geometry_ids_.clear();
-  primitive_ptrs_.clear();
+unsigned int Raycaster::getRayMask(const std::string & entity)
+{
+  if (auto iter = ray_masks_.find(entity); iter != ray_masks_.end()) {
+    return iter->second;
+  } else if (ray_masks_.size() < 32) {
+    return ray_masks_.emplace(entity, 1u << ray_masks_.size()).first->second;
+  } else {
+    throw SimulationRuntimeError("LiDARs of more than 32 entities share the raycaster.");
+  }
+}
+
+bool Raycaster::isCommitted(const rclcpp::Time & stamp) const
+{
+  return committed_stamp_ and committed_stamp_.value() == stamp;
+}
 
+sensor_msgs::msg::PointCloud2 Raycaster::raycast(
+  const std::string & frame_id, const rclcpp::Time & stamp, const geometry_msgs::msg::Pose & origin,
+  double max_distance, double min_distance)
+{
+  commit(stamp);
+  return raycast(ray_directions_, frame_id, stamp, origin, max_distance, min_distance);
+}
+
+sensor_msgs::msg::PointCloud2 Raycaster::raycast(
+  const RayDirections & directions, const std::string & frame_id, const rclcpp::Time & stamp,
+  const geometry_msgs::msg::Pose & origin, double max_distance, double min_distance,
+  unsigned int ray_mask)
+{
+  return raycast(
+    directions, 0, directions.x.size(), frame_id, stamp, origin, max_distance, min_distance,
+    ray_mask);
+}
+
+sensor_msgs::msg::PointCloud2 Raycaster::raycast(
+  const RayDirections & directions, std::size_t first_ray, std::size_t last_ray,
+  const std::string & frame_id, const rclcpp::Time & stamp, const geometry_msgs::msg::Pose & origin,
+  double max_distance, double min_distance, unsigned int ray_mask)
+{
+  detected_objects_ = {};
   sensor_msgs::msg::PointCloud2 pointcloud_msg;
-  pcl::toROSMsg(*cloud, pointcloud_msg);
+  {
+    /*
+       The rays are split into more chunks than threads, so that threads finishing early take the
+       chunks of the others. The chunks are contiguous, so the points stay in the scan order.
+    */
+    static std::mutex mutex;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto & thread_pool = getThreadPool();
+    /// @note Hard coded parameter, number of chunks per thread.
+    constexpr std::size_t chunks_per_thread = 4;
+    /// @note The chunks are made of whole packets, so only the last packet of a scan is partial.
+    last_ray = std::min(last_ray, directions.x.size());
+    const auto ray_count = first_ray < last_ray ? last_ray - first_ray : 0;
+    const auto packet_count = (ray_count + packet_size_ - 1) / packet_size_;
+    const auto chunk_count = std::min(packet_count, thread_pool.size() * chunks_per_thread);
+    chunk_clouds_.resize(chunk_count);
+    chunk_detected_ids_.resize(chunk_count);
+    thread_pool.parallelFor(chunk_count, [&](const std::size_t chunk) {
+      common::ScopedTraceEvent event("raycast", "Raycaster::intersect");
+      chunk_clouds_[chunk].clear();
+      chunk_detected_ids_[chunk].clear();
+      const auto begin =
+        first_ray + std::min(ray_count, packet_count * chunk / chunk_count * packet_size_);
+      const auto end =
+        first_ray + std::min(ray_count, packet_count * (chunk + 1) / chunk_count * packet_size_);
+      switch (packet_size_) {
+        case 16:
+          intersectPackets<16>(
+            directions, begin, end, origin, max_distance, min_distance, ray_mask,
+            chunk_clouds_[chunk], chunk_detected_ids_[chunk]);
+          break;
+        case 8:
+          intersectPackets<8>(
+            directions, begin, end, origin, max_distance, min_distance, ray_mask,
+            chunk_clouds_[chunk], chunk_detected_ids_[chunk]);
+          break;
+        default:
+          intersect(
+            directions, begin, end, origin, max_distance, min_distance, ray_mask,
+            chunk_clouds_[chunk], chunk_detected_ids_[chunk]);
+          break;
+      }
+    });
+    /*
+       The points of the chunks are written straight into the buffer of the message at the offset
+       of their chunk, instead of being concatenated into one cloud and converted afterwards.
+    */
+    std::vector<std::size_t> chunk_offsets(chunk_count + 1, 0);
+    for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+      chunk_offsets[chunk + 1] = chunk_offsets[chunk] + chunk_clouds_[chunk].size();
+    }
+    sensor_msgs::PointCloud2Modifier modifier(pointcloud_msg);
+    modifier.setPointCloud2Fields(
+      4, "x", 1, sensor_msgs::msg::PointField::FLOAT32, "y", 1,
+      sensor_msgs::msg::PointField::FLOAT32, "z", 1, sensor_msgs::msg::PointField::FLOAT32,
+      "intensity", 1, sensor_msgs::msg::PointField::FLOAT32);
+    modifier.resize(chunk_offsets[chunk_count]);
+    pointcloud_msg.is_dense = true;
+    thread_pool.parallelFor(chunk_count, [&](const std::size_t chunk) {
+      auto * data = reinterpret_cast<float *>(
+        pointcloud_msg.data.data() + chunk_offsets[chunk] * pointcloud_msg.point_step);
+      for (const auto & point : chunk_clouds_[chunk]) {
+        *data++ = point.x;
+        *data++ = point.y;
+        *data++ = point.z;
+        *data++ = point.intensity;
+      }
+    });
+    std::set<unsigned int> detected_ids;
+    for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+      detected_ids.insert(chunk_detected_ids_[chunk].begin(), chunk_detected_ids_[chunk].end());
+    }
+    for (const auto & id : detected_ids) {
+      /// @note Static meshes have no name, so they are not detected objects.
+      if (const auto iter = geometry_ids_.find(id); iter != geometry_ids_.end()) {
+        detected_objects_.emplace_back(iter->second);
+      }
+    }
+  }
+
   pointcloud_msg.header.frame_id = frame_id;
   pointcloud_msg.header.stamp = stamp;
   return pointcloud_msg;
 }
+
+auto makeRaycaster(const std::string & backend) -> std::shared_ptr<Raycaster>
+{
+  if (backend.empty() or backend == "embree") {
+    return std::make_shared<Raycaster>();
+  } else {
+    std::stringstream ss;
+    ss << "Unexpected raycaster backend " << std::quoted(backend)
+       << " given, only \"embree\" is available in this build.";
+    throw SimulationRuntimeError(ss.str().c_str());
+  }
+}
 }  // namespace simple_sensor_simulator
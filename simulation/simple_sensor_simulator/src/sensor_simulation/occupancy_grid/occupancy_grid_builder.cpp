@@ -12,11 +12,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <boost/geometry.hpp>
+#include <algorithm>
+#include <cmath>
 #include <geometry/quaternion/get_rotation_matrix.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <simple_sensor_simulator/sensor_simulation/occupancy_grid/grid_traversal.hpp>
 #include <simple_sensor_simulator/sensor_simulation/occupancy_grid/occupancy_grid_builder.hpp>
+#include <utility>
 
 namespace simple_sensor_simulator
 {
@@ -34,7 +36,10 @@ OccupancyGridBuilder::OccupancyGridBuilder(
   values_(height * width),
 
   min_cols_(height),
-  max_cols_(height)
+  max_cols_(height),
+
+  dirty_row_begin_(height),
+  value_row_begin_(height)
 {
 }
 
@@ -65,40 +70,46 @@ auto OccupancyGridBuilder::makePoint(double x, double y, double z) const -> Poin
 
 auto OccupancyGridBuilder::makeOccupiedArea(const PrimitiveType & primitive) const -> PolygonType
 {
-  namespace bg = boost::geometry;
-  using Point = bg::model::d2::point_xy<double>;
-  using Ring = bg::model::ring<Point>;
-
   // Generate a polygon of given primitive
-  auto primitive_ring = Ring();
+  auto polygon = PolygonType();
   for (auto & e : primitive.get2DConvexHull()) {
-    auto p = transformToGrid(e);
-    primitive_ring.emplace_back(p.x, p.y);
+    polygon.emplace_back(transformToGrid(e));
+  }
+  // The convex hull is a closed ring, so drop its last point which is the same as the first one
+  if (
+    polygon.size() > 1 and polygon.front().x == polygon.back().x and
+    polygon.front().y == polygon.back().y) {
+    polygon.pop_back();
   }
 
   const auto real_width = width * resolution / 2;
   const auto real_height = height * resolution / 2;
 
-  auto grid_ring = Ring{
-    {+real_width, +real_height},  // top right
-    {+real_width, -real_height},  // bottom right
-    {-real_width, -real_height},  // bottom left
-    {-real_width, +real_height},  // top left
+  // Clip a polygon to fit into grid area, one grid edge after another (Sutherland-Hodgman).
+  // The polygon is convex, so this is exact and needs no general polygon intersection.
+  const auto clip = [&](const auto & signed_distance) {
+    auto clipped = PolygonType();
+    for (size_t i = 0; i < polygon.size(); ++i) {
+      const auto & p = polygon[i];
+      const auto & q = polygon[(i + 1) % polygon.size()];
+      const auto dp = signed_distance(p);
+      const auto dq = signed_distance(q);
+      if (dp >= 0) {
+        clipped.emplace_back(p);
+      }
+      if ((dp > 0 and dq < 0) or (dp < 0 and dq > 0)) {
+        const auto t = dp / (dp - dq);
+        clipped.emplace_back(makePoint(p.x + (q.x - p.x) * t, p.y + (q.y - p.y) * t));
+      }
+    }
+    polygon = std::move(clipped);
   };
+  clip([&](const PointType & p) { return real_width - p.x; });   // right
+  clip([&](const PointType & p) { return real_width + p.x; });   // left
+  clip([&](const PointType & p) { return real_height - p.y; });  // top
+  clip([&](const PointType & p) { return real_height + p.y; });  // bottom
 
-  // Clip a polygon to fit into grid area
-  auto intersection_polygon = std::vector<Ring>();
-  bg::intersection(primitive_ring, grid_ring, intersection_polygon);
-
-  auto result = PolygonType();
-  if (not intersection_polygon.empty()) {
-    // If a polygon intersects the occupancy grid area, `intersection_polygon` will have
-    // just one `Ring` so accessing a polygon via `front()` should be sufficient
-    for (auto & p : intersection_polygon.front()) {
-      result.emplace_back(makePoint(p.x(), p.y()));
-    }
-  }
-  return result;
+  return polygon.size() < 3 ? PolygonType() : polygon;
 }
 
 auto OccupancyGridBuilder::makeInvisibleArea(const PolygonType & occupied_polygon) const
@@ -198,15 +209,35 @@ auto OccupancyGridBuilder::addPolygon(MarkerGridType & grid, const PolygonType &
   // of the polygon. This makes performance of an occupancy grid generation
   // tolerant of an increasing number of primitives.
 
-  min_cols_.assign(min_cols_.size(), width);  // Leftmost marked cells of each rows
-  max_cols_.assign(max_cols_.size(), -1);     // Rightmost marked cells of each rows
+  if (convex_hull.empty()) {
+    return;
+  }
+
+  pixels_.clear();
+  for (const auto & point : convex_hull) {
+    pixels_.emplace_back(transformToPixel(point));
+  }
+
+  // Only the rows the polygon spans are touched, so small polygons on large grids stay cheap
+  auto [min_pixel, max_pixel] = std::minmax_element(
+    pixels_.begin(), pixels_.end(),
+    [](const PointType & p, const PointType & q) { return p.y < q.y; });
+  const auto row_begin = std::clamp<int32_t>(std::floor(min_pixel->y), 0, height);
+  const auto row_end = std::clamp<int32_t>(std::floor(max_pixel->y) + 1, 0, height);
+  if (row_begin >= row_end) {
+    return;
+  }
+
+  // Leftmost and rightmost marked cells of each rows
+  std::fill(min_cols_.begin() + row_begin, min_cols_.begin() + row_end, width);
+  std::fill(max_cols_.begin() + row_begin, max_cols_.begin() + row_end, -1);
 
   // Traverse each polygon edges on grid coordinate and update `min_cols_` and `max_cols_`
-  for (size_t i = 0; i < convex_hull.size(); ++i) {
-    const auto p = transformToPixel(convex_hull[i]);
-    const auto q = transformToPixel(convex_hull[(i + 1) % convex_hull.size()]);
+  for (size_t i = 0; i < pixels_.size(); ++i) {
+    const auto & p = pixels_[i];
+    const auto & q = pixels_[(i + 1) % pixels_.size()];
     for (auto [col, row] : GridTraversal(p.x, p.y, q.x, q.y)) {
-      if (row >= 0 && row < int32_t(height)) {
+      if (row >= row_begin && row < row_end) {
         min_cols_[row] = std::min(min_cols_[row], col);
         max_cols_[row] = std::max(max_cols_[row], col);
       }
@@ -214,7 +245,7 @@ auto OccupancyGridBuilder::addPolygon(MarkerGridType & grid, const PolygonType &
   }
 
   // Put marked cells on the occupancy grid
-  for (size_t row = 0; row < height; ++row) {
+  for (auto row = row_begin; row < row_end; ++row) {
     auto min_col = min_cols_[row];
     auto max_col = max_cols_[row] + 1;
 
@@ -236,6 +267,9 @@ auto OccupancyGridBuilder::addPolygon(MarkerGridType & grid, const PolygonType &
     }
   }
 
+  dirty_row_begin_ = std::min(dirty_row_begin_, row_begin);
+  dirty_row_end_ = std::max(dirty_row_end_, row_end);
+
   // At this stage, we have marked grid cells like
   //  0  0  0  0  0  0  0  0
   //  0  0  0  1  0 -1  0  0
@@ -277,25 +311,34 @@ auto OccupancyGridBuilder::build() -> void
 {
   // https://imoz.jp/algorithms/imos_method.html (Japanese)
 
-  // We can make prefix sum calculation faster by unrolling for loop and
-  // tweaking compiler options, but, as far as I run this code locally,
-  // it takes about 200us for 400x400 grids and I think it is sufficient,
-  // so I leave this naive implementation.
-  for (size_t row = 0; row < height; ++row) {
-    for (size_t col = 0; col + 1 < width; ++col) {
-      invisible_grid_[row * width + col + 1] += invisible_grid_[row * width + col];
+  // Rows outside the marked rows are empty, so only clear those which were not empty last time
+  const auto clear_rows = [&](int32_t begin, int32_t end) {
+    if (begin < end) {
+      std::fill(values_.begin() + begin * width, values_.begin() + end * width, 0);
     }
-  }
-
-  for (size_t row = 0; row < height; ++row) {
-    for (size_t col = 0; col + 1 < width; ++col) {
-      occupied_grid_[row * width + col + 1] += occupied_grid_[row * width + col];
+  };
+  clear_rows(value_row_begin_, std::min(value_row_end_, dirty_row_begin_));
+  clear_rows(std::max(value_row_begin_, dirty_row_end_), value_row_end_);
+
+  // The prefix sums of both grids are taken in one pass per row, which also clears the markers
+  // for the next build, so the grids are never cleared as a whole.
+  for (auto row = dirty_row_begin_; row < dirty_row_end_; ++row) {
+    auto * const invisible = invisible_grid_.data() + row * width;
+    auto * const occupied = occupied_grid_.data() + row * width;
+    auto * const values = values_.data() + row * width;
+    MarkerCounterType invisible_sum = 0;
+    MarkerCounterType occupied_sum = 0;
+    for (size_t col = 0; col < width; ++col) {
+      invisible_sum += std::exchange(invisible[col], 0);
+      occupied_sum += std::exchange(occupied[col], 0);
+      values[col] = occupied_sum ? occupied_cost : invisible_sum ? invisible_cost : 0;
     }
   }
 
-  for (size_t i = 0; i < height * width; ++i) {
-    values_[i] = occupied_grid_[i] ? occupied_cost : invisible_grid_[i] ? invisible_cost : 0;
-  }
+  value_row_begin_ = dirty_row_begin_;
+  value_row_end_ = dirty_row_end_;
+  dirty_row_begin_ = height;
+  dirty_row_end_ = 0;
 }
 
 auto OccupancyGridBuilder::get() const -> const OccupancyGridType & { return values_; }
@@ -304,8 +347,17 @@ auto OccupancyGridBuilder::reset(const PoseType & origin) -> void
 {
   origin_ = origin;
   primitive_count_ = 0;
-  invisible_grid_.assign(invisible_grid_.size(), 0);
-  occupied_grid_.assign(occupied_grid_.size(), 0);
+  // Markers are cleared by build, so only those added without a build are left
+  if (dirty_row_begin_ < dirty_row_end_) {
+    std::fill(
+      invisible_grid_.begin() + dirty_row_begin_ * width,
+      invisible_grid_.begin() + dirty_row_end_ * width, 0);
+    std::fill(
+      occupied_grid_.begin() + dirty_row_begin_ * width,
+      occupied_grid_.begin() + dirty_row_end_ * width, 0);
+    dirty_row_begin_ = height;
+    dirty_row_end_ = 0;
+  }
 }
 
 }  // namespace simple_sensor_simulator
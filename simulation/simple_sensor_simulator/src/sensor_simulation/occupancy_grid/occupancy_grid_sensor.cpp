@@ -14,6 +14,7 @@
 
 #include <algorithm>
 #include <geometry/quaternion/get_rotation_matrix.hpp>
+#include <iterator>
 #include <memory>
 #include <nav_msgs/msg/occupancy_grid.hpp>
 #include <optional>
@@ -21,6 +22,7 @@
 #include <simple_sensor_simulator/sensor_simulation/occupancy_grid/occupancy_grid_sensor.hpp>
 #include <simulation_interface/conversions.hpp>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace simple_sensor_simulator
@@ -38,17 +40,15 @@ geometry_msgs::Pose OccupancyGridSensorBase::getSensorPose(
   throw SimulationRuntimeError("Occupancy grid sensor can be attached only ego entity.");
 }
 
-const std::vector<std::string> OccupancyGridSensorBase::getDetectedObjects(
+const std::vector<bool> OccupancyGridSensorBase::getDetectedObjects(
   const std::vector<traffic_simulator_msgs::EntityStatus> & status,
-  const std::vector<std::string> & lidar_detected_entities) const
+  const std::vector<bool> & lidar_detected_entities) const
 {
-  std::vector<std::string> detected_entities;
+  std::vector<bool> detected_entities(status.size(), false);
   const auto pose = getSensorPose(status);
-  for (const auto & s : status) {
-    if (const auto has_detected =
-          std::find(lidar_detected_entities.begin(), lidar_detected_entities.end(), s.name()) !=
-          lidar_detected_entities.end();
-        !has_detected) {
+  for (size_t i = 0; i < status.size(); ++i) {
+    const auto & s = status[i];
+    if (const auto has_detected = lidar_detected_entities[i]; !has_detected) {
       continue;
     }
 
@@ -56,7 +56,7 @@ const std::vector<std::string> OccupancyGridSensorBase::getDetectedObjects(
       s.pose().position().x() - pose.position().x(), s.pose().position().y() - pose.position().y(),
       s.pose().position().z() - pose.position().z());
     if (s.name() != configuration_.entity() && distance <= configuration_.range()) {
-      detected_entities.emplace_back(s.name());
+      detected_entities[i] = true;
     }
   }
   return detected_entities;
@@ -65,21 +65,9 @@ const std::vector<std::string> OccupancyGridSensorBase::getDetectedObjects(
 template <>
 auto OccupancyGridSensor<nav_msgs::msg::OccupancyGrid>::getOccupancyGrid(
   const std::vector<traffic_simulator_msgs::EntityStatus> & status, const rclcpp::Time & stamp,
-  const std::vector<std::string> & lidar_detected_entities) -> nav_msgs::msg::OccupancyGrid
+  const std::vector<bool> & lidar_detected_entities) -> nav_msgs::msg::OccupancyGrid
 {
-  // check if entities in `status` have unique names
-  {
-    auto unique_entities = std::set<std::string>();
-    for (const auto & s : status) {
-      if (configuration_.entity() != s.name()) {
-        if (unique_entities.count(s.name()) != 0) {
-          throw std::runtime_error(
-            "status contains primitives with the same name: `" + s.name() + "`");
-        }
-        unique_entities.insert(s.name());
-      }
-    }
-  }
+  // entities in `status` have unique names, which is checked by SensorSimulation::updateSensorFrame
 
   // find ego from `status` and get its pose with north side up
   auto ego_pose_north_up = geometry_msgs::msg::Pose();
@@ -100,23 +88,20 @@ auto OccupancyGridSensor<nav_msgs::msg::OccupancyGrid>::getOccupancyGrid(
     ego_pose_north_up.orientation = geometry_msgs::msg::Quaternion();
   }
 
-  // construct a `set` of detected object names to look up entities later
-  auto detected_entities = std::set<std::string>();
-  {
-    if (configuration_.filter_by_range()) {
-      auto v = getDetectedObjects(status, lidar_detected_entities);
-      detected_entities.insert(v.begin(), v.end());
-    } else {
-      detected_entities.insert(lidar_detected_entities.begin(), lidar_detected_entities.end());
-    }
-  }
+  // flags of detected objects, indexed like `status`
+  const auto detected_entities = configuration_.filter_by_range()
+                                   ? getDetectedObjects(status, lidar_detected_entities)
+                                   : lidar_detected_entities;
 
-  // construct an occupancy grid
-  builder_.reset(ego_pose_north_up);
-  for (const auto & s : status) {
-    if (configuration_.entity() != s.name()) {
+  // list the inputs of the occupancy grid
+  inputs_.clear();
+  inputs_.insert(
+    inputs_.end(), {ego_pose_north_up.position.x, ego_pose_north_up.position.y,
+                    ego_pose_north_up.position.z});
+  for (size_t i = 0; i < status.size(); ++i) {
+    if (const auto & s = status[i]; configuration_.entity() != s.name()) {
       // skip if entity is not actually detected
-      if (detected_entities.count(s.name()) == 0) {
+      if (not detected_entities[i]) {
         continue;
       }
 
@@ -134,10 +119,31 @@ auto OccupancyGridSensor<nav_msgs::msg::OccupancyGrid>::getOccupancyGrid(
       }
 
       const auto & v = s.bounding_box().dimensions();
-      builder_.add(primitives::Box(v.x(), v.y(), v.z(), pose));
+      inputs_.insert(
+        inputs_.end(), {v.x(), v.y(), v.z(), pose.position.x, pose.position.y, pose.position.z,
+                        pose.orientation.x, pose.orientation.y, pose.orientation.z,
+                        pose.orientation.w});
+    }
+  }
+
+  // construct an occupancy grid, unless it is the same as the last one
+  if (inputs_ != previous_inputs_) {
+    builder_.reset(ego_pose_north_up);
+    for (auto input = std::next(inputs_.begin(), 3); input != inputs_.end();
+         input = std::next(input, 10)) {
+      auto pose = geometry_msgs::msg::Pose();
+      pose.position.x = input[3];
+      pose.position.y = input[4];
+      pose.position.z = input[5];
+      pose.orientation.x = input[6];
+      pose.orientation.y = input[7];
+      pose.orientation.z = input[8];
+      pose.orientation.w = input[9];
+      builder_.add(primitives::Box(input[0], input[1], input[2], pose));
     }
+    builder_.build();
+    std::swap(inputs_, previous_inputs_);
   }
-  builder_.build();
 
   // construct message
   auto res = nav_msgs::msg::OccupancyGrid();
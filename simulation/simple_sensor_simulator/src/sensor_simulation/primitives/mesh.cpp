@@ -0,0 +1,177 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <simple_sensor_simulator/sensor_simulation/primitives/mesh.hpp>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace simple_sensor_simulator
+{
+namespace primitives
+{
+namespace
+{
+auto endsWith(const std::string & s, const std::string & suffix) -> bool
+{
+  return s.size() >= suffix.size() and
+         s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+/// @note Scale and center the vertices into the unit cube, axis by axis.
+auto fit(MeshModel::Level & level) -> void
+{
+  auto min = Vertex{
+    std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+    std::numeric_limits<float>::max()};
+  auto max = Vertex{
+    std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(),
+    std::numeric_limits<float>::lowest()};
+  for (const auto & v : level.vertices) {
+    min = Vertex{std::min(min.x, v.x), std::min(min.y, v.y), std::min(min.z, v.z)};
+    max = Vertex{std::max(max.x, v.x), std::max(max.y, v.y), std::max(max.z, v.z)};
+  }
+  const auto scale = [](const float lower, const float upper) {
+    return upper > lower ? 1.0f / (upper - lower) : 1.0f;
+  };
+  for (auto & v : level.vertices) {
+    v.x = (v.x - 0.5f * (min.x + max.x)) * scale(min.x, max.x);
+    v.y = (v.y - 0.5f * (min.y + max.y)) * scale(min.y, max.y);
+    v.z = (v.z - 0.5f * (min.z + max.z)) * scale(min.z, max.z);
+  }
+}
+}  // namespace
+
+auto MeshModel::getLevel(double distance) const -> std::size_t
+{
+  /// @note Hard coded parameter, distance from the sensor covered by each level of detail.
+  constexpr double level_distance = 30.0;
+  const auto level = distance > 0.0 ? static_cast<std::size_t>(distance / level_distance) : 0;
+  return std::min(level, levels.size() - 1);
+}
+
+auto MeshModel::load(const std::string & path) -> std::shared_ptr<const MeshModel>
+{
+  static std::mutex mutex;
+  static std::unordered_map<std::string, std::shared_ptr<const MeshModel>> models;
+  std::lock_guard<std::mutex> lock(mutex);
+
+  if (auto iter = models.find(path); iter != models.end()) {
+    return iter->second;
+  }
+
+  auto model = std::make_shared<MeshModel>();
+  model->path = path;
+  if (endsWith(path, ".obj")) {
+    const auto stem = path.substr(0, path.size() - 4);
+    for (std::size_t lod = 0;; ++lod) {
+      std::ifstream file(lod == 0 ? path : stem + ".lod" + std::to_string(lod) + ".obj");
+      if (auto level = read(file); not level.triangles.empty()) {
+        fit(level);
+        model->levels.push_back(std::move(level));
+      } else {
+        break;
+      }
+    }
+  }
+
+  return models.emplace(path, model->levels.empty() ? nullptr : std::move(model)).first->second;
+}
+
+auto MeshModel::read(std::istream & is) -> Level
+{
+  Level level;
+  for (std::string line; std::getline(is, line);) {
+    std::istringstream tokens(line);
+    std::string keyword;
+    tokens >> keyword;
+    if (keyword == "v") {
+      Vertex v;
+      if (tokens >> v.x >> v.y >> v.z) {
+        level.vertices.push_back(v);
+      }
+    } else if (keyword == "f") {
+      std::vector<unsigned int> indices;
+      for (std::string token; tokens >> token;) {
+        /// @note Only the vertex index of "v/vt/vn" is used, negative indices count from the end.
+        const auto index = std::strtol(token.c_str(), nullptr, 10);
+        const auto size = static_cast<long>(level.vertices.size());
+        if (const auto i = index < 0 ? size + index : index - 1; 0 <= i and i < size) {
+          indices.push_back(static_cast<unsigned int>(i));
+        }
+      }
+      for (std::size_t i = 2; i < indices.size(); ++i) {
+        level.triangles.push_back(Triangle{indices[0], indices[i - 1], indices[i]});
+      }
+    }
+  }
+  return level;
+}
+
+Mesh::Mesh(
+  const std::shared_ptr<const MeshModel> & model, std::size_t level, float depth, float width,
+  float height, const geometry_msgs::msg::Pose & pose)
+: Primitive("Mesh", pose),
+  model(model),
+  level(std::min(level, model->levels.size() - 1)),
+  depth(depth),
+  width(width),
+  height(height)
+{
+  /// @note The corners of the bounding box, so the hull of the entity does not depend on the model.
+  for (const auto x : {-0.5f, +0.5f}) {
+    for (const auto y : {-0.5f, +0.5f}) {
+      for (const auto z : {-0.5f, +0.5f}) {
+        vertices_.push_back(Vertex{x * depth, y * width, z * height});
+      }
+    }
+  }
+}
+
+RTCScene Mesh::createPrototype(RTCDevice device) const
+{
+  const auto & [vertices, triangles] = model->levels[level];
+  RTCScene scene = rtcNewScene(device);
+  RTCGeometry mesh = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_TRIANGLE);
+  Vertex * vertex_buffer = static_cast<Vertex *>(rtcSetNewGeometryBuffer(
+    mesh, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, sizeof(Vertex), vertices.size()));
+  std::transform(vertices.begin(), vertices.end(), vertex_buffer, [this](const auto & v) {
+    return Vertex{v.x * depth, v.y * width, v.z * height};
+  });
+  Triangle * triangle_buffer = static_cast<Triangle *>(rtcSetNewGeometryBuffer(
+    mesh, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT3, sizeof(Triangle), triangles.size()));
+  std::copy(triangles.begin(), triangles.end(), triangle_buffer);
+  // enable raycasting
+  rtcSetGeometryMask(mesh, 0b11111111'11111111'11111111'11111111);
+  rtcCommitGeometry(mesh);
+  rtcAttachGeometry(scene, mesh);
+  rtcReleaseGeometry(mesh);
+  rtcCommitScene(scene);
+  return scene;
+}
+
+std::string Mesh::getPrototypeKey() const
+{
+  std::stringstream key;
+  key << model->path << "#" << level << "#" << depth << "x" << width << "x" << height;
+  return key.str();
+}
+}  // namespace primitives
+}  // namespace simple_sensor_simulator
@@ -112,15 +112,13 @@ std::vector<geometry_msgs::msg::Point> Primitive::get2DConvexHull() const
   return math::geometry::get2DConvexHull(toPoints(transform()));
 }
 
-unsigned int Primitive::addToScene(RTCDevice device, RTCScene scene)
+RTCGeometry Primitive::createGeometry(RTCDevice device, const std::vector<Vertex> & vertices) const
 {
   RTCGeometry mesh = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_TRIANGLE);
-  const auto transformed_vertices = transform();
-  Vertex * vertices = static_cast<Vertex *>(rtcSetNewGeometryBuffer(
-    mesh, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, sizeof(Vertex),
-    transformed_vertices.size()));
-  for (size_t i = 0; i < transformed_vertices.size(); i++) {
-    vertices[i] = transformed_vertices[i];
+  Vertex * vertex_buffer = static_cast<Vertex *>(rtcSetNewGeometryBuffer(
+    mesh, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, sizeof(Vertex), vertices.size()));
+  for (size_t i = 0; i < vertices.size(); i++) {
+    vertex_buffer[i] = vertices[i];
   }
   Triangle * triangles = static_cast<Triangle *>(rtcSetNewGeometryBuffer(
     mesh, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT3, sizeof(Triangle), triangles_.size()));
@@ -130,11 +128,27 @@ unsigned int Primitive::addToScene(RTCDevice device, RTCScene scene)
   // enable raycasting
   rtcSetGeometryMask(mesh, 0b11111111'11111111'11111111'11111111);
   rtcCommitGeometry(mesh);
+  return mesh;
+}
+
+unsigned int Primitive::addToScene(RTCDevice device, RTCScene scene)
+{
+  RTCGeometry mesh = createGeometry(device, transform());
   unsigned int geometry_id = rtcAttachGeometry(scene, mesh);
   rtcReleaseGeometry(mesh);
   return geometry_id;
 }
 
+RTCScene Primitive::createPrototype(RTCDevice device) const
+{
+  RTCScene scene = rtcNewScene(device);
+  RTCGeometry mesh = createGeometry(device, vertices_);
+  rtcAttachGeometry(scene, mesh);
+  rtcReleaseGeometry(mesh);
+  rtcCommitScene(scene);
+  return scene;
+}
+
 std::optional<double> Primitive::getMax(const math::geometry::Axis & axis) const
 {
   if (vertices_.empty()) {
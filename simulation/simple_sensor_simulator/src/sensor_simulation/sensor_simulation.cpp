@@ -12,42 +12,115 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <future>
 #include <memory>
 #include <simple_sensor_simulator/sensor_simulation/sensor_simulation.hpp>
 #include <string>
+#include <traffic_simulator/helper/phase_timer.hpp>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace simple_sensor_simulator
 {
+auto SensorSimulation::triangulateLaneletMap(const hdmap_utils::HdMapUtils & hdmap_utils)
+  -> std::pair<std::vector<Vertex>, std::vector<Triangle>>
+{
+  std::vector<Vertex> vertices;
+  std::vector<Triangle> triangles;
+  for (const auto & lanelet_id : hdmap_utils.getLaneletIds()) {
+    const auto left = hdmap_utils.getLeftBound(lanelet_id);
+    const auto right = hdmap_utils.getRightBound(lanelet_id);
+    if (left.empty() or right.empty() or left.size() + right.size() < 3) {
+      continue;
+    }
+    const auto left_offset = static_cast<unsigned int>(vertices.size());
+    const auto right_offset = static_cast<unsigned int>(left_offset + left.size());
+    for (const auto & point : left) {
+      vertices.push_back(toVertex(point));
+    }
+    for (const auto & point : right) {
+      vertices.push_back(toVertex(point));
+    }
+    /*
+       Walk along both bounds at once, always advancing along the bound which is behind in
+       proportion of its points, so the triangles span the strip even if the bounds have different
+       numbers of points.
+    */
+    unsigned int i = 0;
+    unsigned int j = 0;
+    while (i + 1 < left.size() or j + 1 < right.size()) {
+      if (
+        j + 1 == right.size() or
+        (i + 1 < left.size() and (i + 1) * (right.size() - 1) <= (j + 1) * (left.size() - 1))) {
+        triangles.push_back(Triangle{left_offset + i, left_offset + i + 1, right_offset + j});
+        ++i;
+      } else {
+        triangles.push_back(Triangle{left_offset + i, right_offset + j + 1, right_offset + j});
+        ++j;
+      }
+    }
+  }
+  return {vertices, triangles};
+}
+
 auto SensorSimulation::updateSensorFrame(
   double current_simulation_time, const rclcpp::Time & current_ros_time,
   const std::vector<traffic_simulator_msgs::EntityStatus> & entities,
   const simulation_api_schema::UpdateTrafficLightsRequest & update_traffic_lights_request) -> void
 {
-  for (auto & sensor : imu_sensors_) {
-    sensor->update(current_ros_time, entities);
+  traffic_simulator::helper::ScopedPhaseTimer timer("SensorSimulation::updateSensorFrame");
+
+  /*
+     Only the detection sensors and the occupancy grid sensors depend on the lidars, so the other
+     sensors run alongside them. The lidars themselves run one after another on the scene shared
+     by all the entities, since each one already spreads its rays over the thread pool.
+  */
+  auto imu_and_traffic_lights = std::async(std::launch::async, [&]() {
+    for (auto & sensor : imu_sensors_) {
+      traffic_simulator::helper::ScopedPhaseTimer timer("ImuSensor::update");
+      sensor->update(current_ros_time, entities);
+    }
+    for (auto & sensor : traffic_lights_detectors_) {
+      traffic_simulator::helper::ScopedPhaseTimer timer("PseudoTrafficLightsDetector::updateFrame");
+      sensor->updateFrame(current_ros_time, update_traffic_lights_request);
+    }
+  });
+
+  // The sensors below look entities up by their index in `entities`, so the names must be unique
+  std::unordered_map<std::string, std::size_t> entity_indices;
+  for (std::size_t i = 0; i < entities.size(); ++i) {
+    if (not entity_indices.emplace(entities[i].name(), i).second) {
+      throw std::runtime_error(
+        "status contains primitives with the same name: `" + entities[i].name() + "`");
+    }
   }
 
-  std::vector<std::string> lidar_detected_objects = {};
+  // Flags of the entities detected by any lidar, indexed like `entities`
+  std::vector<bool> lidar_detected_objects(entities.size(), false);
   for (auto & sensor : lidar_sensors_) {
+    traffic_simulator::helper::ScopedPhaseTimer timer("LidarSensor::update");
     sensor->update(current_simulation_time, entities, current_ros_time);
     for (const auto & object : sensor->getDetectedObjects()) {
-      if (std::count(lidar_detected_objects.begin(), lidar_detected_objects.end(), object) == 0) {
-        lidar_detected_objects.push_back(object);
+      if (const auto iter = entity_indices.find(object); iter != entity_indices.end()) {
+        lidar_detected_objects[iter->second] = true;
       }
     }
   }
 
-  for (auto & sensor : detection_sensors_) {
-    sensor->update(current_simulation_time, entities, current_ros_time, lidar_detected_objects);
-  }
+  auto occupancy_grids = std::async(std::launch::async, [&]() {
+    for (auto & sensor : occupancy_grid_sensors_) {
+      traffic_simulator::helper::ScopedPhaseTimer timer("OccupancyGridSensor::update");
+      sensor->update(current_simulation_time, entities, current_ros_time, lidar_detected_objects);
+    }
+  });
 
-  for (auto & sensor : occupancy_grid_sensors_) {
+  for (auto & sensor : detection_sensors_) {
+    traffic_simulator::helper::ScopedPhaseTimer timer("DetectionSensor::update");
     sensor->update(current_simulation_time, entities, current_ros_time, lidar_detected_objects);
   }
 
-  for (auto & sensor : traffic_lights_detectors_) {
-    sensor->updateFrame(current_ros_time, update_traffic_lights_request);
-  }
+  occupancy_grids.get();
+  imu_and_traffic_lights.get();
 }
 }  // namespace simple_sensor_simulator
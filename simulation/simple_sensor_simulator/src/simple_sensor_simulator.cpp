@@ -22,6 +22,9 @@
 #include <simple_sensor_simulator/simple_sensor_simulator.hpp>
 #include <simulation_interface/conversions.hpp>
 #include <string>
+#include <traffic_simulator/hdmap_utils/registry.hpp>
+#include <traffic_simulator/helper/phase_timer.hpp>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -29,15 +32,17 @@ namespace simple_sensor_simulator
 {
 ScenarioSimulator::ScenarioSimulator(const rclcpp::NodeOptions & options)
 : Node("simple_sensor_simulator", options),
+  diagnostics_pub_(create_publisher<diagnostic_msgs::msg::DiagnosticArray>(
+    "/simulation/diagnostics", rclcpp::QoS(1))),
   server_(
-    simulation_interface::protocol, simulation_interface::HostName::ANY, getSocketPort(),
+    getTransportProtocol(), simulation_interface::HostName::ANY, getSocketPort(),
     [this](auto &&... xs) { return initialize(std::forward<decltype(xs)>(xs)...); },
     [this](auto &&... xs) { return updateFrame(std::forward<decltype(xs)>(xs)...); },
     [this](auto &&... xs) { return spawnVehicleEntity(std::forward<decltype(xs)>(xs)...); },
     [this](auto &&... xs) { return spawnPedestrianEntity(std::forward<decltype(xs)>(xs)...); },
     [this](auto &&... xs) { return spawnMiscObjectEntity(std::forward<decltype(xs)>(xs)...); },
     [this](auto &&... xs) { return despawnEntity(std::forward<decltype(xs)>(xs)...); },
-    [this](auto &&... xs) { return updateEntityStatus(std::forward<decltype(xs)>(xs)...); },
+    [this](const auto & req, auto & res) { updateEntityStatus(req, res); },
     [this](auto &&... xs) { return attachImuSensor(std::forward<decltype(xs)>(xs)...); },
     [this](auto &&... xs) { return attachLidarSensor(std::forward<decltype(xs)>(xs)...); },
     [this](auto &&... xs) { return attachDetectionSensor(std::forward<decltype(xs)>(xs)...); },
@@ -46,7 +51,9 @@ ScenarioSimulator::ScenarioSimulator(const rclcpp::NodeOptions & options)
     [this](auto &&... xs) {
       return attachPseudoTrafficLightDetector(std::forward<decltype(xs)>(xs)...);
     },
-    [this](auto &&... xs) { return updateStepTime(std::forward<decltype(xs)>(xs)...); })
+    [this](auto &&... xs) { return updateStepTime(std::forward<decltype(xs)>(xs)...); },
+    [this](auto &&... xs) { return spawnEntities(std::forward<decltype(xs)>(xs)...); },
+    [this](auto &&... xs) { return despawnEntities(std::forward<decltype(xs)>(xs)...); })
 {
 }
 
@@ -67,7 +74,20 @@ geographic_msgs::msg::GeoPoint ScenarioSimulator::getOrigin()
   return origin;
 }
 
-ScenarioSimulator::~ScenarioSimulator() {}
+ScenarioSimulator::~ScenarioSimulator()
+{
+  if (sensor_frame_.valid()) {
+    sensor_frame_.wait();
+  }
+}
+
+auto ScenarioSimulator::waitForSensorFrame() -> void
+{
+  if (sensor_frame_.valid()) {
+    /// @note Rethrow here the exception thrown while rendering the previous frame, if any.
+    sensor_frame_.get();
+  }
+}
 
 int ScenarioSimulator::getSocketPort()
 {
@@ -75,9 +95,19 @@ int ScenarioSimulator::getSocketPort()
   return get_parameter("port").as_int();
 }
 
+simulation_interface::TransportProtocol ScenarioSimulator::getTransportProtocol()
+{
+  if (!has_parameter("transport_protocol")) {
+    declare_parameter<std::string>("transport_protocol", "tcp");
+  }
+  return simulation_interface::stringToTransportProtocol(
+    get_parameter("transport_protocol").as_string());
+}
+
 auto ScenarioSimulator::initialize(const simulation_api_schema::InitializeRequest & req)
   -> simulation_api_schema::InitializeResponse
 {
+  waitForSensorFrame();
   initialized_ = true;
   realtime_factor_ = req.realtime_factor();
   step_time_ = req.step_time();
@@ -86,13 +116,38 @@ auto ScenarioSimulator::initialize(const simulation_api_schema::InitializeReques
   builtin_interfaces::msg::Time t;
   simulation_interface::toMsg(req.initialize_ros_time(), t);
   current_ros_time_ = t;
-  hdmap_utils_ = std::make_shared<hdmap_utils::HdMapUtils>(req.lanelet2_map_path(), getOrigin());
+  hdmap_utils_ = hdmap_utils::acquireHdMapUtils(
+    req.lanelet2_map_path(), getOrigin(),
+    [&]() {
+      if (not has_parameter("map_snapshot_directory")) {
+        declare_parameter("map_snapshot_directory", std::string(""));
+      }
+      return get_parameter("map_snapshot_directory").as_string();
+    }(),
+    [&]() {
+      if (not has_parameter("map_region")) {
+        declare_parameter("map_region", std::vector<double>());
+      }
+      return hdmap_utils::toMapRegion(get_parameter("map_region").as_double_array());
+    }());
   traffic_simulator::lanelet_pose::CanonicalizedLaneletPose::setConsiderPoseByRoadSlope([&]() {
     if (not has_parameter("consider_pose_by_road_slope")) {
       declare_parameter("consider_pose_by_road_slope", false);
     }
     return get_parameter("consider_pose_by_road_slope").as_bool();
   }());
+  traffic_simulator::lanelet_pose::CanonicalizedLaneletPose::setUseElevationProfile([&]() {
+    if (not has_parameter("use_elevation_profile")) {
+      declare_parameter("use_elevation_profile", false);
+    }
+    return get_parameter("use_elevation_profile").as_bool();
+  }());
+  pipeline_sensor_frames_ = [&]() {
+    if (not has_parameter("pipeline_sensor_frames")) {
+      declare_parameter("pipeline_sensor_frames", false);
+    }
+    return get_parameter("pipeline_sensor_frames").as_bool();
+  }();
   auto res = simulation_api_schema::InitializeResponse();
   res.mutable_result()->set_success(true);
   res.mutable_result()->set_description("succeed to initialize simulation");
@@ -101,12 +156,14 @@ auto ScenarioSimulator::initialize(const simulation_api_schema::InitializeReques
   pedestrians_.clear();
   misc_objects_.clear();
   entity_status_.clear();
+  entity_names_.clear();
   return res;
 }
 
 auto ScenarioSimulator::updateFrame(const simulation_api_schema::UpdateFrameRequest & req)
   -> simulation_api_schema::UpdateFrameResponse
 {
+  traffic_simulator::helper::ScopedPhaseTimer timer("ScenarioSimulator::updateFrame");
   auto res = simulation_api_schema::UpdateFrameResponse();
   if (!initialized_) {
     res.mutable_result()->set_description("simulator have not initialized yet.");
@@ -131,13 +188,39 @@ auto ScenarioSimulator::updateFrame(const simulation_api_schema::UpdateFrameRequ
       *status.mutable_bounding_box() = getBoundingBox(status.name());
       return status;
     });
-  sensor_sim_.updateSensorFrame(
-    current_simulation_time_, current_ros_time_, entity_status, traffic_signals_states_);
+  waitForSensorFrame();
+  if (pipeline_sensor_frames_) {
+    sensor_frame_ = std::async(
+      std::launch::async, [this, current_simulation_time = current_simulation_time_,
+                           current_ros_time = current_ros_time_,
+                           entity_status = std::move(entity_status),
+                           traffic_signals_states = traffic_signals_states_]() {
+        sensor_sim_.updateSensorFrame(
+          current_simulation_time, current_ros_time, entity_status, traffic_signals_states);
+      });
+  } else {
+    sensor_sim_.updateSensorFrame(
+      current_simulation_time_, current_ros_time_, entity_status, traffic_signals_states_);
+  }
+  publishDiagnostics();
   res.mutable_result()->set_success(true);
   res.mutable_result()->set_description("succeed to update frame");
   return res;
 }
 
+auto ScenarioSimulator::publishDiagnostics() -> void
+{
+  if (const auto now = std::chrono::steady_clock::now();
+      diagnostics_published_time_ + std::chrono::seconds(1) <= now) {
+    diagnostics_published_time_ = now;
+    diagnostic_msgs::msg::DiagnosticArray diagnostics;
+    diagnostics.header.stamp = current_ros_time_;
+    diagnostics.status.push_back(
+      traffic_simulator::helper::makePhaseTimingStatus("simple_sensor_simulator: frame phases"));
+    diagnostics_pub_->publish(diagnostics);
+  }
+}
+
 auto ScenarioSimulator::updateStepTime(const simulation_api_schema::UpdateStepTimeRequest & req)
   -> simulation_api_schema::UpdateStepTimeResponse
 {
@@ -148,10 +231,10 @@ auto ScenarioSimulator::updateStepTime(const simulation_api_schema::UpdateStepTi
 }
 
 auto ScenarioSimulator::updateEntityStatus(
-  const simulation_api_schema::UpdateEntityStatusRequest & req)
-  -> simulation_api_schema::UpdateEntityStatusResponse
+  const simulation_api_schema::UpdateEntityStatusRequest & req,
+  simulation_api_schema::UpdateEntityStatusResponse & res) -> void
 {
-  auto res = simulation_api_schema::UpdateEntityStatusResponse();
+  traffic_simulator::helper::ScopedPhaseTimer timer("ScenarioSimulator::updateEntityStatus");
   auto copyStatusToResponse = [&](const simulation_api_schema::EntityStatus & status) {
     auto updated_status = res.add_status();
     updated_status->set_name(status.name());
@@ -159,6 +242,10 @@ auto ScenarioSimulator::updateEntityStatus(
     updated_status->mutable_pose()->CopyFrom(status.pose());
   };
 
+  for (const auto & [name, handle] : req.handles()) {
+    entity_names_[handle] = name;
+  }
+
   for (const auto & status : req.status()) {
     try {
       if (isEgo(status.name())) {
@@ -186,9 +273,20 @@ auto ScenarioSimulator::updateEntityStatus(
     }
   }
 
+  /// @note The traffic simulator already has the kinematics, so they are not sent back.
+  for (const auto & kinematics : req.kinematics()) {
+    try {
+      auto & status = entity_status_.at(entity_names_.at(kinematics.handle()));
+      *status.mutable_pose() = kinematics.pose();
+      *status.mutable_action_status()->mutable_twist() = kinematics.twist();
+      *status.mutable_action_status()->mutable_accel() = kinematics.accel();
+    } catch (const std::out_of_range & e) {
+      THROW_SEMANTIC_ERROR("Entity of handle ", kinematics.handle(), " does not exist");
+    }
+  }
+
   res.mutable_result()->set_success(true);
   res.mutable_result()->set_description("");
-  return res;
 }
 
 template <typename SpawnRequestType>
@@ -204,6 +302,8 @@ auto ScenarioSimulator::insertEntitySpawnedStatus(
   init_status.mutable_action_status()->set_current_action("initializing");
   init_status.mutable_pose()->CopyFrom(spawn_request.pose());
   entity_status_.insert({spawn_request.parameters().name(), init_status});
+  waitForSensorFrame();
+  sensor_sim_.setEntityModel(spawn_request.parameters().name(), spawn_request.asset_key());
 }
 
 auto ScenarioSimulator::spawnVehicleEntity(
@@ -293,15 +393,82 @@ auto ScenarioSimulator::despawnEntity(const simulation_api_schema::DespawnEntity
                                       remove_despawn_requested_entity_from(misc_objects_);
   if (any_entity_was_removed) {
     entity_status_.erase(req.name());
+    waitForSensorFrame();
+    sensor_sim_.setEntityModel(req.name(), "");
   }
   auto res = simulation_api_schema::DespawnEntityResponse();
   res.mutable_result()->set_success(any_entity_was_removed);
   return res;
 }
 
+auto ScenarioSimulator::spawnEntities(const simulation_api_schema::SpawnEntitiesRequest & req)
+  -> simulation_api_schema::SpawnEntitiesResponse
+{
+  auto res = simulation_api_schema::SpawnEntitiesResponse();
+  vehicles_.reserve(vehicles_.size() + req.vehicles_size());
+  pedestrians_.reserve(pedestrians_.size() + req.pedestrians_size());
+  misc_objects_.reserve(misc_objects_.size() + req.misc_objects_size());
+  const auto spawn_all = [&](const auto & requests, const auto & spawn) {
+    for (const auto & request : requests) {
+      if (const auto result = spawn(request).result(); not result.success()) {
+        *res.mutable_result() = result;
+        return false;
+      }
+    }
+    return true;
+  };
+  if (
+    spawn_all(req.vehicles(), [this](const auto & x) { return spawnVehicleEntity(x); }) and
+    spawn_all(req.pedestrians(), [this](const auto & x) { return spawnPedestrianEntity(x); }) and
+    spawn_all(req.misc_objects(), [this](const auto & x) { return spawnMiscObjectEntity(x); })) {
+    res.mutable_result()->set_success(true);
+  }
+  return res;
+}
+
+auto ScenarioSimulator::despawnEntities(const simulation_api_schema::DespawnEntitiesRequest & req)
+  -> simulation_api_schema::DespawnEntitiesResponse
+{
+  const auto names = std::unordered_set<std::string>(req.names().begin(), req.names().end());
+  auto removed_names = std::vector<std::string>();
+  auto remove_despawn_requested_entities_from = [&](auto & v) {
+    const auto size = std::size(v);
+    v.erase(
+      std::remove_if(
+        std::begin(v), std::end(v),
+        [&](const auto & entity) {
+          if (names.count(entity.name())) {
+            removed_names.push_back(entity.name());
+            return true;
+          } else {
+            return false;
+          }
+        }),
+      std::end(v));
+    return size != std::size(v);  // true if something removed.
+  };
+  if (remove_despawn_requested_entities_from(ego_vehicles_)) {
+    ego_entity_simulation_.reset();
+  }
+  remove_despawn_requested_entities_from(vehicles_);
+  remove_despawn_requested_entities_from(pedestrians_);
+  remove_despawn_requested_entities_from(misc_objects_);
+  if (not removed_names.empty()) {
+    waitForSensorFrame();
+  }
+  for (const auto & name : removed_names) {
+    entity_status_.erase(name);
+    sensor_sim_.setEntityModel(name, "");
+  }
+  auto res = simulation_api_schema::DespawnEntitiesResponse();
+  res.mutable_result()->set_success(removed_names.size() == names.size());
+  return res;
+}
+
 auto ScenarioSimulator::attachImuSensor(const simulation_api_schema::AttachImuSensorRequest & req)
   -> simulation_api_schema::AttachImuSensorResponse
 {
+  waitForSensorFrame();
   sensor_sim_.attachImuSensor(current_simulation_time_, req.configuration(), *this);
   auto res = simulation_api_schema::AttachImuSensorResponse();
   res.mutable_result()->set_success(true);
@@ -312,6 +479,7 @@ auto ScenarioSimulator::attachDetectionSensor(
   const simulation_api_schema::AttachDetectionSensorRequest & req)
   -> simulation_api_schema::AttachDetectionSensorResponse
 {
+  waitForSensorFrame();
   sensor_sim_.attachDetectionSensor(current_simulation_time_, req.configuration(), *this);
   auto res = simulation_api_schema::AttachDetectionSensorResponse();
   res.mutable_result()->set_success(true);
@@ -322,7 +490,9 @@ auto ScenarioSimulator::attachLidarSensor(
   const simulation_api_schema::AttachLidarSensorRequest & req)
   -> simulation_api_schema::AttachLidarSensorResponse
 {
-  sensor_sim_.attachLidarSensor(current_simulation_time_, req.configuration(), *this);
+  waitForSensorFrame();
+  sensor_sim_.attachLidarSensor(
+    current_simulation_time_, req.configuration(), *this, hdmap_utils_);
   auto res = simulation_api_schema::AttachLidarSensorResponse();
   res.mutable_result()->set_success(true);
   return res;
@@ -333,6 +503,7 @@ auto ScenarioSimulator::attachOccupancyGridSensor(
   -> simulation_api_schema::AttachOccupancyGridSensorResponse
 {
   auto res = simulation_api_schema::AttachOccupancyGridSensorResponse();
+  waitForSensorFrame();
   sensor_sim_.attachOccupancyGridSensor(current_simulation_time_, req.configuration(), *this);
   res.mutable_result()->set_success(true);
   return res;
@@ -353,6 +524,7 @@ auto ScenarioSimulator::attachPseudoTrafficLightDetector(
   -> simulation_api_schema::AttachPseudoTrafficLightDetectorResponse
 {
   auto response = simulation_api_schema::AttachPseudoTrafficLightDetectorResponse();
+  waitForSensorFrame();
   sensor_sim_.attachPseudoTrafficLightsDetector(
     current_simulation_time_, req.configuration(), *this, hdmap_utils_);
   response.mutable_result()->set_success(true);
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cmath>
 #include <concealer/autoware_universe.hpp>
 #include <filesystem>
 #include <geometry/quaternion/euler_to_quaternion.hpp>
@@ -43,7 +44,9 @@ EgoEntitySimulation::EgoEntitySimulation(
   const rclcpp::Parameter & use_sim_time, const bool consider_acceleration_by_road_slope)
 : autoware(std::make_unique<concealer::AutowareUniverse>()),
   vehicle_model_type_(getVehicleModelType()),
-  vehicle_model_ptr_(makeSimulationModel(vehicle_model_type_, step_time, parameters)),
+  vehicle_model_sub_step_count_(getVehicleModelSubStepCount(step_time)),
+  vehicle_model_ptr_(makeSimulationModel(
+    vehicle_model_type_, step_time / vehicle_model_sub_step_count_, parameters)),
   status_(initial_status, std::nullopt),
   initial_pose_(status_.getMapPose()),
   initial_rotation_matrix_(math::geometry::getRotationMatrix(initial_pose_.orientation)),
@@ -100,6 +103,23 @@ auto EgoEntitySimulation::getVehicleModelType() -> VehicleModelType
   }
 }
 
+auto EgoEntitySimulation::getVehicleModelSubStepCount(const double step_time) -> std::size_t
+{
+  /// @note 0 integrates the vehicle model once per frame, whatever the frame rate is.
+  const auto vehicle_model_step_time = getParameter<double>("vehicle_model_step_time", 0.0);
+
+  if (vehicle_model_step_time < 0.0) {
+    THROW_SEMANTIC_ERROR(
+      "vehicle_model_step_time must not be negative, but ", vehicle_model_step_time,
+      " specified");
+  } else if (vehicle_model_step_time == 0.0 or vehicle_model_step_time >= step_time) {
+    return 1;
+  } else {
+    /// @note The tolerance keeps e.g. 1/30 [s] divided by 1/300 [s] from giving 11 sub steps.
+    return static_cast<std::size_t>(std::ceil(step_time / vehicle_model_step_time - 1e-6));
+  }
+}
+
 auto EgoEntitySimulation::makeSimulationModel(
   const VehicleModelType vehicle_model_type, const double step_time,
   const traffic_simulator_msgs::msg::VehicleParameters & parameters)
@@ -189,7 +209,7 @@ auto EgoEntitySimulation::setAutowareStatus() -> void
 
 void EgoEntitySimulation::requestSpeedChange(double value)
 {
-  Eigen::VectorXd v(vehicle_model_ptr_->getDimX());
+  SimModelInterface::Vector v(vehicle_model_ptr_->getDimX());
 
   switch (vehicle_model_type_) {
     case VehicleModelType::DELAY_STEER_ACC:
@@ -252,7 +272,8 @@ auto EgoEntitySimulation::overwrite(
              (previous_linear_velocity_ ? *previous_angular_velocity_ : 0) * step_time;
     }();
 
-    switch (auto state = Eigen::VectorXd(vehicle_model_ptr_->getDimX()); vehicle_model_type_) {
+    switch (auto state = SimModelInterface::Vector(vehicle_model_ptr_->getDimX());
+            vehicle_model_type_) {
       case VehicleModelType::DELAY_STEER_ACC:
       case VehicleModelType::DELAY_STEER_ACC_GEARED:
       case VehicleModelType::DELAY_STEER_MAP_ACC_GEARED:
@@ -303,7 +324,7 @@ void EgoEntitySimulation::update(
                                status_.getMapPose().position.z - initial_pose_.position.z);
 
   if (is_npc_logic_started) {
-    auto input = Eigen::VectorXd(vehicle_model_ptr_->getDimU());
+    auto input = SimModelInterface::Vector(vehicle_model_ptr_->getDimU());
 
     auto acceleration_by_slope = [this]() {
       if (consider_acceleration_by_road_slope_) {
@@ -340,7 +361,9 @@ void EgoEntitySimulation::update(
 
     vehicle_model_ptr_->setGear(autoware->getGearCommand().command);
     vehicle_model_ptr_->setInput(input);
-    vehicle_model_ptr_->update(step_time);
+    for (std::size_t i = 0; i < vehicle_model_sub_step_count_; ++i) {
+      vehicle_model_ptr_->update(step_time / vehicle_model_sub_step_count_);
+    }
   }
   // only the position in the Oz axis is left unchanged, the rest is taken from SimModelInterface
   world_relative_position_.x() = vehicle_model_ptr_->getX();
@@ -356,36 +379,38 @@ auto EgoEntitySimulation::calculateEgoPitch() const -> double
     return 0.0;
   }
 
-  /// @note Copied from motion_util::findNearestSegmentIndex
-  auto centerline_points = hdmap_utils_ptr_->getCenterPoints(status_.getLaneletId());
-  auto find_nearest_segment_index =
-    [](const std::vector<geometry_msgs::msg::Point> & points, const Eigen::Vector3d & point) {
-      assert(not points.empty());
-
-      double min_dist = std::numeric_limits<double>::max();
-      size_t min_idx = 0;
-
-      for (size_t i = 0; i < points.size(); ++i) {
-        const auto dist =
-          [](const geometry_msgs::msg::Point & point1, const Eigen::Vector3d & point2) {
-            const auto dx = point1.x - point2.x();
-            const auto dy = point1.y - point2.y();
-            return dx * dx + dy * dy;
-          }(points.at(i), point);
-
-        if (dist < min_dist) {
-          min_dist = dist;
-          min_idx = i;
-        }
-      }
-      return min_idx;
-    };
+  /*
+     The ego moves a few segments of the centerline per frame at most, so the segment holding the
+     arc length of its lanelet pose is searched from the one of the previous frame.
+  */
+  auto & cursor = centerline_cursor_;
+  if (not cursor.points or cursor.lanelet_id != status_.getLaneletId()) {
+    cursor = {hdmap_utils_ptr_->getSharedCenterPoints(status_.getLaneletId()),
+              status_.getLaneletId(), 0, 0.0};
+  }
 
-  const size_t ego_seg_idx =
-    find_nearest_segment_index(centerline_points, world_relative_position_);
+  const auto & centerline_points = *cursor.points;
+  if (centerline_points.size() < 2) {
+    return 0.0;
+  }
+
+  const auto segment_length = [&](const std::size_t i) {
+    const auto & from = centerline_points[i];
+    const auto & to = centerline_points[i + 1];
+    return std::hypot(to.x - from.x, to.y - from.y, to.z - from.z);
+  };
+
+  const auto s = status_.getLaneletPose().s;
+  while (cursor.segment_index + 2 < centerline_points.size() and
+         cursor.segment_start_s + segment_length(cursor.segment_index) < s) {
+    cursor.segment_start_s += segment_length(cursor.segment_index++);
+  }
+  while (cursor.segment_index > 0 and s < cursor.segment_start_s) {
+    cursor.segment_start_s -= segment_length(--cursor.segment_index);
+  }
 
-  const auto & prev_point = centerline_points.at(ego_seg_idx);
-  const auto & next_point = centerline_points.at(ego_seg_idx + 1);
+  const auto & prev_point = centerline_points[cursor.segment_index];
+  const auto & next_point = centerline_points[cursor.segment_index + 1];
 
   /// @note Calculate ego yaw angle on lanelet coordinates
   const double lanelet_yaw = std::atan2(next_point.y - prev_point.y, next_point.x - prev_point.x);
@@ -466,20 +491,31 @@ auto EgoEntitySimulation::setStatus(const traffic_simulator_msgs::msg::EntitySta
 {
   /// @note The lanelet matching algorithm should be equivalent to the one used in
   /// EgoEntity::setStatus
-  const auto unique_route_lanelets =
-    traffic_simulator::helper::getUniqueValues(autoware->getRouteLanelets());
-  const auto matching_distance = std::max(
-                                   vehicle_parameters.axles.front_axle.track_width,
-                                   vehicle_parameters.axles.rear_axle.track_width) *
-                                   0.5 +
-                                 1.0;
-  /// @note Ego uses the unique_route_lanelets get from Autoware, instead of the current lanelet_id
-  /// value from EntityStatus, therefore canonicalization has to be done in advance,
-  /// not inside CanonicalizedEntityStatus
-  const auto canonicalized_lanelet_pose = traffic_simulator::pose::toCanonicalizedLaneletPose(
-    status.pose, status.bounding_box, unique_route_lanelets, false, matching_distance,
-    hdmap_utils_ptr_);
-  status_.set(traffic_simulator::CanonicalizedEntityStatus(status, canonicalized_lanelet_pose));
+  if (auto route_lanelets = autoware->getRouteLanelets(); route_lanelets != route_lanelets_) {
+    route_lanelets_ = std::move(route_lanelets);
+    unique_route_lanelets_ = traffic_simulator::helper::getUniqueValues(route_lanelets_);
+    matched_pose_.reset();
+  }
+  /*
+     The ego does not move until the NPC logic starts or while it stops, so the pose of the previous
+     frame is matched once and its lanelet pose is reused. The pitch of the ego and the slope of the
+     road are then calculated on this lanelet pose as well.
+  */
+  if (not matched_pose_ or matched_pose_.value() != status.pose) {
+    const auto matching_distance = std::max(
+                                     vehicle_parameters.axles.front_axle.track_width,
+                                     vehicle_parameters.axles.rear_axle.track_width) *
+                                     0.5 +
+                                   1.0;
+    /// @note Ego uses the unique_route_lanelets get from Autoware, instead of the current
+    /// lanelet_id value from EntityStatus, therefore canonicalization has to be done in advance,
+    /// not inside CanonicalizedEntityStatus
+    matched_lanelet_pose_ = traffic_simulator::pose::toCanonicalizedLaneletPose(
+      status.pose, status.bounding_box, unique_route_lanelets_, false, matching_distance,
+      hdmap_utils_ptr_);
+    matched_pose_ = status.pose;
+  }
+  status_.set(traffic_simulator::CanonicalizedEntityStatus(status, matched_lanelet_pose_));
   setAutowareStatus();
 }
 
@@ -0,0 +1,55 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cmath>
+#include <simple_sensor_simulator/vehicle_simulation/vehicle_model/delay_line.hpp>
+
+void DelayLine::initialize(const double delay, const double dt)
+{
+  const auto step_count = static_cast<std::size_t>(std::round(delay / dt));
+  delay_ = step_count * dt;
+  time_ = 0.0;
+  tolerance_ = dt * 1.0e-6;
+
+  values_.assign(2 * step_count + 2, 0.0);
+  times_.resize(values_.size());
+  /// @note The newest sample is at the back, the older ones before it in the ring
+  newest_ = times_.size() - 1;
+  for (std::size_t i = 0; i < times_.size(); ++i) {
+    times_[newest_ - i] = -(i * dt);
+  }
+}
+
+double DelayLine::update(const double input, const double dt)
+{
+  time_ += dt;
+  newest_ = (newest_ + 1) % values_.size();
+  values_[newest_] = input;
+  times_[newest_] = time_;
+
+  const double delayed_time = time_ - delay_;
+  std::size_t newer = newest_;
+  for (std::size_t age = 0; age < values_.size(); ++age) {
+    const std::size_t i = (newest_ + values_.size() - age) % values_.size();
+    if (times_[i] <= delayed_time + tolerance_) {
+      if (age == 0 or delayed_time - times_[i] <= tolerance_) {
+        return values_[i];
+      }
+      const double ratio = (delayed_time - times_[i]) / (times_[newer] - times_[i]);
+      return values_[i] + (values_[newer] - values_[i]) * ratio;
+    }
+    newer = i;
+  }
+  return values_[newer];
+}
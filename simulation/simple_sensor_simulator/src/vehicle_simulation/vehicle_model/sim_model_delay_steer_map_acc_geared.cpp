@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <cmath>
 #include <autoware_auto_vehicle_msgs/msg/gear_command.hpp>
 #include <simple_sensor_simulator/vehicle_simulation/vehicle_model/sim_model_delay_steer_map_acc_geared.hpp>
 
@@ -186,11 +187,79 @@ double CSVLoader::clampValue(
   return val;
 }
 
+AccelerationMap::UniformAxis::UniformAxis(const std::vector<double> & index)
+{
+  if (index.size() < 2) {
+    throw std::invalid_argument(
+      "The size of points is less than 2. index.size() = " + std::to_string(index.size()));
+  }
+  if (!interpolation_utils::isIncreasing(index)) {
+    throw std::invalid_argument("The index of the acceleration map is not sorted.");
+  }
+
+  double smallest_step = index[1] - index[0];
+  for (std::size_t i = 2; i < index.size(); ++i) {
+    smallest_step = std::min(smallest_step, index[i] - index[i - 1]);
+  }
+
+  min = index.front();
+  max = index.back();
+  // NOTE: The tolerance keeps the size of a uniform index despite the calculation error of double.
+  size = std::min(
+    max_size, static_cast<std::size_t>(std::ceil((max - min) / smallest_step - 1e-6)) + 1);
+  step = (max - min) / (size - 1);
+}
+
+std::pair<std::size_t, double> AccelerationMap::UniformAxis::locate(
+  const double value, const char * name) const
+{
+  if (value < min || max < value) {
+    std::cerr << "Input " << name << ": " << value
+              << " is out of range. use closest value. Please update the conversion map"
+              << std::endl;
+  }
+  const double position = (std::min(std::max(value, min), max) - min) / step;
+  const auto i = std::min(static_cast<std::size_t>(position), size - 2);
+  return {i, position - i};
+}
+
+void AccelerationMap::resample()
+{
+  vel_axis_ = UniformAxis(vel_index_);
+  acc_axis_ = UniformAxis(acc_index_);
+
+  std::vector<double> samples;
+  samples.reserve(acc_axis_.size * vel_axis_.size);
+  for (std::size_t i = 0; i < acc_axis_.size; ++i) {
+    // (throttle, vel, acc) map => (throttle, acc) map by fixing vel, then interpolate throttle
+    for (std::size_t j = 0; j < vel_axis_.size; ++j) {
+      std::vector<double> interpolated_acc_vec;
+      for (const auto & acc_vec : acceleration_map_) {
+        interpolated_acc_vec.push_back(interpolation::lerp(vel_index_, acc_vec, vel_axis_.at(j)));
+      }
+      samples.push_back(interpolation::lerp(acc_index_, interpolated_acc_vec, acc_axis_.at(i)));
+    }
+  }
+
+  const auto sample = [&](std::size_t i, std::size_t j) { return samples[i * vel_axis_.size + j]; };
+  cell_coefficients_.clear();
+  cell_coefficients_.reserve((acc_axis_.size - 1) * (vel_axis_.size - 1));
+  for (std::size_t i = 0; i + 1 < acc_axis_.size; ++i) {
+    for (std::size_t j = 0; j + 1 < vel_axis_.size; ++j) {
+      const double v00 = sample(i, j);
+      const double v01 = sample(i, j + 1);
+      const double v10 = sample(i + 1, j);
+      const double v11 = sample(i + 1, j + 1);
+      cell_coefficients_.push_back({v00, v01 - v00, v10 - v00, v11 - v10 - v01 + v00});
+    }
+  }
+}
+
 SimModelDelaySteerMapAccGeared::SimModelDelaySteerMapAccGeared(
   double vx_lim, double steer_lim, double vx_rate_lim, double steer_rate_lim, double wheelbase,
   double dt, double acc_delay, double acc_time_constant, double steer_delay,
   double steer_time_constant, std::string path)
-: SimModelInterface(6 /* dim x */, 2 /* dim u */),
+: SimModelBase(),
   MIN_TIME_CONSTANT(0.03),
   vx_lim_(vx_lim),
   vx_rate_lim_(vx_rate_lim),
@@ -220,14 +289,10 @@ double SimModelDelaySteerMapAccGeared::getWz()
 double SimModelDelaySteerMapAccGeared::getSteer() { return state_(IDX::STEER); }
 void SimModelDelaySteerMapAccGeared::update(const double & dt)
 {
-  Eigen::VectorXd delayed_input = Eigen::VectorXd::Zero(dim_u_);
+  Input delayed_input = Input::Zero();
 
-  acc_input_queue_.push_back(input_(IDX_U::ACCX_DES));
-  delayed_input(IDX_U::ACCX_DES) = acc_input_queue_.front();
-  acc_input_queue_.pop_front();
-  steer_input_queue_.push_back(input_(IDX_U::STEER_DES));
-  delayed_input(IDX_U::STEER_DES) = steer_input_queue_.front();
-  steer_input_queue_.pop_front();
+  delayed_input(IDX_U::ACCX_DES) = acc_input_delay_line_.update(input_(IDX_U::ACCX_DES), dt);
+  delayed_input(IDX_U::STEER_DES) = steer_input_delay_line_.update(input_(IDX_U::STEER_DES), dt);
 
   const auto prev_state = state_;
   updateRungeKutta(dt, delayed_input);
@@ -242,17 +307,12 @@ void SimModelDelaySteerMapAccGeared::update(const double & dt)
 
 void SimModelDelaySteerMapAccGeared::initializeInputQueue(const double & dt)
 {
-  size_t acc_input_queue_size = static_cast<size_t>(round(acc_delay_ / dt));
-  acc_input_queue_.resize(acc_input_queue_size);
-  std::fill(acc_input_queue_.begin(), acc_input_queue_.end(), 0.0);
-
-  size_t steer_input_queue_size = static_cast<size_t>(round(steer_delay_ / dt));
-  steer_input_queue_.resize(steer_input_queue_size);
-  std::fill(steer_input_queue_.begin(), steer_input_queue_.end(), 0.0);
+  acc_input_delay_line_.initialize(acc_delay_, dt);
+  steer_input_delay_line_.initialize(steer_delay_, dt);
 }
 
-Eigen::VectorXd SimModelDelaySteerMapAccGeared::calcModel(
-  const Eigen::VectorXd & state, const Eigen::VectorXd & input)
+SimModelDelaySteerMapAccGeared::State SimModelDelaySteerMapAccGeared::calcModel(
+  const State & state, const Input & input)
 {
   const double vel = std::clamp(state(IDX::VX), -vx_lim_, vx_lim_);
   const double acc = std::clamp(state(IDX::ACCX), -vx_rate_lim_, vx_rate_lim_);
@@ -263,7 +323,7 @@ Eigen::VectorXd SimModelDelaySteerMapAccGeared::calcModel(
   double steer_rate = -(steer - steer_des) / steer_time_constant_;
   steer_rate = std::clamp(steer_rate, -steer_rate_lim_, steer_rate_lim_);
 
-  Eigen::VectorXd d_state = Eigen::VectorXd::Zero(dim_x_);
+  State d_state = State::Zero();
   d_state(IDX::X) = vel * cos(yaw);
   d_state(IDX::Y) = vel * sin(yaw);
   d_state(IDX::YAW) = vel * std::tan(steer) / wheelbase_;
@@ -278,7 +338,7 @@ Eigen::VectorXd SimModelDelaySteerMapAccGeared::calcModel(
 }
 
 void SimModelDelaySteerMapAccGeared::updateStateWithGear(
-  Eigen::VectorXd & state, const Eigen::VectorXd & prev_state, const uint8_t gear, const double dt)
+  State & state, const State & prev_state, const uint8_t gear, const double dt)
 {
   using autoware_auto_vehicle_msgs::msg::GearCommand;
   if (
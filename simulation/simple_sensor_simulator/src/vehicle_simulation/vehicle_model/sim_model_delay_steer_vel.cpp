@@ -19,7 +19,7 @@ SimModelDelaySteerVel::SimModelDelaySteerVel(
   double vx_lim, double steer_lim, double vx_rate_lim, double steer_rate_lim, double wheelbase,
   double dt, double vx_delay, double vx_time_constant, double steer_delay,
   double steer_time_constant, double steer_dead_band)
-: SimModelInterface(5 /* dim x */, 2 /* dim u */),
+: SimModelBase(),
   MIN_TIME_CONSTANT(0.03),
   vx_lim_(vx_lim),
   vx_rate_lim_(vx_rate_lim),
@@ -48,14 +48,10 @@ double SimModelDelaySteerVel::getWz()
 double SimModelDelaySteerVel::getSteer() { return state_(IDX::STEER); }
 void SimModelDelaySteerVel::update(const double & dt)
 {
-  Eigen::VectorXd delayed_input = Eigen::VectorXd::Zero(dim_u_);
+  Input delayed_input = Input::Zero();
 
-  vx_input_queue_.push_back(input_(IDX_U::VX_DES));
-  delayed_input(IDX_U::VX_DES) = vx_input_queue_.front();
-  vx_input_queue_.pop_front();
-  steer_input_queue_.push_back(input_(IDX_U::STEER_DES));
-  delayed_input(IDX_U::STEER_DES) = steer_input_queue_.front();
-  steer_input_queue_.pop_front();
+  delayed_input(IDX_U::VX_DES) = vx_input_delay_line_.update(input_(IDX_U::VX_DES), dt);
+  delayed_input(IDX_U::STEER_DES) = steer_input_delay_line_.update(input_(IDX_U::STEER_DES), dt);
   // do not use deadzone_delta_steer (Steer IF does not exist in this model)
   updateRungeKutta(dt, delayed_input);
   current_ax_ = (input_(IDX_U::VX_DES) - prev_vx_) / dt;
@@ -64,18 +60,12 @@ void SimModelDelaySteerVel::update(const double & dt)
 
 void SimModelDelaySteerVel::initializeInputQueue(const double & dt)
 {
-  size_t vx_input_queue_size = static_cast<size_t>(round(vx_delay_ / dt));
-  for (size_t i = 0; i < vx_input_queue_size; i++) {
-    vx_input_queue_.push_back(0.0);
-  }
-  size_t steer_input_queue_size = static_cast<size_t>(round(steer_delay_ / dt));
-  for (size_t i = 0; i < steer_input_queue_size; i++) {
-    steer_input_queue_.push_back(0.0);
-  }
+  vx_input_delay_line_.initialize(vx_delay_, dt);
+  steer_input_delay_line_.initialize(steer_delay_, dt);
 }
 
-Eigen::VectorXd SimModelDelaySteerVel::calcModel(
-  const Eigen::VectorXd & state, const Eigen::VectorXd & input)
+SimModelDelaySteerVel::State SimModelDelaySteerVel::calcModel(
+  const State & state, const Input & input)
 {
   auto sat = [](double val, double u, double l) { return std::max(std::min(val, u), l); };
 
@@ -100,7 +90,7 @@ Eigen::VectorXd SimModelDelaySteerVel::calcModel(
   const double steer_rate =
     sat(-steer_diff_with_dead_band / steer_time_constant_, steer_rate_lim_, -steer_rate_lim_);
 
-  Eigen::VectorXd d_state = Eigen::VectorXd::Zero(dim_x_);
+  State d_state = State::Zero();
   d_state(IDX::X) = vx * cos(yaw);
   d_state(IDX::Y) = vx * sin(yaw);
   d_state(IDX::YAW) = vx * std::tan(steer) / wheelbase_;
@@ -15,7 +15,7 @@
 #include <simple_sensor_simulator/vehicle_simulation/vehicle_model/sim_model_ideal_steer_acc.hpp>
 
 SimModelIdealSteerAcc::SimModelIdealSteerAcc(double wheelbase)
-: SimModelInterface(4 /* dim x */, 2 /* dim u */), wheelbase_(wheelbase)
+: SimModelBase(), wheelbase_(wheelbase)
 {
 }
 
@@ -32,15 +32,15 @@ double SimModelIdealSteerAcc::getWz()
 double SimModelIdealSteerAcc::getSteer() { return input_(IDX_U::STEER_DES); }
 void SimModelIdealSteerAcc::update(const double & dt) { updateRungeKutta(dt, input_); }
 
-Eigen::VectorXd SimModelIdealSteerAcc::calcModel(
-  const Eigen::VectorXd & state, const Eigen::VectorXd & input)
+SimModelIdealSteerAcc::State SimModelIdealSteerAcc::calcModel(
+  const State & state, const Input & input)
 {
   const double vx = state(IDX::VX);
   const double yaw = state(IDX::YAW);
   const double ax = input(IDX_U::AX_DES);
   const double steer = input(IDX_U::STEER_DES);
 
-  Eigen::VectorXd d_state = Eigen::VectorXd::Zero(dim_x_);
+  State d_state = State::Zero();
   d_state(IDX::X) = vx * std::cos(yaw);
   d_state(IDX::Y) = vx * std::sin(yaw);
   d_state(IDX::VX) = ax;
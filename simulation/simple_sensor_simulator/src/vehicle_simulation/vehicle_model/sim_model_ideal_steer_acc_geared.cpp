@@ -17,7 +17,7 @@
 #include <simple_sensor_simulator/vehicle_simulation/vehicle_model/sim_model_ideal_steer_acc_geared.hpp>
 
 SimModelIdealSteerAccGeared::SimModelIdealSteerAccGeared(double wheelbase)
-: SimModelInterface(4 /* dim x */, 2 /* dim u */), wheelbase_(wheelbase), current_acc_(0.0)
+: SimModelBase(), wheelbase_(wheelbase), current_acc_(0.0)
 {
 }
 
@@ -42,15 +42,15 @@ void SimModelIdealSteerAccGeared::update(const double & dt)
   updateStateWithGear(state_, prev_state, gear_, dt);
 }
 
-Eigen::VectorXd SimModelIdealSteerAccGeared::calcModel(
-  const Eigen::VectorXd & state, const Eigen::VectorXd & input)
+SimModelIdealSteerAccGeared::State SimModelIdealSteerAccGeared::calcModel(
+  const State & state, const Input & input)
 {
   const double vx = state(IDX::VX);
   const double yaw = state(IDX::YAW);
   const double ax = input(IDX_U::AX_DES);
   const double steer = input(IDX_U::STEER_DES);
 
-  Eigen::VectorXd d_state = Eigen::VectorXd::Zero(dim_x_);
+  State d_state = State::Zero();
   d_state(IDX::X) = vx * std::cos(yaw);
   d_state(IDX::Y) = vx * std::sin(yaw);
   d_state(IDX::VX) = ax;
@@ -60,7 +60,7 @@ Eigen::VectorXd SimModelIdealSteerAccGeared::calcModel(
 }
 
 void SimModelIdealSteerAccGeared::updateStateWithGear(
-  Eigen::VectorXd & state, const Eigen::VectorXd & prev_state, const uint8_t gear, const double dt)
+  State & state, const State & prev_state, const uint8_t gear, const double dt)
 {
   const auto setStopState = [&]() {
     state(IDX::VX) = 0.0;
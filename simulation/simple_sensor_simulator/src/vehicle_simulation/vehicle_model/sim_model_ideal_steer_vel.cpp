@@ -15,7 +15,7 @@
 #include <simple_sensor_simulator/vehicle_simulation/vehicle_model/sim_model_ideal_steer_vel.hpp>
 
 SimModelIdealSteerVel::SimModelIdealSteerVel(double wheelbase)
-: SimModelInterface(3 /* dim x */, 2 /* dim u */), wheelbase_(wheelbase)
+: SimModelBase(), wheelbase_(wheelbase)
 {
 }
 
@@ -37,14 +37,14 @@ void SimModelIdealSteerVel::update(const double & dt)
   prev_vx_ = input_(IDX_U::VX_DES);
 }
 
-Eigen::VectorXd SimModelIdealSteerVel::calcModel(
-  const Eigen::VectorXd & state, const Eigen::VectorXd & input)
+SimModelIdealSteerVel::State SimModelIdealSteerVel::calcModel(
+  const State & state, const Input & input)
 {
   const double yaw = state(IDX::YAW);
   const double vx = input(IDX_U::VX_DES);
   const double steer = input(IDX_U::STEER_DES);
 
-  Eigen::VectorXd d_state = Eigen::VectorXd::Zero(dim_x_);
+  State d_state = State::Zero();
   d_state(IDX::X) = vx * std::cos(yaw);
   d_state(IDX::Y) = vx * std::sin(yaw);
   d_state(IDX::YAW) = vx * std::tan(steer) / wheelbase_;
@@ -0,0 +1,41 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "benchmark_utils.hpp"
+
+namespace
+{
+std::atomic<std::size_t> allocation_count{0};
+}  // namespace
+
+auto benchmark_utils::getAllocationCount() -> std::size_t { return allocation_count.load(); }
+
+/// @note Count the allocations of the whole process, the simulators allocate through these.
+void * operator new(std::size_t size)
+{
+  ++allocation_count;
+  if (void * pointer = std::malloc(size == 0 ? 1 : size)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void * pointer) noexcept { std::free(pointer); }
+
+void operator delete(void * pointer, std::size_t) noexcept { std::free(pointer); }
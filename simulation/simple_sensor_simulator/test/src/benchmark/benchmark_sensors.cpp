@@ -0,0 +1,142 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <nav_msgs/msg/occupancy_grid.hpp>
+#include <sensor_msgs/msg/imu.hpp>
+#include <sensor_msgs/msg/point_cloud2.hpp>
+#include <simple_sensor_simulator/sensor_simulation/detection_sensor/detection_sensor.hpp>
+#include <simple_sensor_simulator/sensor_simulation/imu/imu_sensor.hpp>
+#include <simple_sensor_simulator/sensor_simulation/lidar/lidar_sensor.hpp>
+#include <simple_sensor_simulator/sensor_simulation/occupancy_grid/occupancy_grid_sensor.hpp>
+#include <vector>
+
+#include "benchmark_utils.hpp"
+
+using namespace simple_sensor_simulator;
+
+/// @note The argument is the number of entities around the ego, the same in every benchmark.
+static void LidarSensorUpdate(benchmark::State & state)
+{
+  const auto frames = benchmark_utils::recordFrames(state.range(0));
+  const auto configuration =
+    utils::constructLidarConfiguration("ego", "awf/universe", 0.0, utils::degToRad(0.2));
+  auto lidar = LidarSensor<sensor_msgs::msg::PointCloud2>(
+    0.0, configuration,
+    benchmark_utils::getNode().create_publisher<sensor_msgs::msg::PointCloud2>(
+      "benchmark/pointcloud", 1));
+  const auto rays_per_scan = static_cast<std::int64_t>(
+    configuration.vertical_angles_size() * 2 * M_PI / configuration.horizontal_resolution());
+
+  auto time = 0.0;
+  std::size_t frame = 0;
+  const auto allocation_counter = benchmark_utils::AllocationCounter(state);
+  for (auto _ : state) {
+    time += configuration.scan_duration();
+    lidar.update(time, frames[frame++ % frames.size()], rclcpp::Time(time * 1e9));
+  }
+  state.SetItemsProcessed(state.iterations() * rays_per_scan);
+}
+BENCHMARK(LidarSensorUpdate)->Arg(10)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+static void DetectionSensorUpdate(benchmark::State & state)
+{
+  const auto frames = benchmark_utils::recordFrames(state.range(0));
+  simulation_api_schema::DetectionSensorConfiguration configuration;
+  configuration.set_entity("ego");
+  configuration.set_architecture_type("awf/universe");
+  configuration.set_update_duration(0.1);
+  configuration.set_range(300.0);
+  configuration.set_detect_all_objects_in_range(true);
+  configuration.set_pos_noise_stddev(0.1);
+  configuration.set_random_seed(1);
+  configuration.set_probability_of_lost(0.1);
+  using DetectedObjects = autoware_auto_perception_msgs::msg::DetectedObjects;
+  using TrackedObjects = autoware_auto_perception_msgs::msg::TrackedObjects;
+  /// @note Nobody subscribes to the ground truth, so it is not built, as in most scenarios.
+  auto detection = DetectionSensor<DetectedObjects>(
+    0.0, configuration,
+    benchmark_utils::getNode().create_publisher<DetectedObjects>("benchmark/detected_objects", 1),
+    benchmark_utils::getNode().create_publisher<TrackedObjects>("benchmark/ground_truth", 1));
+  const auto lidar_detected_entities = std::vector<bool>(state.range(0) + 1, false);
+
+  auto time = 0.0;
+  std::size_t frame = 0;
+  const auto allocation_counter = benchmark_utils::AllocationCounter(state);
+  for (auto _ : state) {
+    time += configuration.update_duration();
+    detection.update(
+      time, frames[frame++ % frames.size()], rclcpp::Time(time * 1e9), lidar_detected_entities);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(DetectionSensorUpdate)->Arg(10)->Arg(100)->Arg(1000)->Unit(benchmark::kMicrosecond);
+
+static void OccupancyGridSensorUpdate(benchmark::State & state)
+{
+  const auto frames = benchmark_utils::recordFrames(state.range(0));
+  simulation_api_schema::OccupancyGridSensorConfiguration configuration;
+  configuration.set_entity("ego");
+  configuration.set_architecture_type("awf/universe");
+  configuration.set_update_duration(0.1);
+  configuration.set_resolution(0.5);
+  configuration.set_width(400);
+  configuration.set_height(400);
+  configuration.set_range(300.0);
+  configuration.set_filter_by_range(true);
+  auto occupancy_grid = OccupancyGridSensor<nav_msgs::msg::OccupancyGrid>(
+    0.0, configuration,
+    benchmark_utils::getNode().create_publisher<nav_msgs::msg::OccupancyGrid>(
+      "benchmark/occupancy_grid", 1));
+  const auto lidar_detected_entities = std::vector<bool>(state.range(0) + 1, true);
+
+  auto time = 0.0;
+  std::size_t frame = 0;
+  const auto allocation_counter = benchmark_utils::AllocationCounter(state);
+  for (auto _ : state) {
+    time += configuration.update_duration();
+    occupancy_grid.update(
+      time, frames[frame++ % frames.size()], rclcpp::Time(time * 1e9), lidar_detected_entities);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(OccupancyGridSensorUpdate)->Arg(10)->Arg(100)->Arg(1000)->Unit(benchmark::kMicrosecond);
+
+static void ImuSensorUpdate(benchmark::State & state)
+{
+  const auto frames = benchmark_utils::recordFrames(state.range(0));
+  simulation_api_schema::ImuSensorConfiguration configuration;
+  configuration.set_entity("ego");
+  configuration.set_frame_id("base_link");
+  configuration.set_add_gravity(true);
+  configuration.set_use_seed(true);
+  configuration.set_seed(1);
+  configuration.set_noise_standard_deviation_orientation(0.01);
+  configuration.set_noise_standard_deviation_twist(0.01);
+  configuration.set_noise_standard_deviation_acceleration(0.01);
+  const auto imu = ImuSensor<sensor_msgs::msg::Imu>(
+    configuration,
+    benchmark_utils::getNode().create_publisher<sensor_msgs::msg::Imu>("benchmark/imu", 1));
+
+  auto time = 0.0;
+  std::size_t frame = 0;
+  const auto allocation_counter = benchmark_utils::AllocationCounter(state);
+  for (auto _ : state) {
+    time += 0.05;
+    benchmark::DoNotOptimize(imu.update(rclcpp::Time(time * 1e9), frames[frame++ % frames.size()]));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(ImuSensorUpdate)->Arg(10)->Arg(1000)->Unit(benchmark::kMicrosecond);
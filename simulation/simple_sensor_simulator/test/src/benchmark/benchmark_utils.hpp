@@ -0,0 +1,104 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SIMPLE_SENSOR_SIMULATOR__TEST__BENCHMARK_UTILS_HPP_
+#define SIMPLE_SENSOR_SIMULATOR__TEST__BENCHMARK_UTILS_HPP_
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <rclcpp/rclcpp.hpp>
+#include <string>
+#include <vector>
+
+#include "../utils/helper_functions.hpp"
+
+namespace benchmark_utils
+{
+/// @note Number of calls to operator new in the process, counted by allocation_count.cpp.
+auto getAllocationCount() -> std::size_t;
+
+/// @brief Report the allocations per iteration of the benchmark since its construction.
+class AllocationCounter
+{
+public:
+  explicit AllocationCounter(benchmark::State & state)
+  : state_(state), initial_count_(getAllocationCount())
+  {
+  }
+
+  ~AllocationCounter()
+  {
+    const auto allocation_count = getAllocationCount() - initial_count_;
+    state_.counters["allocations"] = benchmark::Counter(
+      static_cast<double>(allocation_count), benchmark::Counter::kAvgIterations);
+  }
+
+private:
+  benchmark::State & state_;
+  const std::size_t initial_count_;
+};
+
+/// @note The sensors publish through this node, which is never spun.
+inline auto getNode() -> rclcpp::Node &
+{
+  static const auto node = [] {
+    if (not rclcpp::ok()) {
+      rclcpp::init(0, nullptr);
+    }
+    return std::make_shared<rclcpp::Node>("sensor_simulation_benchmark_node");
+  }();
+  return *node;
+}
+
+/**
+ * @brief Frames of entities driving around the ego on concentric rings, recorded once and
+ * replayed by the benchmarks so that all of them trace the same workload.
+ * @note Hard coded parameter, the rings are 10 m apart and the entities drive at 10 m/s, so most of
+ * them stay within the range of the sensors.
+ */
+inline auto recordFrames(const std::size_t entity_count, const std::size_t frame_count = 100)
+  -> std::vector<std::vector<EntityStatus>>
+{
+  constexpr double ring_spacing = 10.0;
+  constexpr double entities_per_ring = 16.0;
+  constexpr double speed = 10.0;
+  constexpr double step_time = 0.05;
+
+  std::vector<std::vector<EntityStatus>> frames(frame_count);
+  for (std::size_t frame = 0; frame < frame_count; ++frame) {
+    auto & statuses = frames[frame];
+    statuses.push_back(utils::makeEntity(
+      "ego", EntityType::EGO, EntitySubtype::CAR, utils::makePose(0, 0, 0, 0, 0, 0, 1),
+      utils::makeDimensions(4.5, 2.0, 1.5)));
+    for (std::size_t i = 0; i < entity_count; ++i) {
+      const auto radius = ring_spacing * (1.0 + std::floor(i / entities_per_ring));
+      const auto yaw = 2.0 * M_PI * i / entities_per_ring + speed * step_time * frame / radius;
+      const auto heading = yaw + M_PI_2;
+      statuses.push_back(utils::makeEntity(
+        "entity" + std::to_string(i), EntityType::VEHICLE, EntitySubtype::CAR,
+        utils::makePose(
+          radius * std::cos(yaw), radius * std::sin(yaw), 0, 0, 0, std::sin(heading / 2),
+          std::cos(heading / 2)),
+        utils::makeDimensions(4.5, 2.0, 1.5)));
+    }
+  }
+  return frames;
+}
+}  // namespace benchmark_utils
+
+#endif  // SIMPLE_SENSOR_SIMULATOR__TEST__BENCHMARK_UTILS_HPP_
@@ -0,0 +1,208 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <autoware_auto_vehicle_msgs/msg/gear_command.hpp>
+#include <cmath>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <simple_sensor_simulator/vehicle_simulation/vehicle_model/sim_model.hpp>
+#include <string>
+#include <vector>
+
+#include "benchmark_utils.hpp"
+
+namespace
+{
+/// @note Hard coded parameters, the defaults of EgoEntitySimulation for a typical passenger car.
+constexpr double vel_lim = 50.0;
+constexpr double steer_lim = 0.64;
+constexpr double vel_rate_lim = 7.0;
+constexpr double steer_rate_lim = 5.0;
+constexpr double wheel_base = 2.79;
+
+/// @note The control period of Autoware, the step of the simulation with the default frame rate.
+constexpr double step_time = 0.05;
+
+/// @note The reference trajectory is integrated with this many sub steps per command.
+constexpr std::size_t reference_sub_step_count = 100;
+
+struct Command
+{
+  double acceleration;
+  double velocity;
+  double steering;
+};
+
+/**
+ * @brief Control commands of Autoware driving off, through an S-curve and stopping, recorded once
+ * and replayed by the benchmarks so that all the models trace the same inputs.
+ * @note The acceleration and the deceleration are balanced, so the velocity is 0 at the end and the
+ * sequence can be replayed in a loop.
+ */
+auto recordCommands(const double duration = 30.0) -> const std::vector<Command> &
+{
+  static const auto commands = [&]() {
+    std::vector<Command> commands;
+    double velocity = 0.0;
+    for (double time = 0.0; time < duration; time += step_time) {
+      const auto acceleration = time < 5.0 ? 1.0 : time < 25.0 ? 0.0 : -1.0;
+      const auto steering = 5.0 <= time and time < 25.0 ? 0.2 * std::sin(0.5 * (time - 5.0)) : 0.0;
+      commands.push_back(Command{acceleration, velocity, steering});
+      velocity = std::max(velocity + acceleration * step_time, 0.0);
+    }
+    return commands;
+  }();
+  return commands;
+}
+
+/**
+ * @brief The map of DELAY_STEER_MAP_ACC_GEARED, the engine gets weaker as the vehicle speeds up.
+ * @note The vehicle slightly rolls back after the stop because of the delays, so the map also
+ * covers negative velocities.
+ */
+auto writeAccelerationMap() -> std::string
+{
+  static const auto path = [] {
+    const auto path = std::filesystem::temp_directory_path() / "benchmark_acceleration_map.csv";
+    std::ofstream file(path);
+    file << "default,-5.0,0.0,5.0,10.0,15.0,20.0\n";
+    for (double acceleration = -3.0; acceleration <= 3.0; acceleration += 0.5) {
+      file << acceleration;
+      for (double velocity = -5.0; velocity <= 20.0; velocity += 5.0) {
+        const auto power = acceleration > 0.0 ? 1.0 - 0.02 * std::max(velocity, 0.0) : 1.0;
+        file << "," << acceleration * power;
+      }
+      file << "\n";
+    }
+    return path.string();
+  }();
+  return path;
+}
+
+struct VehicleModelType
+{
+  std::string name;
+
+  /// @note The models with a delay are built for the step time, so they are made for each of them.
+  std::function<std::unique_ptr<SimModelInterface>(double)> make;
+
+  bool takes_velocity = false;
+};
+
+const std::vector<VehicleModelType> vehicle_model_types{
+  {"DELAY_STEER_ACC",
+   [](double dt) {
+     return std::make_unique<SimModelDelaySteerAcc>(
+       vel_lim, steer_lim, vel_rate_lim, steer_rate_lim, wheel_base, dt, 0.1, 0.1, 0.24, 0.27, 0.0,
+       1.0, 1.0);
+   }},
+  {"DELAY_STEER_ACC_GEARED",
+   [](double dt) {
+     return std::make_unique<SimModelDelaySteerAccGeared>(
+       vel_lim, steer_lim, vel_rate_lim, steer_rate_lim, wheel_base, dt, 0.1, 0.1, 0.24, 0.27, 0.0,
+       1.0, 1.0);
+   }},
+  {"DELAY_STEER_MAP_ACC_GEARED",
+   [](double dt) {
+     return std::make_unique<SimModelDelaySteerMapAccGeared>(
+       vel_lim, steer_lim, vel_rate_lim, steer_rate_lim, wheel_base, dt, 0.1, 0.1, 0.24, 0.27,
+       writeAccelerationMap());
+   }},
+  {"DELAY_STEER_VEL",
+   [](double dt) {
+     return std::make_unique<SimModelDelaySteerVel>(
+       vel_lim, steer_lim, vel_rate_lim, steer_rate_lim, wheel_base, dt, 0.1, 0.1, 0.24, 0.27,
+       0.0);
+   },
+   true},
+  {"IDEAL_STEER_ACC", [](double) { return std::make_unique<SimModelIdealSteerAcc>(wheel_base); }},
+  {"IDEAL_STEER_ACC_GEARED",
+   [](double) { return std::make_unique<SimModelIdealSteerAccGeared>(wheel_base); }},
+  {"IDEAL_STEER_VEL",
+   [](double) { return std::make_unique<SimModelIdealSteerVel>(wheel_base); },
+   true},
+};
+
+auto makeVehicleModel(const VehicleModelType & type, const double dt)
+  -> std::unique_ptr<SimModelInterface>
+{
+  auto model = type.make(dt);
+  model->setGear(autoware_auto_vehicle_msgs::msg::GearCommand::DRIVE);
+  return model;
+}
+
+auto setCommand(SimModelInterface & model, const VehicleModelType & type, const Command & command)
+  -> void
+{
+  auto input = SimModelInterface::Vector(model.getDimU());
+  input(0) = type.takes_velocity ? command.velocity : command.acceleration;
+  input(1) = command.steering;
+  model.setInput(input);
+}
+
+/**
+ * @return Largest distance between the positions of the model stepped once per command and of the
+ * same model stepped with sub steps, the reference for the model and its integrator.
+ */
+auto calculateMaxPositionError(const VehicleModelType & type) -> double
+{
+  auto model = makeVehicleModel(type, step_time);
+  auto reference = makeVehicleModel(type, step_time / reference_sub_step_count);
+
+  double max_error = 0.0;
+  for (const auto & command : recordCommands()) {
+    setCommand(*model, type, command);
+    model->update(step_time);
+    setCommand(*reference, type, command);
+    for (std::size_t i = 0; i < reference_sub_step_count; ++i) {
+      reference->update(step_time / reference_sub_step_count);
+    }
+    max_error = std::max(
+      max_error, std::hypot(model->getX() - reference->getX(), model->getY() - reference->getY()));
+  }
+  return max_error;
+}
+}  // namespace
+
+/// @note The argument is the index of the vehicle model type in the list above.
+static void VehicleModelUpdate(benchmark::State & state)
+{
+  const auto & type = vehicle_model_types[state.range(0)];
+  const auto & commands = recordCommands();
+  state.SetLabel(type.name);
+  state.counters["max_position_error"] = calculateMaxPositionError(type);
+
+  auto model = makeVehicleModel(type, step_time);
+  const auto initial_state = SimModelInterface::Vector::Zero(model->getDimX()).eval();
+
+  std::size_t step = 0;
+  const auto allocation_counter = benchmark_utils::AllocationCounter(state);
+  for (auto _ : state) {
+    if (step == commands.size()) {
+      model->setState(initial_state);
+      step = 0;
+    }
+    setCommand(*model, type, commands[step++]);
+    model->update(step_time);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(VehicleModelUpdate)->DenseRange(0, 6)->Unit(benchmark::kNanosecond);
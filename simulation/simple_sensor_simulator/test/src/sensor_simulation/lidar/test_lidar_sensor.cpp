@@ -82,3 +82,29 @@ TEST_F(LidarSensorTest, getDetectedObjects)
   ASSERT_FALSE(unique_objects.empty());
   EXPECT_EQ(unique_objects, expected_objects);
 }
+
+/**
+ * @note Test basic functionality. Test lidar sensor in azimuth slices on a static scene - the goal
+ * is to check if the slices of one scan contain together the points of the full scan.
+ */
+TEST_F(LidarSensorTest, update_azimuthSliced)
+{
+  lidar_->update(current_simulation_time_, status_, current_ros_time_);
+  rclcpp::spin_some(node_);
+  ASSERT_NE(received_msg_, nullptr);
+  const auto full_scan_points = received_msg_->width * received_msg_->height;
+
+  auto config = config_;
+  config.set_azimuth_sliced(true);
+  const auto sliced_lidar =
+    std::make_unique<LidarSensor<sensor_msgs::msg::PointCloud2>>(0.0, config, publisher_);
+  std::size_t sliced_points = 0;
+  for (const auto time : {config.scan_duration() / 2, config.scan_duration()}) {
+    received_msg_ = nullptr;
+    sliced_lidar->update(time, status_, current_ros_time_);
+    rclcpp::spin_some(node_);
+    ASSERT_NE(received_msg_, nullptr);
+    sliced_points += received_msg_->width * received_msg_->height;
+  }
+  EXPECT_EQ(sliced_points, full_scan_points);
+}
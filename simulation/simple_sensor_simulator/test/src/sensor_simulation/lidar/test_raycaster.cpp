@@ -66,6 +66,64 @@ TEST_F(RaycasterTest, raycast_box)
   EXPECT_EQ(cloud.header.stamp, stamp_);
 }
 
+/**
+ * @note Test function behavior when the box is not added for the next scan - the goal is to have
+ * the box removed from the scene.
+ */
+TEST_F(RaycasterTest, raycast_removedBox)
+{
+  raycaster_->addPrimitive<primitives::Box>(
+    box_name_, box_depth_, box_width_, box_height_, box_pose_);
+  raycaster_->raycast(frame_id_, stamp_, origin_);
+
+  const auto cloud = raycaster_->raycast(frame_id_, stamp_, origin_);
+
+  EXPECT_EQ(cloud.width * cloud.height, 0);
+  EXPECT_TRUE(raycaster_->getDetectedObject().empty());
+}
+
+/**
+ * @note Test function behavior when the box is added with another pose for the next scan - the
+ * goal is to have the points on the box at its new pose.
+ */
+TEST_F(RaycasterTest, raycast_movedBox)
+{
+  raycaster_->addPrimitive<primitives::Box>(
+    box_name_, box_depth_, box_width_, box_height_, box_pose_);
+  raycaster_->raycast(frame_id_, stamp_, origin_);
+
+  raycaster_->addPrimitive<primitives::Box>(
+    box_name_, box_depth_, box_width_, box_height_,
+    utils::makePose(10.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0));
+  pcl::PointCloud<pcl::PointXYZI> cloud;
+  pcl::fromROSMsg(raycaster_->raycast(frame_id_, stamp_, origin_), cloud);
+
+  ASSERT_FALSE(cloud.empty());
+  for (const auto & point : cloud) {
+    EXPECT_NEAR(point.x, 9.5, 1e-3);
+  }
+}
+
+/**
+ * @note Test basic functionality. Test raycasting a static ground mesh - the goal is to get points
+ * only on the ground, which is not reported as a detected object.
+ */
+TEST_F(RaycasterTest, raycast_staticMesh)
+{
+  const std::vector<Vertex> vertices = {
+    {-50.0f, -50.0f, -1.0f}, {50.0f, -50.0f, -1.0f}, {50.0f, 50.0f, -1.0f}, {-50.0f, 50.0f, -1.0f}};
+  raycaster_->addStaticMesh(vertices, {{0, 1, 2}, {0, 2, 3}});
+
+  pcl::PointCloud<pcl::PointXYZI> cloud;
+  pcl::fromROSMsg(raycaster_->raycast(frame_id_, stamp_, origin_), cloud);
+
+  ASSERT_FALSE(cloud.empty());
+  for (const auto & point : cloud) {
+    EXPECT_NEAR(point.z, -1.0, 1e-3);
+  }
+  EXPECT_TRUE(raycaster_->getDetectedObject().empty());
+}
+
 /**
  * @note Test basic functionality. Test setting ray directions with a lidar configuration that has
  * one ray which intersects with the only box on the scene.
@@ -140,6 +198,63 @@ TEST_F(RaycasterTest, getDetectedObjects)
   EXPECT_EQ(detected_objects[0], box_name_);
 }
 
+/**
+ * @note Test function behavior when the LiDARs of several entities share the scene - the goal is to
+ * test that the rays of the LiDAR of an entity skip that entity, but not the other entities.
+ */
+TEST_F(RaycasterTest, getRayMask_sharedScene)
+{
+  const auto ego_mask = raycaster_->getRayMask("ego");
+  const auto other_mask = raycaster_->getRayMask("other");
+  EXPECT_NE(ego_mask, other_mask);
+  EXPECT_EQ(raycaster_->getRayMask("ego"), ego_mask);
+
+  raycaster_->addPrimitive<primitives::Box>("ego", box_depth_, box_width_, box_height_, origin_);
+  raycaster_->addPrimitive<primitives::Box>(
+    "other", box_depth_, box_width_, box_height_, box_pose_);
+  raycaster_->commit(stamp_);
+
+  const auto directions = raycaster_->makeDirections(config_);
+  raycaster_->raycast(directions, frame_id_, stamp_, origin_, 300, 0, ego_mask);
+  EXPECT_EQ(raycaster_->getDetectedObject(), std::vector<std::string>{"other"});
+
+  raycaster_->raycast(directions, frame_id_, stamp_, box_pose_, 300, 0, other_mask);
+  EXPECT_EQ(raycaster_->getDetectedObject(), std::vector<std::string>{"ego"});
+}
+
+/**
+ * @note Test the visibility test with a box behind another one - the goal is to have the far box
+ * visible only through a target which the near box does not hide.
+ */
+TEST_F(RaycasterTest, isVisible_occludedBox)
+{
+  raycaster_->addPrimitive<primitives::Box>(
+    "near", box_depth_, box_width_, box_height_, box_pose_);
+  raycaster_->addPrimitive<primitives::Box>(
+    "far", box_depth_, box_width_, box_height_,
+    utils::makePose(10.0, 0.8, 0.0, 0.0, 0.0, 0.0, 1.0));
+  raycaster_->commit(stamp_);
+
+  const auto makePoint = [](const double x, const double y, const double z) {
+    return geometry_msgs::build<Point>().x(x).y(y).z(z);
+  };
+  EXPECT_TRUE(raycaster_->isVisible(origin_.position, "near", {makePoint(5.0, 0.0, 0.0)}));
+  EXPECT_FALSE(raycaster_->isVisible(origin_.position, "far", {makePoint(10.0, 0.8, 0.0)}));
+  EXPECT_TRUE(raycaster_->isVisible(
+    origin_.position, "far", {makePoint(10.0, 0.8, 0.0), makePoint(10.0, 1.2, 0.0)}));
+}
+
+/**
+ * @note Test function behavior when selecting the ray tracing backend - the goal is to test that
+ * the Embree backend is the default and that an unavailable backend is an error.
+ */
+TEST(RaycasterBackendTest, makeRaycaster)
+{
+  EXPECT_NE(makeRaycaster(""), nullptr);
+  EXPECT_NE(makeRaycaster("embree"), nullptr);
+  EXPECT_THROW(makeRaycaster("unknown"), SimulationRuntimeError);
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
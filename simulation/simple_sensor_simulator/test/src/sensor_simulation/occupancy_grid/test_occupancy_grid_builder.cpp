@@ -0,0 +1,59 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <simple_sensor_simulator/sensor_simulation/occupancy_grid/occupancy_grid_builder.hpp>
+#include <simple_sensor_simulator/sensor_simulation/primitives/box.hpp>
+
+#include "../../utils/helper_functions.hpp"
+
+using namespace simple_sensor_simulator;
+
+/**
+ * @note Test basic functionality. Test building a grid with one box in front of the origin - the
+ * goal is to mark the box as occupied, the area behind it as invisible and the rest as free.
+ */
+TEST(OccupancyGridBuilder, build_box)
+{
+  OccupancyGridBuilder builder(1.0, 20, 20);
+  builder.reset(utils::makePose(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0));
+  builder.add(primitives::Box(2.0, 2.0, 2.0, utils::makePose(3.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0)));
+  builder.build();
+
+  const auto & values = builder.get();
+  EXPECT_EQ(values[10 * 20 + 13], builder.occupied_cost);
+  EXPECT_EQ(values[10 * 20 + 18], builder.invisible_cost);
+  EXPECT_EQ(values[10 * 20 + 10], 0);
+  EXPECT_EQ(values[10 * 20 + 5], 0);
+}
+
+/**
+ * @note Test function behavior when the grid is built again without primitives - the goal is to
+ * test that no cell of the previous build is left marked.
+ */
+TEST(OccupancyGridBuilder, build_afterReset)
+{
+  OccupancyGridBuilder builder(1.0, 20, 20);
+  builder.reset(utils::makePose(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0));
+  builder.add(primitives::Box(2.0, 2.0, 2.0, utils::makePose(3.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0)));
+  builder.build();
+
+  builder.reset(utils::makePose(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0));
+  builder.build();
+
+  const auto & values = builder.get();
+  EXPECT_TRUE(std::all_of(values.begin(), values.end(), [](auto value) { return value == 0; }));
+}
@@ -0,0 +1,121 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <geometry_msgs/msg/pose.hpp>
+#include <simple_sensor_simulator/sensor_simulation/primitives/box.hpp>
+#include <simple_sensor_simulator/sensor_simulation/primitives/mesh.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../../utils/expect_eq_macros.hpp"
+
+using namespace simple_sensor_simulator;
+using namespace simple_sensor_simulator::primitives;
+
+/**
+ * @note Test parsing correctness. The goal is to test whether the faces of an OBJ file are split
+ * into triangle fans, with the texture and normal indices ignored and negative indices resolved.
+ */
+TEST(MeshTest, read_quad)
+{
+  std::istringstream obj(
+    "# quad\n"
+    "v 0 0 0\n"
+    "v 1 0 0\n"
+    "v 1 1 0\n"
+    "v 0 1 0\n"
+    "vn 0 0 1\n"
+    "f 1/1/1 2/2/1 3//1 -1\n");
+
+  const auto level = MeshModel::read(obj);
+
+  const std::vector<Triangle> expected_triangles = {{0, 1, 2}, {0, 2, 3}};
+
+  ASSERT_EQ(level.vertices.size(), 4u);
+  ASSERT_EQ(level.triangles.size(), expected_triangles.size());
+  for (size_t i = 0; i < expected_triangles.size(); ++i) {
+    EXPECT_TRIANGLE_EQ(level.triangles[i], expected_triangles[i]);
+  }
+}
+
+/**
+ * @note Test function behavior when the asset key is not an OBJ file - the goal is to test that
+ * no model is loaded, so the entity is traced as its bounding box.
+ */
+TEST(MeshTest, load_modelType)
+{
+  EXPECT_EQ(MeshModel::load("lexus_rx450h"), nullptr);
+  EXPECT_EQ(MeshModel::load("/nonexistent/model.obj"), nullptr);
+}
+
+/**
+ * @note Test loading correctness. The goal is to test whether the levels of detail are loaded
+ * next to the model, fitted into the unit cube, and shared between the loads of the same path.
+ */
+TEST(MeshTest, load_levels)
+{
+  const std::string path = testing::TempDir() + "mesh_test_model.obj";
+  const std::string lod1_path = testing::TempDir() + "mesh_test_model.lod1.obj";
+  std::ofstream(path) << "v 0 0 0\nv 4 0 0\nv 0 2 0\nv 0 0 1\nf 1 2 3\nf 1 2 4\nf 1 3 4\n";
+  std::ofstream(lod1_path) << "v 0 0 0\nv 4 0 0\nv 0 2 1\nf 1 2 3\n";
+
+  const auto model = MeshModel::load(path);
+  std::remove(path.c_str());
+  std::remove(lod1_path.c_str());
+
+  ASSERT_NE(model, nullptr);
+  ASSERT_EQ(model->levels.size(), 2u);
+  EXPECT_EQ(model->levels[0].triangles.size(), 3u);
+  EXPECT_EQ(model->levels[1].triangles.size(), 1u);
+  EXPECT_VERTEX_EQ(model->levels[0].vertices[0], (Vertex{-0.5f, -0.5f, -0.5f}));
+  EXPECT_VERTEX_EQ(model->levels[0].vertices[1], (Vertex{0.5f, -0.5f, -0.5f}));
+  EXPECT_EQ(model->getLevel(0.0), 0u);
+  EXPECT_EQ(model->getLevel(1000.0), 1u);
+  EXPECT_EQ(MeshModel::load(path), model);
+}
+
+/**
+ * @note Test initialization correctness. The goal is to test whether the vertices of the mesh are
+ * the corners of the bounding box, like those of a box, so that its hull does not depend on the
+ * model.
+ */
+TEST(MeshTest, Mesh_boundingBox)
+{
+  std::istringstream obj("v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n");
+  auto model = std::make_shared<MeshModel>();
+  model->levels.push_back(MeshModel::read(obj));
+
+  const auto pose = geometry_msgs::msg::Pose();
+  const Mesh mesh(model, 5, 4.0f, 2.0f, 1.5f, pose);
+  const Box box(4.0f, 2.0f, 1.5f, pose);
+
+  EXPECT_EQ(mesh.level, 0u);
+  const auto vertices = mesh.getVertex();
+  const auto expected_vertices = box.getVertex();
+  ASSERT_EQ(vertices.size(), expected_vertices.size());
+  for (size_t i = 0; i < vertices.size(); ++i) {
+    EXPECT_VERTEX_EQ(vertices[i], expected_vertices[i]);
+  }
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
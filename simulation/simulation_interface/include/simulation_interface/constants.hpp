@@ -19,10 +19,18 @@
 
 namespace simulation_interface
 {
-enum class TransportProtocol { TCP /*, UDP*/ };
+/**
+ * @note IPC connects the simulators running on the same host through a Unix domain socket, which
+ * skips the TCP/IP stack of the loopback interface. The hostname is then not part of the endpoint.
+ * INPROC connects the simulators running in the same process, the client calling the handlers of
+ * the server directly without any socket nor serialization.
+ */
+enum class TransportProtocol { TCP, IPC, INPROC /*, UDP*/ };
 
 std::string enumToString(const TransportProtocol & protocol);
 
+TransportProtocol stringToTransportProtocol(const std::string & protocol);
+
 enum class HostName { LOCALHOST, ANY };
 
 std::string enumToString(const HostName & hostname);
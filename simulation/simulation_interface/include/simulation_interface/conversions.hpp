@@ -22,6 +22,8 @@
 #include <std_msgs.pb.h>
 #include <traffic_simulator_msgs.pb.h>
 
+#include <google/protobuf/arena.h>
+
 #include <autoware_auto_control_msgs/msg/ackermann_control_command.hpp>
 #include <autoware_auto_vehicle_msgs/msg/gear_command.hpp>
 #include <builtin_interfaces/msg/duration.hpp>
@@ -54,6 +56,18 @@
 
 namespace zeromq
 {
+/// @note Hard coded parameter, size of the first block of the arenas of the client and the server.
+constexpr std::size_t arena_block_size = 1 << 20;
+
+/// @note The arena allocates in the block first, which it does not free on reset.
+inline auto makeArenaOptions(std::vector<char> & block) -> google::protobuf::ArenaOptions
+{
+  google::protobuf::ArenaOptions options;
+  options.initial_block = block.data();
+  options.initial_block_size = block.size();
+  return options;
+}
+
 template <typename Proto>
 zmqpp::message toZMQ(const Proto & proto)
 {
@@ -257,6 +271,25 @@ auto toMsg(
   traffic_light_bulb_state.confidence = proto.confidence();
 }
 
+auto toProto(const traffic_simulator_msgs::msg::Vertex &, traffic_simulator_msgs::Vertex &) -> void;
+
+auto toMsg(const traffic_simulator_msgs::Vertex &, traffic_simulator_msgs::msg::Vertex &) -> void;
+
+/// @note Writes into the vertices already held by the destination, see also toMsg.
+auto toProto(const traffic_simulator_msgs::msg::Polyline &, traffic_simulator_msgs::Polyline &)
+  -> void;
+
+auto toMsg(const traffic_simulator_msgs::Polyline &, traffic_simulator_msgs::msg::Polyline &)
+  -> void;
+
+auto toProto(
+  const traffic_simulator_msgs::msg::PolylineTrajectory &,
+  traffic_simulator_msgs::PolylineTrajectory &) -> void;
+
+auto toMsg(
+  const traffic_simulator_msgs::PolylineTrajectory &,
+  traffic_simulator_msgs::msg::PolylineTrajectory &) -> void;
+
 auto toProtobufMessage(const traffic_simulator_msgs::msg::Vertex &)
   -> traffic_simulator_msgs::Vertex;
 
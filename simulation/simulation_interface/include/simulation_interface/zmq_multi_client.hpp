@@ -17,14 +17,20 @@
 
 #include <simulation_api_schema.pb.h>
 
+#include <chrono>
+#include <cstdint>
 #include <functional>
+#include <future>
+#include <google/protobuf/arena.h>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <rclcpp/rclcpp.hpp>
 #include <scenario_simulator_exception/exception.hpp>
 #include <simulation_interface/constants.hpp>
 #include <string>
 #include <thread>
+#include <vector>
 #include <zmqpp/zmqpp.hpp>
 
 namespace zeromq
@@ -85,8 +91,37 @@ public:
   auto call(const simulation_api_schema::AttachPseudoTrafficLightDetectorRequest &)
     -> simulation_api_schema::AttachPseudoTrafficLightDetectorResponse;
 
+  auto call(const simulation_api_schema::StepRequest &) -> simulation_api_schema::StepResponse;
+
+  auto call(const simulation_api_schema::SpawnEntitiesRequest &)
+    -> simulation_api_schema::SpawnEntitiesResponse;
+
+  auto call(const simulation_api_schema::DespawnEntitiesRequest &)
+    -> simulation_api_schema::DespawnEntitiesResponse;
+
+  /**
+   * @brief Send the request and return without waiting for its response.
+   * @note The response is received when the future is waited, on the thread waiting it, so the
+   * requests in flight may be answered while the caller keeps working. The server answers the
+   * requests in order, and a synchronous call first receives the responses of the requests in
+   * flight, which are kept until their futures are waited. With the INPROC protocol the request is
+   * handled before returning.
+   */
+  auto callAsync(const simulation_api_schema::SimulationRequest &)
+    -> std::future<simulation_api_schema::SimulationResponse>;
+
+  auto callAsync(const simulation_api_schema::StepRequest &)
+    -> std::future<simulation_api_schema::StepResponse>;
+
+  /// @return Count of the requests sent to the simulator, in process or not.
+  auto getCallCount() const -> std::uint64_t { return call_count_; }
+
+  /// @return Time spent waiting for the responses of the simulator, in process or not.
+  auto getCallDuration() const -> std::chrono::steady_clock::duration { return call_duration_; }
+
   const simulation_interface::TransportProtocol protocol;
   const std::string hostname;
+  const unsigned int socket_port;
 
 private:
   zmqpp::context context_;
@@ -94,6 +129,54 @@ private:
   zmqpp::socket socket_;
 
   bool is_running = true;
+
+  /**
+   * @note The simulation request and response are allocated in the arena, which is reset for each
+   * call, and serialized through a buffer kept across the calls. So once warmed up, the transport
+   * only allocates the frames of ZeroMQ and the response returned.
+   */
+  std::vector<char> arena_block_;
+  google::protobuf::Arena arena_;
+  std::string serialized_;
+
+  std::uint64_t sent_count_ = 0;
+  std::uint64_t received_count_ = 0;
+  std::uint64_t call_count_ = 0;
+  std::chrono::steady_clock::duration call_duration_{};
+
+  /// @note Responses received before their futures are waited, by the index of their request.
+  std::map<std::uint64_t, simulation_api_schema::SimulationResponse> received_;
+
+  /// @return Index of the request, counted from the first request sent.
+  auto send(const simulation_api_schema::SimulationRequest &) -> std::uint64_t;
+
+  auto receiveNext(simulation_api_schema::SimulationResponse &) -> void;
+
+  auto receive(const std::uint64_t index) -> simulation_api_schema::SimulationResponse;
+
+  auto exchange(const simulation_api_schema::SimulationRequest &)
+    -> const simulation_api_schema::SimulationResponse &;
+
+  /// @note The simulation request only borrows the request, which is not copied.
+  template <typename Request, typename Response>
+  auto call(
+    const Request & request,
+    void (simulation_api_schema::SimulationRequest::*set)(Request *),
+    Request * (simulation_api_schema::SimulationRequest::*release)(),
+    const Response & (simulation_api_schema::SimulationResponse::*get)() const) -> Response
+  {
+    if (is_running) {
+      arena_.Reset();
+      auto & sim_request =
+        *google::protobuf::Arena::CreateMessage<simulation_api_schema::SimulationRequest>(&arena_);
+      (sim_request.*set)(const_cast<Request *>(&request));
+      const auto & sim_response = exchange(sim_request);
+      (sim_request.*release)();
+      return (sim_response.*get)();
+    } else {
+      return {};
+    }
+  }
 };
 }  // namespace zeromq
 
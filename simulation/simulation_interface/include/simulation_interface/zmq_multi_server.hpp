@@ -17,15 +17,45 @@
 
 #include <simulation_api_schema.pb.h>
 
+#include <cstdint>
 #include <functional>
+#include <google/protobuf/arena.h>
+#include <optional>
 #include <rclcpp/rclcpp.hpp>
 #include <scenario_simulator_exception/exception.hpp>
 #include <simulation_interface/constants.hpp>
 #include <string>
 #include <thread>
 #include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include <zmqpp/zmqpp.hpp>
 
+/**
+ * @brief The requests served by MultiServer, as the name of their request and response messages
+ * and the name of their field in the oneof of SimulationRequest and SimulationResponse.
+ * @note The types of the functions of MultiServer, the order of its constructor arguments and the
+ * cases of MultiServer::handle are all generated from this list, so a request is added here only.
+ */
+#define SIMULATION_INTERFACE_MULTI_SERVER_RPCS(RPC)                           \
+  RPC(Initialize, initialize)                                                 \
+  RPC(UpdateFrame, update_frame)                                              \
+  RPC(SpawnVehicleEntity, spawn_vehicle_entity)                               \
+  RPC(SpawnPedestrianEntity, spawn_pedestrian_entity)                         \
+  RPC(SpawnMiscObjectEntity, spawn_misc_object_entity)                        \
+  RPC(DespawnEntity, despawn_entity)                                          \
+  RPC(UpdateEntityStatus, update_entity_status)                               \
+  RPC(AttachImuSensor, attach_imu_sensor)                                     \
+  RPC(AttachLidarSensor, attach_lidar_sensor)                                 \
+  RPC(AttachDetectionSensor, attach_detection_sensor)                         \
+  RPC(AttachOccupancyGridSensor, attach_occupancy_grid_sensor)                \
+  RPC(UpdateTrafficLights, update_traffic_lights)                             \
+  RPC(AttachPseudoTrafficLightDetector, attach_pseudo_traffic_light_detector) \
+  RPC(UpdateStepTime, update_step_time)                                       \
+  RPC(SpawnEntities, spawn_entities)                                          \
+  RPC(DespawnEntities, despawn_entities)
+
 namespace zeromq
 {
 class MultiServer
@@ -36,53 +66,127 @@ public:
     const simulation_interface::TransportProtocol & protocol,
     const simulation_interface::HostName & hostname, const unsigned int socket_port, Ts &&... xs)
   : context_(zmqpp::context()),
-    type_(zmqpp::socket_type::reply),
+    type_(zmqpp::socket_type::router),
     socket_(context_, type_),
+    shutdown_receiver_(context_, zmqpp::socket_type::pair),
+    shutdown_sender_(context_, zmqpp::socket_type::pair),
+    arena_block_(arena_block_size),
+    arena_(makeArenaOptions(arena_block_)),
     functions_(std::forward<decltype(xs)>(xs)...)
   {
-    socket_.bind(simulation_interface::getEndPoint(protocol, hostname, socket_port));
+    if (protocol == simulation_interface::TransportProtocol::INPROC) {
+      registerInProcess(socket_port);
+    } else {
+      socket_.bind(simulation_interface::getEndPoint(protocol, hostname, socket_port));
+    }
+    /// @note Unique per server, since the endpoints of inproc sockets are shared by the process.
+    const auto shutdown_endpoint =
+      "inproc://zeromq_multi_server_shutdown_" +
+      std::to_string(reinterpret_cast<std::uintptr_t>(this));
+    shutdown_receiver_.bind(shutdown_endpoint);
+    shutdown_sender_.connect(shutdown_endpoint);
     poller_.add(socket_);
+    poller_.add(shutdown_receiver_);
     thread_ = std::thread(&MultiServer::start_poll, this);
   }
 
   ~MultiServer();
 
+  /**
+   * @brief Handle the request on the calling thread, with the server of the process serving the
+   * port with the INPROC protocol.
+   * @return false if no server of the process serves the port.
+   */
+  static auto callInProcess(
+    const unsigned int socket_port, const simulation_api_schema::SimulationRequest &,
+    simulation_api_schema::SimulationResponse &) -> bool;
+
 private:
-  void poll();
+  auto handle(
+    const simulation_api_schema::SimulationRequest &, simulation_api_schema::SimulationResponse &)
+    -> void;
+  auto registerInProcess(const unsigned int socket_port) -> void;
+  /// @note Port served with the INPROC protocol, if any.
+  std::optional<unsigned int> in_process_port_;
+  /// @return false if the server has been asked to shut down.
+  auto poll() -> bool;
   void start_poll();
+  /// @note Handled with the functions of the requests it fuses, so it needs no function of its own.
+  auto step(const simulation_api_schema::StepRequest &, simulation_api_schema::StepResponse &)
+    -> void;
   std::thread thread_;
   const zmqpp::context context_;
   const zmqpp::socket_type type_;
   zmqpp::poller poller_;
+  /**
+   * @note A router, so that a client may send its next request before receiving the response of
+   * the previous one. The requests are still handled one by one, in the order they are received.
+   */
   zmqpp::socket socket_;
+  /**
+   * @note The poller blocks on the requests and on these sockets, which the destructor uses to
+   * wake it up. So a request is handled as soon as it is received instead of on the next polling.
+   */
+  zmqpp::socket shutdown_receiver_;
+  zmqpp::socket shutdown_sender_;
+
+  /**
+   * @note The request and the response are allocated in the arena, which is reset for each request,
+   * and serialized through a buffer kept across the requests. So once warmed up, the transport only
+   * allocates the frames of ZeroMQ.
+   */
+  std::vector<char> arena_block_;
+  google::protobuf::Arena arena_;
+  std::string serialized_;
+
+  /**
+   * @brief Function of a request, writing its response in place into the response of the server,
+   * which is allocated in the arena.
+   * @note A function returning its response is also accepted, its response is then assigned to the
+   * one of the server, which copies it since it is not allocated in the arena. So the functions of
+   * the requests with large responses should take the response as their second argument instead.
+   */
+  template <typename Request, typename Response>
+  class Handler
+  {
+  public:
+    template <typename F>
+    Handler(F && f)
+    {
+      if constexpr (std::is_invocable_r_v<Response, F &, const Request &>) {
+        function_ = [f = std::forward<F>(f)](const Request & request, Response & response) mutable {
+          response = f(request);
+        };
+      } else {
+        function_ = std::forward<F>(f);
+      }
+    }
 
-#define DEFINE_FUNCTION_TYPE(TYPENAME)                                      \
-  using TYPENAME = std::function<simulation_api_schema::TYPENAME##Response( \
-    const simulation_api_schema::TYPENAME##Request &)>
-
-  DEFINE_FUNCTION_TYPE(Initialize);
-  DEFINE_FUNCTION_TYPE(UpdateFrame);
-  DEFINE_FUNCTION_TYPE(SpawnVehicleEntity);
-  DEFINE_FUNCTION_TYPE(SpawnPedestrianEntity);
-  DEFINE_FUNCTION_TYPE(SpawnMiscObjectEntity);
-  DEFINE_FUNCTION_TYPE(DespawnEntity);
-  DEFINE_FUNCTION_TYPE(UpdateEntityStatus);
-  DEFINE_FUNCTION_TYPE(AttachImuSensor);
-  DEFINE_FUNCTION_TYPE(AttachLidarSensor);
-  DEFINE_FUNCTION_TYPE(AttachDetectionSensor);
-  DEFINE_FUNCTION_TYPE(AttachOccupancyGridSensor);
-  DEFINE_FUNCTION_TYPE(UpdateTrafficLights);
-  DEFINE_FUNCTION_TYPE(AttachPseudoTrafficLightDetector);
-  DEFINE_FUNCTION_TYPE(UpdateStepTime);
+    auto operator()(const Request & request, Response & response) const -> void
+    {
+      function_(request, response);
+    }
+
+  private:
+    std::function<void(const Request &, Response &)> function_;
+  };
+
+#define DEFINE_FUNCTION_TYPE(TYPENAME, FIELD) \
+  using TYPENAME =                            \
+    Handler<simulation_api_schema::TYPENAME##Request, simulation_api_schema::TYPENAME##Response>;
+
+  SIMULATION_INTERFACE_MULTI_SERVER_RPCS(DEFINE_FUNCTION_TYPE)
 
 #undef DEFINE_FUNCTION_TYPE
 
-  std::tuple<
-    Initialize, UpdateFrame, SpawnVehicleEntity, SpawnPedestrianEntity, SpawnMiscObjectEntity,
-    DespawnEntity, UpdateEntityStatus, AttachImuSensor, AttachLidarSensor, AttachDetectionSensor,
-    AttachOccupancyGridSensor, UpdateTrafficLights, AttachPseudoTrafficLightDetector,
-    UpdateStepTime>
+#define TUPLE_OF_FUNCTION_TYPE(TYPENAME, FIELD) std::declval<std::tuple<TYPENAME>>(),
+
+  /// @note In the order of the list, which is also the order of the functions of the constructor.
+  decltype(std::tuple_cat(
+    SIMULATION_INTERFACE_MULTI_SERVER_RPCS(TUPLE_OF_FUNCTION_TYPE) std::tuple<>()))
     functions_;
+
+#undef TUPLE_OF_FUNCTION_TYPE
 };
 }  // namespace zeromq
 
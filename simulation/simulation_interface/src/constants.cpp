@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <iomanip>
 #include <scenario_simulator_exception/exception.hpp>
 #include <simulation_interface/constants.hpp>
 #include <string>
@@ -21,15 +22,23 @@ namespace simulation_interface
 std::string getEndPoint(
   const TransportProtocol & protocol, const HostName & hostname, const unsigned int & port)
 {
-  return simulation_interface::enumToString(protocol) + "://" +
-         simulation_interface::enumToString(hostname) + ":" + std::to_string(port);
+  return getEndPoint(protocol, simulation_interface::enumToString(hostname), port);
 }
 
 std::string getEndPoint(
   const TransportProtocol & protocol, const std::string & hostname, const unsigned int & port)
 {
-  return simulation_interface::enumToString(protocol) + "://" + hostname + ":" +
-         std::to_string(port);
+  if (protocol == TransportProtocol::INPROC) {
+    return simulation_interface::enumToString(protocol) + "://scenario_simulator_v2_" +
+           std::to_string(port);
+  } else if (protocol == TransportProtocol::IPC) {
+    /// @note The port keeps the endpoints of several simulators on the same host apart.
+    return simulation_interface::enumToString(protocol) + ":///tmp/scenario_simulator_v2_" +
+           std::to_string(port);
+  } else {
+    return simulation_interface::enumToString(protocol) + "://" + hostname + ":" +
+           std::to_string(port);
+  }
 }
 
 std::string enumToString(const TransportProtocol & protocol)
@@ -37,12 +46,31 @@ std::string enumToString(const TransportProtocol & protocol)
   switch (protocol) {
     case TransportProtocol::TCP:
       return "tcp";
+    case TransportProtocol::IPC:
+      return "ipc";
+    case TransportProtocol::INPROC:
+      return "inproc";
       /*
     case TransportProtocol::UDP:
       return "udp";              
       */
   }
-  THROW_SIMULATION_ERROR("Protocol should be TCP.");  // LCOV_EXCL_LINE
+  THROW_SIMULATION_ERROR("Protocol should be TCP, IPC or INPROC.");  // LCOV_EXCL_LINE
+}
+
+TransportProtocol stringToTransportProtocol(const std::string & protocol)
+{
+  if (protocol == "tcp") {
+    return TransportProtocol::TCP;
+  } else if (protocol == "ipc") {
+    return TransportProtocol::IPC;
+  } else if (protocol == "inproc") {
+    return TransportProtocol::INPROC;
+  } else {
+    THROW_SIMULATION_ERROR(
+      "Unexpected transport protocol ", std::quoted(protocol),
+      " given, it should be tcp, ipc or inproc.");
+  }
 }
 
 std::string enumToString(const HostName & hostname)
@@ -603,12 +603,74 @@ auto toProto(
   toProto(std::get<1>(message), *proto.mutable_gear_command());
 }
 
+auto toProto(
+  const traffic_simulator_msgs::msg::Vertex & message, traffic_simulator_msgs::Vertex & proto)
+  -> void
+{
+  proto.set_time(message.time);
+  toProto(message.position, *proto.mutable_position());
+}
+
+auto toMsg(
+  const traffic_simulator_msgs::Vertex & proto, traffic_simulator_msgs::msg::Vertex & message)
+  -> void
+{
+  message.time = proto.time();
+  toMsg(proto.position(), message.position);
+}
+
+auto toProto(
+  const traffic_simulator_msgs::msg::Polyline & message, traffic_simulator_msgs::Polyline & proto)
+  -> void
+{
+  /*
+     Cleared elements of a repeated field are kept by protobuf and handed back by add_vertices, so
+     converting into the same message every frame only allocates when the polyline grows.
+  */
+  proto.clear_vertices();
+  proto.mutable_vertices()->Reserve(static_cast<int>(message.vertices.size()));
+  for (const auto & vertex : message.vertices) {
+    toProto(vertex, *proto.add_vertices());
+  }
+}
+
+auto toMsg(
+  const traffic_simulator_msgs::Polyline & proto, traffic_simulator_msgs::msg::Polyline & message)
+  -> void
+{
+  message.vertices.resize(proto.vertices_size());
+  for (int i = 0; i < proto.vertices_size(); ++i) {
+    toMsg(proto.vertices(i), message.vertices[i]);
+  }
+}
+
+auto toProto(
+  const traffic_simulator_msgs::msg::PolylineTrajectory & message,
+  traffic_simulator_msgs::PolylineTrajectory & proto) -> void
+{
+  proto.set_initial_distance_offset(message.initial_distance_offset);
+  proto.set_dynamic_constraints_ignorable(message.dynamic_constraints_ignorable);
+  proto.set_base_time(message.base_time);
+  proto.set_closed(message.closed);
+  toProto(message.shape, *proto.mutable_shape());
+}
+
+auto toMsg(
+  const traffic_simulator_msgs::PolylineTrajectory & proto,
+  traffic_simulator_msgs::msg::PolylineTrajectory & message) -> void
+{
+  message.initial_distance_offset = proto.initial_distance_offset();
+  message.dynamic_constraints_ignorable = proto.dynamic_constraints_ignorable();
+  message.base_time = proto.base_time();
+  message.closed = proto.closed();
+  toMsg(proto.shape(), message.shape);
+}
+
 auto toProtobufMessage(const traffic_simulator_msgs::msg::Vertex & message)
   -> traffic_simulator_msgs::Vertex
 {
   auto proto = traffic_simulator_msgs::Vertex();
-  proto.set_time(message.time);
-  toProto(message.position, *proto.mutable_position());
+  toProto(message, proto);
   return proto;
 }
 
@@ -616,8 +678,7 @@ auto toROS2Message(const traffic_simulator_msgs::Vertex & proto)
   -> traffic_simulator_msgs::msg::Vertex
 {
   auto message = traffic_simulator_msgs::msg::Vertex();
-  message.time = proto.time();
-  toMsg(proto.position(), message.position);
+  toMsg(proto, message);
   return message;
 }
 
@@ -625,9 +686,7 @@ auto toProtobufMessage(const traffic_simulator_msgs::msg::Polyline & message)
   -> traffic_simulator_msgs::Polyline
 {
   auto proto = traffic_simulator_msgs::Polyline();
-  for (const auto & vertex : message.vertices) {
-    *proto.add_vertices() = toProtobufMessage(vertex);
-  }
+  toProto(message, proto);
   return proto;
 }
 
@@ -635,9 +694,7 @@ auto toROS2Message(const traffic_simulator_msgs::Polyline & proto)
   -> traffic_simulator_msgs::msg::Polyline
 {
   auto message = traffic_simulator_msgs::msg::Polyline();
-  for (const auto & vertex : proto.vertices()) {
-    message.vertices.push_back(toROS2Message(vertex));
-  }
+  toMsg(proto, message);
   return message;
 }
 
@@ -645,11 +702,7 @@ auto toProtobufMessage(const traffic_simulator_msgs::msg::PolylineTrajectory & m
   -> traffic_simulator_msgs::PolylineTrajectory
 {
   auto proto = traffic_simulator_msgs::PolylineTrajectory();
-  proto.set_initial_distance_offset(message.initial_distance_offset);
-  proto.set_dynamic_constraints_ignorable(message.dynamic_constraints_ignorable);
-  proto.set_base_time(message.base_time);
-  proto.set_closed(message.closed);
-  *proto.mutable_shape() = toProtobufMessage(message.shape);
+  toProto(message, proto);
   return proto;
 }
 
@@ -657,11 +710,7 @@ auto toROS2Message(const traffic_simulator_msgs::PolylineTrajectory & proto)
   -> traffic_simulator_msgs::msg::PolylineTrajectory
 {
   auto message = traffic_simulator_msgs::msg::PolylineTrajectory();
-  message.initial_distance_offset = proto.initial_distance_offset();
-  message.dynamic_constraints_ignorable = proto.dynamic_constraints_ignorable();
-  message.base_time = proto.base_time();
-  message.closed = proto.closed();
-  message.shape = toROS2Message(proto.shape());
+  toMsg(proto, message);
   return message;
 }
 }  // namespace simulation_interface
@@ -15,19 +15,29 @@
 #include <rclcpp/utilities.hpp>
 #include <simulation_interface/conversions.hpp>
 #include <simulation_interface/zmq_multi_client.hpp>
+#include <simulation_interface/zmq_multi_server.hpp>
+#include <status_monitor/trace.hpp>
 #include <string>
 namespace zeromq
 {
+using SimulationRequest = simulation_api_schema::SimulationRequest;
+using SimulationResponse = simulation_api_schema::SimulationResponse;
+
 MultiClient::MultiClient(
   const simulation_interface::TransportProtocol & protocol, const std::string & hostname,
   const unsigned int socket_port)
 : protocol(protocol),
   hostname(hostname),
+  socket_port(socket_port),
   context_(zmqpp::context()),
-  type_(zmqpp::socket_type::request),
-  socket_(context_, type_)
+  type_(zmqpp::socket_type::dealer),
+  socket_(context_, type_),
+  arena_block_(arena_block_size),
+  arena_(makeArenaOptions(arena_block_))
 {
-  socket_.connect(simulation_interface::getEndPoint(protocol, hostname, socket_port));
+  if (protocol != simulation_interface::TransportProtocol::INPROC) {
+    socket_.connect(simulation_interface::getEndPoint(protocol, hostname, socket_port));
+  }
 }
 
 void MultiClient::closeConnection()
@@ -43,179 +53,246 @@ MultiClient::~MultiClient() { closeConnection(); }
 auto MultiClient::call(const simulation_api_schema::SimulationRequest & req)
   -> simulation_api_schema::SimulationResponse
 {
-  zmqpp::message message = toZMQ(req);
+  arena_.Reset();
+  return exchange(req);
+}
+
+auto MultiClient::callAsync(const simulation_api_schema::SimulationRequest & req)
+  -> std::future<simulation_api_schema::SimulationResponse>
+{
+  if (is_running and protocol == simulation_interface::TransportProtocol::INPROC) {
+    std::promise<simulation_api_schema::SimulationResponse> response;
+    response.set_value(exchange(req));
+    return response.get_future();
+  } else if (is_running) {
+    ++call_count_;
+    const auto index = send(req);
+    return std::async(std::launch::deferred, [this, index]() { return receive(index); });
+  } else {
+    std::promise<simulation_api_schema::SimulationResponse> response;
+    response.set_value({});
+    return response.get_future();
+  }
+}
+
+auto MultiClient::callAsync(const simulation_api_schema::StepRequest & request)
+  -> std::future<simulation_api_schema::StepResponse>
+{
+  arena_.Reset();
+  auto & sim_request = *google::protobuf::Arena::CreateMessage<SimulationRequest>(&arena_);
+  sim_request.unsafe_arena_set_allocated_step(
+    const_cast<simulation_api_schema::StepRequest *>(&request));
+  auto sim_response = callAsync(sim_request);
+  sim_request.unsafe_arena_release_step();
+  return std::async(std::launch::deferred, [sim_response = std::move(sim_response)]() mutable {
+    return sim_response.get().step();
+  });
+}
+
+auto MultiClient::send(const simulation_api_schema::SimulationRequest & req) -> std::uint64_t
+{
+  common::ScopedTraceEvent event("rpc", "MultiClient::send");
+  req.SerializeToString(&serialized_);
+  zmqpp::message message;
+  message.add_raw(serialized_.data(), serialized_.size());
   socket_.send(message);
+  return sent_count_++;
+}
+
+auto MultiClient::receiveNext(simulation_api_schema::SimulationResponse & response) -> void
+{
   zmqpp::message buffer;
   socket_.receive(buffer);
-  return toProto<simulation_api_schema::SimulationResponse>(buffer);
+  response.ParseFromArray(buffer.raw_data(0), static_cast<int>(buffer.size(0)));
+  ++received_count_;
+}
+
+auto MultiClient::receive(const std::uint64_t index) -> simulation_api_schema::SimulationResponse
+{
+  common::ScopedTraceEvent event("rpc", "MultiClient::receive");
+  const auto start_time = std::chrono::steady_clock::now();
+  while (received_count_ <= index) {
+    receiveNext(received_[received_count_]);
+  }
+  call_duration_ += std::chrono::steady_clock::now() - start_time;
+  const auto iter = received_.find(index);
+  auto response = std::move(iter->second);
+  received_.erase(iter);
+  return response;
+}
+
+auto MultiClient::exchange(const simulation_api_schema::SimulationRequest & req)
+  -> const simulation_api_schema::SimulationResponse &
+{
+  common::ScopedTraceEvent event("rpc", "MultiClient::exchange");
+  ++call_count_;
+  const auto start_time = std::chrono::steady_clock::now();
+  if (protocol == simulation_interface::TransportProtocol::INPROC) {
+    auto & response =
+      *google::protobuf::Arena::CreateMessage<simulation_api_schema::SimulationResponse>(&arena_);
+    if (not MultiServer::callInProcess(socket_port, req, response)) {
+      THROW_SIMULATION_ERROR("No simulator of this process serves port ", socket_port, ".");
+    }
+    call_duration_ += std::chrono::steady_clock::now() - start_time;
+    return response;
+  }
+  while (received_count_ < sent_count_) {
+    receiveNext(received_[received_count_]);
+  }
+  send(req);
+  auto & response =
+    *google::protobuf::Arena::CreateMessage<simulation_api_schema::SimulationResponse>(&arena_);
+  receiveNext(response);
+  call_duration_ += std::chrono::steady_clock::now() - start_time;
+  return response;
 }
 
 auto MultiClient::call(const simulation_api_schema::InitializeRequest & request)
   -> simulation_api_schema::InitializeResponse
 {
-  if (is_running) {
-    simulation_api_schema::SimulationRequest sim_request;
-    *sim_request.mutable_initialize() = request;
-    return call(sim_request).initialize();
-  } else {
-    return {};
-  }
+  return call(
+    request, &SimulationRequest::unsafe_arena_set_allocated_initialize,
+    &SimulationRequest::unsafe_arena_release_initialize, &SimulationResponse::initialize);
 }
 
 auto MultiClient::call(const simulation_api_schema::UpdateFrameRequest & request)
   -> simulation_api_schema::UpdateFrameResponse
 {
-  if (is_running) {
-    simulation_api_schema::SimulationRequest sim_request;
-    *sim_request.mutable_update_frame() = request;
-    return call(sim_request).update_frame();
-  } else {
-    return {};
-  }
+  return call(
+    request, &SimulationRequest::unsafe_arena_set_allocated_update_frame,
+    &SimulationRequest::unsafe_arena_release_update_frame, &SimulationResponse::update_frame);
 }
 
 auto MultiClient::call(const simulation_api_schema::UpdateStepTimeRequest & request)
   -> simulation_api_schema::UpdateStepTimeResponse
 {
-  if (is_running) {
-    simulation_api_schema::SimulationRequest sim_request;
-    *sim_request.mutable_update_step_time() = request;
-    return call(sim_request).update_step_time();
-  } else {
-    return {};
-  }
+  return call(
+    request, &SimulationRequest::unsafe_arena_set_allocated_update_step_time,
+    &SimulationRequest::unsafe_arena_release_update_step_time,
+    &SimulationResponse::update_step_time);
 }
 
 auto MultiClient::call(const simulation_api_schema::SpawnVehicleEntityRequest & request)
   -> simulation_api_schema::SpawnVehicleEntityResponse
 {
-  if (is_running) {
-    simulation_api_schema::SimulationRequest sim_request;
-    *sim_request.mutable_spawn_vehicle_entity() = request;
-    return call(sim_request).spawn_vehicle_entity();
-  } else {
-    return {};
-  }
+  return call(
+    request, &SimulationRequest::unsafe_arena_set_allocated_spawn_vehicle_entity,
+    &SimulationRequest::unsafe_arena_release_spawn_vehicle_entity,
+    &SimulationResponse::spawn_vehicle_entity);
 }
 
 auto MultiClient::call(const simulation_api_schema::SpawnPedestrianEntityRequest & request)
   -> simulation_api_schema::SpawnPedestrianEntityResponse
 {
-  if (is_running) {
-    simulation_api_schema::SimulationRequest sim_request;
-    *sim_request.mutable_spawn_pedestrian_entity() = request;
-    return call(sim_request).spawn_pedestrian_entity();
-  } else {
-    return {};
-  }
+  return call(
+    request, &SimulationRequest::unsafe_arena_set_allocated_spawn_pedestrian_entity,
+    &SimulationRequest::unsafe_arena_release_spawn_pedestrian_entity,
+    &SimulationResponse::spawn_pedestrian_entity);
 }
 
 auto MultiClient::call(const simulation_api_schema::SpawnMiscObjectEntityRequest & request)
   -> simulation_api_schema::SpawnMiscObjectEntityResponse
 {
-  if (is_running) {
-    simulation_api_schema::SimulationRequest sim_request;
-    *sim_request.mutable_spawn_misc_object_entity() = request;
-    return call(sim_request).spawn_misc_object_entity();
-  } else {
-    return {};
-  }
+  return call(
+    request, &SimulationRequest::unsafe_arena_set_allocated_spawn_misc_object_entity,
+    &SimulationRequest::unsafe_arena_release_spawn_misc_object_entity,
+    &SimulationResponse::spawn_misc_object_entity);
 }
 
 auto MultiClient::call(const simulation_api_schema::DespawnEntityRequest & request)
   -> simulation_api_schema::DespawnEntityResponse
 {
-  if (is_running) {
-    simulation_api_schema::SimulationRequest sim_request;
-    *sim_request.mutable_despawn_entity() = request;
-    return call(sim_request).despawn_entity();
-  } else {
-    return {};
-  }
+  return call(
+    request, &SimulationRequest::unsafe_arena_set_allocated_despawn_entity,
+    &SimulationRequest::unsafe_arena_release_despawn_entity, &SimulationResponse::despawn_entity);
 }
 
 auto MultiClient::call(const simulation_api_schema::UpdateEntityStatusRequest & request)
   -> simulation_api_schema::UpdateEntityStatusResponse
 {
-  if (is_running) {
-    simulation_api_schema::SimulationRequest sim_request;
-    *sim_request.mutable_update_entity_status() = request;
-    return call(sim_request).update_entity_status();
-  } else {
-    return {};
-  }
+  return call(
+    request, &SimulationRequest::unsafe_arena_set_allocated_update_entity_status,
+    &SimulationRequest::unsafe_arena_release_update_entity_status,
+    &SimulationResponse::update_entity_status);
 }
 
 auto MultiClient::call(const simulation_api_schema::AttachImuSensorRequest & request)
   -> simulation_api_schema::AttachImuSensorResponse
 {
-  if (is_running) {
-    auto simulation_request = simulation_api_schema::SimulationRequest();
-    *simulation_request.mutable_attach_imu_sensor() = request;
-    return call(simulation_request).attach_imu_sensor();
-  } else {
-    return {};
-  }
+  return call(
+    request, &SimulationRequest::unsafe_arena_set_allocated_attach_imu_sensor,
+    &SimulationRequest::unsafe_arena_release_attach_imu_sensor,
+    &SimulationResponse::attach_imu_sensor);
 }
 
 auto MultiClient::call(const simulation_api_schema::AttachLidarSensorRequest & request)
   -> simulation_api_schema::AttachLidarSensorResponse
 {
-  if (is_running) {
-    simulation_api_schema::SimulationRequest sim_request;
-    *sim_request.mutable_attach_lidar_sensor() = request;
-    return call(sim_request).attach_lidar_sensor();
-  } else {
-    return {};
-  }
+  return call(
+    request, &SimulationRequest::unsafe_arena_set_allocated_attach_lidar_sensor,
+    &SimulationRequest::unsafe_arena_release_attach_lidar_sensor,
+    &SimulationResponse::attach_lidar_sensor);
 }
 
 auto MultiClient::call(const simulation_api_schema::AttachDetectionSensorRequest & request)
   -> simulation_api_schema::AttachDetectionSensorResponse
 {
-  if (is_running) {
-    simulation_api_schema::SimulationRequest sim_request;
-    *sim_request.mutable_attach_detection_sensor() = request;
-    return call(sim_request).attach_detection_sensor();
-  } else {
-    return {};
-  }
+  return call(
+    request, &SimulationRequest::unsafe_arena_set_allocated_attach_detection_sensor,
+    &SimulationRequest::unsafe_arena_release_attach_detection_sensor,
+    &SimulationResponse::attach_detection_sensor);
 }
 
 auto MultiClient::call(const simulation_api_schema::AttachOccupancyGridSensorRequest & request)
   -> simulation_api_schema::AttachOccupancyGridSensorResponse
 {
-  if (is_running) {
-    simulation_api_schema::SimulationRequest sim_request;
-    *sim_request.mutable_attach_occupancy_grid_sensor() = request;
-    return call(sim_request).attach_occupancy_grid_sensor();
-  } else {
-    return {};
-  }
+  return call(
+    request, &SimulationRequest::unsafe_arena_set_allocated_attach_occupancy_grid_sensor,
+    &SimulationRequest::unsafe_arena_release_attach_occupancy_grid_sensor,
+    &SimulationResponse::attach_occupancy_grid_sensor);
 }
 
 auto MultiClient::call(const simulation_api_schema::UpdateTrafficLightsRequest & request)
   -> simulation_api_schema::UpdateTrafficLightsResponse
 {
-  if (is_running) {
-    simulation_api_schema::SimulationRequest sim_request;
-    *sim_request.mutable_update_traffic_lights() = request;
-    return call(sim_request).update_traffic_lights();
-  } else {
-    return {};
-  }
+  return call(
+    request, &SimulationRequest::unsafe_arena_set_allocated_update_traffic_lights,
+    &SimulationRequest::unsafe_arena_release_update_traffic_lights,
+    &SimulationResponse::update_traffic_lights);
 }
 
 auto MultiClient::call(
   const simulation_api_schema::AttachPseudoTrafficLightDetectorRequest & request)
   -> simulation_api_schema::AttachPseudoTrafficLightDetectorResponse
 {
-  if (is_running) {
-    auto simulation_request = simulation_api_schema::SimulationRequest();
-    *simulation_request.mutable_attach_pseudo_traffic_light_detector() = request;
-    return call(simulation_request).attach_pseudo_traffic_light_detector();
-  } else {
-    return {};
-  }
+  return call(
+    request, &SimulationRequest::unsafe_arena_set_allocated_attach_pseudo_traffic_light_detector,
+    &SimulationRequest::unsafe_arena_release_attach_pseudo_traffic_light_detector,
+    &SimulationResponse::attach_pseudo_traffic_light_detector);
+}
+
+auto MultiClient::call(const simulation_api_schema::StepRequest & request)
+  -> simulation_api_schema::StepResponse
+{
+  return call(
+    request, &SimulationRequest::unsafe_arena_set_allocated_step,
+    &SimulationRequest::unsafe_arena_release_step, &SimulationResponse::step);
+}
+
+auto MultiClient::call(const simulation_api_schema::SpawnEntitiesRequest & request)
+  -> simulation_api_schema::SpawnEntitiesResponse
+{
+  return call(
+    request, &SimulationRequest::unsafe_arena_set_allocated_spawn_entities,
+    &SimulationRequest::unsafe_arena_release_spawn_entities, &SimulationResponse::spawn_entities);
+}
+
+auto MultiClient::call(const simulation_api_schema::DespawnEntitiesRequest & request)
+  -> simulation_api_schema::DespawnEntitiesResponse
+{
+  return call(
+    request, &SimulationRequest::unsafe_arena_set_allocated_despawn_entities,
+    &SimulationRequest::unsafe_arena_release_despawn_entities,
+    &SimulationResponse::despawn_entities);
 }
 }  // namespace zeromq
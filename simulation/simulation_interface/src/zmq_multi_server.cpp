@@ -12,94 +12,180 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <mutex>
 #include <simulation_interface/conversions.hpp>
 #include <simulation_interface/zmq_multi_server.hpp>
 #include <status_monitor/status_monitor.hpp>
+#include <status_monitor/trace.hpp>
+#include <string>
+#include <unordered_map>
 
 namespace zeromq
 {
-MultiServer::~MultiServer() { thread_.join(); }
+namespace
+{
+/// @note Also held while a server handles a request in process, so it is not destroyed meanwhile.
+std::mutex in_process_mutex;
+
+std::unordered_map<unsigned int, MultiServer *> in_process_servers;
+}  // namespace
+
+MultiServer::~MultiServer()
+{
+  if (in_process_port_) {
+    std::lock_guard<std::mutex> lock(in_process_mutex);
+    in_process_servers.erase(*in_process_port_);
+  }
+  shutdown_sender_.send(std::string());
+  thread_.join();
+}
 
-void MultiServer::poll()
+auto MultiServer::poll() -> bool
 {
-  constexpr long timeout_ms = 1L;
+  /**
+   * @note Hard coded parameter, the longest time the poller blocks without any request, so that
+   * the thread keeps touching the status monitor and notices the shutdown of rclcpp.
+   */
+  constexpr long timeout_ms = 100L;
   poller_.poll(timeout_ms);
+  if (poller_.has_input(shutdown_receiver_)) {
+    return false;
+  }
   if (poller_.has_input(socket_)) {
-    simulation_api_schema::SimulationResponse sim_response;
     zmqpp::message sim_request;
     socket_.receive(sim_request);
-    auto proto = toProto<simulation_api_schema::SimulationRequest>(sim_request);
-    switch (proto.request_case()) {
-      case simulation_api_schema::SimulationRequest::RequestCase::kInitialize:
-        *sim_response.mutable_initialize() = std::get<Initialize>(functions_)(proto.initialize());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kUpdateFrame:
-        *sim_response.mutable_update_frame() =
-          std::get<UpdateFrame>(functions_)(proto.update_frame());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kSpawnVehicleEntity:
-        *sim_response.mutable_spawn_vehicle_entity() =
-          std::get<SpawnVehicleEntity>(functions_)(proto.spawn_vehicle_entity());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kSpawnPedestrianEntity:
-        *sim_response.mutable_spawn_pedestrian_entity() =
-          std::get<SpawnPedestrianEntity>(functions_)(proto.spawn_pedestrian_entity());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kSpawnMiscObjectEntity:
-        *sim_response.mutable_spawn_misc_object_entity() =
-          std::get<SpawnMiscObjectEntity>(functions_)(proto.spawn_misc_object_entity());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kDespawnEntity:
-        *sim_response.mutable_despawn_entity() =
-          std::get<DespawnEntity>(functions_)(proto.despawn_entity());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kUpdateEntityStatus:
-        *sim_response.mutable_update_entity_status() =
-          std::get<UpdateEntityStatus>(functions_)(proto.update_entity_status());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kAttachImuSensor:
-        *sim_response.mutable_attach_imu_sensor() =
-          std::get<AttachImuSensor>(functions_)(proto.attach_imu_sensor());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kAttachLidarSensor:
-        *sim_response.mutable_attach_lidar_sensor() =
-          std::get<AttachLidarSensor>(functions_)(proto.attach_lidar_sensor());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kAttachDetectionSensor:
-        *sim_response.mutable_attach_detection_sensor() =
-          std::get<AttachDetectionSensor>(functions_)(proto.attach_detection_sensor());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kAttachOccupancyGridSensor:
-        *sim_response.mutable_attach_occupancy_grid_sensor() =
-          std::get<AttachOccupancyGridSensor>(functions_)(proto.attach_occupancy_grid_sensor());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kUpdateTrafficLights:
-        *sim_response.mutable_update_traffic_lights() =
-          std::get<UpdateTrafficLights>(functions_)(proto.update_traffic_lights());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kAttachPseudoTrafficLightDetector:
-        *sim_response.mutable_attach_pseudo_traffic_light_detector() =
-          std::get<AttachPseudoTrafficLightDetector>(functions_)(
-            proto.attach_pseudo_traffic_light_detector());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kUpdateStepTime:
-        *sim_response.mutable_update_step_time() =
-          std::get<UpdateStepTime>(functions_)(proto.update_step_time());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::REQUEST_NOT_SET: {
-        THROW_SIMULATION_ERROR("No case defined for oneof in SimulationRequest message");
-      }
+    arena_.Reset();
+    auto & proto =
+      *google::protobuf::Arena::CreateMessage<simulation_api_schema::SimulationRequest>(&arena_);
+    /// @note The frames before the request are the envelope identifying the client.
+    const auto request_part = sim_request.parts() - 1;
+    proto.ParseFromArray(
+      sim_request.raw_data(request_part), static_cast<int>(sim_request.size(request_part)));
+    auto & sim_response =
+      *google::protobuf::Arena::CreateMessage<simulation_api_schema::SimulationResponse>(&arena_);
+    handle(proto, sim_response);
+    sim_response.SerializeToString(&serialized_);
+    zmqpp::message msg;
+    for (std::size_t part = 0; part < request_part; ++part) {
+      msg.add_raw(sim_request.raw_data(part), sim_request.size(part));
     }
-    auto msg = toZMQ(sim_response);
+    msg.add_raw(serialized_.data(), serialized_.size());
     socket_.send(msg);
   }
+  return true;
+}
+
+auto MultiServer::handle(
+  const simulation_api_schema::SimulationRequest & request,
+  simulation_api_schema::SimulationResponse & response) -> void
+{
+  /// @note Named by the field of the request, such as "MultiServer::step".
+  const auto field = common::Trace::enabled()
+                       ? request.descriptor()->FindFieldByNumber(request.request_case())
+                       : nullptr;
+  common::ScopedTraceEvent event("rpc", field ? "MultiServer::" + field->name() : std::string());
+  switch (request.request_case()) {
+#define CASE_OF_FUNCTION_TYPE(TYPENAME, FIELD)                                    \
+  case simulation_api_schema::SimulationRequest::RequestCase::k##TYPENAME:        \
+    std::get<TYPENAME>(functions_)(request.FIELD(), *response.mutable_##FIELD()); \
+    break;
+
+    SIMULATION_INTERFACE_MULTI_SERVER_RPCS(CASE_OF_FUNCTION_TYPE)
+
+#undef CASE_OF_FUNCTION_TYPE
+
+    case simulation_api_schema::SimulationRequest::RequestCase::kStep:
+      step(request.step(), *response.mutable_step());
+      break;
+    case simulation_api_schema::SimulationRequest::RequestCase::REQUEST_NOT_SET: {
+      THROW_SIMULATION_ERROR("No case defined for oneof in SimulationRequest message");
+    }
+  }
+}
+
+auto MultiServer::step(
+  const simulation_api_schema::StepRequest & request,
+  simulation_api_schema::StepResponse & response) -> void
+{
+  if (request.has_update_step_time()) {
+    std::get<UpdateStepTime>(functions_)(
+      request.update_step_time(), *response.mutable_update_step_time());
+    if (not response.update_step_time().result().success()) {
+      *response.mutable_result() = response.update_step_time().result();
+      return;
+    }
+  }
+  if (request.has_update_traffic_lights()) {
+    std::get<UpdateTrafficLights>(functions_)(
+      request.update_traffic_lights(), *response.mutable_update_traffic_lights());
+    if (not response.update_traffic_lights().result().success()) {
+      *response.mutable_result() = response.update_traffic_lights().result();
+      return;
+    }
+  }
+  if (request.has_update_frame()) {
+    std::get<UpdateFrame>(functions_)(request.update_frame(), *response.mutable_update_frame());
+    if (not response.update_frame().result().success()) {
+      *response.mutable_result() = response.update_frame().result();
+      return;
+    }
+  }
+  if (request.has_despawn_entities()) {
+    std::get<DespawnEntities>(functions_)(
+      request.despawn_entities(), *response.mutable_despawn_entities());
+    if (not response.despawn_entities().result().success()) {
+      *response.mutable_result() = response.despawn_entities().result();
+      return;
+    }
+  }
+  if (request.has_spawn_entities()) {
+    std::get<SpawnEntities>(functions_)(
+      request.spawn_entities(), *response.mutable_spawn_entities());
+    if (not response.spawn_entities().result().success()) {
+      *response.mutable_result() = response.spawn_entities().result();
+      return;
+    }
+  }
+  if (request.has_update_entity_status()) {
+    std::get<UpdateEntityStatus>(functions_)(
+      request.update_entity_status(), *response.mutable_update_entity_status());
+    if (not response.update_entity_status().result().success()) {
+      *response.mutable_result() = response.update_entity_status().result();
+      return;
+    }
+  }
+  response.mutable_result()->set_success(true);
+}
+
+auto MultiServer::registerInProcess(const unsigned int socket_port) -> void
+{
+  std::lock_guard<std::mutex> lock(in_process_mutex);
+  if (not in_process_servers.emplace(socket_port, this).second) {
+    THROW_SIMULATION_ERROR("Port ", socket_port, " is already served in this process.");
+  }
+  in_process_port_ = socket_port;
+}
+
+auto MultiServer::callInProcess(
+  const unsigned int socket_port, const simulation_api_schema::SimulationRequest & request,
+  simulation_api_schema::SimulationResponse & response) -> bool
+{
+  std::lock_guard<std::mutex> lock(in_process_mutex);
+  if (const auto iter = in_process_servers.find(socket_port); iter != in_process_servers.end()) {
+    iter->second->handle(request, response);
+    return true;
+  } else {
+    return false;
+  }
 }
 
 void MultiServer::start_poll()
 {
   while (rclcpp::ok()) {
     common::status_monitor.touch(__func__);
-    poll();
+    if (not poll()) {
+      break;
+    }
   }
 }
 }  // namespace zeromq
@@ -0,0 +1,152 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <simulation_interface/conversions.hpp>
+#include <string>
+#include <vector>
+
+namespace
+{
+std::atomic<std::size_t> allocation_count{0};
+
+/// @brief Report the allocations per iteration of the benchmark since its construction.
+class AllocationCounter
+{
+public:
+  explicit AllocationCounter(benchmark::State & state)
+  : state_(state), initial_count_(allocation_count.load())
+  {
+  }
+
+  ~AllocationCounter()
+  {
+    state_.counters["allocations"] = benchmark::Counter(
+      static_cast<double>(allocation_count.load() - initial_count_),
+      benchmark::Counter::kAvgIterations);
+  }
+
+private:
+  benchmark::State & state_;
+  const std::size_t initial_count_;
+};
+
+auto makeEntityStatuses(const std::int64_t size)
+  -> std::vector<traffic_simulator_msgs::msg::EntityStatus>
+{
+  std::vector<traffic_simulator_msgs::msg::EntityStatus> statuses(size);
+  for (std::int64_t i = 0; i < size; ++i) {
+    statuses[i].name = "entity_" + std::to_string(i);
+    statuses[i].time = 0.1 * i;
+    statuses[i].pose.position.x = 1.0 * i;
+    statuses[i].action_status.twist.linear.x = 10.0;
+    statuses[i].lanelet_pose_valid = true;
+  }
+  return statuses;
+}
+
+auto makePolylineTrajectory(const std::int64_t size)
+  -> traffic_simulator_msgs::msg::PolylineTrajectory
+{
+  traffic_simulator_msgs::msg::PolylineTrajectory trajectory;
+  trajectory.shape.vertices.resize(size);
+  for (std::int64_t i = 0; i < size; ++i) {
+    trajectory.shape.vertices[i].time = 0.1 * i;
+    trajectory.shape.vertices[i].position.position.x = 1.0 * i;
+  }
+  return trajectory;
+}
+}  // namespace
+
+/// @note Count the allocations of the whole process, the conversions allocate through these.
+void * operator new(std::size_t size)
+{
+  ++allocation_count;
+  if (void * pointer = std::malloc(size == 0 ? 1 : size)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void * pointer) noexcept { std::free(pointer); }
+
+void operator delete(void * pointer, std::size_t) noexcept { std::free(pointer); }
+
+/// @note The argument is the number of entities, converted into the same request every iteration.
+static void EntityStatusToProto(benchmark::State & state)
+{
+  const auto statuses = makeEntityStatuses(state.range(0));
+  simulation_api_schema::UpdateEntityStatusRequest request;
+  const auto allocation_counter = AllocationCounter(state);
+  for (auto _ : state) {
+    request.clear_status();
+    for (const auto & status : statuses) {
+      simulation_interface::toProto(status, *request.add_status());
+    }
+    benchmark::DoNotOptimize(request);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(EntityStatusToProto)->Arg(10)->Arg(100)->Arg(1000);
+
+static void EntityStatusToMsg(benchmark::State & state)
+{
+  const auto statuses = makeEntityStatuses(state.range(0));
+  simulation_api_schema::UpdateEntityStatusRequest request;
+  for (const auto & status : statuses) {
+    simulation_interface::toProto(status, *request.add_status());
+  }
+  auto converted = statuses;
+  const auto allocation_counter = AllocationCounter(state);
+  for (auto _ : state) {
+    for (int i = 0; i < request.status_size(); ++i) {
+      simulation_interface::toMsg(request.status(i), converted[i]);
+    }
+    benchmark::DoNotOptimize(converted);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(EntityStatusToMsg)->Arg(10)->Arg(100)->Arg(1000);
+
+/// @note The argument is the number of vertices of the trajectory.
+static void PolylineTrajectoryToProto(benchmark::State & state)
+{
+  const auto trajectory = makePolylineTrajectory(state.range(0));
+  traffic_simulator_msgs::PolylineTrajectory proto;
+  const auto allocation_counter = AllocationCounter(state);
+  for (auto _ : state) {
+    simulation_interface::toProto(trajectory, proto);
+    benchmark::DoNotOptimize(proto);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(PolylineTrajectoryToProto)->Arg(10)->Arg(100)->Arg(1000);
+
+static void PolylineTrajectoryToMsg(benchmark::State & state)
+{
+  traffic_simulator_msgs::PolylineTrajectory proto;
+  simulation_interface::toProto(makePolylineTrajectory(state.range(0)), proto);
+  traffic_simulator_msgs::msg::PolylineTrajectory trajectory;
+  const auto allocation_counter = AllocationCounter(state);
+  for (auto _ : state) {
+    simulation_interface::toMsg(proto, trajectory);
+    benchmark::DoNotOptimize(trajectory);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(PolylineTrajectoryToMsg)->Arg(10)->Arg(100)->Arg(1000);
@@ -527,6 +527,35 @@ TEST(Conversion, LaneletPose)
   EXPECT_LANELET_POSE_EQ(pose, proto);
 }
 
+/**
+ * @note Test converting into messages already holding vertices - the goal is to test that the
+ * vertices of the destination are overwritten or dropped to match the source.
+ */
+TEST(Conversion, PolylineInPlace)
+{
+  traffic_simulator_msgs::msg::Polyline polyline;
+  polyline.vertices.resize(3);
+  for (std::size_t i = 0; i < polyline.vertices.size(); ++i) {
+    polyline.vertices[i].time = 1.0 * i;
+    polyline.vertices[i].position.position.x = 2.0 * i;
+  }
+  traffic_simulator_msgs::Polyline proto;
+  proto.add_vertices()->set_time(-1.0);
+  simulation_interface::toProto(polyline, proto);
+  ASSERT_EQ(proto.vertices_size(), 3);
+  for (int i = 0; i < proto.vertices_size(); ++i) {
+    EXPECT_DOUBLE_EQ(proto.vertices(i).time(), polyline.vertices[i].time);
+    EXPECT_POSE_EQ(polyline.vertices[i].position, proto.vertices(i).position());
+  }
+  polyline.vertices.resize(5);
+  simulation_interface::toMsg(proto, polyline);
+  ASSERT_EQ(polyline.vertices.size(), 3u);
+  for (int i = 0; i < proto.vertices_size(); ++i) {
+    EXPECT_DOUBLE_EQ(proto.vertices(i).time(), polyline.vertices[i].time);
+    EXPECT_POSE_EQ(polyline.vertices[i].position, proto.vertices(i).position());
+  }
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
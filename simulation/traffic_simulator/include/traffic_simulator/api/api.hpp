@@ -21,6 +21,10 @@
 #include <autoware_auto_vehicle_msgs/msg/vehicle_state_command.hpp>
 #include <boost/variant.hpp>
 #include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
+#include <future>
 #include <memory>
 #include <optional>
 #include <rclcpp/rclcpp.hpp>
@@ -42,6 +46,7 @@
 #include <traffic_simulator/traffic/traffic_controller.hpp>
 #include <traffic_simulator/traffic_lights/traffic_light.hpp>
 #include <traffic_simulator_msgs/msg/behavior_parameter.hpp>
+#include <unordered_map>
 #include <utility>
 
 namespace traffic_simulator
@@ -70,7 +75,13 @@ public:
     entity_manager_ptr_(
       std::make_shared<entity::EntityManager>(node, configuration, node_parameters_)),
     traffic_controller_ptr_(std::make_shared<traffic::TrafficController>(
-      entity_manager_ptr_->getHdmapUtils(), [this]() { return API::getEntityNames(); },
+      entity_manager_ptr_->getHdmapUtils(),
+      [this](const auto & point, const auto radius) {
+        return entity_manager_ptr_->getEntitiesNear(point, radius);
+      },
+      [this](const auto & lanelet_ids) {
+        return entity_manager_ptr_->getEntitiesOnLanelets(lanelet_ids);
+      },
       [this](const auto & entity_name) {
         if (const auto entity = getEntity(entity_name)) {
           return entity->getMapPose();
@@ -84,6 +95,9 @@ public:
       rclcpp::PublisherOptionsWithAllocator<AllocatorT>())),
     debug_marker_pub_(rclcpp::create_publisher<visualization_msgs::msg::MarkerArray>(
       node, "debug_marker", rclcpp::QoS(100), rclcpp::PublisherOptionsWithAllocator<AllocatorT>())),
+    diagnostics_pub_(rclcpp::create_publisher<diagnostic_msgs::msg::DiagnosticArray>(
+      node, "/simulation/diagnostics", rclcpp::QoS(1),
+      rclcpp::PublisherOptionsWithAllocator<AllocatorT>())),
     real_time_factor_subscriber(rclcpp::create_subscription<std_msgs::msg::Float64>(
       node, "/real_time_factor", rclcpp::QoS(rclcpp::KeepLast(1)).best_effort(),
       [this](const std_msgs::msg::Float64 & message) {
@@ -92,18 +106,21 @@ public:
          * For that reason, before performing the action, it needs to be ensured that the incoming request data is a positive number.
          */
         if (message.data >= 0.001) {
+          /// @note The new step time is sent to the simulator along with the next step.
           clock_.realtime_factor = message.data;
-          simulation_api_schema::UpdateStepTimeRequest request;
-          request.set_simulation_step_time(clock_.getStepTime());
-          zeromq_client_.call(request);
         }
       })),
     clock_(node->get_parameter("use_sim_time").as_bool(), std::forward<decltype(xs)>(xs)...),
     zeromq_client_(
-      simulation_interface::protocol, configuration.simulator_host, getZMQSocketPort(*node))
+      getZMQTransportProtocol(*node), configuration.simulator_host, getZMQSocketPort(*node))
   {
     setVerbose(configuration.verbose);
 
+    clock_.maximum_step_scale =
+      std::max(1.0, getROS2Parameter<double>("real_time_factor_governor_maximum_step_scale", 1.0));
+
+    step_time_in_sim_ = clock_.getStepTime();
+
     if (not configuration.standalone_mode) {
       simulation_api_schema::InitializeRequest request;
       request.set_initialize_time(clock_.getCurrentSimulationTime());
@@ -131,8 +148,22 @@ public:
     return node.get_parameter("port").as_int();
   }
 
+  template <typename Node>
+  auto getZMQTransportProtocol(Node & node) -> simulation_interface::TransportProtocol
+  {
+    if (!node.has_parameter("transport_protocol")) {
+      node.declare_parameter<std::string>("transport_protocol", "tcp");
+    }
+    return simulation_interface::stringToTransportProtocol(
+      node.get_parameter("transport_protocol").as_string());
+  }
+
   void closeZMQConnection() { zeromq_client_.closeConnection(); }
 
+  auto getZMQCallCount() const -> std::uint64_t { return zeromq_client_.getCallCount(); }
+
+  auto getZMQCallDuration() const { return zeromq_client_.getCallDuration(); }
+
   void setVerbose(const bool verbose);
 
   template <typename Pose>
@@ -168,7 +199,12 @@ public:
         req.set_is_ego(behavior == VehicleBehavior::autoware());
         /// @todo Should be filled from function API
         req.set_initial_speed(0.0);
-        return zeromq_client_.call(req).result().success();
+        if (req.is_ego()) {
+          return zeromq_client_.call(req).result().success();
+        } else {
+          *step_request_.mutable_spawn_entities()->add_vehicles() = std::move(req);
+          return true;
+        }
       }
     };
 
@@ -194,12 +230,12 @@ public:
         throw common::SemanticError(
           "Entity ", name, " can not be registered in simulator - it has not been spawned yet.");
       } else {
-        simulation_api_schema::SpawnPedestrianEntityRequest req;
+        auto & req = *step_request_.mutable_spawn_entities()->add_pedestrians();
         simulation_interface::toProto(parameters, *req.mutable_parameters());
         req.mutable_parameters()->set_name(name);
         req.set_asset_key(model3d);
         simulation_interface::toProto(entity->getMapPose(), *req.mutable_pose());
-        return zeromq_client_.call(req).result().success();
+        return true;
       }
     };
 
@@ -224,12 +260,12 @@ public:
         throw common::SemanticError(
           "Entity ", name, " can not be registered in simulator - it has not been spawned yet.");
       } else {
-        simulation_api_schema::SpawnMiscObjectEntityRequest req;
+        auto & req = *step_request_.mutable_spawn_entities()->add_misc_objects();
         simulation_interface::toProto(parameters, *req.mutable_parameters());
         req.mutable_parameters()->set_name(name);
         req.set_asset_key(model3d);
         simulation_interface::toProto(entity->getMapPose(), *req.mutable_pose());
-        return zeromq_client_.call(req).result().success();
+        return true;
       }
     };
 
@@ -337,6 +373,8 @@ public:
 
   auto getEntity(const std::string & name) const -> std::shared_ptr<entity::EntityBase>;
 
+  auto getEntity(const entity::EntityHandle & handle) const -> std::shared_ptr<entity::EntityBase>;
+
   // clang-format off
 #define FORWARD_TO_ENTITY_MANAGER(NAME)                                    \
   /*!                                                                      \
@@ -366,7 +404,9 @@ public:
   FORWARD_TO_ENTITY_MANAGER(getCurrentAction);
   FORWARD_TO_ENTITY_MANAGER(getCurrentTwist);
   FORWARD_TO_ENTITY_MANAGER(getEgoName);
+  FORWARD_TO_ENTITY_MANAGER(getEntityHandle);
   FORWARD_TO_ENTITY_MANAGER(getEntityNames);
+  FORWARD_TO_ENTITY_MANAGER(getEntityNamesCollidingWith);
   FORWARD_TO_ENTITY_MANAGER(getEntityStatus);
   FORWARD_TO_ENTITY_MANAGER(getCanonicalizedStatusBeforeUpdate);
   FORWARD_TO_ENTITY_MANAGER(getHdmapUtils);
@@ -409,12 +449,42 @@ public:
 #undef FORWARD_TO_ENTITY_MANAGER
 
 private:
+  /// @note Set the time of the frame stepped into the next step request.
   bool updateTimeInSim();
 
-  bool updateEntitiesStatusInSim();
+  /// @note Send the step request with the entity status of the frame starting, without waiting.
+  auto updateEntitiesStatusInSim() -> std::future<simulation_api_schema::StepResponse>;
 
+  /// @note Apply the entity status stepped by the simulator.
+  bool updateEntitiesStatusFromSim(const simulation_api_schema::StepResponse &);
+
+  /// @note Set the traffic lights into the next step request, if they have changed.
   bool updateTrafficLightsInSim();
 
+  /**
+   * @note The entities other than the ego are spawned and despawned in the simulator along with the
+   * next step, so spawning many entities in a frame takes no more round trips. The ego is spawned
+   * and despawned immediately, since its sensors and its simulation are set up right after.
+   */
+  simulation_api_schema::StepRequest step_request_;
+
+  /// @return false if the entity was not waiting for the next step to be spawned in the simulator.
+  auto cancelSpawnInSim(const std::string & name) -> bool;
+
+  /// @note Kinematics of an entity as last sent to the simulator, with the handle given to it.
+  struct SentKinematics
+  {
+    std::uint32_t handle;
+    geometry_msgs::msg::Pose pose;
+    geometry_msgs::msg::Twist twist;
+    geometry_msgs::msg::Accel accel;
+  };
+
+  /// @note Entities whose full status has been sent in the session, so only their moves are sent.
+  std::unordered_map<std::string, SentKinematics> sent_kinematics_;
+
+  std::uint32_t next_entity_handle_ = 0;
+
   const Configuration configuration;
 
   const rclcpp::node_interfaces::NodeParametersInterface::SharedPtr node_parameters_;
@@ -427,10 +497,20 @@ private:
 
   const rclcpp::Publisher<visualization_msgs::msg::MarkerArray>::SharedPtr debug_marker_pub_;
 
+  /// @note Achieved real time factor of the simulation, published once per second.
+  const rclcpp::Publisher<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr diagnostics_pub_;
+
+  std::chrono::steady_clock::time_point diagnostics_published_time_;
+
+  auto publishDiagnostics() -> void;
+
   const rclcpp::Subscription<std_msgs::msg::Float64>::SharedPtr real_time_factor_subscriber;
 
   SimulationClock clock_;
 
+  /// @note Step time of the simulator, which changes with the real time factor and its governor.
+  double step_time_in_sim_;
+
   zeromq::MultiClient zeromq_client_;
 };
 }  // namespace traffic_simulator
@@ -20,6 +20,7 @@
 #include <traffic_simulator/behavior/follow_trajectory.hpp>
 #include <traffic_simulator/data_type/behavior.hpp>
 #include <traffic_simulator/data_type/entity_status.hpp>
+#include <traffic_simulator/data_type/other_entity_status.hpp>
 #include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
 #include <traffic_simulator/traffic_lights/traffic_light_manager.hpp>
 #include <traffic_simulator_msgs/msg/behavior_parameter.hpp>
@@ -29,12 +30,12 @@
 #include <traffic_simulator_msgs/msg/vehicle_parameters.hpp>
 #include <traffic_simulator_msgs/msg/waypoints_array.hpp>
 #include <unordered_map>
+#include <vector>
 #include <visualization_msgs/msg/marker_array.hpp>
 
 namespace entity_behavior
 {
-using EntityStatusDict =
-  std::unordered_map<std::string, traffic_simulator::CanonicalizedEntityStatus>;
+using EntityStatusDict = traffic_simulator::OtherEntityStatus;
 
 class BehaviorPluginBase
 {
@@ -42,8 +43,31 @@ public:
   virtual ~BehaviorPluginBase() = default;
   virtual void configure(const rclcpp::Logger & logger) = 0;
   virtual auto update(const double current_time, const double step_time) -> void = 0;
+
+  /**
+   * @brief Update several entities of the same plugin type and step time in one call.
+   * @param plugins Plugins of those entities, this plugin is one of them. They all have the same
+   * dynamic type as this plugin, so an override may static_cast them to its own type.
+   * @note By default each plugin is updated in turn, a plugin whose per-entity update is cheap can
+   * override it to process all of its entities in one loop.
+   */
+  virtual auto updateAll(
+    const std::vector<BehaviorPluginBase *> & plugins, const double current_time,
+    const double step_time) -> void
+  {
+    for (const auto plugin : plugins) {
+      plugin->update(current_time, step_time);
+    }
+  }
   virtual const std::string & getCurrentAction() const = 0;
 
+  /**
+   * @brief Clear everything set since configure(), so that a despawned entity's plugin can be
+   * reused by a newly spawned entity, see acquireBehaviorPlugin.
+   * @return false if the plugin does not support it, then it is destroyed instead.
+   */
+  virtual auto recycle() -> bool { return false; }
+
 #define DEFINE_GETTER_SETTER(NAME, KEY, TYPE)      \
   virtual TYPE get##NAME() = 0;                    \
   virtual void set##NAME(const TYPE & value) = 0;  \
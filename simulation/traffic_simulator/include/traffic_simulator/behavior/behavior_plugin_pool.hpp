@@ -0,0 +1,34 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRAFFIC_SIMULATOR__BEHAVIOR__BEHAVIOR_PLUGIN_POOL_HPP_
+#define TRAFFIC_SIMULATOR__BEHAVIOR__BEHAVIOR_PLUGIN_POOL_HPP_
+
+#include <memory>
+#include <string>
+#include <traffic_simulator/behavior/behavior_plugin_base.hpp>
+
+namespace entity_behavior
+{
+/**
+ * @brief Get an instance of the behavior plugin, shared by nothing else.
+ * @note All plugins are loaded by one class loader of this process. When the returned pointer is
+ * released, the plugin is kept for the next call with the same plugin_name if its recycle()
+ * succeeds, so despawning and spawning entities does not rebuild the plugins every time.
+ * configure() has to be called on the returned plugin, whether it is recycled or not.
+ */
+auto acquireBehaviorPlugin(const std::string & plugin_name) -> std::shared_ptr<BehaviorPluginBase>;
+}  // namespace entity_behavior
+
+#endif  // TRAFFIC_SIMULATOR__BEHAVIOR__BEHAVIOR_PLUGIN_POOL_HPP_
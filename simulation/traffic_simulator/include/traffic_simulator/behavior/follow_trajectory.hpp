@@ -19,19 +19,74 @@
 #include <traffic_simulator/data_type/entity_status.hpp>
 #include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
 #include <traffic_simulator_msgs/msg/behavior_parameter.hpp>
+#include <traffic_simulator_msgs/msg/bounding_box.hpp>
 #include <traffic_simulator_msgs/msg/entity_status.hpp>
+#include <traffic_simulator_msgs/msg/lanelet_pose.hpp>
 #include <traffic_simulator_msgs/msg/polyline_trajectory.hpp>
+#include <vector>
 
 namespace traffic_simulator
 {
 namespace follow_trajectory
 {
+/**
+ * @brief The parts of a PolylineTrajectory that do not change while it is followed, computed once
+ * when the trajectory is requested: the lanelet matches of the vertices, the cumulative distances
+ * along the lanelets between them and the positions of the vertices with an arrival time.
+ * @note A cursor keeps track of the front vertex, makeUpdatedStatus advances it every time the
+ * front waypoint is discarded, so that every query is O(1).
+ */
+class PolylineTrajectorySamples
+{
+public:
+  explicit PolylineTrajectorySamples(
+    const traffic_simulator_msgs::msg::PolylineTrajectory &,
+    const traffic_simulator_msgs::msg::BoundingBox &,
+    const std::shared_ptr<hdmap_utils::HdMapUtils> &, double matching_distance);
+
+  /// @return true if the samples describe the remaining vertices of the given trajectory.
+  auto isSampling(const traffic_simulator_msgs::msg::PolylineTrajectory &) const -> bool;
+
+  auto getFrontLaneletPose() const
+    -> const std::optional<traffic_simulator_msgs::msg::LaneletPose> &;
+
+  /// @return Distance along the lanelets from the front vertex to the index-th remaining vertex.
+  auto getDistanceTo(std::size_t index) const -> double;
+
+  /// @return Index of the first remaining vertex with an arrival time, or the number of remaining
+  /// vertices if there is none.
+  auto getIndexOfFirstWaypointWithArrivalTimeSpecified() const -> std::size_t;
+
+  /// @note Follows the front vertex being rotated (closed) or popped (not closed).
+  auto advance() -> void;
+
+private:
+  const bool closed;
+
+  std::vector<geometry_msgs::msg::Point> positions;
+
+  std::vector<std::optional<traffic_simulator_msgs::msg::LaneletPose>> lanelet_poses;
+
+  /*
+     Indexed by the position of a vertex in the trajectory repeated twice, so that a closed
+     trajectory can be followed across its end without wrapping the indices.
+  */
+  std::vector<double> cumulative_distances;
+
+  std::vector<std::size_t> next_waypoint_with_arrival_time_specified;
+
+  std::size_t cursor = 0;
+
+  std::size_t remaining;
+};
+
 auto makeUpdatedStatus(
   const traffic_simulator_msgs::msg::EntityStatus &,
   traffic_simulator_msgs::msg::PolylineTrajectory &,
   const traffic_simulator_msgs::msg::BehaviorParameter &,
   const std::shared_ptr<hdmap_utils::HdMapUtils> &, double, double,
-  std::optional<double> target_speed = std::nullopt) -> std::optional<EntityStatus>;
+  std::optional<double> target_speed = std::nullopt,
+  PolylineTrajectorySamples * samples = nullptr) -> std::optional<EntityStatus>;
 }  // namespace follow_trajectory
 }  // namespace traffic_simulator
 
@@ -76,6 +76,7 @@ class FollowWaypointController
 {
   const double step_time;
   const bool with_breaking;
+  const bool use_bisection;
 
   const double max_speed;
   const double max_acceleration;
@@ -131,6 +132,17 @@ class FollowWaypointController
   */
   static constexpr std::size_t number_of_acceleration_candidates = 30;
 
+  /*
+     Number of halvings of the range of [min_acceleration, max_acceleration]
+     when the acceleration is searched by bisection instead of the
+     discretization above. It gives a finer resolution than the candidates
+     with about a third of the predictions.
+
+     There is no technical basis for this value, it was chosen to match the
+     arrivals of the discretization in the controller tests.
+  */
+  static constexpr std::size_t number_of_bisection_iterations = 8;
+
   /*
      This is a debugging method, it is not worth giving it much attention.
   */
@@ -139,7 +151,8 @@ class FollowWaypointController
   {
     stream << std::setprecision(16) << std::fixed;
     stream << "FollowWaypointController: step_time: " << c.step_time
-           << ", with_breaking: " << c.with_breaking << ", max_speed: " << c.max_speed
+           << ", with_breaking: " << c.with_breaking << ", use_bisection: " << c.use_bisection
+           << ", max_speed: " << c.max_speed
            << ", max_acceleration: " << c.max_acceleration
            << ", max_deceleration: " << c.max_deceleration
            << ", max_acceleration_rate: " << c.max_acceleration_rate
@@ -226,6 +239,7 @@ public:
     const std::optional<double> & target_speed = std::nullopt)
   : step_time{step_time},
     with_breaking{with_breaking},
+    use_bisection{behavior_parameter.use_bisection_for_follow_waypoint},
     max_speed{behavior_parameter.dynamic_constraints.max_speed},
     max_acceleration{behavior_parameter.dynamic_constraints.max_acceleration},
     max_acceleration_rate{behavior_parameter.dynamic_constraints.max_acceleration_rate},
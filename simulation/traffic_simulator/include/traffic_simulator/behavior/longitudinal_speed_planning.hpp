@@ -15,6 +15,7 @@
 #ifndef TRAFFIC_SIMULATOR__BEHAVIOR__LONGITUDINAL_SPEED_PLANNING_HPP_
 #define TRAFFIC_SIMULATOR__BEHAVIOR__LONGITUDINAL_SPEED_PLANNING_HPP_
 
+#include <optional>
 #include <traffic_simulator_msgs/msg/action_status.hpp>
 #include <traffic_simulator_msgs/msg/dynamic_constraints.hpp>
 #include <tuple>
@@ -56,6 +57,17 @@ public:
   const std::string entity;
 
 private:
+  /**
+   * @brief Distance run by getDynamicStates steps until the target speed is reached, in O(1).
+   * @return std::nullopt if the constraints do not meet the assumptions of the closed form.
+   * @note After the first step the acceleration ramps up with constant jerk, saturates and is cut
+   * by the target speed, so the speeds of the steps are sums of arithmetic series.
+   */
+  auto getRunningDistanceInClosedForm(
+    double target_speed, const traffic_simulator_msgs::msg::DynamicConstraints &,
+    const geometry_msgs::msg::Twist & current_twist,
+    const geometry_msgs::msg::Accel & current_accel, double tolerance) const
+    -> std::optional<double>;
   auto isReachedToTargetSpeedWithConstantJerk(
     double target_speed, const traffic_simulator_msgs::msg::DynamicConstraints &,
     const geometry_msgs::msg::Twist & current_twist,
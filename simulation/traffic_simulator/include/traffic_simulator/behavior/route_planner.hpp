@@ -16,7 +16,9 @@
 #define BEHAVIOR_TREE_PLUGIN__ROUTE_PLANNER_HPP_
 
 #include <deque>
+#include <geometry/spline/catmull_rom_spline.hpp>
 #include <memory>
+#include <optional>
 #include <traffic_simulator/data_type/entity_status.hpp>
 #include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
 #include <vector>
@@ -28,9 +30,20 @@ class RoutePlanner
 public:
   explicit RoutePlanner(const std::shared_ptr<hdmap_utils::HdMapUtils> &);
 
+  /**
+   * @note The route lanelets only depend on the lanelet the entity is on, the horizon and the
+   * planned route, so the previous result is reused until one of them changes.
+   */
   auto getRouteLanelets(const CanonicalizedLaneletPose & entity_lanelet_pose, double horizon = 100)
     -> lanelet::Ids;
 
+  /**
+   * @brief Spline along the center points of the lanelets last returned by getRouteLanelets.
+   * @return nullptr if the spline cannot be calculated.
+   * @note Built once per route window, the same object is returned while the window is unchanged.
+   */
+  auto getRouteSpline() -> std::shared_ptr<math::geometry::CatmullRomSpline>;
+
   auto setWaypoints(const std::vector<CanonicalizedLaneletPose> & waypoints) -> void;
 
   auto cancelRoute() -> void;
@@ -42,7 +55,34 @@ private:
 
   auto updateRoute(const CanonicalizedLaneletPose & entity_lanelet_pose) -> void;
 
+  auto setRoute(const std::optional<lanelet::Ids> & route) -> void;
+
+  auto getFollowingLanelets(const lanelet::Id lanelet_id, const double horizon, const bool in_route)
+    -> lanelet::Ids;
+
   std::optional<lanelet::Ids> route_;
+
+  /// @note Incremented whenever route_ changes, so the route window is not compared element-wise.
+  std::size_t route_version_ = 0;
+
+  struct RouteWindow
+  {
+    lanelet::Id lanelet_id;
+
+    double horizon;
+
+    bool in_route;
+
+    std::size_t route_version;
+
+    lanelet::Ids lanelet_ids;
+
+    /// @note std::nullopt until getRouteSpline is called for this window.
+    std::optional<std::shared_ptr<math::geometry::CatmullRomSpline>> spline;
+  };
+
+  std::optional<RouteWindow> route_window_;
+
   std::shared_ptr<hdmap_utils::HdMapUtils> hdmap_utils_ptr_;
 
   /*
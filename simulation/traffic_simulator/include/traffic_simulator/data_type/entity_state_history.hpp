@@ -0,0 +1,104 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRAFFIC_SIMULATOR__DATA_TYPE__ENTITY_STATE_HISTORY_HPP_
+#define TRAFFIC_SIMULATOR__DATA_TYPE__ENTITY_STATE_HISTORY_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <geometry_msgs/msg/accel.hpp>
+#include <geometry_msgs/msg/pose.hpp>
+#include <geometry_msgs/msg/twist.hpp>
+#include <stdexcept>
+#include <string>
+#include <traffic_simulator/data_type/entity_status.hpp>
+
+namespace traffic_simulator
+{
+/**
+ * @brief States of an entity on its most recent frames, the oldest one is overwritten when full.
+ * @note The states are stored in place in a fixed size array, so recording a frame and reading
+ * the history neither allocates nor copies anything but the state of the frame.
+ */
+class EntityStateHistory
+{
+public:
+  struct State
+  {
+    double time = 0.0;
+
+    geometry_msgs::msg::Pose pose;
+
+    geometry_msgs::msg::Twist twist;
+
+    geometry_msgs::msg::Accel accel;
+
+    /// @note Only meaningful if lanelet_pose_valid is true.
+    LaneletPose lanelet_pose;
+
+    bool lanelet_pose_valid = false;
+  };
+
+  /// @note Hard coded parameter, number of frames kept, 1 s at a step time of 10 ms.
+  static constexpr std::size_t capacity = 100;
+
+  auto push(const double time, const CanonicalizedEntityStatus & status) -> void
+  {
+    latest_ = (latest_ + 1) % capacity;
+    size_ = std::min(size_ + 1, capacity);
+    auto & state = states_[latest_];
+    state.time = time;
+    state.pose = status.getMapPose();
+    state.twist = status.getTwist();
+    state.accel = status.getAccel();
+    if ((state.lanelet_pose_valid = status.laneMatchingSucceed())) {
+      state.lanelet_pose = status.getLaneletPose();
+    }
+  }
+
+  auto clear() noexcept -> void { size_ = 0; }
+
+  auto empty() const noexcept -> bool { return size_ == 0; }
+
+  auto size() const noexcept -> std::size_t { return size_; }
+
+  /**
+   * @param age number of frames before the latest one, 0 is the latest state
+   * @throw std::out_of_range if the history does not hold that many frames
+   */
+  auto at(const std::size_t age) const -> const State &
+  {
+    if (size_ <= age) {
+      throw std::out_of_range(
+        "EntityStateHistory holds " + std::to_string(size_) + " states, the state of age " +
+        std::to_string(age) + " is requested");
+    }
+    return states_[(latest_ + capacity - age) % capacity];
+  }
+
+  auto latest() const -> const State & { return at(0); }
+
+  auto oldest() const -> const State & { return at(size_ - 1); }
+
+private:
+  std::array<State, capacity> states_;
+
+  std::size_t latest_ = capacity - 1;
+
+  std::size_t size_ = 0;
+};
+}  // namespace traffic_simulator
+
+#endif  // TRAFFIC_SIMULATOR__DATA_TYPE__ENTITY_STATE_HISTORY_HPP_
@@ -15,7 +15,10 @@
 #ifndef TRAFFIC_SIMULATOR__DATA_TYPE__LANELET_POSE_HPP_
 #define TRAFFIC_SIMULATOR__DATA_TYPE__LANELET_POSE_HPP_
 
+#include <memory>
+#include <mutex>
 #include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
+#include <vector>
 
 namespace traffic_simulator
 {
@@ -32,13 +35,23 @@ public:
   explicit CanonicalizedLaneletPose(
     const LaneletPose & maybe_non_canonicalized_lanelet_pose, const lanelet::Ids & route_lanelets,
     const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils);
-  CanonicalizedLaneletPose(const CanonicalizedLaneletPose & other);
-  CanonicalizedLaneletPose(CanonicalizedLaneletPose && other) noexcept;
-  CanonicalizedLaneletPose & operator=(const CanonicalizedLaneletPose & obj);
+  CanonicalizedLaneletPose(const CanonicalizedLaneletPose & other) = default;
+  CanonicalizedLaneletPose(CanonicalizedLaneletPose && other) noexcept = default;
+  CanonicalizedLaneletPose & operator=(const CanonicalizedLaneletPose & obj) = default;
   explicit operator LaneletPose() const noexcept { return lanelet_pose_; }
-  explicit operator geometry_msgs::msg::Pose() const noexcept { return map_pose_; }
+  explicit operator geometry_msgs::msg::Pose() const { return getMapPose(); }
   auto getLaneletPose() const -> const LaneletPose & { return lanelet_pose_; }
-  auto hasAlternativeLaneletPose() const -> bool { return lanelet_poses_.size() > 1; }
+  auto getMapPose() const -> const geometry_msgs::msg::Pose &;
+  auto hasAlternativeLaneletPose() const -> bool { return getAlternativeLaneletPoses().size() > 1; }
+  /**
+   * @brief Move the pose along its lanelet, keeping the offset and the rpy.
+   * @return std::nullopt if the moved pose leaves the lanelet or the pose lies on overlapping
+   * lanelets, it has to be canonicalized then.
+   * @note A pose inside its lanelet is canonical already, so only the map pose is re-evaluated.
+   */
+  auto moveAlongLanelet(
+    const double distance, const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils) const
+    -> std::optional<CanonicalizedLaneletPose>;
   auto getAlternativeLaneletPoseBaseOnShortestRouteFrom(
     LaneletPose from, const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils,
     bool allow_lane_change = false) const -> std::optional<LaneletPose>;
@@ -47,6 +60,15 @@ public:
     consider_pose_by_road_slope_ = consider_pose_by_road_slope;
   }
   static auto getConsiderPoseByRoadSlope() -> bool { return consider_pose_by_road_slope_; }
+  /**
+   * @note If set, the height and the pitch of the map poses are looked up in the ElevationProfile
+   * of the lanelet at s, instead of projecting the map pose onto the spline of the centerline.
+   */
+  static auto setUseElevationProfile(bool use_elevation_profile) -> void
+  {
+    use_elevation_profile_ = use_elevation_profile;
+  }
+  static auto getUseElevationProfile() -> bool { return use_elevation_profile_; }
 
 /**
    Note: The comparison operator for the CanonicalizedLaneletPose type compares
@@ -71,8 +93,41 @@ public:
 #undef DEFINE_COMPARISON_OPERATOR
 
 private:
-  auto adjustOrientationAndOzPosition(const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils)
-    -> void;
+  /**
+   * @brief Poses derived from the lanelet pose, each computed on its first access.
+   * @note Shared by the copies, which have the same lanelet pose, so that copying is cheap.
+   * std::call_once makes the first access safe from the threads reading the other entities.
+   */
+  struct Derived
+  {
+    const std::shared_ptr<hdmap_utils::HdMapUtils> hdmap_utils;
+
+    const LaneletPose maybe_non_canonicalized_lanelet_pose;
+
+    std::once_flag lanelet_poses_flag;
+
+    std::vector<LaneletPose> lanelet_poses;
+
+    std::once_flag map_pose_flag;
+
+    geometry_msgs::msg::Pose map_pose;
+
+    explicit Derived(
+      const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils,
+      const LaneletPose & maybe_non_canonicalized_lanelet_pose)
+    : hdmap_utils(hdmap_utils),
+      maybe_non_canonicalized_lanelet_pose(maybe_non_canonicalized_lanelet_pose)
+    {
+    }
+  };
+  auto getAlternativeLaneletPoses() const -> const std::vector<LaneletPose> &;
+  /// @note The map pose is computed at once if the rpy of the lanelet pose depends on it.
+  auto derive(
+    const LaneletPose & maybe_non_canonicalized_lanelet_pose,
+    const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils) -> void;
+  static auto adjustOrientationAndOzPosition(
+    geometry_msgs::msg::Pose & map_pose, LaneletPose & lanelet_pose,
+    const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils) -> void;
   auto canonicalize(
     const LaneletPose & may_non_canonicalized_lanelet_pose,
     const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils) -> LaneletPose;
@@ -80,9 +135,9 @@ private:
     const LaneletPose & may_non_canonicalized_lanelet_pose, const lanelet::Ids & route_lanelets,
     const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils) -> LaneletPose;
   LaneletPose lanelet_pose_;
-  std::vector<LaneletPose> lanelet_poses_;
-  geometry_msgs::msg::Pose map_pose_;
+  std::shared_ptr<Derived> derived_;
   inline static bool consider_pose_by_road_slope_{false};
+  inline static bool use_elevation_profile_{false};
 };
 }  // namespace lanelet_pose
 
@@ -0,0 +1,207 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRAFFIC_SIMULATOR__DATA_TYPE__OTHER_ENTITY_STATUS_HPP_
+#define TRAFFIC_SIMULATOR__DATA_TYPE__OTHER_ENTITY_STATUS_HPP_
+
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <traffic_simulator/data_type/entity_status.hpp>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace traffic_simulator
+{
+/**
+ * @brief Read-only view of the statuses of all entities except one.
+ * @note The statuses of a frame are stored once and shared by the views of all entities, so copying
+ * a view (e.g. to a behavior tree blackboard) does not copy any status.
+ */
+class OtherEntityStatus
+{
+public:
+  using Map = std::unordered_map<std::string, CanonicalizedEntityStatus>;
+
+  using key_type = Map::key_type;
+
+  using mapped_type = Map::mapped_type;
+
+  using value_type = Map::value_type;
+
+  using size_type = Map::size_type;
+
+  /// @note Lanelet id to the lane-matched entries of a Map on that lanelet.
+  using LaneletOccupancy = std::unordered_map<lanelet::Id, std::vector<const Map::value_type *>>;
+
+  class const_iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+
+    using value_type = Map::value_type;
+
+    using difference_type = std::ptrdiff_t;
+
+    using pointer = const value_type *;
+
+    using reference = const value_type &;
+
+    const_iterator() = default;
+
+    const_iterator(
+      const Map::const_iterator iter, const Map::const_iterator end,
+      const std::string * excluded_name)
+    : iter_(iter), end_(end), excluded_name_(excluded_name)
+    {
+      skip();
+    }
+
+    auto operator*() const -> reference { return *iter_; }
+
+    auto operator->() const -> pointer { return &*iter_; }
+
+    auto operator++() -> const_iterator &
+    {
+      ++iter_;
+      skip();
+      return *this;
+    }
+
+    auto operator++(int) -> const_iterator
+    {
+      auto copy = *this;
+      ++*this;
+      return copy;
+    }
+
+    auto operator==(const const_iterator & other) const -> bool { return iter_ == other.iter_; }
+
+    auto operator!=(const const_iterator & other) const -> bool { return iter_ != other.iter_; }
+
+  private:
+    auto skip() -> void
+    {
+      if (iter_ != end_ and iter_->first == *excluded_name_) {
+        ++iter_;
+      }
+    }
+
+    Map::const_iterator iter_;
+
+    Map::const_iterator end_;
+
+    const std::string * excluded_name_ = nullptr;
+  };
+
+  using iterator = const_iterator;
+
+  OtherEntityStatus() : OtherEntityStatus(std::make_shared<const Map>(), "") {}
+
+  /**
+   * @param excluded_name Name of the entity whose status is hidden, usually the viewing entity.
+   * @param lanelet_occupancy Occupancy of all_status, built from it if not given. It is meant to
+   * be built once per frame and shared by the views of all entities.
+   */
+  explicit OtherEntityStatus(
+    std::shared_ptr<const Map> all_status, std::string excluded_name = "",
+    std::shared_ptr<const LaneletOccupancy> lanelet_occupancy = nullptr)
+  : all_status_(std::move(all_status)),
+    excluded_name_(std::move(excluded_name)),
+    lanelet_occupancy_(
+      lanelet_occupancy ? std::move(lanelet_occupancy) : makeLaneletOccupancy(*all_status_))
+  {
+  }
+
+  static auto makeLaneletOccupancy(const Map & all_status)
+    -> std::shared_ptr<const LaneletOccupancy>
+  {
+    auto lanelet_occupancy = std::make_shared<LaneletOccupancy>();
+    for (const auto & entry : all_status) {
+      if (entry.second.laneMatchingSucceed()) {
+        (*lanelet_occupancy)[entry.second.getLaneletId()].push_back(&entry);
+      }
+    }
+    return lanelet_occupancy;
+  }
+
+  /// @note Copies the statuses, kept so that callers holding a plain map still work.
+  OtherEntityStatus(const Map & all_status)
+  : OtherEntityStatus(std::make_shared<const Map>(all_status))
+  {
+  }
+
+  auto begin() const -> const_iterator
+  {
+    return const_iterator(all_status_->begin(), all_status_->end(), &excluded_name_);
+  }
+
+  auto end() const -> const_iterator
+  {
+    return const_iterator(all_status_->end(), all_status_->end(), &excluded_name_);
+  }
+
+  auto find(const std::string & name) const -> const_iterator
+  {
+    return name == excluded_name_
+             ? end()
+             : const_iterator(all_status_->find(name), all_status_->end(), &excluded_name_);
+  }
+
+  auto at(const std::string & name) const -> const CanonicalizedEntityStatus &
+  {
+    if (const auto iter = find(name); iter != end()) {
+      return iter->second;
+    } else {
+      throw std::out_of_range("OtherEntityStatus::at");
+    }
+  }
+
+  auto count(const std::string & name) const -> size_type { return find(name) != end() ? 1 : 0; }
+
+  auto size() const -> size_type
+  {
+    return all_status_->size() - all_status_->count(excluded_name_);
+  }
+
+  auto empty() const -> bool { return size() == 0; }
+
+  /// @return The statuses of all entities, including the excluded one.
+  auto getAllStatus() const -> const std::shared_ptr<const Map> & { return all_status_; }
+
+  /// @brief Calls function with each lane-matched entry on lanelet_id, except the excluded one.
+  template <typename Function>
+  auto forEachOnLanelet(const lanelet::Id lanelet_id, Function && function) const -> void
+  {
+    if (const auto iter = lanelet_occupancy_->find(lanelet_id); iter != lanelet_occupancy_->end()) {
+      for (const auto entry : iter->second) {
+        if (entry->first != excluded_name_) {
+          function(*entry);
+        }
+      }
+    }
+  }
+
+private:
+  std::shared_ptr<const Map> all_status_;
+
+  std::string excluded_name_;
+
+  std::shared_ptr<const LaneletOccupancy> lanelet_occupancy_;
+};
+}  // namespace traffic_simulator
+
+#endif  // TRAFFIC_SIMULATOR__DATA_TYPE__OTHER_ENTITY_STATUS_HPP_
@@ -45,6 +45,7 @@ class EgoEntity : public VehicleEntity
   std::optional<double> target_speed_;
   traffic_simulator_msgs::msg::BehaviorParameter behavior_parameter_;
   std::shared_ptr<traffic_simulator_msgs::msg::PolylineTrajectory> polyline_trajectory_;
+  std::optional<follow_trajectory::PolylineTrajectorySamples> polyline_trajectory_samples_;
 
 public:
   explicit EgoEntity() = delete;
@@ -18,14 +18,17 @@
 #include <autoware_auto_control_msgs/msg/ackermann_control_command.hpp>
 #include <autoware_auto_vehicle_msgs/msg/gear_command.hpp>
 #include <concealer/field_operator_application.hpp>
+#include <geometry/oriented_bounding_box.hpp>
 #include <memory>
 #include <optional>
 #include <queue>
 #include <string>
 #include <traffic_simulator/behavior/follow_trajectory.hpp>
 #include <traffic_simulator/behavior/longitudinal_speed_planning.hpp>
+#include <traffic_simulator/data_type/entity_state_history.hpp>
 #include <traffic_simulator/data_type/entity_status.hpp>
 #include <traffic_simulator/data_type/lane_change.hpp>
+#include <traffic_simulator/data_type/other_entity_status.hpp>
 #include <traffic_simulator/data_type/speed_change.hpp>
 #include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
 #include <traffic_simulator/helper/helper.hpp>
@@ -37,12 +40,18 @@
 #include <traffic_simulator_msgs/msg/entity_status.hpp>
 #include <traffic_simulator_msgs/msg/entity_type.hpp>
 #include <traffic_simulator_msgs/msg/obstacle.hpp>
+#include <utility>
 #include <traffic_simulator_msgs/msg/vehicle_parameters.hpp>
 #include <traffic_simulator_msgs/msg/waypoints_array.hpp>
 #include <unordered_map>
 #include <vector>
 #include <visualization_msgs/msg/marker_array.hpp>
 
+namespace entity_behavior
+{
+class BehaviorPluginBase;
+}  // namespace entity_behavior
+
 namespace traffic_simulator
 {
 namespace entity
@@ -82,6 +91,7 @@ public:
   DEFINE_GETTER(LinearJerk,                      double,                                             status_->getLinearJerk())
   DEFINE_GETTER(MapPose,                         const geometry_msgs::msg::Pose &,                   status_->getMapPose())
   DEFINE_GETTER(StandStillDuration,              double,                                             stand_still_duration_)
+  DEFINE_GETTER(StateHistory,                    const EntityStateHistory &,                         state_history_)
   DEFINE_GETTER(TraveledDistance,                double,                                             traveled_distance_)
   // clang-format on
 #undef DEFINE_GETTER
@@ -99,6 +109,13 @@ public:
 
   /*   */ auto get2DPolygon() const -> std::vector<geometry_msgs::msg::Point>;
 
+  /**
+   * @brief Bounding box of the entity placed at its current map pose.
+   * @note The corners and the envelope are computed once per pose, so every query of a frame
+   * shares them. The entities are not updated concurrently with the queries.
+   */
+  /*   */ auto getOrientedBoundingBox() const -> const math::geometry::OrientedBoundingBox &;
+
   virtual auto getCurrentAction() const -> std::string = 0;
 
   virtual auto getBehaviorParameter() const -> traffic_simulator_msgs::msg::BehaviorParameter = 0;
@@ -131,6 +148,29 @@ public:
 
   virtual auto onPostUpdate(const double current_time, const double step_time) -> void;
 
+  /**
+   * @brief Behavior plugin that EntityManager may update together with the plugins of other
+   * entities through BehaviorPluginBase::updateAll.
+   * @return nullptr if the entity is updated only through onUpdate.
+   * @note If not nullptr, onUpdate must be equivalent to onPreBehaviorUpdate, the update of the
+   * plugin and onPostBehaviorUpdate in this order.
+   */
+  virtual auto getBatchableBehaviorPlugin() const -> entity_behavior::BehaviorPluginBase *
+  {
+    return nullptr;
+  }
+
+  virtual auto onPreBehaviorUpdate(const double, const double) -> void {}
+
+  virtual auto onPostBehaviorUpdate(const double, const double) -> void {}
+
+  /**
+   * @return true if onUpdate would leave the status as it is, so EntityManager skips the update.
+   * @note Setting the status from outside, e.g. teleporting the entity, must make this false until
+   * the entity is updated again.
+   */
+  virtual auto isStatic() const -> bool { return false; }
+
   /*   */ void resetDynamicConstraints();
 
   virtual void requestAcquirePosition(const CanonicalizedLaneletPose &) = 0;
@@ -187,7 +227,12 @@ public:
 
   virtual void setBehaviorParameter(const traffic_simulator_msgs::msg::BehaviorParameter &) = 0;
 
-  /*   */ void setOtherStatus(const std::unordered_map<std::string, CanonicalizedEntityStatus> &);
+  /// @note The statuses are shared, not copied, the status of this entity is hidden from the view.
+  /*   */ void setOtherStatus(
+    const std::shared_ptr<const OtherEntityStatus::Map> &,
+    const std::shared_ptr<const OtherEntityStatus::LaneletOccupancy> & = nullptr);
+
+  /*   */ void setOtherStatus(const OtherEntityStatus::Map &);
 
   virtual auto setStatus(const EntityStatus & status, const lanelet::Ids & lanelet_ids) -> void;
 
@@ -222,6 +267,9 @@ public:
 
   /*   */ void updateEntityStatusTimestamp(const double current_time);
 
+  /// @note Called by EntityManager once per frame after all the entities are updated.
+  /*   */ auto updateStateHistory(const double current_time) -> void;
+
   /*   */ bool reachPosition(
     const geometry_msgs::msg::Pose & target_pose, const double tolerance) const;
 
@@ -244,6 +292,12 @@ protected:
 
   CanonicalizedEntityStatus status_before_update_;
 
+  EntityStateHistory state_history_;
+
+  /// @note The map pose the box was computed at, with the box.
+  mutable std::optional<std::pair<geometry_msgs::msg::Pose, math::geometry::OrientedBoundingBox>>
+    oriented_bounding_box_;
+
   std::shared_ptr<hdmap_utils::HdMapUtils> hdmap_utils_ptr_;
   std::shared_ptr<traffic_simulator::TrafficLightManager> traffic_light_manager_;
 
@@ -252,7 +306,7 @@ protected:
   double prev_job_duration_ = 0.0;
   double step_time_ = 0.0;
 
-  std::unordered_map<std::string, CanonicalizedEntityStatus> other_status_;
+  OtherEntityStatus other_status_;
 
   std::optional<double> target_speed_;
   traffic_simulator::job::JobList job_list_;
@@ -19,6 +19,7 @@
 #include <tf2_ros/static_transform_broadcaster.h>
 #include <tf2_ros/transform_broadcaster.h>
 
+#include <algorithm>
 #include <autoware_perception_msgs/msg/traffic_signal_array.hpp>
 #include <memory>
 #include <optional>
@@ -34,16 +35,21 @@
 #include <traffic_simulator/data_type/speed_change.hpp>
 #include <traffic_simulator/entity/ego_entity.hpp>
 #include <traffic_simulator/entity/entity_base.hpp>
+#include <traffic_simulator/entity/entity_registry.hpp>
+#include <traffic_simulator/entity/entity_spatial_index.hpp>
 #include <traffic_simulator/entity/misc_object_entity.hpp>
 #include <traffic_simulator/entity/pedestrian_entity.hpp>
 #include <traffic_simulator/entity/vehicle_entity.hpp>
 #include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
+#include <traffic_simulator/hdmap_utils/registry.hpp>
 #include <traffic_simulator/traffic/traffic_sink.hpp>
 #include <traffic_simulator/traffic_lights/configurable_rate_updater.hpp>
 #include <traffic_simulator/traffic_lights/traffic_light_marker_publisher.hpp>
 #include <traffic_simulator/traffic_lights/traffic_light_publisher.hpp>
+#include <traffic_simulator/utils/entity_log.hpp>
 #include <traffic_simulator/utils/node_parameters.hpp>
 #include <traffic_simulator/utils/pose.hpp>
+#include <traffic_simulator/utils/thread_pool.hpp>
 #include <traffic_simulator_msgs/msg/behavior_parameter.hpp>
 #include <traffic_simulator_msgs/msg/bounding_box.hpp>
 #include <traffic_simulator_msgs/msg/entity_status_with_trajectory_array.hpp>
@@ -51,6 +57,7 @@
 #include <traffic_simulator_msgs/msg/vehicle_parameters.hpp>
 #include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 #include <visualization_msgs/msg/marker_array.hpp>
@@ -83,21 +90,73 @@ class EntityManager
 
   const rclcpp::Clock::SharedPtr clock_ptr_;
 
-  std::unordered_map<std::string, std::shared_ptr<traffic_simulator::entity::EntityBase>> entities_;
+  EntityRegistry entities_;
 
   bool npc_logic_started_;
 
+  /// @note Rebuilt at the end of every update.
+  EntitySpatialIndex entity_spatial_index_;
+
+  /// @note Only created if parameter npc_logic_thread_count is greater than 1.
+  std::unique_ptr<ThreadPool> npc_logic_thread_pool_;
+
+  /**
+   * @note Level of detail of the NPC logic. An NPC farther than npc_lod_distance_ from every ego
+   * entity is updated only once every npc_lod_update_interval_ frames, with the step time of all
+   * skipped frames. Disabled if the distance is not positive.
+   */
+  double npc_lod_distance_ = 0.0;
+
+  std::size_t npc_lod_update_interval_ = 1;
+
+  std::size_t frame_count_ = 0;
+
+  std::unordered_map<std::string, double> npc_lod_skipped_times_;
+
+  /// @note Pose of the "ego" and "entities" frames, fixed when it is first computed.
+  std::optional<geometry_msgs::msg::Pose> entity_frame_pose_;
+
+  std::unordered_set<std::string> broadcast_frame_ids_;
+
+  static auto makeTransform(const geometry_msgs::msg::PoseStamped &)
+    -> geometry_msgs::msg::TransformStamped;
+
+  /**
+   * @return Step time to update the entity with in this frame, or std::nullopt if the update of
+   * the entity is skipped. Not thread-safe, called before the entities are updated.
+   */
+  auto getNpcStepTime(
+    const std::string & name, const double step_time,
+    const std::vector<geometry_msgs::msg::Point> & ego_positions) -> std::optional<double>;
+
   using EntityStatusWithTrajectoryArray =
     traffic_simulator_msgs::msg::EntityStatusWithTrajectoryArray;
   const rclcpp::Publisher<EntityStatusWithTrajectoryArray>::SharedPtr entity_status_array_pub_ptr_;
 
+  /**
+   * @note The entity status is published once every entity_status_publish_interval_ frames, and
+   * only if there is a subscriber. The waypoints of an entity are sent only if they changed since
+   * its last message, except in every entity_status_keyframe_interval_-th message.
+   */
+  std::size_t entity_status_publish_interval_ = 1;
+
+  std::size_t entity_status_keyframe_interval_ = 1;
+
+  std::size_t entity_status_publish_count_ = 0;
+
+  std::unordered_map<std::string, traffic_simulator_msgs::msg::WaypointsArray>
+    published_waypoints_;
+
+  auto publishEntityStatus(const OtherEntityStatus::Map &, const double time) -> void;
+
+  /// @note Opt-in, the statuses of every frame are written to it after they are published.
+  std::unique_ptr<EntityLog::Writer> entity_log_writer_;
+
   using MarkerArray = visualization_msgs::msg::MarkerArray;
   const rclcpp::Publisher<MarkerArray>::SharedPtr lanelet_marker_pub_ptr_;
 
   const std::shared_ptr<hdmap_utils::HdMapUtils> hdmap_utils_ptr_;
 
-  MarkerArray markers_raw_;
-
   const std::shared_ptr<TrafficLightManager> conventional_traffic_light_manager_ptr_;
   const std::shared_ptr<TrafficLightMarkerPublisher>
     conventional_traffic_light_marker_publisher_ptr_;
@@ -161,9 +220,11 @@ public:
     lanelet_marker_pub_ptr_(rclcpp::create_publisher<MarkerArray>(
       node, "lanelet/marker", LaneletMarkerQoS(),
       rclcpp::PublisherOptionsWithAllocator<AllocatorT>())),
-    hdmap_utils_ptr_(std::make_shared<hdmap_utils::HdMapUtils>(
-      configuration.lanelet2_map_path(), getOrigin(*node))),
-    markers_raw_(hdmap_utils_ptr_->generateMarker()),
+    hdmap_utils_ptr_(hdmap_utils::acquireHdMapUtils(
+      configuration.lanelet2_map_path(), getOrigin(*node),
+      getParameter<std::string>(node_parameters_, "map_snapshot_directory", ""),
+      hdmap_utils::toMapRegion(
+        getParameter<std::vector<double>>(node_parameters_, "map_region", {})))),
     conventional_traffic_light_manager_ptr_(
       std::make_shared<TrafficLightManager>(hdmap_utils_ptr_)),
     conventional_traffic_light_marker_publisher_ptr_(
@@ -179,7 +240,7 @@ public:
     v2i_traffic_light_publisher_ptr_(makeV2ITrafficLightPublisher(
       "/perception/traffic_light_recognition/external/traffic_signals", node, hdmap_utils_ptr_)),
     v2i_traffic_light_updater_(
-      node,
+      configuration.v2i_traffic_light_publish_rate,
       [this]() {
         v2i_traffic_light_marker_publisher_ptr_->publish();
         v2i_traffic_light_publisher_ptr_->publish(
@@ -187,13 +248,39 @@ public:
         v2i_traffic_light_legacy_topic_publisher_ptr_->publish(
           clock_ptr_->now(), v2i_traffic_light_manager_ptr_->generateUpdateTrafficLightsRequest());
       }),
-    conventional_traffic_light_updater_(node, [this]() {
-      conventional_traffic_light_marker_publisher_ptr_->publish();
-      conventional_backward_compatible_traffic_light_publisher_ptr_->publish(
-        clock_ptr_->now(),
-        conventional_traffic_light_manager_ptr_->generateUpdateTrafficLightsRequest());
-    })
+    conventional_traffic_light_updater_(
+      configuration.conventional_traffic_light_publish_rate,
+      [this]() {
+        conventional_traffic_light_marker_publisher_ptr_->publish();
+        conventional_backward_compatible_traffic_light_publisher_ptr_->publish(
+          clock_ptr_->now(),
+          conventional_traffic_light_manager_ptr_->generateUpdateTrafficLightsRequest());
+      })
   {
+    if (getParameter<bool>(node_parameters_, "use_route_table", false)) {
+      hdmap_utils_ptr_->enableRouteTable(
+        configuration.lanelet2_map_path().parent_path() / "route_table.bin");
+    }
+    /**
+     * @note Opt-in, because behavior plugins loaded by name are required to be thread-safe with
+     * respect to each other to be updated in parallel.
+     */
+    if (const auto thread_count = getParameter<int>(node_parameters_, "npc_logic_thread_count", 1);
+        thread_count > 1) {
+      npc_logic_thread_pool_ = std::make_unique<ThreadPool>(thread_count);
+    }
+    npc_lod_distance_ = getParameter<double>(node_parameters_, "npc_lod_distance", 0.0);
+    npc_lod_update_interval_ = static_cast<std::size_t>(
+      std::max(1, getParameter<int>(node_parameters_, "npc_lod_update_interval", 4)));
+    entity_status_publish_interval_ = static_cast<std::size_t>(
+      std::max(1, getParameter<int>(node_parameters_, "entity_status_publish_interval", 1)));
+    entity_status_keyframe_interval_ = static_cast<std::size_t>(
+      std::max(1, getParameter<int>(node_parameters_, "entity_status_keyframe_interval", 1)));
+    if (const auto entity_log_path =
+          getParameter<std::string>(node_parameters_, "entity_log_path", "");
+        not entity_log_path.empty()) {
+      entity_log_writer_ = std::make_unique<EntityLog::Writer>(entity_log_path);
+    }
     updateHdmapMarker();
   }
 
@@ -317,17 +404,51 @@ public:
   bool checkCollision(
     const std::string & first_entity_name, const std::string & second_entity_name);
 
+  /**
+   * @brief Names of the entities colliding with the entity of the name, in one pass over entities.
+   * @note The bounding circles of the entities are compared first, so only the entities close
+   * enough are checked by the polygons of their bounding boxes.
+   */
+  auto getEntityNamesCollidingWith(const std::string & name) const -> std::vector<std::string>;
+
   bool despawnEntity(const std::string & name);
 
   bool entityExists(const std::string & name);
 
+  auto entityExists(const EntityHandle & handle) const -> bool;
+
   auto getEntityNames() const -> const std::vector<std::string>;
 
   auto getEntity(const std::string & name) const
     -> std::shared_ptr<traffic_simulator::entity::EntityBase>;
 
+  /// @return nullptr if the entity of the handle was despawned.
+  auto getEntity(const EntityHandle & handle) const
+    -> std::shared_ptr<traffic_simulator::entity::EntityBase>;
+
+  /**
+   * @return Handle of the entity, std::nullopt if it does not exist.
+   * @note Callers resolving the same entity every frame can keep the handle instead of the name.
+   */
+  auto getEntityHandle(const std::string & name) const -> std::optional<EntityHandle>;
+
+  /**
+   * @return Names of the entities within radius of point, sorted.
+   * @note Positions are the ones of the last update, entities despawned since then are skipped.
+   */
+  auto getEntitiesNear(const geometry_msgs::msg::Point & point, const double radius) const
+    -> std::vector<std::string>;
+
+  /**
+   * @return Names of the entities matched to any of lanelet_ids, sorted.
+   * @note Lanelets are the ones of the last update, entities despawned since then are skipped.
+   */
+  auto getEntitiesOnLanelets(const lanelet::Ids & lanelet_ids) const -> std::vector<std::string>;
+
   auto getEntityStatus(const std::string & name) const -> const CanonicalizedEntityStatus &;
 
+  auto getEntityStatus(const EntityHandle & handle) const -> const CanonicalizedEntityStatus &;
+
   auto getHdmapUtils() -> const std::shared_ptr<hdmap_utils::HdMapUtils> &;
 
   auto getNumberOfEgo() const -> std::size_t;
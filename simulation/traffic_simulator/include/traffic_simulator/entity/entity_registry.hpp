@@ -0,0 +1,193 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRAFFIC_SIMULATOR__ENTITY__ENTITY_REGISTRY_HPP_
+#define TRAFFIC_SIMULATOR__ENTITY__ENTITY_REGISTRY_HPP_
+
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <traffic_simulator/entity/entity_base.hpp>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace traffic_simulator
+{
+namespace entity
+{
+/**
+ * @brief Stable reference to a registered entity.
+ * @note A handle stays valid until its entity is despawned and never refers to an entity spawned
+ * later in the same slot, because the generation of a slot changes on every removal.
+ */
+struct EntityHandle
+{
+  std::uint32_t index = std::numeric_limits<std::uint32_t>::max();
+
+  std::uint32_t generation = 0;
+
+  auto operator==(const EntityHandle & other) const -> bool
+  {
+    return index == other.index and generation == other.generation;
+  }
+
+  auto operator!=(const EntityHandle & other) const -> bool { return not(*this == other); }
+};
+
+/**
+ * @brief Entities stored in a contiguous vector of slots, with a side table from names to slots.
+ * @note The interface by name follows std::unordered_map, so that iteration and lookups by name
+ * work as before. Lookups by handle index the slots directly instead of hashing the name. Slots of
+ * despawned entities are reused.
+ */
+class EntityRegistry
+{
+public:
+  using key_type = std::string;
+
+  using mapped_type = std::shared_ptr<EntityBase>;
+
+  using value_type = std::pair<const std::string, std::shared_ptr<EntityBase>>;
+
+  using size_type = std::size_t;
+
+private:
+  struct Slot
+  {
+    std::optional<value_type> entry;
+
+    std::uint32_t generation = 0;
+  };
+
+  template <typename Value, typename Slots>
+  class Iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+
+    using value_type = std::remove_const_t<Value>;
+
+    using difference_type = std::ptrdiff_t;
+
+    using pointer = Value *;
+
+    using reference = Value &;
+
+    Iterator() = default;
+
+    Iterator(Slots * slots, const std::size_t index) : slots_(slots), index_(index) { skip(); }
+
+    /// @note Allows converting an iterator to a const_iterator.
+    template <typename OtherValue, typename OtherSlots>
+    Iterator(const Iterator<OtherValue, OtherSlots> & other)
+    : slots_(other.slots_), index_(other.index_)
+    {
+    }
+
+    auto operator*() const -> reference { return *(*slots_)[index_].entry; }
+
+    auto operator->() const -> pointer { return &*(*slots_)[index_].entry; }
+
+    auto operator++() -> Iterator &
+    {
+      ++index_;
+      skip();
+      return *this;
+    }
+
+    auto operator++(int) -> Iterator
+    {
+      auto copy = *this;
+      ++*this;
+      return copy;
+    }
+
+    auto operator==(const Iterator & other) const -> bool { return index_ == other.index_; }
+
+    auto operator!=(const Iterator & other) const -> bool { return index_ != other.index_; }
+
+  private:
+    template <typename, typename>
+    friend class Iterator;
+
+    auto skip() -> void
+    {
+      while (index_ < slots_->size() and not(*slots_)[index_].entry) {
+        ++index_;
+      }
+    }
+
+    Slots * slots_ = nullptr;
+
+    std::size_t index_ = 0;
+  };
+
+public:
+  using iterator = Iterator<value_type, std::vector<Slot>>;
+
+  using const_iterator = Iterator<const value_type, const std::vector<Slot>>;
+
+  auto begin() -> iterator { return iterator(&slots_, 0); }
+
+  auto begin() const -> const_iterator { return const_iterator(&slots_, 0); }
+
+  auto end() -> iterator { return iterator(&slots_, slots_.size()); }
+
+  auto end() const -> const_iterator { return const_iterator(&slots_, slots_.size()); }
+
+  /// @return The entity and true, or the existing entity of the same name and false.
+  auto emplace(const std::string & name, std::shared_ptr<EntityBase> entity)
+    -> std::pair<iterator, bool>;
+
+  auto erase(const std::string & name) -> size_type;
+
+  auto find(const std::string & name) -> iterator;
+
+  auto find(const std::string & name) const -> const_iterator;
+
+  /// @throw std::out_of_range if there is no entity of the name.
+  auto at(const std::string & name) const -> const std::shared_ptr<EntityBase> &;
+
+  auto count(const std::string & name) const -> size_type { return indices_.count(name); }
+
+  auto size() const -> size_type { return indices_.size(); }
+
+  auto empty() const -> bool { return indices_.empty(); }
+
+  auto getHandle(const std::string & name) const -> std::optional<EntityHandle>;
+
+  /// @return nullptr if the entity of the handle was despawned.
+  auto get(const EntityHandle & handle) const -> std::shared_ptr<EntityBase>;
+
+  /// @return Names of the registered entities in the order they were spawned.
+  auto getNames() const -> const std::vector<std::string> & { return names_; }
+
+private:
+  std::vector<Slot> slots_;
+
+  std::vector<std::uint32_t> free_indices_;
+
+  std::unordered_map<std::string, std::uint32_t> indices_;
+
+  std::vector<std::string> names_;
+};
+}  // namespace entity
+}  // namespace traffic_simulator
+
+#endif  // TRAFFIC_SIMULATOR__ENTITY__ENTITY_REGISTRY_HPP_
@@ -0,0 +1,73 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRAFFIC_SIMULATOR__ENTITY__ENTITY_SPATIAL_INDEX_HPP_
+#define TRAFFIC_SIMULATOR__ENTITY__ENTITY_SPATIAL_INDEX_HPP_
+
+#include <lanelet2_core/Forward.h>
+
+#include <cstdint>
+#include <geometry_msgs/msg/point.hpp>
+#include <string>
+#include <traffic_simulator/data_type/other_entity_status.hpp>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace traffic_simulator
+{
+namespace entity
+{
+/**
+ * @brief Index of the entity statuses of a frame, by position and by lanelet.
+ * @note Positions are bucketed into a uniform grid in map coordinates, so a neighbor query only
+ * visits the cells overlapping its search circle instead of every entity. Results are sorted by
+ * name, so that they do not depend on the order in which the statuses were stored.
+ */
+class EntitySpatialIndex
+{
+public:
+  /// @note Hard coded parameter, a cell of 20 m holds a few vehicles in dense traffic.
+  explicit EntitySpatialIndex(const double cell_size = 20.0);
+
+  auto build(const OtherEntityStatus::Map & all_status) -> void;
+
+  /// @return Names of the entities within radius of point, measured in 3D like getDistance.
+  auto getEntitiesNear(const geometry_msgs::msg::Point & point, const double radius) const
+    -> std::vector<std::string>;
+
+  /// @return Names of the lane-matched entities whose lanelet id is one of lanelet_ids.
+  auto getEntitiesOnLanelets(const lanelet::Ids & lanelet_ids) const -> std::vector<std::string>;
+
+private:
+  auto getCell(const double value) const -> std::int64_t;
+
+  auto getNames(std::vector<std::size_t> && indices) const -> std::vector<std::string>;
+
+  const double cell_size_;
+
+  /// @note Sorted by name.
+  std::vector<std::string> names_;
+
+  std::vector<geometry_msgs::msg::Point> positions_;
+
+  /// @note (cell_x, cell_y, index of names_), sorted so that a row of cells is contiguous.
+  std::vector<std::tuple<std::int64_t, std::int64_t, std::size_t>> cells_;
+
+  std::unordered_map<lanelet::Id, std::vector<std::size_t>> lanelet_occupancy_;
+};
+}  // namespace entity
+}  // namespace traffic_simulator
+
+#endif  // TRAFFIC_SIMULATOR__ENTITY__ENTITY_SPATIAL_INDEX_HPP_
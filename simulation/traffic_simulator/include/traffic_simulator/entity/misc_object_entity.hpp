@@ -33,6 +33,8 @@ public:
 
   void onUpdate(double, double) override;
 
+  auto isStatic() const -> bool override;
+
   auto getCurrentAction() const -> std::string override;
 
   auto getDefaultDynamicConstraints() const
@@ -17,10 +17,10 @@
 
 #include <memory>
 #include <optional>
-#include <pluginlib/class_loader.hpp>
 #include <pugixml.hpp>
 #include <string>
 #include <traffic_simulator/behavior/behavior_plugin_base.hpp>
+#include <traffic_simulator/behavior/behavior_plugin_pool.hpp>
 #include <traffic_simulator/behavior/route_planner.hpp>
 #include <traffic_simulator/entity/entity_base.hpp>
 #include <traffic_simulator_msgs/msg/pedestrian_parameters.hpp>
@@ -70,6 +70,12 @@ public:
 
   auto onUpdate(const double current_time, const double step_time) -> void override;
 
+  auto getBatchableBehaviorPlugin() const -> entity_behavior::BehaviorPluginBase * override;
+
+  auto onPreBehaviorUpdate(const double current_time, const double step_time) -> void override;
+
+  auto onPostBehaviorUpdate(const double current_time, const double step_time) -> void override;
+
   void requestAcquirePosition(const CanonicalizedLaneletPose & lanelet_pose) override;
 
   void requestAcquirePosition(const geometry_msgs::msg::Pose & map_pose) override;
@@ -124,7 +130,6 @@ public:
   const traffic_simulator_msgs::msg::PedestrianParameters pedestrian_parameters;
 
 private:
-  pluginlib::ClassLoader<entity_behavior::BehaviorPluginBase> loader_;
   const std::shared_ptr<entity_behavior::BehaviorPluginBase> behavior_plugin_ptr_;
   traffic_simulator::RoutePlanner route_planner_;
 };
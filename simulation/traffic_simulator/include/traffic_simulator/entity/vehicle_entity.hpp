@@ -17,11 +17,11 @@
 
 #include <memory>
 #include <optional>
-#include <pluginlib/class_loader.hpp>
 #include <pugixml.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <string>
 #include <traffic_simulator/behavior/behavior_plugin_base.hpp>
+#include <traffic_simulator/behavior/behavior_plugin_pool.hpp>
 #include <traffic_simulator/behavior/route_planner.hpp>
 #include <traffic_simulator/entity/entity_base.hpp>
 #include <traffic_simulator_msgs/msg/behavior_parameter.hpp>
@@ -56,6 +56,14 @@ public:
       return name;
     }
 
+    /// @note Lightweight lane following for background traffic, e.g. of TrafficSource.
+    static auto intelligentDriverModel() noexcept -> const std::string &
+    {
+      static const std::string name =
+        "intelligent_driver_model_plugin/IntelligentDriverModelPlugin";
+      return name;
+    }
+
     static auto defaultBehavior() -> const std::string & { return behaviorTree(); }
   };
 
@@ -96,6 +104,12 @@ public:
 
   auto onUpdate(const double current_time, const double step_time) -> void override;
 
+  auto getBatchableBehaviorPlugin() const -> entity_behavior::BehaviorPluginBase * override;
+
+  auto onPreBehaviorUpdate(const double current_time, const double step_time) -> void override;
+
+  auto onPostBehaviorUpdate(const double current_time, const double step_time) -> void override;
+
   void requestAcquirePosition(const CanonicalizedLaneletPose &);
 
   void requestAcquirePosition(const geometry_msgs::msg::Pose & map_pose) override;
@@ -129,15 +143,9 @@ public:
   const traffic_simulator_msgs::msg::VehicleParameters vehicle_parameters;
 
 private:
-  pluginlib::ClassLoader<entity_behavior::BehaviorPluginBase> loader_;
-
   const std::shared_ptr<entity_behavior::BehaviorPluginBase> behavior_plugin_ptr_;
 
   traffic_simulator::RoutePlanner route_planner_;
-
-  std::shared_ptr<math::geometry::CatmullRomSpline> spline_;
-
-  lanelet::Ids previous_route_lanelets_;
 };
 }  // namespace entity
 }  // namespace traffic_simulator
@@ -0,0 +1,74 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRAFFIC_SIMULATOR__HDMAP_UTILS__ADJACENCY_TABLE_HPP_
+#define TRAFFIC_SIMULATOR__HDMAP_UTILS__ADJACENCY_TABLE_HPP_
+
+#include <lanelet2_core/Forward.h>
+
+#include <cstdint>
+#include <traffic_simulator/hdmap_utils/lanelet_index.hpp>
+#include <vector>
+
+namespace hdmap_utils
+{
+/**
+ * @brief Static one-to-many relation between lanelets, stored in compressed sparse row form.
+ * @note The rows are indexed by the dense lanelet index, and the related ids of all rows are
+ * stored in one contiguous array. Built once when the map is loaded and never modified
+ * afterwards, so concurrent lookups are safe.
+ */
+class AdjacencyTable
+{
+public:
+  struct Row
+  {
+    const lanelet::Id * first;
+
+    const lanelet::Id * last;
+
+    auto begin() const -> const lanelet::Id * { return first; }
+
+    auto end() const -> const lanelet::Id * { return last; }
+
+    auto empty() const -> bool { return first == last; }
+
+    auto size() const -> std::size_t { return last - first; }
+  };
+
+  AdjacencyTable() = default;
+
+  /// @note rows[i] are the related ids of the lanelet whose dense index is i, in order.
+  explicit AdjacencyTable(const std::vector<lanelet::Ids> & rows);
+
+  auto row(const LaneletIndex::Index index) const -> Row
+  {
+    return Row{values_.data() + offsets_[index], values_.data() + offsets_[index + 1]};
+  }
+
+  auto ids(const LaneletIndex::Index index) const -> lanelet::Ids
+  {
+    const auto related_ids = row(index);
+    return lanelet::Ids(related_ids.begin(), related_ids.end());
+  }
+
+private:
+  /// @note Related ids of the i-th row are values_[offsets_[i]] to values_[offsets_[i + 1] - 1].
+  std::vector<std::uint32_t> offsets_;
+
+  lanelet::Ids values_;
+};
+}  // namespace hdmap_utils
+
+#endif  // TRAFFIC_SIMULATOR__HDMAP_UTILS__ADJACENCY_TABLE_HPP_
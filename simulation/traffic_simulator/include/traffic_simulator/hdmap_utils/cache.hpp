@@ -15,12 +15,23 @@
 #ifndef TRAFFIC_SIMULATOR__HDMAP_UTILS__CACHE_HPP_
 #define TRAFFIC_SIMULATOR__HDMAP_UTILS__CACHE_HPP_
 
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <geometry/quaternion/quaternion_to_euler.hpp>
 #include <geometry/spline/catmull_rom_spline.hpp>
 #include <geometry_msgs/msg/point.hpp>
+#include <geometry_msgs/msg/pose.hpp>
+#include <iterator>
+#include <list>
+#include <memory>
 #include <mutex>
 #include <optional>
-#include <scenario_simulator_exception/exception.hpp>
+#include <shared_mutex>
+#include <traffic_simulator/data_type/lane_change.hpp>
+#include <tuple>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace std
@@ -44,113 +55,319 @@ public:
 
 namespace hdmap_utils
 {
-class RouteCache
+/**
+ * @brief Thread-safe map from Key to Mapped, split into shards that are locked independently.
+ * @note Readers take a shared lock of a single shard, so concurrent lookups never serialize.
+ * Entries are never modified once inserted; store std::shared_ptr<const T> as Mapped to share large
+ * values with the callers without copying them.
+ */
+template <
+  typename Key, typename Mapped, typename Hash = std::hash<Key>, std::size_t ShardCount = 16>
+class ShardedCache
 {
 public:
-  auto exists(lanelet::Id from, lanelet::Id to, bool allow_lane_change)
+  auto find(const Key & key) const -> std::optional<Mapped>
   {
-    std::lock_guard<std::mutex> lock(mutex_);
-    std::tuple<lanelet::Id, lanelet::Id, bool> key = {from, to, allow_lane_change};
-    return data_.find(key) != data_.end();
+    const auto & shard = getShard(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    if (const auto iter = shard.data.find(key); iter != shard.data.end()) {
+      return iter->second;
+    } else {
+      return std::nullopt;
+    }
+  }
+
+  /**
+   * @note If the key was already inserted (e.g. by another thread which computed the same value
+   * concurrently), the existing entry is kept and returned.
+   */
+  auto insert(const Key & key, Mapped mapped) -> Mapped
+  {
+    auto & shard = getShard(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.data.try_emplace(key, std::move(mapped)).first->second;
   }
 
-  auto getRoute(const lanelet::Id from, const lanelet::Id to, const bool allow_lane_change)
-    -> decltype(auto)
+private:
+  struct Shard
+  {
+    mutable std::shared_mutex mutex;
+
+    std::unordered_map<Key, Mapped, Hash> data;
+  };
+
+  auto getShard(const Key & key) const -> const Shard &
+  {
+    return shards_[Hash{}(key) % ShardCount];
+  }
+
+  auto getShard(const Key & key) -> Shard & { return shards_[Hash{}(key) % ShardCount]; }
+
+  std::array<Shard, ShardCount> shards_;
+};
+
+/**
+ * @brief Thread-safe map from Key to Mapped holding at most capacity entries.
+ * @note When full, inserting evicts the least recently used entry. Lookups reorder the entries,
+ * so they take an exclusive lock; use ShardedCache for entries that never need to be evicted.
+ */
+template <typename Key, typename Mapped, typename Hash = std::hash<Key>>
+class LruCache
+{
+public:
+  explicit LruCache(const std::size_t capacity) : capacity_(capacity) {}
+
+  auto find(const Key & key) -> std::optional<Mapped>
   {
-    if (!exists(from, to, allow_lane_change)) {
-      THROW_SIMULATION_ERROR(
-        "route from : ", from, " to : ", to, (allow_lane_change ? " with" : " without"),
-        " lane change does not exists on route cache.");
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (const auto iter = index_.find(key); iter != index_.end()) {
+      entries_.splice(entries_.begin(), entries_, iter->second);
+      return iter->second->second;
     } else {
-      std::lock_guard<std::mutex> lock(mutex_);
-      return data_.at({from, to, allow_lane_change});
+      return std::nullopt;
     }
   }
 
-  auto appendData(
-    lanelet::Id from, lanelet::Id to, const bool allow_lane_change, const lanelet::Ids & route)
-    -> void
+  auto insert(const Key & key, Mapped mapped) -> void
   {
     std::lock_guard<std::mutex> lock(mutex_);
-    data_[{from, to, allow_lane_change}] = route;
+    if (const auto iter = index_.find(key); iter != index_.end()) {
+      iter->second->second = std::move(mapped);
+      entries_.splice(entries_.begin(), entries_, iter->second);
+    } else {
+      entries_.emplace_front(key, std::move(mapped));
+      index_.emplace(key, entries_.begin());
+      if (entries_.size() > capacity_) {
+        index_.erase(entries_.back().first);
+        entries_.pop_back();
+      }
+    }
   }
 
 private:
-  std::unordered_map<std::tuple<lanelet::Id, lanelet::Id, bool>, lanelet::Ids> data_;
+  const std::size_t capacity_;
 
   std::mutex mutex_;
+
+  std::list<std::pair<Key, Mapped>> entries_;
+
+  std::unordered_map<Key, typename std::list<std::pair<Key, Mapped>>::iterator, Hash> index_;
+};
+
+class RouteCache
+{
+public:
+  /// @return Cached route, or nullptr if the route has not been calculated yet.
+  auto getRoute(const lanelet::Id from, const lanelet::Id to, const bool allow_lane_change) const
+    -> std::shared_ptr<const lanelet::Ids>
+  {
+    return data_.find({from, to, allow_lane_change}).value_or(nullptr);
+  }
+
+  auto appendData(
+    const lanelet::Id from, const lanelet::Id to, const bool allow_lane_change,
+    lanelet::Ids route) -> std::shared_ptr<const lanelet::Ids>
+  {
+    return data_.insert(
+      {from, to, allow_lane_change}, std::make_shared<const lanelet::Ids>(std::move(route)));
+  }
+
+private:
+  ShardedCache<std::tuple<lanelet::Id, lanelet::Id, bool>, std::shared_ptr<const lanelet::Ids>>
+    data_;
 };
 
 class CenterPointsCache
 {
 public:
-  auto exists(lanelet::Id lanelet_id) -> bool
+  struct Entry
   {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return data_.find(lanelet_id) != data_.end();
+    std::shared_ptr<const std::vector<geometry_msgs::msg::Point>> points;
+
+    std::shared_ptr<math::geometry::CatmullRomSpline> spline;
+  };
+
+  /// @return Cached center points and spline, or std::nullopt if they have not been calculated yet.
+  auto find(const lanelet::Id lanelet_id) const -> std::optional<Entry>
+  {
+    return data_.find(lanelet_id);
   }
 
-  auto getCenterPoints(lanelet::Id lanelet_id) -> decltype(auto)
+  auto appendData(const lanelet::Id lanelet_id, std::vector<geometry_msgs::msg::Point> points)
+    -> Entry
   {
-    if (!exists(lanelet_id)) {
-      THROW_SIMULATION_ERROR("center point of : ", lanelet_id, " does not exists on route cache.");
-    }
-    std::lock_guard<std::mutex> lock(mutex_);
-    return data_.at(lanelet_id);
+    auto spline = std::make_shared<math::geometry::CatmullRomSpline>(points);
+    return data_.insert(
+      lanelet_id,
+      Entry{
+        std::make_shared<const std::vector<geometry_msgs::msg::Point>>(std::move(points)),
+        std::move(spline)});
   }
 
-  auto getCenterPointsSpline(lanelet::Id lanelet_id) -> decltype(auto)
+private:
+  ShardedCache<lanelet::Id, Entry> data_;
+};
+
+/**
+ * @brief Splines along the center points of lanelet sequences, shared by everyone following them.
+ * @note Entries only hold weak references, so a spline lives as long as some entity still uses it
+ * as its reference trajectory, and expired entries are dropped when a new spline is inserted.
+ */
+class RouteSplineCache
+{
+public:
+  /// @return Cached spline, or nullptr if no one is using a spline of the lanelet_ids.
+  auto find(const lanelet::Ids & lanelet_ids) const
+    -> std::shared_ptr<math::geometry::CatmullRomSpline>
   {
-    if (!exists(lanelet_id)) {
-      THROW_SIMULATION_ERROR("center point of : ", lanelet_id, " does not exists on route cache.");
-    }
     std::lock_guard<std::mutex> lock(mutex_);
-    return splines_[lanelet_id];
+    if (const auto iter = data_.find(lanelet_ids); iter != data_.end()) {
+      return iter->second.lock();
+    } else {
+      return nullptr;
+    }
   }
 
-  auto appendData(lanelet::Id lanelet_id, const std::vector<geometry_msgs::msg::Point> & route)
+  /**
+   * @note If a spline of the lanelet_ids was inserted in the meantime and is still alive, it is
+   * kept and returned instead, so that everyone shares the same object.
+   */
+  auto appendData(
+    const lanelet::Ids & lanelet_ids, std::shared_ptr<math::geometry::CatmullRomSpline> spline)
+    -> std::shared_ptr<math::geometry::CatmullRomSpline>
   {
     std::lock_guard<std::mutex> lock(mutex_);
-    data_[lanelet_id] = route;
-    splines_[lanelet_id] = std::make_shared<math::geometry::CatmullRomSpline>(route);
+    for (auto iter = data_.begin(); iter != data_.end();) {
+      iter = iter->second.expired() ? data_.erase(iter) : std::next(iter);
+    }
+    if (auto [iter, inserted] = data_.try_emplace(lanelet_ids, spline); not inserted) {
+      return iter->second.lock();
+    }
+    return spline;
   }
 
 private:
-  std::unordered_map<lanelet::Id, std::vector<geometry_msgs::msg::Point>> data_;
+  struct Hash
+  {
+    auto operator()(const lanelet::Ids & lanelet_ids) const -> std::size_t
+    {
+      std::size_t seed = lanelet_ids.size();
+      for (const auto lanelet_id : lanelet_ids) {
+        // hash combine like boost library
+        seed ^= std::hash<lanelet::Id>{}(lanelet_id) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+      }
+      return seed;
+    }
+  };
 
-  std::unordered_map<lanelet::Id, std::shared_ptr<math::geometry::CatmullRomSpline>> splines_;
+  mutable std::mutex mutex_;
 
-  std::mutex mutex_;
+  std::unordered_map<lanelet::Ids, std::weak_ptr<math::geometry::CatmullRomSpline>, Hash> data_;
 };
 
-class LaneletLengthCache
+/**
+ * @brief Target s of lane change trajectories chosen by searching the candidate goals.
+ * @note Keyed by the start pose quantized to position_resolution and yaw_resolution, so nearby
+ * starts share the chosen goal. Only the goal is cached; callers build the trajectory from their
+ * exact start pose, so a cache hit never moves the start of the trajectory.
+ */
+class LaneChangeTrajectoryCache
 {
 public:
-  auto exists(lanelet::Id lanelet_id)
-  {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return data_.find(lanelet_id) != data_.end();
-  }
+  /**
+   * @note Hard coded parameter
+   */
+  static constexpr double position_resolution = 0.1;
+  static constexpr double yaw_resolution = 0.01;
+  static constexpr std::size_t capacity = 1024;
 
-  auto getLength(lanelet::Id lanelet_id)
+  /**
+   * @return std::nullopt if the goal has not been searched yet, otherwise the target s, which is
+   * itself std::nullopt if no candidate goal was acceptable.
+   */
+  auto getTargetS(
+    const geometry_msgs::msg::Pose & from,
+    const traffic_simulator::lane_change::Parameter & lane_change_parameter,
+    const double maximum_curvature_threshold, const double target_trajectory_length,
+    const double forward_distance_threshold) -> std::optional<std::optional<double>>
   {
-    if (!exists(lanelet_id)) {
-      THROW_SIMULATION_ERROR("length of : ", lanelet_id, " does not exists on route cache.");
-    }
-    std::lock_guard<std::mutex> lock(mutex_);
-    return data_[lanelet_id];
+    return data_.find(makeKey(
+      from, lane_change_parameter, maximum_curvature_threshold, target_trajectory_length,
+      forward_distance_threshold));
   }
 
-  auto appendData(lanelet::Id lanelet_id, double length)
+  auto appendData(
+    const geometry_msgs::msg::Pose & from,
+    const traffic_simulator::lane_change::Parameter & lane_change_parameter,
+    const double maximum_curvature_threshold, const double target_trajectory_length,
+    const double forward_distance_threshold, const std::optional<double> target_s) -> void
   {
-    std::lock_guard<std::mutex> lock(mutex_);
-    data_[lanelet_id] = length;
+    data_.insert(
+      makeKey(
+        from, lane_change_parameter, maximum_curvature_threshold, target_trajectory_length,
+        forward_distance_threshold),
+      target_s);
   }
 
 private:
-  std::unordered_map<lanelet::Id, double> data_;
+  struct Key
+  {
+    lanelet::Id target_lanelet_id;
+    std::array<std::int64_t, 4> quantized_from;
+    traffic_simulator::lane_change::TrajectoryShape trajectory_shape;
+    std::array<double, 3> thresholds;
 
-  std::mutex mutex_;
+    auto operator==(const Key & other) const -> bool
+    {
+      return target_lanelet_id == other.target_lanelet_id and
+             quantized_from == other.quantized_from and
+             trajectory_shape == other.trajectory_shape and thresholds == other.thresholds;
+    }
+  };
+
+  struct KeyHash
+  {
+    auto operator()(const Key & key) const -> std::size_t
+    {
+      size_t seed = 0;
+      const auto combine = [&](const auto value) {
+        // hash combine like boost library
+        seed ^= std::hash<std::decay_t<decltype(value)>>{}(value) + 0x9e3779b9 + (seed << 6) +
+                (seed >> 2);
+      };
+      combine(key.target_lanelet_id);
+      for (const auto value : key.quantized_from) {
+        combine(value);
+      }
+      combine(static_cast<int>(key.trajectory_shape));
+      for (const auto value : key.thresholds) {
+        combine(value);
+      }
+      return seed;
+    }
+  };
+
+  static auto makeKey(
+    const geometry_msgs::msg::Pose & from,
+    const traffic_simulator::lane_change::Parameter & lane_change_parameter,
+    const double maximum_curvature_threshold, const double target_trajectory_length,
+    const double forward_distance_threshold) -> Key
+  {
+    const auto quantize = [](const double value, const double resolution) {
+      return static_cast<std::int64_t>(std::llround(value / resolution));
+    };
+    return Key{
+      lane_change_parameter.target.lanelet_id,
+      {quantize(from.position.x, position_resolution),
+       quantize(from.position.y, position_resolution),
+       quantize(from.position.z, position_resolution),
+       quantize(
+         math::geometry::convertQuaternionToEulerAngle(from.orientation).z, yaw_resolution)},
+      lane_change_parameter.trajectory_shape,
+      {maximum_curvature_threshold, target_trajectory_length, forward_distance_threshold}};
+  }
+
+  LruCache<Key, std::optional<double>, KeyHash> data_{capacity};
 };
 }  // namespace hdmap_utils
 
@@ -0,0 +1,70 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRAFFIC_SIMULATOR__HDMAP_UTILS__CENTERLINE_INDEX_HPP_
+#define TRAFFIC_SIMULATOR__HDMAP_UTILS__CENTERLINE_INDEX_HPP_
+
+#include <lanelet2_core/Forward.h>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/geometries/box.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+#include <boost/geometry/geometries/segment.hpp>
+#include <boost/geometry/index/rtree.hpp>
+#include <geometry_msgs/msg/point.hpp>
+#include <utility>
+#include <vector>
+
+namespace hdmap_utils
+{
+/**
+ * @brief Static R-tree over the 2D segments of every lanelet centerline.
+ * @note Built once when the map is loaded and never modified afterwards, so concurrent
+ * queries from const member functions of HdMapUtils are safe.
+ */
+class CenterlineIndex
+{
+public:
+  struct Candidate
+  {
+    lanelet::Id lanelet_id;
+    /// @note 2D distance between the query point and the nearest centerline segment.
+    double distance;
+  };
+
+  CenterlineIndex() = default;
+
+  explicit CenterlineIndex(
+    const std::vector<std::pair<lanelet::Id, std::vector<geometry_msgs::msg::Point>>> &);
+
+  auto empty() const -> bool { return rtree_.empty(); }
+
+  /**
+   * @brief Find every lanelet whose centerline passes within search_radius of the point.
+   * @return Candidates with unique lanelet ids, sorted by ascending distance to the centerline.
+   */
+  auto query(const geometry_msgs::msg::Point &, const double search_radius) const
+    -> std::vector<Candidate>;
+
+private:
+  using Point2d = boost::geometry::model::d2::point_xy<double>;
+  using Box2d = boost::geometry::model::box<Point2d>;
+  using Segment2d = boost::geometry::model::segment<Point2d>;
+  using Value = std::pair<Box2d, std::pair<lanelet::Id, Segment2d>>;
+
+  boost::geometry::index::rtree<Value, boost::geometry::index::rstar<16>> rtree_;
+};
+}  // namespace hdmap_utils
+
+#endif  // TRAFFIC_SIMULATOR__HDMAP_UTILS__CENTERLINE_INDEX_HPP_
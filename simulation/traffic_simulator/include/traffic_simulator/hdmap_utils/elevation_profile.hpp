@@ -0,0 +1,56 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRAFFIC_SIMULATOR__HDMAP_UTILS__ELEVATION_PROFILE_HPP_
+#define TRAFFIC_SIMULATOR__HDMAP_UTILS__ELEVATION_PROFILE_HPP_
+
+#include <geometry/spline/catmull_rom_spline.hpp>
+#include <vector>
+
+namespace hdmap_utils
+{
+/**
+ * @brief Height and orientation of the centerline of a lanelet, sampled at a fixed interval of s.
+ * @note A lookup is a linear interpolation between the two samples around s, instead of evaluating
+ * the spline of the centerline.
+ */
+class ElevationProfile
+{
+public:
+  struct Sample
+  {
+    double z;
+
+    double pitch;
+
+    double yaw;
+  };
+
+  /// @note Hard coded parameter, interval of s between the samples by default.
+  static constexpr double default_resolution = 0.5;
+
+  explicit ElevationProfile(
+    const math::geometry::CatmullRomSpline &, double resolution = default_resolution);
+
+  /// @note s is clamped to the centerline.
+  auto at(double s) const -> Sample;
+
+private:
+  double resolution_;
+
+  std::vector<Sample> samples_;
+};
+}  // namespace hdmap_utils
+
+#endif  // TRAFFIC_SIMULATOR__HDMAP_UTILS__ELEVATION_PROFILE_HPP_
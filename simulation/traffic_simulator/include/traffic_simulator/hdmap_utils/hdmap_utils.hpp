@@ -38,14 +38,23 @@
 #include <geometry/spline/catmull_rom_spline_interface.hpp>
 #include <geometry/spline/hermite_curve.hpp>
 #include <geometry_msgs/msg/pose_stamped.hpp>
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <rclcpp/rclcpp.hpp>
 #include <string>
 #include <tf2_geometry_msgs/tf2_geometry_msgs.hpp>
 #include <traffic_simulator/data_type/lane_change.hpp>
+#include <traffic_simulator/hdmap_utils/adjacency_table.hpp>
 #include <traffic_simulator/hdmap_utils/cache.hpp>
+#include <traffic_simulator/hdmap_utils/centerline_index.hpp>
+#include <traffic_simulator/hdmap_utils/elevation_profile.hpp>
+#include <traffic_simulator/hdmap_utils/lane_bound.hpp>
+#include <traffic_simulator/hdmap_utils/lanelet_index.hpp>
+#include <traffic_simulator/hdmap_utils/map_snapshot.hpp>
+#include <traffic_simulator/hdmap_utils/route_table.hpp>
 #include <traffic_simulator_msgs/msg/bounding_box.hpp>
 #include <traffic_simulator_msgs/msg/entity_status.hpp>
 #include <tuple>
@@ -58,10 +67,31 @@ namespace hdmap_utils
 {
 enum class LaneletType { LANE, CROSSWALK };
 
+/**
+ * @note Once constructed, the map is read only: every const member function may be called from
+ * any number of threads at the same time, and so may enableRouteTable, which replaces the route
+ * table atomically. This holds because
+ * - the tables of static lanelet data are written by the constructor only,
+ * - the centerline of every lanelet is set by the constructor, so lanelet2 never computes one
+ *   lazily while the map is read,
+ * - the caches are guarded by their own locks, and the values they hold are shared immutable,
+ * - the markers and the map message are built under std::call_once.
+ * The lanelets returned by getLanelets belong to the map and must not be modified.
+ */
 class HdMapUtils
 {
 public:
-  explicit HdMapUtils(const boost::filesystem::path &, const geographic_msgs::msg::GeoPoint &);
+  /**
+   * @param snapshot_directory If not empty, the map is loaded from a preprocessed snapshot in this
+   * directory when one exists for the map and origin, otherwise a snapshot is written there.
+   * @param region If given, only the lanelets and areas crossing this box of the map frame are kept
+   * after loading, so the preprocessing of a very large map is limited to the region of the
+   * scenario. A cropped map is neither read from nor written to the snapshot directory.
+   */
+  explicit HdMapUtils(
+    const boost::filesystem::path &, const geographic_msgs::msg::GeoPoint &,
+    const boost::filesystem::path & snapshot_directory = {},
+    const std::optional<lanelet::BoundingBox2d> & region = std::nullopt);
 
   auto canChangeLane(const lanelet::Id from, const lanelet::Id to) const -> bool;
 
@@ -83,10 +113,29 @@ public:
     const traffic_simulator_msgs::msg::LaneletPose & to, bool allow_lane_change) const
     -> std::optional<std::pair<int, int>>;
 
+  /**
+   * @brief Precompute the shortest routes between all pairs of lanelets, used by getRoute.
+   * @param cache_path If not empty, the table is loaded from this file when it matches the map,
+   * otherwise it is built and written to this file.
+   * @note The table needs O(N^2) memory for N lanelets, only use it on maps of moderate size.
+   */
+  auto enableRouteTable(const boost::filesystem::path & cache_path = {}) -> void;
+
   auto filterLaneletIds(const lanelet::Ids &, const char subtype[]) const -> lanelet::Ids;
 
   auto generateMarker() const -> visualization_msgs::msg::MarkerArray;
 
+  /// @note Same as generateMarker, but built once per map and shared by the callers.
+  auto getSharedMarker() const -> std::shared_ptr<const visualization_msgs::msg::MarkerArray>;
+
+  /**
+   * @brief Lanelets an entity on one of the given lanelets can move into without leaving the road:
+   * the following, the preceding and the same direction neighboring ones.
+   * @note The given lanelets themselves are excluded.
+   */
+  auto getAdjacentLaneletIds(
+    const lanelet::Ids &, const traffic_simulator_msgs::msg::EntityType &) const -> lanelet::Ids;
+
   auto getAllCanonicalizedLaneletPoses(const traffic_simulator_msgs::msg::LaneletPose &) const
     -> std::vector<traffic_simulator_msgs::msg::LaneletPose>;
 
@@ -98,9 +147,20 @@ public:
 
   auto getCenterPoints(const lanelet::Id) const -> std::vector<geometry_msgs::msg::Point>;
 
+  /// @note The cached center points themselves, for lookups on every frame without copying them.
+  auto getSharedCenterPoints(const lanelet::Id) const
+    -> std::shared_ptr<const std::vector<geometry_msgs::msg::Point>>;
+
   auto getCenterPointsSpline(const lanelet::Id) const
     -> std::shared_ptr<math::geometry::CatmullRomSpline>;
 
+  /// @note Entities following the same lanelets share one spline, see RouteSplineCache.
+  auto getCenterPointsSpline(const lanelet::Ids &) const
+    -> std::shared_ptr<math::geometry::CatmullRomSpline>;
+
+  /// @note Sampled from the spline of the centerline on the first call for each lanelet.
+  auto getElevationProfile(const lanelet::Id) const -> std::shared_ptr<const ElevationProfile>;
+
   auto getClosestLaneletId(
     const geometry_msgs::msg::Pose &, const double distance_thresh = 30.0,
     const bool include_crosswalk = false) const -> std::optional<lanelet::Id>;
@@ -182,6 +242,9 @@ public:
 
   auto getLeftBound(const lanelet::Id) const -> std::vector<geometry_msgs::msg::Point>;
 
+  /// @note Built from the left bound on the first call for each lanelet.
+  auto getLeftLaneBound(const lanelet::Id) const -> std::shared_ptr<const LaneBound>;
+
   auto getLeftLaneletIds(
     const lanelet::Id, const traffic_simulator_msgs::msg::EntityType &,
     const bool include_opposite_direction = true) const -> lanelet::Ids;
@@ -223,6 +286,9 @@ public:
 
   auto getRightBound(const lanelet::Id) const -> std::vector<geometry_msgs::msg::Point>;
 
+  /// @note Built from the right bound on the first call for each lanelet.
+  auto getRightLaneBound(const lanelet::Id) const -> std::shared_ptr<const LaneBound>;
+
   auto getRightLaneletIds(
     lanelet::Id, traffic_simulator_msgs::msg::EntityType,
     bool include_opposite_direction = true) const -> lanelet::Ids;
@@ -310,12 +376,33 @@ public:
 
   auto toMapBin() const -> autoware_auto_mapping_msgs::msg::HADMapBin;
 
+  /// @note Same as toMapBin, but serialized once per map and shared by the callers.
+  auto getSharedMapBin() const -> std::shared_ptr<const autoware_auto_mapping_msgs::msg::HADMapBin>;
+
   auto toMapPoints(const lanelet::Id, const std::vector<double> & s) const
     -> std::vector<geometry_msgs::msg::Point>;
 
   auto toMapPose(const traffic_simulator_msgs::msg::LaneletPose &, const bool fill_pitch = true)
     const -> geometry_msgs::msg::PoseStamped;
 
+  /**
+   * @brief Batched toLaneletPose(pose, include_crosswalk, matching_distance).
+   * @note The poses are matched on up to thread_count threads, the results keep their order.
+   */
+  auto toLaneletPoses(
+    const std::vector<geometry_msgs::msg::Pose> &, const bool include_crosswalk,
+    const double matching_distance = 1.0, const std::size_t thread_count = 1) const
+    -> std::vector<std::optional<traffic_simulator_msgs::msg::LaneletPose>>;
+
+  /**
+   * @brief Batched toMapPose.
+   * @note Lanelet poses on the same lanelet share a single center points spline lookup, and are
+   * converted on up to thread_count threads. The results keep the order of the lanelet poses.
+   */
+  auto toMapPoses(
+    const std::vector<traffic_simulator_msgs::msg::LaneletPose> &, const bool fill_pitch = true,
+    const std::size_t thread_count = 1) const -> std::vector<geometry_msgs::msg::PoseStamped>;
+
 private:
   /** @defgroup cache
    *  Declared mutable for caching
@@ -323,7 +410,18 @@ private:
   // @{
   mutable RouteCache route_cache_;
   mutable CenterPointsCache center_points_cache_;
-  mutable LaneletLengthCache lanelet_length_cache_;
+  mutable RouteSplineCache route_spline_cache_;
+  mutable ShardedCache<lanelet::Id, std::shared_ptr<const ElevationProfile>>
+    elevation_profile_cache_;
+  mutable ShardedCache<lanelet::Id, std::shared_ptr<const LaneBound>> left_bound_cache_;
+  mutable ShardedCache<lanelet::Id, std::shared_ptr<const LaneBound>> right_bound_cache_;
+  mutable LaneChangeTrajectoryCache lane_change_trajectory_cache_;
+  mutable ShardedCache<std::tuple<lanelet::Id, lanelet::Id, bool>, std::optional<double>>
+    longitudinal_distance_cache_;
+  mutable std::once_flag marker_once_;
+  mutable std::shared_ptr<const visualization_msgs::msg::MarkerArray> marker_;
+  mutable std::once_flag map_bin_once_;
+  mutable std::shared_ptr<const autoware_auto_mapping_msgs::msg::HADMapBin> map_bin_;
   // @}
 
   lanelet::LaneletMapPtr lanelet_map_ptr_;
@@ -332,6 +430,42 @@ private:
   lanelet::routing::RoutingGraphConstPtr pedestrian_routing_graph_ptr_;
   lanelet::traffic_rules::TrafficRulesPtr traffic_rules_pedestrian_ptr_;
   lanelet::ConstLanelets shoulder_lanelets_;
+  CenterlineIndex centerline_index_;
+  LaneletIndex lanelet_index_;
+  /** @defgroup static lanelet data
+   *  Built once when the map is loaded, indexed by lanelet_index_
+   */
+  // @{
+  std::vector<double> lanelet_lengths_;
+  std::vector<double> speed_limits_;
+  /// @note Empty for the lanelets without subtype, which no subtype filter keeps.
+  std::vector<std::string> subtypes_;
+  std::vector<std::string> turn_directions_;
+  AdjacencyTable following_lanelet_table_;
+  AdjacencyTable previous_lanelet_table_;
+  AdjacencyTable next_road_shoulder_table_;
+  AdjacencyTable previous_road_shoulder_table_;
+  /// @note The lanelet taken after or before each one by the walks along the lanes, or InvalId.
+  std::vector<lanelet::Id> next_lanelets_along_;
+  std::vector<lanelet::Id> previous_lanelets_along_;
+  AdjacencyTable conflicting_lane_table_;
+  AdjacencyTable conflicting_crosswalk_table_;
+  AdjacencyTable right_of_way_table_;
+  AdjacencyTable stop_line_table_;
+  AdjacencyTable traffic_light_table_;
+  // @}
+  /** @defgroup static stop line and traffic light geometry
+   *  Built once when the map is loaded, keyed by stop line id and traffic light id
+   */
+  // @{
+  std::unordered_map<lanelet::Id, std::vector<geometry_msgs::msg::Point>> stop_line_points_;
+  std::unordered_map<lanelet::Id, std::vector<std::vector<geometry_msgs::msg::Point>>>
+    traffic_light_stop_lines_points_;
+  std::unordered_map<lanelet::Id, std::unordered_map<std::string, geometry_msgs::msg::Point>>
+    traffic_light_bulb_positions_;
+  std::unordered_map<lanelet::Id, lanelet::Ids> traffic_light_regulatory_element_ids_;
+  // @}
+  std::shared_ptr<const RouteTable> route_table_;
 
   template <typename Lanelet>
   auto getLaneletIds(const std::vector<Lanelet> & lanelets) const -> lanelet::Ids
@@ -355,6 +489,17 @@ private:
 
   auto calculateSegmentDistances(const lanelet::ConstLineString3d &) const -> std::vector<double>;
 
+  auto calculateConflictingCrosswalkIds(const lanelet::ConstLanelet &) const -> lanelet::Ids;
+
+  auto calculateConflictingLaneIds(const lanelet::ConstLanelet &) const -> lanelet::Ids;
+
+  auto calculateRightOfWayLaneletIds(const lanelet::ConstLanelet &) const -> lanelet::Ids;
+
+  auto createAdjacencyTable(const std::function<lanelet::Ids(const lanelet::ConstLanelet &)> &)
+    const -> AdjacencyTable;
+
+  auto createCenterlineIndex() const -> CenterlineIndex;
+
   auto excludeSubtypeLanelets(
     const std::vector<std::pair<double, lanelet::Lanelet>> &, const char subtype[]) const
     -> std::vector<std::pair<double, lanelet::Lanelet>>;
@@ -365,20 +510,41 @@ private:
     const std::vector<double> & accumulated_lengths, const double target_length) const
     -> std::pair<std::size_t, std::size_t>;
 
+  /// @note Only the points, so that it runs in parallel without taking ids of lanelet2.
   auto generateFineCenterline(const lanelet::ConstLanelet &, const double resolution) const
-    -> lanelet::LineString3d;
+    -> lanelet::BasicPoints3d;
+
+  auto getCenterPointsCacheEntry(const lanelet::Id) const -> CenterPointsCache::Entry;
 
   auto getLaneChangeTrajectory(
     const geometry_msgs::msg::Pose & from, const traffic_simulator_msgs::msg::LaneletPose & to,
     const traffic_simulator::lane_change::TrajectoryShape,
     const double tangent_vector_size = 100) const -> math::geometry::HermiteCurve;
 
+  /// @brief Candidate trajectory from the pose to the centerline of the target lanelet at to_s.
+  auto getLaneChangeTrajectory(
+    const geometry_msgs::msg::Pose & from,
+    const traffic_simulator::lane_change::Parameter & lane_change_parameter,
+    const double to_s) const -> math::geometry::HermiteCurve;
+
+  /// @note Throws the same lanelet2 error as the lanelet layer if the id is not in the map.
+  auto getLaneletIndex(const lanelet::Id) const -> LaneletIndex::Index;
+
+  /// @return Longitudinal distance from the origin of the first lanelet to the origin of the last.
+  auto getLongitudinalDistanceBetweenOrigins(
+    const lanelet::Id from, const lanelet::Id to, const bool allow_lane_change) const
+    -> std::optional<double>;
+
   auto getNextRoadShoulderLanelet(const lanelet::Id) const -> lanelet::Ids;
 
   auto getPreviousRoadShoulderLanelet(const lanelet::Id) const -> lanelet::Ids;
 
   auto getStopLines() const -> lanelet::ConstLineStrings3d;
 
+  /// @note The returned reference is valid as long as this object, throws for unknown ids.
+  auto getStopLinePoints(const lanelet::Id stop_line_id) const
+    -> const std::vector<geometry_msgs::msg::Point> &;
+
   auto getStopLinesOnPath(const lanelet::Ids &) const -> lanelet::ConstLineStrings3d;
 
   auto getTrafficLightRegulatoryElementsOnPath(const lanelet::Ids &) const
@@ -387,6 +553,10 @@ private:
   auto getTrafficLights(const lanelet::Id traffic_light_id) const
     -> std::vector<lanelet::AutowareTrafficLightConstPtr>;
 
+  /// @note The returned reference is valid as long as this object, throws for unknown ids.
+  auto getTrafficLightStopLinesPointsReference(const lanelet::Id traffic_light_id) const
+    -> const std::vector<std::vector<geometry_msgs::msg::Point>> &;
+
   auto getTrafficSignRegulatoryElementsOnPath(const lanelet::Ids &) const
     -> std::vector<std::shared_ptr<const lanelet::TrafficSign>>;
 
@@ -396,6 +566,11 @@ private:
   auto getVectorFromPose(const geometry_msgs::msg::Pose &, const double magnitude) const
     -> geometry_msgs::msg::Vector3;
 
+  /// @note The lanelet pose must be canonicalized, and spline must be the one of its lanelet.
+  auto toMapPose(
+    const traffic_simulator_msgs::msg::LaneletPose &, const math::geometry::CatmullRomSpline &,
+    const bool fill_pitch) const -> geometry_msgs::msg::Pose;
+
   auto mapCallback(const autoware_auto_mapping_msgs::msg::HADMapBin &) const -> void;
 
   auto overwriteLaneletsCenterline() -> void;
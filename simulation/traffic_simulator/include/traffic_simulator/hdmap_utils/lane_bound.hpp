@@ -0,0 +1,53 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRAFFIC_SIMULATOR__HDMAP_UTILS__LANE_BOUND_HPP_
+#define TRAFFIC_SIMULATOR__HDMAP_UTILS__LANE_BOUND_HPP_
+
+#include <geometry_msgs/msg/point.hpp>
+#include <vector>
+
+namespace hdmap_utils
+{
+/**
+ * @brief Left or right bound of a lanelet as a polyline, indexed by the arc length of its points.
+ * @note Built once per lanelet, so the distance queries neither copy the points of the map nor
+ * build the geometry of the bound again.
+ */
+class LaneBound
+{
+public:
+  explicit LaneBound(const std::vector<geometry_msgs::msg::Point> &);
+
+  auto getPoints() const -> const std::vector<geometry_msgs::msg::Point> & { return points_; }
+
+  auto getLength() const -> double { return arc_lengths_.empty() ? 0.0 : arc_lengths_.back(); }
+
+  /**
+   * @brief Distance in 2D between the polyline and a polygon, 0 if they intersect or the polyline
+   * is inside the polygon, as math::geometry::getDistance2D of the points of the bound.
+   * @note A segment is skipped without being measured when it is too far along the polyline from
+   * a point already measured to be closer than the distance found so far.
+   */
+  auto getDistance2D(const std::vector<geometry_msgs::msg::Point> & polygon) const -> double;
+
+private:
+  std::vector<geometry_msgs::msg::Point> points_;
+
+  /// @note Arc length in 2D from the first point to each point.
+  std::vector<double> arc_lengths_;
+};
+}  // namespace hdmap_utils
+
+#endif  // TRAFFIC_SIMULATOR__HDMAP_UTILS__LANE_BOUND_HPP_
@@ -0,0 +1,63 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRAFFIC_SIMULATOR__HDMAP_UTILS__LANELET_INDEX_HPP_
+#define TRAFFIC_SIMULATOR__HDMAP_UTILS__LANELET_INDEX_HPP_
+
+#include <lanelet2_core/Forward.h>
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace hdmap_utils
+{
+/**
+ * @brief Dense remapping of the lanelet ids of a map to 0, 1, ..., size() - 1.
+ * @note Per-lanelet data indexed by the dense index can be stored in contiguous arrays instead of
+ * hash maps keyed by the sparse 64-bit ids. When the ids are not too sparse, the lookup is a
+ * single array access, otherwise a binary search over the sorted ids.
+ */
+class LaneletIndex
+{
+public:
+  using Index = std::uint32_t;
+
+  LaneletIndex() = default;
+
+  /// @note The dense index of a lanelet is the position of its id in the sorted ids.
+  explicit LaneletIndex(lanelet::Ids);
+
+  /// @return std::nullopt if the lanelet id is not a lanelet of the map.
+  auto find(const lanelet::Id) const -> std::optional<Index>;
+
+  auto id(const Index index) const -> lanelet::Id { return ids_[index]; }
+
+  auto ids() const -> const lanelet::Ids & { return ids_; }
+
+  auto size() const -> std::size_t { return ids_.size(); }
+
+private:
+  static constexpr Index invalid_index = ~Index(0);
+
+  lanelet::Ids ids_;
+
+  lanelet::Id min_id_ = 0;
+
+  /// @note direct_lookup_[id - min_id_] is the index of the id, empty if the ids are too sparse.
+  std::vector<Index> direct_lookup_;
+};
+}  // namespace hdmap_utils
+
+#endif  // TRAFFIC_SIMULATOR__HDMAP_UTILS__LANELET_INDEX_HPP_
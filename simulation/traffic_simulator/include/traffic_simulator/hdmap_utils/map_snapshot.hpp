@@ -0,0 +1,82 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRAFFIC_SIMULATOR__HDMAP_UTILS__MAP_SNAPSHOT_HPP_
+#define TRAFFIC_SIMULATOR__HDMAP_UTILS__MAP_SNAPSHOT_HPP_
+
+#include <lanelet2_core/LaneletMap.h>
+
+#include <boost/filesystem.hpp>
+#include <cstdint>
+#include <geographic_msgs/msg/geo_point.hpp>
+#include <geometry_msgs/msg/point.hpp>
+#include <memory>
+#include <vector>
+
+namespace hdmap_utils
+{
+/**
+ * @brief Preprocessed lanelet map stored in a single binary file, opened by mmap.
+ * @note The snapshot holds the lanelet map after the centerlines are overwritten, together with the
+ * lengths and center points of all lanelets, so loading it skips XML parsing, projection and
+ * centerline generation. A snapshot is keyed by the content of the lanelet2 map file and the
+ * origin, so editing the map makes the old snapshot unused instead of stale.
+ */
+class MapSnapshot
+{
+public:
+  struct Centerline
+  {
+    lanelet::Id lanelet_id;
+
+    double length;
+
+    std::vector<geometry_msgs::msg::Point> points;
+  };
+
+  /// @return nullptr if there is no snapshot of the map in the directory or it cannot be read.
+  static auto open(
+    const boost::filesystem::path & snapshot_directory,
+    const boost::filesystem::path & lanelet2_map_path, const geographic_msgs::msg::GeoPoint &)
+    -> std::unique_ptr<const MapSnapshot>;
+
+  /// @return true if the snapshot was written successfully.
+  static auto write(
+    const boost::filesystem::path & snapshot_directory,
+    const boost::filesystem::path & lanelet2_map_path, const geographic_msgs::msg::GeoPoint &,
+    const lanelet::LaneletMap &, const std::vector<Centerline> &) -> bool;
+
+  MapSnapshot(const MapSnapshot &) = delete;
+
+  auto operator=(const MapSnapshot &) -> MapSnapshot & = delete;
+
+  ~MapSnapshot();
+
+  auto getLaneletMap() const -> lanelet::LaneletMapPtr;
+
+  auto getCenterlines() const -> std::vector<Centerline>;
+
+private:
+  MapSnapshot(const void * address, const std::size_t size);
+
+  static auto path(const boost::filesystem::path & snapshot_directory, const std::uint64_t key)
+    -> boost::filesystem::path;
+
+  const void * const address_;
+
+  const std::size_t size_;
+};
+}  // namespace hdmap_utils
+
+#endif  // TRAFFIC_SIMULATOR__HDMAP_UTILS__MAP_SNAPSHOT_HPP_
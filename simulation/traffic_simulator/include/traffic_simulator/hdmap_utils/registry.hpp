@@ -0,0 +1,49 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRAFFIC_SIMULATOR__HDMAP_UTILS__REGISTRY_HPP_
+#define TRAFFIC_SIMULATOR__HDMAP_UTILS__REGISTRY_HPP_
+
+#include <boost/filesystem.hpp>
+#include <geographic_msgs/msg/geo_point.hpp>
+#include <memory>
+#include <optional>
+#include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
+#include <vector>
+
+namespace hdmap_utils
+{
+/**
+ * @brief Get the HdMapUtils of the map, shared by every component of this process.
+ * @note The map is loaded only if no component currently holds an instance for the same
+ * lanelet2_map_path, origin and region. The last acquired map is kept until another one is
+ * acquired, the other maps are released when their last holder drops them.
+ * @param snapshot_directory Passed to the constructor of HdMapUtils when the map is loaded.
+ * @param region Passed to the constructor of HdMapUtils when the map is loaded.
+ */
+auto acquireHdMapUtils(
+  const boost::filesystem::path & lanelet2_map_path, const geographic_msgs::msg::GeoPoint & origin,
+  const boost::filesystem::path & snapshot_directory = {},
+  const std::optional<lanelet::BoundingBox2d> & region = std::nullopt)
+  -> std::shared_ptr<HdMapUtils>;
+
+/**
+ * @brief Convert the value of a "map_region" parameter, [min_x, min_y, max_x, max_y] of the map
+ * frame, into the region of the map to load.
+ * @return std::nullopt if the value is empty, so the whole map is loaded.
+ */
+auto toMapRegion(const std::vector<double> &) -> std::optional<lanelet::BoundingBox2d>;
+}  // namespace hdmap_utils
+
+#endif  // TRAFFIC_SIMULATOR__HDMAP_UTILS__REGISTRY_HPP_
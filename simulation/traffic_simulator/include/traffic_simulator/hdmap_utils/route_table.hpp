@@ -0,0 +1,96 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRAFFIC_SIMULATOR__HDMAP_UTILS__ROUTE_TABLE_HPP_
+#define TRAFFIC_SIMULATOR__HDMAP_UTILS__ROUTE_TABLE_HPP_
+
+#include <lanelet2_core/Forward.h>
+
+#include <array>
+#include <boost/filesystem.hpp>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace hdmap_utils
+{
+/**
+ * @brief All-pairs next-hop table of the shortest routes between lanelets.
+ * @note The table needs O(N^2) memory for N lanelets, so it is only intended for maps of moderate
+ * size. Once built, a route query costs O(route length) and needs no locking.
+ */
+class RouteTable
+{
+public:
+  struct Edge
+  {
+    std::uint32_t to;
+
+    double cost;
+  };
+
+  /**
+   * @brief Weighted routing graph, vertices are the indices of lanelet_ids.
+   * @note edges[0] are the edges used without lane changes, edges[1] the ones used with them.
+   */
+  struct Graph
+  {
+    lanelet::Ids lanelet_ids;
+
+    std::array<std::vector<std::vector<Edge>>, 2> edges;
+
+    /// @note Used to detect a stale table file, changes whenever the topology or costs change.
+    auto fingerprint() const -> std::uint64_t;
+  };
+
+  /// @brief Run a Dijkstra search from every lanelet, in parallel.
+  explicit RouteTable(const Graph &);
+
+  /**
+   * @brief Load a table previously written by save().
+   * @return std::nullopt if the file does not exist, is broken, or was built for another graph.
+   */
+  static auto load(const boost::filesystem::path &, const Graph &) -> std::optional<RouteTable>;
+
+  /// @return true if the table was written successfully.
+  auto save(const boost::filesystem::path &) const -> bool;
+
+  /**
+   * @return Lanelet ids from `from` to `to`, empty if `to` is not reachable,
+   * or std::nullopt if `from` or `to` is not a vertex of the table.
+   */
+  auto getRoute(const lanelet::Id from, const lanelet::Id to, const bool allow_lane_change) const
+    -> std::optional<lanelet::Ids>;
+
+private:
+  RouteTable() = default;
+
+  static constexpr std::uint32_t unreachable = std::numeric_limits<std::uint32_t>::max();
+
+  auto size() const -> std::size_t { return lanelet_ids_.size(); }
+
+  std::uint64_t fingerprint_ = 0;
+
+  lanelet::Ids lanelet_ids_;
+
+  std::unordered_map<lanelet::Id, std::uint32_t> indices_;
+
+  /// @note next_hops_[allow_lane_change][from * size() + to] is the vertex following `from`.
+  std::array<std::vector<std::uint32_t>, 2> next_hops_;
+};
+}  // namespace hdmap_utils
+
+#endif  // TRAFFIC_SIMULATOR__HDMAP_UTILS__ROUTE_TABLE_HPP_
@@ -0,0 +1,126 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef TRAFFIC_SIMULATOR__HELPER__PHASE_TIMER_HPP_
+#define TRAFFIC_SIMULATOR__HELPER__PHASE_TIMER_HPP_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <diagnostic_msgs/msg/diagnostic_status.hpp>
+#include <functional>
+#include <map>
+#include <string>
+
+namespace traffic_simulator
+{
+namespace helper
+{
+/**
+ * @brief Wall-clock time spent in a phase of the frame, such as "EntityManager::update".
+ * @note Only the pointer to the name of the phase is stored, so it must be a string literal.
+ */
+struct PhaseTiming
+{
+  const char * phase;
+  double milliseconds;
+  std::size_t allocations = 0;
+  std::size_t allocated_bytes = 0;
+};
+
+/**
+ * @brief Allocations made by operator new on the calling thread since it started.
+ * @note Only counted if traffic_simulator is built with TRAFFIC_SIMULATOR_ALLOCATION_ACCOUNTING,
+ * which replaces the global operator new of the process. Otherwise always zero.
+ */
+struct Allocations
+{
+  std::size_t count = 0;
+  std::size_t bytes = 0;
+};
+
+auto threadAllocations() -> Allocations;
+
+/**
+ * @brief Bounded ring buffer of the phase timings measured on a single thread.
+ * @note Lock-free for a single producer, the thread measuring the phases, and a single consumer,
+ * collectPhaseTimings. Timings pushed while the buffer is full are dropped.
+ */
+class PhaseTimingBuffer
+{
+public:
+  /// @note Enough for the timings of a few hundred entities per frame, collected every second.
+  static constexpr std::size_t capacity = 4096;
+
+  auto push(const PhaseTiming & timing) -> bool;
+
+  auto pop(const std::function<void(const PhaseTiming &)> & consume) -> void;
+
+  /// @note Set once the thread owning the buffer exits, so that nothing is pushed anymore.
+  std::atomic<bool> retired = false;
+
+private:
+  std::array<PhaseTiming, capacity> timings_;
+
+  std::atomic<std::size_t> head_ = 0;
+
+  std::atomic<std::size_t> tail_ = 0;
+};
+
+/**
+ * @brief Measure the wall-clock time and the allocations of the scope as the given phase, on the
+ * buffer of this thread.
+ * @note The phase is also written to the trace of common::Trace, if it is enabled.
+ */
+class ScopedPhaseTimer
+{
+public:
+  explicit ScopedPhaseTimer(const char * phase);
+
+  ~ScopedPhaseTimer();
+
+  ScopedPhaseTimer(const ScopedPhaseTimer &) = delete;
+
+  auto operator=(const ScopedPhaseTimer &) -> ScopedPhaseTimer & = delete;
+
+private:
+  const char * const phase_;
+
+  const Allocations start_allocations_;
+
+  const std::chrono::steady_clock::time_point start_;
+};
+
+struct PhaseStatistics
+{
+  std::size_t count = 0;
+  double total_milliseconds = 0.0;
+  double maximum_milliseconds = 0.0;
+  std::size_t allocations = 0;
+  std::size_t allocated_bytes = 0;
+};
+
+/// @brief Pop the timings measured on all the threads since the last call, accumulated by phase.
+auto collectPhaseTimings() -> std::map<std::string, PhaseStatistics>;
+
+/**
+ * @brief Pop the timings as collectPhaseTimings does, into a diagnostic status.
+ * @note Each phase is a key of the status, with "<mean> / <maximum> ms (<count>)" as its value,
+ * followed by the mean allocations per call if they are counted.
+ */
+auto makePhaseTimingStatus(const std::string & name) -> diagnostic_msgs::msg::DiagnosticStatus;
+}  // namespace helper
+}  // namespace traffic_simulator
+
+#endif  // TRAFFIC_SIMULATOR__HELPER__PHASE_TIMER_HPP_
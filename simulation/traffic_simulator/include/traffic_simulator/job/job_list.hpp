@@ -15,8 +15,9 @@
 #ifndef TRAFFIC_SIMULATOR__JOB__JOB_LIST_HPP_
 #define TRAFFIC_SIMULATOR__JOB__JOB_LIST_HPP_
 
+#include <array>
+#include <list>
 #include <traffic_simulator/job/job.hpp>
-#include <vector>
 
 namespace traffic_simulator
 {
@@ -31,8 +32,17 @@ public:
     const job::Event event);
   void update(const double step_time, const job::Event event);
 
+  /// @return Number of jobs that have not been removed yet, finished jobs are removed on update.
+  auto size() const -> std::size_t;
+
 private:
-  std::vector<Job> list_;
+  /*
+     One bucket per job::Event, so that update visits only the jobs of its event. std::list keeps
+     the jobs in place while they are appended and removed, also by the jobs being updated.
+  */
+  std::array<std::list<Job>, 2> lists_;
+
+  auto getList(const job::Event event) -> std::list<Job> &;
 };
 }  // namespace job
 }  // namespace traffic_simulator
@@ -15,6 +15,9 @@
 #ifndef TRAFFIC_SIMULATOR__SIMULATION_CLOCK__SIMULATION_CLOCK_HPP_
 #define TRAFFIC_SIMULATOR__SIMULATION_CLOCK__SIMULATION_CLOCK_HPP_
 
+#include <chrono>
+#include <limits>
+#include <optional>
 #include <rclcpp/rclcpp.hpp>
 #include <rosgraph_msgs/msg/clock.hpp>
 
@@ -36,7 +39,12 @@ public:
 
   auto getCurrentSimulationTime() const { return seconds_since_the_simulator_started_; }
 
-  auto getStepTime() const { return realtime_factor / frame_rate_; }
+  auto getStepTime() const { return realtime_factor * step_scale_ / frame_rate_; }
+
+  /// @return Simulation time advanced per second of wall-clock time, smoothed over the last frames.
+  auto getAchievedRealtimeFactor() const { return achieved_realtime_factor_; }
+
+  auto getStepScale() const { return step_scale_; }
 
   auto start() -> void;
 
@@ -48,9 +56,27 @@ public:
 
   double realtime_factor;
 
+  /**
+   * @brief Upper bound of the scale of the step time, 1 to disable the real time factor governor.
+   * @note When the frames take longer than the period of the frame rate, for example because of a
+   * spike of the sensors, the simulation time falls behind the real time factor. The governor then
+   * scales the step time by the ratio of the wall-clock time of the frames to their period, up to
+   * this bound, so that the simulation keeps up with the real time factor with coarser steps.
+   */
+  double maximum_step_scale = 1.0;
+
 private:
   double frame_rate_;
 
+  double step_scale_ = 1.0;
+
+  double achieved_realtime_factor_ = std::numeric_limits<double>::quiet_NaN();
+
+  /// @note Wall-clock time of a frame, smoothed so that a single spike does not jerk the step.
+  double frame_duration_ = 0.0;
+
+  std::optional<std::chrono::steady_clock::time_point> previous_update_time_;
+
   const rclcpp::Time time_at_the_start_of_the_simulator_;
 
   double seconds_since_the_simulator_started_ = 0.0;
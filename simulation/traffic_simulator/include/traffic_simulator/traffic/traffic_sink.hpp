@@ -43,7 +43,8 @@ class TrafficSink : public TrafficModuleBase
 public:
   explicit TrafficSink(
     lanelet::Id lanelet_id, double radius, const geometry_msgs::msg::Point & position,
-    const std::function<std::vector<std::string>(void)> & get_entity_names_function,
+    const std::function<std::vector<std::string>(const geometry_msgs::msg::Point &, double)> &
+      get_entity_names_near_function,
     const std::function<geometry_msgs::msg::Pose(const std::string &)> & get_entity_pose_function,
     const std::function<void(std::string)> & despawn_function);
   const lanelet::Id lanelet_id;
@@ -54,7 +55,8 @@ public:
     -> void override;
 
 private:
-  const std::function<std::vector<std::string>(void)> get_entity_names_function;
+  const std::function<std::vector<std::string>(const geometry_msgs::msg::Point &, double)>
+    get_entity_names_near_function;
   const std::function<geometry_msgs::msg::Pose(const std::string &)> get_entity_pose_function;
   const std::function<void(const std::string &)> despawn_function;
 };
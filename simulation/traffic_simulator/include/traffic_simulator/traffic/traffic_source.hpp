@@ -15,13 +15,17 @@
 #ifndef TRAFFIC_SIMULATOR__TRAFFIC__TRAFFIC_SOURCE_HPP_
 #define TRAFFIC_SIMULATOR__TRAFFIC__TRAFFIC_SOURCE_HPP_
 
+#include <arithmetic/random/philox.hpp>
 #include <functional>
 #include <geometry_msgs/msg/pose.hpp>
 #include <random>
+#include <string>
 #include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
 #include <traffic_simulator/traffic/traffic_module_base.hpp>
+#include <traffic_simulator_msgs/msg/lanelet_pose.hpp>
 #include <traffic_simulator_msgs/msg/pedestrian_parameters.hpp>
 #include <traffic_simulator_msgs/msg/vehicle_parameters.hpp>
+#include <vector>
 
 namespace traffic_simulator
 {
@@ -78,7 +82,10 @@ public:
     const double radius, const double rate, const geometry_msgs::msg::Pose & pose,
     const Distribution & distribution, const std::optional<int> seed, const double current_time,
     const Configuration & configuration,
-    const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils, const Spawner & spawn)
+    const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils,
+    const std::function<std::vector<std::string>(const geometry_msgs::msg::Point &, double)> &
+      get_entity_names_near_function,
+    const Spawner & spawn)
   : rate(rate),
     pose(pose),
     id(source_count_++),
@@ -87,7 +94,8 @@ public:
     spawn_vehicle_in_world_coordinate(spawn),
     spawn_pedestrian_in_world_coordinate(spawn),
     hdmap_utils_(hdmap_utils),
-    engine_(seed ? seed.value() : std::random_device()()),
+    get_entity_names_near_function_(get_entity_names_near_function),
+    engine_(seed ? seed.value() : std::random_device()(), id),
     angle_distribution_(0.0, boost::math::constants::two_pi<double>()),
     radius_distribution_(0.0, radius),
     params_distribution_([&]() {
@@ -106,6 +114,7 @@ public:
     validate(hdmap_utils, pose, radius_distribution_.max(), false),
     validate_considering_crosswalk(hdmap_utils, pose, radius_distribution_.max(), true)
   {
+    makeSpawnSlots();
   }
 
   void execute(const double current_time, const double step_time) override;
@@ -117,10 +126,32 @@ public:
   const std::size_t id;
 
 private:
+  /// @brief Lane-matched pose on a centerline inside the source radius, where an entity may spawn.
+  struct SpawnSlot
+  {
+    traffic_simulator_msgs::msg::LaneletPose lanelet_pose;
+
+    geometry_msgs::msg::Pose map_pose;
+  };
+
+  /// @note Hard coded parameter, interval of the spawn slots along the centerlines.
+  static constexpr double spawn_slot_interval = 1.0;
+
+  /// @note Hard coded parameter, number of slots tried before the spawn is deferred to next frame.
+  static constexpr std::size_t spawn_slot_attempts = 10;
+
+  auto makeSpawnSlots() -> void;
+
+  auto makeSpawnSlots(const Validator &) const -> std::vector<SpawnSlot>;
+
   auto makeRandomPose(const bool random_orientation = false) -> geometry_msgs::msg::Pose;
 
-  auto isPoseValid(const VehicleOrPedestrianParameter &, const geometry_msgs::msg::Pose &)
-    -> std::pair<bool, std::optional<CanonicalizedLaneletPose>>;
+  auto isPoseValid(const VehicleOrPedestrianParameter &, const geometry_msgs::msg::Pose &) const
+    -> bool;
+
+  auto isOccupied(
+    const VehicleOrPedestrianParameter &, const geometry_msgs::msg::Pose &,
+    const std::vector<geometry_msgs::msg::Point> & spawned_positions) const -> bool;
 
   static inline std::size_t source_count_ = 0;
 
@@ -136,7 +167,11 @@ private:
 
   const std::shared_ptr<hdmap_utils::HdMapUtils> hdmap_utils_;
 
-  std::mt19937 engine_;
+  const std::function<std::vector<std::string>(const geometry_msgs::msg::Point &, double)>
+    get_entity_names_near_function_;
+
+  /// @note Each source draws from its own stream, so sources do not disturb each other's spawns.
+  math::arithmetic::Philox4x32 engine_;
 
   std::uniform_real_distribution<double> angle_distribution_;
 
@@ -152,6 +187,12 @@ private:
 
   /// @note Validators, one does not allow positions on crosswalk, the other does allow positions on crosswalk
   const Validator validate, validate_considering_crosswalk;
+
+  /// @note Slots on the lanelets of validate and validate_considering_crosswalk respectively.
+  std::vector<SpawnSlot> vehicle_spawn_slots_, pedestrian_spawn_slots_;
+
+  /// @note For each entry of distribution_, indices of the slots its footprint is valid on.
+  std::vector<std::vector<std::size_t>> valid_spawn_slot_indices_;
 };
 }  // namespace traffic
 }  // namespace traffic_simulator
@@ -16,31 +16,34 @@
 #define TRAFFIC_SIMULATOR__TRAFFIC_LIGHTS__CONFIGURABLE_RATE_UPDATER_HPP
 
 #include <functional>
-#include <rclcpp/rclcpp.hpp>
 
 namespace traffic_simulator
 {
+/**
+ * @brief Calls a thunk at a given rate of simulation time, from the update of each frame.
+ * @note The thunk is called on the first frame at or after each multiple of the period, and at most
+ * once per frame, so the publications are aligned to the frames and no timer of the executor is
+ * involved. If the rate is higher than the frame rate, the thunk is called on every frame.
+ */
 class ConfigurableRateUpdater
 {
-  rclcpp::TimerBase::SharedPtr timer_ = nullptr;
-  const rclcpp::node_interfaces::NodeBaseInterface::SharedPtr node_base_interface_;
-  const rclcpp::node_interfaces::NodeTimersInterface::SharedPtr node_timers_interface_;
-  double update_rate_ = 0.0;
+  double update_rate_;
+
+  double next_update_time_ = 0.0;
+
+  bool started_ = false;
+
   const std::function<void()> thunk_;
-  const rclcpp::Clock::SharedPtr clock_ptr_;
 
 public:
-  template <typename NodePointer>
-  ConfigurableRateUpdater(const NodePointer & node, std::function<void()> thunk)
-  : node_base_interface_(node->get_node_base_interface()),
-    node_timers_interface_(node->get_node_timers_interface()),
-    thunk_(thunk),
-    clock_ptr_(node->get_clock())
+  explicit ConfigurableRateUpdater(double update_rate, std::function<void()> thunk)
+  : update_rate_(update_rate), thunk_(thunk)
   {
   }
 
-  auto createTimer(double update_rate) -> void;
+  auto update(const double current_time) -> void;
 
+  /// @note The next call is scheduled from the last one with the new rate.
   auto resetUpdateRate(double update_rate) -> void;
 
   auto getUpdateRate() const -> double { return update_rate_; }
@@ -15,9 +15,11 @@
 #ifndef TRAFFIC_SIMULATOR__TRAFFIC_LIGHTS__TRAFFIC_LIGHT_MANAGER_BASE_HPP_
 #define TRAFFIC_SIMULATOR__TRAFFIC_LIGHTS__TRAFFIC_LIGHT_MANAGER_BASE_HPP_
 
+#include <cstdint>
 #include <iomanip>
 #include <memory>
 #include <rclcpp/rclcpp.hpp>
+#include <set>
 #include <simulation_interface/conversions.hpp>
 #include <stdexcept>  // std::out_of_range
 #include <string>
@@ -39,6 +41,18 @@ protected:
 
   const std::shared_ptr<hdmap_utils::HdMapUtils> hdmap_;
 
+private:
+  /// @note Bulbs and confidence of every traffic light when version_ was last incremented.
+  std::unordered_map<lanelet::Id, std::pair<std::set<TrafficLight::Bulb>, double>> states_;
+
+  std::uint64_t version_ = 0;
+
+  std::uint64_t checked_version_ = 0;
+
+  std::uint64_t request_version_ = 0;
+
+  simulation_api_schema::UpdateTrafficLightsRequest request_;
+
 public:
   explicit TrafficLightManager(const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap);
 
@@ -53,9 +67,19 @@ public:
   auto getTrafficLights(const lanelet::Id lanelet_id)
     -> std::vector<std::reference_wrapper<TrafficLight>>;
 
+  /**
+   * @return Number incremented whenever the bulbs or the confidence of any traffic light changed.
+   * @note Traffic lights are modified through references, so changes are detected by comparing
+   * them with the states at the previous change, which costs no allocation if nothing changed.
+   */
+  auto getVersion() -> std::uint64_t;
+
+  /// @return true if any traffic light has changed since the last call of this function.
   auto hasAnyLightChanged() -> bool;
 
-  auto generateUpdateTrafficLightsRequest() -> simulation_api_schema::UpdateTrafficLightsRequest;
+  /// @note The request is cached and only rebuilt if any traffic light has changed.
+  auto generateUpdateTrafficLightsRequest()
+    -> const simulation_api_schema::UpdateTrafficLightsRequest &;
 };
 }  // namespace traffic_simulator
 #endif  // TRAFFIC_SIMULATOR__TRAFFIC_LIGHTS__TRAFFIC_LIGHT_MANAGER_BASE_HPP_
@@ -16,6 +16,7 @@
 #define TRAFFIC_SIMULATOR__TRAFFIC_LIGHTS__TRAFFIC_LIGHT_PUBLISHER_HPP_
 
 #include <memory>
+#include <optional>
 #include <rclcpp/rclcpp.hpp>
 #include <simulation_interface/conversions.hpp>
 #include <string>
@@ -29,6 +30,9 @@ public:
   virtual auto publish(
     const rclcpp::Time & current_ros_time,
     const simulation_api_schema::UpdateTrafficLightsRequest & request) -> void = 0;
+
+  /// @note Publish the last published message again with the given stamp, without rebuilding it.
+  virtual auto republish(const rclcpp::Time & current_ros_time) -> void = 0;
 };
 
 template <typename Message>
@@ -38,6 +42,8 @@ class TrafficLightPublisher : public TrafficLightPublisherBase
 
   const std::shared_ptr<hdmap_utils::HdMapUtils> hdmap_utils_;
 
+  std::optional<Message> message_;
+
 public:
   template <typename NodePointer>
   explicit TrafficLightPublisher(
@@ -53,6 +59,8 @@ public:
   auto publish(
     const rclcpp::Time & current_ros_time,
     const simulation_api_schema::UpdateTrafficLightsRequest & request) -> void override;
+
+  auto republish(const rclcpp::Time & current_ros_time) -> void override;
 };
 }  // namespace traffic_simulator
 #endif  // TRAFFIC_SIMULATOR__TRAFFIC_LIGHTS__TRAFFIC_LIGHT_PUBLISHER_HPP_
@@ -17,6 +17,8 @@
 
 #include <traffic_simulator/data_type/lanelet_pose.hpp>
 #include <traffic_simulator_msgs/msg/waypoints_array.hpp>
+#include <tuple>
+#include <vector>
 
 namespace traffic_simulator
 {
@@ -98,6 +100,16 @@ auto distanceToRightLaneBound(
   const traffic_simulator_msgs::msg::BoundingBox & bounding_box, const lanelet::Ids & lanelet_ids,
   const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils_ptr) -> double;
 
+/**
+ * @brief Batched distanceToLaneBound(map_pose, bounding_box, lanelet_ids, hdmap_utils_ptr).
+ * @note The polygon of each entity is built once for both bounds of all its lanelets, and the
+ * bounds are shared by all the entities through the cache of the hdmap_utils.
+ */
+auto distancesToLaneBound(
+  const std::vector<std::tuple<
+    geometry_msgs::msg::Pose, traffic_simulator_msgs::msg::BoundingBox, lanelet::Ids>> & entities,
+  const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils_ptr) -> std::vector<double>;
+
 // Other objects
 auto distanceToCrosswalk(
   const traffic_simulator_msgs::msg::WaypointsArray & waypoints_array,
@@ -0,0 +1,100 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRAFFIC_SIMULATOR__UTILS__ENTITY_LOG_HPP_
+#define TRAFFIC_SIMULATOR__UTILS__ENTITY_LOG_HPP_
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <traffic_simulator/data_type/other_entity_status.hpp>
+#include <traffic_simulator_msgs/msg/entity_status.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace traffic_simulator
+{
+/**
+ * @brief States of the entities on every frame, stored in a single binary file opened by mmap.
+ * @note Each entity takes a fixed size record per frame, with the position and the velocities in
+ * single precision and the orientation quantized to 16 bits per component, instead of the full
+ * EntityStatus message. The frames are indexed at the end of the file, so any frame is read
+ * without reading the ones before it.
+ */
+class EntityLog
+{
+public:
+  /// @brief Appends the frames to the file, the index is written when the writer is destroyed.
+  class Writer
+  {
+  public:
+    /// @throw common::SimulationError if the file cannot be created.
+    explicit Writer(const boost::filesystem::path &);
+
+    Writer(const Writer &) = delete;
+
+    auto operator=(const Writer &) -> Writer & = delete;
+
+    ~Writer();
+
+    auto write(const double time, const OtherEntityStatus::Map &) -> void;
+
+  private:
+    boost::filesystem::ofstream file_;
+
+    std::vector<std::string> names_;
+
+    std::unordered_map<std::string, std::uint32_t> ids_;
+
+    std::uint64_t entity_count_ = 0;
+
+    std::vector<double> times_;
+
+    std::vector<std::uint64_t> first_entities_;
+  };
+
+  /// @return nullptr if the file does not exist, is not an entity log or was not closed.
+  static auto open(const boost::filesystem::path &) -> std::unique_ptr<const EntityLog>;
+
+  EntityLog(const EntityLog &) = delete;
+
+  auto operator=(const EntityLog &) -> EntityLog & = delete;
+
+  ~EntityLog();
+
+  auto getFrameCount() const -> std::size_t;
+
+  auto getTime(const std::size_t frame) const -> double;
+
+  /// @return The last frame at or before the time, or the first frame if there is none.
+  auto findFrame(const double time) const -> std::size_t;
+
+  /// @note Only the fields stored in the log are filled, the type and bounding box are not.
+  auto getFrame(const std::size_t frame) const
+    -> std::vector<traffic_simulator_msgs::msg::EntityStatus>;
+
+private:
+  EntityLog(const void * address, const std::size_t size, std::vector<std::string> names);
+
+  const void * const address_;
+
+  const std::size_t size_;
+
+  const std::vector<std::string> names_;
+};
+}  // namespace traffic_simulator
+
+#endif  // TRAFFIC_SIMULATOR__UTILS__ENTITY_LOG_HPP_
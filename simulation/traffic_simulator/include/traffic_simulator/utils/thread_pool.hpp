@@ -0,0 +1,94 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRAFFIC_SIMULATOR__UTILS__THREAD_POOL_HPP_
+#define TRAFFIC_SIMULATOR__UTILS__THREAD_POOL_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace traffic_simulator
+{
+/**
+ * @brief Fixed set of threads running index-parallel loops.
+ * @note The threads are created once and sleep between loops, so a loop costs a wake-up instead
+ * of thread creation. Each thread first runs the indices of its own block and then steals the
+ * remaining indices of the other blocks, so uneven tasks do not leave threads idle.
+ */
+class ThreadPool
+{
+public:
+  /// @param thread_count Number of threads running a loop, including the calling thread.
+  explicit ThreadPool(const std::size_t thread_count);
+
+  ThreadPool(const ThreadPool &) = delete;
+
+  auto operator=(const ThreadPool &) -> ThreadPool & = delete;
+
+  ~ThreadPool();
+
+  auto size() const -> std::size_t { return workers_.size() + 1; }
+
+  /**
+   * @brief Run task(i) for every i in [0, count) and wait until all of them are done.
+   * @note The calling thread takes part in the loop. If some tasks throw, the exception of the
+   * lowest index is rethrown after all tasks are done, so that the result does not depend on the
+   * scheduling. Not reentrant, a task must not call parallelFor of the same pool.
+   */
+  auto parallelFor(const std::size_t count, const std::function<void(std::size_t)> & task)
+    -> void;
+
+private:
+  /// @note Padded to a cache line so that threads taking indices of their blocks do not contend.
+  struct alignas(64) Block
+  {
+    std::atomic<std::size_t> next;
+
+    std::size_t end;
+  };
+
+  auto run(const std::size_t thread_index) -> void;
+
+  auto work(const std::size_t thread_index) -> void;
+
+  std::vector<std::thread> workers_;
+
+  std::unique_ptr<Block[]> blocks_;
+
+  const std::function<void(std::size_t)> * task_ = nullptr;
+
+  std::vector<std::exception_ptr> exceptions_;
+
+  std::mutex mutex_;
+
+  std::condition_variable start_condition_;
+
+  std::condition_variable finish_condition_;
+
+  std::uint64_t generation_ = 0;
+
+  std::size_t running_workers_ = 0;
+
+  bool stopping_ = false;
+};
+}  // namespace traffic_simulator
+
+#endif  // TRAFFIC_SIMULATOR__UTILS__THREAD_POOL_HPP_
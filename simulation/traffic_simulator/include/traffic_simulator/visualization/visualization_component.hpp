@@ -60,11 +60,16 @@ extern "C" {
 }  // extern "C"
 #endif
 
+#include <geometry/spline/catmull_rom_spline.hpp>
+#include <limits>
+#include <memory>
 #include <rclcpp/rclcpp.hpp>
+#include <set>
 #include <string>
 #include <traffic_simulator/color_utils/color_utils.hpp>
 #include <traffic_simulator_msgs/msg/entity_status_with_trajectory_array.hpp>
 #include <unordered_map>
+#include <vector>
 #include <visualization_msgs/msg/marker_array.hpp>
 
 namespace traffic_simulator
@@ -96,19 +101,33 @@ private:
    * @return const visualization_msgs::msg::MarkerArray delete marker messages. (action is DELETE_ALL)
    */
   const visualization_msgs::msg::MarkerArray generateDeleteMarker() const;
+  /**
+   * @brief state of the markers of an entity, kept between the messages.
+   */
+  struct EntityMarkers
+  {
+    std::vector<geometry_msgs::msg::Pose> goal_pose;
+    traffic_simulator_msgs::msg::WaypointsArray waypoints;
+    /// @note Spline of the waypoints, nullptr if there are not more than two waypoints.
+    std::shared_ptr<const math::geometry::CatmullRomSpline> spline;
+    /// @note Whether the goal pose or waypoints changed since their markers were published.
+    bool static_markers_changed = true;
+    /// @note IDs of the markers published for the entity, to delete them when it despawns.
+    std::set<std::int32_t> ids;
+  };
   /**
    * @brief generate marker from entity status
    * @param status entity status message
-   * @param waypoints waypoints message
+   * @param entity goal pose and waypoints of the entity
    * @param obstacle obstacles in waypoint
+   * @param static_markers if true, the goal pose and waypoints markers are generated too.
    * @return const visualization_msgs::msg::MarkerArray markers which describes entity bounding box and it's status.
    */
   int goal_pose_max_size = 0;
   const visualization_msgs::msg::MarkerArray generateMarker(
-    const traffic_simulator_msgs::msg::EntityStatus & status,
-    const std::vector<geometry_msgs::msg::Pose> & goal_pose,
-    const traffic_simulator_msgs::msg::WaypointsArray & waypoints,
-    const traffic_simulator_msgs::msg::Obstacle & obstacle, bool obstacle_find);
+    const traffic_simulator_msgs::msg::EntityStatus & status, const EntityMarkers & entity,
+    const traffic_simulator_msgs::msg::Obstacle & obstacle, bool obstacle_find,
+    bool static_markers);
   /**
    * @brief publisher of marker topic.
    */
@@ -119,9 +138,19 @@ private:
   rclcpp::Subscription<traffic_simulator_msgs::msg::EntityStatusWithTrajectoryArray>::SharedPtr
     entity_status_sub_;
   /**
-   * @brief buffers for generated markers.
+   * @brief markers of the entities of the last published message.
+   */
+  std::unordered_map<std::string, EntityMarkers> entities_;
+  /**
+   * @brief rate of the published markers (unit : Hz), every received message is published if zero.
+   */
+  const double marker_publish_rate_;
+  /**
+   * @brief lifetime of the markers republished with the entity poses (unit : second).
    */
-  std::unordered_map<std::string, visualization_msgs::msg::MarkerArray> markers_;
+  const double marker_lifetime_;
+  double last_publish_time_ = -std::numeric_limits<double>::infinity();
+  double last_static_markers_time_ = -std::numeric_limits<double>::infinity();
 };
 }  // namespace traffic_simulator
 
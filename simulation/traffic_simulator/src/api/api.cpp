@@ -14,6 +14,7 @@
 
 #include <tf2/LinearMath/Quaternion.h>
 
+#include <cmath>
 #include <geometry/quaternion/euler_to_quaternion.hpp>
 #include <limits>
 #include <memory>
@@ -23,6 +24,7 @@
 #include <stdexcept>
 #include <string>
 #include <traffic_simulator/api/api.hpp>
+#include <traffic_simulator/helper/phase_timer.hpp>
 #include <traffic_simulator/traffic/traffic_source.hpp>
 #include <traffic_simulator/utils/pose.hpp>
 
@@ -32,18 +34,46 @@ void API::setVerbose(const bool verbose) { entity_manager_ptr_->setVerbose(verbo
 
 bool API::despawn(const std::string & name)
 {
+  const auto is_ego =
+    entity_manager_ptr_->entityExists(name) and entity_manager_ptr_->is<entity::EgoEntity>(name);
   const auto result = entity_manager_ptr_->despawnEntity(name);
   if (!result) {
     return false;
   }
+  sent_kinematics_.erase(name);
   if (not configuration.standalone_mode) {
-    simulation_api_schema::DespawnEntityRequest req;
-    req.set_name(name);
-    return zeromq_client_.call(req).result().success();
+    if (is_ego) {
+      simulation_api_schema::DespawnEntityRequest req;
+      req.set_name(name);
+      return zeromq_client_.call(req).result().success();
+    } else if (not cancelSpawnInSim(name)) {
+      step_request_.mutable_despawn_entities()->add_names(name);
+    }
   }
   return true;
 }
 
+auto API::cancelSpawnInSim(const std::string & name) -> bool
+{
+  const auto erase = [&](auto & requests) {
+    for (int i = 0; i < requests.size(); ++i) {
+      if (requests.Get(i).parameters().name() == name) {
+        requests.DeleteSubrange(i, 1);
+        return true;
+      }
+    }
+    return false;
+  };
+  if (step_request_.has_spawn_entities()) {
+    auto & spawn_entities = *step_request_.mutable_spawn_entities();
+    return erase(*spawn_entities.mutable_vehicles()) or
+           erase(*spawn_entities.mutable_pedestrians()) or
+           erase(*spawn_entities.mutable_misc_objects());
+  } else {
+    return false;
+  }
+}
+
 bool API::despawnEntities()
 {
   auto entities = getEntityNames();
@@ -104,6 +134,12 @@ auto API::getEntity(const std::string & name) const -> std::shared_ptr<entity::E
   return entity_manager_ptr_->getEntity(name);
 }
 
+auto API::getEntity(const entity::EntityHandle & handle) const
+  -> std::shared_ptr<entity::EntityBase>
+{
+  return entity_manager_ptr_->getEntity(handle);
+}
+
 auto API::setEntityStatus(
   const std::string & name, const CanonicalizedLaneletPose & canonicalized_lanelet_pose,
   const traffic_simulator_msgs::msg::ActionStatus & action_status) -> void
@@ -279,40 +315,66 @@ bool API::attachLidarSensor(
 
 bool API::updateTimeInSim()
 {
-  simulation_api_schema::UpdateFrameRequest request;
+  auto & request = *step_request_.mutable_update_frame();
   request.set_current_simulation_time(clock_.getCurrentSimulationTime());
   request.set_current_scenario_time(getCurrentTime());
   simulation_interface::toProto(
     clock_.getCurrentRosTimeAsMsg().clock, *request.mutable_current_ros_time());
-  return zeromq_client_.call(request).result().success();
+  return true;
 }
 
 bool API::updateTrafficLightsInSim()
 {
   if (entity_manager_ptr_->trafficLightsChanged()) {
-    auto req = entity_manager_ptr_->generateUpdateRequestForConventionalTrafficLights();
-    return zeromq_client_.call(req).result().success();
+    *step_request_.mutable_update_traffic_lights() =
+      entity_manager_ptr_->generateUpdateRequestForConventionalTrafficLights();
   }
-  /// @todo handle response
-  return simulation_api_schema::UpdateTrafficLightsResponse().result().success();
+  return true;
 }
 
-bool API::updateEntitiesStatusInSim()
+auto API::updateEntitiesStatusInSim() -> std::future<simulation_api_schema::StepResponse>
 {
-  simulation_api_schema::UpdateEntityStatusRequest req;
+  helper::ScopedPhaseTimer timer("API::updateEntitiesStatusInSim");
+  auto & req = *step_request_.mutable_update_entity_status();
   req.set_npc_logic_started(entity_manager_ptr_->isNpcLogicStarted());
   for (const auto & entity_name : entity_manager_ptr_->getEntityNames()) {
-    const auto entity_status =
-      static_cast<EntityStatus>(entity_manager_ptr_->getEntityStatus(entity_name));
-    simulation_interface::toProto(entity_status, *req.add_status());
+    /// @note Only the full statuses are copied out of the entity, the kinematics are read in place.
+    const auto & entity_status = entity_manager_ptr_->getEntityStatus(entity_name);
     if (entity_manager_ptr_->is<entity::EgoEntity>(entity_name)) {
+      /// @note The simulator steps the ego on its status, so the ego is sent on every frame.
+      simulation_interface::toProto(static_cast<EntityStatus>(entity_status), *req.add_status());
       req.set_overwrite_ego_status(entity_manager_ptr_->isControlledBySimulator(entity_name));
+    } else if (auto iter = sent_kinematics_.find(entity_name); iter == sent_kinematics_.end()) {
+      simulation_interface::toProto(static_cast<EntityStatus>(entity_status), *req.add_status());
+      (*req.mutable_handles())[entity_name] = next_entity_handle_;
+      sent_kinematics_.emplace(
+        entity_name, SentKinematics{
+                       next_entity_handle_++, entity_status.getMapPose(), entity_status.getTwist(),
+                       entity_status.getAccel()});
+    } else if (
+      auto & sent = iter->second; sent.pose != entity_status.getMapPose() or
+                                  sent.twist != entity_status.getTwist() or
+                                  sent.accel != entity_status.getAccel()) {
+      sent.pose = entity_status.getMapPose();
+      sent.twist = entity_status.getTwist();
+      sent.accel = entity_status.getAccel();
+      auto & kinematics = *req.add_kinematics();
+      kinematics.set_handle(sent.handle);
+      simulation_interface::toProto(sent.pose, *kinematics.mutable_pose());
+      simulation_interface::toProto(sent.twist, *kinematics.mutable_twist());
+      simulation_interface::toProto(sent.accel, *kinematics.mutable_accel());
     }
   }
 
-  simulation_api_schema::UpdateEntityStatusResponse res;
-  if (auto res = zeromq_client_.call(req); res.result().success()) {
-    for (const auto & res_status : res.status()) {
+  auto res = zeromq_client_.callAsync(step_request_);
+  step_request_.Clear();
+  return res;
+}
+
+bool API::updateEntitiesStatusFromSim(const simulation_api_schema::StepResponse & res)
+{
+  if (res.result().success()) {
+    for (const auto & res_status : res.update_entity_status().status()) {
       auto entity_name = res_status.name();
       auto entity_status =
         static_cast<EntityStatus>(entity_manager_ptr_->getEntityStatus(entity_name));
@@ -334,11 +396,33 @@ bool API::updateEntitiesStatusInSim()
 
 bool API::updateFrame()
 {
+  helper::ScopedPhaseTimer timer("API::updateFrame");
+
   if (configuration.standalone_mode && entity_manager_ptr_->isEgoSpawned()) {
     THROW_SEMANTIC_ERROR("Ego simulation is no longer supported in standalone mode");
   }
 
-  if (!updateEntitiesStatusInSim()) {
+  /*
+     The time and the traffic lights of the previous frame are sent along with the entity status of
+     this frame, so that stepping the simulator takes a single round trip per frame.
+  */
+  auto step_response = updateEntitiesStatusInSim();
+
+  /*
+     The transforms and the debug markers of the previous frame do not depend on the response, so
+     they are published while the simulator steps.
+  */
+  entity_manager_ptr_->broadcastEntityTransform();
+  debug_marker_pub_->publish(entity_manager_ptr_->makeDebugMarker());
+  debug_marker_pub_->publish(traffic_controller_ptr_->makeDebugMarker());
+
+  /// @note Only the part of the round trip of the step that is not hidden by publishing the above.
+  const auto response = [&]() {
+    helper::ScopedPhaseTimer timer("StepRequest");
+    return step_response.get();
+  }();
+
+  if (!updateEntitiesStatusFromSim(response)) {
     return false;
   }
 
@@ -351,14 +435,59 @@ bool API::updateFrame()
     }
   }
 
-  entity_manager_ptr_->broadcastEntityTransform();
   clock_.update();
   clock_pub_->publish(clock_.getCurrentRosTimeAsMsg());
-  debug_marker_pub_->publish(entity_manager_ptr_->makeDebugMarker());
-  debug_marker_pub_->publish(traffic_controller_ptr_->makeDebugMarker());
+
+  if (const auto step_time = clock_.getStepTime();
+      not configuration.standalone_mode and step_time != step_time_in_sim_) {
+    step_request_.mutable_update_step_time()->set_simulation_step_time(step_time);
+    step_time_in_sim_ = step_time;
+  }
+
+  publishDiagnostics();
   return true;
 }
 
+auto API::publishDiagnostics() -> void
+{
+  if (const auto now = std::chrono::steady_clock::now();
+      diagnostics_published_time_ + std::chrono::seconds(1) <= now) {
+    diagnostics_published_time_ = now;
+
+    const auto achieved_realtime_factor = clock_.getAchievedRealtimeFactor();
+
+    diagnostic_msgs::msg::DiagnosticStatus status;
+    status.name = "traffic_simulator: real time factor";
+    /// @note Warns when the simulation falls behind the real time factor by more than 10 percent.
+    if (std::isnan(achieved_realtime_factor)) {
+      status.level = diagnostic_msgs::msg::DiagnosticStatus::STALE;
+      status.message = "Not measured yet";
+    } else if (achieved_realtime_factor < 0.9 * clock_.realtime_factor) {
+      status.level = diagnostic_msgs::msg::DiagnosticStatus::WARN;
+      status.message = "The simulation is slower than the real time factor";
+    } else {
+      status.level = diagnostic_msgs::msg::DiagnosticStatus::OK;
+      status.message = "OK";
+    }
+    const auto add = [&](const auto & key, const double value) {
+      diagnostic_msgs::msg::KeyValue key_value;
+      key_value.key = key;
+      key_value.value = std::to_string(value);
+      status.values.push_back(key_value);
+    };
+    add("target", clock_.realtime_factor);
+    add("achieved", achieved_realtime_factor);
+    add("step_scale", clock_.getStepScale());
+    add("step_time", clock_.getStepTime());
+
+    diagnostic_msgs::msg::DiagnosticArray diagnostics;
+    diagnostics.header.stamp = clock_.getCurrentRosTime();
+    diagnostics.status.push_back(status);
+    diagnostics.status.push_back(helper::makePhaseTimingStatus("traffic_simulator: frame phases"));
+    diagnostics_pub_->publish(diagnostics);
+  }
+}
+
 void API::startNpcLogic()
 {
   if (entity_manager_ptr_->isNpcLogicStarted()) {
@@ -415,7 +544,11 @@ auto API::addTrafficSource(
 
   traffic_controller_ptr_->addModule<traffic_simulator::traffic::TrafficSource>(
     radius, rate, pose, distribution, seed, getCurrentTime(), configuration,
-    entity_manager_ptr_->getHdmapUtils(), [this, speed](const auto & name, auto &&... xs) {
+    entity_manager_ptr_->getHdmapUtils(),
+    [this](const auto & point, const auto radius) {
+      return entity_manager_ptr_->getEntitiesNear(point, radius);
+    },
+    [this, speed](const auto & name, auto &&... xs) {
       this->spawn(name, std::forward<decltype(xs)>(xs)...);
       setLinearVelocity(name, speed);
     });
@@ -0,0 +1,81 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mutex>
+#include <pluginlib/class_loader.hpp>
+#include <string>
+#include <traffic_simulator/behavior/behavior_plugin_pool.hpp>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace entity_behavior
+{
+namespace
+{
+class BehaviorPluginPool : public std::enable_shared_from_this<BehaviorPluginPool>
+{
+public:
+  BehaviorPluginPool() : loader_("traffic_simulator", "entity_behavior::BehaviorPluginBase") {}
+
+  auto acquire(const std::string & plugin_name) -> std::shared_ptr<BehaviorPluginBase>
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pluginlib::UniquePtr<BehaviorPluginBase> plugin;
+    if (auto & idle_plugins = idle_plugins_[plugin_name]; idle_plugins.empty()) {
+      plugin = loader_.createUniqueInstance(plugin_name);
+    } else {
+      plugin = std::move(idle_plugins.back());
+      idle_plugins.pop_back();
+    }
+    const auto pointer = plugin.get();
+    used_plugins_.emplace(pointer, std::make_pair(plugin_name, std::move(plugin)));
+    /// @note The pool is kept alive by the plugins in use, so they never outlive the class loader.
+    return std::shared_ptr<BehaviorPluginBase>(
+      pointer, [pool = shared_from_this()](auto pointer) { pool->release(pointer); });
+  }
+
+private:
+  auto release(BehaviorPluginBase * pointer) -> void
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (const auto iter = used_plugins_.find(pointer); iter != used_plugins_.end()) {
+      auto [plugin_name, plugin] = std::move(iter->second);
+      used_plugins_.erase(iter);
+      if (plugin->recycle()) {
+        idle_plugins_[plugin_name].push_back(std::move(plugin));
+      }
+    }
+  }
+
+  std::mutex mutex_;
+
+  /// @note Declared before the plugins, so that it is destroyed after all of them.
+  pluginlib::ClassLoader<BehaviorPluginBase> loader_;
+
+  std::unordered_map<std::string, std::vector<pluginlib::UniquePtr<BehaviorPluginBase>>>
+    idle_plugins_;
+
+  std::unordered_map<
+    BehaviorPluginBase *, std::pair<std::string, pluginlib::UniquePtr<BehaviorPluginBase>>>
+    used_plugins_;
+};
+}  // namespace
+
+auto acquireBehaviorPlugin(const std::string & plugin_name) -> std::shared_ptr<BehaviorPluginBase>
+{
+  static const auto pool = std::make_shared<BehaviorPluginPool>();
+  return pool->acquire(plugin_name);
+}
+}  // namespace entity_behavior
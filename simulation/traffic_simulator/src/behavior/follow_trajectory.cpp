@@ -43,12 +43,127 @@ auto any(F f, T && x, Ts &&... xs)
   }
 }
 
+namespace
+{
+auto distanceAlongLanelet(
+  const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils,
+  const geometry_msgs::msg::Point & from,
+  const std::optional<traffic_simulator_msgs::msg::LaneletPose> & from_lanelet_pose,
+  const geometry_msgs::msg::Point & to,
+  const std::optional<traffic_simulator_msgs::msg::LaneletPose> & to_lanelet_pose) -> double
+{
+  if (from_lanelet_pose and to_lanelet_pose) {
+    if (const auto distance = hdmap_utils->getLongitudinalDistance(
+          from_lanelet_pose.value(), to_lanelet_pose.value());
+        distance) {
+      return distance.value();
+    }
+  }
+  return math::geometry::hypot(from, to);
+}
+}  // namespace
+
+PolylineTrajectorySamples::PolylineTrajectorySamples(
+  const traffic_simulator_msgs::msg::PolylineTrajectory & polyline_trajectory,
+  const traffic_simulator_msgs::msg::BoundingBox & bounding_box,
+  const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils, const double matching_distance)
+: closed(polyline_trajectory.closed), remaining(polyline_trajectory.shape.vertices.size())
+{
+  const auto & vertices = polyline_trajectory.shape.vertices;
+
+  for (const auto & vertex : vertices) {
+    positions.push_back(vertex.position.position);
+    lanelet_poses.push_back(
+      hdmap_utils->toLaneletPose(vertex.position.position, bounding_box, false, matching_distance));
+  }
+
+  /*
+     Only a closed trajectory comes back to its first vertex, otherwise the vertices after the last
+     one are never referenced and the map is not queried for them.
+  */
+  const auto size = closed ? 2 * vertices.size() : vertices.size();
+
+  cumulative_distances.resize(size, 0.0);
+  for (std::size_t index = 1; index < size; ++index) {
+    const auto from = (index - 1) % vertices.size(), to = index % vertices.size();
+    cumulative_distances[index] =
+      cumulative_distances[index - 1] +
+      (index < vertices.size() or from == vertices.size() - 1
+         ? distanceAlongLanelet(
+             hdmap_utils, positions[from], lanelet_poses[from], positions[to], lanelet_poses[to])
+         : cumulative_distances[index - vertices.size()] -
+             cumulative_distances[index - vertices.size() - 1]);
+  }
+
+  next_waypoint_with_arrival_time_specified.resize(size, size);
+  for (auto index = size; 0 < index--;) {
+    if (not std::isnan(vertices[index % vertices.size()].time)) {
+      next_waypoint_with_arrival_time_specified[index] = index;
+    } else if (index + 1 < size) {
+      next_waypoint_with_arrival_time_specified[index] =
+        next_waypoint_with_arrival_time_specified[index + 1];
+    }
+  }
+}
+
+auto PolylineTrajectorySamples::isSampling(
+  const traffic_simulator_msgs::msg::PolylineTrajectory & polyline_trajectory) const -> bool
+{
+  if (polyline_trajectory.closed != closed) {
+    return false;
+  } else if (polyline_trajectory.shape.vertices.size() != remaining) {
+    return false;
+  } else if (remaining == 0) {
+    return true;
+  } else {
+    const auto & front = polyline_trajectory.shape.vertices.front().position.position;
+    const auto & back = polyline_trajectory.shape.vertices.back().position.position;
+    const auto & sampled_front = positions[cursor];
+    const auto & sampled_back = positions[(cursor + remaining - 1) % positions.size()];
+    return front.x == sampled_front.x and front.y == sampled_front.y and
+           front.z == sampled_front.z and back.x == sampled_back.x and back.y == sampled_back.y and
+           back.z == sampled_back.z;
+  }
+}
+
+auto PolylineTrajectorySamples::getFrontLaneletPose() const
+  -> const std::optional<traffic_simulator_msgs::msg::LaneletPose> &
+{
+  return lanelet_poses.at(cursor);
+}
+
+auto PolylineTrajectorySamples::getDistanceTo(const std::size_t index) const -> double
+{
+  return cumulative_distances.at(cursor + index) - cumulative_distances.at(cursor);
+}
+
+auto PolylineTrajectorySamples::getIndexOfFirstWaypointWithArrivalTimeSpecified() const
+  -> std::size_t
+{
+  if (remaining == 0) {
+    return 0;
+  } else {
+    return std::min(next_waypoint_with_arrival_time_specified[cursor] - cursor, remaining);
+  }
+}
+
+auto PolylineTrajectorySamples::advance() -> void
+{
+  if (closed) {
+    cursor = (cursor + 1) % positions.size();
+  } else if (0 < remaining) {
+    ++cursor;
+    --remaining;
+  }
+}
+
 auto makeUpdatedStatus(
   const traffic_simulator_msgs::msg::EntityStatus & entity_status,
   traffic_simulator_msgs::msg::PolylineTrajectory & polyline_trajectory,
   const traffic_simulator_msgs::msg::BehaviorParameter & behavior_parameter,
   const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils, const double step_time,
-  double matching_distance, std::optional<double> target_speed) -> std::optional<EntityStatus>
+  double matching_distance, std::optional<double> target_speed,
+  PolylineTrajectorySamples * samples) -> std::optional<EntityStatus>
 {
   using math::arithmetic::isApproximatelyEqualTo;
   using math::arithmetic::isDefinitelyLessThan;
@@ -66,22 +181,32 @@ auto makeUpdatedStatus(
   using math::geometry::normalize;
   using math::geometry::truncate;
 
+  /*
+     Samples left over from another trajectory are not used, the distances are then computed from
+     the vertices every step.
+  */
+  if (samples and not samples->isSampling(polyline_trajectory)) {
+    samples = nullptr;
+  }
+
   auto distance_along_lanelet =
     [&](const geometry_msgs::msg::Point & from, const geometry_msgs::msg::Point & to) -> double {
-    if (const auto from_lanelet_pose =
-          hdmap_utils->toLaneletPose(from, entity_status.bounding_box, false, matching_distance);
-        from_lanelet_pose) {
-      if (const auto to_lanelet_pose =
-            hdmap_utils->toLaneletPose(to, entity_status.bounding_box, false, matching_distance);
-          to_lanelet_pose) {
-        if (const auto distance = hdmap_utils->getLongitudinalDistance(
-              from_lanelet_pose.value(), to_lanelet_pose.value());
-            distance) {
-          return distance.value();
-        }
-      }
+    return distanceAlongLanelet(
+      hdmap_utils, from,
+      hdmap_utils->toLaneletPose(from, entity_status.bounding_box, false, matching_distance), to,
+      hdmap_utils->toLaneletPose(to, entity_status.bounding_box, false, matching_distance));
+  };
+
+  auto distance_along_lanelet_to_front_waypoint =
+    [&](const geometry_msgs::msg::Point & from, const geometry_msgs::msg::Point & to) -> double {
+    if (samples) {
+      return distanceAlongLanelet(
+        hdmap_utils, from,
+        hdmap_utils->toLaneletPose(from, entity_status.bounding_box, false, matching_distance), to,
+        samples->getFrontLaneletPose());
+    } else {
+      return distance_along_lanelet(from, to);
     }
-    return hypot(from, to);
   };
 
   auto discard_the_front_waypoint_and_recurse = [&]() {
@@ -116,17 +241,27 @@ auto makeUpdatedStatus(
       polyline_trajectory.shape.vertices.pop_back();
     }
 
+    if (samples) {
+      samples->advance();
+    }
+
     return makeUpdatedStatus(
       entity_status, polyline_trajectory, behavior_parameter, hdmap_utils, step_time,
-      matching_distance, target_speed);
+      matching_distance, target_speed, samples);
   };
 
   auto is_infinity_or_nan = [](auto x) constexpr { return std::isinf(x) or std::isnan(x); };
 
   auto first_waypoint_with_arrival_time_specified = [&]() {
-    return std::find_if(
-      polyline_trajectory.shape.vertices.begin(), polyline_trajectory.shape.vertices.end(),
-      [](auto && vertex) { return not std::isnan(vertex.time); });
+    if (samples) {
+      return std::next(
+        polyline_trajectory.shape.vertices.begin(),
+        samples->getIndexOfFirstWaypointWithArrivalTimeSpecified());
+    } else {
+      return std::find_if(
+        polyline_trajectory.shape.vertices.begin(), polyline_trajectory.shape.vertices.end(),
+        [](auto && vertex) { return not std::isnan(vertex.time); });
+    }
   };
 
   auto is_breaking_waypoint = [&]() {
@@ -169,7 +304,7 @@ auto makeUpdatedStatus(
        problems.
     */
     const auto [distance_to_front_waypoint, remaining_time_to_front_waypoint] = std::make_tuple(
-      distance_along_lanelet(position, target_position),
+      distance_along_lanelet_to_front_waypoint(position, target_position),
       (not std::isnan(polyline_trajectory.base_time) ? polyline_trajectory.base_time : 0.0) +
         polyline_trajectory.shape.vertices.front().time - entity_status.time);
     /*
@@ -189,6 +324,10 @@ auto makeUpdatedStatus(
            inappropriate.
         */
         auto total_distance_to = [&](auto last) {
+          if (samples) {
+            return samples->getDistanceTo(
+              std::distance(std::begin(polyline_trajectory.shape.vertices), last));
+          }
           auto total_distance = 0.0;
           for (auto iter = std::begin(polyline_trajectory.shape.vertices);
                0 < std::distance(iter, last); ++iter) {
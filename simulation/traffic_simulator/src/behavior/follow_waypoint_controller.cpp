@@ -304,18 +304,47 @@ auto FollowWaypointController::getAcceleration(
 
   std::optional<double> best_acceleration = std::nullopt;
 
-  for (std::size_t i = 0; i <= number_of_acceleration_candidates; ++i) {
-    const double candidate_acceleration = local_min_acceleration + i * step_acceleration;
-
+  // Create a lambda for candidate selection
+  const auto considerCandidate = [&](double candidate_acceleration) -> std::optional<double> {
     if (const auto predicted_state_opt = getPredictedStopStateWithoutConsideringTime(
           candidate_acceleration, remaining_distance, acceleration, speed);
         predicted_state_opt) {
-      if (const auto distance_diff = remaining_distance - predicted_state_opt->traveled_distance;
-          (distance_diff >= 0 || min_distance_diff < 0) &&
-          (std::abs(distance_diff) < std::abs(min_distance_diff))) {
+      const auto distance_diff = remaining_distance - predicted_state_opt->traveled_distance;
+      if (
+        (distance_diff >= 0 || min_distance_diff < 0) &&
+        (std::abs(distance_diff) < std::abs(min_distance_diff))) {
         min_distance_diff = distance_diff;
         best_acceleration = candidate_acceleration;
       }
+      return distance_diff;
+    } else {
+      return std::nullopt;
+    }
+  };
+
+  if (use_bisection) {
+    /*
+       The stop distance grows with the candidate acceleration, so the range is halved toward the
+       highest candidate that stops before the waypoint. A candidate without a stop state travels
+       too far.
+    */
+    considerCandidate(local_min_acceleration);
+    considerCandidate(local_max_acceleration);
+    auto lower = local_min_acceleration;
+    auto upper = local_max_acceleration;
+    for (std::size_t i = 0; i < number_of_bisection_iterations && upper - lower > local_epsilon;
+         ++i) {
+      const double candidate_acceleration = (lower + upper) / 2.0;
+      if (const auto distance_diff = considerCandidate(candidate_acceleration);
+          distance_diff && distance_diff.value() >= 0) {
+        lower = candidate_acceleration;
+      } else {
+        upper = candidate_acceleration;
+      }
+    }
+  } else {
+    for (std::size_t i = 0; i <= number_of_acceleration_candidates; ++i) {
+      considerCandidate(local_min_acceleration + i * step_acceleration);
     }
   }
 
@@ -385,10 +414,10 @@ auto FollowWaypointController::getAcceleration(
 
     // Create a lambda for candidate selection
     std::optional<double> best_acceleration = std::nullopt;
-    const auto considerCandidate = [&](double candidate_acceleration) -> void {
-      if (
-        const auto predicted_state_opt = getPredictedWaypointArrivalState(
-          candidate_acceleration, remaining_time, remaining_distance, acceleration, speed)) {
+    const auto considerCandidate = [&](double candidate_acceleration) {
+      const auto predicted_state_opt = getPredictedWaypointArrivalState(
+        candidate_acceleration, remaining_time, remaining_distance, acceleration, speed);
+      if (predicted_state_opt) {
         const auto time_diff = remaining_time - predicted_state_opt->travel_time;
         const auto distance_diff = remaining_distance - predicted_state_opt->traveled_distance;
         if (isBetterCandidate(time_diff, distance_diff)) {
@@ -397,6 +426,7 @@ auto FollowWaypointController::getAcceleration(
           best_acceleration = candidate_acceleration;
         }
       }
+      return predicted_state_opt;
     };
 
     // Consider the borderline values and precise value of 0
@@ -415,9 +445,40 @@ auto FollowWaypointController::getAcceleration(
        step_time) is met however, at the moment this change affects other
        behaviors - this requires further investigation.
     */
-    if (const double step_acceleration =
-          (local_max_acceleration - local_min_acceleration) / number_of_acceleration_candidates;
-        step_acceleration > local_epsilon) {
+    if (use_bisection) {
+      /*
+         The predicted arrival time decreases as the candidate acceleration increases, so the range
+         is halved toward the candidate arriving at the remaining time, and among the candidates
+         arriving at the same time, toward the one stopping closest before the waypoint. A
+         candidate without an arrival state is either too slow to move or too fast to stop.
+      */
+      auto lower = local_min_acceleration;
+      auto upper = local_max_acceleration;
+      for (std::size_t i = 0; i < number_of_bisection_iterations && upper - lower > local_epsilon;
+           ++i) {
+        const double candidate_acceleration = (lower + upper) / 2.0;
+        if (const auto predicted_state_opt = considerCandidate(candidate_acceleration)) {
+          const auto time_diff = remaining_time - predicted_state_opt->travel_time;
+          if (
+            std::abs(time_diff) < local_epsilon
+              ? remaining_distance - predicted_state_opt->traveled_distance >= 0
+              : time_diff < 0) {
+            lower = candidate_acceleration;
+          } else {
+            upper = candidate_acceleration;
+          }
+        } else if (
+          speed + clampAcceleration(candidate_acceleration, acceleration, speed) * step_time <=
+          local_epsilon) {
+          lower = candidate_acceleration;
+        } else {
+          upper = candidate_acceleration;
+        }
+      }
+    } else if (const double step_acceleration =
+                 (local_max_acceleration - local_min_acceleration) /
+                 number_of_acceleration_candidates;
+               step_acceleration > local_epsilon) {
       for (std::size_t i = 1; i < number_of_acceleration_candidates; ++i) {
         considerCandidate(local_min_acceleration + i * step_acceleration);
       }
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <cmath>
 #include <geometry/vector3/operator.hpp>
 #include <iostream>
 #include <rclcpp/rclcpp.hpp>
@@ -120,6 +121,10 @@ auto LongitudinalSpeedPlanner::getRunningDistance(
   if (isTargetSpeedReached(target_speed, current_twist, twist_tolerance)) {
     return 0;
   }
+  if (const auto distance = getRunningDistanceInClosedForm(
+        target_speed, constraints, current_twist, current_accel, twist_tolerance)) {
+    return distance.value();
+  }
   double ret = 0;
   std::tuple<geometry_msgs::msg::Twist, geometry_msgs::msg::Accel, double> next_state =
     std::make_tuple(current_twist, current_accel, current_linear_jerk);
@@ -133,6 +138,99 @@ auto LongitudinalSpeedPlanner::getRunningDistance(
   return ret;
 }
 
+auto LongitudinalSpeedPlanner::getRunningDistanceInClosedForm(
+  double target_speed, const traffic_simulator_msgs::msg::DynamicConstraints & constraints,
+  const geometry_msgs::msg::Twist & current_twist, const geometry_msgs::msg::Accel & current_accel,
+  double tolerance) const -> std::optional<double>
+{
+  /// @note Mirrored when decelerating, so that the speed always increases toward the target.
+  const bool accelerating = isAccelerating(target_speed, current_twist);
+  const double sign = accelerating ? 1.0 : -1.0;
+  const double max_accel =
+    accelerating ? constraints.max_acceleration : constraints.max_deceleration;
+  const double accel_step =
+    step_time *
+    (accelerating ? constraints.max_acceleration_rate : constraints.max_deceleration_rate);
+  /// @note Otherwise the speed is clamped by max_speed or never reaches the target.
+  if (
+    not(step_time > 0 and max_accel > 0 and accel_step > 0) or
+    std::abs(target_speed) > constraints.max_speed or
+    std::abs(current_twist.linear.x) > constraints.max_speed) {
+    return std::nullopt;
+  }
+
+  /// @note The first step is simulated, it brings the acceleration into [0, max_accel].
+  const auto [first_twist, first_accel, first_jerk] =
+    getDynamicStates(target_speed, constraints, current_twist, current_accel);
+  if (isTargetSpeedReached(target_speed, first_twist, tolerance)) {
+    return first_twist.linear.x * step_time +
+           first_accel.linear.x * step_time * step_time / 2.0 +
+           first_jerk * step_time * step_time * step_time / 6.0;
+  }
+
+  const double v0 = sign * current_twist.linear.x;
+  const double a0 = sign * current_accel.linear.x;
+  const double v1 = sign * first_twist.linear.x;
+  const double a1 = std::min(sign * first_accel.linear.x, max_accel);
+  const double vt = sign * target_speed;
+
+  /**
+   * @note Step counts are held in double, they are integral values.
+   * The acceleration of the m-th step after the first one, before being cut by the target speed, is
+   * min(a1 + m * accel_step, max_accel). It is below max_accel for the first ramp_steps steps.
+   */
+  const double ramp_steps = std::max(0.0, std::ceil((max_accel - a1) / accel_step) - 1.0);
+  /// @note Sum of the accelerations of the first m steps after the first one.
+  const auto accel_sum = [&](const double m) {
+    if (m <= ramp_steps) {
+      return m * a1 + accel_step * m * (m + 1) / 2.0;
+    } else {
+      return ramp_steps * a1 + accel_step * ramp_steps * (ramp_steps + 1) / 2.0 +
+             (m - ramp_steps) * max_accel;
+    }
+  };
+  /// @note Sum of accel_sum(0) ... accel_sum(m).
+  const auto accel_sum_sum = [&](const double m) {
+    const auto ramp = [&](const double n) {
+      return a1 * n * (n + 1) / 2.0 + accel_step * n * (n + 1) * (n + 2) / 6.0;
+    };
+    if (m <= ramp_steps) {
+      return ramp(m);
+    } else {
+      return ramp(ramp_steps) + (m - ramp_steps) * accel_sum(ramp_steps) +
+             max_accel * (m - ramp_steps) * (m - ramp_steps + 1) / 2.0;
+    }
+  };
+
+  /// @note The target speed is reached at the first step after m steps with accel_sum(m) >= goal.
+  const double goal = (vt - v1 - tolerance) / step_time;
+  double m = 1.0;
+  if (accel_sum(ramp_steps) >= goal) {
+    const double b = a1 + accel_step / 2.0;
+    m = std::ceil((-b + std::sqrt(b * b + 2.0 * accel_step * goal)) / accel_step);
+  } else {
+    m = ramp_steps + std::ceil((goal - accel_sum(ramp_steps)) / max_accel);
+  }
+  /// @note Corrects the rounding errors of the closed form solutions above.
+  for (m = std::max(m, 1.0); m > 1.0 and accel_sum(m - 1.0) >= goal;) {
+    m -= 1.0;
+  }
+  while (accel_sum(m) < goal) {
+    m += 1.0;
+  }
+
+  /// @note The last step is cut so that the target speed is not exceeded.
+  const double last_speed = std::min(v1 + step_time * accel_sum(m), vt);
+  const double last_accel = (last_speed - (v1 + step_time * accel_sum(m - 1.0))) / step_time;
+  /**
+   * @note Same terms as getRunningDistance summed over all steps. The acceleration and jerk terms
+   * telescope, the speed term is the sum of the speeds of the steps.
+   */
+  const double speed_sum = m * v1 + step_time * accel_sum_sum(m - 1.0) + last_speed;
+  return sign * (step_time * speed_sum + step_time * (last_speed - v0) / 2.0 +
+                 step_time * step_time * (last_accel - a0) / 6.0);
+}
+
 auto LongitudinalSpeedPlanner::isTargetSpeedReached(
   double target_speed, const geometry_msgs::msg::Twist & current_twist,
   double tolerance) const noexcept -> bool
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <scenario_simulator_exception/exception.hpp>
 #include <traffic_simulator/behavior/route_planner.hpp>
 
 namespace traffic_simulator
@@ -41,21 +42,57 @@ auto RoutePlanner::getRouteLanelets(
   // If the route from the entity_lanelet_pose to waypoint_queue_.front() was failed to calculate in updateRoute function,
   // use following lanelet as route.
   if (!route_) {
-    return hdmap_utils_ptr_->getFollowingLanelets(lanelet_pose.lanelet_id, horizon, true);
+    return getFollowingLanelets(lanelet_pose.lanelet_id, horizon, false);
   }
   if (route_ && hdmap_utils_ptr_->isInRoute(lanelet_pose.lanelet_id, route_.value())) {
-    return hdmap_utils_ptr_->getFollowingLanelets(
-      lanelet_pose.lanelet_id, route_.value(), horizon, true);
+    return getFollowingLanelets(lanelet_pose.lanelet_id, horizon, true);
   }
   // If the entity_lanelet_pose is in the lanelet id of the waypoint queue, cancel the target waypoint.
   cancelWaypoint(entity_lanelet_pose);
-  return hdmap_utils_ptr_->getFollowingLanelets(lanelet_pose.lanelet_id, horizon, true);
+  return getFollowingLanelets(lanelet_pose.lanelet_id, horizon, false);
+}
+
+auto RoutePlanner::getRouteSpline() -> std::shared_ptr<math::geometry::CatmullRomSpline>
+{
+  if (not route_window_) {
+    return nullptr;
+  }
+  if (not route_window_->spline) {
+    try {
+      route_window_->spline = hdmap_utils_ptr_->getCenterPointsSpline(route_window_->lanelet_ids);
+    } catch (const common::scenario_simulator_exception::SemanticError &) {
+      route_window_->spline = nullptr;
+    }
+  }
+  return route_window_->spline.value();
+}
+
+auto RoutePlanner::getFollowingLanelets(
+  const lanelet::Id lanelet_id, const double horizon, const bool in_route) -> lanelet::Ids
+{
+  if (
+    not route_window_ or route_window_->lanelet_id != lanelet_id or
+    route_window_->horizon != horizon or route_window_->in_route != in_route or
+    (in_route and route_window_->route_version != route_version_)) {
+    route_window_ = RouteWindow{
+      lanelet_id, horizon, in_route, route_version_,
+      in_route ? hdmap_utils_ptr_->getFollowingLanelets(lanelet_id, route_.value(), horizon, true)
+               : hdmap_utils_ptr_->getFollowingLanelets(lanelet_id, horizon, true),
+      std::nullopt};
+  }
+  return route_window_->lanelet_ids;
 }
 
 void RoutePlanner::cancelRoute()
 {
   waypoint_queue_.clear();
-  route_ = std::nullopt;
+  setRoute(std::nullopt);
+}
+
+auto RoutePlanner::setRoute(const std::optional<lanelet::Ids> & route) -> void
+{
+  route_ = route;
+  ++route_version_;
 }
 
 void RoutePlanner::cancelWaypoint(const CanonicalizedLaneletPose & entity_lanelet_pose)
@@ -103,15 +140,15 @@ auto RoutePlanner::updateRoute(const CanonicalizedLaneletPose & entity_lanelet_p
   }
   const auto lanelet_pose = static_cast<LaneletPose>(entity_lanelet_pose);
   if (!route_) {
-    route_ = hdmap_utils_ptr_->getRoute(
-      lanelet_pose.lanelet_id, static_cast<LaneletPose>(waypoint_queue_.front()).lanelet_id);
+    setRoute(hdmap_utils_ptr_->getRoute(
+      lanelet_pose.lanelet_id, static_cast<LaneletPose>(waypoint_queue_.front()).lanelet_id));
     return;
   }
   if (hdmap_utils_ptr_->isInRoute(lanelet_pose.lanelet_id, route_.value())) {
     return;
   } else {
-    route_ = hdmap_utils_ptr_->getRoute(
-      lanelet_pose.lanelet_id, static_cast<LaneletPose>(waypoint_queue_.front()).lanelet_id);
+    setRoute(hdmap_utils_ptr_->getRoute(
+      lanelet_pose.lanelet_id, static_cast<LaneletPose>(waypoint_queue_.front()).lanelet_id));
     return;
   }
 }
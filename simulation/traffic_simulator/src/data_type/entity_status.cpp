@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cmath>
 #include <traffic_simulator/data_type/entity_status.hpp>
 #include <traffic_simulator/data_type/lanelet_pose.hpp>
 
@@ -19,6 +20,39 @@ namespace traffic_simulator
 {
 namespace entity_status
 {
+namespace
+{
+/*
+   The lanelets an entity was matched to in the previous frame are a cursor for matching it again:
+   entities move continuously, so they are tried first, then the lanelets the entity can move into
+   from them, before searching the whole map.
+*/
+auto matchToLaneCursor(
+  const geometry_msgs::msg::Pose & map_pose, const lanelet::Ids & lanelet_ids,
+  const traffic_simulator_msgs::msg::EntityType & type, const double matching_distance,
+  const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils_ptr) -> std::optional<LaneletPose>
+{
+  if (lanelet_ids.empty()) {
+    return std::nullopt;
+  } else if (const auto lanelet_pose =
+               hdmap_utils_ptr->toLaneletPose(map_pose, lanelet_ids, matching_distance)) {
+    return lanelet_pose;
+  } else {
+    /// @note Branching lanelets overlap where they begin, so the closest centerline is preferred.
+    std::optional<LaneletPose> closest_lanelet_pose;
+    for (const auto & lanelet_id : hdmap_utils_ptr->getAdjacentLaneletIds(lanelet_ids, type)) {
+      if (const auto lanelet_pose =
+            hdmap_utils_ptr->toLaneletPose(map_pose, lanelet_id, matching_distance);
+          lanelet_pose and
+          (not closest_lanelet_pose or
+           std::abs(lanelet_pose->offset) < std::abs(closest_lanelet_pose->offset))) {
+        closest_lanelet_pose = lanelet_pose;
+      }
+    }
+    return closest_lanelet_pose;
+  }
+}
+}  // namespace
 
 CanonicalizedEntityStatus::CanonicalizedEntityStatus(
   const EntityStatus & may_non_canonicalized_entity_status,
@@ -59,7 +93,15 @@ auto CanonicalizedEntityStatus::set(const CanonicalizedEntityStatus & status) ->
   assert(getSubtype() == status.getSubtype());
   assert(getName() == status.getName());
   assert(getBoundingBox() == status.getBoundingBox());
-  entity_status_ = status.entity_status_;
+  /*
+     The name, type, subtype and bounding box of an entity do not change, so
+     only the state of the frame is copied, not the whole message.
+  */
+  entity_status_.time = status.entity_status_.time;
+  entity_status_.pose = status.entity_status_.pose;
+  entity_status_.action_status = status.entity_status_.action_status;
+  entity_status_.lanelet_pose = status.entity_status_.lanelet_pose;
+  entity_status_.lanelet_pose_valid = status.entity_status_.lanelet_pose_valid;
   canonicalized_lanelet_pose_ = status.canonicalized_lanelet_pose_;
 }
 
@@ -74,11 +116,13 @@ auto CanonicalizedEntityStatus::set(
   std::optional<CanonicalizedLaneletPose> canonicalized_lanelet_pose;
   if (status.lanelet_pose_valid) {
     canonicalized_lanelet_pose = pose::canonicalize(status.lanelet_pose, hdmap_utils_ptr);
+  } else if (
+    const auto lanelet_pose =
+      matchToLaneCursor(status.pose, lanelet_ids, getType(), matching_distance, hdmap_utils_ptr)) {
+    canonicalized_lanelet_pose = pose::canonicalize(lanelet_pose.value(), hdmap_utils_ptr);
   } else {
-    // prefer the current lanelet
     canonicalized_lanelet_pose = pose::toCanonicalizedLaneletPose(
-      status.pose, getBoundingBox(), lanelet_ids, include_crosswalk, matching_distance,
-      hdmap_utils_ptr);
+      status.pose, getBoundingBox(), include_crosswalk, matching_distance, hdmap_utils_ptr);
   }
   set(CanonicalizedEntityStatus(status, canonicalized_lanelet_pose));
 }
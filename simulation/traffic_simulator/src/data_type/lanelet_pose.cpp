@@ -27,46 +27,51 @@ namespace lanelet_pose
 CanonicalizedLaneletPose::CanonicalizedLaneletPose(
   const LaneletPose & maybe_non_canonicalized_lanelet_pose,
   const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils)
-: lanelet_pose_(canonicalize(maybe_non_canonicalized_lanelet_pose, hdmap_utils)),
-  lanelet_poses_(
-    hdmap_utils->getAllCanonicalizedLaneletPoses(maybe_non_canonicalized_lanelet_pose)),
-  map_pose_(pose::toMapPose(lanelet_pose_, hdmap_utils))
+: lanelet_pose_(canonicalize(maybe_non_canonicalized_lanelet_pose, hdmap_utils))
 {
-  adjustOrientationAndOzPosition(hdmap_utils);
+  derive(maybe_non_canonicalized_lanelet_pose, hdmap_utils);
 }
 
 CanonicalizedLaneletPose::CanonicalizedLaneletPose(
   const LaneletPose & maybe_non_canonicalized_lanelet_pose, const lanelet::Ids & route_lanelets,
   const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils)
-: lanelet_pose_(canonicalize(maybe_non_canonicalized_lanelet_pose, route_lanelets, hdmap_utils)),
-  lanelet_poses_(
-    hdmap_utils->getAllCanonicalizedLaneletPoses(maybe_non_canonicalized_lanelet_pose)),
-  map_pose_(pose::toMapPose(lanelet_pose_, hdmap_utils))
+: lanelet_pose_(canonicalize(maybe_non_canonicalized_lanelet_pose, route_lanelets, hdmap_utils))
 {
-  adjustOrientationAndOzPosition(hdmap_utils);
+  derive(maybe_non_canonicalized_lanelet_pose, hdmap_utils);
 }
 
-CanonicalizedLaneletPose::CanonicalizedLaneletPose(const CanonicalizedLaneletPose & other)
-: lanelet_pose_(other.lanelet_pose_),
-  lanelet_poses_(other.lanelet_poses_),
-  map_pose_(other.map_pose_)
+auto CanonicalizedLaneletPose::derive(
+  const LaneletPose & maybe_non_canonicalized_lanelet_pose,
+  const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils) -> void
 {
+  derived_ = std::make_shared<Derived>(hdmap_utils, maybe_non_canonicalized_lanelet_pose);
+  if (consider_pose_by_road_slope_) {
+    std::call_once(derived_->map_pose_flag, [this]() {
+      derived_->map_pose = pose::toMapPose(lanelet_pose_, derived_->hdmap_utils);
+      adjustOrientationAndOzPosition(derived_->map_pose, lanelet_pose_, derived_->hdmap_utils);
+    });
+  }
 }
 
-CanonicalizedLaneletPose::CanonicalizedLaneletPose(CanonicalizedLaneletPose && other) noexcept
-: lanelet_pose_(std::move(other.lanelet_pose_)),
-  lanelet_poses_(std::move(other.lanelet_poses_)),
-  map_pose_(std::move(other.map_pose_))
+auto CanonicalizedLaneletPose::getMapPose() const -> const geometry_msgs::msg::Pose &
 {
+  std::call_once(derived_->map_pose_flag, [this]() {
+    /// @note Only with the road slope considered does the rpy of the lanelet pose depend on it.
+    auto lanelet_pose = lanelet_pose_;
+    derived_->map_pose = pose::toMapPose(lanelet_pose, derived_->hdmap_utils);
+    adjustOrientationAndOzPosition(derived_->map_pose, lanelet_pose, derived_->hdmap_utils);
+  });
+  return derived_->map_pose;
 }
 
-auto CanonicalizedLaneletPose::operator=(const CanonicalizedLaneletPose & other)
-  -> CanonicalizedLaneletPose &
+auto CanonicalizedLaneletPose::getAlternativeLaneletPoses() const
+  -> const std::vector<LaneletPose> &
 {
-  this->lanelet_pose_ = other.lanelet_pose_;
-  this->lanelet_poses_ = other.lanelet_poses_;
-  this->map_pose_ = other.map_pose_;
-  return *this;
+  std::call_once(derived_->lanelet_poses_flag, [this]() {
+    derived_->lanelet_poses = derived_->hdmap_utils->getAllCanonicalizedLaneletPoses(
+      derived_->maybe_non_canonicalized_lanelet_pose);
+  });
+  return derived_->lanelet_poses;
 }
 
 auto CanonicalizedLaneletPose::canonicalize(
@@ -109,17 +114,39 @@ auto CanonicalizedLaneletPose::canonicalize(
   }
 }
 
+auto CanonicalizedLaneletPose::moveAlongLanelet(
+  const double distance, const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils) const
+  -> std::optional<CanonicalizedLaneletPose>
+{
+  /// @note A pose shared by overlapping lanelets is left to the canonicalization of the caller.
+  if (const auto s = lanelet_pose_.s + distance;
+      getAlternativeLaneletPoses().size() <= 1 and 0.0 <= s and
+      s <= hdmap_utils->getLaneletLength(lanelet_pose_.lanelet_id)) {
+    auto moved = *this;
+    moved.lanelet_pose_.s = s;
+    moved.derive(moved.lanelet_pose_, hdmap_utils);
+    /// @note The moved pose lies on its lanelet alone, as this pose does.
+    std::call_once(moved.derived_->lanelet_poses_flag, [&]() {
+      moved.derived_->lanelet_poses = {moved.lanelet_pose_};
+    });
+    return moved;
+  } else {
+    return std::nullopt;
+  }
+}
+
 auto CanonicalizedLaneletPose::getAlternativeLaneletPoseBaseOnShortestRouteFrom(
   LaneletPose from, const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils,
   bool allow_lane_change) const -> std::optional<LaneletPose>
 {
-  if (lanelet_poses_.empty()) {
+  const auto & lanelet_poses = getAlternativeLaneletPoses();
+  if (lanelet_poses.empty()) {
     return std::nullopt;
   }
   lanelet::Ids shortest_route =
-    hdmap_utils->getRoute(from.lanelet_id, lanelet_poses_[0].lanelet_id);
-  LaneletPose alternative_lanelet_pose = lanelet_poses_[0];
-  for (const auto & laneletPose : lanelet_poses_) {
+    hdmap_utils->getRoute(from.lanelet_id, lanelet_poses[0].lanelet_id);
+  LaneletPose alternative_lanelet_pose = lanelet_poses[0];
+  for (const auto & laneletPose : lanelet_poses) {
     const auto route =
       hdmap_utils->getRoute(from.lanelet_id, laneletPose.lanelet_id, allow_lane_change);
     if (shortest_route.size() > route.size()) {
@@ -131,29 +158,46 @@ auto CanonicalizedLaneletPose::getAlternativeLaneletPoseBaseOnShortestRouteFrom(
 }
 
 auto CanonicalizedLaneletPose::adjustOrientationAndOzPosition(
+  geometry_msgs::msg::Pose & map_pose, LaneletPose & lanelet_pose,
   const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils) -> void
 {
   using math::geometry::convertEulerAngleToQuaternion;
   using math::geometry::convertQuaternionToEulerAngle;
   using math::geometry::getRotation;
-  const math::geometry::CatmullRomSpline spline(
-    hdmap_utils->getCenterPoints(lanelet_pose_.lanelet_id));
-  // adjust Oz position
-  if (const auto s_value = spline.getSValue(map_pose_)) {
-    map_pose_.position.z = spline.getPoint(s_value.value()).z;
-  }
-  // adjust pitch
-  if (consider_pose_by_road_slope_) {
-    const auto lanelet_quaternion = spline.getPose(lanelet_pose_.s, true).orientation;
+  const auto adjust_pitch = [&](const geometry_msgs::msg::Quaternion & lanelet_quaternion) {
     const auto lanelet_rpy = convertQuaternionToEulerAngle(lanelet_quaternion);
-    const auto entity_rpy = convertQuaternionToEulerAngle(map_pose_.orientation);
-    map_pose_.orientation =
+    const auto entity_rpy = convertQuaternionToEulerAngle(map_pose.orientation);
+    map_pose.orientation =
       convertEulerAngleToQuaternion(geometry_msgs::build<geometry_msgs::msg::Vector3>()
                                       .x(entity_rpy.x)
                                       .y(lanelet_rpy.y)
                                       .z(entity_rpy.z));
-    lanelet_pose_.rpy =
-      convertQuaternionToEulerAngle(getRotation(lanelet_quaternion, map_pose_.orientation));
+    lanelet_pose.rpy =
+      convertQuaternionToEulerAngle(getRotation(lanelet_quaternion, map_pose.orientation));
+  };
+  if (use_elevation_profile_) {
+    const auto elevation =
+      hdmap_utils->getElevationProfile(lanelet_pose.lanelet_id)->at(lanelet_pose.s);
+    // adjust Oz position
+    map_pose.position.z = elevation.z;
+    // adjust pitch
+    if (consider_pose_by_road_slope_) {
+      adjust_pitch(convertEulerAngleToQuaternion(geometry_msgs::build<geometry_msgs::msg::Vector3>()
+                                                   .x(0.0)
+                                                   .y(elevation.pitch)
+                                                   .z(elevation.yaw)));
+    }
+  } else {
+    /// @note The spline of the centerline is cached by HdMapUtils, instead of being built per pose.
+    const auto & spline = *hdmap_utils->getCenterPointsSpline(lanelet_pose.lanelet_id);
+    // adjust Oz position
+    if (const auto s_value = spline.getSValue(map_pose)) {
+      map_pose.position.z = spline.getPoint(s_value.value()).z;
+    }
+    // adjust pitch
+    if (consider_pose_by_road_slope_) {
+      adjust_pitch(spline.getPose(lanelet_pose.s, true).orientation);
+    }
   }
 }
 
@@ -154,7 +154,8 @@ void EgoEntity::onUpdate(double current_time, double step_time)
           static_cast<traffic_simulator::EntityStatus>(*status_), *polyline_trajectory_,
           behavior_parameter_, hdmap_utils_ptr_, step_time,
           getDefaultMatchingDistanceForLaneletPoseCalculation(),
-          target_speed_ ? target_speed_.value() : status_->getTwist().linear.x)) {
+          target_speed_ ? target_speed_.value() : status_->getTwist().linear.x,
+          polyline_trajectory_samples_ ? &polyline_trajectory_samples_.value() : nullptr)) {
       // prefer current lanelet on ss2 side
       setStatus(non_canonicalized_updated_status.value(), status_->getLaneletIds());
     } else {
@@ -220,6 +221,9 @@ auto EgoEntity::requestFollowTrajectory(
   const std::shared_ptr<traffic_simulator_msgs::msg::PolylineTrajectory> & parameter) -> void
 {
   polyline_trajectory_ = parameter;
+  polyline_trajectory_samples_.emplace(
+    *parameter, status_->getBoundingBox(), hdmap_utils_ptr_,
+    getDefaultMatchingDistanceForLaneletPoseCalculation());
   VehicleEntity::requestFollowTrajectory(parameter);
   is_controlled_by_simulator_ = true;
 }
@@ -82,6 +82,17 @@ auto EntityBase::get2DPolygon() const -> std::vector<geometry_msgs::msg::Point>
   return math::geometry::toPolygon2D(getBoundingBox());
 }
 
+auto EntityBase::getOrientedBoundingBox() const -> const math::geometry::OrientedBoundingBox &
+{
+  /// @note The bounding box of an entity does not change, so the pose alone tells it is outdated.
+  if (const auto & pose = getMapPose();
+      not oriented_bounding_box_ or oriented_bounding_box_->first != pose) {
+    oriented_bounding_box_.emplace(
+      pose, math::geometry::OrientedBoundingBox(pose, getBoundingBox()));
+  }
+  return oriented_bounding_box_->second;
+}
+
 auto EntityBase::getCanonicalizedLaneletPose() const -> std::optional<CanonicalizedLaneletPose>
 {
   return status_->getCanonicalizedLaneletPose();
@@ -533,10 +544,15 @@ void EntityBase::setDynamicConstraints(
 }
 
 void EntityBase::setOtherStatus(
-  const std::unordered_map<std::string, CanonicalizedEntityStatus> & status)
+  const std::shared_ptr<const OtherEntityStatus::Map> & status,
+  const std::shared_ptr<const OtherEntityStatus::LaneletOccupancy> & lanelet_occupancy)
+{
+  other_status_ = OtherEntityStatus(status, name, lanelet_occupancy);
+}
+
+void EntityBase::setOtherStatus(const OtherEntityStatus::Map & status)
 {
-  other_status_ = status;
-  other_status_.erase(name);
+  setOtherStatus(std::make_shared<const OtherEntityStatus::Map>(status));
 }
 
 auto EntityBase::setStatus(const EntityStatus & status, const lanelet::Ids & lanelet_ids) -> void
@@ -648,6 +664,11 @@ void EntityBase::updateEntityStatusTimestamp(const double current_time)
   status_->setTime(current_time);
 }
 
+auto EntityBase::updateStateHistory(const double current_time) -> void
+{
+  state_history_.push(current_time, *status_);
+}
+
 bool EntityBase::reachPosition(const std::string & target_name, const double tolerance) const
 {
   return reachPosition(other_status_.find(target_name)->second.getMapPose(), tolerance);
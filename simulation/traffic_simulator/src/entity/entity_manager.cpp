@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <geometry/bounding_box.hpp>
 #include <geometry/distance.hpp>
@@ -19,18 +21,26 @@
 #include <geometry/transform.hpp>
 #include <geometry/vector3/operator.hpp>
 #include <limits>
+#include <map>
 #include <memory>
 #include <optional>
 #include <queue>
 #include <scenario_simulator_exception/exception.hpp>
 #include <sstream>
+#include <status_monitor/trace.hpp>
 #include <stdexcept>
 #include <string>
+#include <traffic_simulator/behavior/behavior_plugin_base.hpp>
 #include <traffic_simulator/entity/entity_manager.hpp>
 #include <traffic_simulator/helper/helper.hpp>
+#include <traffic_simulator/helper/phase_timer.hpp>
 #include <traffic_simulator/helper/stop_watch.hpp>
 #include <traffic_simulator/utils/distance.hpp>
+#include <tuple>
+#include <typeindex>
+#include <typeinfo>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace traffic_simulator
@@ -39,77 +49,79 @@ namespace entity
 {
 void EntityManager::broadcastEntityTransform()
 {
-  static bool is_send = false;
-  static geometry_msgs::msg::Pose pose;
-
-  using math::geometry::operator/;
   using math::geometry::operator*;
   using math::geometry::operator+=;
-  std::vector<std::string> names = getEntityNames();
   /**
    * @note This part of the process is intended to ensure that frames are issued in a position that makes
    * it as easy as possible to see the entities that will appear in the scenario.
    * In the past, we used to publish the frames of all entities, but that would be too heavy processing,
    * so we publish the average of the coordinates of all entities.
    */
-  if (isEgoSpawned()) {
-    if (const auto ego = getEntity(getEgoName())) {
-      if (!is_send) {
-        pose = ego->getMapPose();
-        is_send = true;
+  if (not entity_frame_pose_) {
+    if (isEgoSpawned()) {
+      entity_frame_pose_ = getEntity(getEgoName())->getMapPose();
+    } else if (not entities_.empty()) {
+      geometry_msgs::msg::Point position;
+      for (const auto & [name, entity] : entities_) {
+        position += entity->getMapPose().position * (1.0 / static_cast<double>(entities_.size()));
       }
-      broadcastTransform(
-        geometry_msgs::build<geometry_msgs::msg::PoseStamped>()
-          /**
-           * @note This is the intended implementation.
-           * It is easier to create rviz config if the name "ego" is fixed,
-           * so the frame_id "ego" is issued regardless of the name of the ego entity.
-           */
-          .header(std_msgs::build<std_msgs::msg::Header>().stamp(clock_ptr_->now()).frame_id("ego"))
-          .pose(pose),
-        true);
+      entity_frame_pose_ = geometry_msgs::build<geometry_msgs::msg::Pose>()
+                             .position(position)
+                             .orientation(geometry_msgs::msg::Quaternion());
     }
   }
-  if (!names.empty()) {
-    if (!is_send) {
-      pose = geometry_msgs::build<geometry_msgs::msg::Pose>()
-               .position(std::accumulate(
-                 names.begin(), names.end(), geometry_msgs::msg::Point(),
-                 [this, names](geometry_msgs::msg::Point point, const std::string & name) {
-                   point += getEntity(name)->getMapPose().position *
-                            (1.0 / static_cast<double>(names.size()));
-                   return point;
-                 }))
-               .orientation(geometry_msgs::msg::Quaternion());
-      is_send = true;
+  /**
+   * @note The pose is fixed once computed and static transforms are latched, so each frame is sent
+   * only once, and all frames appearing in the same update are sent in one message.
+   */
+  std::vector<geometry_msgs::msg::TransformStamped> transforms;
+  const auto stamp = clock_ptr_->now();
+  const auto append = [&](const std::string & frame_id) {
+    if (not broadcast_frame_ids_.count(frame_id)) {
+      transforms.push_back(makeTransform(
+        geometry_msgs::build<geometry_msgs::msg::PoseStamped>()
+          .header(std_msgs::build<std_msgs::msg::Header>().stamp(stamp).frame_id(frame_id))
+          .pose(entity_frame_pose_.value())));
+      broadcast_frame_ids_.insert(frame_id);
     }
-    broadcastTransform(
-      geometry_msgs::build<geometry_msgs::msg::PoseStamped>()
-        .header(
-          std_msgs::build<std_msgs::msg::Header>().stamp(clock_ptr_->now()).frame_id("entities"))
-        .pose(pose),
-      true);
+  };
+  if (isEgoSpawned()) {
+    /**
+     * @note This is the intended implementation.
+     * It is easier to create rviz config if the name "ego" is fixed,
+     * so the frame_id "ego" is issued regardless of the name of the ego entity.
+     */
+    append("ego");
+  }
+  if (not entities_.empty()) {
+    append("entities");
+  }
+  if (not transforms.empty()) {
+    broadcaster_.sendTransform(transforms);
   }
 }
 
-void EntityManager::broadcastTransform(
-  const geometry_msgs::msg::PoseStamped & pose, const bool static_transform)
+auto EntityManager::makeTransform(const geometry_msgs::msg::PoseStamped & pose)
+  -> geometry_msgs::msg::TransformStamped
 {
   geometry_msgs::msg::TransformStamped transform_stamped;
-  {
-    transform_stamped.header.stamp = pose.header.stamp;
-    transform_stamped.header.frame_id = "map";
-    transform_stamped.child_frame_id = pose.header.frame_id;
-    transform_stamped.transform.translation.x = pose.pose.position.x;
-    transform_stamped.transform.translation.y = pose.pose.position.y;
-    transform_stamped.transform.translation.z = pose.pose.position.z;
-    transform_stamped.transform.rotation = pose.pose.orientation;
-  }
+  transform_stamped.header.stamp = pose.header.stamp;
+  transform_stamped.header.frame_id = "map";
+  transform_stamped.child_frame_id = pose.header.frame_id;
+  transform_stamped.transform.translation.x = pose.pose.position.x;
+  transform_stamped.transform.translation.y = pose.pose.position.y;
+  transform_stamped.transform.translation.z = pose.pose.position.z;
+  transform_stamped.transform.rotation = pose.pose.orientation;
+  return transform_stamped;
+}
 
+void EntityManager::broadcastTransform(
+  const geometry_msgs::msg::PoseStamped & pose, const bool static_transform)
+{
   if (static_transform) {
-    broadcaster_.sendTransform(transform_stamped);
+    broadcaster_.sendTransform(makeTransform(pose));
   } else {
-    base_link_broadcaster_.sendTransform(transform_stamped);
+    base_link_broadcaster_.sendTransform(makeTransform(pose));
   }
 }
 
@@ -120,14 +132,32 @@ bool EntityManager::checkCollision(
     if (const auto first_entity = getEntity(first_entity_name)) {
       if (const auto second_entity = getEntity(second_entity_name)) {
         return math::geometry::checkCollision2D(
-          first_entity->getMapPose(), first_entity->getBoundingBox(), second_entity->getMapPose(),
-          second_entity->getBoundingBox());
+          first_entity->getOrientedBoundingBox(), second_entity->getOrientedBoundingBox());
       }
     }
   }
   return false;
 }
 
+auto EntityManager::getEntityNamesCollidingWith(const std::string & name) const
+  -> std::vector<std::string>
+{
+  std::vector<std::string> names;
+  if (const auto entity = getEntity(name)) {
+    const auto & box = entity->getOrientedBoundingBox();
+    for (const auto & [other_name, other_entity] : entities_) {
+      /// @note Boxes whose envelopes are apart do not collide, which rejects most of the pairs.
+      if (const auto & other_box = other_entity->getOrientedBoundingBox();
+          other_name != name and box.min_x <= other_box.max_x and other_box.min_x <= box.max_x and
+          box.min_y <= other_box.max_y and other_box.min_y <= box.max_y and
+          math::geometry::checkCollision2D(box, other_box)) {
+        names.push_back(other_name);
+      }
+    }
+  }
+  return names;
+}
+
 visualization_msgs::msg::MarkerArray EntityManager::makeDebugMarker() const
 {
   visualization_msgs::msg::MarkerArray marker;
@@ -139,6 +169,7 @@ visualization_msgs::msg::MarkerArray EntityManager::makeDebugMarker() const
 
 bool EntityManager::despawnEntity(const std::string & name)
 {
+  npc_lod_skipped_times_.erase(name);
   return entityExists(name) && entities_.erase(name);
 }
 
@@ -147,15 +178,49 @@ bool EntityManager::entityExists(const std::string & name)
   return entities_.find(name) != std::end(entities_);
 }
 
+auto EntityManager::entityExists(const EntityHandle & handle) const -> bool
+{
+  return entities_.get(handle) != nullptr;
+}
+
 auto EntityManager::getEntityNames() const -> const std::vector<std::string>
 {
-  std::vector<std::string> names{};
-  for (const auto & each : entities_) {
-    names.push_back(each.first);
-  }
+  return entities_.getNames();
+}
+
+auto EntityManager::getEntitiesNear(
+  const geometry_msgs::msg::Point & point, const double radius) const -> std::vector<std::string>
+{
+  auto names = entity_spatial_index_.getEntitiesNear(point, radius);
+  names.erase(
+    std::remove_if(
+      names.begin(), names.end(), [this](const auto & name) { return not entities_.count(name); }),
+    names.end());
   return names;
 }
 
+auto EntityManager::getEntitiesOnLanelets(const lanelet::Ids & lanelet_ids) const
+  -> std::vector<std::string>
+{
+  auto names = entity_spatial_index_.getEntitiesOnLanelets(lanelet_ids);
+  names.erase(
+    std::remove_if(
+      names.begin(), names.end(), [this](const auto & name) { return not entities_.count(name); }),
+    names.end());
+  return names;
+}
+
+auto EntityManager::getEntity(const EntityHandle & handle) const
+  -> std::shared_ptr<traffic_simulator::entity::EntityBase>
+{
+  return entities_.get(handle);
+}
+
+auto EntityManager::getEntityHandle(const std::string & name) const -> std::optional<EntityHandle>
+{
+  return entities_.getHandle(name);
+}
+
 auto EntityManager::getEntity(const std::string & name) const
   -> std::shared_ptr<traffic_simulator::entity::EntityBase>
 {
@@ -183,6 +248,16 @@ auto EntityManager::getEntityStatus(const std::string & name) const
   }
 }
 
+auto EntityManager::getEntityStatus(const EntityHandle & handle) const
+  -> const CanonicalizedEntityStatus &
+{
+  if (const auto entity = getEntity(handle)) {
+    return entity->getCanonicalizedStatus();
+  } else {
+    THROW_SEMANTIC_ERROR("entity of handle ", handle.index, " does not exist.");
+  }
+}
+
 auto EntityManager::getHdmapUtils() -> const std::shared_ptr<hdmap_utils::HdMapUtils> &
 {
   return hdmap_utils_ptr_;
@@ -190,16 +265,15 @@ auto EntityManager::getHdmapUtils() -> const std::shared_ptr<hdmap_utils::HdMapU
 
 auto EntityManager::getNumberOfEgo() const -> std::size_t
 {
-  return std::count_if(std::begin(entities_), std::end(entities_), [this](const auto & each) {
-    return is<EgoEntity>(each.first);
+  return std::count_if(std::begin(entities_), std::end(entities_), [](const auto & each) {
+    return dynamic_cast<const EgoEntity *>(each.second.get()) != nullptr;
   });
 }
 
 const std::string EntityManager::getEgoName() const
 {
-  const auto names = getEntityNames();
-  for (const auto & name : names) {
-    if (is<EgoEntity>(name)) {
+  for (const auto & [name, entity] : entities_) {
+    if (dynamic_cast<const EgoEntity *>(entity.get())) {
       return name;
     }
   }
@@ -252,12 +326,9 @@ auto EntityManager::getWaypoints(const std::string & name)
 
 bool EntityManager::isEgoSpawned() const
 {
-  for (const auto & name : getEntityNames()) {
-    if (is<EgoEntity>(name)) {
-      return true;
-    }
-  }
-  return false;
+  return std::any_of(std::begin(entities_), std::end(entities_), [](const auto & each) {
+    return dynamic_cast<const EgoEntity *>(each.second.get()) != nullptr;
+  });
 }
 
 bool EntityManager::isInLanelet(
@@ -352,6 +423,8 @@ auto EntityManager::updateNpcLogic(
   const std::string & name, const double current_time, const double step_time)
   -> const CanonicalizedEntityStatus &
 {
+  common::ScopedTraceEvent event("behavior", name);
+  helper::ScopedPhaseTimer timer("EntityManager::updateNpcLogic");
   if (configuration.verbose) {
     std::cout << "update " << name << " behavior" << std::endl;
   }
@@ -368,34 +441,65 @@ auto EntityManager::updateNpcLogic(
   }
 }
 
-void EntityManager::update(const double current_time, const double step_time)
+auto EntityManager::getNpcStepTime(
+  const std::string & name, const double step_time,
+  const std::vector<geometry_msgs::msg::Point> & ego_positions) -> std::optional<double>
 {
-  traffic_simulator::helper::StopWatch<std::chrono::milliseconds> stop_watch_update(
-    "EntityManager::update", configuration.verbose);
-  setVerbose(configuration.verbose);
-  if (npc_logic_started_) {
-    conventional_traffic_light_updater_.createTimer(
-      configuration.conventional_traffic_light_publish_rate);
-    v2i_traffic_light_updater_.createTimer(configuration.v2i_traffic_light_publish_rate);
+  /// @note The status of a static entity does not change until it is set from outside.
+  if (npc_logic_started_ and not is<EgoEntity>(name) and getEntity(name)->isStatic()) {
+    return std::nullopt;
   }
-  std::unordered_map<std::string, CanonicalizedEntityStatus> all_status;
-  for (auto && [name, entity] : entities_) {
-    all_status.emplace(name, entity->getCanonicalizedStatus());
+  /// @note Without an ego entity there is nothing to be far from, so everything is kept accurate.
+  if (
+    not npc_logic_started_ or npc_lod_distance_ <= 0.0 or npc_lod_update_interval_ <= 1 or
+    ego_positions.empty() or is<EgoEntity>(name)) {
+    return step_time;
   }
-  for (auto && [name, entity] : entities_) {
-    entity->setOtherStatus(all_status);
+  const auto & position = getEntity(name)->getMapPose().position;
+  const auto is_near = std::any_of(
+    ego_positions.begin(), ego_positions.end(), [&](const geometry_msgs::msg::Point & ego) {
+      return std::hypot(position.x - ego.x, position.y - ego.y, position.z - ego.z) <=
+             npc_lod_distance_;
+    });
+  auto skipped_time = npc_lod_skipped_times_.find(name);
+  if (skipped_time == npc_lod_skipped_times_.end()) {
+    skipped_time = npc_lod_skipped_times_.emplace(name, 0.0).first;
   }
-  all_status.clear();
-  for (auto && [name, entity] : entities_) {
-    all_status.emplace(name, updateNpcLogic(name, current_time, step_time));
+  /// @note The frames updating distant entities are staggered by slot, to spread out the load.
+  if (
+    is_near or (frame_count_ + getEntityHandle(name)->index) % npc_lod_update_interval_ == 0) {
+    return step_time + std::exchange(skipped_time->second, 0.0);
+  } else {
+    skipped_time->second += step_time;
+    return std::nullopt;
   }
-  for (auto && [name, entity] : entities_) {
-    entity->setOtherStatus(all_status);
+}
+
+auto EntityManager::publishEntityStatus(
+  const OtherEntityStatus::Map & all_status, const double time) -> void
+{
+  /// @note Without subscribers, the next message has to send all waypoints to whoever subscribes.
+  if (entity_status_array_pub_ptr_->get_subscription_count() == 0) {
+    published_waypoints_.clear();
+    return;
   }
+  /// @note frame_count_ is already incremented, so the first frame is always published.
+  if ((frame_count_ - 1) % entity_status_publish_interval_ != 0) {
+    return;
+  }
+  const auto is_keyframe = entity_status_publish_count_++ % entity_status_keyframe_interval_ == 0;
+  std::unordered_map<std::string, traffic_simulator_msgs::msg::WaypointsArray> published_waypoints;
   traffic_simulator_msgs::msg::EntityStatusWithTrajectoryArray status_array_msg;
   for (auto && [name, status] : all_status) {
     traffic_simulator_msgs::msg::EntityStatusWithTrajectory status_with_trajectory;
-    status_with_trajectory.waypoint = getWaypoints(name);
+    auto waypoint = getWaypoints(name);
+    if (const auto iter = published_waypoints_.find(name);
+        not is_keyframe and iter != published_waypoints_.end() and iter->second == waypoint) {
+      status_with_trajectory.waypoint_unchanged = true;
+    } else {
+      status_with_trajectory.waypoint = waypoint;
+    }
+    published_waypoints.emplace(name, std::move(waypoint));
     for (const auto & goal : getGoalPoses<geometry_msgs::msg::Pose>(name)) {
       status_with_trajectory.goal_pose.push_back(goal);
     }
@@ -406,12 +510,121 @@ void EntityManager::update(const double current_time, const double step_time)
       status_with_trajectory.obstacle_find = false;
     }
     status_with_trajectory.status = static_cast<EntityStatus>(status);
-    status_with_trajectory.status.time = current_time + step_time;
+    status_with_trajectory.status.time = time;
     status_with_trajectory.name = name;
-    status_with_trajectory.time = current_time + step_time;
+    status_with_trajectory.time = time;
     status_array_msg.data.emplace_back(status_with_trajectory);
   }
+  published_waypoints_ = std::move(published_waypoints);
   entity_status_array_pub_ptr_->publish(status_array_msg);
+}
+
+void EntityManager::update(const double current_time, const double step_time)
+{
+  traffic_simulator::helper::StopWatch<std::chrono::milliseconds> stop_watch_update(
+    "EntityManager::update", configuration.verbose);
+  helper::ScopedPhaseTimer timer("EntityManager::update");
+  setVerbose(configuration.verbose);
+  /// @note Traffic lights are published on the frames, at their rates of simulation time.
+  if (npc_logic_started_) {
+    conventional_traffic_light_updater_.update(current_time);
+    v2i_traffic_light_updater_.update(current_time);
+  }
+  /// @note Each snapshot is built once per frame and shared by all entities instead of copied.
+  auto status_before_update = std::make_shared<OtherEntityStatus::Map>();
+  for (auto && [name, entity] : entities_) {
+    status_before_update->emplace(name, entity->getCanonicalizedStatus());
+  }
+  const auto lanelet_occupancy_before_update =
+    OtherEntityStatus::makeLaneletOccupancy(*status_before_update);
+  for (auto && [name, entity] : entities_) {
+    entity->setOtherStatus(status_before_update, lanelet_occupancy_before_update);
+  }
+  std::vector<geometry_msgs::msg::Point> ego_positions;
+  for (const auto & [name, entity] : entities_) {
+    if (dynamic_cast<const EgoEntity *>(entity.get())) {
+      ego_positions.push_back(entity->getMapPose().position);
+    }
+  }
+  /// @note Returns the status of the entity without updating it if its update is skipped.
+  const auto update_npc_logic = [&](const std::string & name, const std::optional<double> & step)
+    -> const CanonicalizedEntityStatus & {
+    return step ? updateNpcLogic(name, current_time, step.value())
+                : getEntity(name)->getCanonicalizedStatus();
+  };
+  auto all_status_ptr = std::make_shared<OtherEntityStatus::Map>();
+  auto & all_status = *all_status_ptr;
+  if (npc_logic_thread_pool_ and npc_logic_started_) {
+    /**
+     * @note Every entity reads only the statuses set above and writes only its own status, so the
+     * updates are independent. Ego entities drive Autoware through ROS, so they are updated on this
+     * thread. The results are merged in name order, independent of the scheduling.
+     */
+    std::vector<std::string> names;
+    names.reserve(entities_.size());
+    for (auto && [name, entity] : entities_) {
+      names.push_back(name);
+    }
+    std::sort(names.begin(), names.end());
+    std::vector<const CanonicalizedEntityStatus *> statuses(names.size(), nullptr);
+    std::vector<std::pair<std::size_t, std::optional<double>>> npc_steps;
+    for (std::size_t i = 0; i < names.size(); ++i) {
+      if (is<EgoEntity>(names[i])) {
+        statuses[i] = &updateNpcLogic(names[i], current_time, step_time);
+      } else {
+        npc_steps.emplace_back(i, getNpcStepTime(names[i], step_time, ego_positions));
+      }
+    }
+    npc_logic_thread_pool_->parallelFor(npc_steps.size(), [&](const std::size_t i) {
+      const auto & [index, step] = npc_steps[i];
+      statuses[index] = &update_npc_logic(names[index], step);
+    });
+    for (std::size_t i = 0; i < names.size(); ++i) {
+      all_status.emplace(names[i], *statuses[i]);
+    }
+  } else {
+    /**
+     * @note Behavior plugins of the same type and step time are updated in one call, so that a
+     * plugin can process all of its entities in one loop, see BehaviorPluginBase::updateAll. The
+     * other entities are updated in turn.
+     */
+    std::map<
+      std::pair<std::type_index, double>, std::vector<entity_behavior::BehaviorPluginBase *>>
+      batches;
+    std::vector<std::tuple<std::string, std::shared_ptr<EntityBase>, double>> batched_entities;
+    for (auto && [name, entity] : entities_) {
+      const auto step = getNpcStepTime(name, step_time, ego_positions);
+      if (const auto plugin = entity->getBatchableBehaviorPlugin();
+          plugin and step and npc_logic_started_) {
+        if (configuration.verbose) {
+          std::cout << "update " << name << " behavior" << std::endl;
+        }
+        entity->onPreBehaviorUpdate(current_time, step.value());
+        batches[{std::type_index(typeid(*plugin)), step.value()}].push_back(plugin);
+        batched_entities.emplace_back(name, entity, step.value());
+      } else {
+        all_status.emplace(name, update_npc_logic(name, step));
+      }
+    }
+    for (auto && [key, plugins] : batches) {
+      plugins.front()->updateAll(plugins, current_time, key.second);
+    }
+    for (auto && [name, entity, step] : batched_entities) {
+      entity->onPostBehaviorUpdate(current_time, step);
+      all_status.emplace(name, entity->getCanonicalizedStatus());
+    }
+  }
+  ++frame_count_;
+  const auto lanelet_occupancy = OtherEntityStatus::makeLaneletOccupancy(all_status);
+  for (auto && [name, entity] : entities_) {
+    entity->setOtherStatus(all_status_ptr, lanelet_occupancy);
+    entity->updateStateHistory(current_time + step_time);
+  }
+  entity_spatial_index_.build(all_status);
+  publishEntityStatus(all_status, current_time + step_time);
+  if (entity_log_writer_) {
+    entity_log_writer_->write(current_time + step_time, all_status);
+  }
   stop_watch_update.stop();
   if (configuration.verbose) {
     stop_watch_update.print();
@@ -420,14 +633,12 @@ void EntityManager::update(const double current_time, const double step_time)
 
 void EntityManager::updateHdmapMarker()
 {
-  MarkerArray markers;
-  const auto stamp = clock_ptr_->now();
-  for (const auto & marker_raw : markers_raw_.markers) {
-    visualization_msgs::msg::Marker marker = marker_raw;
-    marker.header.stamp = stamp;
-    markers.markers.emplace_back(marker);
-  }
-  lanelet_marker_pub_ptr_->publish(markers);
+  /**
+   * @note The markers are built once per map and published as they are, instead of copied with
+   * the current stamp, because they are in the map frame which is static. The topic is transient
+   * local, so this is only published once per EntityManager.
+   */
+  lanelet_marker_pub_ptr_->publish(*hdmap_utils_ptr_->getSharedMarker());
 }
 
 auto EntityManager::startNpcLogic(const double current_time) -> void
@@ -0,0 +1,105 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <stdexcept>
+#include <traffic_simulator/entity/entity_registry.hpp>
+
+namespace traffic_simulator
+{
+namespace entity
+{
+auto EntityRegistry::emplace(const std::string & name, std::shared_ptr<EntityBase> entity)
+  -> std::pair<iterator, bool>
+{
+  if (const auto iter = indices_.find(name); iter != indices_.end()) {
+    return {iterator(&slots_, iter->second), false};
+  }
+  std::uint32_t index;
+  if (free_indices_.empty()) {
+    index = static_cast<std::uint32_t>(slots_.size());
+    slots_.emplace_back();
+  } else {
+    index = free_indices_.back();
+    free_indices_.pop_back();
+  }
+  slots_[index].entry.emplace(name, std::move(entity));
+  indices_.emplace(name, index);
+  names_.push_back(name);
+  return {iterator(&slots_, index), true};
+}
+
+auto EntityRegistry::erase(const std::string & name) -> size_type
+{
+  if (const auto iter = indices_.find(name); iter != indices_.end()) {
+    auto & slot = slots_[iter->second];
+    slot.entry.reset();
+    ++slot.generation;
+    free_indices_.push_back(iter->second);
+    indices_.erase(iter);
+    names_.erase(std::find(names_.begin(), names_.end(), name));
+    return 1;
+  } else {
+    return 0;
+  }
+}
+
+auto EntityRegistry::find(const std::string & name) -> iterator
+{
+  if (const auto iter = indices_.find(name); iter != indices_.end()) {
+    return iterator(&slots_, iter->second);
+  } else {
+    return end();
+  }
+}
+
+auto EntityRegistry::find(const std::string & name) const -> const_iterator
+{
+  if (const auto iter = indices_.find(name); iter != indices_.end()) {
+    return const_iterator(&slots_, iter->second);
+  } else {
+    return end();
+  }
+}
+
+auto EntityRegistry::at(const std::string & name) const -> const std::shared_ptr<EntityBase> &
+{
+  if (const auto iter = indices_.find(name); iter != indices_.end()) {
+    return slots_[iter->second].entry->second;
+  } else {
+    throw std::out_of_range("EntityRegistry::at");
+  }
+}
+
+auto EntityRegistry::getHandle(const std::string & name) const -> std::optional<EntityHandle>
+{
+  if (const auto iter = indices_.find(name); iter != indices_.end()) {
+    return EntityHandle{iter->second, slots_[iter->second].generation};
+  } else {
+    return std::nullopt;
+  }
+}
+
+auto EntityRegistry::get(const EntityHandle & handle) const -> std::shared_ptr<EntityBase>
+{
+  if (
+    handle.index < slots_.size() and slots_[handle.index].generation == handle.generation and
+    slots_[handle.index].entry) {
+    return slots_[handle.index].entry->second;
+  } else {
+    return nullptr;
+  }
+}
+}  // namespace entity
+}  // namespace traffic_simulator
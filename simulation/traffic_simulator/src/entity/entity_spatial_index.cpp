@@ -0,0 +1,117 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <traffic_simulator/entity/entity_spatial_index.hpp>
+
+namespace traffic_simulator
+{
+namespace entity
+{
+EntitySpatialIndex::EntitySpatialIndex(const double cell_size) : cell_size_(cell_size) {}
+
+auto EntitySpatialIndex::build(const OtherEntityStatus::Map & all_status) -> void
+{
+  names_.clear();
+  positions_.clear();
+  cells_.clear();
+  lanelet_occupancy_.clear();
+
+  for (const auto & [name, status] : all_status) {
+    names_.push_back(name);
+  }
+  std::sort(names_.begin(), names_.end());
+
+  for (std::size_t index = 0; index < names_.size(); ++index) {
+    const auto & status = all_status.at(names_[index]);
+    const auto & position = status.getMapPose().position;
+    positions_.push_back(position);
+    cells_.emplace_back(getCell(position.x), getCell(position.y), index);
+    if (status.laneMatchingSucceed()) {
+      lanelet_occupancy_[status.getLaneletId()].push_back(index);
+    }
+  }
+  std::sort(cells_.begin(), cells_.end());
+}
+
+auto EntitySpatialIndex::getEntitiesNear(
+  const geometry_msgs::msg::Point & point, const double radius) const -> std::vector<std::string>
+{
+  const auto is_near = [&](const std::size_t index) {
+    const auto & position = positions_[index];
+    return std::hypot(position.x - point.x, position.y - point.y, position.z - point.z) <= radius;
+  };
+
+  std::vector<std::size_t> indices;
+  if (not(radius >= 0.0)) {
+    return {};
+  } else if (const auto columns = (2.0 * radius) / cell_size_ + 1.0;
+             not std::isfinite(columns) or columns * columns > cells_.size() or
+             not std::isfinite(point.x) or not std::isfinite(point.y)) {
+    /// @note The search circle covers more cells than there are entities, so scan them instead.
+    for (std::size_t index = 0; index < names_.size(); ++index) {
+      if (is_near(index)) {
+        indices.push_back(index);
+      }
+    }
+  } else {
+    const auto min_cell_y = getCell(point.y - radius);
+    const auto max_cell_y = getCell(point.y + radius);
+    for (auto cell_x = getCell(point.x - radius); cell_x <= getCell(point.x + radius); ++cell_x) {
+      for (auto iter = std::lower_bound(
+             cells_.begin(), cells_.end(), std::make_tuple(cell_x, min_cell_y, std::size_t(0)));
+           iter != cells_.end() and std::get<0>(*iter) == cell_x and
+           std::get<1>(*iter) <= max_cell_y;
+           ++iter) {
+        if (is_near(std::get<2>(*iter))) {
+          indices.push_back(std::get<2>(*iter));
+        }
+      }
+    }
+  }
+  return getNames(std::move(indices));
+}
+
+auto EntitySpatialIndex::getEntitiesOnLanelets(const lanelet::Ids & lanelet_ids) const
+  -> std::vector<std::string>
+{
+  std::vector<std::size_t> indices;
+  for (const auto lanelet_id : lanelet_ids) {
+    if (const auto iter = lanelet_occupancy_.find(lanelet_id); iter != lanelet_occupancy_.end()) {
+      indices.insert(indices.end(), iter->second.begin(), iter->second.end());
+    }
+  }
+  return getNames(std::move(indices));
+}
+
+auto EntitySpatialIndex::getCell(const double value) const -> std::int64_t
+{
+  return static_cast<std::int64_t>(std::floor(value / cell_size_));
+}
+
+auto EntitySpatialIndex::getNames(std::vector<std::size_t> && indices) const
+  -> std::vector<std::string>
+{
+  std::sort(indices.begin(), indices.end());
+  indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+  std::vector<std::string> names;
+  names.reserve(indices.size());
+  for (const auto index : indices) {
+    names.push_back(names_[index]);
+  }
+  return names;
+}
+}  // namespace entity
+}  // namespace traffic_simulator
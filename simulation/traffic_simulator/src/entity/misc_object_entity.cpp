@@ -35,6 +35,17 @@ auto MiscObjectEntity::onUpdate(const double /*current_time*/, const double) ->
   status_before_update_.set(*status_);
 }
 
+auto MiscObjectEntity::isStatic() const -> bool
+{
+  /// @note onUpdate only zeroes the motion and copies the status to the status before the update.
+  return status_->getActionStatus().current_action == "static" and
+         status_->getTwist() == geometry_msgs::msg::Twist() and
+         status_->getAccel() == geometry_msgs::msg::Accel() and status_->getLinearJerk() == 0.0 and
+         status_before_update_.getMapPose() == status_->getMapPose() and
+         status_before_update_.getTwist() == status_->getTwist() and
+         status_before_update_.getAccel() == status_->getAccel();
+}
+
 auto MiscObjectEntity::getCurrentAction() const -> std::string
 {
   return static_cast<EntityStatus>(*status_).action_status.current_action;
@@ -31,9 +31,7 @@ PedestrianEntity::PedestrianEntity(
 : EntityBase(name, entity_status, hdmap_utils_ptr),
   plugin_name(plugin_name),
   pedestrian_parameters(parameters),
-  loader_(pluginlib::ClassLoader<entity_behavior::BehaviorPluginBase>(
-    "traffic_simulator", "entity_behavior::BehaviorPluginBase")),
-  behavior_plugin_ptr_(loader_.createSharedInstance(plugin_name)),
+  behavior_plugin_ptr_(entity_behavior::acquireBehaviorPlugin(plugin_name)),
   route_planner_(hdmap_utils_ptr_)
 {
   behavior_plugin_ptr_->configure(rclcpp::get_logger(name));
@@ -247,14 +245,31 @@ void PedestrianEntity::setDecelerationRateLimit(double deceleration_rate)
 }
 
 auto PedestrianEntity::onUpdate(const double current_time, const double step_time) -> void
+{
+  onPreBehaviorUpdate(current_time, step_time);
+  /// @note CanonicalizedEntityStatus is updated here, it is not skipped even if isAtEndOfLanelets return true
+  behavior_plugin_ptr_->update(current_time, step_time);
+  onPostBehaviorUpdate(current_time, step_time);
+}
+
+auto PedestrianEntity::getBatchableBehaviorPlugin() const -> entity_behavior::BehaviorPluginBase *
+{
+  return behavior_plugin_ptr_.get();
+}
+
+auto PedestrianEntity::onPreBehaviorUpdate(const double current_time, const double step_time)
+  -> void
 {
   EntityBase::onUpdate(current_time, step_time);
   behavior_plugin_ptr_->setOtherEntityStatus(other_status_);
   behavior_plugin_ptr_->setCanonicalizedEntityStatus(status_);
   behavior_plugin_ptr_->setTargetSpeed(target_speed_);
   behavior_plugin_ptr_->setRouteLanelets(getRouteLanelets());
-  /// @note CanonicalizedEntityStatus is updated here, it is not skipped even if isAtEndOfLanelets return true
-  behavior_plugin_ptr_->update(current_time, step_time);
+}
+
+auto PedestrianEntity::onPostBehaviorUpdate(const double current_time, const double step_time)
+  -> void
+{
   if (const auto canonicalized_lanelet_pose = status_->getCanonicalizedLaneletPose()) {
     if (pose::isAtEndOfLanelets(canonicalized_lanelet_pose.value(), hdmap_utils_ptr_)) {
       stopAtCurrentPosition();
@@ -31,9 +31,7 @@ VehicleEntity::VehicleEntity(
   const std::string & plugin_name)
 : EntityBase(name, entity_status, hdmap_utils_ptr),
   vehicle_parameters(parameters),
-  loader_(pluginlib::ClassLoader<entity_behavior::BehaviorPluginBase>(
-    "traffic_simulator", "entity_behavior::BehaviorPluginBase")),
-  behavior_plugin_ptr_(loader_.createSharedInstance(plugin_name)),
+  behavior_plugin_ptr_(entity_behavior::acquireBehaviorPlugin(plugin_name)),
   route_planner_(hdmap_utils_ptr_)
 {
   behavior_plugin_ptr_->configure(rclcpp::get_logger(name));
@@ -124,6 +122,19 @@ auto VehicleEntity::getWaypoints() -> const traffic_simulator_msgs::msg::Waypoin
 }
 
 auto VehicleEntity::onUpdate(const double current_time, const double step_time) -> void
+{
+  onPreBehaviorUpdate(current_time, step_time);
+  /// @note CanonicalizedEntityStatus is updated here, it is not skipped even if isAtEndOfLanelets return true
+  behavior_plugin_ptr_->update(current_time, step_time);
+  onPostBehaviorUpdate(current_time, step_time);
+}
+
+auto VehicleEntity::getBatchableBehaviorPlugin() const -> entity_behavior::BehaviorPluginBase *
+{
+  return behavior_plugin_ptr_.get();
+}
+
+auto VehicleEntity::onPreBehaviorUpdate(const double current_time, const double step_time) -> void
 {
   EntityBase::onUpdate(current_time, step_time);
 
@@ -133,20 +144,13 @@ auto VehicleEntity::onUpdate(const double current_time, const double step_time)
   auto route_lanelets = getRouteLanelets();
   behavior_plugin_ptr_->setRouteLanelets(route_lanelets);
 
-  // recalculate spline only when input data changes
-  if (previous_route_lanelets_ != route_lanelets) {
-    previous_route_lanelets_ = route_lanelets;
-    try {
-      spline_ = std::make_shared<math::geometry::CatmullRomSpline>(
-        hdmap_utils_ptr_->getCenterPoints(route_lanelets));
-    } catch (const common::scenario_simulator_exception::SemanticError & error) {
-      // reset the ptr when spline cannot be calculated
-      spline_.reset();
-    }
-  }
-  behavior_plugin_ptr_->setReferenceTrajectory(spline_);
-  /// @note CanonicalizedEntityStatus is updated here, it is not skipped even if isAtEndOfLanelets return true
-  behavior_plugin_ptr_->update(current_time, step_time);
+  /// @note The spline is cached by the route planner, it is rebuilt only when the route changes.
+  behavior_plugin_ptr_->setReferenceTrajectory(
+    route_lanelets.empty() ? nullptr : route_planner_.getRouteSpline());
+}
+
+auto VehicleEntity::onPostBehaviorUpdate(const double current_time, const double step_time) -> void
+{
   if (const auto canonicalized_lanelet_pose = status_->getCanonicalizedLaneletPose()) {
     if (pose::isAtEndOfLanelets(canonicalized_lanelet_pose.value(), hdmap_utils_ptr_)) {
       stopAtCurrentPosition();
@@ -0,0 +1,28 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <traffic_simulator/hdmap_utils/adjacency_table.hpp>
+
+namespace hdmap_utils
+{
+AdjacencyTable::AdjacencyTable(const std::vector<lanelet::Ids> & rows)
+{
+  offsets_.reserve(rows.size() + 1);
+  offsets_.push_back(0);
+  for (const auto & related_ids : rows) {
+    values_.insert(values_.end(), related_ids.begin(), related_ids.end());
+    offsets_.push_back(static_cast<std::uint32_t>(values_.size()));
+  }
+}
+}  // namespace hdmap_utils
@@ -0,0 +1,75 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <iterator>
+#include <traffic_simulator/hdmap_utils/centerline_index.hpp>
+#include <unordered_map>
+
+namespace hdmap_utils
+{
+CenterlineIndex::CenterlineIndex(
+  const std::vector<std::pair<lanelet::Id, std::vector<geometry_msgs::msg::Point>>> & centerlines)
+{
+  std::vector<Value> values;
+  for (const auto & [lanelet_id, center_points] : centerlines) {
+    for (std::size_t i = 0; i + 1 < center_points.size(); ++i) {
+      const Segment2d segment(
+        Point2d(center_points[i].x, center_points[i].y),
+        Point2d(center_points[i + 1].x, center_points[i + 1].y));
+      Box2d box;
+      boost::geometry::envelope(segment, box);
+      values.emplace_back(box, std::make_pair(lanelet_id, segment));
+    }
+  }
+  /// @note Range construction uses the packing algorithm, which gives a better balanced tree.
+  rtree_ = decltype(rtree_)(values.begin(), values.end());
+}
+
+auto CenterlineIndex::query(const geometry_msgs::msg::Point & point, const double search_radius)
+  const -> std::vector<Candidate>
+{
+  const Point2d search_point(point.x, point.y);
+  const Box2d search_box(
+    Point2d(point.x - search_radius, point.y - search_radius),
+    Point2d(point.x + search_radius, point.y + search_radius));
+
+  std::vector<Value> values;
+  rtree_.query(boost::geometry::index::intersects(search_box), std::back_inserter(values));
+
+  std::unordered_map<lanelet::Id, double> nearest_distances;
+  for (const auto & [box, lanelet_id_and_segment] : values) {
+    const auto & [lanelet_id, segment] = lanelet_id_and_segment;
+    if (const auto distance = boost::geometry::distance(search_point, segment);
+        distance <= search_radius) {
+      if (const auto iter = nearest_distances.find(lanelet_id); iter == nearest_distances.end()) {
+        nearest_distances.emplace(lanelet_id, distance);
+      } else {
+        iter->second = std::min(iter->second, distance);
+      }
+    }
+  }
+
+  std::vector<Candidate> candidates;
+  candidates.reserve(nearest_distances.size());
+  for (const auto & [lanelet_id, distance] : nearest_distances) {
+    candidates.push_back({lanelet_id, distance});
+  }
+  std::sort(candidates.begin(), candidates.end(), [](const auto & lhs, const auto & rhs) {
+    return lhs.distance < rhs.distance or
+           (lhs.distance == rhs.distance and lhs.lanelet_id < rhs.lanelet_id);
+  });
+  return candidates;
+}
+}  // namespace hdmap_utils
@@ -0,0 +1,53 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <geometry/quaternion/quaternion_to_euler.hpp>
+#include <traffic_simulator/hdmap_utils/elevation_profile.hpp>
+
+namespace hdmap_utils
+{
+ElevationProfile::ElevationProfile(
+  const math::geometry::CatmullRomSpline & spline, const double resolution)
+: resolution_(resolution)
+{
+  const auto length = spline.getLength();
+  const auto size = static_cast<std::size_t>(std::ceil(length / resolution_)) + 1;
+  samples_.reserve(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    const auto pose = spline.getPose(std::min(i * resolution_, length), true);
+    const auto rpy = math::geometry::convertQuaternionToEulerAngle(pose.orientation);
+    samples_.push_back(Sample{pose.position.z, rpy.y, rpy.z});
+  }
+}
+
+auto ElevationProfile::at(const double s) const -> Sample
+{
+  const auto position = std::clamp(s / resolution_, 0.0, static_cast<double>(samples_.size() - 1));
+  const auto i = std::min(static_cast<std::size_t>(position), samples_.size() - 1);
+  if (i + 1 == samples_.size()) {
+    return samples_[i];
+  } else {
+    const auto & [z0, pitch0, yaw0] = samples_[i];
+    const auto & [z1, pitch1, yaw1] = samples_[i + 1];
+    const auto t = position - i;
+    /// @note The yaw is interpolated along the shorter arc, to not turn around at +/-pi.
+    const auto yaw_difference = std::remainder(yaw1 - yaw0, 2.0 * M_PI);
+    return Sample{
+      z0 + (z1 - z0) * t, pitch0 + (pitch1 - pitch0) * t,
+      std::remainder(yaw0 + yaw_difference * t, 2.0 * M_PI)};
+  }
+}
+}  // namespace hdmap_utils
@@ -18,6 +18,7 @@
 #include <lanelet2_projection/UTM.h>
 
 #include <algorithm>
+#include <atomic>
 #include <autoware_lanelet2_extension/io/autoware_osm_parser.hpp>
 #include <autoware_lanelet2_extension/projection/mgrs_projector.hpp>
 #include <autoware_lanelet2_extension/utility/message_conversion.hpp>
@@ -31,7 +32,9 @@
 #include <boost/geometry/geometries/box.hpp>
 #include <boost/geometry/geometries/point_xy.hpp>
 #include <boost/geometry/geometries/polygon.hpp>
+#include <chrono>
 #include <deque>
+#include <future>
 #include <geometry/quaternion/euler_to_quaternion.hpp>
 #include <geometry/quaternion/get_rotation.hpp>
 #include <geometry/quaternion/operator.hpp>
@@ -43,51 +46,262 @@
 #include <geometry/vector3/normalize.hpp>
 #include <geometry/vector3/operator.hpp>
 #include <memory>
+#include <numeric>
 #include <optional>
 #include <scenario_simulator_exception/exception.hpp>
+#include <rclcpp/logging.hpp>
 #include <set>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <traffic_simulator/color_utils/color_utils.hpp>
 #include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
 #include <traffic_simulator/helper/helper.hpp>
+#include <traffic_simulator/helper/phase_timer.hpp>
+#include <traffic_simulator/utils/thread_pool.hpp>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 namespace hdmap_utils
 {
-HdMapUtils::HdMapUtils(
-  const boost::filesystem::path & lanelet2_map_path, const geographic_msgs::msg::GeoPoint &)
+namespace
+{
+/**
+ * @brief Call function(begin, end) for contiguous ranges covering [0, size) on up to thread_count
+ * threads.
+ * @note An exception thrown by the function is rethrown to the caller.
+ */
+template <typename Function>
+auto parallelFor(const std::size_t size, const std::size_t thread_count, Function && function)
+  -> void
+{
+  const auto worker_count = std::max<std::size_t>(1, std::min(thread_count, size));
+  if (worker_count == 1) {
+    function(std::size_t(0), size);
+    return;
+  }
+  std::vector<std::future<void>> futures;
+  for (std::size_t worker = 0; worker < worker_count; ++worker) {
+    futures.push_back(std::async(std::launch::async, [&, worker]() {
+      function(size * worker / worker_count, size * (worker + 1) / worker_count);
+    }));
+  }
+  for (auto & future : futures) {
+    future.get();
+  }
+}
+
+auto toPoints(const lanelet::ConstLineString3d & line_string)
+  -> std::vector<geometry_msgs::msg::Point>
 {
-  lanelet::projection::MGRSProjector projector;
+  std::vector<geometry_msgs::msg::Point> points;
+  points.reserve(line_string.size());
+  for (const auto & point : line_string) {
+    geometry_msgs::msg::Point p;
+    p.x = point.x();
+    p.y = point.y();
+    p.z = point.z();
+    points.emplace_back(p);
+  }
+  return points;
+}
+}  // namespace
 
-  lanelet::ErrorMessages errors;
+HdMapUtils::HdMapUtils(
+  const boost::filesystem::path & lanelet2_map_path, const geographic_msgs::msg::GeoPoint & origin,
+  const boost::filesystem::path & snapshot_directory,
+  const std::optional<lanelet::BoundingBox2d> & region)
+{
+  traffic_simulator::helper::ScopedPhaseTimer timer("HdMapUtils::HdMapUtils");
+
+  std::stringstream startup_time;
+  auto lap_time = std::chrono::steady_clock::now();
+  const auto lap = [&](const char * stage) {
+    const auto now = std::chrono::steady_clock::now();
+    startup_time << " " << stage << " " << std::chrono::duration<double>(now - lap_time).count()
+                 << " s,";
+    lap_time = now;
+  };
+
+  const auto snapshot = snapshot_directory.empty() or region
+                          ? nullptr
+                          : MapSnapshot::open(snapshot_directory, lanelet2_map_path, origin);
+
+  if (snapshot) {
+    lanelet_map_ptr_ = snapshot->getLaneletMap();
+  } else {
+    lanelet::projection::MGRSProjector projector;
 
-  lanelet_map_ptr_ = lanelet::load(lanelet2_map_path.string(), projector, &errors);
+    lanelet::ErrorMessages errors;
 
-  if (not errors.empty()) {
-    std::stringstream ss;
-    const auto * separator = "";
-    for (const auto & error : errors) {
-      ss << separator << error;
-      separator = "\n";
+    lanelet_map_ptr_ = lanelet::load(lanelet2_map_path.string(), projector, &errors);
+
+    if (not errors.empty()) {
+      std::stringstream ss;
+      const auto * separator = "";
+      for (const auto & error : errors) {
+        ss << separator << error;
+        separator = "\n";
+      }
+      THROW_SIMULATION_ERROR("Failed to load lanelet map (", ss.str(), ")");
     }
-    THROW_SIMULATION_ERROR("Failed to load lanelet map (", ss.str(), ")");
   }
+  lap("load");
+  if (region) {
+    /// @note Lanelets crossing the border are kept whole, with the regulatory elements they use.
+    lanelet_map_ptr_ = lanelet::utils::createMap(
+      lanelet_map_ptr_->laneletLayer.search(*region), lanelet_map_ptr_->areaLayer.search(*region));
+    if (lanelet_map_ptr_->laneletLayer.empty()) {
+      THROW_SIMULATION_ERROR(
+        "No lanelet of ", lanelet2_map_path.string(), " crosses the map region from (",
+        region->min().x(), ", ", region->min().y(), ") to (", region->max().x(), ", ",
+        region->max().y(), ")");
+    }
+    lap("crop");
+  }
+  /// @note Centerlines stored in the snapshot are custom centerlines, so this is a no-op for them.
   overwriteLaneletsCenterline();
+  lap("centerlines");
   traffic_rules_vehicle_ptr_ = lanelet::traffic_rules::TrafficRulesFactory::create(
     lanelet::Locations::Germany, lanelet::Participants::Vehicle);
-  vehicle_routing_graph_ptr_ =
-    lanelet::routing::RoutingGraph::build(*lanelet_map_ptr_, *traffic_rules_vehicle_ptr_);
   traffic_rules_pedestrian_ptr_ = lanelet::traffic_rules::TrafficRulesFactory::create(
     lanelet::Locations::Germany, lanelet::Participants::Pedestrian);
-  pedestrian_routing_graph_ptr_ =
-    lanelet::routing::RoutingGraph::build(*lanelet_map_ptr_, *traffic_rules_pedestrian_ptr_);
-  std::vector<lanelet::routing::RoutingGraphConstPtr> all_graphs;
-  all_graphs.push_back(vehicle_routing_graph_ptr_);
-  all_graphs.push_back(pedestrian_routing_graph_ptr_);
+  /*
+     Every lanelet has its centerline set above, so building the routing
+     graphs only reads the map and the two graphs are built concurrently.
+  */
+  auto pedestrian_routing_graph = std::async(std::launch::async, [this]() {
+    return lanelet::routing::RoutingGraph::build(*lanelet_map_ptr_, *traffic_rules_pedestrian_ptr_);
+  });
+  vehicle_routing_graph_ptr_ =
+    lanelet::routing::RoutingGraph::build(*lanelet_map_ptr_, *traffic_rules_vehicle_ptr_);
   shoulder_lanelets_ =
     lanelet::utils::query::shoulderLanelets(lanelet::utils::query::laneletLayer(lanelet_map_ptr_));
+  pedestrian_routing_graph_ptr_ = pedestrian_routing_graph.get();
+  lap("routing graphs");
+  lanelet_index_ = LaneletIndex(getLaneletIds());
+  lanelet_lengths_.resize(lanelet_index_.size());
+  if (snapshot) {
+    for (auto & centerline : snapshot->getCenterlines()) {
+      lanelet_lengths_[getLaneletIndex(centerline.lanelet_id)] = centerline.length;
+      center_points_cache_.appendData(centerline.lanelet_id, std::move(centerline.points));
+    }
+  } else {
+    for (LaneletIndex::Index index = 0; index < lanelet_index_.size(); ++index) {
+      lanelet_lengths_[index] = lanelet::utils::getLaneletLength2d(
+        lanelet_map_ptr_->laneletLayer.get(lanelet_index_.id(index)));
+    }
+  }
+  speed_limits_.reserve(lanelet_index_.size());
+  subtypes_.reserve(lanelet_index_.size());
+  turn_directions_.reserve(lanelet_index_.size());
+  for (const auto lanelet_id : lanelet_index_.ids()) {
+    const auto lanelet = lanelet_map_ptr_->laneletLayer.get(lanelet_id);
+    const auto limit = traffic_rules_vehicle_ptr_->speedLimit(lanelet);
+    speed_limits_.push_back(lanelet::units::KmHQuantity(limit.speedLimit).value() / 3.6);
+    subtypes_.push_back(lanelet.attributeOr(lanelet::AttributeName::Subtype, ""));
+    turn_directions_.push_back(lanelet.attributeOr("turn_direction", "else"));
+  }
+  centerline_index_ = createCenterlineIndex();
+  following_lanelet_table_ = createAdjacencyTable([this](const auto & lanelet) {
+    return getLaneletIds(vehicle_routing_graph_ptr_->following(lanelet));
+  });
+  previous_lanelet_table_ = createAdjacencyTable([this](const auto & lanelet) {
+    return getLaneletIds(vehicle_routing_graph_ptr_->previous(lanelet));
+  });
+  next_road_shoulder_table_ = createAdjacencyTable(
+    [this](const auto & lanelet) { return getNextRoadShoulderLanelet(lanelet.id()); });
+  previous_road_shoulder_table_ = createAdjacencyTable(
+    [this](const auto & lanelet) { return getPreviousRoadShoulderLanelet(lanelet.id()); });
+  /// @note The straight lanelet is preferred, then the first one, as in the walks along the lanes.
+  next_lanelets_along_.reserve(lanelet_index_.size());
+  previous_lanelets_along_.reserve(lanelet_index_.size());
+  for (const auto lanelet_id : lanelet_index_.ids()) {
+    const auto choose = [](const lanelet::Ids & straight_ids, const lanelet::Ids & ids) {
+      return straight_ids.empty() ? (ids.empty() ? lanelet::InvalId : ids.front())
+                                  : straight_ids.front();
+    };
+    next_lanelets_along_.push_back(
+      choose(getNextLaneletIds(lanelet_id, "straight"), getNextLaneletIds(lanelet_id)));
+    previous_lanelets_along_.push_back(
+      choose(getPreviousLaneletIds(lanelet_id, "straight"), getPreviousLaneletIds(lanelet_id)));
+  }
+  conflicting_lane_table_ = createAdjacencyTable(
+    [this](const auto & lanelet) { return calculateConflictingLaneIds(lanelet); });
+  conflicting_crosswalk_table_ = createAdjacencyTable(
+    [this](const auto & lanelet) { return calculateConflictingCrosswalkIds(lanelet); });
+  right_of_way_table_ = createAdjacencyTable(
+    [this](const auto & lanelet) { return calculateRightOfWayLaneletIds(lanelet); });
+  stop_line_table_ = createAdjacencyTable([this](const auto & lanelet) {
+    lanelet::Ids stop_line_ids;
+    for (const auto & stop_line : getStopLinesOnPath({lanelet.id()})) {
+      stop_line_ids.push_back(stop_line.id());
+      stop_line_points_.emplace(stop_line.id(), toPoints(stop_line));
+    }
+    return stop_line_ids;
+  });
+  traffic_light_table_ = createAdjacencyTable([this](const auto & lanelet) {
+    lanelet::Ids traffic_light_ids;
+    for (const auto & traffic_light : getTrafficLightRegulatoryElementsOnPath({lanelet.id()})) {
+      for (auto light_string : traffic_light->lightBulbs()) {
+        if (light_string.hasAttribute("traffic_light_id")) {
+          if (auto id = light_string.attribute("traffic_light_id").asId(); id) {
+            traffic_light_ids.push_back(id.value());
+          }
+        }
+      }
+    }
+    return traffic_light_ids;
+  });
+  for (const auto & traffic_light : lanelet::utils::query::autowareTrafficLights(
+         lanelet::utils::query::laneletLayer(lanelet_map_ptr_))) {
+    for (auto light_string : traffic_light->lightBulbs()) {
+      if (light_string.hasAttribute("traffic_light_id")) {
+        if (auto id = light_string.attribute("traffic_light_id").asId(); id) {
+          const auto stop_line = traffic_light->stopLine();
+          traffic_light_stop_lines_points_[id.value()].push_back(
+            stop_line ? toPoints(stop_line.value()) : std::vector<geometry_msgs::msg::Point>());
+          /// @note The first bulb of each color is the position of the color, arrows excluded.
+          auto & bulb_positions = traffic_light_bulb_positions_[id.value()];
+          for (const auto & bulb : static_cast<lanelet::ConstLineString3d>(light_string)) {
+            if (bulb.hasAttribute("color") and not bulb.hasAttribute("arrow")) {
+              bulb_positions.try_emplace(
+                bulb.attribute("color").value(), geometry_msgs::build<geometry_msgs::msg::Point>()
+                                                   .x(bulb.x())
+                                                   .y(bulb.y())
+                                                   .z(bulb.z()));
+            }
+          }
+        }
+      }
+    }
+  }
+  for (const auto & regulatory_element : lanelet_map_ptr_->regulatoryElementLayer) {
+    if (regulatory_element->attributeOr(lanelet::AttributeName::Subtype, "") ==
+        std::string("traffic_light")) {
+      for (const auto & ref_member :
+           regulatory_element->getParameters<lanelet::ConstLineString3d>("refers")) {
+        traffic_light_regulatory_element_ids_[ref_member.id()].push_back(regulatory_element->id());
+      }
+    }
+  }
+  if (not snapshot_directory.empty() and not snapshot and not region) {
+    std::vector<MapSnapshot::Centerline> centerlines;
+    for (const auto & lanelet : lanelet_map_ptr_->laneletLayer) {
+      centerlines.push_back(
+        {lanelet.id(), getLaneletLength(lanelet.id()),
+         *getCenterPointsCacheEntry(lanelet.id()).points});
+    }
+    /// @note A snapshot that cannot be written is not an error, the map is just loaded from osm.
+    MapSnapshot::write(
+      snapshot_directory, lanelet2_map_path, origin, *lanelet_map_ptr_, centerlines);
+  }
+  lap("tables");
+  RCLCPP_INFO_STREAM(
+    rclcpp::get_logger("hdmap_utils"),
+    "Loaded " << lanelet2_map_path.string() << " in" << startup_time.str() << " "
+              << lanelet_index_.size() << " lanelets");
 }
 
 auto HdMapUtils::getAllCanonicalizedLaneletPoses(
@@ -273,17 +487,14 @@ auto HdMapUtils::getLaneletPolygon(const lanelet::Id lanelet_id) const
 auto HdMapUtils::filterLaneletIds(const lanelet::Ids & lanelet_ids, const char subtype[]) const
   -> lanelet::Ids
 {
-  const auto lanelets = getLanelets(lanelet_ids);
-  lanelet::Lanelets filtered_lanelets;
-  for (const auto & ll : lanelets) {
-    if (ll.hasAttribute(lanelet::AttributeName::Subtype)) {
-      lanelet::Attribute attr = ll.attribute(lanelet::AttributeName::Subtype);
-      if (attr.value() == subtype) {
-        filtered_lanelets.emplace_back(ll);
-      }
+  lanelet::Ids filtered_lanelet_ids;
+  for (const auto lanelet_id : lanelet_ids) {
+    if (const auto & lanelet_subtype = subtypes_[getLaneletIndex(lanelet_id)];
+        not lanelet_subtype.empty() and lanelet_subtype == subtype) {
+      filtered_lanelet_ids.push_back(lanelet_id);
     }
   }
-  return getLaneletIds(filtered_lanelets);
+  return filtered_lanelet_ids;
 }
 
 auto HdMapUtils::getNearbyLaneletIds(
@@ -402,12 +613,8 @@ auto HdMapUtils::getConflictingLaneIds(const lanelet::Ids & lanelet_ids) const -
 {
   lanelet::Ids ids;
   for (const auto & lanelet_id : lanelet_ids) {
-    const auto lanelet = lanelet_map_ptr_->laneletLayer.get(lanelet_id);
-    const auto conflicting_lanelets =
-      lanelet::utils::getConflictingLanelets(vehicle_routing_graph_ptr_, lanelet);
-    for (const auto & conflicting_lanelet : conflicting_lanelets) {
-      ids.emplace_back(conflicting_lanelet.id());
-    }
+    const auto row = conflicting_lane_table_.row(getLaneletIndex(lanelet_id));
+    ids.insert(ids.end(), row.begin(), row.end());
   }
   return ids;
 }
@@ -415,19 +622,9 @@ auto HdMapUtils::getConflictingLaneIds(const lanelet::Ids & lanelet_ids) const -
 auto HdMapUtils::getConflictingCrosswalkIds(const lanelet::Ids & lanelet_ids) const -> lanelet::Ids
 {
   lanelet::Ids ids;
-  std::vector<lanelet::routing::RoutingGraphConstPtr> graphs;
-  graphs.emplace_back(vehicle_routing_graph_ptr_);
-  graphs.emplace_back(pedestrian_routing_graph_ptr_);
-  lanelet::routing::RoutingGraphContainer container(graphs);
   for (const auto & lanelet_id : lanelet_ids) {
-    const auto lanelet = lanelet_map_ptr_->laneletLayer.get(lanelet_id);
-    double height_clearance = 4;
-    size_t routing_graph_id = 1;
-    const auto conflicting_crosswalks =
-      container.conflictingInGraph(lanelet, routing_graph_id, height_clearance);
-    for (const auto & crosswalk : conflicting_crosswalks) {
-      ids.emplace_back(crosswalk.id());
-    }
+    const auto row = conflicting_crosswalk_table_.row(getLaneletIndex(lanelet_id));
+    ids.insert(ids.end(), row.begin(), row.end());
   }
   return ids;
 }
@@ -487,11 +684,9 @@ auto HdMapUtils::filterLanelets(const lanelet::Lanelets & lanelets, const char s
 {
   lanelet::Lanelets filtered_lanelets;
   for (const auto & ll : lanelets) {
-    if (ll.hasAttribute(lanelet::AttributeName::Subtype)) {
-      lanelet::Attribute attr = ll.attribute(lanelet::AttributeName::Subtype);
-      if (attr.value() != subtype) {
-        filtered_lanelets.push_back(ll);
-      }
+    if (const auto & lanelet_subtype = subtypes_[getLaneletIndex(ll.id())];
+        not lanelet_subtype.empty() and lanelet_subtype != subtype) {
+      filtered_lanelets.push_back(ll);
     }
   }
   return filtered_lanelets;
@@ -503,11 +698,9 @@ auto HdMapUtils::excludeSubtypeLanelets(
 {
   std::vector<std::pair<double, lanelet::Lanelet>> exclude_subtype_lanelets;
   for (const auto & ll : lls) {
-    if (ll.second.hasAttribute(lanelet::AttributeName::Subtype)) {
-      lanelet::Attribute attr = ll.second.attribute(lanelet::AttributeName::Subtype);
-      if (attr.value() != subtype) {
-        exclude_subtype_lanelets.push_back(ll);
-      }
+    if (const auto & lanelet_subtype = subtypes_[getLaneletIndex(ll.second.id())];
+        not lanelet_subtype.empty() and lanelet_subtype != subtype) {
+      exclude_subtype_lanelets.push_back(ll);
     }
   }
   return exclude_subtype_lanelets;
@@ -577,13 +770,32 @@ auto HdMapUtils::toLaneletPose(
   const geometry_msgs::msg::Pose & pose, const bool include_crosswalk,
   const double matching_distance) const -> std::optional<traffic_simulator_msgs::msg::LaneletPose>
 {
-  const auto lanelet_ids = getNearbyLaneletIds(pose.position, 0.1, include_crosswalk);
-  if (lanelet_ids.empty()) {
-    return std::nullopt;
-  }
-  for (const auto & id : lanelet_ids) {
-    const auto lanelet_pose = toLaneletPose(pose, id, matching_distance);
-    if (lanelet_pose) {
+  /**
+   * @note Hard coded parameter
+   * A pose can only be matched to a lanelet whose centerline spline is within matching_distance,
+   * the margin absorbs the difference between the spline and its polyline in the index.
+   */
+  constexpr double spline_margin = 1.0;
+  /**
+   * @note Hard coded parameter
+   * The pose must lie inside the lanelet polygon (allowing this tolerance) to be matched.
+   */
+  constexpr double polygon_distance_threshold = 0.1;
+  const auto search_point = toPoint2d(pose.position);
+  /// @note Candidates are sorted by distance to the centerline, so the best match is tried first.
+  for (const auto & candidate :
+       centerline_index_.query(pose.position, matching_distance + spline_margin)) {
+    if (not include_crosswalk) {
+      if (const auto & subtype = subtypes_[getLaneletIndex(candidate.lanelet_id)];
+          subtype.empty() or subtype == lanelet::AttributeValueString::Crosswalk) {
+        continue;
+      }
+    }
+    const auto lanelet = lanelet_map_ptr_->laneletLayer.get(candidate.lanelet_id);
+    if (lanelet::geometry::distance2d(lanelet, search_point) > polygon_distance_threshold) {
+      continue;
+    }
+    if (const auto lanelet_pose = toLaneletPose(pose, candidate.lanelet_id, matching_distance)) {
       return lanelet_pose;
     }
   }
@@ -735,10 +947,8 @@ auto HdMapUtils::getSpeedLimit(const lanelet::Ids & lanelet_ids) const -> double
   if (lanelet_ids.empty()) {
     THROW_SEMANTIC_ERROR("size of the vector lanelet ids should be more than 1");
   }
-  for (auto itr = lanelet_ids.begin(); itr != lanelet_ids.end(); itr++) {
-    const auto lanelet = lanelet_map_ptr_->laneletLayer.get(*itr);
-    const auto limit = traffic_rules_vehicle_ptr_->speedLimit(lanelet);
-    limits.push_back(lanelet::units::KmHQuantity(limit.speedLimit).value() / 3.6);
+  for (const auto lanelet_id : lanelet_ids) {
+    limits.push_back(speed_limits_[getLaneletIndex(lanelet_id)]);
   }
   return *std::min_element(limits.begin(), limits.end());
 }
@@ -797,22 +1007,11 @@ auto HdMapUtils::getPreviousLanelets(const lanelet::Id lanelet_id, const double
   lanelet::Ids ret;
   double total_distance = 0.0;
   ret.push_back(lanelet_id);
-  while (total_distance < distance) {
-    auto ids = getPreviousLaneletIds(lanelet_id, "straight");
-    if (ids.size() != 0) {
-      total_distance = total_distance + getLaneletLength(ids[0]);
-      ret.push_back(ids[0]);
-      continue;
-    } else {
-      auto else_ids = getPreviousLaneletIds(lanelet_id);
-      if (else_ids.size() != 0) {
-        total_distance = total_distance + getLaneletLength(else_ids[0]);
-        ret.push_back(else_ids[0]);
-        continue;
-      } else {
-        break;
-      }
-    }
+  for (auto previous_id = previous_lanelets_along_[getLaneletIndex(lanelet_id)];
+       total_distance < distance and previous_id != lanelet::InvalId;
+       previous_id = previous_lanelets_along_[getLaneletIndex(previous_id)]) {
+    total_distance = total_distance + getLaneletLength(previous_id);
+    ret.push_back(previous_id);
   }
   return ret;
 }
@@ -871,22 +1070,11 @@ auto HdMapUtils::getFollowingLanelets(
   if (include_self) {
     ret.push_back(lanelet_id);
   }
-  lanelet::Id end_lanelet_id = lanelet_id;
-  while (total_distance < distance) {
-    if (const auto straight_ids = getNextLaneletIds(end_lanelet_id, "straight");
-        !straight_ids.empty()) {
-      total_distance = total_distance + getLaneletLength(straight_ids[0]);
-      ret.push_back(straight_ids[0]);
-      end_lanelet_id = straight_ids[0];
-      continue;
-    } else if (const auto ids = getNextLaneletIds(end_lanelet_id); ids.size() != 0) {
-      total_distance = total_distance + getLaneletLength(ids[0]);
-      ret.push_back(ids[0]);
-      end_lanelet_id = ids[0];
-      continue;
-    } else {
-      break;
-    }
+  for (auto next_id = next_lanelets_along_[getLaneletIndex(lanelet_id)];
+       total_distance < distance and next_id != lanelet::InvalId;
+       next_id = next_lanelets_along_[getLaneletIndex(next_id)]) {
+    total_distance = total_distance + getLaneletLength(next_id);
+    ret.push_back(next_id);
   }
   return ret;
 }
@@ -895,35 +1083,113 @@ auto HdMapUtils::getRoute(
   const lanelet::Id from_lanelet_id, const lanelet::Id to_lanelet_id, bool allow_lane_change) const
   -> lanelet::Ids
 {
-  if (route_cache_.exists(from_lanelet_id, to_lanelet_id, allow_lane_change)) {
-    return route_cache_.getRoute(from_lanelet_id, to_lanelet_id, allow_lane_change);
+  if (const auto route_table = std::atomic_load(&route_table_)) {
+    if (auto route = route_table->getRoute(from_lanelet_id, to_lanelet_id, allow_lane_change)) {
+      return std::move(route.value());
+    }
+  }
+  if (const auto cached_route =
+        route_cache_.getRoute(from_lanelet_id, to_lanelet_id, allow_lane_change)) {
+    return *cached_route;
   }
   lanelet::Ids ids;
   const auto lanelet = lanelet_map_ptr_->laneletLayer.get(from_lanelet_id);
   const auto to_lanelet = lanelet_map_ptr_->laneletLayer.get(to_lanelet_id);
   lanelet::Optional<lanelet::routing::Route> route =
     vehicle_routing_graph_ptr_->getRoute(lanelet, to_lanelet, 0, allow_lane_change);
-  if (!route) {
-    route_cache_.appendData(from_lanelet_id, to_lanelet_id, allow_lane_change, ids);
-    return ids;
+  if (route) {
+    lanelet::routing::LaneletPath shortest_path = route->shortestPath();
+    for (auto lane_itr = shortest_path.begin(); lane_itr != shortest_path.end(); lane_itr++) {
+      ids.push_back(lane_itr->id());
+    }
   }
-  lanelet::routing::LaneletPath shortest_path = route->shortestPath();
-  if (shortest_path.empty()) {
-    route_cache_.appendData(from_lanelet_id, to_lanelet_id, allow_lane_change, ids);
-    return ids;
+  return *route_cache_.appendData(from_lanelet_id, to_lanelet_id, allow_lane_change, ids);
+}
+
+auto HdMapUtils::enableRouteTable(const boost::filesystem::path & cache_path) -> void
+{
+  /**
+   * @note Costs follow the default distance cost of lanelet2 routing graphs : moving to a
+   * following lanelet costs the average length of both lanelets, and changing the lane costs a
+   * fixed distance.
+   */
+  constexpr double lane_change_cost = 10.0;
+
+  RouteTable::Graph graph;
+  for (const auto & lanelet : vehicle_routing_graph_ptr_->passableSubmap()->laneletLayer) {
+    graph.lanelet_ids.push_back(lanelet.id());
+  }
+  std::sort(graph.lanelet_ids.begin(), graph.lanelet_ids.end());
+
+  std::unordered_map<lanelet::Id, std::uint32_t> indices;
+  for (std::uint32_t index = 0; index < graph.lanelet_ids.size(); ++index) {
+    indices.emplace(graph.lanelet_ids[index], index);
+  }
+
+  auto & [edges_without_lane_change, edges_with_lane_change] = graph.edges;
+  edges_without_lane_change.resize(graph.lanelet_ids.size());
+  edges_with_lane_change.resize(graph.lanelet_ids.size());
+  for (std::uint32_t index = 0; index < graph.lanelet_ids.size(); ++index) {
+    const auto lanelet = lanelet_map_ptr_->laneletLayer.get(graph.lanelet_ids[index]);
+    for (const auto & following_lanelet : vehicle_routing_graph_ptr_->following(lanelet, false)) {
+      if (const auto iter = indices.find(following_lanelet.id()); iter != indices.end()) {
+        const RouteTable::Edge edge = {
+          iter->second,
+          (getLaneletLength(lanelet.id()) + getLaneletLength(following_lanelet.id())) * 0.5};
+        edges_without_lane_change[index].push_back(edge);
+        edges_with_lane_change[index].push_back(edge);
+      }
+    }
+    for (const auto & adjacent_lanelet :
+         {vehicle_routing_graph_ptr_->left(lanelet), vehicle_routing_graph_ptr_->right(lanelet)}) {
+      if (adjacent_lanelet) {
+        if (const auto iter = indices.find(adjacent_lanelet->id()); iter != indices.end()) {
+          edges_with_lane_change[index].push_back({iter->second, lane_change_cost});
+        }
+      }
+    }
   }
-  for (auto lane_itr = shortest_path.begin(); lane_itr != shortest_path.end(); lane_itr++) {
-    ids.push_back(lane_itr->id());
+
+  std::shared_ptr<const RouteTable> route_table;
+  if (cache_path.empty()) {
+    route_table = std::make_shared<const RouteTable>(graph);
+  } else if (auto loaded_table = RouteTable::load(cache_path, graph)) {
+    route_table = std::make_shared<const RouteTable>(std::move(loaded_table.value()));
+  } else {
+    route_table = std::make_shared<const RouteTable>(graph);
+    /// @note A read-only map directory is not an error, the table is rebuilt on the next load.
+    route_table->save(cache_path);
   }
-  route_cache_.appendData(from_lanelet_id, to_lanelet_id, allow_lane_change, ids);
-  return ids;
+  /// @note Stored atomically, the instance may be shared with components already querying routes.
+  std::atomic_store(&route_table_, route_table);
 }
 
 auto HdMapUtils::getCenterPointsSpline(const lanelet::Id lanelet_id) const
   -> std::shared_ptr<math::geometry::CatmullRomSpline>
 {
-  getCenterPoints(lanelet_id);
-  return center_points_cache_.getCenterPointsSpline(lanelet_id);
+  return getCenterPointsCacheEntry(lanelet_id).spline;
+}
+
+auto HdMapUtils::getElevationProfile(const lanelet::Id lanelet_id) const
+  -> std::shared_ptr<const ElevationProfile>
+{
+  if (auto elevation_profile = elevation_profile_cache_.find(lanelet_id)) {
+    return elevation_profile.value();
+  } else {
+    return elevation_profile_cache_.insert(
+      lanelet_id, std::make_shared<const ElevationProfile>(*getCenterPointsSpline(lanelet_id)));
+  }
+}
+
+auto HdMapUtils::getCenterPointsSpline(const lanelet::Ids & lanelet_ids) const
+  -> std::shared_ptr<math::geometry::CatmullRomSpline>
+{
+  if (auto spline = route_spline_cache_.find(lanelet_ids)) {
+    return spline;
+  }
+  /// @note Built without holding the lock of the cache, so other lookups are not blocked.
+  return route_spline_cache_.appendData(
+    lanelet_ids, std::make_shared<math::geometry::CatmullRomSpline>(getCenterPoints(lanelet_ids)));
 }
 
 auto HdMapUtils::getCenterPoints(const lanelet::Ids & lanelet_ids) const
@@ -934,7 +1200,7 @@ auto HdMapUtils::getCenterPoints(const lanelet::Ids & lanelet_ids) const
     return ret;
   }
   for (const auto lanelet_id : lanelet_ids) {
-    ret += getCenterPoints(lanelet_id);
+    ret += *getCenterPointsCacheEntry(lanelet_id).points;
   }
   ret.erase(std::unique(ret.begin(), ret.end()), ret.end());
   return ret;
@@ -943,17 +1209,29 @@ auto HdMapUtils::getCenterPoints(const lanelet::Ids & lanelet_ids) const
 auto HdMapUtils::getCenterPoints(const lanelet::Id lanelet_id) const
   -> std::vector<geometry_msgs::msg::Point>
 {
-  std::vector<geometry_msgs::msg::Point> ret;
+  return *getCenterPointsCacheEntry(lanelet_id).points;
+}
+
+auto HdMapUtils::getSharedCenterPoints(const lanelet::Id lanelet_id) const
+  -> std::shared_ptr<const std::vector<geometry_msgs::msg::Point>>
+{
+  return getCenterPointsCacheEntry(lanelet_id).points;
+}
+
+auto HdMapUtils::getCenterPointsCacheEntry(const lanelet::Id lanelet_id) const
+  -> CenterPointsCache::Entry
+{
   if (!lanelet_map_ptr_) {
     THROW_SIMULATION_ERROR("lanelet map is null pointer");
   }
   if (lanelet_map_ptr_->laneletLayer.empty()) {
     THROW_SIMULATION_ERROR("lanelet layer is empty");
   }
-  if (center_points_cache_.exists(lanelet_id)) {
-    return center_points_cache_.getCenterPoints(lanelet_id);
+  if (auto entry = center_points_cache_.find(lanelet_id)) {
+    return std::move(entry.value());
   }
 
+  std::vector<geometry_msgs::msg::Point> ret;
   const auto lanelet = lanelet_map_ptr_->laneletLayer.get(lanelet_id);
   const auto centerline = lanelet.centerline();
   for (const auto & point : centerline) {
@@ -975,18 +1253,12 @@ auto HdMapUtils::getCenterPoints(const lanelet::Id lanelet_id) const
     ret.push_back(p1);
     ret.push_back(p2);
   }
-  center_points_cache_.appendData(lanelet_id, ret);
-  return ret;
+  return center_points_cache_.appendData(lanelet_id, std::move(ret));
 }
 
 auto HdMapUtils::getLaneletLength(const lanelet::Id lanelet_id) const -> double
 {
-  if (lanelet_length_cache_.exists(lanelet_id)) {
-    return lanelet_length_cache_.getLength(lanelet_id);
-  }
-  double ret = lanelet::utils::getLaneletLength2d(lanelet_map_ptr_->laneletLayer.get(lanelet_id));
-  lanelet_length_cache_.appendData(lanelet_id, ret);
-  return ret;
+  return lanelet_lengths_[getLaneletIndex(lanelet_id)];
 }
 
 auto HdMapUtils::getPreviousRoadShoulderLanelet(const lanelet::Id lanelet_id) const -> lanelet::Ids
@@ -1003,14 +1275,13 @@ auto HdMapUtils::getPreviousRoadShoulderLanelet(const lanelet::Id lanelet_id) co
 
 auto HdMapUtils::getPreviousLaneletIds(const lanelet::Id lanelet_id) const -> lanelet::Ids
 {
+  const auto index = getLaneletIndex(lanelet_id);
+  const auto previous_lanelets = previous_lanelet_table_.row(index);
+  const auto previous_road_shoulders = previous_road_shoulder_table_.row(index);
   lanelet::Ids ids;
-  const auto lanelet = lanelet_map_ptr_->laneletLayer.get(lanelet_id);
-  for (const auto & llt : vehicle_routing_graph_ptr_->previous(lanelet)) {
-    ids.push_back(llt.id());
-  }
-  for (const auto & id : getPreviousRoadShoulderLanelet(lanelet_id)) {
-    ids.push_back(id);
-  }
+  ids.reserve(previous_lanelets.size() + previous_road_shoulders.size());
+  ids.insert(ids.end(), previous_lanelets.begin(), previous_lanelets.end());
+  ids.insert(ids.end(), previous_road_shoulders.begin(), previous_road_shoulders.end());
   return ids;
 }
 
@@ -1027,10 +1298,9 @@ auto HdMapUtils::getPreviousLaneletIds(
   const lanelet::Id lanelet_id, const std::string & turn_direction) const -> lanelet::Ids
 {
   lanelet::Ids ids;
-  const auto lanelet = lanelet_map_ptr_->laneletLayer.get(lanelet_id);
-  for (const auto & llt : vehicle_routing_graph_ptr_->previous(lanelet)) {
-    if (llt.attributeOr("turn_direction", "else") == turn_direction) {
-      ids.push_back(llt.id());
+  for (const auto id : previous_lanelet_table_.row(getLaneletIndex(lanelet_id))) {
+    if (turn_directions_[getLaneletIndex(id)] == turn_direction) {
+      ids.push_back(id);
     }
   }
   return ids;
@@ -1060,14 +1330,13 @@ auto HdMapUtils::getNextRoadShoulderLanelet(const lanelet::Id lanelet_id) const
 
 auto HdMapUtils::getNextLaneletIds(const lanelet::Id lanelet_id) const -> lanelet::Ids
 {
+  const auto index = getLaneletIndex(lanelet_id);
+  const auto following_lanelets = following_lanelet_table_.row(index);
+  const auto next_road_shoulders = next_road_shoulder_table_.row(index);
   lanelet::Ids ids;
-  const auto lanelet = lanelet_map_ptr_->laneletLayer.get(lanelet_id);
-  for (const auto & llt : vehicle_routing_graph_ptr_->following(lanelet)) {
-    ids.push_back(llt.id());
-  }
-  for (const auto & id : getNextRoadShoulderLanelet(lanelet_id)) {
-    ids.push_back(id);
-  }
+  ids.reserve(following_lanelets.size() + next_road_shoulders.size());
+  ids.insert(ids.end(), following_lanelets.begin(), following_lanelets.end());
+  ids.insert(ids.end(), next_road_shoulders.begin(), next_road_shoulders.end());
   return ids;
 }
 
@@ -1084,10 +1353,9 @@ auto HdMapUtils::getNextLaneletIds(
   const lanelet::Id lanelet_id, const std::string & turn_direction) const -> lanelet::Ids
 {
   lanelet::Ids ids;
-  const auto lanelet = lanelet_map_ptr_->laneletLayer.get(lanelet_id);
-  for (const auto & llt : vehicle_routing_graph_ptr_->following(lanelet)) {
-    if (llt.attributeOr("turn_direction", "else") == turn_direction) {
-      ids.push_back(llt.id());
+  for (const auto id : following_lanelet_table_.row(getLaneletIndex(lanelet_id))) {
+    if (turn_directions_[getLaneletIndex(id)] == turn_direction) {
+      ids.push_back(id);
     }
   }
   return ids;
@@ -1126,33 +1394,10 @@ auto HdMapUtils::getTrafficLightBulbPosition(
   const lanelet::Id traffic_light_id, const std::string & color_name) const
   -> std::optional<geometry_msgs::msg::Point>
 {
-  lanelet::ConstLanelets all_lanelets = lanelet::utils::query::laneletLayer(lanelet_map_ptr_);
-  auto autoware_traffic_lights = lanelet::utils::query::autowareTrafficLights(all_lanelets);
-
-  auto areBulbsAssignedToTrafficLight = [traffic_light_id](auto red_yellow_green_bulbs) -> bool {
-    return red_yellow_green_bulbs.hasAttribute("traffic_light_id") and
-           red_yellow_green_bulbs.attribute("traffic_light_id").asId() and
-           red_yellow_green_bulbs.attribute("traffic_light_id").asId().value() == traffic_light_id;
-  };
-
-  auto isBulbOfExpectedColor = [color_name](auto bulb) -> bool {
-    return bulb.hasAttribute("color") and !bulb.hasAttribute("arrow") and
-           bulb.attribute("color").value().compare(color_name) == 0;
-  };
-
-  for (const auto & light : autoware_traffic_lights) {
-    for (auto three_light_bulbs : light->lightBulbs()) {
-      if (areBulbsAssignedToTrafficLight(three_light_bulbs)) {
-        for (auto bulb : static_cast<lanelet::ConstLineString3d>(three_light_bulbs)) {
-          if (isBulbOfExpectedColor(bulb)) {
-            geometry_msgs::msg::Point point;
-            point.x = bulb.x();
-            point.y = bulb.y();
-            point.z = bulb.z();
-            return point;
-          }
-        }
-      }
+  if (const auto iter = traffic_light_bulb_positions_.find(traffic_light_id);
+      iter != traffic_light_bulb_positions_.end()) {
+    if (const auto bulb = iter->second.find(color_name); bulb != iter->second.end()) {
+      return bulb->second;
     }
   }
   return std::nullopt;
@@ -1199,13 +1444,58 @@ auto HdMapUtils::getAlongLaneletPose(
 auto HdMapUtils::getLeftBound(const lanelet::Id lanelet_id) const
   -> std::vector<geometry_msgs::msg::Point>
 {
-  return toPolygon(lanelet_map_ptr_->laneletLayer.get(lanelet_id).leftBound());
+  return getLeftLaneBound(lanelet_id)->getPoints();
+}
+
+auto HdMapUtils::getLeftLaneBound(const lanelet::Id lanelet_id) const
+  -> std::shared_ptr<const LaneBound>
+{
+  if (auto lane_bound = left_bound_cache_.find(lanelet_id)) {
+    return lane_bound.value();
+  } else {
+    return left_bound_cache_.insert(
+      lanelet_id, std::make_shared<const LaneBound>(
+                    toPolygon(lanelet_map_ptr_->laneletLayer.get(lanelet_id).leftBound())));
+  }
 }
 
 auto HdMapUtils::getRightBound(const lanelet::Id lanelet_id) const
   -> std::vector<geometry_msgs::msg::Point>
 {
-  return toPolygon(lanelet_map_ptr_->laneletLayer.get(lanelet_id).rightBound());
+  return getRightLaneBound(lanelet_id)->getPoints();
+}
+
+auto HdMapUtils::getRightLaneBound(const lanelet::Id lanelet_id) const
+  -> std::shared_ptr<const LaneBound>
+{
+  if (auto lane_bound = right_bound_cache_.find(lanelet_id)) {
+    return lane_bound.value();
+  } else {
+    return right_bound_cache_.insert(
+      lanelet_id, std::make_shared<const LaneBound>(
+                    toPolygon(lanelet_map_ptr_->laneletLayer.get(lanelet_id).rightBound())));
+  }
+}
+
+auto HdMapUtils::getAdjacentLaneletIds(
+  const lanelet::Ids & lanelet_ids, const traffic_simulator_msgs::msg::EntityType & type) const
+  -> lanelet::Ids
+{
+  auto adjacent_lanelet_ids = getNextLaneletIds(lanelet_ids);
+  adjacent_lanelet_ids += getPreviousLaneletIds(lanelet_ids);
+  for (const auto & lanelet_id : lanelet_ids) {
+    adjacent_lanelet_ids += getLeftLaneletIds(lanelet_id, type, false);
+    adjacent_lanelet_ids += getRightLaneletIds(lanelet_id, type, false);
+  }
+  adjacent_lanelet_ids = sortAndUnique(adjacent_lanelet_ids);
+  adjacent_lanelet_ids.erase(
+    std::remove_if(
+      adjacent_lanelet_ids.begin(), adjacent_lanelet_ids.end(),
+      [&](const auto lanelet_id) {
+        return std::find(lanelet_ids.begin(), lanelet_ids.end(), lanelet_id) != lanelet_ids.end();
+      }),
+    adjacent_lanelet_ids.end());
+  return adjacent_lanelet_ids;
 }
 
 auto HdMapUtils::getLeftLaneletIds(
@@ -1339,6 +1629,17 @@ auto HdMapUtils::getLaneChangeTrajectory(
   const double forward_distance_threshold) const
   -> std::optional<std::pair<math::geometry::HermiteCurve, double>>
 {
+  if (const auto cached_target_s = lane_change_trajectory_cache_.getTargetS(
+        from_pose, lane_change_parameter, maximum_curvature_threshold, target_trajectory_length,
+        forward_distance_threshold)) {
+    if (not cached_target_s.value()) {
+      return std::nullopt;
+    }
+    return std::make_pair(
+      getLaneChangeTrajectory(from_pose, lane_change_parameter, cached_target_s->value()),
+      cached_target_s->value());
+  }
+
   double to_length = getLaneletLength(lane_change_parameter.target.lanelet_id);
   std::vector<double> evaluation, target_s;
   std::vector<math::geometry::HermiteCurve> curves;
@@ -1351,15 +1652,7 @@ auto HdMapUtils::getLaneChangeTrajectory(
       forward_distance_threshold) {
       continue;
     }
-    double start_to_goal_distance = std::sqrt(
-      std::pow(from_pose.position.x - goal_pose.pose.position.x, 2) +
-      std::pow(from_pose.position.y - goal_pose.pose.position.y, 2) +
-      std::pow(from_pose.position.z - goal_pose.pose.position.z, 2));
-    traffic_simulator_msgs::msg::LaneletPose to_pose;
-    to_pose.lanelet_id = lane_change_parameter.target.lanelet_id;
-    to_pose.s = to_s;
-    auto traj = getLaneChangeTrajectory(
-      from_pose, to_pose, lane_change_parameter.trajectory_shape, start_to_goal_distance * 0.5);
+    auto traj = getLaneChangeTrajectory(from_pose, lane_change_parameter, to_s);
     if (traj.getMaximum2DCurvature() < maximum_curvature_threshold) {
       double eval = std::fabs(target_trajectory_length - traj.getLength());
       evaluation.push_back(eval);
@@ -1368,13 +1661,35 @@ auto HdMapUtils::getLaneChangeTrajectory(
     }
   }
   if (evaluation.empty()) {
+    lane_change_trajectory_cache_.appendData(
+      from_pose, lane_change_parameter, maximum_curvature_threshold, target_trajectory_length,
+      forward_distance_threshold, std::nullopt);
     return std::nullopt;
   }
   std::vector<double>::iterator min_itr = std::min_element(evaluation.begin(), evaluation.end());
   size_t min_index = std::distance(evaluation.begin(), min_itr);
+  lane_change_trajectory_cache_.appendData(
+    from_pose, lane_change_parameter, maximum_curvature_threshold, target_trajectory_length,
+    forward_distance_threshold, target_s[min_index]);
   return std::make_pair(curves[min_index], target_s[min_index]);
 }
 
+auto HdMapUtils::getLaneChangeTrajectory(
+  const geometry_msgs::msg::Pose & from_pose,
+  const traffic_simulator::lane_change::Parameter & lane_change_parameter, const double to_s) const
+  -> math::geometry::HermiteCurve
+{
+  const auto to_pose =
+    traffic_simulator::helper::constructLaneletPose(lane_change_parameter.target.lanelet_id, to_s);
+  const auto goal_pose = toMapPose(to_pose).pose;
+  double start_to_goal_distance = std::sqrt(
+    std::pow(from_pose.position.x - goal_pose.position.x, 2) +
+    std::pow(from_pose.position.y - goal_pose.position.y, 2) +
+    std::pow(from_pose.position.z - goal_pose.position.z, 2));
+  return getLaneChangeTrajectory(
+    from_pose, to_pose, lane_change_parameter.trajectory_shape, start_to_goal_distance * 0.5);
+}
+
 auto HdMapUtils::getLaneChangeTrajectory(
   const geometry_msgs::msg::Pose & from_pose,
   const traffic_simulator_msgs::msg::LaneletPose & to_pose,
@@ -1444,25 +1759,12 @@ auto HdMapUtils::toMapPose(
   const traffic_simulator_msgs::msg::LaneletPose & lanelet_pose, const bool fill_pitch) const
   -> geometry_msgs::msg::PoseStamped
 {
-  using math::geometry::operator*;
-  using math::geometry::operator+=;
   if (
     const auto pose = std::get<std::optional<traffic_simulator_msgs::msg::LaneletPose>>(
       canonicalizeLaneletPose(lanelet_pose))) {
     geometry_msgs::msg::PoseStamped ret;
     ret.header.frame_id = "map";
-    const auto spline = getCenterPointsSpline(pose->lanelet_id);
-    ret.pose = spline->getPose(pose->s);
-    const auto normal_vec = spline->getNormalVector(pose->s);
-    const auto diff = math::geometry::normalize(normal_vec) * pose->offset;  //this
-    ret.pose.position += diff;
-    const auto tangent_vec = spline->getTangentVector(pose->s);
-    geometry_msgs::msg::Vector3 rpy;
-    rpy.x = 0.0;
-    rpy.y = fill_pitch ? std::atan2(-tangent_vec.z, std::hypot(tangent_vec.x, tangent_vec.y)) : 0.0;
-    rpy.z = std::atan2(tangent_vec.y, tangent_vec.x);
-    ret.pose.orientation = math::geometry::convertEulerAngleToQuaternion(rpy) *
-                           math::geometry::convertEulerAngleToQuaternion(pose->rpy);
+    ret.pose = toMapPose(pose.value(), *getCenterPointsSpline(pose->lanelet_id), fill_pitch);
     return ret;
   } else {
     THROW_SEMANTIC_ERROR(
@@ -1472,6 +1774,75 @@ auto HdMapUtils::toMapPose(
   }
 }
 
+auto HdMapUtils::toMapPose(
+  const traffic_simulator_msgs::msg::LaneletPose & lanelet_pose,
+  const math::geometry::CatmullRomSpline & spline, const bool fill_pitch) const
+  -> geometry_msgs::msg::Pose
+{
+  using math::geometry::operator*;
+  using math::geometry::operator+=;
+  auto pose = spline.getPose(lanelet_pose.s);
+  const auto normal_vec = spline.getNormalVector(lanelet_pose.s);
+  const auto diff = math::geometry::normalize(normal_vec) * lanelet_pose.offset;
+  pose.position += diff;
+  const auto tangent_vec = spline.getTangentVector(lanelet_pose.s);
+  geometry_msgs::msg::Vector3 rpy;
+  rpy.x = 0.0;
+  rpy.y = fill_pitch ? std::atan2(-tangent_vec.z, std::hypot(tangent_vec.x, tangent_vec.y)) : 0.0;
+  rpy.z = std::atan2(tangent_vec.y, tangent_vec.x);
+  pose.orientation = math::geometry::convertEulerAngleToQuaternion(rpy) *
+                     math::geometry::convertEulerAngleToQuaternion(lanelet_pose.rpy);
+  return pose;
+}
+
+auto HdMapUtils::toLaneletPoses(
+  const std::vector<geometry_msgs::msg::Pose> & poses, const bool include_crosswalk,
+  const double matching_distance, const std::size_t thread_count) const
+  -> std::vector<std::optional<traffic_simulator_msgs::msg::LaneletPose>>
+{
+  std::vector<std::optional<traffic_simulator_msgs::msg::LaneletPose>> lanelet_poses(poses.size());
+  parallelFor(poses.size(), thread_count, [&](const std::size_t begin, const std::size_t end) {
+    for (auto i = begin; i < end; ++i) {
+      lanelet_poses[i] = toLaneletPose(poses[i], include_crosswalk, matching_distance);
+    }
+  });
+  return lanelet_poses;
+}
+
+auto HdMapUtils::toMapPoses(
+  const std::vector<traffic_simulator_msgs::msg::LaneletPose> & lanelet_poses,
+  const bool fill_pitch, const std::size_t thread_count) const
+  -> std::vector<geometry_msgs::msg::PoseStamped>
+{
+  /// @note Visited in lanelet id order, so consecutive lanelet poses reuse the same spline.
+  std::vector<std::size_t> order(lanelet_poses.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](const auto lhs, const auto rhs) {
+    return lanelet_poses[lhs].lanelet_id < lanelet_poses[rhs].lanelet_id;
+  });
+
+  std::vector<geometry_msgs::msg::PoseStamped> map_poses(lanelet_poses.size());
+  parallelFor(order.size(), thread_count, [&](const std::size_t begin, const std::size_t end) {
+    std::optional<lanelet::Id> spline_lanelet_id;
+    std::shared_ptr<math::geometry::CatmullRomSpline> spline;
+    for (auto i = begin; i < end; ++i) {
+      const auto & lanelet_pose = lanelet_poses[order[i]];
+      auto & map_pose = map_poses[order[i]];
+      if (lanelet_pose.s < 0 or getLaneletLength(lanelet_pose.lanelet_id) < lanelet_pose.s) {
+        map_pose = toMapPose(lanelet_pose, fill_pitch);
+        continue;
+      }
+      if (spline_lanelet_id != lanelet_pose.lanelet_id) {
+        spline = getCenterPointsSpline(lanelet_pose.lanelet_id);
+        spline_lanelet_id = lanelet_pose.lanelet_id;
+      }
+      map_pose.header.frame_id = "map";
+      map_pose.pose = toMapPose(lanelet_pose, *spline, fill_pitch);
+    }
+  });
+  return map_poses;
+}
+
 auto HdMapUtils::getTangentVector(const lanelet::Id lanelet_id, const double s) const
   -> std::optional<geometry_msgs::msg::Vector3>
 {
@@ -1543,6 +1914,38 @@ auto HdMapUtils::getLongitudinalDistance(
       return to.s - from.s;
     }
   }
+
+  /**
+   * @note The distance between the origins of the two lanelets only depends on the route, so it
+   * is computed once per pair of lanelets, and the conditions evaluated every frame only add the s
+   * of the poses while the entities stay on the same lanelets.
+   */
+  const auto key = std::make_tuple(from.lanelet_id, to.lanelet_id, allow_lane_change);
+  auto distance = longitudinal_distance_cache_.find(key);
+  if (not distance) {
+    distance = longitudinal_distance_cache_.insert(
+      key,
+      getLongitudinalDistanceBetweenOrigins(from.lanelet_id, to.lanelet_id, allow_lane_change));
+  }
+  if (distance.value()) {
+    return distance.value().value() - from.s + to.s;
+  } else {
+    return std::nullopt;
+  }
+}
+
+auto HdMapUtils::getLongitudinalDistanceBetweenOrigins(
+  const lanelet::Id from_lanelet_id, const lanelet::Id to_lanelet_id,
+  const bool allow_lane_change) const -> std::optional<double>
+{
+  traffic_simulator_msgs::msg::LaneletPose from;
+  from.lanelet_id = from_lanelet_id;
+  from.s = 0.0;
+
+  traffic_simulator_msgs::msg::LaneletPose to;
+  to.lanelet_id = to_lanelet_id;
+  to.s = 0.0;
+
   const auto route = getRoute(from.lanelet_id, to.lanelet_id, allow_lane_change);
   if (route.empty()) {
     return std::nullopt;
@@ -1629,6 +2032,24 @@ auto HdMapUtils::toMapBin() const -> autoware_auto_mapping_msgs::msg::HADMapBin
   return msg;
 }
 
+auto HdMapUtils::getSharedMapBin() const
+  -> std::shared_ptr<const autoware_auto_mapping_msgs::msg::HADMapBin>
+{
+  std::call_once(map_bin_once_, [this]() {
+    map_bin_ = std::make_shared<const autoware_auto_mapping_msgs::msg::HADMapBin>(toMapBin());
+  });
+  return map_bin_;
+}
+
+auto HdMapUtils::getSharedMarker() const
+  -> std::shared_ptr<const visualization_msgs::msg::MarkerArray>
+{
+  std::call_once(marker_once_, [this]() {
+    marker_ = std::make_shared<const visualization_msgs::msg::MarkerArray>(generateMarker());
+  });
+  return marker_;
+}
+
 auto HdMapUtils::insertMarkerArray(
   visualization_msgs::msg::MarkerArray & a1, const visualization_msgs::msg::MarkerArray & a2) const
   -> void
@@ -1698,12 +2119,30 @@ auto HdMapUtils::generateMarker() const -> visualization_msgs::msg::MarkerArray
 
 auto HdMapUtils::overwriteLaneletsCenterline() -> void
 {
+  std::vector<lanelet::Lanelet> lanelets;
   for (auto & lanelet_obj : lanelet_map_ptr_->laneletLayer) {
     if (!lanelet_obj.hasCustomCenterline()) {
-      const auto fine_center_line = generateFineCenterline(lanelet_obj, 2.0);
-      lanelet_obj.setCenterline(fine_center_line);
+      lanelets.push_back(lanelet_obj);
     }
   }
+  /*
+     The points are generated in parallel, and then given their ids in the
+     order of the lanelet layer, so that the ids are the same as generating
+     them one lanelet after another.
+  */
+  std::vector<lanelet::BasicPoints3d> fine_center_lines(lanelets.size());
+  traffic_simulator::ThreadPool(std::max(1u, std::thread::hardware_concurrency()))
+    .parallelFor(lanelets.size(), [&](const std::size_t index) {
+      fine_center_lines[index] = generateFineCenterline(lanelets[index], 2.0);
+    });
+  for (std::size_t index = 0; index < lanelets.size(); ++index) {
+    lanelet::LineString3d centerline(lanelet::utils::getId());
+    for (const auto & point : fine_center_lines[index]) {
+      centerline.push_back(
+        lanelet::Point3d(lanelet::utils::getId(), point.x(), point.y(), point.z()));
+    }
+    lanelets[index].setCenterline(centerline);
+  }
 }
 
 auto HdMapUtils::findNearestIndexPair(
@@ -1746,16 +2185,7 @@ auto HdMapUtils::getRightOfWayLaneletIds(const lanelet::Ids & lanelet_ids) const
 
 auto HdMapUtils::getRightOfWayLaneletIds(const lanelet::Id lanelet_id) const -> lanelet::Ids
 {
-  lanelet::Ids ids;
-  for (const auto & right_of_way :
-       lanelet_map_ptr_->laneletLayer.get(lanelet_id).regulatoryElementsAs<lanelet::RightOfWay>()) {
-    for (const auto & ll : right_of_way->rightOfWayLanelets()) {
-      if (lanelet_id != ll.id()) {
-        ids.push_back(ll.id());
-      }
-    }
-  }
-  return ids;
+  return right_of_way_table_.ids(getLaneletIndex(lanelet_id));
 }
 
 auto HdMapUtils::getTrafficSignRegulatoryElementsOnPath(const lanelet::Ids & lanelet_ids) const
@@ -1840,12 +2270,23 @@ auto HdMapUtils::getStopLineIds() const -> lanelet::Ids
 auto HdMapUtils::getStopLineIdsOnPath(const lanelet::Ids & route_lanelets) const -> lanelet::Ids
 {
   lanelet::Ids stop_line_ids;
-  for (const auto & ret : getStopLinesOnPath(route_lanelets)) {
-    stop_line_ids.push_back(ret.id());
+  for (const auto & lanelet_id : route_lanelets) {
+    const auto row = stop_line_table_.row(getLaneletIndex(lanelet_id));
+    stop_line_ids.insert(stop_line_ids.end(), row.begin(), row.end());
   }
   return stop_line_ids;
 }
 
+auto HdMapUtils::getStopLinePoints(const lanelet::Id stop_line_id) const
+  -> const std::vector<geometry_msgs::msg::Point> &
+{
+  if (const auto iter = stop_line_points_.find(stop_line_id); iter != stop_line_points_.end()) {
+    return iter->second;
+  } else {
+    THROW_SEMANTIC_ERROR("stop_line_id does not match. ID : ", stop_line_id);
+  }
+}
+
 auto HdMapUtils::getTrafficLights(const lanelet::Id traffic_light_id) const
   -> std::vector<lanelet::AutowareTrafficLightConstPtr>
 {
@@ -1883,23 +2324,18 @@ auto HdMapUtils::getTrafficLightStopLineIds(const lanelet::Id traffic_light_id)
 auto HdMapUtils::getTrafficLightStopLinesPoints(const lanelet::Id traffic_light_id) const
   -> std::vector<std::vector<geometry_msgs::msg::Point>>
 {
-  std::vector<std::vector<geometry_msgs::msg::Point>> ret;
-  const auto traffic_lights = getTrafficLights(traffic_light_id);
-  for (const auto & traffic_light : traffic_lights) {
-    ret.emplace_back(std::vector<geometry_msgs::msg::Point>{});
-    const auto stop_line = traffic_light->stopLine();
-    if (stop_line) {
-      auto & current_stop_line = ret.back();
-      for (const auto & point : stop_line.value()) {
-        geometry_msgs::msg::Point p;
-        p.x = point.x();
-        p.y = point.y();
-        p.z = point.z();
-        current_stop_line.emplace_back(p);
-      }
-    }
+  return getTrafficLightStopLinesPointsReference(traffic_light_id);
+}
+
+auto HdMapUtils::getTrafficLightStopLinesPointsReference(const lanelet::Id traffic_light_id) const
+  -> const std::vector<std::vector<geometry_msgs::msg::Point>> &
+{
+  if (const auto iter = traffic_light_stop_lines_points_.find(traffic_light_id);
+      iter != traffic_light_stop_lines_points_.end()) {
+    return iter->second;
+  } else {
+    THROW_SEMANTIC_ERROR("traffic_light_id does not match. ID : ", traffic_light_id);
   }
-  return ret;
 }
 
 auto HdMapUtils::getStopLinePolygon(const lanelet::Id lanelet_id) const
@@ -1920,14 +2356,9 @@ auto HdMapUtils::getStopLinePolygon(const lanelet::Id lanelet_id) const
 auto HdMapUtils::getTrafficLightIdsOnPath(const lanelet::Ids & route_lanelets) const -> lanelet::Ids
 {
   lanelet::Ids ids;
-  for (const auto & traffic_light : getTrafficLightRegulatoryElementsOnPath(route_lanelets)) {
-    for (auto light_string : traffic_light->lightBulbs()) {
-      if (light_string.hasAttribute("traffic_light_id")) {
-        if (auto id = light_string.attribute("traffic_light_id").asId(); id) {
-          ids.push_back(id.value());
-        }
-      }
-    }
+  for (const auto & lanelet_id : route_lanelets) {
+    const auto row = traffic_light_table_.row(getLaneletIndex(lanelet_id));
+    ids.insert(ids.end(), row.begin(), row.end());
   }
   return ids;
 }
@@ -1936,7 +2367,8 @@ auto HdMapUtils::getDistanceToTrafficLightStopLine(
   const lanelet::Ids & route_lanelets,
   const std::vector<geometry_msgs::msg::Point> & waypoints) const -> std::optional<double>
 {
-  auto traffic_light_ids = getTrafficLightIdsOnPath(route_lanelets);
+  /// @note Traffic lights shared by several route lanelets only need to be checked once.
+  const auto traffic_light_ids = sortAndUnique(getTrafficLightIdsOnPath(route_lanelets));
   if (traffic_light_ids.empty()) {
     return std::nullopt;
   }
@@ -1957,7 +2389,8 @@ auto HdMapUtils::getDistanceToTrafficLightStopLine(
   const lanelet::Ids & route_lanelets,
   const math::geometry::CatmullRomSplineInterface & spline) const -> std::optional<double>
 {
-  auto traffic_light_ids = getTrafficLightIdsOnPath(route_lanelets);
+  /// @note Traffic lights shared by several route lanelets only need to be checked once.
+  const auto traffic_light_ids = sortAndUnique(getTrafficLightIdsOnPath(route_lanelets));
   if (traffic_light_ids.empty()) {
     return std::nullopt;
   }
@@ -1982,8 +2415,7 @@ auto HdMapUtils::getDistanceToTrafficLightStopLine(
     return std::nullopt;
   }
   math::geometry::CatmullRomSpline spline(waypoints);
-  const auto stop_lines = getTrafficLightStopLinesPoints(traffic_light_id);
-  for (const auto & stop_line : stop_lines) {
+  for (const auto & stop_line : getTrafficLightStopLinesPointsReference(traffic_light_id)) {
     const auto collision_point = spline.getCollisionPointIn2D(stop_line);
     if (collision_point) {
       return collision_point;
@@ -1999,8 +2431,7 @@ auto HdMapUtils::getDistanceToTrafficLightStopLine(
   if (spline.getLength() <= 0) {
     return std::nullopt;
   }
-  const auto stop_lines = getTrafficLightStopLinesPoints(traffic_light_id);
-  for (const auto & stop_line : stop_lines) {
+  for (const auto & stop_line : getTrafficLightStopLinesPointsReference(traffic_light_id)) {
     const auto collision_point = spline.getCollisionPointIn2D(stop_line);
     if (collision_point) {
       return collision_point;
@@ -2021,17 +2452,8 @@ auto HdMapUtils::getDistanceToStopLine(
     return std::nullopt;
   }
   math::geometry::CatmullRomSpline spline(waypoints);
-  const auto stop_lines = getStopLinesOnPath({route_lanelets});
-  for (const auto & stop_line : stop_lines) {
-    std::vector<geometry_msgs::msg::Point> stop_line_points;
-    for (const auto & point : stop_line) {
-      geometry_msgs::msg::Point p;
-      p.x = point.x();
-      p.y = point.y();
-      p.z = point.z();
-      stop_line_points.emplace_back(p);
-    }
-    const auto collision_point = spline.getCollisionPointIn2D(stop_line_points);
+  for (const auto stop_line_id : sortAndUnique(getStopLineIdsOnPath(route_lanelets))) {
+    const auto collision_point = spline.getCollisionPointIn2D(getStopLinePoints(stop_line_id));
     if (collision_point) {
       collision_points.insert(collision_point.value());
     }
@@ -2050,17 +2472,8 @@ auto HdMapUtils::getDistanceToStopLine(
     return std::nullopt;
   }
   std::set<double> collision_points;
-  const auto stop_lines = getStopLinesOnPath({route_lanelets});
-  for (const auto & stop_line : stop_lines) {
-    std::vector<geometry_msgs::msg::Point> stop_line_points;
-    for (const auto & point : stop_line) {
-      geometry_msgs::msg::Point p;
-      p.x = point.x();
-      p.y = point.y();
-      p.z = point.z();
-      stop_line_points.emplace_back(p);
-    }
-    const auto collision_point = spline.getCollisionPointIn2D(stop_line_points);
+  for (const auto stop_line_id : sortAndUnique(getStopLineIdsOnPath(route_lanelets))) {
+    const auto collision_point = spline.getCollisionPointIn2D(getStopLinePoints(stop_line_id));
     if (collision_point) {
       collision_points.insert(collision_point.value());
     }
@@ -2083,6 +2496,82 @@ auto HdMapUtils::calculateSegmentDistances(const lanelet::ConstLineString3d & li
   return segment_distances;
 }
 
+auto HdMapUtils::calculateConflictingLaneIds(const lanelet::ConstLanelet & lanelet) const
+  -> lanelet::Ids
+{
+  lanelet::Ids ids;
+  const auto conflicting_lanelets =
+    lanelet::utils::getConflictingLanelets(vehicle_routing_graph_ptr_, lanelet);
+  for (const auto & conflicting_lanelet : conflicting_lanelets) {
+    ids.emplace_back(conflicting_lanelet.id());
+  }
+  return ids;
+}
+
+auto HdMapUtils::calculateConflictingCrosswalkIds(const lanelet::ConstLanelet & lanelet) const
+  -> lanelet::Ids
+{
+  lanelet::Ids ids;
+  std::vector<lanelet::routing::RoutingGraphConstPtr> graphs;
+  graphs.emplace_back(vehicle_routing_graph_ptr_);
+  graphs.emplace_back(pedestrian_routing_graph_ptr_);
+  lanelet::routing::RoutingGraphContainer container(graphs);
+  double height_clearance = 4;
+  size_t routing_graph_id = 1;
+  const auto conflicting_crosswalks =
+    container.conflictingInGraph(lanelet, routing_graph_id, height_clearance);
+  for (const auto & crosswalk : conflicting_crosswalks) {
+    ids.emplace_back(crosswalk.id());
+  }
+  return ids;
+}
+
+auto HdMapUtils::calculateRightOfWayLaneletIds(const lanelet::ConstLanelet & lanelet) const
+  -> lanelet::Ids
+{
+  lanelet::Ids ids;
+  for (const auto & right_of_way : lanelet.regulatoryElementsAs<lanelet::RightOfWay>()) {
+    for (const auto & ll : right_of_way->rightOfWayLanelets()) {
+      if (lanelet.id() != ll.id()) {
+        ids.push_back(ll.id());
+      }
+    }
+  }
+  return ids;
+}
+
+auto HdMapUtils::createAdjacencyTable(
+  const std::function<lanelet::Ids(const lanelet::ConstLanelet &)> & calculate) const
+  -> AdjacencyTable
+{
+  std::vector<lanelet::Ids> rows;
+  rows.reserve(lanelet_index_.size());
+  for (const auto lanelet_id : lanelet_index_.ids()) {
+    rows.push_back(calculate(lanelet_map_ptr_->laneletLayer.get(lanelet_id)));
+  }
+  return AdjacencyTable(rows);
+}
+
+auto HdMapUtils::getLaneletIndex(const lanelet::Id lanelet_id) const -> LaneletIndex::Index
+{
+  if (const auto index = lanelet_index_.find(lanelet_id)) {
+    return index.value();
+  } else {
+    lanelet_map_ptr_->laneletLayer.get(lanelet_id);
+    THROW_SIMULATION_ERROR("Lanelet ", lanelet_id, " is not in the lanelet index.");
+  }
+}
+
+auto HdMapUtils::createCenterlineIndex() const -> CenterlineIndex
+{
+  std::vector<std::pair<lanelet::Id, std::vector<geometry_msgs::msg::Point>>> centerlines;
+  centerlines.reserve(lanelet_map_ptr_->laneletLayer.size());
+  for (const auto & lanelet : lanelet_map_ptr_->laneletLayer) {
+    centerlines.emplace_back(lanelet.id(), *getCenterPointsCacheEntry(lanelet.id()).points);
+  }
+  return CenterlineIndex(centerlines);
+}
+
 auto HdMapUtils::calculateAccumulatedLengths(const lanelet::ConstLineString3d & line_string) const
   -> std::vector<double>
 {
@@ -2132,7 +2621,8 @@ auto HdMapUtils::resamplePoints(
 }
 
 auto HdMapUtils::generateFineCenterline(
-  const lanelet::ConstLanelet & lanelet_obj, const double resolution) const -> lanelet::LineString3d
+  const lanelet::ConstLanelet & lanelet_obj, const double resolution) const
+  -> lanelet::BasicPoints3d
 {
   // Get length of longer border
   const double left_length =
@@ -2148,14 +2638,10 @@ auto HdMapUtils::generateFineCenterline(
   const auto right_points = resamplePoints(lanelet_obj.rightBound(), num_segments);
 
   // Create centerline
-  lanelet::LineString3d centerline(lanelet::utils::getId());
+  lanelet::BasicPoints3d centerline;
   for (size_t i = 0; i < static_cast<size_t>(num_segments + 1); i++) {
-    // Add ID for the average point of left and right
-    const auto center_basic_point = (right_points.at(i) + left_points.at(i)) / 2.0;
-    const lanelet::Point3d center_point(
-      lanelet::utils::getId(), center_basic_point.x(), center_basic_point.y(),
-      center_basic_point.z());
-    centerline.push_back(center_point);
+    // The average point of left and right
+    centerline.push_back((right_points.at(i) + left_points.at(i)) / 2.0);
   }
   return centerline;
 }
@@ -2218,18 +2704,12 @@ auto HdMapUtils::getTrafficLightRegulatoryElementIDsFromTrafficLight(
   const lanelet::Id traffic_light_way_id) const -> lanelet::Ids
 {
   assert(isTrafficLight(traffic_light_way_id));
-  lanelet::Ids traffic_light_regulatory_element_ids;
-  for (const auto & regulatory_element : lanelet_map_ptr_->regulatoryElementLayer) {
-    if (regulatory_element->attribute(lanelet::AttributeName::Subtype).value() == "traffic_light") {
-      for (const auto & ref_member :
-           regulatory_element->getParameters<lanelet::ConstLineString3d>("refers")) {
-        if (ref_member.id() == traffic_light_way_id) {
-          traffic_light_regulatory_element_ids.push_back(regulatory_element->id());
-        }
-      }
-    }
+  if (const auto iter = traffic_light_regulatory_element_ids_.find(traffic_light_way_id);
+      iter != traffic_light_regulatory_element_ids_.end()) {
+    return iter->second;
+  } else {
+    return {};
   }
-  return traffic_light_regulatory_element_ids;
 }
 
 auto HdMapUtils::toPolygon(const lanelet::ConstLineString3d & line_string) const
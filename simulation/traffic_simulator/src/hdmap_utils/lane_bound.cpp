@@ -0,0 +1,161 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <traffic_simulator/hdmap_utils/lane_bound.hpp>
+
+namespace hdmap_utils
+{
+namespace
+{
+using Point = geometry_msgs::msg::Point;
+
+auto distance2D(const Point & a, const Point & b) -> double
+{
+  return std::hypot(a.x - b.x, a.y - b.y);
+}
+
+auto cross(const Point & origin, const Point & a, const Point & b) -> double
+{
+  return (a.x - origin.x) * (b.y - origin.y) - (a.y - origin.y) * (b.x - origin.x);
+}
+
+auto pointToSegmentDistance2D(const Point & point, const Point & a, const Point & b) -> double
+{
+  const auto dx = b.x - a.x;
+  const auto dy = b.y - a.y;
+  if (const auto squared_length = dx * dx + dy * dy; squared_length == 0.0) {
+    return distance2D(point, a);
+  } else {
+    const auto t =
+      std::clamp(((point.x - a.x) * dx + (point.y - a.y) * dy) / squared_length, 0.0, 1.0);
+    return std::hypot(point.x - (a.x + t * dx), point.y - (a.y + t * dy));
+  }
+}
+
+auto intersects(const Point & a0, const Point & a1, const Point & b0, const Point & b1) -> bool
+{
+  const auto on_segment = [](const Point & a, const Point & b, const Point & point) {
+    return std::min(a.x, b.x) <= point.x and point.x <= std::max(a.x, b.x) and
+           std::min(a.y, b.y) <= point.y and point.y <= std::max(a.y, b.y);
+  };
+  const auto d0 = cross(b0, b1, a0);
+  const auto d1 = cross(b0, b1, a1);
+  const auto d2 = cross(a0, a1, b0);
+  const auto d3 = cross(a0, a1, b1);
+  if ((d0 > 0) != (d1 > 0) and d0 != 0 and d1 != 0 and (d2 > 0) != (d3 > 0) and d2 != 0 and
+      d3 != 0) {
+    return true;
+  } else {
+    return (d0 == 0 and on_segment(b0, b1, a0)) or (d1 == 0 and on_segment(b0, b1, a1)) or
+           (d2 == 0 and on_segment(a0, a1, b0)) or (d3 == 0 and on_segment(a0, a1, b1));
+  }
+}
+
+auto segmentToSegmentDistance2D(
+  const Point & a0, const Point & a1, const Point & b0, const Point & b1) -> double
+{
+  if (intersects(a0, a1, b0, b1)) {
+    return 0.0;
+  } else {
+    return std::min(
+      {pointToSegmentDistance2D(a0, b0, b1), pointToSegmentDistance2D(a1, b0, b1),
+       pointToSegmentDistance2D(b0, a0, a1), pointToSegmentDistance2D(b1, a0, a1)});
+  }
+}
+
+auto segmentToPolygonDistance2D(
+  const Point & a0, const Point & a1, const std::vector<Point> & polygon) -> double
+{
+  auto distance = std::numeric_limits<double>::max();
+  for (std::size_t i = 0; i < polygon.size(); ++i) {
+    distance = std::min(
+      distance, segmentToSegmentDistance2D(a0, a1, polygon[i], polygon[(i + 1) % polygon.size()]));
+  }
+  return distance;
+}
+
+auto isInside(const Point & point, const std::vector<Point> & polygon) -> bool
+{
+  bool inside = false;
+  for (std::size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+    if (
+      (polygon[i].y > point.y) != (polygon[j].y > point.y) and
+      point.x < (polygon[j].x - polygon[i].x) * (point.y - polygon[i].y) /
+                    (polygon[j].y - polygon[i].y) +
+                  polygon[i].x) {
+      inside = not inside;
+    }
+  }
+  return inside;
+}
+}  // namespace
+
+LaneBound::LaneBound(const std::vector<geometry_msgs::msg::Point> & points) : points_(points)
+{
+  arc_lengths_.reserve(points_.size());
+  for (std::size_t i = 0; i < points_.size(); ++i) {
+    arc_lengths_.push_back(
+      i == 0 ? 0.0 : arc_lengths_.back() + distance2D(points_[i - 1], points_[i]));
+  }
+}
+
+auto LaneBound::getDistance2D(const std::vector<geometry_msgs::msg::Point> & polygon) const
+  -> double
+{
+  if (points_.empty() or polygon.empty()) {
+    return std::numeric_limits<double>::max();
+  } else if (isInside(points_.front(), polygon)) {
+    return 0.0;
+  } else if (points_.size() == 1) {
+    return segmentToPolygonDistance2D(points_.front(), points_.front(), polygon);
+  }
+
+  /// @note Every point of the polygon is within the radius from the center.
+  Point center;
+  for (const auto & point : polygon) {
+    center.x += point.x / polygon.size();
+    center.y += point.y / polygon.size();
+  }
+  double radius = 0.0;
+  for (const auto & point : polygon) {
+    radius = std::max(radius, distance2D(center, point));
+  }
+
+  auto distance = std::numeric_limits<double>::max();
+  for (std::size_t i = 0; i + 1 < points_.size();) {
+    /**
+     * @note A point of the polyline at an arc length t past the point i is at least
+     * distance2D(center, points_[i]) - t away from the center, so the segments ending within the
+     * margin cannot be closer to the polygon than the distance found so far.
+     */
+    if (const auto margin = distance2D(center, points_[i]) - radius - distance;
+        margin >= arc_lengths_[i + 1] - arc_lengths_[i]) {
+      const auto next = std::upper_bound(
+        arc_lengths_.begin() + i + 1, arc_lengths_.end(), arc_lengths_[i] + margin);
+      i = std::max<std::size_t>(i + 1, std::distance(arc_lengths_.begin(), next) - 1);
+      continue;
+    }
+    distance =
+      std::min(distance, segmentToPolygonDistance2D(points_[i], points_[i + 1], polygon));
+    if (distance == 0.0) {
+      return 0.0;
+    }
+    ++i;
+  }
+  return distance;
+}
+}  // namespace hdmap_utils
@@ -0,0 +1,59 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <traffic_simulator/hdmap_utils/lanelet_index.hpp>
+#include <utility>
+
+namespace hdmap_utils
+{
+LaneletIndex::LaneletIndex(lanelet::Ids ids) : ids_(std::move(ids))
+{
+  std::sort(ids_.begin(), ids_.end());
+  ids_.erase(std::unique(ids_.begin(), ids_.end()), ids_.end());
+
+  /**
+   * @note Hard coded parameter
+   * The direct lookup table is used while it needs at most this many entries per lanelet.
+   */
+  constexpr std::size_t max_entries_per_lanelet = 8;
+  if (
+    not ids_.empty() and static_cast<std::uint64_t>(ids_.back() - ids_.front()) <
+                           max_entries_per_lanelet * ids_.size()) {
+    min_id_ = ids_.front();
+    direct_lookup_.assign(ids_.back() - ids_.front() + 1, invalid_index);
+    for (Index index = 0; index < ids_.size(); ++index) {
+      direct_lookup_[ids_[index] - min_id_] = index;
+    }
+  }
+}
+
+auto LaneletIndex::find(const lanelet::Id lanelet_id) const -> std::optional<Index>
+{
+  if (not direct_lookup_.empty()) {
+    if (lanelet_id < min_id_ or lanelet_id - min_id_ >= lanelet::Id(direct_lookup_.size())) {
+      return std::nullopt;
+    } else if (const auto index = direct_lookup_[lanelet_id - min_id_]; index == invalid_index) {
+      return std::nullopt;
+    } else {
+      return index;
+    }
+  } else if (const auto iter = std::lower_bound(ids_.begin(), ids_.end(), lanelet_id);
+             iter != ids_.end() and *iter == lanelet_id) {
+    return static_cast<Index>(std::distance(ids_.begin(), iter));
+  } else {
+    return std::nullopt;
+  }
+}
+}  // namespace hdmap_utils
@@ -0,0 +1,250 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fcntl.h>
+#include <lanelet2_core/utility/Utilities.h>
+#include <lanelet2_io/io_handlers/Serialize.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <traffic_simulator/hdmap_utils/map_snapshot.hpp>
+
+namespace hdmap_utils
+{
+namespace
+{
+constexpr char file_magic[8] = {'S', 'S', 'V', '2', 'S', 'N', 'A', 'P'};
+
+constexpr std::uint32_t file_version = 1;
+
+struct Header
+{
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t reserved;
+  std::uint64_t key;
+  std::uint64_t lanelet_count;
+  std::uint64_t point_count;
+  std::uint64_t map_size;
+};
+
+struct Record
+{
+  std::int64_t lanelet_id;
+  double length;
+  std::uint64_t first_point;
+  std::uint64_t point_count;
+};
+
+struct Point
+{
+  double x;
+  double y;
+  double z;
+};
+
+auto fileSize(const Header & header) -> std::size_t
+{
+  return sizeof(Header) + sizeof(Record) * header.lanelet_count +
+         sizeof(Point) * header.point_count + header.map_size;
+}
+
+/// @note FNV-1a, only used to detect that the map file or the origin changed.
+auto hash(const void * data, const std::size_t size, std::uint64_t seed = 14695981039346656037ULL)
+  -> std::uint64_t
+{
+  for (std::size_t i = 0; i < size; ++i) {
+    seed = (seed ^ static_cast<const unsigned char *>(data)[i]) * 1099511628211ULL;
+  }
+  return seed;
+}
+
+auto key(
+  const boost::filesystem::path & lanelet2_map_path, const geographic_msgs::msg::GeoPoint & origin)
+  -> std::uint64_t
+{
+  boost::filesystem::ifstream file(lanelet2_map_path, std::ios::binary);
+  const std::string content{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+  const double coordinates[] = {origin.latitude, origin.longitude, origin.altitude};
+  return hash(coordinates, sizeof(coordinates), hash(content.data(), content.size()));
+}
+
+/// @note Read-only stream buffer over the mapped file, so deserialization does not copy it.
+class MemoryBuffer : public std::streambuf
+{
+public:
+  MemoryBuffer(const char * data, const std::size_t size)
+  {
+    auto begin = const_cast<char *>(data);
+    setg(begin, begin, begin + size);
+  }
+};
+}  // namespace
+
+MapSnapshot::MapSnapshot(const void * address, const std::size_t size)
+: address_(address), size_(size)
+{
+}
+
+MapSnapshot::~MapSnapshot() { ::munmap(const_cast<void *>(address_), size_); }
+
+auto MapSnapshot::path(const boost::filesystem::path & snapshot_directory, const std::uint64_t key)
+  -> boost::filesystem::path
+{
+  std::stringstream name;
+  name << std::hex << std::setw(16) << std::setfill('0') << key << ".snapshot";
+  return snapshot_directory / name.str();
+}
+
+auto MapSnapshot::open(
+  const boost::filesystem::path & snapshot_directory,
+  const boost::filesystem::path & lanelet2_map_path, const geographic_msgs::msg::GeoPoint & origin)
+  -> std::unique_ptr<const MapSnapshot>
+{
+  const auto snapshot_key = key(lanelet2_map_path, origin);
+  const auto snapshot_path = path(snapshot_directory, snapshot_key);
+
+  const auto file_descriptor = ::open(snapshot_path.c_str(), O_RDONLY);
+  if (file_descriptor < 0) {
+    return nullptr;
+  }
+  struct stat status;
+  if (::fstat(file_descriptor, &status) != 0 or status.st_size < ::off_t(sizeof(Header))) {
+    ::close(file_descriptor);
+    return nullptr;
+  }
+  const auto size = static_cast<std::size_t>(status.st_size);
+  const auto address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+  /// @note The mapping stays valid after the file descriptor is closed.
+  ::close(file_descriptor);
+  if (address == MAP_FAILED) {
+    return nullptr;
+  }
+
+  auto snapshot = std::unique_ptr<const MapSnapshot>(new MapSnapshot(address, size));
+  const auto & header = *static_cast<const Header *>(address);
+  if (
+    std::memcmp(header.magic, file_magic, sizeof(file_magic)) != 0 or
+    header.version != file_version or header.key != snapshot_key or fileSize(header) != size) {
+    return nullptr;
+  }
+  const auto records =
+    reinterpret_cast<const Record *>(static_cast<const char *>(address) + sizeof(Header));
+  for (std::size_t i = 0; i < header.lanelet_count; ++i) {
+    if (records[i].first_point + records[i].point_count > header.point_count) {
+      return nullptr;
+    }
+  }
+  return snapshot;
+}
+
+auto MapSnapshot::write(
+  const boost::filesystem::path & snapshot_directory,
+  const boost::filesystem::path & lanelet2_map_path, const geographic_msgs::msg::GeoPoint & origin,
+  const lanelet::LaneletMap & lanelet_map, const std::vector<Centerline> & centerlines) -> bool
+{
+  std::stringstream map_stream;
+  {
+    boost::archive::binary_oarchive archive(map_stream);
+    archive << lanelet_map;
+    auto id_counter = lanelet::utils::getId();
+    archive << id_counter;
+  }
+  const auto serialized_map = map_stream.str();
+
+  Header header = {};
+  std::memcpy(header.magic, file_magic, sizeof(file_magic));
+  header.version = file_version;
+  header.key = key(lanelet2_map_path, origin);
+  header.lanelet_count = centerlines.size();
+  header.map_size = serialized_map.size();
+
+  std::vector<Record> records;
+  std::vector<Point> points;
+  for (const auto & centerline : centerlines) {
+    records.push_back(
+      {centerline.lanelet_id, centerline.length, points.size(), centerline.points.size()});
+    for (const auto & point : centerline.points) {
+      points.push_back({point.x, point.y, point.z});
+    }
+  }
+  header.point_count = points.size();
+
+  boost::system::error_code error;
+  boost::filesystem::create_directories(snapshot_directory, error);
+  const auto snapshot_path = path(snapshot_directory, header.key);
+  /// @note Written to a temporary file first, so other processes never open a partial snapshot.
+  const auto temporary_path = boost::filesystem::path(snapshot_path)
+                                .concat(boost::filesystem::unique_path(".%%%%%%").string());
+  {
+    boost::filesystem::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(records.data()), sizeof(Record) * records.size());
+    file.write(reinterpret_cast<const char *>(points.data()), sizeof(Point) * points.size());
+    file.write(serialized_map.data(), serialized_map.size());
+    if (not file) {
+      boost::filesystem::remove(temporary_path, error);
+      return false;
+    }
+  }
+  boost::filesystem::rename(temporary_path, snapshot_path, error);
+  return not error;
+}
+
+auto MapSnapshot::getLaneletMap() const -> lanelet::LaneletMapPtr
+{
+  const auto & header = *static_cast<const Header *>(address_);
+  const auto map_data = static_cast<const char *>(address_) + size_ - header.map_size;
+  MemoryBuffer buffer(map_data, header.map_size);
+  std::istream stream(&buffer);
+  boost::archive::binary_iarchive archive(stream);
+  auto lanelet_map = std::make_shared<lanelet::LaneletMap>();
+  archive >> *lanelet_map;
+  lanelet::Id id_counter;
+  archive >> id_counter;
+  lanelet::utils::registerId(id_counter);
+  return lanelet_map;
+}
+
+auto MapSnapshot::getCenterlines() const -> std::vector<Centerline>
+{
+  const auto & header = *static_cast<const Header *>(address_);
+  const auto records =
+    reinterpret_cast<const Record *>(static_cast<const char *>(address_) + sizeof(Header));
+  const auto points = reinterpret_cast<const Point *>(records + header.lanelet_count);
+  std::vector<Centerline> centerlines;
+  centerlines.reserve(header.lanelet_count);
+  for (std::size_t i = 0; i < header.lanelet_count; ++i) {
+    auto & centerline = centerlines.emplace_back();
+    centerline.lanelet_id = records[i].lanelet_id;
+    centerline.length = records[i].length;
+    centerline.points.reserve(records[i].point_count);
+    for (std::size_t j = 0; j < records[i].point_count; ++j) {
+      const auto & point = points[records[i].first_point + j];
+      centerline.points.push_back(
+        geometry_msgs::build<geometry_msgs::msg::Point>().x(point.x).y(point.y).z(point.z));
+    }
+  }
+  return centerlines;
+}
+}  // namespace hdmap_utils
@@ -0,0 +1,73 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <map>
+#include <mutex>
+#include <scenario_simulator_exception/exception.hpp>
+#include <string>
+#include <traffic_simulator/hdmap_utils/registry.hpp>
+#include <tuple>
+#include <vector>
+
+namespace hdmap_utils
+{
+auto acquireHdMapUtils(
+  const boost::filesystem::path & lanelet2_map_path, const geographic_msgs::msg::GeoPoint & origin,
+  const boost::filesystem::path & snapshot_directory,
+  const std::optional<lanelet::BoundingBox2d> & region) -> std::shared_ptr<HdMapUtils>
+{
+  using Key = std::tuple<std::string, double, double, double, std::vector<double>>;
+
+  static std::mutex mutex;
+  static std::map<Key, std::weak_ptr<HdMapUtils>> registry;
+
+  /// @note The last acquired map outlives its holders, so consecutive scenarios on it reuse it.
+  static std::shared_ptr<HdMapUtils> retained;
+
+  const Key key = {
+    boost::filesystem::weakly_canonical(lanelet2_map_path).string(), origin.latitude,
+    origin.longitude, origin.altitude,
+    region ? std::vector<double>{region->min().x(), region->min().y(), region->max().x(),
+                                 region->max().y()}
+           : std::vector<double>{}};
+
+  /// @note The lock is held while loading, so concurrent requesters of the same map wait for it.
+  std::lock_guard<std::mutex> lock(mutex);
+  if (auto hdmap_utils = registry[key].lock()) {
+    return retained = hdmap_utils;
+  } else {
+    retained.reset();
+    for (auto iter = registry.begin(); iter != registry.end();) {
+      iter = iter->second.expired() ? registry.erase(iter) : std::next(iter);
+    }
+    hdmap_utils = std::make_shared<HdMapUtils>(
+      lanelet2_map_path, origin, snapshot_directory, region);
+    registry[key] = hdmap_utils;
+    return retained = hdmap_utils;
+  }
+}
+
+auto toMapRegion(const std::vector<double> & value) -> std::optional<lanelet::BoundingBox2d>
+{
+  if (value.empty()) {
+    return std::nullopt;
+  } else if (value.size() == 4 and value[0] < value[2] and value[1] < value[3]) {
+    return lanelet::BoundingBox2d(
+      lanelet::BasicPoint2d(value[0], value[1]), lanelet::BasicPoint2d(value[2], value[3]));
+  } else {
+    THROW_SIMULATION_ERROR(
+      "The map region must be given as [min_x, min_y, max_x, max_y] with min < max");
+  }
+}
+}  // namespace hdmap_utils
@@ -0,0 +1,215 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <boost/filesystem/fstream.hpp>
+#include <cstring>
+#include <functional>
+#include <queue>
+#include <thread>
+#include <traffic_simulator/hdmap_utils/route_table.hpp>
+#include <utility>
+
+namespace hdmap_utils
+{
+namespace
+{
+constexpr char file_magic[8] = {'S', 'S', 'V', '2', 'R', 'T', 'B', 'L'};
+
+constexpr std::uint32_t file_version = 1;
+
+template <typename T>
+auto write(std::ostream & stream, const T & value) -> void
+{
+  stream.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+auto write(std::ostream & stream, const std::vector<T> & values) -> void
+{
+  stream.write(reinterpret_cast<const char *>(values.data()), sizeof(T) * values.size());
+}
+
+template <typename T>
+auto read(std::istream & stream, T & value) -> bool
+{
+  return static_cast<bool>(stream.read(reinterpret_cast<char *>(&value), sizeof(T)));
+}
+
+template <typename T>
+auto read(std::istream & stream, std::vector<T> & values) -> bool
+{
+  return static_cast<bool>(
+    stream.read(reinterpret_cast<char *>(values.data()), sizeof(T) * values.size()));
+}
+}  // namespace
+
+auto RouteTable::Graph::fingerprint() const -> std::uint64_t
+{
+  std::uint64_t seed = lanelet_ids.size();
+  const auto combine = [&](const auto value) {
+    // hash combine like boost library
+    seed ^= std::hash<std::decay_t<decltype(value)>>{}(value) + 0x9e3779b9 + (seed << 6) +
+            (seed >> 2);
+  };
+  for (const auto lanelet_id : lanelet_ids) {
+    combine(lanelet_id);
+  }
+  for (const auto & edges_of_mode : edges) {
+    for (std::size_t from = 0; from < edges_of_mode.size(); ++from) {
+      for (const auto & edge : edges_of_mode[from]) {
+        combine(from);
+        combine(edge.to);
+        combine(edge.cost);
+      }
+    }
+  }
+  return seed;
+}
+
+RouteTable::RouteTable(const Graph & graph)
+: fingerprint_(graph.fingerprint()), lanelet_ids_(graph.lanelet_ids)
+{
+  for (std::uint32_t index = 0; index < lanelet_ids_.size(); ++index) {
+    indices_.emplace(lanelet_ids_[index], index);
+  }
+
+  const auto n = size();
+
+  /**
+   * @note Dijkstra search from the source, the first hop of every vertex is propagated along the
+   * search tree so that the row of the table is filled without walking the paths back.
+   */
+  const auto search = [n](
+                        const std::vector<std::vector<Edge>> & edges, const std::uint32_t source,
+                        std::uint32_t * first_hops) {
+    std::vector<double> costs(n, std::numeric_limits<double>::infinity());
+    using Entry = std::pair<double, std::uint32_t>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+    costs[source] = 0.0;
+    first_hops[source] = source;
+    queue.emplace(0.0, source);
+    while (not queue.empty()) {
+      const auto [cost, vertex] = queue.top();
+      queue.pop();
+      if (cost > costs[vertex]) {
+        continue;
+      }
+      for (const auto & edge : edges[vertex]) {
+        if (const auto new_cost = cost + edge.cost; new_cost < costs[edge.to]) {
+          costs[edge.to] = new_cost;
+          first_hops[edge.to] = vertex == source ? edge.to : first_hops[vertex];
+          queue.emplace(new_cost, edge.to);
+        }
+      }
+    }
+  };
+
+  // Run as many threads as physical cores (which is usually /2 virtual threads)
+  const auto thread_count =
+    std::max<std::size_t>(1, std::min<std::size_t>(std::thread::hardware_concurrency() / 2, n));
+
+  for (std::size_t mode = 0; mode < next_hops_.size(); ++mode) {
+    next_hops_[mode].assign(n * n, unreachable);
+    std::vector<std::thread> threads;
+    for (std::size_t thread_index = 0; thread_index < thread_count; ++thread_index) {
+      threads.emplace_back([&, mode, thread_index]() {
+        for (auto source = thread_index; source < n; source += thread_count) {
+          search(
+            graph.edges[mode], static_cast<std::uint32_t>(source),
+            next_hops_[mode].data() + source * n);
+        }
+      });
+    }
+    for (auto & thread : threads) {
+      thread.join();
+    }
+  }
+}
+
+auto RouteTable::load(const boost::filesystem::path & path, const Graph & graph)
+  -> std::optional<RouteTable>
+{
+  boost::filesystem::ifstream file(path, std::ios::binary);
+  if (not file) {
+    return std::nullopt;
+  }
+
+  char magic[sizeof(file_magic)];
+  std::uint32_t version;
+  std::uint64_t fingerprint, n;
+  if (
+    not file.read(magic, sizeof(magic)) or std::memcmp(magic, file_magic, sizeof(magic)) != 0 or
+    not read(file, version) or version != file_version or not read(file, fingerprint) or
+    fingerprint != graph.fingerprint() or not read(file, n) or n != graph.lanelet_ids.size()) {
+    return std::nullopt;
+  }
+
+  RouteTable table;
+  table.fingerprint_ = fingerprint;
+  table.lanelet_ids_.resize(n);
+  if (not read(file, table.lanelet_ids_) or table.lanelet_ids_ != graph.lanelet_ids) {
+    return std::nullopt;
+  }
+  for (std::uint32_t index = 0; index < table.lanelet_ids_.size(); ++index) {
+    table.indices_.emplace(table.lanelet_ids_[index], index);
+  }
+  for (auto & next_hops : table.next_hops_) {
+    next_hops.resize(n * n);
+    if (not read(file, next_hops)) {
+      return std::nullopt;
+    }
+  }
+  return table;
+}
+
+auto RouteTable::save(const boost::filesystem::path & path) const -> bool
+{
+  boost::filesystem::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (not file) {
+    return false;
+  }
+  file.write(file_magic, sizeof(file_magic));
+  write(file, file_version);
+  write(file, fingerprint_);
+  write(file, static_cast<std::uint64_t>(size()));
+  write(file, lanelet_ids_);
+  for (const auto & next_hops : next_hops_) {
+    write(file, next_hops);
+  }
+  return static_cast<bool>(file);
+}
+
+auto RouteTable::getRoute(
+  const lanelet::Id from, const lanelet::Id to, const bool allow_lane_change) const
+  -> std::optional<lanelet::Ids>
+{
+  const auto from_index = indices_.find(from);
+  const auto to_index = indices_.find(to);
+  if (from_index == indices_.end() or to_index == indices_.end()) {
+    return std::nullopt;
+  }
+
+  const auto & next_hops = next_hops_[allow_lane_change ? 1 : 0];
+  lanelet::Ids route;
+  for (auto index = from_index->second; index != unreachable;
+       index = next_hops[index * size() + to_index->second]) {
+    route.push_back(lanelet_ids_[index]);
+    if (index == to_index->second) {
+      return route;
+    }
+  }
+  return lanelet::Ids();
+}
+}  // namespace hdmap_utils
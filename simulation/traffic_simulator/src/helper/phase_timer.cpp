@@ -0,0 +1,190 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <status_monitor/trace.hpp>
+#include <traffic_simulator/helper/phase_timer.hpp>
+#include <vector>
+
+#ifdef TRAFFIC_SIMULATOR_ALLOCATION_ACCOUNTING
+namespace
+{
+/// @note Trivial, so that it is usable by operator new even while the thread starts or exits.
+thread_local traffic_simulator::helper::Allocations thread_allocations;
+
+auto allocate(const std::size_t size) -> void *
+{
+  ++thread_allocations.count;
+  thread_allocations.bytes += size;
+  if (void * pointer = std::malloc(size == 0 ? 1 : size)) {
+    return pointer;
+  } else {
+    throw std::bad_alloc();
+  }
+}
+}  // namespace
+
+void * operator new(std::size_t size) { return allocate(size); }
+
+void * operator new[](std::size_t size) { return allocate(size); }
+
+void operator delete(void * pointer) noexcept { std::free(pointer); }
+
+void operator delete[](void * pointer) noexcept { std::free(pointer); }
+
+void operator delete(void * pointer, std::size_t) noexcept { std::free(pointer); }
+
+void operator delete[](void * pointer, std::size_t) noexcept { std::free(pointer); }
+#endif  // TRAFFIC_SIMULATOR_ALLOCATION_ACCOUNTING
+
+namespace traffic_simulator
+{
+namespace helper
+{
+namespace
+{
+struct PhaseTimingBuffers
+{
+  std::mutex mutex;
+  std::vector<std::shared_ptr<PhaseTimingBuffer>> buffers;
+};
+
+auto phaseTimingBuffers() -> PhaseTimingBuffers &
+{
+  static PhaseTimingBuffers buffers;
+  return buffers;
+}
+
+/// @note The buffer outlives its thread until collectPhaseTimings pops the last timings of it.
+struct ThreadPhaseTimingBuffer
+{
+  const std::shared_ptr<PhaseTimingBuffer> buffer = std::make_shared<PhaseTimingBuffer>();
+
+  ThreadPhaseTimingBuffer()
+  {
+    auto & buffers = phaseTimingBuffers();
+    std::lock_guard<std::mutex> lock(buffers.mutex);
+    buffers.buffers.push_back(buffer);
+  }
+
+  ~ThreadPhaseTimingBuffer() { buffer->retired = true; }
+};
+
+auto threadPhaseTimingBuffer() -> PhaseTimingBuffer &
+{
+  thread_local ThreadPhaseTimingBuffer buffer;
+  return *buffer.buffer;
+}
+}  // namespace
+
+auto threadAllocations() -> Allocations
+{
+#ifdef TRAFFIC_SIMULATOR_ALLOCATION_ACCOUNTING
+  return thread_allocations;
+#else
+  return {};
+#endif
+}
+
+auto PhaseTimingBuffer::push(const PhaseTiming & timing) -> bool
+{
+  const auto head = head_.load(std::memory_order_relaxed);
+  if (const auto next = (head + 1) % capacity; next == tail_.load(std::memory_order_acquire)) {
+    return false;
+  } else {
+    timings_[head] = timing;
+    head_.store(next, std::memory_order_release);
+    return true;
+  }
+}
+
+auto PhaseTimingBuffer::pop(const std::function<void(const PhaseTiming &)> & consume) -> void
+{
+  auto tail = tail_.load(std::memory_order_relaxed);
+  for (const auto head = head_.load(std::memory_order_acquire); tail != head;
+       tail = (tail + 1) % capacity) {
+    consume(timings_[tail]);
+  }
+  tail_.store(tail, std::memory_order_release);
+}
+
+ScopedPhaseTimer::ScopedPhaseTimer(const char * phase)
+: phase_(phase), start_allocations_(threadAllocations()), start_(std::chrono::steady_clock::now())
+{
+}
+
+ScopedPhaseTimer::~ScopedPhaseTimer()
+{
+  const auto end = std::chrono::steady_clock::now();
+  const auto end_allocations = threadAllocations();
+  threadPhaseTimingBuffer().push(PhaseTiming{
+    phase_, std::chrono::duration<double, std::milli>(end - start_).count(),
+    end_allocations.count - start_allocations_.count,
+    end_allocations.bytes - start_allocations_.bytes});
+  if (common::Trace::enabled()) {
+    common::Trace::complete("frame", phase_, start_, end);
+  }
+}
+
+auto collectPhaseTimings() -> std::map<std::string, PhaseStatistics>
+{
+  std::map<std::string, PhaseStatistics> statistics;
+  auto & buffers = phaseTimingBuffers();
+  std::lock_guard<std::mutex> lock(buffers.mutex);
+  for (auto iter = buffers.buffers.begin(); iter != buffers.buffers.end();) {
+    /// @note Read before popping, so that a retired buffer is known to be drained by the pop.
+    const bool retired = (*iter)->retired;
+    (*iter)->pop([&](const PhaseTiming & timing) {
+      auto & phase = statistics[timing.phase];
+      ++phase.count;
+      phase.total_milliseconds += timing.milliseconds;
+      phase.maximum_milliseconds = std::max(phase.maximum_milliseconds, timing.milliseconds);
+      phase.allocations += timing.allocations;
+      phase.allocated_bytes += timing.allocated_bytes;
+    });
+    iter = retired ? buffers.buffers.erase(iter) : std::next(iter);
+  }
+  return statistics;
+}
+
+auto makePhaseTimingStatus(const std::string & name) -> diagnostic_msgs::msg::DiagnosticStatus
+{
+  diagnostic_msgs::msg::DiagnosticStatus status;
+  status.name = name;
+  status.level = diagnostic_msgs::msg::DiagnosticStatus::OK;
+  status.message = "Mean and maximum wall-clock time of each phase since the last report";
+  for (const auto & [phase, statistics] : collectPhaseTimings()) {
+    std::stringstream value;
+    value << std::fixed << std::setprecision(3)
+          << statistics.total_milliseconds / statistics.count << " / "
+          << statistics.maximum_milliseconds << " ms (" << statistics.count << ")";
+#ifdef TRAFFIC_SIMULATOR_ALLOCATION_ACCOUNTING
+    value << std::setprecision(1) << ", "
+          << static_cast<double>(statistics.allocations) / statistics.count << " allocations / "
+          << static_cast<double>(statistics.allocated_bytes) / statistics.count << " bytes";
+#endif
+    diagnostic_msgs::msg::KeyValue key_value;
+    key_value.key = phase;
+    key_value.value = value.str();
+    status.values.push_back(key_value);
+  }
+  return status;
+}
+}  // namespace helper
+}  // namespace traffic_simulator
@@ -23,21 +23,50 @@ void JobList::append(
   const std::function<bool(double)> & func_on_update, const std::function<void()> & func_on_cleanup,
   job::Type type, bool exclusive, const job::Event event)
 {
-  for (auto & job : list_) {
-    if (job.type == type && job.exclusive == exclusive && job.getStatus() == job::Status::ACTIVE) {
-      job.inactivate();
+  for (auto & list : lists_) {
+    for (auto & job : list) {
+      if (
+        job.type == type && job.exclusive == exclusive && job.getStatus() == job::Status::ACTIVE) {
+        job.inactivate();
+      }
     }
   }
-  list_.emplace_back(Job(func_on_update, func_on_cleanup, type, exclusive, event));
+  getList(event).emplace_back(func_on_update, func_on_cleanup, type, exclusive, event);
 }
 
 void JobList::update(const double step_time, const job::Event event)
 {
-  for (auto & job : list_) {
-    if (job.event == event) {
-      job.onUpdate(step_time);
+  auto & list = getList(event);
+  /// @note Jobs appended by the jobs being updated are not updated until the next call.
+  auto job = list.begin();
+  for (auto count = list.size(); 0 < count; --count) {
+    job->onUpdate(step_time);
+    if (job->getStatus() == job::Status::INACTIVE) {
+      job = list.erase(job);
+    } else {
+      ++job;
     }
   }
 }
+
+auto JobList::size() const -> std::size_t
+{
+  std::size_t size = 0;
+  for (const auto & list : lists_) {
+    size += list.size();
+  }
+  return size;
+}
+
+auto JobList::getList(const job::Event event) -> std::list<Job> &
+{
+  switch (event) {
+    case job::Event::PRE_UPDATE:
+      return lists_[0];
+    default:
+    case job::Event::POST_UPDATE:
+      return lists_[1];
+  }
+}
 }  // namespace job
 }  // namespace traffic_simulator
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <cmath>
 #include <scenario_simulator_exception/exception.hpp>
 #include <traffic_simulator/simulation_clock/simulation_clock.hpp>
 
@@ -28,7 +30,30 @@ SimulationClock::SimulationClock(bool use_sim_time, double realtime_factor, doub
 
 auto SimulationClock::update() -> void
 {
-  seconds_since_the_simulator_started_ += realtime_factor / frame_rate_;
+  const auto step_time = getStepTime();
+
+  seconds_since_the_simulator_started_ += step_time;
+
+  const auto now = std::chrono::steady_clock::now();
+  if (previous_update_time_) {
+    constexpr double smoothing = 0.1;
+    const auto elapsed = std::chrono::duration<double>(now - *previous_update_time_).count();
+    frame_duration_ =
+      0.0 < frame_duration_ ? frame_duration_ + smoothing * (elapsed - frame_duration_) : elapsed;
+    achieved_realtime_factor_ =
+      0.0 < frame_duration_ ? step_time / frame_duration_ : achieved_realtime_factor_;
+    if (1.0 < maximum_step_scale) {
+      /*
+         The scale is rounded to tenths, so that the step time sent to the
+         simulator only changes when the overrun does.
+      */
+      step_scale_ = std::clamp(
+        std::round(frame_duration_ * frame_rate_ * 10.0) / 10.0, 1.0, maximum_step_scale);
+    } else {
+      step_scale_ = 1.0;
+    }
+  }
+  previous_update_time_ = now;
 }
 
 auto SimulationClock::getCurrentRosTimeAsMsg() -> rosgraph_msgs::msg::Clock
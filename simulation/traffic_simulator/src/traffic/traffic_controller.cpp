@@ -26,6 +26,7 @@
 #include <memory>
 #include <string>
 #include <traffic_simulator/data_type/lanelet_pose.hpp>
+#include <traffic_simulator/helper/phase_timer.hpp>
 #include <traffic_simulator/traffic/traffic_controller.hpp>
 #include <traffic_simulator/traffic/traffic_sink.hpp>
 #include <traffic_simulator/utils/pose.hpp>
@@ -38,11 +39,15 @@ namespace traffic
 {
 TrafficController::TrafficController(
   std::shared_ptr<hdmap_utils::HdMapUtils> hdmap_utils,
-  const std::function<std::vector<std::string>(void)> & get_entity_names_function,
+  const std::function<std::vector<std::string>(const geometry_msgs::msg::Point &, double)> &
+    get_entity_names_near_function,
+  const std::function<std::vector<std::string>(const lanelet::Ids &)> &
+    get_entity_names_on_lanelets_function,
   const std::function<geometry_msgs::msg::Pose(const std::string &)> & get_entity_pose_function,
   const std::function<void(std::string)> & despawn_function, bool auto_sink)
 : hdmap_utils_(hdmap_utils),
-  get_entity_names_function(get_entity_names_function),
+  get_entity_names_near_function(get_entity_names_near_function),
+  get_entity_names_on_lanelets_function(get_entity_names_on_lanelets_function),
   get_entity_pose_function(get_entity_pose_function),
   despawn_function(despawn_function),
   auto_sink(auto_sink)
@@ -60,15 +65,24 @@ void TrafficController::autoSink()
       lanelet_pose.lanelet_id = lanelet_id;
       lanelet_pose.s = pose::laneletLength(lanelet_id, hdmap_utils_);
       const auto pose = pose::toMapPose(lanelet_pose, hdmap_utils_);
+      /*
+         The sink is at the end of a lanelet without followers, so only the entities on that
+         lanelet can reach it. Looking them up by lanelet checks every entity against the sink of
+         its own lanelet instead of every sink searching around itself.
+      */
       addModule<traffic_simulator::traffic::TrafficSink>(
-        lanelet_id, 1, pose.position, get_entity_names_function, get_entity_pose_function,
-        despawn_function);
+        lanelet_id, 1, pose.position,
+        [this, lanelet_id](const geometry_msgs::msg::Point &, double) {
+          return get_entity_names_on_lanelets_function({lanelet_id});
+        },
+        get_entity_pose_function, despawn_function);
     }
   }
 }
 
 void TrafficController::execute(const double current_time, const double step_time)
 {
+  helper::ScopedPhaseTimer timer("TrafficController::execute");
   for (const auto & module : modules_) {
     module->execute(current_time, step_time);
   }
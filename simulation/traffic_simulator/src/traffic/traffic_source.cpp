@@ -23,6 +23,17 @@ namespace traffic_simulator
 {
 namespace traffic
 {
+namespace
+{
+auto getBoundingBox(const TrafficSource::VehicleOrPedestrianParameter & parameter)
+  -> const traffic_simulator_msgs::msg::BoundingBox &
+{
+  return std::holds_alternative<TrafficSource::PedestrianParameter>(parameter)
+           ? std::get<TrafficSource::PedestrianParameter>(parameter).bounding_box
+           : std::get<TrafficSource::VehicleParameter>(parameter).bounding_box;
+}
+}  // namespace
+
 TrafficSource::Validator::Validator(
   const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils,
   const geometry_msgs::msg::Pose & pose, const double radius, const bool include_crosswalk)
@@ -91,9 +102,74 @@ auto TrafficSource::makeRandomPose(const bool random_orientation) -> geometry_ms
   return random_pose;
 }
 
+auto TrafficSource::makeSpawnSlots() -> void
+{
+  /// @note Positions outside the lanes are sampled at random instead, see execute.
+  if (configuration_.allow_spawn_outside_lane) {
+    return;
+  }
+
+  const auto contains = [this](const auto & is_type_of) {
+    return std::any_of(distribution_.begin(), distribution_.end(), [&](const auto & entry) {
+      return is_type_of(std::get<0>(entry));
+    });
+  };
+  if (contains([](const auto & x) { return std::holds_alternative<VehicleParameter>(x); })) {
+    vehicle_spawn_slots_ = makeSpawnSlots(validate);
+  }
+  if (contains([](const auto & x) { return std::holds_alternative<PedestrianParameter>(x); })) {
+    pedestrian_spawn_slots_ = makeSpawnSlots(validate_considering_crosswalk);
+  }
+
+  valid_spawn_slot_indices_.reserve(distribution_.size());
+  for (const auto & entry : distribution_) {
+    const auto & parameter = std::get<0>(entry);
+    const auto is_pedestrian = std::holds_alternative<PedestrianParameter>(parameter);
+    const auto & slots = is_pedestrian ? pedestrian_spawn_slots_ : vehicle_spawn_slots_;
+    const auto & validator = is_pedestrian ? validate_considering_crosswalk : validate;
+    const auto bbox_corners = math::geometry::getPointsFromBbox(getBoundingBox(parameter));
+    auto & indices = valid_spawn_slot_indices_.emplace_back();
+    /// @note The validity does not depend on the position, so it is checked only once.
+    if (not isPoseValid(parameter, pose)) {
+      continue;
+    }
+    for (std::size_t i = 0; i < slots.size(); ++i) {
+      if (
+        not configuration_.require_footprint_fitting or
+        validator(
+          math::geometry::transformPoints(slots[i].map_pose, bbox_corners),
+          slots[i].lanelet_pose.lanelet_id)) {
+        indices.push_back(i);
+      }
+    }
+  }
+}
+
+auto TrafficSource::makeSpawnSlots(const Validator & validator) const -> std::vector<SpawnSlot>
+{
+  std::vector<SpawnSlot> slots;
+  for (const auto lanelet_id : validator.ids) {
+    const auto length = hdmap_utils_->getLaneletLength(lanelet_id);
+    for (double s = 0.0; s < length; s += spawn_slot_interval) {
+      /// @note Aligned with the lane, like the lanelet poses matched from random positions were.
+      const auto lanelet_pose = helper::constructLaneletPose(lanelet_id, s);
+      const auto map_pose = hdmap_utils_->toMapPose(lanelet_pose).pose;
+      if (
+        std::hypot(map_pose.position.x - pose.position.x, map_pose.position.y - pose.position.y) <
+        radius_distribution_.max()) {
+        slots.push_back({lanelet_pose, map_pose});
+      }
+    }
+  }
+  return slots;
+}
+
 void TrafficSource::execute(
   [[maybe_unused]] const double current_time, [[maybe_unused]] const double step_time)
 {
+  /// @note Not in the entity spatial index until the next update, so checked for occupancy here.
+  std::vector<geometry_msgs::msg::Point> spawned_positions;
+
   for (; current_time - start_execution_time_ > 1.0 / rate * entity_count_; ++entity_count_) {
     const auto index = params_distribution_(engine_);
 
@@ -102,19 +178,47 @@ void TrafficSource::execute(
     const auto name =
       "TrafficSource_" + std::to_string(id) + "_Entity_" + std::to_string(entity_count_);
 
-    const auto [pose, lanelet_pose] = [&]() {
-      static constexpr auto max_randomization_attempts = 10000;
+    std::optional<geometry_msgs::msg::Pose> pose;
+    std::optional<CanonicalizedLaneletPose> lanelet_pose;
 
-      for (auto tries = 0; tries < max_randomization_attempts; ++tries) {
-        auto candidate_pose = makeRandomPose(configuration_.use_random_orientation);
-        if (auto [valid, lanelet_pose] = isPoseValid(parameter, candidate_pose); valid) {
-          return std::make_pair(candidate_pose, lanelet_pose);
+    if (configuration_.allow_spawn_outside_lane) {
+      /// @note The validity does not depend on the position, so it is checked only once.
+      if (not isPoseValid(parameter, this->pose)) {
+        THROW_SIMULATION_ERROR(
+          "TrafficSource ", id, " failed to generate valid random pose, the entity does not fit ",
+          "inside the spawning area.");
+      }
+      for (std::size_t attempt = 0; attempt < spawn_slot_attempts and not pose; ++attempt) {
+        if (const auto candidate_pose = makeRandomPose(configuration_.use_random_orientation);
+            not isOccupied(parameter, candidate_pose, spawned_positions)) {
+          pose = candidate_pose;
         }
       }
-      THROW_SIMULATION_ERROR(
-        "TrafficSource ", id, " failed to generate valid random pose in ",
-        max_randomization_attempts, ".");
-    }();
+    } else {
+      const auto & slots = std::holds_alternative<PedestrianParameter>(parameter)
+                             ? pedestrian_spawn_slots_
+                             : vehicle_spawn_slots_;
+      const auto & indices = valid_spawn_slot_indices_[index];
+      if (indices.empty()) {
+        THROW_SIMULATION_ERROR(
+          "TrafficSource ", id, " failed to generate valid random pose, there is no position on ",
+          "the lanes inside the spawning area where the entity fits.");
+      }
+      auto slot_distribution = std::uniform_int_distribution<std::size_t>(0, indices.size() - 1);
+      for (std::size_t attempt = 0; attempt < spawn_slot_attempts and not pose; ++attempt) {
+        if (const auto & slot = slots[indices[slot_distribution(engine_)]];
+            not isOccupied(parameter, slot.map_pose, spawned_positions)) {
+          pose = slot.map_pose;
+          lanelet_pose.emplace(slot.lanelet_pose, hdmap_utils_);
+        }
+      }
+    }
+
+    /// @note Every slot tried is occupied, spawning is deferred until the traffic moves on.
+    if (not pose) {
+      break;
+    }
+    spawned_positions.push_back(pose->position);
 
     if (lanelet_pose) {
       /// @note If lanelet pose is valid spawn using lanelet pose
@@ -131,82 +235,46 @@ void TrafficSource::execute(
       /// @note If lanelet pose is not valid spawn using normal map pose
       if (std::holds_alternative<PedestrianParameter>(parameter)) {
         spawn_pedestrian_in_world_coordinate(
-          name, pose, std::get<PedestrianParameter>(parameter), std::get<1>(distribution_[index]),
-          std::get<2>(distribution_[index]));
+          name, pose.value(), std::get<PedestrianParameter>(parameter),
+          std::get<1>(distribution_[index]), std::get<2>(distribution_[index]));
       } else {
         spawn_vehicle_in_world_coordinate(
-          name, pose, std::get<VehicleParameter>(parameter), std::get<1>(distribution_[index]),
-          std::get<2>(distribution_[index]));
+          name, pose.value(), std::get<VehicleParameter>(parameter),
+          std::get<1>(distribution_[index]), std::get<2>(distribution_[index]));
       }
     }
   }
 }
 
 auto TrafficSource::isPoseValid(
-  const VehicleOrPedestrianParameter & parameter, const geometry_msgs::msg::Pose & pose)
-  -> std::pair<bool, std::optional<CanonicalizedLaneletPose>>
+  const VehicleOrPedestrianParameter & parameter, const geometry_msgs::msg::Pose & pose) const
+  -> bool
 {
-  const auto bbox_corners = math::geometry::getPointsFromBbox(
-    std::holds_alternative<PedestrianParameter>(parameter)
-      ? std::get<PedestrianParameter>(parameter).bounding_box
-      : std::get<VehicleParameter>(parameter).bounding_box);
-
-  auto are_all_corners_inside_the_spawning_area = [&]() {
-    /// @note transform bounding box corners to world coordinate system
-    const auto corners = math::geometry::transformPoints(pose, bbox_corners);
-
-    return std::all_of(corners.begin(), corners.end(), [&](const auto & corner) {
-      /// @note 2D validation - does not account for height
-      return std::hypot(corner.x - pose.position.x, corner.y - pose.position.y) <
-             radius_distribution_.max();
-    });
-  };
+  /// @note transform bounding box corners to world coordinate system
+  const auto corners = math::geometry::transformPoints(
+    pose, math::geometry::getPointsFromBbox(getBoundingBox(parameter)));
 
-  /// @note Step 1: check whether all corners are inside spawning area
-  if (not are_all_corners_inside_the_spawning_area()) {
-    return {false, std::nullopt};
-  }
-
-  /// @note Step 2: check whether can be outside lanelet
-  if (configuration_.allow_spawn_outside_lane) {
-    return {true, std::nullopt};
-  }
-
-  if (const auto lanelet_pose =
-        hdmap_utils_->toLaneletPose(pose, std::holds_alternative<PedestrianParameter>(parameter));
-      lanelet_pose) {
-    /// @note reset orientation - to align the entity with lane
-    auto corrected_pose = lanelet_pose.value();
-    corrected_pose.rpy.z = 0.0;
-
-    auto out_pose = std::make_optional<CanonicalizedLaneletPose>(corrected_pose, hdmap_utils_);
-
-    /// @note Step 3: check whether the bounding box can be outside lanelet
-    if (not configuration_.require_footprint_fitting) {
-      return std::make_pair(true, out_pose);
-    }
+  /// @note check whether all corners are inside spawning area
+  return std::all_of(corners.begin(), corners.end(), [&](const auto & corner) {
+    /// @note 2D validation - does not account for height
+    return std::hypot(corner.x - pose.position.x, corner.y - pose.position.y) <
+           radius_distribution_.max();
+  });
+}
 
-    /// @note Step 4: check whether the bounding box fits inside the lanelet
-    if (std::holds_alternative<PedestrianParameter>(parameter)) {
-      return std::make_pair(
-        not configuration_.require_footprint_fitting or
-          validate_considering_crosswalk(
-            math::geometry::transformPoints(
-              hdmap_utils_->toMapPose(corrected_pose).pose, bbox_corners),
-            corrected_pose.lanelet_id),
-        out_pose);
-    } else {
-      return std::make_pair(
-        not configuration_.require_footprint_fitting or
-          validate(
-            math::geometry::transformPoints(
-              hdmap_utils_->toMapPose(corrected_pose).pose, bbox_corners),
-            corrected_pose.lanelet_id),
-        out_pose);
-    }
-  } else {
-    return {false, std::nullopt};
-  }
+auto TrafficSource::isOccupied(
+  const VehicleOrPedestrianParameter & parameter, const geometry_msgs::msg::Pose & pose,
+  const std::vector<geometry_msgs::msg::Point> & spawned_positions) const -> bool
+{
+  /// @note Entities closer than the diagonal of the footprint are assumed to overlap with it.
+  const auto & dimensions = getBoundingBox(parameter).dimensions;
+  const auto clearance = std::hypot(dimensions.x, dimensions.y);
+  return (get_entity_names_near_function_ and
+          not get_entity_names_near_function_(pose.position, clearance).empty()) or
+         std::any_of(
+           spawned_positions.begin(), spawned_positions.end(), [&](const auto & position) {
+             return math::geometry::hypot(position, pose.position) < clearance;
+           });
 }
 }  // namespace traffic
 }  // namespace traffic_simulator
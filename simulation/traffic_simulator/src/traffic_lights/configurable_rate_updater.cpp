@@ -16,29 +16,29 @@
 
 namespace traffic_simulator
 {
-auto ConfigurableRateUpdater::createTimer(double update_rate) -> void
+auto ConfigurableRateUpdater::update(const double current_time) -> void
 {
-  if (!timer_) {
-    update_rate_ = update_rate;
-    using namespace std::chrono_literals;
-    timer_ = rclcpp::create_timer(
-      node_base_interface_, node_timers_interface_, clock_ptr_, 1s / update_rate_,
-      [this]() -> void { thunk_(); });
+  /// @note Hard coded parameter, tolerance for the accumulated rounding of the frame times.
+  constexpr double tolerance = 1e-6;
+  if (update_rate_ <= 0.0) {
+    return;
+  } else if (not started_ or next_update_time_ <= current_time + tolerance) {
+    thunk_();
+    /// @note If more than a period passed since the scheduled time, the schedule restarts now.
+    next_update_time_ = started_ and current_time < next_update_time_ + 1.0 / update_rate_
+                          ? next_update_time_ + 1.0 / update_rate_
+                          : current_time + 1.0 / update_rate_;
+    started_ = true;
   }
 }
 
 auto ConfigurableRateUpdater::resetUpdateRate(double update_rate) -> void
 {
   if (update_rate_ != update_rate) {
-    update_rate_ = update_rate;
-    if (timer_ && not timer_->is_canceled()) {
-      timer_->cancel();
+    if (started_ and update_rate_ > 0.0 and update_rate > 0.0) {
+      next_update_time_ += 1.0 / update_rate - 1.0 / update_rate_;
     }
-
-    using namespace std::chrono_literals;
-    timer_ = rclcpp::create_timer(
-      node_base_interface_, node_timers_interface_, clock_ptr_, 1s / update_rate_,
-      [this]() -> void { thunk_(); });
+    update_rate_ = update_rate;
   }
 }
 }  // namespace traffic_simulator
@@ -27,14 +27,35 @@ TrafficLightManager::TrafficLightManager(const std::shared_ptr<hdmap_utils::HdMa
 {
 }
 
+auto TrafficLightManager::getVersion() -> std::uint64_t
+{
+  const auto changed = [this]() {
+    if (states_.size() != traffic_lights_.size()) {
+      return true;
+    }
+    for (const auto & [id, traffic_light] : traffic_lights_) {
+      if (const auto iter = states_.find(id);
+          iter == states_.end() or iter->second.second != traffic_light.confidence or
+          iter->second.first < traffic_light.bulbs or traffic_light.bulbs < iter->second.first) {
+        return true;
+      }
+    }
+    return false;
+  };
+  if (changed()) {
+    states_.clear();
+    for (const auto & [id, traffic_light] : traffic_lights_) {
+      states_.emplace(id, std::make_pair(traffic_light.bulbs, traffic_light.confidence));
+    }
+    ++version_;
+  }
+  return version_;
+}
+
 auto TrafficLightManager::hasAnyLightChanged() -> bool
 {
-  return true;
-  // return std::any_of(
-  //   std::begin(getTrafficLights()), std::end(getTrafficLights()), [](auto && id_and_traffic_light) {
-  //     return id_and_traffic_light.second.colorChanged() or
-  //            id_and_traffic_light.second.arrowChanged();
-  //   });
+  const auto version = getVersion();
+  return std::exchange(checked_version_, version) != version;
 }
 
 auto TrafficLightManager::getTrafficLight(const lanelet::Id traffic_light_id) -> TrafficLight &
@@ -86,14 +107,16 @@ auto TrafficLightManager::getTrafficLights(const lanelet::Id lanelet_id)
 }
 
 auto TrafficLightManager::generateUpdateTrafficLightsRequest()
-  -> simulation_api_schema::UpdateTrafficLightsRequest
+  -> const simulation_api_schema::UpdateTrafficLightsRequest &
 {
-  simulation_api_schema::UpdateTrafficLightsRequest update_traffic_lights_request;
-  for (auto && [lanelet_id, traffic_light] : traffic_lights_) {
-    *update_traffic_lights_request.add_states() =
-      static_cast<simulation_api_schema::TrafficSignal>(traffic_light);
+  if (const auto version = getVersion(); request_version_ != version) {
+    request_.Clear();
+    for (auto && [lanelet_id, traffic_light] : traffic_lights_) {
+      *request_.add_states() = static_cast<simulation_api_schema::TrafficSignal>(traffic_light);
+    }
+    request_version_ = version;
   }
-  return update_traffic_lights_request;
+  return request_;
 }
 
 }  // namespace traffic_simulator
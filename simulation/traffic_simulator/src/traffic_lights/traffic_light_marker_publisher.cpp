@@ -44,11 +44,12 @@ auto TrafficLightMarkerPublisher::drawMarkers() const -> void
 
 auto TrafficLightMarkerPublisher::publish() -> void
 {
-  if (traffic_light_manager_->hasAnyLightChanged()) {
+  /// @note The markers are latched, so they are only published again if any light has changed.
+  if (const auto version = traffic_light_manager_->getVersion(); published_version_ != version) {
     deleteAllMarkers();
+    drawMarkers();
+    published_version_ = version;
   }
-
-  drawMarkers();
 }
 
 }  // namespace traffic_simulator
@@ -16,6 +16,7 @@
 #include <autoware_perception_msgs/msg/traffic_signal_array.hpp>
 #include <traffic_simulator/traffic_lights/traffic_light_publisher.hpp>
 #include <traffic_simulator_msgs/msg/traffic_light_array_v1.hpp>
+#include <utility>
 
 namespace traffic_simulator
 {
@@ -40,6 +41,7 @@ auto TrafficLightPublisher<autoware_auto_perception_msgs::msg::TrafficSignalArra
     message.signals.push_back(traffic_light_message);
   }
   traffic_light_state_array_publisher_->publish(message);
+  message_ = std::move(message);
 }
 
 template <>
@@ -74,6 +76,7 @@ auto TrafficLightPublisher<autoware_perception_msgs::msg::TrafficSignalArray>::p
     }
   }
   traffic_light_state_array_publisher_->publish(message);
+  message_ = std::move(message);
 }
 
 template <>
@@ -95,5 +98,35 @@ auto TrafficLightPublisher<traffic_simulator_msgs::msg::TrafficLightArrayV1>::pu
     message.traffic_lights.push_back(traffic_light_message);
   }
   traffic_light_state_array_publisher_->publish(message);
+  message_ = std::move(message);
+}
+
+template <>
+auto TrafficLightPublisher<autoware_auto_perception_msgs::msg::TrafficSignalArray>::republish(
+  const rclcpp::Time & current_ros_time) -> void
+{
+  if (message_) {
+    message_->header.stamp = current_ros_time;
+    traffic_light_state_array_publisher_->publish(*message_);
+  }
+}
+
+template <>
+auto TrafficLightPublisher<autoware_perception_msgs::msg::TrafficSignalArray>::republish(
+  const rclcpp::Time & current_ros_time) -> void
+{
+  if (message_) {
+    message_->stamp = current_ros_time;
+    traffic_light_state_array_publisher_->publish(*message_);
+  }
+}
+
+template <>
+auto TrafficLightPublisher<traffic_simulator_msgs::msg::TrafficLightArrayV1>::republish(
+  [[maybe_unused]] const rclcpp::Time & current_ros_time) -> void
+{
+  if (message_) {
+    traffic_light_state_array_publisher_->publish(*message_);
+  }
 }
 }  // namespace traffic_simulator
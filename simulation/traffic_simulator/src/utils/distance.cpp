@@ -15,6 +15,7 @@
 #include <geometry/bounding_box.hpp>
 #include <geometry/distance.hpp>
 #include <geometry/transform.hpp>
+#include <limits>
 #include <traffic_simulator/utils/distance.hpp>
 #include <traffic_simulator_msgs/msg/waypoints_array.hpp>
 
@@ -192,23 +193,74 @@ auto boundingBoxLaneLongitudinalDistance(
   return std::nullopt;
 }
 
-auto distanceToLeftLaneBound(
+namespace
+{
+auto toMapPolygon(
   const geometry_msgs::msg::Pose & map_pose,
-  const traffic_simulator_msgs::msg::BoundingBox & bounding_box, lanelet::Id lanelet_id,
+  const traffic_simulator_msgs::msg::BoundingBox & bounding_box)
+  -> std::vector<geometry_msgs::msg::Point>
+{
+  if (auto polygon =
+        math::geometry::transformPoints(map_pose, math::geometry::toPolygon2D(bounding_box));
+      polygon.empty()) {
+    THROW_SEMANTIC_ERROR("Failed to calculate 2d polygon.");
+  } else {
+    return polygon;
+  }
+}
+
+auto distanceToLeftLaneBound(
+  const std::vector<geometry_msgs::msg::Point> & polygon, lanelet::Id lanelet_id,
   const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils_ptr) -> double
 {
-  if (const auto bound = hdmap_utils_ptr->getLeftBound(lanelet_id); bound.empty()) {
+  if (const auto bound = hdmap_utils_ptr->getLeftLaneBound(lanelet_id);
+      bound->getPoints().empty()) {
     THROW_SEMANTIC_ERROR(
       "Failed to calculate left bounds of lanelet_id : ", lanelet_id, " please check lanelet map.");
-  } else if (const auto polygon =
-               math::geometry::transformPoints(map_pose, math::geometry::toPolygon2D(bounding_box));
-             polygon.empty()) {
-    THROW_SEMANTIC_ERROR("Failed to calculate 2d polygon.");
   } else {
-    return math::geometry::getDistance2D(bound, polygon);
+    return bound->getDistance2D(polygon);
+  }
+}
+
+auto distanceToRightLaneBound(
+  const std::vector<geometry_msgs::msg::Point> & polygon, lanelet::Id lanelet_id,
+  const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils_ptr) -> double
+{
+  if (const auto bound = hdmap_utils_ptr->getRightLaneBound(lanelet_id);
+      bound->getPoints().empty()) {
+    THROW_SEMANTIC_ERROR(
+      "Failed to calculate right bounds of lanelet_id : ", lanelet_id,
+      " please check lanelet map.");
+  } else {
+    return bound->getDistance2D(polygon);
   }
 }
 
+auto distanceToLaneBound(
+  const std::vector<geometry_msgs::msg::Point> & polygon, const lanelet::Ids & lanelet_ids,
+  const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils_ptr) -> double
+{
+  if (lanelet_ids.empty()) {
+    THROW_SEMANTIC_ERROR("Failing to calculate distanceToLaneBound given an empty vector.");
+  }
+  auto distance = std::numeric_limits<double>::max();
+  for (const auto lanelet_id : lanelet_ids) {
+    distance = std::min(
+      {distance, distanceToLeftLaneBound(polygon, lanelet_id, hdmap_utils_ptr),
+       distanceToRightLaneBound(polygon, lanelet_id, hdmap_utils_ptr)});
+  }
+  return distance;
+}
+}  // namespace
+
+auto distanceToLeftLaneBound(
+  const geometry_msgs::msg::Pose & map_pose,
+  const traffic_simulator_msgs::msg::BoundingBox & bounding_box, lanelet::Id lanelet_id,
+  const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils_ptr) -> double
+{
+  return distanceToLeftLaneBound(toMapPolygon(map_pose, bounding_box), lanelet_id, hdmap_utils_ptr);
+}
+
 auto distanceToLeftLaneBound(
   const geometry_msgs::msg::Pose & map_pose,
   const traffic_simulator_msgs::msg::BoundingBox & bounding_box, const lanelet::Ids & lanelet_ids,
@@ -217,12 +269,12 @@ auto distanceToLeftLaneBound(
   if (lanelet_ids.empty()) {
     THROW_SEMANTIC_ERROR("Failing to calculate distanceToLeftLaneBound given an empty vector.");
   }
-  std::vector<double> distances;
-  std::transform(
-    lanelet_ids.begin(), lanelet_ids.end(), std::back_inserter(distances), [&](auto lanelet_id) {
-      return distanceToLeftLaneBound(map_pose, bounding_box, lanelet_id, hdmap_utils_ptr);
-    });
-  return *std::min_element(distances.begin(), distances.end());
+  const auto polygon = toMapPolygon(map_pose, bounding_box);
+  auto distance = std::numeric_limits<double>::max();
+  for (const auto lanelet_id : lanelet_ids) {
+    distance = std::min(distance, distanceToLeftLaneBound(polygon, lanelet_id, hdmap_utils_ptr));
+  }
+  return distance;
 }
 
 auto distanceToRightLaneBound(
@@ -230,17 +282,8 @@ auto distanceToRightLaneBound(
   const traffic_simulator_msgs::msg::BoundingBox & bounding_box, lanelet::Id lanelet_id,
   const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils_ptr) -> double
 {
-  if (const auto bound = hdmap_utils_ptr->getRightBound(lanelet_id); bound.empty()) {
-    THROW_SEMANTIC_ERROR(
-      "Failed to calculate right bounds of lanelet_id : ", lanelet_id,
-      " please check lanelet map.");
-  } else if (const auto polygon =
-               math::geometry::transformPoints(map_pose, math::geometry::toPolygon2D(bounding_box));
-             polygon.empty()) {
-    THROW_SEMANTIC_ERROR("Failed to calculate 2d polygon.");
-  } else {
-    return math::geometry::getDistance2D(bound, polygon);
-  }
+  return distanceToRightLaneBound(
+    toMapPolygon(map_pose, bounding_box), lanelet_id, hdmap_utils_ptr);
 }
 
 auto distanceToRightLaneBound(
@@ -251,12 +294,12 @@ auto distanceToRightLaneBound(
   if (lanelet_ids.empty()) {
     THROW_SEMANTIC_ERROR("Failing to calculate distanceToRightLaneBound for given empty vector.");
   }
-  std::vector<double> distances;
-  std::transform(
-    lanelet_ids.begin(), lanelet_ids.end(), std::back_inserter(distances), [&](auto lanelet_id) {
-      return distanceToRightLaneBound(map_pose, bounding_box, lanelet_id, hdmap_utils_ptr);
-    });
-  return *std::min_element(distances.begin(), distances.end());
+  const auto polygon = toMapPolygon(map_pose, bounding_box);
+  auto distance = std::numeric_limits<double>::max();
+  for (const auto lanelet_id : lanelet_ids) {
+    distance = std::min(distance, distanceToRightLaneBound(polygon, lanelet_id, hdmap_utils_ptr));
+  }
+  return distance;
 }
 
 auto distanceToLaneBound(
@@ -264,9 +307,7 @@ auto distanceToLaneBound(
   const traffic_simulator_msgs::msg::BoundingBox & bounding_box, lanelet::Id lanelet_id,
   const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils_ptr) -> double
 {
-  return std::min(
-    distanceToLeftLaneBound(map_pose, bounding_box, lanelet_id, hdmap_utils_ptr),
-    distanceToRightLaneBound(map_pose, bounding_box, lanelet_id, hdmap_utils_ptr));
+  return distanceToLaneBound(toMapPolygon(map_pose, bounding_box), {lanelet_id}, hdmap_utils_ptr);
 }
 
 auto distanceToLaneBound(
@@ -274,9 +315,21 @@ auto distanceToLaneBound(
   const traffic_simulator_msgs::msg::BoundingBox & bounding_box, const lanelet::Ids & lanelet_ids,
   const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils_ptr) -> double
 {
-  return std::min(
-    distanceToLeftLaneBound(map_pose, bounding_box, lanelet_ids, hdmap_utils_ptr),
-    distanceToRightLaneBound(map_pose, bounding_box, lanelet_ids, hdmap_utils_ptr));
+  return distanceToLaneBound(toMapPolygon(map_pose, bounding_box), lanelet_ids, hdmap_utils_ptr);
+}
+
+auto distancesToLaneBound(
+  const std::vector<std::tuple<
+    geometry_msgs::msg::Pose, traffic_simulator_msgs::msg::BoundingBox, lanelet::Ids>> & entities,
+  const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils_ptr) -> std::vector<double>
+{
+  std::vector<double> distances;
+  distances.reserve(entities.size());
+  for (const auto & [map_pose, bounding_box, lanelet_ids] : entities) {
+    distances.push_back(
+      distanceToLaneBound(toMapPolygon(map_pose, bounding_box), lanelet_ids, hdmap_utils_ptr));
+  }
+  return distances;
 }
 
 auto distanceToCrosswalk(
@@ -0,0 +1,294 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <scenario_simulator_exception/exception.hpp>
+#include <traffic_simulator/utils/entity_log.hpp>
+#include <utility>
+
+namespace traffic_simulator
+{
+namespace
+{
+constexpr char file_magic[8] = {'S', 'S', 'V', '2', 'E', 'L', 'O', 'G'};
+
+constexpr std::uint32_t file_version = 1;
+
+struct Header
+{
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t reserved;
+  std::uint64_t frame_count;
+  std::uint64_t entity_count;
+  std::uint64_t name_count;
+  std::uint64_t names_size;
+};
+
+struct Entity
+{
+  std::uint32_t id;
+  std::uint32_t reserved;
+  std::int64_t lanelet_id;
+  float position[3];
+  std::int16_t orientation[4];
+  float s;
+  float offset;
+  float linear_velocity;
+  float angular_velocity;
+  float linear_acceleration;
+};
+
+struct Frame
+{
+  double time;
+  std::uint64_t first_entity;
+};
+
+auto fileSize(const Header & header) -> std::size_t
+{
+  return sizeof(Header) + sizeof(Entity) * header.entity_count +
+         sizeof(Frame) * header.frame_count + header.names_size;
+}
+
+auto getEntities(const void * address) -> const Entity *
+{
+  return reinterpret_cast<const Entity *>(static_cast<const char *>(address) + sizeof(Header));
+}
+
+auto getFrames(const void * address) -> const Frame *
+{
+  return reinterpret_cast<const Frame *>(
+    getEntities(address) + static_cast<const Header *>(address)->entity_count);
+}
+
+/// @note The components of a unit quaternion are in [-1, 1].
+auto quantize(const double value) -> std::int16_t
+{
+  return static_cast<std::int16_t>(std::lround(std::clamp(value, -1.0, 1.0) * 32767.0));
+}
+
+auto dequantize(const std::int16_t value) -> double { return value / 32767.0; }
+}  // namespace
+
+EntityLog::Writer::Writer(const boost::filesystem::path & path)
+: file_(path, std::ios::binary | std::ios::trunc)
+{
+  /// @note The header is written again with the counts when the writer is destroyed.
+  const Header header = {};
+  file_.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  if (not file_) {
+    THROW_SIMULATION_ERROR("Failed to create the entity log ", path.string());
+  }
+}
+
+EntityLog::Writer::~Writer()
+{
+  std::vector<Frame> frames;
+  frames.reserve(times_.size());
+  for (std::size_t i = 0; i < times_.size(); ++i) {
+    frames.push_back({times_[i], first_entities_[i]});
+  }
+  std::string names;
+  for (const auto & name : names_) {
+    const auto size = static_cast<std::uint32_t>(name.size());
+    names.append(reinterpret_cast<const char *>(&size), sizeof(size));
+    names.append(name);
+  }
+
+  Header header = {};
+  std::memcpy(header.magic, file_magic, sizeof(file_magic));
+  header.version = file_version;
+  header.frame_count = frames.size();
+  header.entity_count = entity_count_;
+  header.name_count = names_.size();
+  header.names_size = names.size();
+
+  file_.write(reinterpret_cast<const char *>(frames.data()), sizeof(Frame) * frames.size());
+  file_.write(names.data(), names.size());
+  file_.seekp(0);
+  file_.write(reinterpret_cast<const char *>(&header), sizeof(header));
+}
+
+auto EntityLog::Writer::write(const double time, const OtherEntityStatus::Map & all_status) -> void
+{
+  std::vector<Entity> entities;
+  entities.reserve(all_status.size());
+  for (const auto & [name, status] : all_status) {
+    auto [iter, inserted] = ids_.try_emplace(name, names_.size());
+    if (inserted) {
+      names_.push_back(name);
+    }
+    const auto & pose = status.getMapPose();
+    auto & entity = entities.emplace_back();
+    entity.id = iter->second;
+    entity.position[0] = static_cast<float>(pose.position.x);
+    entity.position[1] = static_cast<float>(pose.position.y);
+    entity.position[2] = static_cast<float>(pose.position.z);
+    entity.orientation[0] = quantize(pose.orientation.x);
+    entity.orientation[1] = quantize(pose.orientation.y);
+    entity.orientation[2] = quantize(pose.orientation.z);
+    entity.orientation[3] = quantize(pose.orientation.w);
+    entity.linear_velocity = static_cast<float>(status.getTwist().linear.x);
+    entity.angular_velocity = static_cast<float>(status.getTwist().angular.z);
+    entity.linear_acceleration = static_cast<float>(status.getAccel().linear.x);
+    if (status.laneMatchingSucceed()) {
+      const auto & lanelet_pose = status.getLaneletPose();
+      entity.lanelet_id = lanelet_pose.lanelet_id;
+      entity.s = static_cast<float>(lanelet_pose.s);
+      entity.offset = static_cast<float>(lanelet_pose.offset);
+    } else {
+      entity.lanelet_id = lanelet::InvalId;
+    }
+  }
+  /// @note Sorted, so the same states are written the same regardless of the order of the map.
+  std::sort(entities.begin(), entities.end(), [](const auto & a, const auto & b) {
+    return a.id < b.id;
+  });
+  times_.push_back(time);
+  first_entities_.push_back(entity_count_);
+  entity_count_ += entities.size();
+  file_.write(
+    reinterpret_cast<const char *>(entities.data()), sizeof(Entity) * entities.size());
+}
+
+EntityLog::EntityLog(const void * address, const std::size_t size, std::vector<std::string> names)
+: address_(address), size_(size), names_(std::move(names))
+{
+}
+
+EntityLog::~EntityLog() { ::munmap(const_cast<void *>(address_), size_); }
+
+auto EntityLog::open(const boost::filesystem::path & path) -> std::unique_ptr<const EntityLog>
+{
+  const auto file_descriptor = ::open(path.c_str(), O_RDONLY);
+  if (file_descriptor < 0) {
+    return nullptr;
+  }
+  struct stat status;
+  if (::fstat(file_descriptor, &status) != 0 or status.st_size < ::off_t(sizeof(Header))) {
+    ::close(file_descriptor);
+    return nullptr;
+  }
+  const auto size = static_cast<std::size_t>(status.st_size);
+  const auto address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+  /// @note The mapping stays valid after the file descriptor is closed.
+  ::close(file_descriptor);
+  if (address == MAP_FAILED) {
+    return nullptr;
+  }
+
+  const auto & header = *static_cast<const Header *>(address);
+  const auto frames = getFrames(address);
+  if (
+    std::memcmp(header.magic, file_magic, sizeof(file_magic)) != 0 or
+    header.version != file_version or fileSize(header) != size or
+    header.name_count > header.names_size / sizeof(std::uint32_t) or
+    not std::is_sorted(
+      frames, frames + header.frame_count,
+      [](const auto & a, const auto & b) { return a.first_entity < b.first_entity; }) or
+    (header.frame_count > 0 and
+     frames[header.frame_count - 1].first_entity > header.entity_count)) {
+    ::munmap(address, size);
+    return nullptr;
+  }
+
+  std::vector<std::string> names;
+  names.reserve(header.name_count);
+  auto iter = reinterpret_cast<const char *>(frames + header.frame_count);
+  const auto end = iter + header.names_size;
+  for (std::size_t i = 0; i < header.name_count; ++i) {
+    std::uint32_t name_size;
+    if (end - iter < std::ptrdiff_t(sizeof(name_size))) {
+      break;
+    }
+    std::memcpy(&name_size, iter, sizeof(name_size));
+    iter += sizeof(name_size);
+    if (end - iter < std::ptrdiff_t(name_size)) {
+      break;
+    }
+    names.emplace_back(iter, name_size);
+    iter += name_size;
+  }
+  if (names.size() != header.name_count) {
+    ::munmap(address, size);
+    return nullptr;
+  }
+  return std::unique_ptr<const EntityLog>(new EntityLog(address, size, std::move(names)));
+}
+
+auto EntityLog::getFrameCount() const -> std::size_t
+{
+  return static_cast<const Header *>(address_)->frame_count;
+}
+
+auto EntityLog::getTime(const std::size_t frame) const -> double
+{
+  return getFrames(address_)[frame].time;
+}
+
+auto EntityLog::findFrame(const double time) const -> std::size_t
+{
+  const auto & header = *static_cast<const Header *>(address_);
+  const auto frames = getFrames(address_);
+  const auto iter = std::upper_bound(
+    frames, frames + header.frame_count, time,
+    [](const double time, const auto & frame) { return time < frame.time; });
+  return iter == frames ? 0 : std::distance(frames, iter) - 1;
+}
+
+auto EntityLog::getFrame(const std::size_t frame) const
+  -> std::vector<traffic_simulator_msgs::msg::EntityStatus>
+{
+  const auto & header = *static_cast<const Header *>(address_);
+  const auto entities = getEntities(address_);
+  const auto frames = getFrames(address_);
+  const auto first = frames[frame].first_entity;
+  const auto last =
+    frame + 1 < header.frame_count ? frames[frame + 1].first_entity : header.entity_count;
+
+  std::vector<traffic_simulator_msgs::msg::EntityStatus> statuses;
+  statuses.reserve(last - first);
+  for (auto i = first; i < last; ++i) {
+    const auto & entity = entities[i];
+    auto & status = statuses.emplace_back();
+    status.time = frames[frame].time;
+    status.name = entity.id < names_.size() ? names_[entity.id] : std::string();
+    status.pose.position.x = entity.position[0];
+    status.pose.position.y = entity.position[1];
+    status.pose.position.z = entity.position[2];
+    status.pose.orientation.x = dequantize(entity.orientation[0]);
+    status.pose.orientation.y = dequantize(entity.orientation[1]);
+    status.pose.orientation.z = dequantize(entity.orientation[2]);
+    status.pose.orientation.w = dequantize(entity.orientation[3]);
+    status.action_status.twist.linear.x = entity.linear_velocity;
+    status.action_status.twist.angular.z = entity.angular_velocity;
+    status.action_status.accel.linear.x = entity.linear_acceleration;
+    status.lanelet_pose_valid = entity.lanelet_id != lanelet::InvalId;
+    if (status.lanelet_pose_valid) {
+      status.lanelet_pose.lanelet_id = entity.lanelet_id;
+      status.lanelet_pose.s = entity.s;
+      status.lanelet_pose.offset = entity.offset;
+    }
+  }
+  return statuses;
+}
+}  // namespace traffic_simulator
@@ -0,0 +1,107 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <traffic_simulator/utils/thread_pool.hpp>
+
+namespace traffic_simulator
+{
+ThreadPool::ThreadPool(const std::size_t thread_count)
+: blocks_(std::make_unique<Block[]>(std::max<std::size_t>(1, thread_count)))
+{
+  for (std::size_t thread_index = 1; thread_index < thread_count; ++thread_index) {
+    workers_.emplace_back([this, thread_index]() { run(thread_index); });
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  start_condition_.notify_all();
+  for (auto & worker : workers_) {
+    worker.join();
+  }
+}
+
+auto ThreadPool::parallelFor(const std::size_t count, const std::function<void(std::size_t)> & task)
+  -> void
+{
+  if (count == 0) {
+    return;
+  }
+  exceptions_.assign(count, nullptr);
+  for (std::size_t thread_index = 0; thread_index < size(); ++thread_index) {
+    blocks_[thread_index].next.store(count * thread_index / size(), std::memory_order_relaxed);
+    blocks_[thread_index].end = count * (thread_index + 1) / size();
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    task_ = &task;
+    running_workers_ = workers_.size();
+    ++generation_;
+  }
+  start_condition_.notify_all();
+  work(0);
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    finish_condition_.wait(lock, [this]() { return running_workers_ == 0; });
+    task_ = nullptr;
+  }
+  for (const auto & exception : exceptions_) {
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+  }
+}
+
+auto ThreadPool::run(const std::size_t thread_index) -> void
+{
+  std::uint64_t generation = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      start_condition_.wait(lock, [&]() { return stopping_ or generation_ != generation; });
+      if (stopping_) {
+        return;
+      }
+      generation = generation_;
+    }
+    work(thread_index);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      --running_workers_;
+    }
+    finish_condition_.notify_one();
+  }
+}
+
+auto ThreadPool::work(const std::size_t thread_index) -> void
+{
+  /// @note Start from the own block, then visit the blocks of the following threads.
+  for (std::size_t offset = 0; offset < size(); ++offset) {
+    auto & block = blocks_[(thread_index + offset) % size()];
+    for (auto index = block.next.fetch_add(1, std::memory_order_relaxed); index < block.end;
+         index = block.next.fetch_add(1, std::memory_order_relaxed)) {
+      try {
+        (*task_)(index);
+      } catch (...) {
+        exceptions_[index] = std::current_exception();
+      }
+    }
+  }
+}
+}  // namespace traffic_simulator
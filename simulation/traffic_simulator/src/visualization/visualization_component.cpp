@@ -51,12 +51,15 @@
 #include <rclcpp_components/register_node_macro.hpp>
 #include <string>
 #include <traffic_simulator/visualization/visualization_component.hpp>
+#include <unordered_set>
 #include <vector>
 
 namespace traffic_simulator
 {
 VisualizationComponent::VisualizationComponent(const rclcpp::NodeOptions & options)
-: Node("visualization", options)
+: Node("visualization", options),
+  marker_publish_rate_(declare_parameter<double>("marker_publish_rate", 0.0)),
+  marker_lifetime_(marker_publish_rate_ > 0.0 ? std::max(0.1, 2.0 / marker_publish_rate_) : 0.1)
 {
   marker_pub_ = create_publisher<visualization_msgs::msg::MarkerArray>("entity/marker", 1);
   entity_status_sub_ =
@@ -68,32 +71,71 @@ VisualizationComponent::VisualizationComponent(const rclcpp::NodeOptions & optio
 void VisualizationComponent::entityStatusCallback(
   const traffic_simulator_msgs::msg::EntityStatusWithTrajectoryArray::ConstSharedPtr msg)
 {
+  /*
+     The goal poses and waypoints are taken from every message, even the ones
+     not published, because the waypoints of a message are only sent when
+     they changed.
+  */
+  for (const auto & data : msg->data) {
+    auto & entity = entities_[data.name];
+    if (not data.waypoint_unchanged and data.waypoint != entity.waypoints) {
+      entity.waypoints = data.waypoint;
+      entity.spline =
+        entity.waypoints.waypoints.size() > 2
+          ? std::make_shared<const math::geometry::CatmullRomSpline>(entity.waypoints.waypoints)
+          : nullptr;
+      entity.static_markers_changed = true;
+    }
+    if (data.goal_pose != entity.goal_pose) {
+      entity.goal_pose = data.goal_pose;
+      entity.static_markers_changed = true;
+    }
+  }
+
+  const auto now = get_clock()->now().seconds();
+  if (const auto elapsed = now - last_publish_time_;
+      marker_publish_rate_ > 0.0 and 0.0 <= elapsed and elapsed < 1.0 / marker_publish_rate_) {
+    return;
+  } else {
+    last_publish_time_ = now;
+  }
+
+  /// @note The markers kept without lifetime are sent again once per second for late subscribers.
+  const auto refresh_static_markers = [&]() {
+    if (const auto elapsed = now - last_static_markers_time_; elapsed < 0.0 or 1.0 <= elapsed) {
+      last_static_markers_time_ = now;
+      return true;
+    } else {
+      return false;
+    }
+  }();
+
   visualization_msgs::msg::MarkerArray current_marker;
-  std::vector<std::string> entity_name_lists;
+  std::unordered_set<std::string> entity_names;
   for (const auto & data : msg->data) {
-    entity_name_lists.emplace_back(data.status.name);
+    entity_names.emplace(data.name);
   }
-  std::vector<std::string> erase_names;
-  for (const auto & marker : markers_) {
-    auto itr = std::find(entity_name_lists.begin(), entity_name_lists.end(), marker.first);
-    if (itr == entity_name_lists.end()) {
-      auto delete_marker = generateDeleteMarker(marker.first);
-      std::copy(
+  for (auto iter = entities_.begin(); iter != entities_.end();) {
+    if (entity_names.count(iter->first) == 0) {
+      auto delete_marker = generateDeleteMarker(iter->first);
+      std::move(
         delete_marker.markers.begin(), delete_marker.markers.end(),
         std::back_inserter(current_marker.markers));
-      erase_names.emplace_back(marker.first);
+      iter = entities_.erase(iter);
+    } else {
+      ++iter;
     }
   }
-  for (const auto & name : erase_names) {
-    markers_.erase(markers_.find(name));
-  }
   for (const auto & data : msg->data) {
-    auto marker_array =
-      generateMarker(data.status, data.goal_pose, data.waypoint, data.obstacle, data.obstacle_find);
-    std::copy(
-      marker_array.markers.begin(), marker_array.markers.end(),
-      std::back_inserter(current_marker.markers));
-    markers_[data.name] = marker_array;
+    auto & entity = entities_[data.name];
+    auto marker_array = generateMarker(
+      data.status, entity, data.obstacle, data.obstacle_find,
+      entity.static_markers_changed or refresh_static_markers);
+    entity.static_markers_changed = false;
+    for (auto & marker : marker_array.markers) {
+      entity.ids.insert(marker.id);
+      current_marker.markers.push_back(std::move(marker));
+    }
   }
   marker_pub_->publish(current_marker);
 }
@@ -103,27 +145,27 @@ const visualization_msgs::msg::MarkerArray VisualizationComponent::generateDelet
 {
   auto ret = visualization_msgs::msg::MarkerArray();
   auto stamp = get_clock()->now();
-  for (const auto & marker : markers_[ns].markers) {
+  for (const auto & id : entities_[ns].ids) {
     visualization_msgs::msg::Marker marker_msg;
     marker_msg.action = marker_msg.DELETE;
     marker_msg.header.frame_id = ns;
     marker_msg.header.stamp = stamp;
-    marker_msg.ns = marker.ns;
-    marker_msg.id = marker.id;
+    marker_msg.ns = ns;
+    marker_msg.id = id;
     ret.markers.emplace_back(marker_msg);
   }
   return ret;
 }
 
 const visualization_msgs::msg::MarkerArray VisualizationComponent::generateMarker(
-  const traffic_simulator_msgs::msg::EntityStatus & status,
-  const std::vector<geometry_msgs::msg::Pose> & goal_pose,
-  const traffic_simulator_msgs::msg::WaypointsArray & waypoints,
-  const traffic_simulator_msgs::msg::Obstacle & obstacle, bool obstacle_find)
+  const traffic_simulator_msgs::msg::EntityStatus & status, const EntityMarkers & entity,
+  const traffic_simulator_msgs::msg::Obstacle & obstacle, bool obstacle_find, bool static_markers)
 {
   constexpr auto default_quaternion = rosidl_runtime_cpp::MessageInitialization::DEFAULTS_ONLY;
   auto ret = visualization_msgs::msg::MarkerArray();
   auto stamp = get_clock()->now();
+  const auto lifetime = rclcpp::Duration::from_seconds(marker_lifetime_);
+  const auto & goal_pose = entity.goal_pose;
 
   const auto color = [&]() {
     switch (status.type.type) {
@@ -139,7 +181,8 @@ const visualization_msgs::msg::MarkerArray VisualizationComponent::generateMarke
     }
   }();
 
-  if (goal_pose.size() != 0) {
+  /// @note The goal pose markers are kept without lifetime until the goal poses change.
+  if (static_markers and goal_pose.size() != 0) {
     goal_pose_max_size = std::max(goal_pose_max_size, int(goal_pose.size()));
     for (std::vector<geometry_msgs::msg::Pose>::size_type i = 0; i < unsigned(goal_pose_max_size);
          i++) {
@@ -156,7 +199,6 @@ const visualization_msgs::msg::MarkerArray VisualizationComponent::generateMarke
         goal_pose_marker.scale.x = 1.6;
         goal_pose_marker.scale.y = 0.2;
         goal_pose_marker.scale.z = 0.2;
-        goal_pose_marker.lifetime = rclcpp::Duration::from_seconds(0.1);
         ret.markers.emplace_back(goal_pose_marker);
 
         visualization_msgs::msg::Marker goal_pose_text_marker;
@@ -174,7 +216,6 @@ const visualization_msgs::msg::MarkerArray VisualizationComponent::generateMarke
         goal_pose_text_marker.scale.x = 0.0;
         goal_pose_text_marker.scale.y = 0.0;
         goal_pose_text_marker.scale.z = 0.6;
-        goal_pose_text_marker.lifetime = rclcpp::Duration::from_seconds(0.1);
         goal_pose_text_marker.text =
           status.name + "_goal_" + std::to_string(int(goal_pose_max_size - goal_pose.size() + i));
         goal_pose_text_marker.color = color_names::makeColorMsg("white", 0.99);
@@ -192,7 +233,7 @@ const visualization_msgs::msg::MarkerArray VisualizationComponent::generateMarke
         ret.markers.emplace_back(goal_pose_text_marker);
       }
     }
-  } else {
+  } else if (static_markers) {
     visualization_msgs::msg::Marker goal_pose_marker;
     goal_pose_marker.action = goal_pose_marker.DELETE;
     goal_pose_marker.id = 10 + int(goal_pose_max_size - 1);
@@ -212,7 +253,7 @@ const visualization_msgs::msg::MarkerArray VisualizationComponent::generateMarke
   bbox.id = 0;
   bbox.action = bbox.ADD;
   bbox.type = bbox.LINE_LIST;
-  bbox.lifetime = rclcpp::Duration::from_seconds(0.1);
+  bbox.lifetime = lifetime;
   geometry_msgs::msg::Point p0, p1, p2, p3, p4, p5, p6, p7;
 
   p0.x = status.bounding_box.center.x + status.bounding_box.dimensions.x * 0.5;
@@ -325,7 +366,7 @@ const visualization_msgs::msg::MarkerArray VisualizationComponent::generateMarke
   text.scale.x = 0.0;
   text.scale.y = 0.0;
   text.scale.z = 0.6;
-  text.lifetime = rclcpp::Duration::from_seconds(0.1);
+  text.lifetime = lifetime;
   text.text = status.name;
   text.color = color_names::makeColorMsg("white", 0.99);
   ret.markers.emplace_back(text);
@@ -364,7 +405,7 @@ const visualization_msgs::msg::MarkerArray VisualizationComponent::generateMarke
   arrow.scale.x = 1.0;
   arrow.scale.y = 1.0;
   arrow.scale.z = 1.0;
-  arrow.lifetime = rclcpp::Duration::from_seconds(0.1);
+  arrow.lifetime = lifetime;
   arrow.color = color_names::makeColorMsg("red", 0.99);
   ret.markers.emplace_back(arrow);
 
@@ -381,7 +422,7 @@ const visualization_msgs::msg::MarkerArray VisualizationComponent::generateMarke
   text_action.scale.x = 0.0;
   text_action.scale.y = 0.0;
   text_action.scale.z = 0.4;
-  text_action.lifetime = rclcpp::Duration::from_seconds(0.1);
+  text_action.lifetime = lifetime;
   text_action.text = status.action_status.current_action;
   if (status.lanelet_pose_valid) {
     text_action.text = text_action.text + "\nid:" + std::to_string(status.lanelet_pose.lanelet_id) +
@@ -397,29 +438,30 @@ const visualization_msgs::msg::MarkerArray VisualizationComponent::generateMarke
   text_action.color = color_names::makeColorMsg("white", 0.99);
   ret.markers.emplace_back(text_action);
 
-  if (waypoints.waypoints.size() > 2) {
-    math::geometry::CatmullRomSpline spline(waypoints.waypoints);
-
-    /**
-     * @brief generate marker for waypoints
-     */
-    visualization_msgs::msg::Marker waypoints_marker;
-    waypoints_marker.header.frame_id = "map";
-    waypoints_marker.header.stamp = stamp;
-    waypoints_marker.ns = status.name;
-    waypoints_marker.id = 4;
-    waypoints_marker.action = waypoints_marker.ADD;
-    waypoints_marker.type = waypoints_marker.TRIANGLE_LIST;
-    size_t num_points = 20;
-    waypoints_marker.points = spline.getPolygon(status.bounding_box.dimensions.y, num_points);
-    waypoints_marker.color = color;
-    waypoints_marker.color.a = 0.8;
-    waypoints_marker.colors =
-      std::vector<std_msgs::msg::ColorRGBA>(num_points * 2, waypoints_marker.color);
-    waypoints_marker.scale.x = 1.0;
-    waypoints_marker.scale.y = 1.0;
-    waypoints_marker.scale.z = 1.0;
-    ret.markers.emplace_back(waypoints_marker);
+  if (entity.spline) {
+    if (static_markers) {
+      /**
+       * @brief generate marker for waypoints
+       */
+      visualization_msgs::msg::Marker waypoints_marker;
+      waypoints_marker.header.frame_id = "map";
+      waypoints_marker.header.stamp = stamp;
+      waypoints_marker.ns = status.name;
+      waypoints_marker.id = 4;
+      waypoints_marker.action = waypoints_marker.ADD;
+      waypoints_marker.type = waypoints_marker.TRIANGLE_LIST;
+      size_t num_points = 20;
+      waypoints_marker.points =
+        entity.spline->getPolygon(status.bounding_box.dimensions.y, num_points);
+      waypoints_marker.color = color;
+      waypoints_marker.color.a = 0.8;
+      waypoints_marker.colors =
+        std::vector<std_msgs::msg::ColorRGBA>(num_points * 2, waypoints_marker.color);
+      waypoints_marker.scale.x = 1.0;
+      waypoints_marker.scale.y = 1.0;
+      waypoints_marker.scale.z = 1.0;
+      ret.markers.emplace_back(waypoints_marker);
+    }
     if (obstacle_find) {
       /**
        * @brief generate marker for obstacle
@@ -431,7 +473,7 @@ const visualization_msgs::msg::MarkerArray VisualizationComponent::generateMarke
       obstacle_marker.id = 5;
       obstacle_marker.action = obstacle_marker.ADD;
       obstacle_marker.type = obstacle_marker.CUBE;
-      obstacle_marker.pose = spline.getPose(obstacle.s);
+      obstacle_marker.pose = entity.spline->getPose(obstacle.s);
       obstacle_marker.pose.position.z =
         obstacle_marker.pose.position.z + status.bounding_box.dimensions.z * 0.5;
       obstacle_marker.color = color_names::makeColorMsg("red", 0.5);
@@ -447,11 +489,13 @@ const visualization_msgs::msg::MarkerArray VisualizationComponent::generateMarke
       ret.markers.emplace_back(obstacle_marker);
     }
   } else {
-    visualization_msgs::msg::Marker waypoints_marker;
-    waypoints_marker.action = waypoints_marker.DELETE;
-    waypoints_marker.id = 4;
-    waypoints_marker.ns = status.name;
-    ret.markers.emplace_back(waypoints_marker);
+    if (static_markers) {
+      visualization_msgs::msg::Marker waypoints_marker;
+      waypoints_marker.action = waypoints_marker.DELETE;
+      waypoints_marker.id = 4;
+      waypoints_marker.ns = status.name;
+      ret.markers.emplace_back(waypoints_marker);
+    }
     visualization_msgs::msg::Marker obstacle_marker;
     obstacle_marker.action = obstacle_marker.DELETE;
     obstacle_marker.id = 5;
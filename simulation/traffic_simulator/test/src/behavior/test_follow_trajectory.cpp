@@ -0,0 +1,131 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <geometry/vector3/hypot.hpp>
+#include <limits>
+#include <traffic_simulator/behavior/follow_trajectory.hpp>
+#include <traffic_simulator/helper/helper.hpp>
+
+#include "../helper_functions.hpp"
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+
+class PolylineTrajectorySamplesTest : public testing::Test
+{
+protected:
+  PolylineTrajectorySamplesTest() : hdmap_utils_ptr(makeHdMapUtilsSharedPointer())
+  {
+    for (const auto & [s, time] : std::vector<std::pair<double, double>>{
+           {0.0, std::numeric_limits<double>::quiet_NaN()},
+           {10.0, std::numeric_limits<double>::quiet_NaN()},
+           {20.0, 5.0},
+           {30.0, std::numeric_limits<double>::quiet_NaN()}}) {
+      auto vertex = traffic_simulator_msgs::msg::Vertex();
+      vertex.time = time;
+      vertex.position =
+        hdmap_utils_ptr->toMapPose(traffic_simulator::helper::constructLaneletPose(34513, s)).pose;
+      polyline_trajectory.shape.vertices.push_back(vertex);
+    }
+  }
+
+  /// @note The distance computed from the vertices, as makeUpdatedStatus does without samples.
+  auto distanceAlongLanelet(std::size_t from, std::size_t to) const -> double
+  {
+    const auto & from_position = polyline_trajectory.shape.vertices[from].position.position;
+    const auto & to_position = polyline_trajectory.shape.vertices[to].position.position;
+    return hdmap_utils_ptr
+      ->getLongitudinalDistance(
+        hdmap_utils_ptr->toLaneletPose(from_position, bounding_box, false, matching_distance)
+          .value(),
+        hdmap_utils_ptr->toLaneletPose(to_position, bounding_box, false, matching_distance).value())
+      .value_or(math::geometry::hypot(from_position, to_position));
+  }
+
+  static constexpr double matching_distance = 1.0;
+
+  std::shared_ptr<hdmap_utils::HdMapUtils> hdmap_utils_ptr;
+  traffic_simulator_msgs::msg::BoundingBox bounding_box = makeBoundingBox();
+  traffic_simulator_msgs::msg::PolylineTrajectory polyline_trajectory;
+};
+
+/**
+ * @note Test basic functionality.
+ * Test the distances and the waypoint with arrival time of a trajectory
+ * that is not closed - the goal is to match the computation from the vertices while the cursor
+ * advances along with popping the front vertex.
+ */
+TEST_F(PolylineTrajectorySamplesTest, advance_notClosed)
+{
+  auto samples = traffic_simulator::follow_trajectory::PolylineTrajectorySamples(
+    polyline_trajectory, bounding_box, hdmap_utils_ptr, matching_distance);
+
+  EXPECT_TRUE(samples.isSampling(polyline_trajectory));
+  EXPECT_EQ(samples.getIndexOfFirstWaypointWithArrivalTimeSpecified(), 2UL);
+  EXPECT_NEAR(samples.getDistanceTo(0), 0.0, 1e-9);
+  EXPECT_NEAR(
+    samples.getDistanceTo(2), distanceAlongLanelet(0, 1) + distanceAlongLanelet(1, 2), 1e-9);
+  EXPECT_NEAR(samples.getDistanceTo(3), 30.0, 1e-1);
+
+  polyline_trajectory.shape.vertices.erase(polyline_trajectory.shape.vertices.begin());
+  EXPECT_FALSE(samples.isSampling(polyline_trajectory));
+  samples.advance();
+  EXPECT_TRUE(samples.isSampling(polyline_trajectory));
+  EXPECT_EQ(samples.getIndexOfFirstWaypointWithArrivalTimeSpecified(), 1UL);
+  EXPECT_NEAR(samples.getDistanceTo(2), 20.0, 1e-1);
+
+  polyline_trajectory.shape.vertices.erase(polyline_trajectory.shape.vertices.begin());
+  samples.advance();
+  polyline_trajectory.shape.vertices.erase(polyline_trajectory.shape.vertices.begin());
+  samples.advance();
+  EXPECT_TRUE(samples.isSampling(polyline_trajectory));
+  EXPECT_EQ(samples.getIndexOfFirstWaypointWithArrivalTimeSpecified(), 1UL);
+  EXPECT_NEAR(samples.getDistanceTo(0), 0.0, 1e-9);
+}
+
+/**
+ * @note Test basic functionality.
+ * Test the distances of a closed trajectory - the goal is to follow the vertices rotated
+ * across the end of the trajectory.
+ */
+TEST_F(PolylineTrajectorySamplesTest, advance_closed)
+{
+  polyline_trajectory.closed = true;
+
+  auto samples = traffic_simulator::follow_trajectory::PolylineTrajectorySamples(
+    polyline_trajectory, bounding_box, hdmap_utils_ptr, matching_distance);
+
+  for (std::size_t i = 0; i < 6; ++i) {
+    auto & vertices = polyline_trajectory.shape.vertices;
+    std::rotate(vertices.begin(), vertices.begin() + 1, vertices.end());
+    samples.advance();
+    EXPECT_TRUE(samples.isSampling(polyline_trajectory));
+    EXPECT_EQ(
+      samples.getIndexOfFirstWaypointWithArrivalTimeSpecified(),
+      static_cast<std::size_t>(std::distance(
+        vertices.begin(), std::find_if(vertices.begin(), vertices.end(), [](const auto & vertex) {
+          return not std::isnan(vertex.time);
+        }))));
+    EXPECT_NEAR(
+      samples.getDistanceTo(vertices.size() - 1) - samples.getDistanceTo(vertices.size() - 2),
+      distanceAlongLanelet(vertices.size() - 2, vertices.size() - 1), 1e-9);
+  }
+}
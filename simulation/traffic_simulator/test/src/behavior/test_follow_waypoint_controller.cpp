@@ -0,0 +1,87 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <traffic_simulator/behavior/follow_waypoint_controller.hpp>
+#include <tuple>
+#include <vector>
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+
+class FollowWaypointControllerTest : public testing::Test
+{
+protected:
+  static constexpr double step_time = 0.05;
+
+  /// @return Number of steps until arrival and the remaining distance at arrival.
+  static auto drive(
+    const bool use_bisection, const double distance, const double time, const double speed)
+    -> std::tuple<std::size_t, double>
+  {
+    auto behavior_parameter = traffic_simulator_msgs::msg::BehaviorParameter();
+    behavior_parameter.dynamic_constraints.max_speed = 10.0;
+    behavior_parameter.dynamic_constraints.max_acceleration = 2.0;
+    behavior_parameter.dynamic_constraints.max_acceleration_rate = 2.0;
+    behavior_parameter.dynamic_constraints.max_deceleration = 2.0;
+    behavior_parameter.dynamic_constraints.max_deceleration_rate = 2.0;
+    behavior_parameter.use_bisection_for_follow_waypoint = use_bisection;
+
+    const auto controller =
+      traffic_simulator::follow_trajectory::FollowWaypointController(
+        behavior_parameter, step_time, true);
+
+    double acceleration = 0.0, current_speed = speed, remaining_distance = distance;
+    std::size_t steps = 0;
+    for (; not controller.areConditionsOfArrivalMet(acceleration, current_speed, remaining_distance)
+           and steps < 10000;
+         ++steps) {
+      acceleration = controller.getAcceleration(
+        time - steps * step_time, remaining_distance, acceleration, current_speed);
+      current_speed += acceleration * step_time;
+      remaining_distance -= current_speed * step_time;
+    }
+    return {steps, remaining_distance};
+  }
+};
+
+/**
+ * @note Test functionality used by other units.
+ * Test arrival at the last waypoint with a specified time and without one,
+ * - the goal is to test that the bisection arrives like the discretization of the candidates.
+ */
+TEST_F(FollowWaypointControllerTest, getAcceleration_bisection)
+{
+  for (const auto & [distance, time, speed] : std::vector<std::tuple<double, double, double>>{
+         {30.0, 8.0, 3.0},
+         {50.0, 12.5, 0.0},
+         {20.0, 6.0, 5.0},
+         {40.0, std::numeric_limits<double>::infinity(), 5.0}}) {
+    const auto [expected_steps, expected_distance] = drive(false, distance, time, speed);
+    const auto [steps, remaining_distance] = drive(true, distance, time, speed);
+
+    if (not std::isinf(time)) {
+      EXPECT_NEAR(steps * step_time, time, step_time);
+    }
+    EXPECT_NEAR(
+      static_cast<double>(steps), static_cast<double>(expected_steps), 1.0);
+    EXPECT_NEAR(remaining_distance, expected_distance, 1e-2);
+    EXPECT_LT(std::abs(remaining_distance), 1e-2);
+  }
+}
@@ -19,6 +19,8 @@
 #include <geometry_msgs/msg/twist.hpp>
 #include <geometry_msgs/msg/vector3.hpp>
 #include <traffic_simulator/behavior/longitudinal_speed_planning.hpp>
+#include <tuple>
+#include <vector>
 
 #include "../expect_eq_macros.hpp"
 
@@ -307,3 +309,41 @@ TEST_F(LongitudinalSpeedPlannerTest, getRunningDistance_zero)
 
   EXPECT_EQ(distance, 0.0);
 }
+
+/**
+ * @note Test functionality aggregation used in other classes.
+ * Test calculations correctness against stepping getDynamicStates until the target speed is reached
+ * - goal is to test that the closed form gives the same distance as the simulated steps,
+ * both when accelerating and when decelerating against the current acceleration.
+ */
+TEST_F(LongitudinalSpeedPlannerTest, getRunningDistance_steps)
+{
+  const auto constraints =
+    traffic_simulator_msgs::build<traffic_simulator_msgs::msg::DynamicConstraints>()
+      .max_acceleration(3.0)
+      .max_acceleration_rate(2.0)
+      .max_deceleration(4.0)
+      .max_deceleration_rate(3.0)
+      .max_speed(30.0);
+
+  for (const auto & [current_speed, current_acceleration, target_speed] :
+       std::vector<std::tuple<double, double, double>>{
+         {0.0, 0.0, 20.0}, {10.0, -1.0, 25.0}, {20.0, 2.0, 0.0}, {-5.0, 0.0, 5.0}}) {
+    const auto current_twist = makeTwistWithLinearX(current_speed);
+    const auto current_accel = makeAccelWithLinearX(current_acceleration);
+
+    double expected = 0.0;
+    auto state = std::make_tuple(current_twist, current_accel, 0.0);
+    do {
+      state = planner.getDynamicStates(
+        target_speed, constraints, std::get<0>(state), std::get<1>(state));
+      expected += std::get<0>(state).linear.x * planner.step_time +
+                  std::get<1>(state).linear.x * planner.step_time * planner.step_time / 2.0 +
+                  std::get<2>(state) * std::pow(planner.step_time, 3) / 6.0;
+    } while (not planner.isTargetSpeedReached(target_speed, std::get<0>(state), 0.01));
+
+    EXPECT_NEAR(
+      planner.getRunningDistance(target_speed, constraints, current_twist, current_accel, 0.0),
+      expected, 1e-4);
+  }
+}
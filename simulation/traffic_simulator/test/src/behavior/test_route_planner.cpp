@@ -128,3 +128,23 @@ TEST_F(RoutePlannerTest, getRouteLanelets_empty)
     EXPECT_EQ(following_ids[i], route[i]);
   }
 }
+
+/**
+ * @note Test functionality used by other units.
+ * Test that the route spline is reused while the entity stays on the same lanelet
+ * and rebuilt when it moves on to the next one.
+ */
+TEST_F(RoutePlannerTest, getRouteSpline)
+{
+  EXPECT_EQ(planner.getRouteSpline(), nullptr);
+
+  planner.getRouteLanelets(makeCanonicalizedLaneletPose(hdmap_utils_ptr, 120659, 1.0), 100.0);
+  const auto spline = planner.getRouteSpline();
+  ASSERT_NE(spline, nullptr);
+
+  planner.getRouteLanelets(makeCanonicalizedLaneletPose(hdmap_utils_ptr, 120659, 5.0), 100.0);
+  EXPECT_EQ(planner.getRouteSpline(), spline);
+
+  planner.getRouteLanelets(makeCanonicalizedLaneletPose(hdmap_utils_ptr, 120660), 100.0);
+  EXPECT_NE(planner.getRouteSpline(), spline);
+}
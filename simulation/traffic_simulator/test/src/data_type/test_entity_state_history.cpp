@@ -0,0 +1,74 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <traffic_simulator/data_type/entity_state_history.hpp>
+
+#include "../helper_functions.hpp"
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+
+auto makeStatus(const double x, const double speed) -> traffic_simulator::CanonicalizedEntityStatus
+{
+  return traffic_simulator::CanonicalizedEntityStatus(
+    makeEntityStatus(nullptr, makePose(makePoint(x, 0.0)), makeBoundingBox(), speed),
+    std::nullopt);
+}
+
+TEST(EntityStateHistory, empty)
+{
+  const traffic_simulator::EntityStateHistory history;
+  EXPECT_TRUE(history.empty());
+  EXPECT_EQ(history.size(), 0u);
+  EXPECT_THROW(history.latest(), std::out_of_range);
+}
+
+TEST(EntityStateHistory, push)
+{
+  traffic_simulator::EntityStateHistory history;
+  history.push(0.1, makeStatus(1.0, 2.0));
+  history.push(0.2, makeStatus(3.0, 4.0));
+  EXPECT_EQ(history.size(), 2u);
+  EXPECT_DOUBLE_EQ(history.latest().time, 0.2);
+  EXPECT_DOUBLE_EQ(history.latest().pose.position.x, 3.0);
+  EXPECT_DOUBLE_EQ(history.latest().twist.linear.x, 4.0);
+  EXPECT_FALSE(history.latest().lanelet_pose_valid);
+  EXPECT_DOUBLE_EQ(history.oldest().time, 0.1);
+  EXPECT_DOUBLE_EQ(history.at(1).pose.position.x, 1.0);
+  EXPECT_THROW(history.at(2), std::out_of_range);
+}
+
+TEST(EntityStateHistory, overwriteOldest)
+{
+  traffic_simulator::EntityStateHistory history;
+  constexpr auto capacity = traffic_simulator::EntityStateHistory::capacity;
+  for (std::size_t i = 0; i < capacity + 5; ++i) {
+    history.push(static_cast<double>(i), makeStatus(static_cast<double>(i), 0.0));
+  }
+  EXPECT_EQ(history.size(), capacity);
+  EXPECT_DOUBLE_EQ(history.latest().time, static_cast<double>(capacity + 4));
+  EXPECT_DOUBLE_EQ(history.oldest().time, 5.0);
+  for (std::size_t age = 0; age < capacity; ++age) {
+    EXPECT_DOUBLE_EQ(history.at(age).time, static_cast<double>(capacity + 4 - age));
+  }
+
+  history.clear();
+  EXPECT_TRUE(history.empty());
+}
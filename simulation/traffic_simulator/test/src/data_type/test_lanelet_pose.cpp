@@ -159,6 +159,59 @@ TEST_F(CanonicalizedLaneletPoseTest, conversionPose)
   EXPECT_POSE_NEAR(static_cast<geometry_msgs::msg::Pose>(pose), pose1, 0.01);
 }
 
+/**
+ * @note Test copies made before the derived poses are first accessed - the goal is to get the same
+ * map pose and alternative poses from the copy as from the pose copied.
+ */
+TEST_F(CanonicalizedLaneletPoseTest, copyBeforeDerivedPoses)
+{
+  const CanonicalizedLaneletPose pose(
+    traffic_simulator::helper::constructLaneletPose(120659, -10.0, 0.0), hdmap_utils);
+  const CanonicalizedLaneletPose expected_pose(
+    traffic_simulator::helper::constructLaneletPose(120659, -10.0, 0.0), hdmap_utils);
+  const auto copied_pose = pose;
+
+  EXPECT_TRUE(copied_pose.hasAlternativeLaneletPose());
+  EXPECT_TRUE(pose.hasAlternativeLaneletPose());
+  EXPECT_POSE_NEAR(copied_pose.getMapPose(), expected_pose.getMapPose(), 1e-6);
+  EXPECT_POSE_NEAR(pose.getMapPose(), expected_pose.getMapPose(), 1e-6);
+}
+
+/**
+ * @note Test function behavior when the moved pose stays on its lanelet - the goal is to get the same
+ * pose as the one canonicalized from scratch.
+ */
+TEST_F(CanonicalizedLaneletPoseTest, moveAlongLanelet_inside)
+{
+  const CanonicalizedLaneletPose pose(
+    traffic_simulator::helper::constructLaneletPose(34606, 1.0, 0.5), hdmap_utils);
+  const CanonicalizedLaneletPose expected_pose(
+    traffic_simulator::helper::constructLaneletPose(34606, 3.0, 0.5), hdmap_utils);
+
+  const auto moved_pose = pose.moveAlongLanelet(2.0, hdmap_utils);
+
+  ASSERT_TRUE(moved_pose.has_value());
+  EXPECT_LANELET_POSE_EQ(
+    static_cast<traffic_simulator::LaneletPose>(moved_pose.value()),
+    static_cast<traffic_simulator::LaneletPose>(expected_pose));
+  EXPECT_POSE_NEAR(
+    static_cast<geometry_msgs::msg::Pose>(moved_pose.value()),
+    static_cast<geometry_msgs::msg::Pose>(expected_pose), 1e-6);
+}
+
+/**
+ * @note Test function behavior when the moved pose leaves its lanelet - the goal is to get std::nullopt.
+ */
+TEST_F(CanonicalizedLaneletPoseTest, moveAlongLanelet_outside)
+{
+  const CanonicalizedLaneletPose pose(
+    traffic_simulator::helper::constructLaneletPose(34606, 1.0, 0.0), hdmap_utils);
+
+  EXPECT_FALSE(pose.moveAlongLanelet(-2.0, hdmap_utils).has_value());
+  EXPECT_FALSE(
+    pose.moveAlongLanelet(hdmap_utils->getLaneletLength(34606), hdmap_utils).has_value());
+}
+
 /**
  * @note Test function behavior when alternative poses are present
  */
@@ -0,0 +1,137 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <traffic_simulator/data_type/other_entity_status.hpp>
+#include <utility>
+
+#include "../helper_functions.hpp"
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+
+auto makeAllStatus(const std::set<std::string> & names)
+  -> std::shared_ptr<const traffic_simulator::OtherEntityStatus::Map>
+{
+  auto all_status = std::make_shared<traffic_simulator::OtherEntityStatus::Map>();
+  for (const auto & name : names) {
+    const auto entity_status =
+      makeEntityStatus(nullptr, makePose(makePoint(0.0, 0.0)), makeBoundingBox(), 0.0, name);
+    all_status->emplace(
+      name, traffic_simulator::CanonicalizedEntityStatus(entity_status, std::nullopt));
+  }
+  return all_status;
+}
+
+/**
+ * @note Test that the status of the excluded entity is hidden from every accessor.
+ */
+TEST(OtherEntityStatus, excludedName)
+{
+  const traffic_simulator::OtherEntityStatus other_status(
+    makeAllStatus({"ego", "npc0", "npc1"}), "ego");
+
+  EXPECT_EQ(other_status.size(), 2U);
+  EXPECT_FALSE(other_status.empty());
+  EXPECT_EQ(other_status.find("ego"), other_status.end());
+  EXPECT_EQ(other_status.count("ego"), 0U);
+  EXPECT_THROW(other_status.at("ego"), std::out_of_range);
+  EXPECT_EQ(other_status.at("npc0").getName(), "npc0");
+  EXPECT_EQ(other_status.find("npc1")->second.getName(), "npc1");
+  EXPECT_EQ(other_status.find("npc2"), other_status.end());
+
+  std::set<std::string> names;
+  for (const auto & [name, status] : other_status) {
+    EXPECT_EQ(name, status.getName());
+    names.insert(name);
+  }
+  EXPECT_EQ(names, (std::set<std::string>{"npc0", "npc1"}));
+}
+
+/**
+ * @note Test that views of the same frame share the statuses instead of copying them.
+ */
+TEST(OtherEntityStatus, shared)
+{
+  const auto all_status = makeAllStatus({"ego", "npc0"});
+  const traffic_simulator::OtherEntityStatus ego_view(all_status, "ego");
+  const traffic_simulator::OtherEntityStatus npc_view(all_status, "npc0");
+  const auto copied_view = ego_view;
+
+  EXPECT_EQ(ego_view.getAllStatus(), npc_view.getAllStatus());
+  EXPECT_EQ(copied_view.getAllStatus(), all_status);
+  EXPECT_EQ(&ego_view.at("npc0"), &npc_view.getAllStatus()->at("npc0"));
+  EXPECT_EQ(copied_view.find("ego"), copied_view.end());
+  EXPECT_EQ(npc_view.begin()->first, "ego");
+  EXPECT_EQ(std::next(npc_view.begin()), npc_view.end());
+}
+
+/**
+ * @note Test that a view made of a plain map or by default hides nothing.
+ */
+TEST(OtherEntityStatus, withoutExcludedName)
+{
+  const traffic_simulator::OtherEntityStatus other_status(*makeAllStatus({"npc0", "npc1"}));
+  EXPECT_EQ(other_status.size(), 2U);
+  EXPECT_NE(other_status.find("npc0"), other_status.end());
+
+  const traffic_simulator::OtherEntityStatus empty_status;
+  EXPECT_TRUE(empty_status.empty());
+  EXPECT_EQ(empty_status.begin(), empty_status.end());
+}
+
+/**
+ * @note Test that the lanelet occupancy lists the lane-matched entities of a lanelet, except the
+ * excluded one, whether it is shared by the caller or built by the view.
+ */
+TEST(OtherEntityStatus, forEachOnLanelet)
+{
+  const auto hdmap_utils = makeHdMapUtilsSharedPointer();
+  auto all_status = std::make_shared<traffic_simulator::OtherEntityStatus::Map>();
+  for (const auto & [name, lanelet_id] :
+       {std::pair<std::string, lanelet::Id>{"ego", 120659}, {"npc0", 120659}, {"npc1", 34513}}) {
+    all_status->emplace(
+      name, makeCanonicalizedEntityStatus(
+              hdmap_utils, makeCanonicalizedLaneletPose(hdmap_utils, lanelet_id, 1.0),
+              makeBoundingBox(), 0.0, name));
+  }
+  const auto entity_status =
+    makeEntityStatus(nullptr, makePose(makePoint(0.0, 0.0)), makeBoundingBox(), 0.0, "npc2");
+  all_status->emplace(
+    "npc2", traffic_simulator::CanonicalizedEntityStatus(entity_status, std::nullopt));
+
+  const auto lanelet_occupancy =
+    traffic_simulator::OtherEntityStatus::makeLaneletOccupancy(*all_status);
+  for (const auto & other_status :
+       {traffic_simulator::OtherEntityStatus(all_status, "ego", lanelet_occupancy),
+        traffic_simulator::OtherEntityStatus(all_status, "ego")}) {
+    auto getNames = [&](const lanelet::Id lanelet_id) {
+      std::set<std::string> names;
+      other_status.forEachOnLanelet(
+        lanelet_id, [&](const auto & entry) { names.insert(entry.second.getName()); });
+      return names;
+    };
+    EXPECT_EQ(getNames(120659), (std::set<std::string>{"npc0"}));
+    EXPECT_EQ(getNames(34513), (std::set<std::string>{"npc1"}));
+    EXPECT_TRUE(getNames(34468).empty());
+  }
+}
@@ -0,0 +1,110 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <traffic_simulator/entity/entity_registry.hpp>
+#include <traffic_simulator/entity/misc_object_entity.hpp>
+#include <vector>
+
+#include "../helper_functions.hpp"
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+
+class EntityRegistryTest : public testing::Test
+{
+protected:
+  EntityRegistryTest() : hdmap_utils_ptr(makeHdMapUtilsSharedPointer()) {}
+
+  auto makeEntity(const std::string & name)
+    -> std::shared_ptr<traffic_simulator::entity::EntityBase>
+  {
+    return std::make_shared<traffic_simulator::entity::MiscObjectEntity>(
+      name,
+      makeCanonicalizedEntityStatus(
+        hdmap_utils_ptr, makeCanonicalizedLaneletPose(hdmap_utils_ptr, 120659), makeBoundingBox(),
+        0.0, name, traffic_simulator_msgs::msg::EntityType::MISC_OBJECT),
+      hdmap_utils_ptr, traffic_simulator_msgs::msg::MiscObjectParameters{});
+  }
+
+  std::shared_ptr<hdmap_utils::HdMapUtils> hdmap_utils_ptr;
+
+  traffic_simulator::entity::EntityRegistry registry;
+};
+
+/**
+ * @note Test lookups by name, which follow std::unordered_map.
+ */
+TEST_F(EntityRegistryTest, name)
+{
+  EXPECT_TRUE(registry.emplace("a", makeEntity("a")).second);
+  EXPECT_TRUE(registry.emplace("b", makeEntity("b")).second);
+  const auto [iter, success] = registry.emplace("a", makeEntity("a"));
+  EXPECT_FALSE(success);
+  EXPECT_EQ(iter->first, "a");
+
+  EXPECT_EQ(registry.size(), 2U);
+  EXPECT_EQ(registry.count("a"), 1U);
+  EXPECT_EQ(registry.at("b")->name, "b");
+  EXPECT_THROW(registry.at("c"), std::out_of_range);
+  EXPECT_EQ(registry.find("c"), registry.end());
+  EXPECT_EQ(registry.getNames(), (std::vector<std::string>{"a", "b"}));
+
+  EXPECT_EQ(registry.erase("a"), 1U);
+  EXPECT_EQ(registry.erase("a"), 0U);
+  EXPECT_EQ(registry.find("a"), registry.end());
+  EXPECT_EQ(registry.getNames(), (std::vector<std::string>{"b"}));
+
+  std::vector<std::string> names;
+  for (const auto & [name, entity] : registry) {
+    EXPECT_EQ(name, entity->name);
+    names.push_back(name);
+  }
+  EXPECT_EQ(names, (std::vector<std::string>{"b"}));
+}
+
+/**
+ * @note Test that handles resolve without names and do not resolve to a reused slot.
+ */
+TEST_F(EntityRegistryTest, handle)
+{
+  registry.emplace("a", makeEntity("a"));
+  registry.emplace("b", makeEntity("b"));
+  const auto handle_a = registry.getHandle("a");
+  const auto handle_b = registry.getHandle("b");
+  ASSERT_TRUE(handle_a);
+  ASSERT_TRUE(handle_b);
+  EXPECT_NE(handle_a.value(), handle_b.value());
+  EXPECT_EQ(registry.get(handle_a.value())->name, "a");
+  EXPECT_FALSE(registry.getHandle("c"));
+  EXPECT_EQ(registry.get(traffic_simulator::entity::EntityHandle{}), nullptr);
+
+  registry.erase("a");
+  EXPECT_EQ(registry.get(handle_a.value()), nullptr);
+
+  registry.emplace("c", makeEntity("c"));
+  const auto handle_c = registry.getHandle("c");
+  ASSERT_TRUE(handle_c);
+  EXPECT_EQ(handle_c->index, handle_a->index);
+  EXPECT_EQ(registry.get(handle_a.value()), nullptr);
+  EXPECT_EQ(registry.get(handle_c.value())->name, "c");
+  EXPECT_EQ(registry.get(handle_b.value())->name, "b");
+}
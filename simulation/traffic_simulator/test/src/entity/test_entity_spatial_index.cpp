@@ -0,0 +1,96 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <traffic_simulator/entity/entity_spatial_index.hpp>
+#include <vector>
+
+#include "../helper_functions.hpp"
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+
+auto makeOffLaneStatus(const std::string & name, const geometry_msgs::msg::Point & position)
+  -> traffic_simulator::CanonicalizedEntityStatus
+{
+  return traffic_simulator::CanonicalizedEntityStatus(
+    makeEntityStatus(nullptr, makePose(position), makeBoundingBox(), 0.0, name), std::nullopt);
+}
+
+/**
+ * @note Test that the grid query finds the same entities as checking every entity, in name order.
+ */
+TEST(EntitySpatialIndex, getEntitiesNear)
+{
+  traffic_simulator::OtherEntityStatus::Map all_status;
+  for (int i = 0; i < 400; ++i) {
+    const auto name = "npc" + std::to_string(i);
+    const auto position = makePoint(std::fmod(i * 37.3, 500.0), (i % 20) * 13.7 - 100.0);
+    all_status.emplace(name, makeOffLaneStatus(name, position));
+  }
+  traffic_simulator::entity::EntitySpatialIndex index;
+  index.build(all_status);
+
+  for (const auto radius : {0.0, 5.0, 30.0, 120.0, 1e4}) {
+    for (const auto & point : {makePoint(0.0, 0.0), makePoint(250.0, 20.0), makePoint(-300, 0)}) {
+      std::vector<std::string> expected;
+      for (const auto & [name, status] : all_status) {
+        const auto & position = status.getMapPose().position;
+        if (std::hypot(position.x - point.x, position.y - point.y) <= radius) {
+          expected.push_back(name);
+        }
+      }
+      std::sort(expected.begin(), expected.end());
+      EXPECT_EQ(index.getEntitiesNear(point, radius), expected);
+    }
+  }
+  EXPECT_TRUE(index.getEntitiesNear(makePoint(0.0, 0.0), -1.0).empty());
+}
+
+/**
+ * @note Test that entities are listed by the lanelet they are matched to, unmatched ones never.
+ */
+TEST(EntitySpatialIndex, getEntitiesOnLanelets)
+{
+  const auto hdmap_utils = makeHdMapUtilsSharedPointer();
+  traffic_simulator::OtherEntityStatus::Map all_status;
+  all_status.emplace(
+    "b", makeCanonicalizedEntityStatus(
+           hdmap_utils, makeCanonicalizedLaneletPose(hdmap_utils, 120659, 5.0), makeBoundingBox(),
+           0.0, "b"));
+  all_status.emplace(
+    "a", makeCanonicalizedEntityStatus(
+           hdmap_utils, makeCanonicalizedLaneletPose(hdmap_utils, 120659, 1.0), makeBoundingBox(),
+           0.0, "a"));
+  all_status.emplace(
+    "c", makeCanonicalizedEntityStatus(
+           hdmap_utils, makeCanonicalizedLaneletPose(hdmap_utils, 34513, 1.0), makeBoundingBox(),
+           0.0, "c"));
+  all_status.emplace("d", makeOffLaneStatus("d", makePoint(0.0, 0.0)));
+  traffic_simulator::entity::EntitySpatialIndex index;
+  index.build(all_status);
+
+  EXPECT_EQ(index.getEntitiesOnLanelets({120659}), (std::vector<std::string>{"a", "b"}));
+  EXPECT_EQ(
+    index.getEntitiesOnLanelets({34513, 120659, 34513}), (std::vector<std::string>{"a", "b", "c"}));
+  EXPECT_TRUE(index.getEntitiesOnLanelets({34468}).empty());
+  EXPECT_TRUE(index.getEntitiesOnLanelets({}).empty());
+}
@@ -293,6 +293,24 @@ TEST_F(MiscObjectEntityTest_FullObject, get2DPolygon)
   EXPECT_POINT_EQ(polygon.at(4), ref_poly.at(4));
 }
 
+/**
+ * @note Test functionality used by other units; test that the oriented bounding box follows the
+ * map pose of the entity.
+ */
+TEST_F(MiscObjectEntityTest_FullObject, getOrientedBoundingBox)
+{
+  const auto & box = misc_object.getOrientedBoundingBox();
+  const auto expected = math::geometry::OrientedBoundingBox(misc_object.getMapPose(), bbox);
+  EXPECT_DOUBLE_EQ(box.min_x, expected.min_x);
+  EXPECT_DOUBLE_EQ(box.max_y, expected.max_y);
+
+  auto map_pose = misc_object.getMapPose();
+  map_pose.position.x += 10.0;
+  misc_object.setMapPose(map_pose);
+  EXPECT_DOUBLE_EQ(misc_object.getOrientedBoundingBox().min_x, expected.min_x + 10.0);
+  EXPECT_DOUBLE_EQ(misc_object.getOrientedBoundingBox().max_x, expected.max_x + 10.0);
+}
+
 /**
  * @note Test basic functionality; test activating an out of range job with
  * an entity that has a positive speed and a speed range specified in the job = [0, 0]
@@ -452,6 +470,27 @@ TEST_F(MiscObjectEntityTest_FullObject, stopAtCurrentPosition)
   EXPECT_EQ(misc_object.getCurrentTwist().linear.x, 0.0);
 }
 
+/**
+ * @note Test basic functionality; test that the entity is static once updated,
+ * and not static after it is moved until it is updated again.
+ */
+TEST_F(MiscObjectEntityTest_FullObject, isStatic)
+{
+  misc_object.onUpdate(0.0, 0.1);
+  EXPECT_TRUE(misc_object.isStatic());
+
+  auto map_pose = misc_object.getMapPose();
+  map_pose.position.x += 1.0;
+  misc_object.setMapPose(map_pose);
+  EXPECT_FALSE(misc_object.isStatic());
+
+  misc_object.onUpdate(0.1, 0.1);
+  EXPECT_TRUE(misc_object.isStatic());
+
+  misc_object.setLinearVelocity(3.0);
+  EXPECT_FALSE(misc_object.isStatic());
+}
+
 /**
  * @note Test functionality used by other units; test lanelet pose obtaining
  * with a matching distance smaller than a distance from an entity to the lanelet
@@ -15,10 +15,14 @@
 #include <geometry_msgs/msg/point.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <ament_index_cpp/get_package_share_directory.hpp>
+#include <cmath>
 #include <geometry/quaternion/euler_to_quaternion.hpp>
+#include <geometry/quaternion/quaternion_to_euler.hpp>
 #include <string>
 #include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
+#include <traffic_simulator/hdmap_utils/registry.hpp>
 #include <traffic_simulator/helper/helper.hpp>
 
 #include "../expect_eq_macros.hpp"
@@ -158,12 +162,167 @@ TEST(HdMapUtils, Construct_invalid)
     std::runtime_error);
 }
 
+/**
+ * @note Test basic functionality.
+ * Test initialization correctness with a map snapshot directory - the goal is to test that
+ * the first construction writes a snapshot and the second one loads the same map from it.
+ */
+TEST(HdMapUtils, Construct_snapshot)
+{
+  const auto snapshot_directory =
+    boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+  const auto construct = [&]() {
+    return hdmap_utils::HdMapUtils(
+      ament_index_cpp::get_package_share_directory("traffic_simulator") +
+        "/map/standard_map/lanelet2_map.osm",
+      geographic_msgs::build<geographic_msgs::msg::GeoPoint>()
+        .latitude(35.61836750154)
+        .longitude(139.78066608243)
+        .altitude(0.0),
+      snapshot_directory);
+  };
+
+  const auto from_osm = construct();
+  ASSERT_FALSE(boost::filesystem::is_empty(snapshot_directory));
+  const auto from_snapshot = construct();
+
+  EXPECT_EQ(from_osm.getLaneletIds().size(), from_snapshot.getLaneletIds().size());
+  EXPECT_DOUBLE_EQ(from_osm.getLaneletLength(34600), from_snapshot.getLaneletLength(34600));
+  EXPECT_EQ(from_osm.getCenterPoints(34600).size(), from_snapshot.getCenterPoints(34600).size());
+  EXPECT_EQ(from_osm.getRoute(34579, 34630, true), from_snapshot.getRoute(34579, 34630, true));
+
+  boost::filesystem::remove_all(snapshot_directory);
+}
+
+/**
+ * @note Test basic functionality.
+ * Test that acquiring the same map twice returns the same instance
+ * and that the instance is released when no one holds it anymore.
+ */
+TEST(HdMapUtils, acquireHdMapUtils)
+{
+  const auto lanelet2_map_path = ament_index_cpp::get_package_share_directory("traffic_simulator") +
+                                 "/map/standard_map/lanelet2_map.osm";
+  const auto origin = geographic_msgs::build<geographic_msgs::msg::GeoPoint>()
+                        .latitude(35.61836750154)
+                        .longitude(139.78066608243)
+                        .altitude(0.0);
+
+  auto first = hdmap_utils::acquireHdMapUtils(lanelet2_map_path, origin);
+  const auto second = hdmap_utils::acquireHdMapUtils(lanelet2_map_path, origin);
+  EXPECT_EQ(first, second);
+
+  const std::weak_ptr<hdmap_utils::HdMapUtils> observer = first;
+  first.reset();
+  EXPECT_FALSE(observer.expired());
+  EXPECT_NE(
+    hdmap_utils::acquireHdMapUtils(
+      lanelet2_map_path, geographic_msgs::build<geographic_msgs::msg::GeoPoint>()
+                           .latitude(0.0)
+                           .longitude(0.0)
+                           .altitude(0.0)),
+    second);
+}
+
+/**
+ * @note Test basic functionality.
+ * Test that the last acquired map is reused after its last holder drops it,
+ * and released once another map is acquired.
+ */
+TEST(HdMapUtils, acquireHdMapUtils_retained)
+{
+  const auto lanelet2_map_path = ament_index_cpp::get_package_share_directory("traffic_simulator") +
+                                 "/map/standard_map/lanelet2_map.osm";
+  const auto origin = geographic_msgs::build<geographic_msgs::msg::GeoPoint>()
+                        .latitude(35.61836750154)
+                        .longitude(139.78066608243)
+                        .altitude(0.0);
+
+  const std::weak_ptr<hdmap_utils::HdMapUtils> observer =
+    hdmap_utils::acquireHdMapUtils(lanelet2_map_path, origin);
+  EXPECT_FALSE(observer.expired());
+  EXPECT_EQ(hdmap_utils::acquireHdMapUtils(lanelet2_map_path, origin), observer.lock());
+
+  hdmap_utils::acquireHdMapUtils(
+    lanelet2_map_path, geographic_msgs::build<geographic_msgs::msg::GeoPoint>()
+                         .latitude(0.0)
+                         .longitude(0.0)
+                         .altitude(0.0));
+  EXPECT_TRUE(observer.expired());
+}
+
+/**
+ * @note Test basic functionality.
+ * Test that a map loaded with a region keeps the lanelets crossing it and drops the others.
+ */
+TEST(HdMapUtils, HdMapUtils_region)
+{
+  const auto lanelet2_map_path = ament_index_cpp::get_package_share_directory("traffic_simulator") +
+                                 "/map/standard_map/lanelet2_map.osm";
+  const auto origin = geographic_msgs::build<geographic_msgs::msg::GeoPoint>()
+                        .latitude(35.61836750154)
+                        .longitude(139.78066608243)
+                        .altitude(0.0);
+
+  const auto whole_map = hdmap_utils::HdMapUtils(lanelet2_map_path, origin);
+  const auto point = whole_map.getCenterPoints(lanelet::Id(34513)).front();
+  const auto region =
+    hdmap_utils::toMapRegion({point.x - 1.0, point.y - 1.0, point.x + 1.0, point.y + 1.0});
+  ASSERT_TRUE(region);
+
+  const auto cropped_map = hdmap_utils::HdMapUtils(lanelet2_map_path, origin, {}, region);
+  const auto ids = cropped_map.getLaneletIds();
+  EXPECT_NE(std::find(ids.begin(), ids.end(), 34513), ids.end());
+  EXPECT_LT(ids.size(), whole_map.getLaneletIds().size());
+
+  EXPECT_FALSE(hdmap_utils::toMapRegion({}));
+  EXPECT_THROW(hdmap_utils::toMapRegion({0.0, 0.0, 1.0}), common::SimulationError);
+  EXPECT_THROW(hdmap_utils::toMapRegion({1.0, 0.0, 0.0, 1.0}), common::SimulationError);
+}
+
 /**
  * @note Test basic functionality.
  * Test map conversion to binary message correctness with a sample map.
  */
+/**
+ * @note Test basic functionality.
+ * Test that the elevation profile of a lanelet matches the spline of its centerline.
+ */
+TEST_F(HdMapUtilsTest_StandardMap, getElevationProfile)
+{
+  const auto spline = hdmap_utils.getCenterPointsSpline(lanelet::Id(34513));
+  const auto elevation_profile = hdmap_utils.getElevationProfile(lanelet::Id(34513));
+  EXPECT_EQ(elevation_profile, hdmap_utils.getElevationProfile(lanelet::Id(34513)));
+
+  for (double s = 0.0; s < spline->getLength(); s += 0.3) {
+    const auto pose = spline->getPose(s, true);
+    const auto rpy = math::geometry::convertQuaternionToEulerAngle(pose.orientation);
+    const auto elevation = elevation_profile->at(s);
+    EXPECT_NEAR(elevation.z, pose.position.z, 0.01);
+    EXPECT_NEAR(elevation.pitch, rpy.y, 0.01);
+    EXPECT_NEAR(std::remainder(elevation.yaw - rpy.z, 2.0 * M_PI), 0.0, 0.01);
+  }
+}
+
 TEST_F(HdMapUtilsTest_StandardMap, toMapBin) { ASSERT_NO_THROW(hdmap_utils.toMapBin()); }
 
+/**
+ * @note Test caching.
+ * Test that the binary message and the markers of the map are built once and shared.
+ */
+TEST_F(HdMapUtilsTest_StandardMap, getSharedMapBinAndMarker)
+{
+  const auto map_bin = hdmap_utils.getSharedMapBin();
+  ASSERT_TRUE(map_bin);
+  EXPECT_FALSE(map_bin->data.empty());
+  EXPECT_EQ(map_bin, hdmap_utils.getSharedMapBin());
+
+  const auto marker = hdmap_utils.getSharedMarker();
+  ASSERT_TRUE(marker);
+  EXPECT_EQ(marker->markers.size(), hdmap_utils.generateMarker().markers.size());
+  EXPECT_EQ(marker, hdmap_utils.getSharedMarker());
+}
+
 /**
  * @note Test basic functionality.
  * Test lanelet matching correctness with a small bounding box (1, 1)
@@ -653,6 +812,26 @@ TEST_F(HdMapUtilsTest_StandardMap, toLaneletPose_correct)
   EXPECT_LANELET_POSE_NEAR(lanelet_pose.value(), reference_lanelet_pose, 0.1);
 }
 
+/**
+ * @note Test basic functionality.
+ * Test conversion to lanelet pose correctness with poses taken from the centerlines
+ * of several lanelets - the goal is to test that the centerline index
+ * returns the lanelet the pose was generated from.
+ */
+TEST_F(HdMapUtilsTest_StandardMap, toLaneletPose_centerlineIndex)
+{
+  for (const auto & reference_lanelet_pose :
+       {traffic_simulator::helper::constructLaneletPose(34513, 5.0),
+        traffic_simulator::helper::constructLaneletPose(34600, 35.0),
+        traffic_simulator::helper::constructLaneletPose(120659, 1.0)}) {
+    const auto lanelet_pose =
+      hdmap_utils.toLaneletPose(hdmap_utils.toMapPose(reference_lanelet_pose).pose, false);
+
+    ASSERT_TRUE(lanelet_pose.has_value());
+    EXPECT_LANELET_POSE_NEAR(lanelet_pose.value(), reference_lanelet_pose, 0.1);
+  }
+}
+
 /**
  * @note Test basic functionality.
  * Test conversion to lanelet pose correctness with a point
@@ -787,6 +966,20 @@ TEST_F(HdMapUtilsTest_StandardMap, getSpeedLimit_empty)
   EXPECT_THROW(hdmap_utils.getSpeedLimit(lanelet::Ids{}), std::runtime_error);
 }
 
+/**
+ * @note Test function behavior when called with a lanelet id that is not in the map
+ * - the goal is to test that the dense lanelet index lookups keep throwing for unknown ids.
+ */
+TEST_F(HdMapUtilsTest_StandardMap, getLaneletData_invalidLaneletId)
+{
+  const lanelet::Id invalid_lanelet_id = 1000000;
+  EXPECT_THROW(hdmap_utils.getSpeedLimit(lanelet::Ids{invalid_lanelet_id}), std::runtime_error);
+  EXPECT_THROW(hdmap_utils.getLaneletLength(invalid_lanelet_id), std::runtime_error);
+  EXPECT_THROW(hdmap_utils.getNextLaneletIds(invalid_lanelet_id), std::runtime_error);
+  EXPECT_THROW(hdmap_utils.getPreviousLaneletIds(invalid_lanelet_id), std::runtime_error);
+  EXPECT_THROW(hdmap_utils.getFollowingLanelets(invalid_lanelet_id, 10.0), std::runtime_error);
+}
+
 /**
  * @note Test basic functionality.
  * Test obtaining closest lanelet id with a pose near
@@ -943,6 +1136,24 @@ TEST_F(HdMapUtilsTest_StandardMap, getPreviousLaneletIds_direction)
   }
 }
 
+/**
+ * @note Test basic functionality.
+ * Test adjacent lanelets id obtaining correctness
+ * with a lanelet that has a lanelet preceding it and several lanelets following it
+ * - the goal is to test that the given lanelet is excluded.
+ */
+TEST_F(HdMapUtilsTest_StandardMap, getAdjacentLaneletIds)
+{
+  auto type = traffic_simulator_msgs::msg::EntityType();
+  type.type = traffic_simulator_msgs::msg::EntityType::VEHICLE;
+  const auto result_ids = hdmap_utils.getAdjacentLaneletIds({34468}, type);
+
+  for (const lanelet::Id lanelet_id : {120660, 34438, 34465}) {
+    EXPECT_NE(std::find(result_ids.begin(), result_ids.end(), lanelet_id), result_ids.end());
+  }
+  EXPECT_EQ(std::find(result_ids.begin(), result_ids.end(), 34468), result_ids.end());
+}
+
 /**
  * @note Test basic functionality.
  * Test next lanelets id obtaining correctness
@@ -1197,6 +1408,88 @@ TEST_F(HdMapUtilsTest_StandardMap, toMapPose_sLargerThanLaneletLength)
     map_pose.pose, makePose(makePoint(3724.9, 73678.1, 2.7), makeQuaternionFromYaw(2.828)), 0.1);
 }
 
+/**
+ * @note Test basic functionality.
+ * Test batched lanelet to map pose transform correctness with lanelet poses
+ * on the same and different lanelets, including ones that need canonicalization
+ * - the goal is to test that the results match toMapPose and keep their order.
+ */
+TEST_F(HdMapUtilsTest_StandardMap, toMapPoses)
+{
+  const std::vector<traffic_simulator_msgs::msg::LaneletPose> lanelet_poses = {
+    traffic_simulator::helper::constructLaneletPose(34696, 10.0, 0.5),
+    traffic_simulator::helper::constructLaneletPose(34600, 35.0),
+    traffic_simulator::helper::constructLaneletPose(34696, -10.0),
+    traffic_simulator::helper::constructLaneletPose(34696, 10.0, 0.0, 0.0, 0.0, M_PI_4),
+    traffic_simulator::helper::constructLaneletPose(
+      34696, hdmap_utils.getLaneletLength(34696) + 10.0)};
+
+  for (const std::size_t thread_count : {1, 4}) {
+    const auto map_poses = hdmap_utils.toMapPoses(lanelet_poses, true, thread_count);
+    ASSERT_EQ(map_poses.size(), lanelet_poses.size());
+    for (std::size_t i = 0; i < lanelet_poses.size(); ++i) {
+      EXPECT_STREQ(map_poses[i].header.frame_id.c_str(), "map");
+      EXPECT_POSE_NEAR(map_poses[i].pose, hdmap_utils.toMapPose(lanelet_poses[i]).pose, 1e-6);
+    }
+  }
+}
+
+/**
+ * @note Test basic functionality.
+ * Test batched conversion to lanelet pose correctness with poses on and off the lanelets
+ * - the goal is to test that the results match toLaneletPose and keep their order.
+ */
+TEST_F(HdMapUtilsTest_StandardMap, toLaneletPoses_batch)
+{
+  const std::vector<geometry_msgs::msg::Pose> poses = {
+    makePose(makePoint(3790.0, 73757.0), makeQuaternionFromYaw(M_PI + M_PI_2 / 3.0)),
+    makePose(makePoint(3790.0, 73757.0), makeQuaternionFromYaw(M_PI_2 / 3.0)),
+    makePose(makePoint(3790.0, 73757.0, -100.0)),
+    hdmap_utils.toMapPose(traffic_simulator::helper::constructLaneletPose(34696, 10.0)).pose};
+
+  for (const std::size_t thread_count : {1, 4}) {
+    const auto lanelet_poses = hdmap_utils.toLaneletPoses(poses, false, 1.0, thread_count);
+    ASSERT_EQ(lanelet_poses.size(), poses.size());
+    for (std::size_t i = 0; i < poses.size(); ++i) {
+      const auto reference_lanelet_pose = hdmap_utils.toLaneletPose(poses[i], false);
+      ASSERT_EQ(lanelet_poses[i].has_value(), reference_lanelet_pose.has_value());
+      if (reference_lanelet_pose) {
+        EXPECT_LANELET_POSE_NEAR(lanelet_poses[i].value(), reference_lanelet_pose.value(), 1e-6);
+      }
+    }
+  }
+}
+
+/**
+ * @note Test basic functionality.
+ * Test lane change trajectory obtaining with a start pose requested repeatedly
+ * - the goal is to test that a cached goal gives the same result as the first search
+ * and that the trajectory always starts at the requested pose.
+ */
+TEST_F(HdMapUtilsTest_FourTrackHighwayMap, getLaneChangeTrajectory_cached)
+{
+  const traffic_simulator::lane_change::Parameter lane_change_parameter(
+    traffic_simulator::lane_change::AbsoluteTarget(199));
+  const auto from_pose =
+    hdmap_utils.toMapPose(traffic_simulator::helper::constructLaneletPose(200, 5.0)).pose;
+
+  const auto searched =
+    hdmap_utils.getLaneChangeTrajectory(from_pose, lane_change_parameter, 10.0, 20.0, 1.0);
+  ASSERT_TRUE(searched.has_value());
+  const auto cached =
+    hdmap_utils.getLaneChangeTrajectory(from_pose, lane_change_parameter, 10.0, 20.0, 1.0);
+  ASSERT_TRUE(cached.has_value());
+  EXPECT_DOUBLE_EQ(searched->second, cached->second);
+  EXPECT_DOUBLE_EQ(searched->first.getLength(), cached->first.getLength());
+
+  auto nearby_pose = from_pose;
+  nearby_pose.position.x += 0.01;
+  const auto nearby =
+    hdmap_utils.getLaneChangeTrajectory(nearby_pose, lane_change_parameter, 10.0, 20.0, 1.0);
+  ASSERT_TRUE(nearby.has_value());
+  EXPECT_POINT_NEAR(nearby->first.getPoint(0.0), nearby_pose.position, 1e-6);
+}
+
 /**
  * @note Test basic functionality.
  * Test changeable lanelets id obtaining with a lanelet
@@ -1435,6 +1728,21 @@ TEST_F(HdMapUtilsTest_StandardMap, getConflictingLaneIds_empty)
   EXPECT_EQ(hdmap_utils.getConflictingLaneIds({}).size(), static_cast<std::size_t>(0));
 }
 
+/**
+ * @note Test basic functionality.
+ * Test obtaining conflicting lanelets correctness with several lanelets
+ * - the goal is to test that the conflicting lanelets of each lanelet are concatenated in order.
+ */
+TEST_F(HdMapUtilsTest_StandardMap, getConflictingLaneIds_multiple)
+{
+  auto expected_ids = hdmap_utils.getConflictingLaneIds({34510});
+  const auto conflicting_ids_of_34633 = hdmap_utils.getConflictingLaneIds({34633});
+  expected_ids.insert(
+    expected_ids.end(), conflicting_ids_of_34633.begin(), conflicting_ids_of_34633.end());
+
+  EXPECT_EQ(hdmap_utils.getConflictingLaneIds({34510, 34513, 34633}), expected_ids);
+}
+
 /**
  * @note Test basic functionality.
  * Test obtaining conflicting crosswalk lanelets
@@ -1584,6 +1892,18 @@ TEST_F(HdMapUtilsTest_FourTrackHighwayMap, getFollowingLanelets_notEnoughLanelet
   EXPECT_EQ(hdmap_utils.getFollowingLanelets(id, 1.0e3, true), (lanelet::Ids{id, 203}));
 }
 
+/**
+ * @note Test basic functionality.
+ * Test previous lanelets obtaining with a lanelet
+ * that has lanelets before it longer than parameter distance
+ * - the goal is for the function to walk back through the lanelets one after another.
+ */
+TEST_F(HdMapUtilsTest_FourTrackHighwayMap, getPreviousLanelets)
+{
+  const lanelet::Id id = 203;
+  EXPECT_EQ(hdmap_utils.getPreviousLanelets(id, 100.0), (lanelet::Ids{id, 199, 3002182}));
+}
+
 /**
  * @note Test basic functionality.
  * Test following lanelets obtaining
@@ -1769,6 +2089,33 @@ TEST_F(HdMapUtilsTest_StandardMap, getRoute_circular)
     hdmap_utils.getRoute(from_and_to_id, from_and_to_id, false), lanelet::Ids{from_and_to_id});
 }
 
+/**
+ * @note Test basic functionality.
+ * Test route obtaining correctness with the precomputed route table enabled
+ * - the goal is to test that the table gives the same routes as the routing graph search.
+ */
+TEST_F(HdMapUtilsTest_StandardMap, getRoute_routeTable)
+{
+  hdmap_utils.enableRouteTable();
+
+  EXPECT_EQ(
+    hdmap_utils.getRoute(34579, 34630, true),
+    (lanelet::Ids{34579, 34774, 120659, 120660, 34468, 34438, 34408, 34624, 34630}));
+  EXPECT_EQ(hdmap_utils.getRoute(120659, 120659, false), lanelet::Ids{120659});
+}
+
+/**
+ * @note Test basic functionality.
+ * Test route obtaining correctness with the precomputed route table enabled
+ * and the beginning and ending that are impossible to route between.
+ */
+TEST_F(HdMapUtilsTest_FourTrackHighwayMap, getRoute_routeTableImpossibleRouting)
+{
+  hdmap_utils.enableRouteTable();
+
+  EXPECT_EQ(hdmap_utils.getRoute(199, 196, true).size(), static_cast<std::size_t>(0));
+}
+
 /**
  * @note Test basic functionality with a lanelet that has a centerline with 3 or more points.
  */
@@ -1853,6 +2200,24 @@ TEST_F(HdMapUtilsTest_StandardMap, getCenterPoints_empty)
   EXPECT_EQ(hdmap_utils.getCenterPoints(lanelet::Ids{}).size(), static_cast<std::size_t>(0));
 }
 
+/**
+ * @note Test basic functionality with a vector containing valid lanelets
+ * - the goal is to test whether the spline is shared while it is in use and released afterwards.
+ */
+TEST_F(HdMapUtilsTest_StandardMap, getCenterPointsSpline_sharedVector)
+{
+  const lanelet::Ids ids{34594, 34621};
+
+  auto spline = hdmap_utils.getCenterPointsSpline(ids);
+  ASSERT_NE(spline, nullptr);
+  EXPECT_EQ(hdmap_utils.getCenterPointsSpline(ids), spline);
+  EXPECT_NE(hdmap_utils.getCenterPointsSpline(lanelet::Ids{34594}), spline);
+
+  const std::weak_ptr<math::geometry::CatmullRomSpline> released = spline;
+  spline.reset();
+  EXPECT_TRUE(released.expired());
+}
+
 /**
  * @note Test basic functionality.
  * Test traffic light checking correctness with an id of a traffic light.
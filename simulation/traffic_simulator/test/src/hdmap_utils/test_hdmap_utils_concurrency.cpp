@@ -0,0 +1,136 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <ament_index_cpp/get_package_share_directory.hpp>
+#include <atomic>
+#include <optional>
+#include <string>
+#include <thread>
+#include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
+#include <vector>
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+
+auto makeHdMapUtils() -> hdmap_utils::HdMapUtils
+{
+  return hdmap_utils::HdMapUtils(
+    ament_index_cpp::get_package_share_directory("traffic_simulator") +
+      "/map/standard_map/lanelet2_map.osm",
+    geographic_msgs::build<geographic_msgs::msg::GeoPoint>()
+      .latitude(35.61836750154)
+      .longitude(139.78066608243)
+      .altitude(0.0));
+}
+
+/// @note Results of queries going through the caches and the lanelet2 map and routing graph.
+struct QueryResult
+{
+  lanelet::Ids following_lanelets;
+
+  std::vector<geometry_msgs::msg::Point> center_points;
+
+  double left_bound_length;
+
+  lanelet::Ids route;
+
+  std::optional<double> longitudinal_distance;
+
+  std::optional<traffic_simulator_msgs::msg::LaneletPose> lanelet_pose;
+
+  auto operator==(const QueryResult & other) const -> bool
+  {
+    return following_lanelets == other.following_lanelets and
+           center_points == other.center_points and
+           left_bound_length == other.left_bound_length and route == other.route and
+           longitudinal_distance == other.longitudinal_distance and
+           lanelet_pose == other.lanelet_pose;
+  }
+};
+
+auto query(
+  const hdmap_utils::HdMapUtils & hdmap_utils, const lanelet::Id from, const lanelet::Id to)
+  -> QueryResult
+{
+  QueryResult result;
+  result.following_lanelets = hdmap_utils.getFollowingLanelets(from, 100.0, true);
+  result.center_points = hdmap_utils.getCenterPoints(from);
+  result.left_bound_length = hdmap_utils.getLeftLaneBound(from)->getLength();
+  result.route = hdmap_utils.getRoute(from, to);
+  result.longitudinal_distance = hdmap_utils.getLongitudinalDistance(
+    traffic_simulator_msgs::build<traffic_simulator_msgs::msg::LaneletPose>()
+      .lanelet_id(from)
+      .s(0.0)
+      .offset(0.0)
+      .rpy(geometry_msgs::msg::Vector3()),
+    traffic_simulator_msgs::build<traffic_simulator_msgs::msg::LaneletPose>()
+      .lanelet_id(to)
+      .s(0.0)
+      .offset(0.0)
+      .rpy(geometry_msgs::msg::Vector3()));
+  if (not result.center_points.empty()) {
+    auto pose = geometry_msgs::msg::Pose();
+    pose.position = result.center_points[result.center_points.size() / 2];
+    result.lanelet_pose = hdmap_utils.toLaneletPose(pose, false);
+  }
+  return result;
+}
+
+/**
+ * @note Test the thread safety of the const member functions. Every thread queries every lanelet
+ * of a map whose caches are empty, each from a different lanelet, so the threads fill the caches
+ * concurrently. The results must be the ones of a map queried by a single thread.
+ */
+TEST(HdMapUtilsConcurrency, constQueries)
+{
+  const auto expected_hdmap_utils = makeHdMapUtils();
+  const auto lanelet_ids = expected_hdmap_utils.getLaneletIds();
+  ASSERT_FALSE(lanelet_ids.empty());
+
+  /// @note Hard coded parameter, the route of each lanelet goes to the lanelet this far in the ids.
+  constexpr std::size_t route_stride = 7;
+  std::vector<QueryResult> expected;
+  for (std::size_t i = 0; i < lanelet_ids.size(); ++i) {
+    expected.push_back(query(
+      expected_hdmap_utils, lanelet_ids[i], lanelet_ids[(i + route_stride) % lanelet_ids.size()]));
+  }
+
+  const auto hdmap_utils = makeHdMapUtils();
+  std::atomic<std::size_t> mismatch_count = 0;
+  std::vector<std::thread> threads;
+  /// @note Hard coded parameter, enough threads to contend for the shards of the caches.
+  constexpr std::size_t thread_count = 8;
+  for (std::size_t thread_index = 0; thread_index < thread_count; ++thread_index) {
+    threads.emplace_back([&, thread_index]() {
+      for (std::size_t n = 0; n < lanelet_ids.size(); ++n) {
+        const auto i = (n + thread_index * lanelet_ids.size() / thread_count) % lanelet_ids.size();
+        if (not(
+              query(
+                hdmap_utils, lanelet_ids[i],
+                lanelet_ids[(i + route_stride) % lanelet_ids.size()]) == expected[i])) {
+          ++mismatch_count;
+        }
+      }
+    });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(mismatch_count, 0u);
+}
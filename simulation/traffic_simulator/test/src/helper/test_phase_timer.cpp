@@ -0,0 +1,73 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <traffic_simulator/helper/phase_timer.hpp>
+
+/**
+ * @note Test basic functionality. Test collecting the timings measured on several threads,
+ * accumulated by phase, and that the timings are popped.
+ */
+TEST(PhaseTimer, collectPhaseTimings)
+{
+  traffic_simulator::helper::collectPhaseTimings();
+  {
+    traffic_simulator::helper::ScopedPhaseTimer timer("main");
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  std::thread([]() {
+    for (int i = 0; i < 3; ++i) {
+      traffic_simulator::helper::ScopedPhaseTimer timer("worker");
+    }
+  }).join();
+
+  auto statistics = traffic_simulator::helper::collectPhaseTimings();
+  ASSERT_EQ(statistics.size(), 2u);
+  EXPECT_EQ(statistics["main"].count, 1u);
+  EXPECT_GE(statistics["main"].maximum_milliseconds, 5.0);
+  EXPECT_EQ(statistics["worker"].count, 3u);
+
+  EXPECT_TRUE(traffic_simulator::helper::collectPhaseTimings().empty());
+}
+
+/**
+ * @note Test function behavior when the buffer is full. Test that the timings pushed over the
+ * capacity are dropped instead of overwriting the ones not popped.
+ */
+TEST(PhaseTimer, PhaseTimingBufferFull)
+{
+  traffic_simulator::helper::PhaseTimingBuffer buffer;
+  std::size_t pushed = 0;
+  for (std::size_t i = 0; i < traffic_simulator::helper::PhaseTimingBuffer::capacity; ++i) {
+    pushed += buffer.push({"phase", static_cast<double>(i)});
+  }
+  EXPECT_EQ(pushed, traffic_simulator::helper::PhaseTimingBuffer::capacity - 1);
+
+  double first = -1.0;
+  std::size_t popped = 0;
+  buffer.pop([&](const auto & timing) {
+    first = popped++ == 0 ? timing.milliseconds : first;
+  });
+  EXPECT_EQ(popped, pushed);
+  EXPECT_DOUBLE_EQ(first, 0.0);
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -115,3 +115,64 @@ TEST(JobList, update)
   EXPECT_EQ(2, update_count);
   EXPECT_EQ(1, cleanup_count);
 }
+
+/**
+ * @note Test basic functionality. Test removing jobs that have finished or have been replaced
+ * by an identical job - the goal is to test that they are not kept in the list.
+ */
+TEST(JobList, update_remove)
+{
+  const auto event = traffic_simulator::job::Event::POST_UPDATE;
+  auto job_list = traffic_simulator::job::JobList();
+
+  job_list.append(
+    [](const double) { return true; }, []() {}, traffic_simulator::job::Type::LINEAR_VELOCITY,
+    true, event);
+  job_list.append(
+    [](const double) { return false; }, []() {}, traffic_simulator::job::Type::UNKOWN, true,
+    event);
+  job_list.append(
+    [](const double) { return false; }, []() {}, traffic_simulator::job::Type::UNKOWN, true,
+    traffic_simulator::job::Event::PRE_UPDATE);
+
+  EXPECT_EQ(job_list.size(), static_cast<std::size_t>(3));
+
+  job_list.update(0.0, event);
+
+  EXPECT_EQ(job_list.size(), static_cast<std::size_t>(1));
+
+  job_list.update(0.0, traffic_simulator::job::Event::PRE_UPDATE);
+
+  EXPECT_EQ(job_list.size(), static_cast<std::size_t>(1));
+}
+
+/**
+ * @note Test basic functionality. Test appending a job from a job being updated
+ * - the goal is to test that the appended job is updated from the next update.
+ */
+TEST(JobList, update_appendWhileUpdating)
+{
+  int appended_update_count = 0;
+
+  const auto event = traffic_simulator::job::Event::POST_UPDATE;
+  auto job_list = traffic_simulator::job::JobList();
+
+  job_list.append(
+    [&](const double) {
+      job_list.append(
+        [&appended_update_count](const double) { return ++appended_update_count, true; }, []() {},
+        traffic_simulator::job::Type::LINEAR_ACCELERATION, true, event);
+      return true;
+    },
+    []() {}, traffic_simulator::job::Type::LINEAR_VELOCITY, true, event);
+
+  job_list.update(0.0, event);
+
+  EXPECT_EQ(appended_update_count, 0);
+  EXPECT_EQ(job_list.size(), static_cast<std::size_t>(1));
+
+  job_list.update(0.0, event);
+
+  EXPECT_EQ(appended_update_count, 1);
+  EXPECT_EQ(job_list.size(), static_cast<std::size_t>(0));
+}
@@ -14,8 +14,10 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
 #include <scenario_simulator_exception/exception.hpp>
 #include <traffic_simulator/simulation_clock/simulation_clock.hpp>
+#include <thread>
 
 /**
  * @note Test basic functionality used in API.
@@ -104,3 +106,29 @@ TEST(SimulationClock, Update)
     EXPECT_NEAR(actual_simulation_time, expected_simulation_time, 1e-6);
   }
 }
+
+/**
+ * @note Test the real time factor governor. Frames slower than the period of the frame rate should
+ * scale the step time up to the maximum step scale, and not at all with the governor disabled.
+ */
+TEST(SimulationClock, RealtimeFactorGovernor)
+{
+  const double frame_rate = 100.0;
+
+  auto governed_clock = traffic_simulator::SimulationClock(true, 1.0, frame_rate);
+  governed_clock.maximum_step_scale = 3.0;
+  auto ungoverned_clock = traffic_simulator::SimulationClock(true, 1.0, frame_rate);
+
+  const double nominal_step_time = ungoverned_clock.getStepTime();
+
+  for (int i = 0; i < 10; ++i) {
+    governed_clock.update();
+    ungoverned_clock.update();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  }
+
+  EXPECT_GT(governed_clock.getStepTime(), 1.5 * nominal_step_time);
+  EXPECT_LE(governed_clock.getStepTime(), 3.0 * nominal_step_time);
+  EXPECT_DOUBLE_EQ(ungoverned_clock.getStepTime(), nominal_step_time);
+  EXPECT_LT(ungoverned_clock.getAchievedRealtimeFactor(), 1.0);
+}
@@ -0,0 +1,76 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <traffic_simulator/traffic_lights/configurable_rate_updater.hpp>
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+
+/**
+ * @note Test the publications at 10 Hz with the default frame rate of 30 Hz, they are on every
+ * third frame starting from the first one.
+ */
+TEST(ConfigurableRateUpdater, update)
+{
+  std::size_t count = 0;
+  auto updater = traffic_simulator::ConfigurableRateUpdater(10.0, [&]() { ++count; });
+  for (std::size_t frame = 0; frame < 30; ++frame) {
+    const auto count_before_update = count;
+    updater.update(frame / 30.0);
+    EXPECT_EQ(count - count_before_update, frame % 3 == 0 ? 1 : 0);
+  }
+  EXPECT_EQ(count, std::size_t(10));
+}
+
+/**
+ * @note Test that a rate higher than the frame rate publishes once per frame, and a rate of zero
+ * does not publish.
+ */
+TEST(ConfigurableRateUpdater, update_rateLimits)
+{
+  std::size_t count = 0;
+  auto updater = traffic_simulator::ConfigurableRateUpdater(100.0, [&]() { ++count; });
+  for (std::size_t frame = 0; frame < 30; ++frame) {
+    updater.update(frame / 30.0);
+  }
+  EXPECT_EQ(count, std::size_t(30));
+
+  updater.resetUpdateRate(0.0);
+  EXPECT_DOUBLE_EQ(updater.getUpdateRate(), 0.0);
+  for (std::size_t frame = 30; frame < 60; ++frame) {
+    updater.update(frame / 30.0);
+  }
+  EXPECT_EQ(count, std::size_t(30));
+}
+
+/**
+ * @note Test that the schedule restarts from the current frame instead of catching up when the
+ * frames are far apart.
+ */
+TEST(ConfigurableRateUpdater, update_skippedFrames)
+{
+  std::size_t count = 0;
+  auto updater = traffic_simulator::ConfigurableRateUpdater(10.0, [&]() { ++count; });
+  updater.update(0.0);
+  updater.update(1.0);
+  updater.update(1.05);
+  EXPECT_EQ(count, std::size_t(2));
+  updater.update(1.1);
+  EXPECT_EQ(count, std::size_t(3));
+}
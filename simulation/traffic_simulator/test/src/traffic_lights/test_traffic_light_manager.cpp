@@ -97,3 +97,33 @@ TEST_F(TrafficLightManagerTest, getTrafficLights_setArrow)
     EXPECT_TRUE(manager.getTrafficLight(id).contains(Color::green, Status::solid_on, Shape::up));
   }
 }
+
+/**
+ * @note Test that the version and the cached request only change if any traffic light changes.
+ */
+TEST_F(TrafficLightManagerTest, getVersion)
+{
+  using Color = traffic_simulator::TrafficLight::Color;
+  const auto initial_version = manager.getVersion();
+  EXPECT_EQ(manager.generateUpdateTrafficLightsRequest().states_size(), 0);
+
+  manager.getTrafficLight(34836).emplace(Color::green);
+  const auto version = manager.getVersion();
+  EXPECT_NE(version, initial_version);
+  EXPECT_EQ(manager.getVersion(), version);
+  EXPECT_TRUE(manager.hasAnyLightChanged());
+  EXPECT_FALSE(manager.hasAnyLightChanged());
+  ASSERT_EQ(manager.generateUpdateTrafficLightsRequest().states_size(), 1);
+  EXPECT_EQ(manager.generateUpdateTrafficLightsRequest().states(0).traffic_light_status_size(), 1);
+
+  manager.getTrafficLight(34836).clear();
+  manager.getTrafficLight(34836).emplace(Color::green);
+  EXPECT_EQ(manager.getVersion(), version);
+
+  manager.getTrafficLight(34836).confidence = 0.5;
+  EXPECT_NE(manager.getVersion(), version);
+  EXPECT_TRUE(manager.hasAnyLightChanged());
+  EXPECT_DOUBLE_EQ(
+    manager.generateUpdateTrafficLightsRequest().states(0).traffic_light_status(0).confidence(),
+    0.5);
+}
@@ -706,3 +706,26 @@ TEST_F(distanceTest_Intersection, distanceToRightLaneBound_emptyVector)
       pose, bounding_box, lanelet::Ids{}, hdmap_utils_ptr),
     common::SemanticError);
 }
+
+/**
+ * @note Test equality with the distanceToLaneBound results of each entity.
+ */
+TEST_F(distanceTest_Intersection, distancesToLaneBound)
+{
+  const auto bounding_box = makeCustom2DBoundingBox(0.1, 0.1, 0.0, 0.0);
+  const auto entities = std::vector<std::tuple<
+    geometry_msgs::msg::Pose, traffic_simulator_msgs::msg::BoundingBox, lanelet::Ids>>{
+    {makePose(86651.84, 44941.47, 135.0), bounding_box, {660L}},
+    {makePose(86642.05, 44902.61, 60.0), bounding_box, {660L, 663L, 684L}},
+    {makePose(86702.79, 44929.05, 150.0), makeCustom2DBoundingBox(3.0, 1.0, 0.0, 0.0),
+     {654L, 686L}}};
+  const auto distances =
+    traffic_simulator::distance::distancesToLaneBound(entities, hdmap_utils_ptr);
+  ASSERT_EQ(distances.size(), entities.size());
+  for (std::size_t i = 0; i < entities.size(); ++i) {
+    const auto & [map_pose, entity_bounding_box, lanelet_ids] = entities[i];
+    EXPECT_DOUBLE_EQ(
+      distances[i], traffic_simulator::distance::distanceToLaneBound(
+                      map_pose, entity_bounding_box, lanelet_ids, hdmap_utils_ptr));
+  }
+}
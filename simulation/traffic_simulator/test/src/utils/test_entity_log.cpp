@@ -0,0 +1,90 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <gtest/gtest.h>
+
+#include <boost/filesystem.hpp>
+#include <string>
+#include <traffic_simulator/utils/entity_log.hpp>
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+
+namespace
+{
+auto makeStatus(const std::string & name, const double x, const double speed)
+  -> traffic_simulator::CanonicalizedEntityStatus
+{
+  traffic_simulator::EntityStatus status;
+  status.name = name;
+  status.pose.position.x = x;
+  status.pose.orientation.z = 0.6;
+  status.pose.orientation.w = 0.8;
+  status.action_status.twist.linear.x = speed;
+  status.lanelet_pose_valid = false;
+  return traffic_simulator::CanonicalizedEntityStatus(status, std::nullopt);
+}
+}  // namespace
+
+/**
+ * @note Test that the frames written are read back, each frame on its own.
+ */
+TEST(EntityLog, writeAndRead)
+{
+  const auto path = boost::filesystem::temp_directory_path() /
+                    boost::filesystem::unique_path("entity_log_%%%%%%.bin");
+  {
+    traffic_simulator::EntityLog::Writer writer(path);
+    for (int frame = 0; frame < 10; ++frame) {
+      traffic_simulator::OtherEntityStatus::Map all_status;
+      all_status.emplace("ego", makeStatus("ego", frame, 1.0));
+      if (frame >= 5) {
+        all_status.emplace("npc", makeStatus("npc", -frame, 2.0));
+      }
+      writer.write(frame * 0.5, all_status);
+    }
+  }
+
+  const auto log = traffic_simulator::EntityLog::open(path);
+  ASSERT_TRUE(log);
+  EXPECT_EQ(log->getFrameCount(), 10U);
+  EXPECT_DOUBLE_EQ(log->getTime(3), 1.5);
+  EXPECT_EQ(log->findFrame(2.2), 4U);
+  EXPECT_EQ(log->findFrame(-1.0), 0U);
+  EXPECT_EQ(log->findFrame(100.0), 9U);
+
+  EXPECT_EQ(log->getFrame(0).size(), 1U);
+  const auto statuses = log->getFrame(7);
+  ASSERT_EQ(statuses.size(), 2U);
+  for (const auto & status : statuses) {
+    EXPECT_DOUBLE_EQ(status.time, 3.5);
+    EXPECT_DOUBLE_EQ(status.pose.position.x, status.name == "ego" ? 7.0 : -7.0);
+    EXPECT_NEAR(status.pose.orientation.z, 0.6, 1e-4);
+    EXPECT_NEAR(status.pose.orientation.w, 0.8, 1e-4);
+    EXPECT_FLOAT_EQ(status.action_status.twist.linear.x, status.name == "ego" ? 1.0 : 2.0);
+    EXPECT_FALSE(status.lanelet_pose_valid);
+  }
+
+  boost::filesystem::remove(path);
+}
+
+/**
+ * @note Test that a missing file is not opened.
+ */
+TEST(EntityLog, openMissingFile)
+{
+  EXPECT_FALSE(traffic_simulator::EntityLog::open("/nonexistent/entity_log.bin"));
+}
@@ -0,0 +1,81 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <traffic_simulator/utils/thread_pool.hpp>
+#include <vector>
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+
+/**
+ * @note Test that every index is run exactly once, on every call of a reused pool.
+ */
+TEST(ThreadPool, parallelFor)
+{
+  traffic_simulator::ThreadPool thread_pool(4);
+  EXPECT_EQ(thread_pool.size(), 4U);
+  for (const std::size_t count : {0, 1, 3, 4, 1000}) {
+    std::vector<std::atomic<int>> counters(count);
+    thread_pool.parallelFor(count, [&](const std::size_t index) { ++counters[index]; });
+    for (const auto & counter : counters) {
+      EXPECT_EQ(counter.load(), 1);
+    }
+  }
+}
+
+/**
+ * @note Test that a pool of a single thread runs the tasks on the calling thread in index order.
+ */
+TEST(ThreadPool, parallelForSingleThread)
+{
+  traffic_simulator::ThreadPool thread_pool(1);
+  std::vector<std::size_t> indices;
+  thread_pool.parallelFor(10, [&](const std::size_t index) { indices.push_back(index); });
+  ASSERT_EQ(indices.size(), 10U);
+  for (std::size_t i = 0; i < indices.size(); ++i) {
+    EXPECT_EQ(indices[i], i);
+  }
+}
+
+/**
+ * @note Test that the exception of the lowest index is rethrown after all tasks are done.
+ */
+TEST(ThreadPool, parallelForException)
+{
+  traffic_simulator::ThreadPool thread_pool(4);
+  std::atomic<std::size_t> done = 0;
+  try {
+    thread_pool.parallelFor(100, [&](const std::size_t index) {
+      ++done;
+      if (index % 10 == 7) {
+        throw std::runtime_error(std::to_string(index));
+      }
+    });
+    ADD_FAILURE() << "No exception was thrown.";
+  } catch (const std::runtime_error & error) {
+    EXPECT_STREQ(error.what(), "7");
+  }
+  EXPECT_EQ(done.load(), 100U);
+  std::atomic<std::size_t> count = 0;
+  thread_pool.parallelFor(100, [&](const std::size_t) { ++count; });
+  EXPECT_EQ(count.load(), 100U);
+}
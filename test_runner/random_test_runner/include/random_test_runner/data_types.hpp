@@ -61,6 +61,9 @@ struct TestControlParameters
   ArchitectureType architecture_type = ArchitectureType::AWF_UNIVERSE;
   std::string simulator_host = "localhost";
   double test_timeout = 60.0;
+  // Test cases of the suite run by this instance, when a sweep is split across instances
+  int64_t shard_index = 0;
+  int64_t shard_count = 1;
 };
 
 struct TestSuiteParameters
@@ -131,8 +134,9 @@ DEFINE_FMT_FORMATTER(
 
 DEFINE_FMT_FORMATTER(
   TestControlParameters,
-  "input dir: {} output dir: {} random test type: {} test count {} test_timeout {}", v.input_dir,
-  v.output_dir, v.random_test_type, v.test_count, v.test_timeout)
+  "input dir: {} output dir: {} random test type: {} test count {} test_timeout {} shard {}/{}",
+  v.input_dir, v.output_dir, v.random_test_type, v.test_count, v.test_timeout, v.shard_index,
+  v.shard_count)
 
 DEFINE_FMT_FORMATTER(
   TestSuiteParameters,
@@ -19,9 +19,14 @@
 
 #include <spdlog/fmt/fmt.h>
 
+#include <algorithm>
 #include <boost/filesystem.hpp>
+#include <list>
+#include <optional>
 #include <rclcpp/logger.hpp>
 #include <rclcpp/rclcpp.hpp>
+#include <string>
+#include <utility>
 
 #include "random_test_runner/data_types.hpp"
 #include "simple_junit/junit5.hpp"
@@ -45,6 +50,8 @@ public:
     reportError(type, error_msg);
   }
 
+  const common::SimpleTestCase & getTestCase() const { return testcase_; }
+
 private:
   void reportError(const std::string & error_type, const std::string & message)
   {
@@ -55,29 +62,51 @@ private:
   common::SimpleTestCase & testcase_;
 };
 
+// Completed test cases are streamed to the result file and released, so that the memory of the
+// reporter does not grow with the count of test cases of a sweep
 class JunitXmlReporter
 {
 public:
   explicit JunitXmlReporter(rclcpp::Logger logger) : logger_(logger) {}
 
-  void init(const std::string & output_directory) { output_directory_ = output_directory; }
+  void init(const std::string & output_directory)
+  {
+    output_directory_ = output_directory;
+    results_.emplace((boost::filesystem::path(output_directory_) / "result.junit.xml").string());
+  }
 
   JunitXmlReporterTestCase spawnTestCase(
     const std::string & testsuite_name, const std::string & testcase_name)
   {
-    return JunitXmlReporterTestCase(results_.testsuite(testsuite_name).testcase(testcase_name));
+    testcases_.emplace_back(testsuite_name, common::SimpleTestCase(testcase_name));
+    return JunitXmlReporterTestCase(testcases_.back().second);
+  }
+
+  void writeTestCase(const JunitXmlReporterTestCase & testcase)
+  {
+    auto it = std::find_if(testcases_.begin(), testcases_.end(), [&](const auto & spawned) {
+      return &spawned.second == &testcase.getTestCase();
+    });
+    if (it != testcases_.end()) {
+      results_->write(it->first, it->second);
+      testcases_.erase(it);
+    }
   }
 
   void write()
   {
     std::string message = fmt::format("Saving results to {}", output_directory_);
     RCLCPP_INFO_STREAM(logger_, message);
-    results_.write_to(
-      (boost::filesystem::path(output_directory_) / "result.junit.xml").c_str(), "  ");
+    for (const auto & [testsuite_name, testcase] : testcases_) {
+      results_->write(testsuite_name, testcase);
+    }
+    testcases_.clear();
+    results_->finalize();
   }
 
 private:
-  common::JUnit5 results_;
+  std::optional<common::junit::StreamingTestSuites> results_;
+  std::list<std::pair<std::string, common::SimpleTestCase>> testcases_;
   std::string output_directory_;
   rclcpp::Logger logger_;
 };
@@ -20,8 +20,10 @@
 #include <lanelet2_core/LaneletMap.h>
 #include <lanelet2_routing/RoutingGraph.h>
 
+#include <boost/dynamic_bitset.hpp>
 #include <boost/filesystem.hpp>
 #include <optional>
+#include <unordered_map>
 
 #include "geometry_msgs/msg/pose_stamped.hpp"
 #include "random_test_runner/data_types.hpp"
@@ -52,6 +54,9 @@ public:
   double computeDistance(
     const traffic_simulator_msgs::msg::LaneletPose & p1,
     const traffic_simulator_msgs::msg::LaneletPose & p2);
+  // Distance between map positions, for poses already converted once by toMapPosition
+  static double computeDistance(
+    const geometry_msgs::msg::Point & p1, const geometry_msgs::msg::Point & p2);
   std::optional<traffic_simulator_msgs::msg::LaneletPose> getOppositeLaneLet(
     const traffic_simulator_msgs::msg::LaneletPose & pose);
   std::vector<LaneletPart> getLanesWithinDistance(
@@ -61,14 +66,30 @@ public:
   std::vector<int64_t> getLaneletIds();
   geometry_msgs::msg::PoseStamped toMapPose(
     const traffic_simulator_msgs::msg::LaneletPose & lanelet_pose, const bool fill_pitch);
+  geometry_msgs::msg::Point toMapPosition(
+    const traffic_simulator_msgs::msg::LaneletPose & lanelet_pose);
   std::vector<int64_t> getRoute(int64_t from_lanelet_id, int64_t to_lanelet_id);
+  // Sorted ids of the lanelets from which the vehicle routing graph reaches the given lanelet
+  std::vector<int64_t> getLaneletIdsReaching(int64_t to_lanelet_id);
   double getLaneletLength(int64_t lanelet_id);
   bool isInLanelet(int64_t lanelet_id, double s);
 
 private:
+  void computeReachability();
+  void computeOppositeLaneWidths();
+
   lanelet::LaneletMapPtr lanelet_map_ptr_;
   lanelet::routing::RoutingGraphConstPtr vehicle_routing_graph_ptr_;
   std::shared_ptr<hdmap_utils::HdMapUtils> hdmap_utils_ptr_;
+
+  // Strongly connected components of the vehicle routing graph (lane changes included), and for
+  // each of them the components it reaches, itself only if it holds a cycle
+  std::unordered_map<int64_t, std::size_t> component_of_lanelet_;
+  std::vector<std::vector<int64_t>> component_lanelet_ids_;
+  std::vector<boost::dynamic_bitset<>> reachable_components_;
+
+  // Width at the start of each right most lanelet, the only ones getOppositeLaneLet supports
+  std::unordered_map<int64_t, double> opposite_lane_widths_;
 };
 
 #endif  // RANDOM_TEST_RUNNER__LANELET_UTILS_HPP
@@ -22,29 +22,14 @@ class EgoCollisionMetric
 public:
   bool isThereEgosCollisionWith(const std::string & npc_name, double current_time)
   {
-    timeoutCollisions(current_time);
-
-    auto npc_insertion_data = npc_last_collision_type_map_.emplace(npc_name, current_time);
-    if (npc_insertion_data.second) {
-      return true;
-    }
-    npc_last_collision_type_map_[npc_name] = current_time;
-    return false;
+    // Only the entry of the colliding npc is timed out, instead of scanning all of them per frame
+    auto [it, inserted] = npc_last_collision_type_map_.emplace(npc_name, current_time);
+    const bool new_collision = inserted || current_time - it->second > collision_timeout_;
+    it->second = current_time;
+    return new_collision;
   }
 
 private:
-  void timeoutCollisions(double current_time)
-  {
-    for (auto it = npc_last_collision_type_map_.begin();
-         it != npc_last_collision_type_map_.end();) {
-      if (current_time - it->second > collision_timeout_) {
-        npc_last_collision_type_map_.erase(it++);
-      } else {
-        it++;
-      }
-    }
-  }
-
   std::unordered_map<std::string, double> npc_last_collision_type_map_;
   const double collision_timeout_ = 0.5;
 };
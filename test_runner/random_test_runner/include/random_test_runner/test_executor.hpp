@@ -19,6 +19,8 @@
 
 #include <memory>
 #include <rclcpp/logger.hpp>
+#include <string>
+#include <unordered_map>
 
 #include "random_test_runner/data_types.hpp"
 #include "random_test_runner/file_interactions/junit_xml_reporter.hpp"
@@ -69,6 +71,9 @@ public:
     architecture_type_(architecture_type),
     logger_(logger)
   {
+    for (size_t i = 0; i < test_description_.npcs_descriptions.size(); i++) {
+      npc_indices_.emplace(test_description_.npcs_descriptions[i].name, i);
+    }
   }
 
   void initialize()
@@ -170,14 +175,19 @@ public:
 
       auto current_time = api_->getCurrentTime();
 
+      const auto ego_status = api_->getEntityStatus(ego_name_);
+      const bool goal_reached = goal_reached_metric_.isGoalReached(ego_status);
+
+      // The verdict of a test case is final once the goal is reached, a collision occurs or the
+      // ego stands still, so the case ends on that frame instead of running until the timeout
       if (!std::isnan(current_time)) {
-        if (goal_reached_metric_.isGoalReached(api_->getEntityStatus(ego_name_))) {
+        if (goal_reached) {
           scenario_completed_ = true;
         }
 
         bool timeout_reached = current_time >= test_timeout_;
         if (timeout_reached) {
-          if (!goal_reached_metric_.isGoalReached(api_->getEntityStatus(ego_name_))) {
+          if (!goal_reached) {
             RCLCPP_INFO(logger_, "Timeout reached");
             error_reporter_.reportTimeout();
           }
@@ -186,20 +196,25 @@ public:
         }
       }
 
-      for (const auto & npc : test_description_.npcs_descriptions) {
-        if (api_->entityExists(npc.name) && api_->checkCollision(ego_name_, npc.name)) {
-          if (ego_collision_metric_.isThereEgosCollisionWith(npc.name, current_time)) {
-            std::string message =
-              fmt::format("New collision occurred between ego and {}", npc.name);
-            RCLCPP_INFO_STREAM(logger_, message);
-            error_reporter_.reportCollision(npc, current_time);
-          }
+      for (const auto & name : api_->getEntityNamesCollidingWith(ego_name_)) {
+        if (const auto npc_index = npc_indices_.find(name);
+            npc_index != npc_indices_.end() &&
+            ego_collision_metric_.isThereEgosCollisionWith(name, current_time)) {
+          std::string message = fmt::format("New collision occurred between ego and {}", name);
+          RCLCPP_INFO_STREAM(logger_, message);
+          error_reporter_.reportCollision(
+            test_description_.npcs_descriptions[npc_index->second], current_time);
+          scenario_completed_ = true;
         }
       }
 
-      if (almost_standstill_metric_.isAlmostStandingStill(api_->getEntityStatus(ego_name_))) {
+      if (scenario_completed_) {
+        return;
+      }
+
+      if (almost_standstill_metric_.isAlmostStandingStill(ego_status)) {
         RCLCPP_INFO(logger_, "Standstill duration exceeded");
-        if (goal_reached_metric_.isGoalReached(api_->getEntityStatus(ego_name_))) {
+        if (goal_reached) {
           RCLCPP_INFO(logger_, "Goal reached, standstill expected");
         } else {
           error_reporter_.reportStandStill();
@@ -227,6 +242,8 @@ public:
 
   bool scenarioCompleted() { return scenario_completed_; }
 
+  const JunitXmlReporterTestCase & getTestCaseReporter() const { return error_reporter_; }
+
 private:
   void executeWithErrorHandling(std::function<void()> && func)
   {
@@ -255,6 +272,7 @@ private:
 
   std::shared_ptr<traffic_simulator_api_type> api_;
   TestDescription test_description_;
+  std::unordered_map<std::string, size_t> npc_indices_;
   const std::string ego_name_ = "ego";
 
   AlmostStandstillMetric almost_standstill_metric_;
@@ -36,11 +36,10 @@ public:
   TestDescription generate();
 
 private:
-  bool isFeasibleRoute(
-    const traffic_simulator_msgs::msg::LaneletPose & start,
+  std::optional<traffic_simulator_msgs::msg::LaneletPose> generateRandomPositionWithRouteTo(
     const traffic_simulator_msgs::msg::LaneletPose & goal);
   traffic_simulator_msgs::msg::LaneletPose generateRandomPoseWithinMinDistanceFromPosesFromLanelets(
-    const std::vector<traffic_simulator_msgs::msg::LaneletPose> & poses, double min_distance,
+    const std::vector<geometry_msgs::msg::Point> & positions, double min_distance,
     const std::vector<LaneletPart> & lanelets);
   std::pair<traffic_simulator_msgs::msg::LaneletPose, traffic_simulator_msgs::msg::LaneletPose>
   generateEgoRoute(
@@ -53,8 +52,8 @@ private:
   traffic_simulator_msgs::msg::LaneletPose generatePoseFromLanelets(
     const std::vector<LaneletPart> & lanelets);
   NPCDescription generateNpcFromLaneletsWithMinDistanceFromPoses(
-    int npc_id, const std::vector<traffic_simulator_msgs::msg::LaneletPose> & poses,
-    double min_distance, const std::vector<LaneletPart> & lanelets);
+    int npc_id, const std::vector<geometry_msgs::msg::Point> & positions, double min_distance,
+    const std::vector<LaneletPart> & lanelets);
 
   rclcpp::Logger logger_;
 
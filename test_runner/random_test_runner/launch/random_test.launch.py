@@ -73,6 +73,13 @@ class RandomTestRunnerLaunch(object):
                 {"default": "/tmp",
                  "description": "Directory to which result.yaml and result.junit.xml files will be placed"},
 
+            "shard_index": {"default": 0,
+                            "description": "Index of the share of the test cases run by this instance, "
+                                           "when a sweep is split across instances"},
+            "shard_count": {"default": 1,
+                            "description": "Count of the instances the test cases of the sweep are split across. "
+                                           "Each instance needs its own port, output_dir and ROS_DOMAIN_ID"},
+
             "initialize_duration": {"default": 35, "description": "How long test runner will wait for Autoware to initialize"},
 
             # test suite arguments #
@@ -209,7 +216,7 @@ class RandomTestRunnerLaunch(object):
                 namespace="simulation",
                 output="log",
                 arguments=[("__log_level:=warn")],
-                parameters=[{"port": 8080}],
+                parameters=[{"port": self.random_test_runner_launch_configuration["port"]}],
                 condition=IfCondition(
                     PythonExpression([
                         "'", self.random_test_runner_launch_configuration["simulator_type"], "'",
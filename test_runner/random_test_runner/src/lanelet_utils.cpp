@@ -21,11 +21,14 @@
 #include <lanelet2_routing/RoutingCost.h>
 #include <lanelet2_traffic_rules/TrafficRulesFactory.h>
 
+#include <algorithm>
 #include <autoware_lanelet2_extension/projection/mgrs_projector.hpp>
+#include <functional>
 #include <geographic_msgs/msg/geo_point.hpp>
 #include <geometry/vector3/normalize.hpp>
 #include <geometry/vector3/operator.hpp>
 #include <optional>
+#include <unordered_set>
 #include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
 
 LaneletUtils::LaneletUtils(const boost::filesystem::path & filename)
@@ -45,6 +48,99 @@ LaneletUtils::LaneletUtils(const boost::filesystem::path & filename)
 
   hdmap_utils_ptr_ =
     std::make_shared<hdmap_utils::HdMapUtils>(filename, geographic_msgs::msg::GeoPoint());
+
+  computeReachability();
+  computeOppositeLaneWidths();
+}
+
+void LaneletUtils::computeOppositeLaneWidths()
+{
+  for (const auto & lanelet : lanelet_map_ptr_->laneletLayer) {
+    if (vehicle_routing_graph_ptr_->rights(lanelet).empty()) {
+      opposite_lane_widths_.emplace(
+        lanelet.id(),
+        lanelet::geometry::distance3d(lanelet.leftBound().front(), lanelet.rightBound().front()));
+    }
+  }
+}
+
+void LaneletUtils::computeReachability()
+{
+  // Tarjan's algorithm, which closes a component only after all the components it reaches
+  std::unordered_map<int64_t, std::size_t> index, lowlink;
+  std::vector<int64_t> stack;
+  std::unordered_set<int64_t> on_stack;
+
+  std::function<void(const lanelet::ConstLanelet &)> connect =
+    [&](const lanelet::ConstLanelet & lanelet) {
+      const int64_t id = lanelet.id();
+      const std::size_t order = index.size();
+      index[id] = order;
+      lowlink[id] = order;
+      stack.push_back(id);
+      on_stack.insert(id);
+
+      for (const auto & next : vehicle_routing_graph_ptr_->following(lanelet, true)) {
+        if (index.find(next.id()) == index.end()) {
+          connect(next);
+          lowlink[id] = std::min(lowlink[id], lowlink[next.id()]);
+        } else if (on_stack.count(next.id())) {
+          lowlink[id] = std::min(lowlink[id], index[next.id()]);
+        }
+      }
+
+      if (lowlink[id] == index[id]) {
+        const std::size_t component = component_lanelet_ids_.size();
+        component_lanelet_ids_.emplace_back();
+        int64_t member;
+        do {
+          member = stack.back();
+          stack.pop_back();
+          on_stack.erase(member);
+          component_of_lanelet_[member] = component;
+          component_lanelet_ids_[component].push_back(member);
+        } while (member != id);
+      }
+    };
+
+  for (const auto & lanelet : lanelet_map_ptr_->laneletLayer) {
+    if (index.find(lanelet.id()) == index.end()) {
+      connect(lanelet);
+    }
+  }
+
+  // The successors of a component were closed before it, so their reachable sets are complete
+  const std::size_t component_count = component_lanelet_ids_.size();
+  reachable_components_.assign(component_count, boost::dynamic_bitset<>(component_count));
+  for (std::size_t component = 0; component < component_count; component++) {
+    for (const auto & id : component_lanelet_ids_[component]) {
+      const auto lanelet = lanelet_map_ptr_->laneletLayer.get(id);
+      for (const auto & next : vehicle_routing_graph_ptr_->following(lanelet, true)) {
+        const std::size_t next_component = component_of_lanelet_.at(next.id());
+        reachable_components_[component].set(next_component);
+        if (next_component != component) {
+          reachable_components_[component] |= reachable_components_[next_component];
+        }
+      }
+    }
+  }
+}
+
+std::vector<int64_t> LaneletUtils::getLaneletIdsReaching(int64_t to_lanelet_id)
+{
+  std::vector<int64_t> ret;
+  if (const auto iter = component_of_lanelet_.find(to_lanelet_id);
+      iter != component_of_lanelet_.end()) {
+    for (std::size_t component = 0; component < reachable_components_.size(); component++) {
+      if (reachable_components_[component].test(iter->second)) {
+        ret.insert(
+          ret.end(), component_lanelet_ids_[component].begin(),
+          component_lanelet_ids_[component].end());
+      }
+    }
+  }
+  std::sort(ret.begin(), ret.end());
+  return ret;
 }
 
 std::vector<int64_t> LaneletUtils::getLaneletIds() { return hdmap_utils_ptr_->getLaneletIds(); }
@@ -65,16 +161,26 @@ double LaneletUtils::getLaneletLength(int64_t lanelet_id)
   return hdmap_utils_ptr_->getLaneletLength(lanelet_id);
 }
 
+geometry_msgs::msg::Point LaneletUtils::toMapPosition(
+  const traffic_simulator_msgs::msg::LaneletPose & lanelet_pose)
+{
+  return hdmap_utils_ptr_->toMapPose(lanelet_pose).pose.position;
+}
+
 double LaneletUtils::computeDistance(
   const traffic_simulator_msgs::msg::LaneletPose & p1,
   const traffic_simulator_msgs::msg::LaneletPose & p2)
 {
-  auto p1_g = hdmap_utils_ptr_->toMapPose(p1).pose.position;
-  auto p2_g = hdmap_utils_ptr_->toMapPose(p2).pose.position;
+  return computeDistance(toMapPosition(p1), toMapPosition(p2));
+}
+
+double LaneletUtils::computeDistance(
+  const geometry_msgs::msg::Point & p1, const geometry_msgs::msg::Point & p2)
+{
   geometry_msgs::msg::Point d;
-  d.x = p1_g.x - p2_g.x;
-  d.y = p1_g.y - p2_g.y;
-  d.z = p1_g.z - p2_g.z;
+  d.x = p1.x - p2.x;
+  d.y = p1.y - p2.y;
+  d.z = p1.z - p2.z;
   return std::sqrt(d.x * d.x + d.y * d.y + d.z * d.z);
 }
 
@@ -97,24 +203,17 @@ std::optional<traffic_simulator_msgs::msg::LaneletPose> LaneletUtils::getOpposit
   using math::geometry::operator*;
   using math::geometry::operator+;
 
-  if (!lanelet_map_ptr_->laneletLayer.exists(pose.lanelet_id)) {
+  // Lanelets which do not exist or have lanes on their right (unsupported situation) are absent
+  const auto lane_width_iter = opposite_lane_widths_.find(pose.lanelet_id);
+  if (lane_width_iter == opposite_lane_widths_.end()) {
     return {};
   }
+  const double lane_width = lane_width_iter->second;
 
   auto tangent_vector = hdmap_utils_ptr_->getTangentVector(pose.lanelet_id, pose.s);
   if (!tangent_vector) {
     return {};
   }
-  lanelet::ConstLanelet current_lanelet = lanelet_map_ptr_->laneletLayer.get(pose.lanelet_id);
-  auto left_point = current_lanelet.leftBound().front();
-  auto right_point = current_lanelet.rightBound().front();
-
-  double lane_width = lanelet::geometry::distance3d(left_point, right_point);
-
-  if (!vehicle_routing_graph_ptr_->rights(current_lanelet).empty()) {
-    // unsupported situation
-    return {};
-  }
 
   geometry_msgs::msg::Vector3 perpendicular_vector;
   perpendicular_vector.x = tangent_vector->y;
@@ -39,6 +39,12 @@ RandomTestRunner::RandomTestRunner(const rclcpp::NodeOptions & option)
     }
     return get_parameter("consider_pose_by_road_slope").as_bool();
   }());
+  traffic_simulator::lanelet_pose::CanonicalizedLaneletPose::setUseElevationProfile([&]() {
+    if (not has_parameter("use_elevation_profile")) {
+      declare_parameter("use_elevation_profile", false);
+    }
+    return get_parameter("use_elevation_profile").as_bool();
+  }());
   TestControlParameters test_control_parameters = collectAndValidateTestControlParameters();
   std::string message = fmt::format("test control parameters: {}", test_control_parameters);
   RCLCPP_INFO_STREAM(get_logger(), message);
@@ -91,6 +97,12 @@ RandomTestRunner::RandomTestRunner(const rclcpp::NodeOptions & option)
   yaml_test_params_saver.addTestSuite(validated_params, validated_params.name);
 
   for (size_t test_id = 0; test_id < test_case_parameters_vector.size(); test_id++) {
+    // Test cases are striped across the shards, and keep the id they have in the whole suite so
+    // that the results of the shards can be merged
+    if (static_cast<int64_t>(test_id) % test_control_parameters.shard_count !=
+        test_control_parameters.shard_index) {
+      continue;
+    }
     std::string message =
       fmt::format("Generating test {}/{}", test_id + 1, test_case_parameters_vector.size());
     RCLCPP_INFO_STREAM(get_logger(), message);
@@ -149,6 +161,8 @@ TestControlParameters RandomTestRunner::collectAndValidateTestControlParameters(
   tp.architecture_type =
     architectureTypeFromString(this->declare_parameter<std::string>("architecture_type", ""));
   tp.simulator_host = this->declare_parameter<std::string>("simulator_host", "localhost");
+  tp.shard_index = this->declare_parameter<int64_t>("shard_index", 0);
+  tp.shard_count = this->declare_parameter<int64_t>("shard_count", 1);
 
   if (!tp.input_dir.empty() && !boost::filesystem::is_directory(tp.input_dir)) {
     throw std::runtime_error(
@@ -159,6 +173,10 @@ TestControlParameters RandomTestRunner::collectAndValidateTestControlParameters(
     throw std::runtime_error(fmt::format(
       "Output directory {} is empty, does not exists or is not a directory", tp.output_dir));
   }
+  if (tp.shard_count < 1 || tp.shard_index < 0 || tp.shard_index >= tp.shard_count) {
+    throw std::runtime_error(fmt::format(
+      "Shard index {} is out of the shard count {}", tp.shard_index, tp.shard_count));
+  }
   tp.test_timeout = this->declare_parameter<double>("test_timeout", 60.0);
   if (tp.test_timeout <= 0.0) {
     throw std::runtime_error(
@@ -197,6 +215,7 @@ void RandomTestRunner::update()
 {
   if (current_test_executor_->scenarioCompleted()) {
     current_test_executor_->deinitialize();
+    error_reporter_.writeTestCase(current_test_executor_->getTestCaseReporter());
     current_test_executor_++;
     if (current_test_executor_ == test_executors_.end()) {
       stop();
@@ -214,6 +233,12 @@ void RandomTestRunner::update()
 
 void RandomTestRunner::start()
 {
+  if (test_executors_.empty()) {
+    RCLCPP_INFO_STREAM(get_logger(), "No test case in this shard");
+    error_reporter_.write();
+    rclcpp::shutdown();
+    return;
+  }
   std::string message = fmt::format(
     "Running test {}/{}", std::distance(test_executors_.begin(), current_test_executor_) + 1,
     test_executors_.size());
@@ -16,6 +16,7 @@
 
 #include "random_test_runner/test_randomizer.hpp"
 
+#include <algorithm>
 #include <rclcpp/logger.hpp>
 #include <rclcpp/rclcpp.hpp>
 
@@ -57,11 +58,13 @@ TestDescription TestRandomizer::generate()
     ret.ego_start_position, test_suite_parameters_.npc_min_spawn_distance_from_ego,
     test_suite_parameters_.npc_max_spawn_distance_from_ego);
 
-  std::vector<traffic_simulator_msgs::msg::LaneletPose> npc_poses;
+  // Map positions of the NPCs already placed, converted once rather than on every comparison
+  std::vector<geometry_msgs::msg::Point> npc_positions;
   for (int npc_id = 0; npc_id < test_suite_parameters_.npcs_count; npc_id++) {
     ret.npcs_descriptions.emplace_back(generateNpcFromLaneletsWithMinDistanceFromPoses(
-      npc_id, npc_poses, min_npc_distance, lanelets_around_start));
-    npc_poses.emplace_back(ret.npcs_descriptions.back().start_position);
+      npc_id, npc_positions, min_npc_distance, lanelets_around_start));
+    npc_positions.emplace_back(
+      lanelet_utils_->toMapPosition(ret.npcs_descriptions.back().start_position));
   }
   return ret;
 }
@@ -89,10 +92,8 @@ TestRandomizer::generateEgoRoute(
       goal_pose = goal_pose_from_params;
     }
 
-    auto start_pose = generateRandomPosition();
-
-    if (isFeasibleRoute(start_pose, goal_pose)) {
-      return {start_pose, goal_pose};
+    if (auto start_pose = generateRandomPositionWithRouteTo(goal_pose)) {
+      return {start_pose.value(), goal_pose};
     }
   }
   throw std::runtime_error("Was not able to randomize ego path - are boundaries too tight?");
@@ -100,17 +101,18 @@ TestRandomizer::generateEgoRoute(
 
 traffic_simulator_msgs::msg::LaneletPose
 TestRandomizer::generateRandomPoseWithinMinDistanceFromPosesFromLanelets(
-  const std::vector<traffic_simulator_msgs::msg::LaneletPose> & poses, double min_distance,
+  const std::vector<geometry_msgs::msg::Point> & positions, double min_distance,
   const std::vector<LaneletPart> & lanelets)
 {
   for (int attempt_number = 0; attempt_number < max_randomization_attempts; attempt_number++) {
     auto ret = generatePoseFromLanelets(lanelets);
-    if (poses.empty()) {
+    if (positions.empty()) {
       return ret;
     }
+    const auto ret_position = lanelet_utils_->toMapPosition(ret);
     double current_min_distance = std::numeric_limits<double>::max();
-    for (const auto & pose : poses) {
-      double distance = lanelet_utils_->computeDistance(pose, ret);
+    for (const auto & position : positions) {
+      double distance = LaneletUtils::computeDistance(position, ret_position);
       current_min_distance = std::min(distance, current_min_distance);
     }
     if (current_min_distance > min_distance) {
@@ -122,18 +124,39 @@ TestRandomizer::generateRandomPoseWithinMinDistanceFromPosesFromLanelets(
     "are boundaries too tight?");
 }
 
-bool TestRandomizer::isFeasibleRoute(
-  const traffic_simulator_msgs::msg::LaneletPose & start,
+std::optional<traffic_simulator_msgs::msg::LaneletPose>
+TestRandomizer::generateRandomPositionWithRouteTo(
   const traffic_simulator_msgs::msg::LaneletPose & goal)
 {
-  if (start.lanelet_id == goal.lanelet_id && start.s < goal.s) {
-    return true;
+  // Starts are drawn only from the lanelets which have a route to the goal or to its opposite
+  // lanelet, which is the same distribution as rejecting the infeasible ones
+  std::vector<int64_t> lanelet_ids = lanelet_utils_->getLaneletIdsReaching(goal.lanelet_id);
+  if (auto opposite_lanelet = lanelet_utils_->getOppositeLaneLet(goal)) {
+    const auto opposite_lanelet_ids =
+      lanelet_utils_->getLaneletIdsReaching(opposite_lanelet->lanelet_id);
+    lanelet_ids.insert(lanelet_ids.end(), opposite_lanelet_ids.begin(), opposite_lanelet_ids.end());
+    std::sort(lanelet_ids.begin(), lanelet_ids.end());
+    lanelet_ids.erase(std::unique(lanelet_ids.begin(), lanelet_ids.end()), lanelet_ids.end());
+  }
+
+  // Without a route back to it, the goal lanelet is feasible only before the goal
+  const bool goal_lanelet_reaching =
+    std::binary_search(lanelet_ids.begin(), lanelet_ids.end(), goal.lanelet_id);
+  if (!goal_lanelet_reaching && goal.s > 0.0) {
+    lanelet_ids.push_back(goal.lanelet_id);
   }
 
-  auto opposite_lanelet = lanelet_utils_->getOppositeLaneLet(goal);
-  return !lanelet_utils_->getRoute(start.lanelet_id, goal.lanelet_id).empty() ||
-         (opposite_lanelet &&
-          !lanelet_utils_->getRoute(start.lanelet_id, opposite_lanelet->lanelet_id).empty());
+  if (lanelet_ids.empty()) {
+    return std::nullopt;
+  }
+
+  LaneletIdRandomizer start_lanelet_id_randomizer(
+    randomization_engine_, 0, static_cast<int64_t>(lanelet_ids.size()) - 1);
+  const int64_t lanelet_id = lanelet_ids[start_lanelet_id_randomizer.generate()];
+  const double s = lanelet_id == goal.lanelet_id && !goal_lanelet_reaching
+                     ? goal.s * s_value_randomizer_.generate()
+                     : getRandomS(lanelet_id);
+  return traffic_simulator::helper::constructLaneletPose(lanelet_id, s);
 }
 
 int64_t TestRandomizer::getRandomLaneletId()
@@ -170,12 +193,12 @@ traffic_simulator_msgs::msg::LaneletPose TestRandomizer::generatePoseFromLanelet
 }
 
 NPCDescription TestRandomizer::generateNpcFromLaneletsWithMinDistanceFromPoses(
-  int npc_id, const std::vector<traffic_simulator_msgs::msg::LaneletPose> & poses,
-  double min_distance, const std::vector<LaneletPart> & lanelets)
+  int npc_id, const std::vector<geometry_msgs::msg::Point> & positions, double min_distance,
+  const std::vector<LaneletPart> & lanelets)
 {
   std::stringstream npc_name_ss;
   npc_name_ss << "npc" << npc_id;
   return {
-    generateRandomPoseWithinMinDistanceFromPosesFromLanelets(poses, min_distance, lanelets),
+    generateRandomPoseWithinMinDistanceFromPosesFromLanelets(positions, min_distance, lanelets),
     speed_randomizer_.generate(), npc_name_ss.str()};
 }
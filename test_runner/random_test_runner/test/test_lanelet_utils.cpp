@@ -51,6 +51,16 @@ TEST(LaneletUtils, computeDistance_differentLanelet)
   EXPECT_NEAR(getLaneletUtils().computeDistance(from, to), 10.032117179351, 1e-2);
 }
 
+TEST(LaneletUtils, computeDistance_mapPositions)
+{
+  traffic_simulator_msgs::msg::LaneletPose from = makeLaneletPose(34594, 15.0),
+                                           to = makeLaneletPose(34621, 5.0);
+  EXPECT_NEAR(
+    LaneletUtils::computeDistance(
+      getLaneletUtils().toMapPosition(from), getLaneletUtils().toMapPosition(to)),
+    getLaneletUtils().computeDistance(from, to), EPS);
+}
+
 TEST(LaneletUtils, getOppositeLanelet)
 {
   traffic_simulator_msgs::msg::LaneletPose pose = makeLaneletPose(34621, 5.0);
@@ -257,6 +267,23 @@ TEST(LaneletUtils, getRoute_intersection)
   EXPECT_EQ(route[2], 34621);
 }
 
+TEST(LaneletUtils, getLaneletIdsReaching)
+{
+  const std::vector<int64_t> lanelet_ids = getLaneletUtils().getLaneletIdsReaching(34621);
+  EXPECT_TRUE(std::binary_search(lanelet_ids.begin(), lanelet_ids.end(), 34600));
+  EXPECT_TRUE(std::binary_search(lanelet_ids.begin(), lanelet_ids.end(), 34594));
+  for (const auto & lanelet_id : {34600, 34681}) {
+    EXPECT_EQ(
+      std::binary_search(lanelet_ids.begin(), lanelet_ids.end(), lanelet_id),
+      !getLaneletUtils().getRoute(lanelet_id, 34621).empty());
+  }
+}
+
+TEST(LaneletUtils, getLaneletIdsReaching_notExisting)
+{
+  EXPECT_TRUE(getLaneletUtils().getLaneletIdsReaching(1).empty());
+}
+
 TEST(LaneletUtils, getLaneletLength)
 {
   EXPECT_NEAR(getLaneletUtils().getLaneletLength(34621), 49.9125380565, EPS);
@@ -65,10 +65,12 @@ def default_rviz_config_file():
 def launch_setup(context, *args, **kwargs):
     # fmt: off
     architecture_type                   = LaunchConfiguration("architecture_type",                      default="awf/universe/20230906")
+    as_fast_as_possible                 = LaunchConfiguration("as_fast_as_possible",                    default=False)
     autoware_launch_file                = LaunchConfiguration("autoware_launch_file",                   default=default_autoware_launch_file_of(architecture_type.perform(context)))
     autoware_launch_package             = LaunchConfiguration("autoware_launch_package",                default=default_autoware_launch_package_of(architecture_type.perform(context)))
     consider_acceleration_by_road_slope = LaunchConfiguration("consider_acceleration_by_road_slope",    default=False)
     consider_pose_by_road_slope         = LaunchConfiguration("consider_pose_by_road_slope",            default=True)
+    context_publish_rate                = LaunchConfiguration("context_publish_rate",                   default=10.0)
     enable_perf                         = LaunchConfiguration("enable_perf",                            default=False)
     global_frame_rate                   = LaunchConfiguration("global_frame_rate",                      default=30.0)
     global_real_time_factor             = LaunchConfiguration("global_real_time_factor",                default=1.0)
@@ -78,22 +80,30 @@ def launch_setup(context, *args, **kwargs):
     launch_rviz                         = LaunchConfiguration("launch_rviz",                            default=False)
     launch_simple_sensor_simulator      = LaunchConfiguration("launch_simple_sensor_simulator",         default=True)
     output_directory                    = LaunchConfiguration("output_directory",                       default=Path("/tmp"))
+    pipeline_sensor_frames              = LaunchConfiguration("pipeline_sensor_frames",                 default=False)
     port                                = LaunchConfiguration("port",                                   default=5555)
     publish_empty_context               = LaunchConfiguration("publish_empty_context",                  default=False)
     record                              = LaunchConfiguration("record",                                 default=True)
+    record_topics                       = LaunchConfiguration("record_topics",                          default="")
     rviz_config                         = LaunchConfiguration("rviz_config",                            default=default_rviz_config_file())
     scenario                            = LaunchConfiguration("scenario",                               default=Path("/dev/null"))
     sensor_model                        = LaunchConfiguration("sensor_model",                           default="")
+    shard_count                         = LaunchConfiguration("shard_count",                            default=1)
+    shard_index                         = LaunchConfiguration("shard_index",                            default=0)
     sigterm_timeout                     = LaunchConfiguration("sigterm_timeout",                        default=8)
+    transport_protocol                  = LaunchConfiguration("transport_protocol",                     default="tcp")
+    use_elevation_profile               = LaunchConfiguration("use_elevation_profile",                  default=False)
     use_sim_time                        = LaunchConfiguration("use_sim_time",                           default=False)
     vehicle_model                       = LaunchConfiguration("vehicle_model",                          default="")
     # fmt: on
 
     print(f"architecture_type                   := {architecture_type.perform(context)}")
+    print(f"as_fast_as_possible                 := {as_fast_as_possible.perform(context)}")
     print(f"autoware_launch_file                := {autoware_launch_file.perform(context)}")
     print(f"autoware_launch_package             := {autoware_launch_package.perform(context)}")
     print(f"consider_acceleration_by_road_slope := {consider_acceleration_by_road_slope.perform(context)}")
     print(f"consider_pose_by_road_slope         := {consider_pose_by_road_slope.perform(context)}")
+    print(f"context_publish_rate                := {context_publish_rate.perform(context)}")
     print(f"enable_perf                         := {enable_perf.perform(context)}")
     print(f"global_frame_rate                   := {global_frame_rate.perform(context)}")
     print(f"global_real_time_factor             := {global_real_time_factor.perform(context)}")
@@ -102,13 +112,19 @@ def launch_setup(context, *args, **kwargs):
     print(f"launch_autoware                     := {launch_autoware.perform(context)}")
     print(f"launch_rviz                         := {launch_rviz.perform(context)}")
     print(f"output_directory                    := {output_directory.perform(context)}")
+    print(f"pipeline_sensor_frames              := {pipeline_sensor_frames.perform(context)}")
     print(f"port                                := {port.perform(context)}")
     print(f"publish_empty_context               := {publish_empty_context.perform(context)}")
     print(f"record                              := {record.perform(context)}")
+    print(f"record_topics                       := {record_topics.perform(context)}")
     print(f"rviz_config                         := {rviz_config.perform(context)}")
     print(f"scenario                            := {scenario.perform(context)}")
     print(f"sensor_model                        := {sensor_model.perform(context)}")
+    print(f"shard_count                         := {shard_count.perform(context)}")
+    print(f"shard_index                         := {shard_index.perform(context)}")
     print(f"sigterm_timeout                     := {sigterm_timeout.perform(context)}")
+    print(f"transport_protocol                  := {transport_protocol.perform(context)}")
+    print(f"use_elevation_profile               := {use_elevation_profile.perform(context)}")
     print(f"use_sim_time                        := {use_sim_time.perform(context)}")
     print(f"vehicle_model                       := {vehicle_model.perform(context)}")
 
@@ -121,18 +137,24 @@ def launch_setup(context, *args, **kwargs):
     def make_parameters():
         parameters = [
             {"architecture_type": architecture_type},
+            {"as_fast_as_possible": as_fast_as_possible},
             {"autoware_launch_file": autoware_launch_file},
             {"autoware_launch_package": autoware_launch_package},
             {"consider_acceleration_by_road_slope": consider_acceleration_by_road_slope},
             {"consider_pose_by_road_slope": consider_pose_by_road_slope},
+            {"context_publish_rate": context_publish_rate},
             {"initialize_duration": initialize_duration},
             {"launch_autoware": launch_autoware},
+            {"pipeline_sensor_frames": pipeline_sensor_frames},
             {"port": port},
             {"publish_empty_context" : publish_empty_context},
             {"record": record},
+            {"record_topics": record_topics},
             {"rviz_config": rviz_config},
             {"sensor_model": sensor_model},
             {"sigterm_timeout": sigterm_timeout},
+            {"transport_protocol": transport_protocol},
+            {"use_elevation_profile": use_elevation_profile},
             {"use_sim_time": use_sim_time},
             {"vehicle_model": vehicle_model},
         ]
@@ -161,10 +183,12 @@ def launch_setup(context, *args, **kwargs):
     return [
         # fmt: off
         DeclareLaunchArgument("architecture_type",                   default_value=architecture_type                  ),
+        DeclareLaunchArgument("as_fast_as_possible",                 default_value=as_fast_as_possible                ),
         DeclareLaunchArgument("autoware_launch_file",                default_value=autoware_launch_file               ),
         DeclareLaunchArgument("autoware_launch_package",             default_value=autoware_launch_package            ),
         DeclareLaunchArgument("consider_acceleration_by_road_slope", default_value=consider_acceleration_by_road_slope),
         DeclareLaunchArgument("consider_pose_by_road_slope",         default_value=consider_pose_by_road_slope        ),
+        DeclareLaunchArgument("context_publish_rate",                default_value=context_publish_rate               ),
         DeclareLaunchArgument("enable_perf",                         default_value=enable_perf                        ),
         DeclareLaunchArgument("global_frame_rate",                   default_value=global_frame_rate                  ),
         DeclareLaunchArgument("global_real_time_factor",             default_value=global_real_time_factor            ),
@@ -173,10 +197,16 @@ def launch_setup(context, *args, **kwargs):
         DeclareLaunchArgument("launch_rviz",                         default_value=launch_rviz                        ),
         DeclareLaunchArgument("publish_empty_context",               default_value=publish_empty_context              ),
         DeclareLaunchArgument("output_directory",                    default_value=output_directory                   ),
+        DeclareLaunchArgument("pipeline_sensor_frames",              default_value=pipeline_sensor_frames             ),
+        DeclareLaunchArgument("record_topics",                       default_value=record_topics                      ),
         DeclareLaunchArgument("rviz_config",                         default_value=rviz_config                        ),
         DeclareLaunchArgument("scenario",                            default_value=scenario                           ),
         DeclareLaunchArgument("sensor_model",                        default_value=sensor_model                       ),
+        DeclareLaunchArgument("shard_count",                         default_value=shard_count                        ),
+        DeclareLaunchArgument("shard_index",                         default_value=shard_index                        ),
         DeclareLaunchArgument("sigterm_timeout",                     default_value=sigterm_timeout                    ),
+        DeclareLaunchArgument("transport_protocol",                  default_value=transport_protocol                 ),
+        DeclareLaunchArgument("use_elevation_profile",               default_value=use_elevation_profile              ),
         DeclareLaunchArgument("use_sim_time",                        default_value=use_sim_time                       ),
         DeclareLaunchArgument("vehicle_model",                       default_value=vehicle_model                      ),
         # fmt: on
@@ -225,6 +255,7 @@ def launch_setup(context, *args, **kwargs):
             executable="openscenario_preprocessor_node",
             namespace="simulation",
             output="screen",
+            parameters=[{"shard_count": shard_count, "shard_index": shard_index}],
             on_exit=ShutdownOnce(),
         ),
         Node(
@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+# Copyright 2020 TIER IV, Inc. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import argparse
+import json
+import sys
+
+from pathlib import Path
+
+# Measurements of a batch run of a scenario which regress when they grow.
+METRICS = [
+    "wall_time_per_simulated_second",
+    "frame_time_p99",
+    "peak_rss_kb",
+    "rpc_calls",
+]
+
+
+class BenchmarkChecker:
+    """Compare benchmark results of scenarios against a recorded baseline."""
+
+    def __init__(self, tolerance):
+        self.tolerance = tolerance
+
+    def read(self, results):
+        measurements = {}
+        for each in results:
+            result = json.loads(Path(each).read_text())
+            measurements[result["scenario"]] = {
+                metric: result[metric] for metric in METRICS if metric in result
+            }
+        return measurements
+
+    def record(self, results, baseline):
+        Path(baseline).write_text(json.dumps(self.read(results), indent=2, sort_keys=True) + "\n")
+
+    def check(self, results, baseline):
+        expected = json.loads(Path(baseline).read_text())
+
+        all_ok = True
+
+        for scenario, measurement in self.read(results).items():
+            if scenario not in expected:
+                print("[NO BASELINE] " + scenario)
+                continue
+
+            for metric, value in measurement.items():
+                limit = expected[scenario].get(metric)
+                if limit is None:
+                    continue
+                elif value > limit * (1.0 + self.tolerance):
+                    print(f"[REGRESSED] {scenario} {metric}: {value} > {limit}")
+                    all_ok = False
+                else:
+                    print(f"[OK] {scenario} {metric}: {value} <= {limit}")
+
+        sys.exit(0 if all_ok else 1)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="check benchmark results of scenarios against a baseline"
+    )
+    parser.add_argument("baseline", help="path to baseline json file")
+    parser.add_argument("results", nargs="+", help="paths to benchmark json files")
+    parser.add_argument(
+        "--tolerance",
+        type=float,
+        default=0.1,
+        help="relative growth of a measurement allowed over the baseline",
+    )
+    parser.add_argument(
+        "--record",
+        action="store_true",
+        help="write the results as the new baseline instead of checking them",
+    )
+    args = parser.parse_args()
+    checker = BenchmarkChecker(args.tolerance)
+    if args.record:
+        checker.record(args.results, args.baseline)
+    else:
+        checker.check(args.results, args.baseline)
+
+
+if __name__ == "__main__":
+    """Entrypoint."""
+    main()
+    pass
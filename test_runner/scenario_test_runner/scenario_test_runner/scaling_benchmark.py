@@ -0,0 +1,143 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+# Copyright 2020 TIER IV, Inc. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import argparse
+import csv
+import json
+import subprocess
+import sys
+
+from pathlib import Path
+
+# Columns of the scaling curve, the time columns are per frame and split by subsystem: the scenario
+# itself, the traffic simulator without its requests, and the simulator serving the requests.
+COLUMNS = [
+    "vehicle_count",
+    "pedestrian_count",
+    "frames",
+    "wall_time_per_simulated_second",
+    "frame_time_p99",
+    "scenario_time_per_frame",
+    "traffic_simulator_time_per_frame",
+    "simulator_time_per_frame",
+    "peak_rss_kb",
+    "rpc_calls",
+]
+
+
+class ScalingBenchmark:
+    """Run the stress mock scenario for a sweep of entity counts and tabulate the measurements."""
+
+    def __init__(self, output_directory, pedestrian_count, duration, detection_sensor):
+        self.output_directory = Path(output_directory)
+        self.pedestrian_count = pedestrian_count
+        self.duration = duration
+        self.detection_sensor = detection_sensor
+
+    def write_parameters(self, path, vehicle_count):
+        lines = [
+            "/**:",
+            "  ros__parameters:",
+            f"    vehicle_count: {vehicle_count}",
+            f"    pedestrian_count: {self.pedestrian_count}",
+            f"    duration: {self.duration}",
+            f"    attach_detection_sensor: {str(self.detection_sensor).lower()}",
+        ]
+        path.write_text("\n".join(lines) + "\n")
+
+    def run(self, vehicle_count):
+        parameters = self.output_directory / f"stress_{vehicle_count}.yaml"
+        benchmark = self.output_directory / f"stress_{vehicle_count}.json"
+        self.write_parameters(parameters, vehicle_count)
+        subprocess.run(
+            [
+                "ros2",
+                "launch",
+                "cpp_mock_scenarios",
+                "mock_test.launch.py",
+                "scenario:=stress",
+                "launch_autoware:=False",
+                "batch:=True",
+                f"benchmark_path:={benchmark}",
+                f"scenario_parameters:={parameters}",
+                f"junit_path:={self.output_directory / f'stress_{vehicle_count}.junit.xml'}",
+            ],
+            check=True,
+        )
+        return self.row(vehicle_count, json.loads(benchmark.read_text()))
+
+    def row(self, vehicle_count, result):
+        frames = max(result["frames"], 1)
+        rpc_time = result.get("rpc_time", 0.0)
+        return {
+            "vehicle_count": vehicle_count,
+            "pedestrian_count": self.pedestrian_count,
+            "frames": result["frames"],
+            "wall_time_per_simulated_second": result["wall_time_per_simulated_second"],
+            "frame_time_p99": result.get("frame_time_p99", 0.0),
+            "scenario_time_per_frame": result["on_update_time"] / frames,
+            "traffic_simulator_time_per_frame": max(result["update_frame_time"] - rpc_time, 0.0)
+            / frames,
+            "simulator_time_per_frame": rpc_time / frames,
+            "peak_rss_kb": result["peak_rss_kb"],
+            "rpc_calls": result["rpc_calls"],
+        }
+
+    def sweep(self, vehicle_counts):
+        self.output_directory.mkdir(parents=True, exist_ok=True)
+        rows = [self.run(vehicle_count) for vehicle_count in vehicle_counts]
+        with open(self.output_directory / "scaling.csv", "w", newline="") as file:
+            writer = csv.DictWriter(file, fieldnames=COLUMNS)
+            writer.writeheader()
+            writer.writerows(rows)
+        for row in rows:
+            print(" ".join(f"{column}: {row[column]}" for column in COLUMNS))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="measure how the frame time of the stress mock scenario grows with the entities"
+    )
+    parser.add_argument(
+        "vehicle_counts",
+        type=int,
+        nargs="*",
+        default=[10, 50, 100, 200, 500],
+        help="vehicle counts of the sweep",
+    )
+    parser.add_argument(
+        "--output-directory",
+        default="/tmp/scaling_benchmark",
+        help="directory the parameters, benchmarks and scaling.csv are written to",
+    )
+    parser.add_argument("--pedestrian-count", type=int, default=0)
+    parser.add_argument("--duration", type=float, default=10.0, help="simulated seconds of a run")
+    parser.add_argument("--detection-sensor", action="store_true")
+    args = parser.parse_args()
+    try:
+        ScalingBenchmark(
+            args.output_directory, args.pedestrian_count, args.duration, args.detection_sensor
+        ).sweep(args.vehicle_counts)
+    except subprocess.CalledProcessError as error:
+        print(f"[FAILED] {error}")
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    """Entrypoint."""
+    main()
+    pass
@@ -0,0 +1,168 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+# Copyright 2020 TIER IV, Inc. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import argparse
+import os
+import queue
+import subprocess
+import sys
+import threading
+import xml.etree.ElementTree as ET
+
+from pathlib import Path
+
+
+def parse_shard(text):
+    index, count = (int(each) for each in text.split("/"))
+    if count <= 0 or not 0 <= index < count:
+        raise argparse.ArgumentTypeError(f"shard {text} is not k/n with 0 <= k < n")
+    return index, count
+
+
+class WorkflowRunner:
+    """
+    Run the scenarios of a workflow file, optionally a shard of them on several simulator stacks.
+
+    Each worker launches its own stack, isolated from the others by its ROS domain ID, its port and
+    its output directory, and takes the next scenario from a queue shared by the workers. The
+    results of all the scenarios are merged into a single JUnit report.
+    """
+
+    def __init__(self, output_directory, arguments, jobs, port, domain_id):
+        self.output_directory = Path(output_directory)
+        self.arguments = arguments
+        self.jobs = jobs
+        self.port = port
+        self.domain_id = domain_id
+        self.report = ET.Element("testsuites", name=str(self.output_directory))
+        self.lock = threading.Lock()
+        self.all_ok = True
+
+    def read(self, workflow, shard):
+        index, count = shard
+        scenarios = [
+            line.strip()
+            for line in Path(workflow).read_text().splitlines()
+            if line.strip() and not line.strip().startswith("#")
+        ]
+        return [each for i, each in enumerate(scenarios) if i % count == index]
+
+    def run_scenario(self, worker, scenario):
+        output_directory = self.output_directory / f"worker_{worker}"
+        environment = dict(os.environ, ROS_DOMAIN_ID=str(self.domain_id + worker))
+        subprocess.run(
+            [
+                "ros2",
+                "launch",
+                "scenario_test_runner",
+                "scenario_test_runner.launch.py",
+                f"scenario:={scenario}",
+                f"output_directory:={output_directory}",
+                f"port:={self.port + worker}",
+            ]
+            + self.arguments,
+            env=environment,
+        )
+        result = output_directory / "scenario_test_runner" / "result.junit.xml"
+        checked = subprocess.run(
+            ["ros2", "run", "scenario_test_runner", "result_checker.py", str(result)],
+            env=environment,
+        )
+        with self.lock:
+            if checked.returncode != 0:
+                print(f"Error: caught non-zero exit status (code: {checked.returncode})")
+                self.all_ok = False
+            if result.exists():
+                self.report.extend(ET.parse(result).getroot())
+            else:
+                suite = ET.SubElement(self.report, "testsuite", name=scenario)
+                case = ET.SubElement(suite, "testcase", name=Path(scenario).stem)
+                ET.SubElement(case, "error", type="launch", message="no result.junit.xml")
+            self.write()
+
+    def write(self):
+        cases = self.report.iter("testcase")
+        self.report.set("tests", str(sum(1 for _ in cases)))
+        for kind in ["failure", "error"]:
+            self.report.set(kind + "s", str(sum(1 for _ in self.report.iter(kind))))
+        ET.ElementTree(self.report).write(
+            self.output_directory / "result.junit.xml", encoding="utf-8", xml_declaration=True
+        )
+
+    def run(self, scenarios):
+        self.output_directory.mkdir(parents=True, exist_ok=True)
+        pending = queue.Queue()
+        for each in scenarios:
+            pending.put(each)
+
+        def work(worker):
+            while True:
+                try:
+                    scenario = pending.get_nowait()
+                except queue.Empty:
+                    return
+                self.run_scenario(worker, scenario)
+
+        workers = [threading.Thread(target=work, args=(i,)) for i in range(self.jobs)]
+        for each in workers:
+            each.start()
+        for each in workers:
+            each.join()
+        self.write()
+        return self.all_ok
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="run the scenarios of a workflow file, a shard of them and in parallel"
+    )
+    parser.add_argument("workflow", help="path to workflow file, a scenario per line")
+    parser.add_argument(
+        "arguments", nargs="*", help="launch arguments passed to scenario_test_runner.launch.py"
+    )
+    parser.add_argument(
+        "--shard",
+        type=parse_shard,
+        default=(0, 1),
+        help="k/n to run only the scenarios at the k-th of every n lines, counting from 0",
+    )
+    parser.add_argument(
+        "-j", "--jobs", type=int, default=1, help="count of simulator stacks run in parallel"
+    )
+    parser.add_argument(
+        "--output-directory",
+        default="/tmp/workflow_runner",
+        help="directory of the worker outputs and of the merged result.junit.xml",
+    )
+    parser.add_argument("--port", type=int, default=5555, help="port of the first worker")
+    parser.add_argument(
+        "--domain-id",
+        type=int,
+        default=int(os.environ.get("ROS_DOMAIN_ID", "0")),
+        help="ROS domain ID of the first worker",
+    )
+    args = parser.parse_args()
+    runner = WorkflowRunner(
+        args.output_directory, args.arguments, max(args.jobs, 1), args.port, args.domain_id
+    )
+    sys.exit(0 if runner.run(runner.read(args.workflow, args.shard)) else 1)
+
+
+if __name__ == "__main__":
+    """Entrypoint."""
+    main()
+    pass